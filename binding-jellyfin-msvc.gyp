@@ -55,6 +55,50 @@
                 "src/bindings/bitstream_filter_context_async.cc",
                 "src/bindings/bitstream_filter_context_sync.cc",
                 "src/bindings/option.cc",
+                "src/bindings/parallel_decoder.cc",
+                "src/bindings/parallel_decoder_async.cc",
+                "src/bindings/parallel_decoder_sync.cc",
+                "src/bindings/demux_dispatcher.cc",
+                "src/bindings/demux_dispatcher_async.cc",
+                "src/bindings/demux_dispatcher_sync.cc",
+                "src/bindings/frame_cache.cc",
+                "src/bindings/concat_input.cc",
+                "src/bindings/concat_input_async.cc",
+                "src/bindings/concat_input_sync.cc",
+                "src/bindings/media_hasher.cc",
+                "src/bindings/media_hasher_async.cc",
+                "src/bindings/media_hasher_sync.cc",
+                "src/bindings/frame_arena.cc",
+                "src/bindings/file_io.cc",
+                "src/bindings/http_io.cc",
+                "src/bindings/packet_allocator.cc",
+                "src/bindings/packet_trace.cc",
+                "src/bindings/read_pacer.cc",
+                "src/bindings/frame_scheduler.cc",
+                "src/bindings/frame_scheduler_async.cc",
+                "src/bindings/frame_scheduler_sync.cc",
+                "src/bindings/packet_router.cc",
+                "src/bindings/packet_router_async.cc",
+                "src/bindings/packet_router_sync.cc",
+                "src/bindings/wire_format.cc",
+                "src/bindings/shared_memory_channel.cc",
+                "src/bindings/shared_memory_channel_async.cc",
+                "src/bindings/shared_memory_channel_sync.cc",
+                "src/bindings/smart_cutter.cc",
+                "src/bindings/smart_cutter_async.cc",
+                "src/bindings/smart_cutter_sync.cc",
+                "src/bindings/scene_analyzer.cc",
+                "src/bindings/scene_analyzer_async.cc",
+                "src/bindings/scene_analyzer_sync.cc",
+                "src/bindings/color_transform.cc",
+                "src/bindings/color_transform_async.cc",
+                "src/bindings/color_transform_sync.cc",
+                "src/bindings/logo_overlay.cc",
+                "src/bindings/logo_overlay_async.cc",
+                "src/bindings/logo_overlay_sync.cc",
+                "src/bindings/image_sequence_writer.cc",
+                "src/bindings/image_sequence_writer_async.cc",
+                "src/bindings/image_sequence_writer_sync.cc",
             ],
             "include_dirs": ["<!@(node -p \"require('node-addon-api').include\")"],
             "dependencies": ["<!(node -p \"require('node-addon-api').gyp\")"],
@@ -0,0 +1,150 @@
+/**
+ * File I/O Benchmark Example - Low Level API
+ *
+ * Compares FFmpeg's file: protocol with the native file backend
+ * (io_uring on Linux, pread/pwrite worker thread otherwise).
+ * Copies the input through an IOContext pair and reports throughput
+ * and syscall counts for each backend.
+ *
+ * The file: protocol has no counters, so its syscall count is estimated from
+ * the request and AVIO buffer sizes. Use `strace -c -f` for exact numbers.
+ *
+ * Usage: tsx examples/file-io-benchmark.ts <input> <output> [queueDepth] [blockSize]
+ * Example: tsx examples/file-io-benchmark.ts testdata/video.mp4 examples/.tmp/copy.bin 16 1048576
+ */
+
+import { existsSync, statSync } from 'node:fs';
+
+import { AVIO_FLAG_READ, AVIO_FLAG_WRITE, FFmpegError, IOContext } from '../src/index.js';
+
+import type { FileIOOptions, FileIOStats } from '../src/index.js';
+
+const CHUNK_SIZE = 64 * 1024;
+
+interface RunResult {
+  seconds: number;
+  readSyscalls: number;
+  writeSyscalls: number;
+  readStats: FileIOStats | null;
+  writeStats: FileIOStats | null;
+}
+
+/**
+ * Copy input to output through two IOContexts
+ */
+function copy(inputFile: string, outputFile: string, options: FileIOOptions | null): RunResult {
+  const input = new IOContext();
+  const output = new IOContext();
+
+  if (options) {
+    FFmpegError.throwIfError(input.openFileSync(inputFile, AVIO_FLAG_READ, options), 'openFile (input)');
+    FFmpegError.throwIfError(output.openFileSync(outputFile, AVIO_FLAG_WRITE, options), 'openFile (output)');
+  } else {
+    FFmpegError.throwIfError(input.open2Sync(inputFile, AVIO_FLAG_READ), 'open2 (input)');
+    FFmpegError.throwIfError(output.open2Sync(outputFile, AVIO_FLAG_WRITE), 'open2 (output)');
+  }
+
+  const start = process.hrtime.bigint();
+  let requests = 0;
+
+  for (;;) {
+    const data = input.readSync(CHUNK_SIZE);
+    if (!Buffer.isBuffer(data) || data.length === 0) {
+      break;
+    }
+    output.writeSync(data);
+    requests++;
+  }
+
+  const readStats = input.getFileStats();
+  const writeStats = output.getFileStats();
+  const outputBufferSize = output.bufferSize;
+  FFmpegError.throwIfError(input.closepSync(), 'closep (input)');
+  FFmpegError.throwIfError(output.closepSync(), 'closep (output)');
+
+  const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+
+  return {
+    seconds,
+    // file: reads large requests directly and writes once per full AVIO buffer
+    readSyscalls: readStats?.syscalls ?? requests + 1,
+    writeSyscalls: writeStats?.syscalls ?? Math.ceil(statSync(inputFile).size / outputBufferSize),
+    readStats,
+    writeStats,
+  };
+}
+
+/**
+ * Print one benchmark row
+ */
+function report(name: string, bytes: number, result: RunResult): void {
+  const mbps = bytes / (1024 * 1024) / result.seconds;
+  const estimated = result.readStats ? '' : ' (est.)';
+  console.log(
+    `${name.padEnd(10)} ${mbps.toFixed(1).padStart(9)} MB/s` +
+      // eslint-disable-next-line @stylistic/indent-binary-ops
+      `  read syscalls: ${String(result.readSyscalls).padStart(6)}${estimated}` +
+      // eslint-disable-next-line @stylistic/indent-binary-ops
+      `  write syscalls: ${String(result.writeSyscalls).padStart(6)}${estimated}`,
+  );
+  if (result.readStats && result.writeStats) {
+    console.log(
+      `${''.padEnd(10)} read ops: ${result.readStats.readOps}, waits: ${result.readStats.waits}, ` +
+        // eslint-disable-next-line @stylistic/indent-binary-ops
+        `write ops: ${result.writeStats.writeOps}, max in flight: ${result.writeStats.maxInFlight}`,
+    );
+  }
+}
+
+/**
+ * Main entry point
+ */
+async function main(): Promise<void> {
+  const args = process.argv.slice(2);
+
+  if (args.length < 2) {
+    console.log('Usage: tsx examples/file-io-benchmark.ts <input> <output> [queueDepth] [blockSize]');
+    console.log('Compares the file: protocol with the native file I/O backend.');
+    process.exit(1);
+  }
+
+  const [inputFile, outputFile] = args;
+  const queueDepth = args[2] ? parseInt(args[2]) : 8;
+  const blockSize = args[3] ? parseInt(args[3]) : 256 * 1024;
+
+  if (!existsSync(inputFile)) {
+    console.error(`Error: File not found: ${inputFile}`);
+    process.exit(1);
+  }
+
+  const bytes = statSync(inputFile).size;
+  console.log(`Copying ${(bytes / (1024 * 1024)).toFixed(1)} MB, ${CHUNK_SIZE} byte requests, queue depth ${queueDepth}, block size ${blockSize}`);
+
+  try {
+    report('file:', bytes, copy(inputFile, outputFile, null));
+
+    const threads = copy(inputFile, outputFile, { engine: 'threads', queueDepth, blockSize });
+    report('threads', bytes, threads);
+
+    const probe = new IOContext();
+    if (probe.openFileSync(inputFile, AVIO_FLAG_READ, { engine: 'uring' }) === 0) {
+      probe.closepSync();
+      report('uring', bytes, copy(inputFile, outputFile, { engine: 'uring', queueDepth, blockSize }));
+    } else {
+      console.log('uring      not available on this system');
+    }
+    process.exit(0);
+  } catch (error) {
+    if (error instanceof FFmpegError) {
+      console.error(`FFmpeg Error: ${error.message} (code: ${error.code})`);
+    } else {
+      console.error('Unexpected error:', error);
+    }
+    process.exit(1);
+  }
+}
+
+// Run if executed directly
+if (import.meta.url === `file://${process.argv[1]}`) {
+  main().catch(console.error);
+}
@@ -0,0 +1,104 @@
+/**
+ * HTTP Prefetch Benchmark Example - High Level API
+ *
+ * Compares FFmpeg's http: protocol with the native HTTP backend
+ * (parallel range requests over keep-alive connections plus a block cache).
+ * Opens a remote file, then seeks to several positions and reads a packet
+ * after each seek, reporting open and seek latency for both backends.
+ *
+ * Files with the `moov` atom at the end and seek-heavy access benefit most.
+ *
+ * Usage: tsx examples/http-prefetch-benchmark.ts <url> [seeks] [connections]
+ * Example: tsx examples/http-prefetch-benchmark.ts https://example.com/video.mp4 10 4
+ */
+
+import { FFmpegError, MediaInput } from '../src/index.js';
+
+import type { HttpIOOptions } from '../src/index.js';
+
+interface RunResult {
+  openMs: number;
+  seekMs: number[];
+}
+
+/**
+ * Open the URL and seek through it
+ */
+async function run(url: string, seeks: number, httpIO: HttpIOOptions | false): Promise<RunResult> {
+  let start = performance.now();
+  await using input = await MediaInput.open(url, { httpIO });
+  const openMs = performance.now() - start;
+
+  const duration = input.duration;
+  const seekMs: number[] = [];
+
+  for (let i = 0; i < seeks; i++) {
+    // Spread targets over the file, alternating between the second half and the first
+    const position = ((i % 2 === 0 ? 0.5 : 0) + (i / seeks) * 0.5) * duration;
+
+    start = performance.now();
+    FFmpegError.throwIfError(await input.seek(position), 'seek');
+    for await (const packet of input.packets()) {
+      packet.free();
+      break;
+    }
+    seekMs.push(performance.now() - start);
+  }
+
+  if (httpIO) {
+    const stats = input.getFormatContext().pb?.getHttpStats();
+    if (stats) {
+      console.log(
+        `${''.padEnd(10)} requests: ${stats.requests}, connections: ${stats.connections}, reused: ${stats.reusedConnections}, ` +
+          // eslint-disable-next-line @stylistic/indent-binary-ops
+          `cache hits: ${stats.memoryHits}, misses: ${stats.misses}, fetched: ${(stats.bytesFetched / (1024 * 1024)).toFixed(1)} MB`,
+      );
+    }
+  }
+
+  return { openMs, seekMs };
+}
+
+/**
+ * Print one benchmark row
+ */
+function report(name: string, result: RunResult): void {
+  const total = result.seekMs.reduce((a, b) => a + b, 0);
+  const average = result.seekMs.length > 0 ? total / result.seekMs.length : 0;
+  console.log(`${name.padEnd(10)} open: ${result.openMs.toFixed(1).padStart(8)} ms  seek+read: ${average.toFixed(1).padStart(8)} ms avg, ${total.toFixed(1)} ms total`);
+}
+
+/**
+ * Main entry point
+ */
+async function main(): Promise<void> {
+  const args = process.argv.slice(2);
+
+  if (args.length < 1) {
+    console.log('Usage: tsx examples/http-prefetch-benchmark.ts <url> [seeks] [connections]');
+    console.log('Compares the http: protocol with the native HTTP backend.');
+    process.exit(1);
+  }
+
+  const [url] = args;
+  const seeks = args[1] ? parseInt(args[1]) : 10;
+  const connections = args[2] ? parseInt(args[2]) : 4;
+
+  try {
+    report('http:', await run(url, seeks, false));
+    report('httpIO', await run(url, seeks, { connections }));
+    process.exit(0);
+  } catch (error) {
+    if (error instanceof FFmpegError) {
+      console.error(`FFmpeg Error: ${error.message} (code: ${error.code})`);
+    } else {
+      console.error('Unexpected error:', error);
+    }
+    process.exit(1);
+  }
+}
+
+// Run if executed directly
+if (import.meta.url === `file://${process.argv[1]}`) {
+  main().catch(console.error);
+}
@@ -0,0 +1,127 @@
+/**
+ * Pipeline Concurrency Benchmark Example - High Level API
+ *
+ * Transcodes the video stream of the input (decode → scale → encode) twice:
+ * once with the stages running one after another (`queueDepth: 0`) and once
+ * with every stage running as its own loop behind a bounded queue. Reports
+ * throughput, the speedup and the per-stage statistics of the concurrent run.
+ *
+ * Codec threads are limited to 1 by default so the speedup comes from stage
+ * overlap only. Pass 0 to let the codecs use all cores as well.
+ *
+ * Usage: tsx examples/pipeline-concurrency-benchmark.ts <input> <output> [queueDepth] [threads]
+ * Example: tsx examples/pipeline-concurrency-benchmark.ts testdata/video.mp4 examples/.tmp/concurrency.mp4 4 1
+ */
+
+import { availableParallelism } from 'node:os';
+
+import { Decoder, Encoder, FF_ENCODER_LIBX264, FFmpegError, FilterAPI, MediaInput, MediaOutput, pipeline } from '../src/index.js';
+
+import type { PipelineStats } from '../src/index.js';
+
+interface RunResult {
+  seconds: number;
+  frames: number;
+  stats: PipelineStats;
+}
+
+/**
+ * Transcode the video stream with the given queue depth
+ */
+async function run(inputFile: string, outputFile: string, queueDepth: number, threads: number): Promise<RunResult> {
+  await using input = await MediaInput.open(inputFile);
+  await using output = await MediaOutput.open(outputFile);
+
+  const videoStream = input.video();
+  if (!videoStream) {
+    throw new Error('No video stream found in input file');
+  }
+
+  using decoder = await Decoder.create(videoStream, { threads });
+  using filter = FilterAPI.create(`scale=${videoStream.codecpar.width}:${videoStream.codecpar.height}:flags=lanczos`, {
+    threads,
+    timeBase: videoStream.timeBase,
+    frameRate: videoStream.avgFrameRate,
+  });
+  using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+    timeBase: videoStream.timeBase,
+    frameRate: videoStream.avgFrameRate,
+    bitrate: '2M',
+    threads,
+    options: {
+      preset: 'veryfast',
+    },
+  });
+
+  const start = performance.now();
+  const control = pipeline(input, decoder, filter, encoder, output, { queueDepth });
+  await control.completion;
+  const seconds = (performance.now() - start) / 1000;
+
+  // Count the encoded frames
+  await using verify = await MediaInput.open(outputFile);
+  let frames = 0;
+  for await (const packet of verify.packets()) {
+    frames++;
+    packet.free();
+  }
+
+  return { seconds, frames, stats: control.stats() };
+}
+
+/**
+ * Print one benchmark row
+ */
+function report(name: string, result: RunResult): void {
+  const fps = result.frames / result.seconds;
+  console.log(`${name.padEnd(12)} ${result.seconds.toFixed(2).padStart(7)} s  ${fps.toFixed(1).padStart(8)} fps  (${result.frames} frames)`);
+}
+
+/**
+ * Main entry point
+ */
+async function main(): Promise<void> {
+  const args = process.argv.slice(2);
+
+  if (args.length < 2) {
+    console.log('Usage: tsx examples/pipeline-concurrency-benchmark.ts <input> <output> [queueDepth] [threads]');
+    console.log('Compares sequential and concurrent pipeline stages.');
+    process.exit(1);
+  }
+
+  const [inputFile, outputFile] = args;
+  const queueDepth = args[2] ? parseInt(args[2]) : 4;
+  const threads = args[3] ? parseInt(args[3]) : 1;
+
+  console.log(`Cores: ${availableParallelism()}, UV_THREADPOOL_SIZE: ${process.env.UV_THREADPOOL_SIZE ?? '4 (default)'}, codec threads: ${threads || 'auto'}`);
+
+  try {
+    const sequential = await run(inputFile, outputFile, 0, threads);
+    report('sequential', sequential);
+
+    const concurrent = await run(inputFile, outputFile, queueDepth, threads);
+    report(`queue ${queueDepth}`, concurrent);
+
+    console.log(`Speedup: ${(sequential.seconds / concurrent.seconds).toFixed(2)}x`);
+    console.log(`Bottleneck: ${concurrent.stats.bottleneck?.stage ?? 'none'}`);
+    console.log('Stages (busy / waiting for input / waiting for the next stage):');
+    for (const stage of concurrent.stats.stages) {
+      const times = [stage.busyTime, stage.upstreamWaitTime, stage.downstreamWaitTime].map((time) => `${time.toFixed(0).padStart(6)} ms`).join(' ');
+      const queue = stage.queue ? `  max depth ${stage.queue.maxDepth}/${stage.queue.capacity}` : '';
+      console.log(`  ${stage.stage.padEnd(7)} ${times}${queue}`);
+    }
+    process.exit(0);
+  } catch (error) {
+    if (error instanceof FFmpegError) {
+      console.error(`FFmpeg Error: ${error.message} (code: ${error.code})`);
+    } else {
+      console.error('Unexpected error:', error);
+    }
+    process.exit(1);
+  }
+}
+
+// Run if executed directly
+if (import.meta.url === `file://${process.argv[1]}`) {
+  main().catch(console.error);
+}
@@ -817,7 +817,7 @@ const __ffmpeg_brand = Symbol('__ffmpeg_brand');
   // Re-export errors from low level api
   output += '// Re-exported FFmpeg errors\n';
   output +=
-    "export { AVERROR_EACCES, AVERROR_EAGAIN, AVERROR_EBUSY, AVERROR_EEXIST, AVERROR_EINVAL, AVERROR_EIO, AVERROR_EISDIR, AVERROR_EMFILE, AVERROR_ENODEV, AVERROR_ENOENT, AVERROR_ENOMEM, AVERROR_ENOSPC, AVERROR_ENOTDIR, AVERROR_EPERM, AVERROR_EPIPE, AVERROR_ERANGE } from '../lib/error.js';\n\n";
+    "export { AVERROR_EACCES, AVERROR_EAGAIN, AVERROR_EBUSY, AVERROR_EEXIST, AVERROR_EINVAL, AVERROR_EIO, AVERROR_EISDIR, AVERROR_EMFILE, AVERROR_ENODEV, AVERROR_ENOENT, AVERROR_ENOMEM, AVERROR_ENOSPC, AVERROR_ENOSYS, AVERROR_ENOTDIR, AVERROR_EPERM, AVERROR_EPIPE, AVERROR_ERANGE } from '../lib/error.js';\n\n";
 
   // Add special time constants
   output += '// Special time constants\n';
@@ -1,5 +1,5 @@
-import { AVERROR_EAGAIN, AVERROR_EOF } from '../constants/constants.js';
-import { Codec, CodecContext, Dictionary, FFmpegError, Frame } from '../lib/index.js';
+import { AVERROR_EAGAIN, AVERROR_EOF, AVERROR_EXIT } from '../constants/constants.js';
+import { Codec, CodecContext, Dictionary, FFmpegError, Frame, ParallelDecoder } from '../lib/index.js';
 
 import type { Packet, Stream } from '../lib/index.js';
 import type { DecoderOptions } from './types.js';
@@ -42,12 +42,21 @@ import type { DecoderOptions } from './types.js';
  * }
  * ```
  *
+ * @example
+ * ```typescript
+ * // Decode intra-only streams (MJPEG, ProRes, ...) on 8 decoder instances
+ * using decoder = await Decoder.create(stream, { parallel: 8 });
+ * ```
+ *
  * @see {@link Encoder} For encoding frames to packets
  * @see {@link MediaInput} For reading media files
  * @see {@link HardwareContext} For GPU acceleration
  */
 export class Decoder implements Disposable {
   private codecContext: CodecContext;
+  private parallel: ParallelDecoder | null;
+  // Frames taken from a saturated pool, returned before the pool's next frames
+  private parallelFrames: Frame[] = [];
   private codec: Codec;
   private frame: Frame;
   private stream: Stream;
@@ -64,12 +73,15 @@ export class Decoder implements Disposable {
    *
    * @param options - Decoder options
    *
+   * @param parallel - Parallel decoder pool for intra-only codecs
+   *
    * Use {@link create} factory method
    *
    * @internal
    */
-  private constructor(codecContext: CodecContext, codec: Codec, stream: Stream, options: DecoderOptions = {}) {
+  private constructor(codecContext: CodecContext, codec: Codec, stream: Stream, options: DecoderOptions = {}, parallel: ParallelDecoder | null = null) {
     this.codecContext = codecContext;
+    this.parallel = parallel;
     this.codec = codec;
     this.stream = stream;
     this.options = options;
@@ -166,8 +178,25 @@ export class Decoder implements Disposable {
       options.hardware = undefined;
     }
 
+    // Decode into arena slots (e.g. shared memory) when requested
+    if (options.frameArena && !options.hardware) {
+      codecContext.setFrameArena(options.frameArena);
+    }
+
     options.exitOnError = options.exitOnError ?? true;
 
+    // Spread intra-only streams across independent decoder instances, the context then only describes the stream
+    if (options.parallel && options.parallel > 1 && !options.hardware && ParallelDecoder.isSupported(stream.codecpar.codecId)) {
+      const parallel = new ParallelDecoder();
+      const parallelOpts = options.options ? Dictionary.fromObject(options.options) : null;
+      const parallelRet = await parallel.open(stream.codecpar, options.parallel, parallelOpts, stream.timeBase);
+      if (parallelRet < 0) {
+        codecContext.freeContext();
+        FFmpegError.throwIfError(parallelRet, 'Failed to open parallel decoder');
+      }
+      return new Decoder(codecContext, codec, stream, options, parallel);
+    }
+
     const opts = options.options ? Dictionary.fromObject(options.options) : undefined;
 
     // Open codec
@@ -268,6 +297,23 @@ export class Decoder implements Disposable {
       options.hardware = undefined;
     }
 
+    // Decode into arena slots (e.g. shared memory) when requested
+    if (options.frameArena && !options.hardware) {
+      codecContext.setFrameArena(options.frameArena);
+    }
+
+    // Spread intra-only streams across independent decoder instances, the context then only describes the stream
+    if (options.parallel && options.parallel > 1 && !options.hardware && ParallelDecoder.isSupported(stream.codecpar.codecId)) {
+      const parallel = new ParallelDecoder();
+      const parallelOpts = options.options ? Dictionary.fromObject(options.options) : null;
+      const parallelRet = parallel.openSync(stream.codecpar, options.parallel, parallelOpts, stream.timeBase);
+      if (parallelRet < 0) {
+        codecContext.freeContext();
+        FFmpegError.throwIfError(parallelRet, 'Failed to open parallel decoder');
+      }
+      return new Decoder(codecContext, codec, stream, options, parallel);
+    }
+
     const opts = options.options ? Dictionary.fromObject(options.options) : undefined;
 
     // Open codec synchronously
@@ -397,6 +443,24 @@ export class Decoder implements Disposable {
       throw new Error('Decoder is closed');
     }
 
+    if (this.parallel) {
+      let sendRet = await this.parallel.sendPacket(packet);
+      while (sendRet === AVERROR_EAGAIN) {
+        // Pool saturated, take frames in order until a slot is free (a suppressed decode error frees one too)
+        const frame = await this.receiveParallel(this.parallel, true);
+        if (frame) {
+          this.parallelFrames.push(frame);
+        }
+        sendRet = await this.parallel.sendPacket(packet);
+      }
+
+      if (sendRet < 0 && sendRet !== AVERROR_EOF && this.options.exitOnError) {
+        FFmpegError.throwIfError(sendRet, 'Failed to send packet');
+      }
+
+      return this.parallelFrames.shift() ?? (await this.receiveParallel(this.parallel, false));
+    }
+
     // Send packet to decoder
     const sendRet = await this.codecContext.sendPacket(packet);
     if (sendRet < 0 && sendRet !== AVERROR_EOF) {
@@ -448,6 +512,24 @@ export class Decoder implements Disposable {
       throw new Error('Decoder is closed');
     }
 
+    if (this.parallel) {
+      let sendRet = this.parallel.sendPacketSync(packet);
+      while (sendRet === AVERROR_EAGAIN) {
+        // Pool saturated, take frames in order until a slot is free (a suppressed decode error frees one too)
+        const frame = this.receiveParallelSync(this.parallel, true);
+        if (frame) {
+          this.parallelFrames.push(frame);
+        }
+        sendRet = this.parallel.sendPacketSync(packet);
+      }
+
+      if (sendRet < 0 && sendRet !== AVERROR_EOF && this.options.exitOnError) {
+        FFmpegError.throwIfError(sendRet, 'Failed to send packet');
+      }
+
+      return this.parallelFrames.shift() ?? this.receiveParallelSync(this.parallel, false);
+    }
+
     // Send packet to decoder
     const sendRet = this.codecContext.sendPacketSync(packet);
     if (sendRet < 0 && sendRet !== AVERROR_EOF) {
@@ -633,7 +715,7 @@ export class Decoder implements Disposable {
     }
 
     // Send flush packet (null)
-    const ret = await this.codecContext.sendPacket(null);
+    const ret = this.parallel ? await this.parallel.sendPacket(null) : await this.codecContext.sendPacket(null);
     if (ret < 0 && ret !== AVERROR_EOF) {
       if (ret !== AVERROR_EAGAIN) {
         FFmpegError.throwIfError(ret, 'Failed to flush decoder');
@@ -669,7 +751,7 @@ export class Decoder implements Disposable {
     }
 
     // Send flush packet (null)
-    const ret = this.codecContext.sendPacketSync(null);
+    const ret = this.parallel ? this.parallel.sendPacketSync(null) : this.codecContext.sendPacketSync(null);
     if (ret < 0 && ret !== AVERROR_EOF) {
       if (ret !== AVERROR_EAGAIN) {
         FFmpegError.throwIfError(ret, 'Failed to flush decoder');
@@ -778,6 +860,10 @@ export class Decoder implements Disposable {
    * @see {@link flush} For signaling end-of-stream
    */
   async receive(): Promise<Frame | null> {
+    if (this.parallel) {
+      return this.parallelFrames.shift() ?? (await this.receiveParallel(this.parallel, false));
+    }
+
     // Clear previous frame data
     this.frame.unref();
 
@@ -836,6 +922,10 @@ export class Decoder implements Disposable {
    * @see {@link receive} For async version
    */
   receiveSync(): Frame | null {
+    if (this.parallel) {
+      return this.parallelFrames.shift() ?? this.receiveParallelSync(this.parallel, false);
+    }
+
     // Clear previous frame data
     this.frame.unref();
 
@@ -884,6 +974,12 @@ export class Decoder implements Disposable {
     this.isClosed = true;
 
     this.frame.free();
+    for (const frame of this.parallelFrames) {
+      frame.free();
+    }
+    this.parallelFrames = [];
+    this.parallel?.close();
+    this.parallel = null;
     this.codecContext.freeContext();
 
     this.initialized = false;
@@ -926,7 +1022,8 @@ export class Decoder implements Disposable {
    *
    * Returns the codec context for advanced operations.
    * Useful for accessing low-level codec properties and settings.
-   * Returns null if decoder is closed.
+   * Returns null if decoder is closed. With a parallel decoder pool the
+   * context describes the stream but is not opened.
    *
    * @returns Codec context or null if closed
    *
@@ -957,4 +1054,83 @@ export class Decoder implements Disposable {
   [Symbol.dispose](): void {
     this.close();
   }
+
+  /**
+   * Receive next frame from the parallel decoder pool.
+   *
+   * Frames are returned in packet submission order.
+   *
+   * @param parallel - Parallel decoder pool
+   *
+   * @param wait - Block until the next frame is decoded
+   *
+   * @returns Cloned frame or null if none available
+   *
+   * @throws {FFmpegError} If receive fails with error other than EAGAIN/EOF
+   *
+   * @internal
+   */
+  private async receiveParallel(parallel: ParallelDecoder, wait: boolean): Promise<Frame | null> {
+    for (;;) {
+      // Clear previous frame data
+      this.frame.unref();
+
+      const ret = await parallel.receiveFrame(this.frame, wait);
+
+      if (ret === 0) {
+        return this.frame.clone();
+      } else if (ret === AVERROR_EAGAIN || ret === AVERROR_EOF) {
+        return null;
+      }
+
+      if (this.options.exitOnError) {
+        FFmpegError.throwIfError(ret, 'Failed to receive frame');
+      }
+      if (ret === AVERROR_EXIT) {
+        // Pool closed
+        return null;
+      }
+      // Suppressed error of one packet, the frames of the following packets are still due
+    }
+  }
+
+  /**
+   * Receive next frame from the parallel decoder pool synchronously.
+   * Synchronous version of receiveParallel.
+   *
+   * @param parallel - Parallel decoder pool
+   *
+   * @param wait - Block until the next frame is decoded
+   *
+   * @returns Cloned frame or null if none available
+   *
+   * @throws {FFmpegError} If receive fails with error other than EAGAIN/EOF
+   *
+   * @internal
+   *
+   * @see {@link receiveParallel} For async version
+   */
+  private receiveParallelSync(parallel: ParallelDecoder, wait: boolean): Frame | null {
+    for (;;) {
+      // Clear previous frame data
+      this.frame.unref();
+
+      const ret = parallel.receiveFrameSync(this.frame, wait);
+
+      if (ret === 0) {
+        return this.frame.clone();
+      } else if (ret === AVERROR_EAGAIN || ret === AVERROR_EOF) {
+        return null;
+      }
+
+      if (this.options.exitOnError) {
+        FFmpegError.throwIfError(ret, 'Failed to receive frame');
+      }
+      if (ret === AVERROR_EXIT) {
+        // Pool closed
+        return null;
+      }
+      // Suppressed error of one packet, the frames of the following packets are still due
+    }
+  }
 }
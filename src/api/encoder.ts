@@ -1,11 +1,16 @@
-import { AVERROR_EAGAIN, AVERROR_EOF } from '../constants/constants.js';
+import { AV_CODEC_FLAG_GLOBAL_HEADER, AVERROR_EAGAIN, AVERROR_EOF } from '../constants/constants.js';
 import { Codec, CodecContext, Dictionary, FFmpegError, Packet, Rational } from '../lib/index.js';
 import { parseBitrate } from './utils.js';
 
 import type { AVCodecID, AVPixelFormat, AVSampleFormat } from '../constants/constants.js';
 import type { FFEncoderCodec } from '../constants/encoders.js';
 import type { Frame } from '../lib/index.js';
-import type { EncoderOptions } from './types.js';
+import type { EncoderOptions, EncoderReconfigureOptions, EncoderReconfigureStats, EncoderSpareOptions } from './types.js';
+
+// Bitrate option value in bits/s
+function toBitRate(value: number | bigint | string): bigint {
+  return typeof value === 'string' ? parseBitrate(value) : BigInt(value);
+}
 
 /**
  * High-level encoder for audio and video streams.
@@ -72,19 +77,28 @@ export class Encoder implements Disposable {
   private initialized = false;
   private isClosed = false;
   private opts?: Dictionary | null;
+  private options: EncoderOptions;
+  private spare: CodecContext | null = null;
+  private pendingPackets: Packet[] = [];
+  private switches = 0;
+  private warmSwitches = 0;
+  private lastSwitchLatency = 0;
 
   /**
    * @param codecContext - Configured codec context
    *
    * @param codec - Encoder codec
    *
+   * @param options - Encoder configuration
+   *
    * @param opts - Encoder options as Dictionary
    *
    * @internal
    */
-  private constructor(codecContext: CodecContext, codec: Codec, opts?: Dictionary | null) {
+  private constructor(codecContext: CodecContext, codec: Codec, options: EncoderOptions, opts?: Dictionary | null) {
     this.codecContext = codecContext;
     this.codec = codec;
+    this.options = options;
     this.opts = opts;
     this.packet = new Packet();
     this.packet.alloc();
@@ -202,6 +216,10 @@ export class Encoder implements Disposable {
       codecContext.threadCount = options.threads;
     }
 
+    if (options.packetAllocator) {
+      codecContext.setPacketAllocator(options.packetAllocator);
+    }
+
     codecContext.timeBase = new Rational(options.timeBase.num, options.timeBase.den);
     codecContext.pktTimebase = new Rational(options.timeBase.num, options.timeBase.den);
 
@@ -211,7 +229,7 @@ export class Encoder implements Disposable {
 
     const opts = options.options ? Dictionary.fromObject(options.options) : undefined;
 
-    return new Encoder(codecContext, codec, opts);
+    return new Encoder(codecContext, codec, options, opts);
   }
 
   /**
@@ -327,6 +345,10 @@ export class Encoder implements Disposable {
       codecContext.threadCount = options.threads;
     }
 
+    if (options.packetAllocator) {
+      codecContext.setPacketAllocator(options.packetAllocator);
+    }
+
     if (options.frameRate) {
       codecContext.framerate = new Rational(options.frameRate.num, options.frameRate.den);
     }
@@ -336,7 +358,7 @@ export class Encoder implements Disposable {
 
     const opts = options.options ? Dictionary.fromObject(options.options) : undefined;
 
-    return new Encoder(codecContext, codec, opts);
+    return new Encoder(codecContext, codec, options, opts);
   }
 
   /**
@@ -467,6 +489,11 @@ export class Encoder implements Disposable {
       await this.initialize(frame);
     }
 
+    // Prepared spare or new size with switchOnResize: continue on another encoder instance
+    if (frame?.isVideo() && this.needsSwitch(frame)) {
+      await this.switchEncoder(frame);
+    }
+
     // Send frame to encoder
     const sendRet = await this.codecContext.sendFrame(frame);
     if (sendRet < 0 && sendRet !== AVERROR_EOF) {
@@ -545,6 +572,11 @@ export class Encoder implements Disposable {
       this.initializeSync(frame);
     }
 
+    // Prepared spare or new size with switchOnResize: continue on another encoder instance
+    if (frame?.isVideo() && this.needsSwitch(frame)) {
+      this.switchEncoderSync(frame);
+    }
+
     // Send frame to encoder
     const sendRet = this.codecContext.sendFrameSync(frame);
     if (sendRet < 0 && sendRet !== AVERROR_EOF) {
@@ -903,6 +935,12 @@ export class Encoder implements Disposable {
       return null;
     }
 
+    // Packets drained from a replaced encoder instance come first
+    const queued = this.pendingPackets.shift();
+    if (queued) {
+      return queued;
+    }
+
     // Clear previous packet data
     this.packet.unref();
 
@@ -964,6 +1002,12 @@ export class Encoder implements Disposable {
       return null;
     }
 
+    // Packets drained from a replaced encoder instance come first
+    const queued = this.pendingPackets.shift();
+    if (queued) {
+      return queued;
+    }
+
     // Clear previous packet data
     this.packet.unref();
 
@@ -982,6 +1026,154 @@ export class Encoder implements Disposable {
     }
   }
 
+  /**
+   * Change rate control or force a keyframe while encoding.
+   *
+   * Applied to the next frame sent, with no reopen. Rate changes need an
+   * encoder that reconfigures while running (libx264, NVENC); others return
+   * AVERROR_ENOSYS, use {@link prepareSpare} with the new rates instead.
+   * Before the encoder is opened the values become part of its configuration.
+   *
+   * @param options - Bitrate, VBV, CRF and keyframe request
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid values
+   *   - AVERROR_ENOSYS: Encoder cannot change rate control while running
+   *
+   * @throws {Error} If encoder is closed
+   *
+   * @example
+   * ```typescript
+   * // Bandwidth estimate dropped
+   * if (encoder.reconfigure({ bitrate: '600k', maxRate: '600k', bufSize: '300k' }) === AVERROR_ENOSYS) {
+   *   await encoder.prepareSpare({ bitrate: '600k', maxRate: '600k', bufSize: '300k' });
+   * }
+   * ```
+   *
+   * @see {@link requestKeyframe} For packet loss recovery
+   * @see {@link getReconfigureStats} For apply latencies
+   */
+  reconfigure(options: EncoderReconfigureOptions): number {
+    if (this.isClosed) {
+      throw new Error('Encoder is closed');
+    }
+
+    return this.codecContext.reconfigure({
+      bitRate: options.bitrate !== undefined ? toBitRate(options.bitrate) : undefined,
+      rcMaxRate: options.maxRate !== undefined ? toBitRate(options.maxRate) : undefined,
+      rcBufferSize: options.bufSize !== undefined ? Number(toBitRate(options.bufSize)) : undefined,
+      crf: options.crf,
+      keyframe: options.keyframe,
+    });
+  }
+
+  /**
+   * Encode the next frame as keyframe.
+   *
+   * Uses an IDR frame where the encoder lets us choose (libx264, NVENC, QSV),
+   * so receivers can resume decoding after packet loss.
+   *
+   * @throws {Error} If encoder is closed
+   *
+   * @throws {FFmpegError} If the request fails
+   *
+   * @example
+   * ```typescript
+   * peer.on('pli', () => encoder.requestKeyframe());
+   * ```
+   */
+  requestKeyframe(): void {
+    FFmpegError.throwIfError(this.reconfigure({ keyframe: true }), 'Failed to request keyframe');
+  }
+
+  /**
+   * Open a spare encoder instance ahead of a switch.
+   *
+   * Opening an encoder (avcodec_open2) takes long enough to stall a live
+   * stream. The spare is opened now with the running configuration plus the
+   * given changes; encoding switches to it with the first frame of the spare's
+   * size. A spare of the current size (e.g. new rates for an encoder without
+   * live rate control) is used with the next frame. Frames of a size with no
+   * spare only switch with the `switchOnResize` option, opening the new
+   * instance on the spot.
+   *
+   * On a switch the running instance is drained and its packets are returned
+   * first; the new instance starts with a keyframe. Extradata is not carried
+   * over and the output stream's codec parameters are not updated, so switching
+   * requires in-band parameter sets (no AV_CODEC_FLAG_GLOBAL_HEADER), e.g. RTP or MPEG-TS.
+   *
+   * @param options - Size and rates of the spare, unset values are kept
+   *
+   * @throws {Error} If encoder is closed, not initialized yet, uses hardware frames or global headers
+   *
+   * @throws {FFmpegError} If the spare cannot be opened
+   *
+   * @example
+   * ```typescript
+   * // Scaler switches to 640x360 soon, have the encoder ready
+   * await encoder.prepareSpare({ width: 640, height: 360, bitrate: '500k' });
+   * ```
+   *
+   * @see {@link prepareSpareSync} For synchronous version
+   */
+  async prepareSpare(options: EncoderSpareOptions = {}): Promise<void> {
+    const spare = this.allocSpare(options);
+
+    const ret = await spare.open2(this.codec, this.opts);
+    if (ret < 0) {
+      spare.freeContext();
+      FFmpegError.throwIfError(ret, 'Failed to open spare encoder');
+    }
+
+    this.spare?.freeContext();
+    this.spare = spare;
+  }
+
+  /**
+   * Open a spare encoder instance ahead of a switch synchronously.
+   * Synchronous version of prepareSpare.
+   *
+   * @param options - Size and rates of the spare, unset values are kept
+   *
+   * @throws {Error} If encoder is closed, not initialized yet, uses hardware frames or global headers
+   *
+   * @throws {FFmpegError} If the spare cannot be opened
+   *
+   * @see {@link prepareSpare} For async version
+   */
+  prepareSpareSync(options: EncoderSpareOptions = {}): void {
+    const spare = this.allocSpare(options);
+
+    const ret = spare.open2Sync(this.codec, this.opts);
+    if (ret < 0) {
+      spare.freeContext();
+      FFmpegError.throwIfError(ret, 'Failed to open spare encoder');
+    }
+
+    this.spare?.freeContext();
+    this.spare = spare;
+  }
+
+  /**
+   * Get runtime reconfiguration statistics.
+   *
+   * @returns Applied changes, forced keyframes, switches and their latencies
+   *
+   * @example
+   * ```typescript
+   * const stats = encoder.getReconfigureStats();
+   * console.log(`Keyframe after ${stats.lastKeyframeLatency.toFixed(1)} ms`);
+   * ```
+   */
+  getReconfigureStats(): EncoderReconfigureStats {
+    return {
+      ...this.codecContext.getReconfigureStats(),
+      switches: this.switches,
+      warmSwitches: this.warmSwitches,
+      lastSwitchLatency: this.lastSwitchLatency,
+    };
+  }
+
   /**
    * Close encoder and free resources.
    *
@@ -1010,6 +1202,12 @@ export class Encoder implements Disposable {
 
     this.packet.free();
     this.codecContext.freeContext();
+    this.spare?.freeContext();
+    this.spare = null;
+    for (const packet of this.pendingPackets) {
+      packet.free();
+    }
+    this.pendingPackets = [];
 
     this.initialized = false;
   }
@@ -1093,6 +1291,277 @@ export class Encoder implements Disposable {
     this.initialized = true;
   }
 
+  /**
+   * Check whether a frame continues on another encoder instance.
+   *
+   * @param frame - Video frame to encode
+   *
+   * @returns True for a prepared spare of the frame's size, or a new size with `switchOnResize`
+   *
+   * @throws {Error} If the size changed without a spare or `switchOnResize`
+   *
+   * @internal
+   */
+  private needsSwitch(frame: Frame): boolean {
+    if (this.spare?.width === frame.width && this.spare.height === frame.height) {
+      return true;
+    }
+    if (frame.width === this.codecContext.width && frame.height === this.codecContext.height) {
+      return false;
+    }
+    if (!this.options.switchOnResize) {
+      throw new Error(
+        `Frame size ${frame.width}x${frame.height} differs from the encoder (${this.codecContext.width}x${this.codecContext.height}), prepare a spare or set switchOnResize`,
+      );
+    }
+    return true;
+  }
+
+  /**
+   * Check that encoding can continue on another instance.
+   *
+   * @throws {Error} If the output relies on global headers
+   *
+   * @internal
+   */
+  private assertSwitchable(): void {
+    // Extradata of the new instance would never reach the already configured output stream
+    if ((this.codecContext.flags & AV_CODEC_FLAG_GLOBAL_HEADER) !== 0) {
+      throw new Error('Switching encoder instances requires in-band parameter sets (AV_CODEC_FLAG_GLOBAL_HEADER is set)');
+    }
+  }
+
+  /**
+   * Allocate a spare codec context with the running configuration.
+   *
+   * @param options - Size and rate changes
+   *
+   * @returns Configured, unopened codec context
+   *
+   * @throws {Error} If encoder is closed, not initialized yet or uses hardware frames
+   *
+   * @internal
+   */
+  private allocSpare(options: EncoderSpareOptions): CodecContext {
+    if (this.isClosed || !this.initialized) {
+      throw new Error('Encoder is not open');
+    }
+    if (this.codecContext.hwFramesCtx) {
+      throw new Error('Spare encoders require software frames');
+    }
+    this.assertSwitchable();
+
+    const spare = new CodecContext();
+    spare.allocContext3(this.codec);
+    this.copyConfiguration(spare, options);
+    return spare;
+  }
+
+  /**
+   * Allocate a codec context for a frame of a size without spare.
+   *
+   * @param frame - First frame for the new instance
+   *
+   * @returns Configured, unopened codec context
+   *
+   * @internal
+   */
+  private allocForFrame(frame: Frame): CodecContext {
+    this.assertSwitchable();
+
+    const context = new CodecContext();
+    context.allocContext3(this.codec);
+    this.copyConfiguration(context, { width: frame.width, height: frame.height });
+
+    context.pixelFormat = frame.format as AVPixelFormat;
+    context.sampleAspectRatio = frame.sampleAspectRatio;
+    context.hwDeviceCtx = frame.hwFramesCtx?.deviceRef ?? null;
+    context.hwFramesCtx = frame.hwFramesCtx;
+    return context;
+  }
+
+  /**
+   * Copy the running configuration to another codec context.
+   *
+   * Rates reflect live changes made with {@link reconfigure}.
+   *
+   * @param context - Unopened codec context
+   *
+   * @param options - Size and rate changes
+   *
+   * @internal
+   */
+  private copyConfiguration(context: CodecContext, options: EncoderSpareOptions): void {
+    const current = this.codecContext;
+
+    context.width = options.width ?? current.width;
+    context.height = options.height ?? current.height;
+    context.pixelFormat = current.pixelFormat;
+    context.sampleAspectRatio = current.sampleAspectRatio;
+    context.timeBase = current.timeBase;
+    context.pktTimebase = current.pktTimebase;
+    context.framerate = current.framerate;
+    context.gopSize = current.gopSize;
+    context.maxBFrames = current.maxBFrames;
+    context.flags = current.flags;
+    context.bitRate = options.bitrate !== undefined ? toBitRate(options.bitrate) : current.bitRate;
+    context.rcMinRate = current.rcMinRate;
+    context.rcMaxRate = options.maxRate !== undefined ? toBitRate(options.maxRate) : current.rcMaxRate;
+    context.rcBufferSize = options.bufSize !== undefined ? Number(toBitRate(options.bufSize)) : current.rcBufferSize;
+
+    if (this.options.threads !== undefined) {
+      context.threadCount = this.options.threads;
+    }
+
+    if (this.options.packetAllocator) {
+      context.setPacketAllocator(this.options.packetAllocator);
+    }
+  }
+
+  /**
+   * Take the prepared spare if it matches the frame's size.
+   *
+   * @param frame - First frame for the new instance
+   *
+   * @returns The spare or null
+   *
+   * @internal
+   */
+  private takeSpare(frame: Frame): CodecContext | null {
+    const spare = this.spare;
+    if (spare?.width !== frame.width || spare.height !== frame.height) {
+      return null;
+    }
+
+    this.spare = null;
+    return spare;
+  }
+
+  /**
+   * Continue encoding on the spare or a new instance for the frame's size.
+   *
+   * Drains the running instance into the packet queue and frees it.
+   *
+   * @param frame - First frame for the new instance
+   *
+   * @throws {Error} If the output relies on global headers
+   *
+   * @throws {FFmpegError} If the new instance cannot be opened or draining fails
+   *
+   * @internal
+   */
+  private async switchEncoder(frame: Frame): Promise<void> {
+    const start = performance.now();
+
+    let next = this.takeSpare(frame);
+    const warm = next !== null;
+
+    if (!next) {
+      next = this.allocForFrame(frame);
+      const openRet = await next.open2(this.codec, this.opts);
+      if (openRet < 0) {
+        next.freeContext();
+        FFmpegError.throwIfError(openRet, 'Failed to open encoder');
+      }
+    }
+
+    // Drain the running instance, receive() returns its packets first
+    const flushRet = await this.codecContext.sendFrame(null);
+    if (flushRet < 0 && flushRet !== AVERROR_EOF) {
+      FFmpegError.throwIfError(flushRet, 'Failed to flush encoder');
+    }
+    while (true) {
+      this.packet.unref();
+      const ret = await this.codecContext.receivePacket(this.packet);
+      if (ret === AVERROR_EAGAIN || ret === AVERROR_EOF) {
+        break;
+      }
+      FFmpegError.throwIfError(ret, 'Failed to receive packet');
+      this.queueDrained();
+    }
+
+    this.finishSwitch(next, warm, start);
+  }
+
+  /**
+   * Continue encoding on the spare or a new instance synchronously.
+   * Synchronous version of switchEncoder.
+   *
+   * @param frame - First frame for the new instance
+   *
+   * @throws {Error} If the output relies on global headers
+   *
+   * @throws {FFmpegError} If the new instance cannot be opened or draining fails
+   *
+   * @internal
+   */
+  private switchEncoderSync(frame: Frame): void {
+    const start = performance.now();
+
+    let next = this.takeSpare(frame);
+    const warm = next !== null;
+
+    if (!next) {
+      next = this.allocForFrame(frame);
+      const openRet = next.open2Sync(this.codec, this.opts);
+      if (openRet < 0) {
+        next.freeContext();
+        FFmpegError.throwIfError(openRet, 'Failed to open encoder');
+      }
+    }
+
+    // Drain the running instance, receiveSync() returns its packets first
+    const flushRet = this.codecContext.sendFrameSync(null);
+    if (flushRet < 0 && flushRet !== AVERROR_EOF) {
+      FFmpegError.throwIfError(flushRet, 'Failed to flush encoder');
+    }
+    while (true) {
+      this.packet.unref();
+      const ret = this.codecContext.receivePacketSync(this.packet);
+      if (ret === AVERROR_EAGAIN || ret === AVERROR_EOF) {
+        break;
+      }
+      FFmpegError.throwIfError(ret, 'Failed to receive packet');
+      this.queueDrained();
+    }
+
+    this.finishSwitch(next, warm, start);
+  }
+
+  /**
+   * Queue a packet drained from the running instance.
+   *
+   * @internal
+   */
+  private queueDrained(): void {
+    const packet = this.packet.clone();
+    if (packet) {
+      this.pendingPackets.push(packet);
+    }
+  }
+
+  /**
+   * Replace the drained instance and record the switch.
+   *
+   * @param next - Opened codec context to continue with
+   *
+   * @param warm - Whether it was a prepared spare
+   *
+   * @param start - performance.now() when the switch started
+   *
+   * @internal
+   */
+  private finishSwitch(next: CodecContext, warm: boolean, start: number): void {
+    this.codecContext.freeContext();
+    this.codecContext = next;
+
+    this.switches++;
+    if (warm) {
+      this.warmSwitches++;
+    }
+    this.lastSwitchLatency = performance.now() - start;
+  }
+
   /**
    * Get encoder codec.
    *
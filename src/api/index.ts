@@ -20,7 +20,7 @@ export { FilterAPI } from './filter.js';
 export { BitStreamFilterAPI } from './bitstream-filter.js';
 
 // Pipeline
-export { pipeline, type NamedInputs, type NamedOutputs, type NamedStages, type PipelineControl, type StreamName } from './pipeline.js';
+export { pipeline, type NamedInputs, type NamedOutputs, type NamedStage, type NamedStages, type PipelineControl, type PipelineOptions, type PipelineQueueStats, type PipelineStageStats, type PipelineStats, type StreamName, type StreamSource } from './pipeline.js';
 
 // Utilities
 export * from './utilities/index.js';
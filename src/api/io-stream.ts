@@ -1,6 +1,7 @@
 import { AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE } from '../constants/constants.js';
 import { IOContext } from '../lib/index.js';
 
+import type { IOCallbackOptions } from '../lib/index.js';
 import type { IOInputCallbacks, MediaInputOptions } from './types.js';
 
 /**
@@ -94,16 +95,17 @@ export class IOStream {
    */
   static create(callbacks: IOInputCallbacks, options?: MediaInputOptions): IOContext;
   static create(input: Buffer | IOInputCallbacks, options: MediaInputOptions = {}): IOContext | Promise<IOContext> {
-    const { bufferSize = 8192 } = options;
+    const { bufferSize = 8192, adaptiveBuffer = false } = options;
+    const callbackOptions: IOCallbackOptions = { adaptive: adaptiveBuffer };
 
     // Handle Buffer
     if (Buffer.isBuffer(input)) {
-      return this.createFromBuffer(input, bufferSize);
+      return this.createFromBuffer(input, bufferSize, callbackOptions);
     }
 
     // Handle custom callbacks
     if (typeof input === 'object' && 'read' in input) {
-      return this.createFromCallbacks(input, bufferSize);
+      return this.createFromCallbacks(input, bufferSize, callbackOptions);
     }
 
     throw new TypeError('Invalid input type. Expected Buffer or IOInputCallbacks');
@@ -119,11 +121,13 @@ export class IOStream {
    *
    * @param bufferSize - Internal buffer size
    *
+   * @param callbackOptions - Adaptive read size
+   *
    * @returns Configured I/O context
    *
    * @internal
    */
-  private static createFromBuffer(buffer: Buffer, bufferSize: number): IOContext {
+  private static createFromBuffer(buffer: Buffer, bufferSize: number, callbackOptions: IOCallbackOptions): IOContext {
     let position = 0;
 
     const ioContext = new IOContext();
@@ -159,6 +163,7 @@ export class IOStream {
         position = Math.max(0, Math.min(position, buffer.length));
         return BigInt(position);
       },
+      callbackOptions,
     );
 
     return ioContext;
@@ -174,13 +179,15 @@ export class IOStream {
    *
    * @param bufferSize - Internal buffer size
    *
+   * @param callbackOptions - Adaptive read size
+   *
    * @returns Configured I/O context
    *
    * @throws {Error} If read callback not provided
    *
    * @internal
    */
-  private static createFromCallbacks(callbacks: IOInputCallbacks, bufferSize: number): IOContext {
+  private static createFromCallbacks(callbacks: IOInputCallbacks, bufferSize: number, callbackOptions: IOCallbackOptions): IOContext {
     // We only support read mode in the high-level API
     // Write mode would be needed for custom output, which we don't currently support
 
@@ -195,6 +202,7 @@ export class IOStream {
       callbacks.read,
       undefined, // No write callback in high-level API
       callbacks.seek,
+      callbackOptions,
     );
 
     return ioContext;
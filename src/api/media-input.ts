@@ -2,12 +2,12 @@ import { closeSync, openSync, readSync } from 'fs';
 import { open } from 'fs/promises';
 import { resolve } from 'path';
 
-import { AVFLAG_NONE, AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_VIDEO } from '../constants/constants.js';
-import { avGetPixFmtName, avGetSampleFmtName, Dictionary, FFmpegError, FormatContext, InputFormat, Packet, Rational } from '../lib/index.js';
+import { AVERROR_ENOSYS, AVFLAG_NONE, AVIO_FLAG_READ, AVMEDIA_TYPE_AUDIO, AVMEDIA_TYPE_VIDEO } from '../constants/constants.js';
+import { avGetPixFmtName, avGetSampleFmtName, Dictionary, FFmpegError, FormatContext, InputFormat, IOContext, Packet, Rational } from '../lib/index.js';
 import { IOStream } from './io-stream.js';
 
 import type { AVMediaType, AVSeekFlag } from '../constants/constants.js';
-import type { IOContext, Stream } from '../lib/index.js';
+import type { PacketTraceOptions, ReadRateStats, Stream } from '../lib/index.js';
 import type { MediaInputOptions, RawData } from './types.js';
 
 /**
@@ -359,6 +359,27 @@ export class MediaInput implements AsyncDisposable, Disposable {
         const isUrl = /^[a-zA-Z][a-zA-Z0-9+.-]*:\/\//.test(input);
         const resolvedInput = isUrl ? input : resolve(input);
 
+        if (options.fileIO && !isUrl) {
+          // Native file backend instead of the file: protocol
+          const fileIO = new IOContext();
+          const openRet = await fileIO.openFile(resolvedInput, AVIO_FLAG_READ, options.fileIO === true ? undefined : options.fileIO);
+          if (openRet !== AVERROR_ENOSYS) {
+            FFmpegError.throwIfError(openRet, 'Failed to open input file');
+            ioContext = fileIO;
+            formatContext.allocContext();
+            formatContext.pb = ioContext;
+          }
+        }
+
+        if (options.httpIO && /^https?:\/\//i.test(input)) {
+          // Native HTTP backend with parallel range prefetching
+          const httpIO = new IOContext();
+          FFmpegError.throwIfError(await httpIO.openHttp(input, options.httpIO === true ? undefined : options.httpIO), 'Failed to open input URL');
+          ioContext = httpIO;
+          formatContext.allocContext();
+          formatContext.pb = ioContext;
+        }
+
         const ret = await formatContext.openInput(resolvedInput, inputFormat, optionsDict);
         FFmpegError.throwIfError(ret, 'Failed to open input');
       } else if (Buffer.isBuffer(input)) {
@@ -368,7 +389,7 @@ export class MediaInput implements AsyncDisposable, Disposable {
         }
         // From buffer - allocate context first for custom I/O
         formatContext.allocContext();
-        ioContext = IOStream.create(input, { bufferSize: options.bufferSize });
+        ioContext = IOStream.create(input, { bufferSize: options.bufferSize, adaptiveBuffer: options.adaptiveBuffer });
         formatContext.pb = ioContext;
         const ret = await formatContext.openInput('', inputFormat, optionsDict);
         FFmpegError.throwIfError(ret, 'Failed to open input from buffer');
@@ -380,6 +401,18 @@ export class MediaInput implements AsyncDisposable, Disposable {
       const ret = await formatContext.findStreamInfo(null);
       FFmpegError.throwIfError(ret, 'Failed to find stream info');
 
+      if (options.packetAllocator) {
+        formatContext.setPacketAllocator(options.packetAllocator);
+      }
+
+      if (options.packetRecorder) {
+        FFmpegError.throwIfError(formatContext.setPacketRecorder(options.packetRecorder), 'Failed to attach packet recorder');
+      }
+
+      if (options.readRate) {
+        FFmpegError.throwIfError(formatContext.setReadRate(options.readRate === true ? {} : options.readRate), 'Failed to set read rate');
+      }
+
       const mediaInput = new MediaInput(formatContext);
       mediaInput.ioContext = ioContext;
 
@@ -511,6 +544,27 @@ export class MediaInput implements AsyncDisposable, Disposable {
         const isUrl = /^[a-zA-Z][a-zA-Z0-9+.-]*:\/\//.test(input);
         const resolvedInput = isUrl ? input : resolve(input);
 
+        if (options.fileIO && !isUrl) {
+          // Native file backend instead of the file: protocol
+          const fileIO = new IOContext();
+          const openRet = fileIO.openFileSync(resolvedInput, AVIO_FLAG_READ, options.fileIO === true ? undefined : options.fileIO);
+          if (openRet !== AVERROR_ENOSYS) {
+            FFmpegError.throwIfError(openRet, 'Failed to open input file');
+            ioContext = fileIO;
+            formatContext.allocContext();
+            formatContext.pb = ioContext;
+          }
+        }
+
+        if (options.httpIO && /^https?:\/\//i.test(input)) {
+          // Native HTTP backend with parallel range prefetching
+          const httpIO = new IOContext();
+          FFmpegError.throwIfError(httpIO.openHttpSync(input, options.httpIO === true ? undefined : options.httpIO), 'Failed to open input URL');
+          ioContext = httpIO;
+          formatContext.allocContext();
+          formatContext.pb = ioContext;
+        }
+
         const ret = formatContext.openInputSync(resolvedInput, inputFormat, optionsDict);
         FFmpegError.throwIfError(ret, 'Failed to open input');
       } else {
@@ -521,6 +575,18 @@ export class MediaInput implements AsyncDisposable, Disposable {
       const ret = formatContext.findStreamInfoSync(null);
       FFmpegError.throwIfError(ret, 'Failed to find stream info');
 
+      if (options.packetAllocator) {
+        formatContext.setPacketAllocator(options.packetAllocator);
+      }
+
+      if (options.packetRecorder) {
+        FFmpegError.throwIfError(formatContext.setPacketRecorder(options.packetRecorder), 'Failed to attach packet recorder');
+      }
+
+      if (options.readRate) {
+        FFmpegError.throwIfError(formatContext.setReadRate(options.readRate === true ? {} : options.readRate), 'Failed to set read rate');
+      }
+
       const mediaInput = new MediaInput(formatContext);
       mediaInput.ioContext = ioContext;
 
@@ -547,6 +613,96 @@ export class MediaInput implements AsyncDisposable, Disposable {
     }
   }
 
+  /**
+   * Open a packet trace as input.
+   *
+   * Replays a trace captured with {@link MediaInputOptions.packetRecorder}: the
+   * recorded streams with their codec parameters, then the recorded packets in
+   * their original order. Decoders and pipelines consume it like any other
+   * input, which makes benchmarks of live or unreliable sources repeatable.
+   *
+   * @param path - Trace file path
+   *
+   * @param options - Replay pacing and packet allocator
+   *
+   * @returns Opened media input instance
+   *
+   * @throws {FFmpegError} If the trace cannot be opened
+   *
+   * @example
+   * ```typescript
+   * // Replay at the recorded arrival times
+   * await using input = await MediaInput.openTrace('capture.trace', { realtime: true });
+   * using decoder = await Decoder.create(input.video()!);
+   * for await (const frame of decoder.frames(input.packets())) {
+   *   frame.free();
+   * }
+   * ```
+   *
+   * @see {@link PacketRecorder} For capturing traces
+   */
+  static async openTrace(path: string, options: PacketTraceOptions & Pick<MediaInputOptions, 'packetAllocator'> = {}): Promise<MediaInput> {
+    const formatContext = new FormatContext();
+
+    try {
+      const ret = await formatContext.openTrace(resolve(path), { realtime: options.realtime, speed: options.speed });
+      FFmpegError.throwIfError(ret, 'Failed to open trace');
+
+      if (options.packetAllocator) {
+        formatContext.setPacketAllocator(options.packetAllocator);
+      }
+
+      const mediaInput = new MediaInput(formatContext);
+      mediaInput._streams = formatContext.streams ?? [];
+      return mediaInput;
+    } catch (error) {
+      await formatContext.closeInput();
+      throw error;
+    }
+  }
+
+  /**
+   * Open a packet trace as input synchronously.
+   * Synchronous version of openTrace.
+   *
+   * @param path - Trace file path
+   *
+   * @param options - Replay pacing and packet allocator
+   *
+   * @returns Opened media input instance
+   *
+   * @throws {FFmpegError} If the trace cannot be opened
+   *
+   * @example
+   * ```typescript
+   * using input = MediaInput.openTraceSync('capture.trace');
+   * for (const packet of input.packetsSync()) {
+   *   packet.free();
+   * }
+   * ```
+   *
+   * @see {@link openTrace} For async version
+   */
+  static openTraceSync(path: string, options: PacketTraceOptions & Pick<MediaInputOptions, 'packetAllocator'> = {}): MediaInput {
+    const formatContext = new FormatContext();
+
+    try {
+      const ret = formatContext.openTraceSync(resolve(path), { realtime: options.realtime, speed: options.speed });
+      FFmpegError.throwIfError(ret, 'Failed to open trace');
+
+      if (options.packetAllocator) {
+        formatContext.setPacketAllocator(options.packetAllocator);
+      }
+
+      const mediaInput = new MediaInput(formatContext);
+      mediaInput._streams = formatContext.streams ?? [];
+      return mediaInput;
+    } catch (error) {
+      formatContext.closeInputSync();
+      throw error;
+    }
+  }
+
   /**
    * Get all streams in the media.
    *
@@ -947,6 +1103,28 @@ export class MediaInput implements AsyncDisposable, Disposable {
     return this.formatContext.seekFrameSync(streamIndex, ts, flags);
   }
 
+  /**
+   * Get read pacing statistics.
+   *
+   * Lateness shows how far the source or the consumer falls behind real time
+   * when reading with {@link MediaInputOptions.readRate}.
+   *
+   * @returns Statistics, or null if the input is not paced
+   *
+   * @example
+   * ```typescript
+   * await using input = await MediaInput.open('video.mp4', { readRate: true });
+   * for await (const packet of input.packets()) {
+   *   // ...
+   *   packet.free();
+   * }
+   * console.log(input.getReadRateStats());
+   * ```
+   */
+  getReadRateStats(): ReadRateStats | null {
+    return this.formatContext.getReadRateStats();
+  }
+
   /**
    * Close media input and free resources.
    *
@@ -2,7 +2,7 @@ import { mkdirSync } from 'fs';
 import { mkdir } from 'fs/promises';
 import { dirname, resolve } from 'path';
 
-import { AVFMT_FLAG_CUSTOM_IO, AVFMT_NOFILE, AVIO_FLAG_WRITE } from '../constants/constants.js';
+import { AVERROR_ENOSYS, AVFMT_FLAG_CUSTOM_IO, AVFMT_NOFILE, AVIO_FLAG_WRITE } from '../constants/constants.js';
 import { FFmpegError, FormatContext, IOContext, Rational } from '../lib/index.js';
 import { Encoder } from './encoder.js';
 
@@ -164,7 +164,14 @@ export class MediaOutput implements AsyncDisposable, Disposable {
           // For file-based formats, we need to open the file using avio_open2
           // FFmpeg will manage the AVIOContext internally
           output.ioContext = new IOContext();
-          const openRet = await output.ioContext.open2(resolvedTarget, AVIO_FLAG_WRITE);
+          let openRet: number = AVERROR_ENOSYS;
+          if (options?.fileIO && !isUrl) {
+            // Native file backend instead of the file: protocol
+            openRet = await output.ioContext.openFile(resolvedTarget, AVIO_FLAG_WRITE, options.fileIO === true ? undefined : options.fileIO);
+          }
+          if (openRet === AVERROR_ENOSYS) {
+            openRet = await output.ioContext.open2(resolvedTarget, AVIO_FLAG_WRITE);
+          }
           FFmpegError.throwIfError(openRet, `Failed to open output file: ${resolvedTarget}`);
           output.formatContext.pb = output.ioContext;
         }
@@ -276,7 +283,14 @@ export class MediaOutput implements AsyncDisposable, Disposable {
           // For file-based formats, we need to open the file using avio_open2
           // FFmpeg will manage the AVIOContext internally
           output.ioContext = new IOContext();
-          const openRet = output.ioContext.open2Sync(resolvedTarget, AVIO_FLAG_WRITE);
+          let openRet: number = AVERROR_ENOSYS;
+          if (options?.fileIO && !isUrl) {
+            // Native file backend instead of the file: protocol
+            openRet = output.ioContext.openFileSync(resolvedTarget, AVIO_FLAG_WRITE, options.fileIO === true ? undefined : options.fileIO);
+          }
+          if (openRet === AVERROR_ENOSYS) {
+            openRet = output.ioContext.open2Sync(resolvedTarget, AVIO_FLAG_WRITE);
+          }
           FFmpegError.throwIfError(openRet, `Failed to open output file: ${resolvedTarget}`);
           output.formatContext.pb = output.ioContext;
         }
@@ -482,37 +496,10 @@ export class MediaOutput implements AsyncDisposable, Disposable {
       throw new Error(`Invalid stream index: ${streamIndex}`);
     }
 
-    // Initialize any encoder streams that are ready
-    for (const streamInfo of this.streams.values()) {
-      if (!streamInfo.initialized && streamInfo.source instanceof Encoder) {
-        const encoder = streamInfo.source;
-        const codecContext = encoder.getCodecContext();
-
-        // Skip if encoder not ready yet
-        if (!encoder.isEncoderInitialized || !codecContext) {
-          continue;
-        }
-
-        // This encoder is ready, initialize it now
-        const ret = streamInfo.stream.codecpar.fromContext(codecContext);
-        FFmpegError.throwIfError(ret, 'Failed to copy codec parameters from encoder');
-
-        // Update the timebase from the encoder
-        streamInfo.sourceTimeBase = codecContext.timeBase;
-
-        // Output stream uses encoder's timebase (or custom if specified)
-        streamInfo.stream.timeBase = streamInfo.timeBase ? new Rational(streamInfo.timeBase.num, streamInfo.timeBase.den) : codecContext.timeBase;
-
-        // Mark as initialized
-        streamInfo.initialized = true;
-      }
-    }
-
     const streamInfo = this.streams.get(streamIndex)!;
 
-    // Check if any streams are still uninitialized
-    const uninitialized = Array.from(this.streams.values()).some((s) => !s.initialized);
-    if (uninitialized) {
+    // Buffer until every encoder stream is ready
+    if (!this.initializeStreams()) {
       const clonedPacket = packet.clone();
       packet.free();
       if (clonedPacket) {
@@ -627,37 +614,10 @@ export class MediaOutput implements AsyncDisposable, Disposable {
       throw new Error(`Invalid stream index: ${streamIndex}`);
     }
 
-    // Initialize any encoder streams that are ready
-    for (const streamInfo of this.streams.values()) {
-      if (!streamInfo.initialized && streamInfo.source instanceof Encoder) {
-        const encoder = streamInfo.source;
-        const codecContext = encoder.getCodecContext();
-
-        // Skip if encoder not ready yet
-        if (!encoder.isEncoderInitialized || !codecContext) {
-          continue;
-        }
-
-        // This encoder is ready, initialize it now
-        const ret = streamInfo.stream.codecpar.fromContext(codecContext);
-        FFmpegError.throwIfError(ret, 'Failed to copy codec parameters from encoder');
-
-        // Update the timebase from the encoder
-        streamInfo.sourceTimeBase = codecContext.timeBase;
-
-        // Output stream uses encoder's timebase (or custom if specified)
-        streamInfo.stream.timeBase = streamInfo.timeBase ? new Rational(streamInfo.timeBase.num, streamInfo.timeBase.den) : codecContext.timeBase;
-
-        // Mark as initialized
-        streamInfo.initialized = true;
-      }
-    }
-
     const streamInfo = this.streams.get(streamIndex)!;
 
-    // Check if any streams are still uninitialized
-    const uninitialized = Array.from(this.streams.values()).some((s) => !s.initialized);
-    if (uninitialized) {
+    // Buffer until every encoder stream is ready
+    if (!this.initializeStreams()) {
       const clonedPacket = packet.clone();
       packet.free();
       if (clonedPacket) {
@@ -874,6 +834,37 @@ export class MediaOutput implements AsyncDisposable, Disposable {
     }
   }
 
+  /**
+   * Write the header as soon as every stream is initialized.
+   *
+   * Used by pipelines that write stream copy packets natively, where no
+   * packet passes through {@link writePacket} to trigger the header.
+   *
+   * @returns True if the header has been written
+   *
+   * @internal
+   */
+  async ensureHeader(): Promise<boolean> {
+    if (this.isClosed || this.trailerWritten) {
+      return false;
+    }
+
+    if (!this.initializeStreams()) {
+      return false;
+    }
+
+    if (!this.headerWritten) {
+      this.headerWritePromise ??= (async () => {
+        const ret = await this.formatContext.writeHeader();
+        FFmpegError.throwIfError(ret, 'Failed to write header');
+        this.headerWritten = true;
+      })();
+      await this.headerWritePromise;
+    }
+
+    return true;
+  }
+
   /**
    * Get underlying format context.
    *
@@ -926,4 +917,42 @@ export class MediaOutput implements AsyncDisposable, Disposable {
   [Symbol.dispose](): void {
     this.closeSync();
   }
+
+  /**
+   * Initialize encoder streams whose encoder is ready.
+   *
+   * Copies codec parameters and time base from the opened encoder.
+   *
+   * @returns True if every stream is initialized
+   *
+   * @internal
+   */
+  private initializeStreams(): boolean {
+    for (const streamInfo of this.streams.values()) {
+      if (!streamInfo.initialized && streamInfo.source instanceof Encoder) {
+        const encoder = streamInfo.source;
+        const codecContext = encoder.getCodecContext();
+
+        // Skip if encoder not ready yet
+        if (!encoder.isEncoderInitialized || !codecContext) {
+          continue;
+        }
+
+        // This encoder is ready, initialize it now
+        const ret = streamInfo.stream.codecpar.fromContext(codecContext);
+        FFmpegError.throwIfError(ret, 'Failed to copy codec parameters from encoder');
+
+        // Update the timebase from the encoder
+        streamInfo.sourceTimeBase = codecContext.timeBase;
+
+        // Output stream uses encoder's timebase (or custom if specified)
+        streamInfo.stream.timeBase = streamInfo.timeBase ? new Rational(streamInfo.timeBase.num, streamInfo.timeBase.den) : codecContext.timeBase;
+
+        // Mark as initialized
+        streamInfo.initialized = true;
+      }
+    }
+
+    return Array.from(this.streams.values()).every((s) => s.initialized);
+  }
 }
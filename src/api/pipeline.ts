@@ -4,7 +4,20 @@
  * Provides a fluent API for building transcoding, filtering, and stream processing pipelines.
  */
 
-import type { Frame, Packet } from '../lib/index.js';
+import {
+  AV_NOPTS_VALUE,
+  AVERROR_EAGAIN,
+  AVERROR_EOF,
+  AVMEDIA_TYPE_ATTACHMENT,
+  AVMEDIA_TYPE_AUDIO,
+  AVMEDIA_TYPE_DATA,
+  AVMEDIA_TYPE_SUBTITLE,
+  AVMEDIA_TYPE_VIDEO,
+} from '../constants/constants.js';
+import { FFmpegError, Packet, PacketRouter } from '../lib/index.js';
+
+import type { AVMediaType } from '../constants/constants.js';
+import type { Frame, IRational } from '../lib/index.js';
 import type { Stream } from '../lib/stream.js';
 import type { BitStreamFilterAPI } from './bitstream-filter.js';
 import type { Decoder } from './decoder.js';
@@ -13,16 +26,35 @@ import type { FilterAPI } from './filter.js';
 import type { MediaInput } from './media-input.js';
 import type { MediaOutput } from './media-output.js';
 
-// Restrict stream names to known types
-export type StreamName = 'video' | 'audio';
+/**
+ * Name of a stream in a named pipeline.
+ *
+ * 'video' and 'audio' select the first stream of that type. Any other name selects the
+ * stream of the stage's decoder or bitstream filter, or is parsed as a stream index ('2')
+ * or a type specifier ('v', 'a:1', 's:0', 'd', 't'). Use a {@link StreamSource} to pick
+ * the stream explicitly.
+ */
+export type StreamName = string;
+
+/**
+ * Explicit stream of an input for named pipelines.
+ *
+ * @example
+ * ```typescript
+ * { input, stream: 3 }      // Stream index
+ * { input, stream: 'a:1' }  // Second audio stream
+ * ```
+ */
+export interface StreamSource {
+  input: MediaInput;
+  stream: number | string;
+}
+
+export type NamedStage = Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[];
 
-// Better type definitions with proper inference
-export type NamedInputs<K extends StreamName = StreamName> = Pick<Record<StreamName, MediaInput>, K>;
-export type NamedStages<K extends StreamName = StreamName> = Pick<
-  Record<StreamName, (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[])[] | 'passthrough'>,
-  K
->;
-export type NamedOutputs<K extends StreamName = StreamName> = Pick<Record<StreamName, MediaOutput>, K>;
+export type NamedInputs<K extends StreamName = StreamName> = Record<K, MediaInput | StreamSource>;
+export type NamedStages<K extends StreamName = StreamName> = Record<K, NamedStage[] | 'passthrough'>;
+export type NamedOutputs<K extends StreamName = StreamName> = Record<K, MediaOutput>;
 
 /**
  * Internal metadata for tracking stream components.
@@ -38,6 +70,138 @@ interface StreamMetadata {
   mediaInput?: MediaInput; // Track source MediaInput for stream copy
 }
 
+/**
+ * Pipeline options.
+ *
+ * Passed as last argument to {@link pipeline}.
+ *
+ * @example
+ * ```typescript
+ * const control = pipeline(input, decoder, filter, encoder, output, { queueDepth: 8 });
+ * ```
+ */
+export interface PipelineOptions {
+  /**
+   * Maximum number of packets or frames buffered behind each stage (default: 4).
+   *
+   * Every stage (read, decode, filter, encode, bitstream filter) runs as its own loop
+   * and hands its output to the next stage through a queue of this size, so the stages
+   * work at the same time on the thread pool. Deeper queues absorb jitter at the cost of
+   * memory (decoded frames). Keep it small with hardware decoders, whose frame pools are
+   * limited. 0 disables buffering and runs the stages one after another.
+   */
+  queueDepth?: number;
+
+  /**
+   * Called with {@link PipelineControl.stats} every `statsInterval` milliseconds
+   * and once more when the pipeline completes.
+   */
+  onStats?: (stats: PipelineStats) => void;
+
+  /**
+   * Interval for {@link onStats} in milliseconds (default: 1000).
+   */
+  statsInterval?: number;
+}
+
+/**
+ * Queue between two pipeline stages.
+ */
+export interface PipelineQueueStats {
+  /** Stage filling the queue */
+  stage: 'read' | 'decode' | 'filter' | 'encode' | 'bsf';
+
+  /** Named stream, for named pipelines */
+  stream?: StreamName;
+
+  /** Items currently queued */
+  depth: number;
+
+  /** Highest depth reached */
+  maxDepth: number;
+
+  /** Queue capacity */
+  capacity: number;
+}
+
+/**
+ * Counters of one pipeline stage.
+ *
+ * Times are measured around the native calls of the stage loop. `busyTime` is
+ * spent in the stage itself, `upstreamWaitTime` waiting for input and
+ * `downstreamWaitTime` waiting for the next stage to take the output.
+ */
+export interface PipelineStageStats {
+  /** Stage kind, 'write' is the muxer */
+  stage: 'read' | 'decode' | 'filter' | 'encode' | 'bsf' | 'write';
+
+  /** Named stream, for named pipelines */
+  stream?: StreamName;
+
+  /** Packets received */
+  packetsIn: number;
+
+  /** Frames received */
+  framesIn: number;
+
+  /** Packets produced */
+  packetsOut: number;
+
+  /** Frames produced */
+  framesOut: number;
+
+  /** Payload bytes of received packets */
+  bytesIn: number;
+
+  /** Payload bytes of produced packets */
+  bytesOut: number;
+
+  /** Time spent working in milliseconds */
+  busyTime: number;
+
+  /** Time spent waiting for input in milliseconds */
+  upstreamWaitTime: number;
+
+  /** Time spent waiting for the next stage in milliseconds */
+  downstreamWaitTime: number;
+
+  /** Items produced (written for 'write') per second over the last second */
+  fps: number;
+
+  /** Media time processed per wall clock time, 0 if timestamps are unknown */
+  speed: number;
+
+  /**
+   * Items lost by the stage: frames removed by a video filter (e.g. `fps`), and
+   * items discarded because the pipeline stopped. Frames held by a filter count
+   * as removed until the filter releases them.
+   */
+  dropped: number;
+
+  /** Frames added by a video filter (e.g. `fps`) */
+  duplicated: number;
+
+  /** Queue behind the stage */
+  queue?: PipelineQueueStats;
+}
+
+/**
+ * Statistics of a running pipeline.
+ */
+export interface PipelineStats {
+  /** Time since the first stage started in milliseconds */
+  elapsedTime: number;
+
+  /** Speed of the slowest written stream (1 = realtime), 0 if unknown */
+  speed: number;
+
+  /** Stage with the most busy time, the one limiting throughput */
+  bottleneck?: Pick<PipelineStageStats, 'stage' | 'stream'>;
+
+  /** Stages in pipeline order. Streams copied natively are not listed. */
+  stages: PipelineStageStats[];
+}
+
 /**
  * Pipeline control interface for managing pipeline execution.
  * Allows graceful stopping and completion tracking of running pipelines.
@@ -67,6 +231,26 @@ export interface PipelineControl {
    */
   isStopped(): boolean;
 
+  /**
+   * Get the queues between the pipeline stages.
+   *
+   * A queue that stays full points at a slow consumer (the next stage),
+   * a queue that stays empty at a slow producer.
+   *
+   * @returns Queues in stage order, empty for stream copy or `queueDepth: 0`
+   */
+  getQueueStats(): PipelineQueueStats[];
+
+  /**
+   * Get live per-stage statistics.
+   *
+   * Cheap enough to call at any time, see {@link PipelineOptions.onStats}
+   * to receive them periodically.
+   *
+   * @returns Snapshot of the pipeline counters
+   */
+  stats(): PipelineStats;
+
   /**
    * Promise that resolves when the pipeline completes.
    * Resolves when all processing is finished or the pipeline is stopped.
@@ -89,6 +273,8 @@ export interface PipelineControl {
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -97,7 +283,7 @@ export interface PipelineControl {
  * await control.completion;
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder, output: MediaOutput): PipelineControl;
+export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder, output: MediaOutput, options?: PipelineOptions): PipelineControl;
 
 /**
  * Full transcoding pipeline with filter: input → decoder → filter → encoder → output.
@@ -112,6 +298,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder,
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -120,7 +308,14 @@ export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder,
  * await control.completion;
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI | FilterAPI[], encoder: Encoder, output: MediaOutput): PipelineControl;
+export function pipeline(
+  source: MediaInput,
+  decoder: Decoder,
+  filter: FilterAPI | FilterAPI[],
+  encoder: Encoder,
+  output: MediaOutput,
+  options?: PipelineOptions,
+): PipelineControl;
 
 /**
  * Transcoding with bitstream filter: input → decoder → encoder → bsf → output.
@@ -135,6 +330,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -146,7 +343,14 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  * await control.completion;
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder, bsf: BitStreamFilterAPI | BitStreamFilterAPI[], output: MediaOutput): PipelineControl;
+export function pipeline(
+  source: MediaInput,
+  decoder: Decoder,
+  encoder: Encoder,
+  bsf: BitStreamFilterAPI | BitStreamFilterAPI[],
+  output: MediaOutput,
+  options?: PipelineOptions,
+): PipelineControl;
 
 /**
  * Full pipeline with filter and bsf: input → decoder → filter → encoder → bsf → output.
@@ -163,6 +367,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder,
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -182,6 +388,7 @@ export function pipeline(
   encoder: Encoder,
   bsf: BitStreamFilterAPI | BitStreamFilterAPI[],
   output: MediaOutput,
+  options?: PipelineOptions,
 ): PipelineControl;
 
 /**
@@ -199,6 +406,8 @@ export function pipeline(
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -211,7 +420,15 @@ export function pipeline(
  * await control.completion;
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, filter1: FilterAPI, filter2: FilterAPI, encoder: Encoder, output: MediaOutput): PipelineControl;
+export function pipeline(
+  source: MediaInput,
+  decoder: Decoder,
+  filter1: FilterAPI,
+  filter2: FilterAPI,
+  encoder: Encoder,
+  output: MediaOutput,
+  options?: PipelineOptions,
+): PipelineControl;
 
 /**
  * Stream copy pipeline: input → output (copies all streams).
@@ -240,6 +457,8 @@ export function pipeline(source: MediaInput, output: MediaOutput): PipelineContr
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -250,7 +469,7 @@ export function pipeline(source: MediaInput, output: MediaOutput): PipelineContr
  * await control.completion;
  * ```
  */
-export function pipeline(source: MediaInput, bsf: BitStreamFilterAPI | BitStreamFilterAPI[], output: MediaOutput): PipelineControl;
+export function pipeline(source: MediaInput, bsf: BitStreamFilterAPI | BitStreamFilterAPI[], output: MediaOutput, options?: PipelineOptions): PipelineControl;
 
 /**
  * Filter + encode + output: frames → filter → encoder → output.
@@ -263,6 +482,8 @@ export function pipeline(source: MediaInput, bsf: BitStreamFilterAPI | BitStream
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -275,7 +496,13 @@ export function pipeline(source: MediaInput, bsf: BitStreamFilterAPI | BitStream
  * await control.completion;
  * ```
  */
-export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | FilterAPI[], encoder: Encoder, output: MediaOutput): PipelineControl;
+export function pipeline(
+  source: AsyncIterable<Frame>,
+  filter: FilterAPI | FilterAPI[],
+  encoder: Encoder,
+  output: MediaOutput,
+  options?: PipelineOptions,
+): PipelineControl;
 
 /**
  * Encode + output: frames → encoder → output.
@@ -286,6 +513,8 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
  *
  * @param output - Media output destination
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -297,7 +526,7 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
  * await control.completion;
  * ```
  */
-export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder, output: MediaOutput): PipelineControl;
+export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder, output: MediaOutput, options?: PipelineOptions): PipelineControl;
 
 /**
  * Partial pipeline: input → decoder (returns frames).
@@ -306,6 +535,8 @@ export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder, output:
  *
  * @param decoder - Decoder for decoding packets
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of frames
  *
  * @example
@@ -319,7 +550,7 @@ export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder, output:
  * }
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder): AsyncGenerator<Frame>;
+export function pipeline(source: MediaInput, decoder: Decoder, options?: PipelineOptions): AsyncGenerator<Frame>;
 
 /**
  * Partial pipeline: input → decoder → filter (returns frames).
@@ -330,6 +561,8 @@ export function pipeline(source: MediaInput, decoder: Decoder): AsyncGenerator<F
  *
  * @param filter - Filter or filter chain
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of frames
  *
  * @example
@@ -344,7 +577,7 @@ export function pipeline(source: MediaInput, decoder: Decoder): AsyncGenerator<F
  * }
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI | FilterAPI[]): AsyncGenerator<Frame>;
+export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI | FilterAPI[], options?: PipelineOptions): AsyncGenerator<Frame>;
 
 /**
  * Partial pipeline: input → decoder → filter → encoder (returns packets).
@@ -357,6 +590,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  *
  * @param encoder - Encoder for encoding frames
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of packets
  *
  * @example
@@ -372,7 +607,7 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  * }
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI | FilterAPI[], encoder: Encoder): AsyncGenerator<Packet>;
+export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI | FilterAPI[], encoder: Encoder, options?: PipelineOptions): AsyncGenerator<Packet>;
 
 /**
  * Partial pipeline: input → decoder → encoder (returns packets).
@@ -383,6 +618,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  *
  * @param encoder - Encoder for encoding frames
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of packets
  *
  * @example
@@ -397,7 +634,7 @@ export function pipeline(source: MediaInput, decoder: Decoder, filter: FilterAPI
  * }
  * ```
  */
-export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder): AsyncGenerator<Packet>;
+export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder, options?: PipelineOptions): AsyncGenerator<Packet>;
 
 /**
  * Partial pipeline: frames → filter (returns frames).
@@ -406,6 +643,8 @@ export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder)
  *
  * @param filter - Filter or filter chain
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of filtered frames
  *
  * @example
@@ -420,7 +659,7 @@ export function pipeline(source: MediaInput, decoder: Decoder, encoder: Encoder)
  * }
  * ```
  */
-export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | FilterAPI[]): AsyncGenerator<Frame>;
+export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | FilterAPI[], options?: PipelineOptions): AsyncGenerator<Frame>;
 
 /**
  * Partial pipeline: frames → encoder (returns packets).
@@ -429,6 +668,8 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
  *
  * @param encoder - Encoder for encoding frames
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of packets
  *
  * @example
@@ -443,7 +684,7 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
  * }
  * ```
  */
-export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder): AsyncGenerator<Packet>;
+export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder, options?: PipelineOptions): AsyncGenerator<Packet>;
 
 /**
  * Partial pipeline: frames → filter → encoder (returns packets).
@@ -454,6 +695,8 @@ export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder): AsyncG
  *
  * @param encoder - Encoder for encoding frames
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Async generator of packets
  *
  * @example
@@ -469,7 +712,7 @@ export function pipeline(source: AsyncIterable<Frame>, encoder: Encoder): AsyncG
  * }
  * ```
  */
-export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | FilterAPI[], encoder: Encoder): AsyncGenerator<Packet>;
+export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | FilterAPI[], encoder: Encoder, options?: PipelineOptions): AsyncGenerator<Packet>;
 
 // ============================================================================
 // Named Pipeline Overloads (multiple streams, variable parameters)
@@ -478,12 +721,18 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
 /**
  * Named pipeline with single output - all streams go to the same output.
  *
- * @param inputs - Named input sources (video/audio)
+ * Any number of streams can be named. Each input is demuxed once by a native
+ * packet router: passthrough streams are copied into the output without
+ * reaching JS, processed streams run concurrently.
+ *
+ * @param inputs - Named input sources (MediaInput or { input, stream })
  *
  * @param stages - Named processing stages for each stream
  *
  * @param output - Single output destination for all streams
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -499,18 +748,36 @@ export function pipeline(source: AsyncIterable<Frame>, filter: FilterAPI | Filte
  * );
  * await control.completion;
  * ```
+ *
+ * @example
+ * ```typescript
+ * // Transcode video, copy every audio track and subtitles by specifier or index
+ * const control = pipeline(
+ *   { video: input, a0: input, a1: input, a2: input, subs: { input, stream: 5 } },
+ *   {
+ *     video: [videoDecoder, videoEncoder],
+ *     a0: 'passthrough',
+ *     a1: 'passthrough',
+ *     a2: 'passthrough',
+ *     subs: 'passthrough'
+ *   },
+ *   output
+ * );
+ * ```
  */
-export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>, output: MediaOutput): PipelineControl;
+export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>, output: MediaOutput, options?: PipelineOptions): PipelineControl;
 
 /**
  * Named pipeline with multiple outputs - each stream has its own output.
  *
- * @param inputs - Named input sources (video/audio)
+ * @param inputs - Named input sources (MediaInput or { input, stream })
  *
  * @param stages - Named processing stages for each stream
  *
  * @param outputs - Named output destinations
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Pipeline control for managing execution
  *
  * @example
@@ -527,15 +794,20 @@ export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: N
  * await control.completion;
  * ```
  */
-export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>, outputs: NamedOutputs<K>): PipelineControl;
+export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>, outputs: NamedOutputs<K>, options?: PipelineOptions): PipelineControl;
 
 /**
  * Partial named pipeline (returns generators for further processing).
  *
- * @param inputs - Named input sources
+ * Generators of the same input share one native reader and must be consumed
+ * concurrently; return a generator early to stop receiving its stream.
+ *
+ * @param inputs - Named input sources (MediaInput or { input, stream })
  *
  * @param stages - Named processing stages
  *
+ * @param options - Pipeline options (stage queue depth)
+ *
  * @returns Record of async generators for each stream
  *
  * @example
@@ -553,16 +825,26 @@ export function pipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: N
  * const videoGenerator = generators.video;
  * const audioGenerator = generators.audio;
  *
- * // Use the generators
- * for await (const packet of videoGenerator) {
- *   // Process video packet
- * }
- * for await (const packet of audioGenerator) {
- *   // Process audio packet
- * }
+ * // Use the generators concurrently
+ * await Promise.all([
+ *   (async () => {
+ *     for await (const packet of videoGenerator) {
+ *       // Process video packet
+ *     }
+ *   })(),
+ *   (async () => {
+ *     for await (const packet of audioGenerator) {
+ *       // Process audio packet
+ *     }
+ *   })(),
+ * ]);
  * ```
  */
-export function pipeline<K extends StreamName, T extends Packet | Frame = Packet | Frame>(inputs: NamedInputs<K>, stages: NamedStages<K>): Record<K, AsyncGenerator<T>>;
+export function pipeline<K extends StreamName, T extends Packet | Frame = Packet | Frame>(
+  inputs: NamedInputs<K>,
+  stages: NamedStages<K>,
+  options?: PipelineOptions,
+): Record<K, AsyncGenerator<T>>;
 
 // ============================================================================
 // Implementation
@@ -574,7 +856,7 @@ export function pipeline<K extends StreamName, T extends Packet | Frame = Packet
  * Creates a processing pipeline from media components.
  * Automatically handles type conversions and proper flushing order.
  *
- * @param args - Variable arguments depending on pipeline type
+ * @param args - Variable arguments depending on pipeline type, optionally followed by {@link PipelineOptions}
  *
  * @returns PipelineControl if output is present, AsyncGenerator otherwise
  *
@@ -603,6 +885,10 @@ export function pipeline<K extends StreamName, T extends Packet | Frame = Packet
  * ```
  */
 export function pipeline(...args: any[]): PipelineControl | AsyncGenerator<Packet | Frame> | Record<StreamName, AsyncGenerator<Packet | Frame>> {
+  // Options are always the last argument
+  const options: PipelineOptions = args.length > 2 && isPipelineOptions(args[args.length - 1]) ? args.pop() : {};
+  const monitor = new PipelineMonitor(options);
+
   // Detect pipeline type based on first argument
   const firstArg = args[0];
 
@@ -610,23 +896,23 @@ export function pipeline(...args: any[]): PipelineControl | AsyncGenerator<Packe
     // Named pipeline (2 or 3 arguments)
     if (args.length === 2) {
       // Partial named pipeline - return generators
-      return runNamedPartialPipeline(args[0], args[1]);
+      return runNamedPartialPipeline(args[0], args[1], monitor);
     } else {
       // Full named pipeline with output
-      return runNamedPipeline(args[0], args[1], args[2]);
+      return runNamedPipeline(args[0], args[1], args[2], monitor);
     }
   } else if (isMediaInput(firstArg)) {
     // Check if this is a stream copy (MediaInput → MediaOutput)
     if (args.length === 2 && isMediaOutput(args[1])) {
       // Stream copy all streams
-      return runMediaInputPipeline(args[0], args[1]);
+      return runMediaInputPipeline(args[0], args[1], monitor);
     } else {
       // Simple pipeline starting with MediaInput
-      return runSimplePipeline(args);
+      return runSimplePipeline(args, monitor);
     }
   } else {
     // Simple pipeline (variable arguments)
-    return runSimplePipeline(args);
+    return runSimplePipeline(args, monitor);
   }
 }
 
@@ -642,15 +928,36 @@ export function pipeline(...args: any[]): PipelineControl | AsyncGenerator<Packe
 class PipelineControlImpl implements PipelineControl {
   private _stopped = false;
   private _completion: Promise<void>;
+  private _routers: PacketRouter[];
+  private _monitor?: PipelineMonitor;
 
   /**
    * @param executionPromise - Promise that resolves when pipeline completes
    *
+   * @param routers - Native packet routers to stop along with the pipeline
+   *
+   * @param monitor - Runs the stages and collects their statistics
+   *
    * @internal
    */
-  constructor(executionPromise: Promise<void>) {
+  constructor(executionPromise: Promise<void>, routers: PacketRouter[] = [], monitor?: PipelineMonitor) {
     // Don't resolve immediately on stop, wait for the actual pipeline to finish
     this._completion = executionPromise;
+    this._routers = routers;
+    this._monitor = monitor;
+
+    if (monitor?.options.onStats) {
+      const onStats = monitor.options.onStats;
+      const timer = setInterval(() => onStats(this.stats()), monitor.options.statsInterval ?? 1000);
+      timer.unref();
+
+      // Final report, also after a failure (the rejection is left to the caller)
+      const report = (): void => {
+        clearInterval(timer);
+        onStats(this.stats());
+      };
+      executionPromise.then(report, report);
+    }
   }
 
   /**
@@ -666,6 +973,11 @@ class PipelineControlImpl implements PipelineControl {
    */
   stop(): void {
     this._stopped = true;
+
+    // Ends every routed stream, copied streams stop right away
+    for (const router of this._routers) {
+      router.stop();
+    }
   }
 
   /**
@@ -685,6 +997,39 @@ class PipelineControlImpl implements PipelineControl {
     return this._stopped;
   }
 
+  /**
+   * Get the queues between the stages.
+   *
+   * @returns Snapshot of every queue
+   *
+   * @example
+   * ```typescript
+   * const control = pipeline(input, decoder, filter, encoder, output);
+   * setInterval(() => console.log(control.getQueueStats()), 1000);
+   * ```
+   */
+  getQueueStats(): PipelineQueueStats[] {
+    return this._monitor?.queueStats() ?? [];
+  }
+
+  /**
+   * Get live per-stage statistics.
+   *
+   * @returns Snapshot of the pipeline counters
+   *
+   * @example
+   * ```typescript
+   * const control = pipeline(input, decoder, filter, encoder, output);
+   * setInterval(() => {
+   *   const { speed, bottleneck } = control.stats();
+   *   console.log(`${speed.toFixed(2)}x, limited by ${bottleneck?.stage}`);
+   * }, 1000);
+   * ```
+   */
+  stats(): PipelineStats {
+    return this._monitor?.stats() ?? { elapsedTime: 0, speed: 0, stages: [] };
+  }
+
   /**
    * Get completion promise.
    */
@@ -704,70 +1049,61 @@ class PipelineControlImpl implements PipelineControl {
  *
  * @param output - Media output destination
  *
+ * @param monitor - Reports statistics (no stages, every stream is copied natively)
+ *
  * @returns Pipeline control interface
  *
  * @internal
  */
-function runMediaInputPipeline(input: MediaInput, output: MediaOutput): PipelineControl {
-  let control: PipelineControl;
-  // eslint-disable-next-line prefer-const
-  control = new PipelineControlImpl(runMediaInputPipelineAsync(input, output, () => control.isStopped()));
-  return control;
+function runMediaInputPipeline(input: MediaInput, output: MediaOutput, monitor: PipelineMonitor): PipelineControl {
+  const router = new PacketRouter();
+  return new PipelineControlImpl(runMediaInputPipelineAsync(input, output, router), [router], monitor);
 }
 
 /**
  * Run media input pipeline asynchronously.
  *
+ * Every stream is copied by a native packet router, packets never reach JS.
+ *
  * @param input - Media input source
  *
  * @param output - Media output destination
  *
- * @param shouldStop - Function to check if pipeline should stop
+ * @param router - Packet router reading the input
  *
  * @internal
  */
-async function runMediaInputPipelineAsync(input: MediaInput, output: MediaOutput, shouldStop: () => boolean): Promise<void> {
+async function runMediaInputPipelineAsync(input: MediaInput, output: MediaOutput, router: PacketRouter): Promise<void> {
   // Get all streams from input
   const videoStream = input.video();
   const audioStream = input.audio();
-  const streams: { stream: any; index: number }[] = [];
+  const streams: Stream[] = [];
 
-  // Add video stream if present
+  // Video and audio first, then any other streams
   if (videoStream) {
-    const outputIndex = output.addStream(videoStream);
-    streams.push({ stream: videoStream, index: outputIndex });
+    streams.push(videoStream);
   }
-
-  // Add audio stream if present
   if (audioStream) {
-    const outputIndex = output.addStream(audioStream);
-    streams.push({ stream: audioStream, index: outputIndex });
+    streams.push(audioStream);
   }
-
-  // Add any other streams
-  const allStreams = input.streams;
-  for (const stream of allStreams) {
-    // Skip if already added
+  for (const stream of input.streams) {
     if (stream !== videoStream && stream !== audioStream) {
-      const outputIndex = output.addStream(stream);
-      streams.push({ stream, index: outputIndex });
+      streams.push(stream);
     }
   }
 
-  // Copy all packets
-  for await (const packet of input.packets()) {
-    // Check if we should stop
-    if (shouldStop()) {
-      packet.free();
-      break;
+  try {
+    router.setInput(input.getFormatContext());
+    for (const stream of streams) {
+      const outputIndex = output.addStream(stream);
+      FFmpegError.throwIfError(router.addPassthrough(stream.index, output.getFormatContext(), outputIndex), 'Failed to add passthrough route');
     }
 
-    // Find the corresponding output stream index
-    const mapping = streams.find((s) => s.stream.index === packet.streamIndex);
-    if (mapping) {
-      await output.writePacket(packet, mapping.index);
-    }
-    packet.free(); // Free packet after processing
+    await runRouters([router], [output], []);
+  } finally {
+    // The reader may still be writing to the output
+    router.stop();
+    await router.wait();
   }
 
   await output.close();
@@ -782,11 +1118,13 @@ async function runMediaInputPipelineAsync(input: MediaInput, output: MediaOutput
  *
  * @param args - Pipeline arguments
  *
+ * @param monitor - Runs the stages and collects their statistics
+ *
  * @returns Pipeline control or async generator
  *
  * @internal
  */
-function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet | Frame> {
+function runSimplePipeline(args: any[], monitor: PipelineMonitor): PipelineControl | AsyncGenerator<Packet | Frame> {
   const [source, ...stages] = args;
 
   // Check if last stage is MediaOutput (consumes stream)
@@ -819,15 +1157,18 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
   // Convert MediaInput to packet stream if needed
   // If we have a decoder or BSF, filter packets by stream index
   let actualSource: AsyncIterable<Packet | Frame>;
+  let sourceTimeBase: IRational | undefined;
   if (isMediaInput(source)) {
     if (metadata.decoder) {
       // Filter packets for the decoder's stream
       const streamIndex = metadata.decoder.getStream().index;
       actualSource = source.packets(streamIndex);
+      sourceTimeBase = metadata.decoder.getStream().timeBase;
     } else if (metadata.bitStreamFilter) {
       // Filter packets for the BSF's stream
       const streamIndex = metadata.bitStreamFilter.getStream().index;
       actualSource = source.packets(streamIndex);
+      sourceTimeBase = metadata.bitStreamFilter.getStream().timeBase;
     } else {
       // No decoder or BSF, pass all packets
       actualSource = source.packets();
@@ -836,13 +1177,17 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
     actualSource = source;
   }
 
-  const generator = buildSimplePipeline(actualSource, processStages);
+  const generator = buildSimplePipeline(actualSource, processStages, monitor, sourceTimeBase);
 
   // If output, consume the generator
   if (isOutput) {
     let control: PipelineControl;
     // eslint-disable-next-line prefer-const
-    control = new PipelineControlImpl(consumeSimplePipeline(generator, lastStage, metadata, () => control.isStopped()));
+    control = new PipelineControlImpl(
+      consumeSimplePipeline(generator, lastStage, metadata, monitor, () => control.isStopped()),
+      [],
+      monitor,
+    );
     return control;
   }
 
@@ -857,38 +1202,47 @@ function runSimplePipeline(args: any[]): PipelineControl | AsyncGenerator<Packet
  *
  * @param stages - Processing stages
  *
- * @yields {Packet | Frame} Processed packets or frames
+ * @param monitor - Runs the stages and collects their statistics
+ *
+ * @param sourceTimeBase - Time base of source packets
+ *
+ * @returns Generator of processed packets or frames
  *
  * @internal
  */
-async function* buildSimplePipeline(
+function buildSimplePipeline(
   source: AsyncIterable<Packet | Frame>,
   stages: (Decoder | Encoder | FilterAPI | FilterAPI[] | BitStreamFilterAPI | BitStreamFilterAPI[] | MediaOutput)[],
+  monitor: PipelineMonitor,
+  sourceTimeBase?: IRational,
 ): AsyncGenerator<Packet | Frame> {
-  let stream: AsyncIterable<any> = source;
+  // Read ahead while the first stage works
+  let stream: AsyncGenerator<any> = monitor.read(source, { timeBase: () => sourceTimeBase ?? null });
 
   for (const stage of stages) {
     if (isDecoder(stage)) {
-      stream = decodeStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('decode', stream as AsyncGenerator<Packet>, (input) => decodeStream(input, stage), { timeBase: () => stage.getStream().timeBase });
     } else if (isEncoder(stage)) {
-      stream = encodeStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('encode', stream as AsyncGenerator<Frame>, (input) => encodeStream(input, stage), {
+        timeBase: () => stage.getCodecContext()?.timeBase ?? null,
+      });
     } else if (isFilterAPI(stage)) {
-      stream = filterStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, stage));
     } else if (isBitStreamFilterAPI(stage)) {
-      stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, stage), { timeBase: () => stage.getStream().timeBase });
     } else if (Array.isArray(stage)) {
       // Chain multiple filters or BSFs
       for (const filter of stage) {
         if (isFilterAPI(filter)) {
-          stream = filterStream(stream as AsyncIterable<Frame>, filter);
+          stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, filter));
         } else if (isBitStreamFilterAPI(filter)) {
-          stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, filter);
+          stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, filter), { timeBase: () => filter.getStream().timeBase });
         }
       }
     }
   }
 
-  yield* stream;
+  return stream;
 }
 
 /**
@@ -900,11 +1254,19 @@ async function* buildSimplePipeline(
  *
  * @param metadata - Stream metadata
  *
+ * @param monitor - Collects the statistics of the write stage
+ *
  * @param shouldStop - Function to check if pipeline should stop
  *
  * @internal
  */
-async function consumeSimplePipeline(stream: AsyncIterable<Packet | Frame>, output: MediaOutput, metadata: StreamMetadata, shouldStop: () => boolean): Promise<void> {
+async function consumeSimplePipeline(
+  stream: AsyncIterable<Packet | Frame>,
+  output: MediaOutput,
+  metadata: StreamMetadata,
+  monitor: PipelineMonitor,
+  shouldStop: () => boolean,
+): Promise<void> {
   // Add stream to output if we have encoder or decoder info
   let streamIndex = 0;
 
@@ -924,8 +1286,10 @@ async function consumeSimplePipeline(stream: AsyncIterable<Packet | Frame>, outp
     throw new Error('Cannot determine stream configuration. This is likely a bug in the pipeline.');
   }
 
+  const writer = monitor.write({ timeBase: () => packetTimeBase(metadata) });
+
   // Process stream
-  for await (const item of stream) {
+  for await (const item of writer.pull(stream)) {
     // Check if we should stop
     if (shouldStop()) {
       if (isPacket(item)) {
@@ -933,11 +1297,12 @@ async function consumeSimplePipeline(stream: AsyncIterable<Packet | Frame>, outp
       } else {
         item.free();
       }
+      writer.discard(1);
       break;
     }
 
     if (isPacket(item)) {
-      await output.writePacket(item, streamIndex);
+      await writer.process(item, async () => await output.writePacket(item, streamIndex));
       // Free the packet after writing
       item.free();
     } else {
@@ -952,62 +1317,75 @@ async function consumeSimplePipeline(stream: AsyncIterable<Packet | Frame>, outp
 // Named Pipeline Implementation
 // ============================================================================
 
+/**
+ * Named stream resolved to its input stream.
+ *
+ * @internal
+ */
+interface NamedStream {
+  name: StreamName;
+  input: MediaInput;
+  stream: Stream;
+  stages: NamedStage[] | 'passthrough';
+}
+
 /**
  * Run a named partial pipeline.
  *
+ * Streams of the same input share one native packet router. The generators must be
+ * consumed concurrently (or returned early), a stream that is not consumed blocks
+ * the router once its queue is full.
+ *
  * @param inputs - Named input sources
  *
  * @param stages - Named processing stages
  *
+ * @param monitor - Runs the stages and collects their statistics
+ *
  * @returns Record of async generators
  *
  * @internal
  */
-function runNamedPartialPipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>): Record<K, AsyncGenerator<Packet | Frame>> {
+function runNamedPartialPipeline<K extends StreamName>(
+  inputs: NamedInputs<K>,
+  stages: NamedStages<K>,
+  monitor: PipelineMonitor,
+): Record<K, AsyncGenerator<Packet | Frame>> {
   const result = {} as Record<K, AsyncGenerator<Packet | Frame>>;
+  const streams = resolveNamedStreams(inputs, stages);
+  const routers = new Map<MediaInput, PacketRouter>();
+  const open = new Map<PacketRouter, number>();
+
+  for (const entry of streams) {
+    const router = getRouter(routers, entry.input);
+    const route = router.addRoute(entry.stream.index);
+    FFmpegError.throwIfError(route, `Failed to route stream '${entry.name}'`);
+    open.set(router, (open.get(router) ?? 0) + 1);
+
+    // Stop the reader once every generator of its input is done, before the input gets closed
+    const packets = routePackets(router, route, async () => {
+      const remaining = open.get(router)! - 1;
+      open.set(router, remaining);
+      if (remaining === 0) {
+        router.stop();
+        await router.wait();
+      }
+    });
 
-  for (const [streamName, streamStages] of Object.entries(stages) as [
-    StreamName,
-    (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[])[] | 'passthrough',
-  ][]) {
-    const input = (inputs as any)[streamName] as MediaInput;
-    if (!input) {
-      throw new Error(`No input found for stream: ${streamName}`);
-    }
-
-    // Get the appropriate stream based on the stream name
-    let stream: Stream | null = null;
-    switch (streamName) {
-      case 'video':
-        stream = input.video() ?? null;
-        break;
-      case 'audio':
-        stream = input.audio() ?? null;
-        break;
-      default:
-        // This should never happen
-        throw new Error(`Invalid stream name: ${streamName}. Must be 'video' or 'audio'.`);
-    }
-
-    if (!stream) {
-      throw new Error(`No ${streamName} stream found in input.`);
-    }
-
-    if (streamStages === 'passthrough') {
+    if (entry.stages === 'passthrough') {
       // Direct passthrough - return input packets for this specific stream
-      (result as any)[streamName] = (async function* () {
-        for await (const packet of input.packets(stream.index)) {
-          yield packet;
-        }
-      })();
+      (result as any)[entry.name] = packets;
     } else {
-      // Process the stream - pass packets for this specific stream only
       // Build pipeline for this stream (can return frames or packets)
       const metadata: StreamMetadata = {};
-      (result as any)[streamName] = buildFlexibleNamedStreamPipeline(input.packets(stream.index), streamStages, metadata);
+      (result as any)[entry.name] = buildFlexibleNamedStreamPipeline(packets, entry.stages, metadata, monitor, entry.name);
     }
   }
 
+  for (const router of routers.values()) {
+    FFmpegError.throwIfError(router.start(), 'Failed to start packet router');
+  }
+
   return result;
 }
 
@@ -1020,26 +1398,47 @@ function runNamedPartialPipeline<K extends StreamName>(inputs: NamedInputs<K>, s
  *
  * @param output - Output destination(s)
  *
+ * @param monitor - Runs the stages and collects their statistics
+ *
  * @returns Pipeline control interface
  *
  * @internal
  */
-function runNamedPipeline<K extends StreamName>(inputs: NamedInputs<K>, stages: NamedStages<K>, output: MediaOutput | NamedOutputs<K>): PipelineControl {
+function runNamedPipeline<K extends StreamName>(
+  inputs: NamedInputs<K>,
+  stages: NamedStages<K>,
+  output: MediaOutput | NamedOutputs<K>,
+  monitor: PipelineMonitor,
+): PipelineControl {
+  const routers: PacketRouter[] = [];
   let control: PipelineControl;
   // eslint-disable-next-line prefer-const
-  control = new PipelineControlImpl(runNamedPipelineAsync(inputs, stages, output, () => control.isStopped()));
+  control = new PipelineControlImpl(
+    runNamedPipelineAsync(inputs, stages, output, routers, monitor, () => control.isStopped()),
+    routers,
+    monitor,
+  );
   return control;
 }
 
 /**
  * Run named pipeline asynchronously.
  *
+ * Each input is read by one native packet router. Passthrough streams are copied
+ * and interleaved into their output by the router itself; only processed streams
+ * are delivered to JS, each consumed concurrently and written with
+ * av_interleaved_write_frame(), which interleaves all streams of an output.
+ *
  * @param inputs - Named input sources
  *
  * @param stages - Named processing stages
  *
  * @param output - Output destination(s)
  *
+ * @param routers - Receives the created routers (stopped by the pipeline control)
+ *
+ * @param monitor - Runs the stages and collects their statistics
+ *
  * @param shouldStop - Function to check if pipeline should stop
  *
  * @internal
@@ -1048,51 +1447,36 @@ async function runNamedPipelineAsync<K extends StreamName>(
   inputs: NamedInputs<K>,
   stages: NamedStages<K>,
   output: MediaOutput | NamedOutputs<K>,
+  routers: PacketRouter[],
+  monitor: PipelineMonitor,
   shouldStop: () => boolean,
 ): Promise<void> {
-  // Track metadata for each stream
-  const streamMetadata: Record<StreamName, StreamMetadata> = {} as any;
-
-  // Process each named stream into generators
-  const processedStreams: Record<StreamName, AsyncIterable<Packet>> = {} as any;
-
-  for (const [streamName, streamStages] of Object.entries(stages) as [
-    StreamName,
-    (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[])[] | 'passthrough',
-  ][]) {
-    const metadata: StreamMetadata = {};
-    (streamMetadata as any)[streamName] = metadata;
-
-    const input = (inputs as any)[streamName] as MediaInput;
-    if (!input) {
-      throw new Error(`No input found for stream: ${streamName}`);
-    }
-
-    if (streamStages === 'passthrough') {
-      // Direct passthrough - no processing
-      let stream: Stream | null = null;
-
-      switch (streamName) {
-        case 'video':
-          stream = input.video() ?? null;
-          metadata.type = 'video';
-          break;
-        case 'audio':
-          stream = input.audio() ?? null;
-          metadata.type = 'audio';
-          break;
+  const byInput = new Map<MediaInput, PacketRouter>();
+  const outputs = new Set<MediaOutput>();
+  const consumers: (() => Promise<void>)[] = [];
+
+  try {
+    // Output streams are added in the order of the stages
+    for (const entry of resolveNamedStreams(inputs, stages)) {
+      const target = isMediaOutput(output) ? output : ((output as any)[entry.name] as MediaOutput | undefined);
+      if (!target) {
+        continue;
       }
+      outputs.add(target);
 
-      if (!stream) {
-        throw new Error(`No ${streamName} stream found in input for passthrough.`);
+      const router = getRouter(byInput, entry.input);
+
+      if (entry.stages === 'passthrough') {
+        // Direct passthrough - copied natively, never reaches JS
+        const streamIndex = target.addStream(entry.stream);
+        const ret = router.addPassthrough(entry.stream.index, target.getFormatContext(), streamIndex);
+        FFmpegError.throwIfError(ret, `Failed to route stream '${entry.name}'`);
+        continue;
       }
 
-      (processedStreams as any)[streamName] = input.packets(stream.index);
-      metadata.mediaInput = input; // Track MediaInput for passthrough
-    } else {
-      // Process the stream
       // Pre-populate metadata by walking through stages
-      for (const stage of streamStages) {
+      const metadata: StreamMetadata = {};
+      for (const stage of entry.stages) {
         if (isDecoder(stage)) {
           metadata.decoder = stage;
         } else if (isEncoder(stage)) {
@@ -1102,56 +1486,31 @@ async function runNamedPipelineAsync<K extends StreamName>(
         }
       }
 
-      // Get packets - filter by stream index based on decoder, BSF, or stream type
-      let packets: AsyncIterable<Packet>;
-      if (metadata.decoder) {
-        const streamIndex = metadata.decoder.getStream().index;
-        packets = input.packets(streamIndex);
-      } else if (metadata.bitStreamFilter) {
-        const streamIndex = metadata.bitStreamFilter.getStream().index;
-        packets = input.packets(streamIndex);
-      } else {
-        // No decoder or BSF - determine stream by name
-        let stream: Stream | null = null;
-        switch (streamName) {
-          case 'video':
-            stream = input.video() ?? null;
-            break;
-          case 'audio':
-            stream = input.audio() ?? null;
-            break;
-        }
+      const route = router.addRoute(entry.stream.index);
+      FFmpegError.throwIfError(route, `Failed to route stream '${entry.name}'`);
 
-        if (!stream) {
-          throw new Error(`No ${streamName} stream found in input.`);
-        }
+      // Encoded streams are initialized lazily, everything else is a stream copy of the source
+      const streamIndex = metadata.encoder ? target.addStream(metadata.encoder) : target.addStream(entry.stream);
+      metadata.streamIndex = streamIndex;
 
-        packets = input.packets(stream.index);
-      }
+      const packets = buildNamedStreamPipeline(routePackets(router, route), entry.stages, metadata, monitor, entry.name);
+      const writer = monitor.write({ name: entry.name, timeBase: () => packetTimeBase(metadata) });
+      consumers.push(async () => await writeNamedStream(packets, target, streamIndex, writer, shouldStop));
+    }
 
-      // Build pipeline for this stream
-      (processedStreams as any)[streamName] = buildNamedStreamPipeline(packets, streamStages, metadata);
+    routers.push(...byInput.values());
+    await runRouters(routers, outputs, consumers);
+  } finally {
+    for (const router of byInput.values()) {
+      router.stop();
     }
+    // Readers may still be inside a read or a passthrough write
+    await Promise.all([...byInput.values()].map(async (router) => await router.wait()));
   }
 
-  // Write to output(s)
+  // A single output is finalized here, named outputs are left to the caller
   if (isMediaOutput(output)) {
-    // Single output - properly interleave all streams
-    await interleaveToOutput(processedStreams, output, streamMetadata, shouldStop);
-  } else {
-    // Multiple outputs - write each stream to its output
-    const outputs = output;
-    const promises: Promise<void>[] = [];
-
-    for (const [streamName, stream] of Object.entries(processedStreams) as [StreamName, AsyncIterable<Packet>][]) {
-      const streamOutput = (outputs as any)[streamName] as MediaOutput | undefined;
-      if (streamOutput) {
-        const metadata = streamMetadata[streamName];
-        promises.push(consumeNamedStream(stream, streamOutput, metadata, shouldStop));
-      }
-    }
-
-    await Promise.all(promises);
+    await output.close();
   }
 }
 
@@ -1164,43 +1523,56 @@ async function runNamedPipelineAsync<K extends StreamName>(
  *
  * @param metadata - Stream metadata
  *
- * @yields {Packet | Frame} Processed packets or frames
+ * @param monitor - Runs the stages and collects their statistics
+ *
+ * @param name - Stream name
+ *
+ * @returns Generator of processed packets or frames
  *
  * @internal
  */
-async function* buildFlexibleNamedStreamPipeline(
-  source: AsyncIterable<Packet>,
-  stages: (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[])[],
+function buildFlexibleNamedStreamPipeline(
+  source: AsyncGenerator<Packet>,
+  stages: NamedStage[],
   metadata: StreamMetadata,
+  monitor: PipelineMonitor,
+  name: StreamName,
 ): AsyncGenerator<Packet | Frame> {
-  let stream: AsyncIterable<any> = source;
+  // Routed packets are already read ahead by the router
+  let stream: AsyncGenerator<any> = source;
 
   for (const stage of stages) {
     if (isDecoder(stage)) {
       metadata.decoder = stage;
-      stream = decodeStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('decode', stream as AsyncGenerator<Packet>, (input) => decodeStream(input, stage), { name, timeBase: () => stage.getStream().timeBase });
     } else if (isEncoder(stage)) {
       metadata.encoder = stage;
-      stream = encodeStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('encode', stream as AsyncGenerator<Frame>, (input) => encodeStream(input, stage), {
+        name,
+        timeBase: () => stage.getCodecContext()?.timeBase ?? null,
+      });
     } else if (isFilterAPI(stage)) {
-      stream = filterStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, stage), { name });
     } else if (isBitStreamFilterAPI(stage)) {
       metadata.bitStreamFilter = stage;
-      stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, stage), { name, timeBase: () => stage.getStream().timeBase });
     } else if (Array.isArray(stage)) {
       // Chain multiple filters or BSFs
       for (const filter of stage) {
         if (isFilterAPI(filter)) {
-          stream = filterStream(stream as AsyncIterable<Frame>, filter);
+          stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, filter), { name });
         } else if (isBitStreamFilterAPI(filter)) {
-          stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, filter);
+          stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, filter), {
+            name,
+            timeBase: () => filter.getStream().timeBase,
+          });
         }
       }
     }
   }
 
-  // Yield whatever the pipeline produces (frames or packets)
-  yield* stream;
+  // Whatever the pipeline produces (frames or packets)
+  return stream;
 }
 
 /**
@@ -1212,261 +1584,867 @@ async function* buildFlexibleNamedStreamPipeline(
  *
  * @param metadata - Stream metadata
  *
- * @yields {Packet} Processed packets
+ * @param monitor - Runs the stages and collects their statistics
+ *
+ * @param name - Stream name
+ *
+ * @returns Generator of processed packets
  *
  * @internal
  */
-async function* buildNamedStreamPipeline(
-  source: AsyncIterable<Packet>,
-  stages: (Decoder | FilterAPI | FilterAPI[] | Encoder | BitStreamFilterAPI | BitStreamFilterAPI[])[],
+function buildNamedStreamPipeline(
+  source: AsyncGenerator<Packet>,
+  stages: NamedStage[],
   metadata: StreamMetadata,
+  monitor: PipelineMonitor,
+  name: StreamName,
 ): AsyncGenerator<Packet> {
-  let stream: AsyncIterable<any> = source;
+  // Routed packets are already read ahead by the router
+  let stream: AsyncGenerator<any> = source;
 
   for (const stage of stages) {
     if (isDecoder(stage)) {
       metadata.decoder = stage;
-      stream = decodeStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('decode', stream as AsyncGenerator<Packet>, (input) => decodeStream(input, stage), { name, timeBase: () => stage.getStream().timeBase });
     } else if (isEncoder(stage)) {
       metadata.encoder = stage;
-      stream = encodeStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('encode', stream as AsyncGenerator<Frame>, (input) => encodeStream(input, stage), {
+        name,
+        timeBase: () => stage.getCodecContext()?.timeBase ?? null,
+      });
     } else if (isFilterAPI(stage)) {
-      stream = filterStream(stream as AsyncIterable<Frame>, stage);
+      stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, stage), { name });
     } else if (isBitStreamFilterAPI(stage)) {
       metadata.bitStreamFilter = stage;
-      stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, stage);
+      stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, stage), { name, timeBase: () => stage.getStream().timeBase });
     } else if (Array.isArray(stage)) {
       // Chain multiple filters or BSFs
       for (const filter of stage) {
         if (isFilterAPI(filter)) {
-          stream = filterStream(stream as AsyncIterable<Frame>, filter);
+          stream = monitor.run('filter', stream as AsyncGenerator<Frame>, (input) => filterStream(input, filter), { name });
         } else if (isBitStreamFilterAPI(filter)) {
-          stream = bitStreamFilterStream(stream as AsyncIterable<Packet>, filter);
+          stream = monitor.run('bsf', stream as AsyncGenerator<Packet>, (input) => bitStreamFilterStream(input, filter), {
+            name,
+            timeBase: () => filter.getStream().timeBase,
+          });
         }
       }
     }
   }
 
-  // Ensure we're yielding packets
+  return requirePackets(stream);
+}
+
+/**
+ * Ensure a named stream ends with packets.
+ *
+ * @param stream - Output of the last stage
+ *
+ * @yields {Packet} Packets of the stream
+ *
+ * @throws {Error} If the stream yields frames
+ *
+ * @internal
+ */
+async function* requirePackets(stream: AsyncIterable<Packet | Frame>): AsyncGenerator<Packet> {
   for await (const item of stream) {
     if (isPacket(item)) {
       yield item;
     } else {
+      item.free();
       throw new Error('Named pipeline must end with packets (use encoder after filters)');
     }
   }
 }
 
 /**
- * Consume a named stream and write to output.
+ * Write a processed named stream to its output.
  *
  * @param stream - Stream of packets
  *
  * @param output - Media output destination
  *
- * @param metadata - Stream metadata
+ * @param streamIndex - Output stream index
+ *
+ * @param writer - Statistics of the write stage
  *
  * @param shouldStop - Function to check if pipeline should stop
  *
  * @internal
  */
-async function consumeNamedStream(stream: AsyncIterable<Packet>, output: MediaOutput, metadata: StreamMetadata, shouldStop: () => boolean): Promise<void> {
-  // Add stream to output
-  let streamIndex = 0;
+async function writeNamedStream(stream: AsyncIterable<Packet>, output: MediaOutput, streamIndex: number, writer: StageMonitor, shouldStop: () => boolean): Promise<void> {
+  for await (const packet of writer.pull(stream)) {
+    // Check if we should stop
+    if (shouldStop()) {
+      packet.free();
+      writer.discard(1);
+      break;
+    }
 
-  if (metadata.encoder) {
-    streamIndex = output.addStream(metadata.encoder);
-  } else if (metadata.decoder) {
-    // Stream copy - use decoder's original stream
-    const originalStream = metadata.decoder.getStream();
-    streamIndex = output.addStream(originalStream);
-  } else if (metadata.bitStreamFilter) {
-    // BSF - use BSF's original stream
-    const originalStream = metadata.bitStreamFilter.getStream();
-    streamIndex = output.addStream(originalStream);
-  } else if (metadata.mediaInput) {
-    // Passthrough from MediaInput - use type hint from metadata
-    const inputStream = metadata.type === 'video' ? metadata.mediaInput.video() : metadata.mediaInput.audio();
-    if (!inputStream) {
-      throw new Error(`No ${metadata.type} stream found in MediaInput`);
+    try {
+      await writer.process(packet, async () => await output.writePacket(packet, streamIndex));
+    } finally {
+      packet.free(); // Free packet after writing
     }
-    streamIndex = output.addStream(inputStream);
-  } else {
-    // This should not happen with the new API
-    throw new Error('Cannot determine stream configuration. This is likely a bug in the pipeline.');
   }
+}
 
-  // Store for later use
-  metadata.streamIndex = streamIndex;
+/**
+ * Run packet routers until every stream has been written.
+ *
+ * @param routers - Routers with all routes added
+ *
+ * @param outputs - Outputs written by the routers and consumers
+ *
+ * @param consumers - Consumers of the routes delivered to JS
+ *
+ * @internal
+ */
+async function runRouters(routers: PacketRouter[], outputs: Iterable<MediaOutput>, consumers: (() => Promise<void>)[]): Promise<void> {
+  for (const router of routers) {
+    FFmpegError.throwIfError(router.start(), 'Failed to start packet router');
+  }
 
-  // Write all packets
-  for await (const packet of stream) {
-    // Check if we should stop
-    if (shouldStop()) {
-      packet.free();
-      break;
+  // Outputs with only copied streams never see a JS packet that would write their header
+  for (const output of outputs) {
+    await output.ensureHeader();
+  }
+
+  await Promise.all(consumers.map(async (consume) => await consume()));
+
+  for (const router of routers) {
+    FFmpegError.throwIfError(await router.wait(), 'Failed to route packets');
+  }
+
+  // Copied packets are held until the header is written, write what is left
+  for (const output of outputs) {
+    await output.ensureHeader();
+  }
+  for (const router of routers) {
+    const ret = router.flush();
+    if (ret !== AVERROR_EAGAIN) {
+      FFmpegError.throwIfError(ret, 'Failed to write copied packets');
     }
+  }
+}
 
-    try {
-      await output.writePacket(packet, streamIndex);
-    } finally {
-      packet.free(); // Free packet after writing
+/**
+ * Receive the packets of a router route.
+ *
+ * @param router - Started packet router
+ *
+ * @param route - Route id
+ *
+ * @param onClose - Awaited once the route is closed
+ *
+ * @yields {Packet} Routed packets (must be freed by caller)
+ *
+ * @internal
+ */
+async function* routePackets(router: PacketRouter, route: number, onClose?: () => Promise<void>): AsyncGenerator<Packet> {
+  try {
+    while (true) {
+      const packet = new Packet();
+      packet.alloc();
+
+      const ret = await router.receivePacket(route, packet);
+      if (ret < 0) {
+        packet.free();
+        if (ret === AVERROR_EOF) {
+          break;
+        }
+        FFmpegError.throwIfError(ret, 'Failed to read packet');
+      }
+
+      yield packet;
     }
+  } finally {
+    // Stream no longer consumed, e.g. the generator was returned early
+    router.closeRoute(route);
+    await onClose?.();
   }
+}
 
-  // Note: Trailer will be written by interleaveToOutput
+/**
+ * Get the packet router of an input, creating it on first use.
+ *
+ * @param routers - Routers by input
+ *
+ * @param input - Media input
+ *
+ * @returns Packet router reading the input
+ *
+ * @internal
+ */
+function getRouter(routers: Map<MediaInput, PacketRouter>, input: MediaInput): PacketRouter {
+  let router = routers.get(input);
+  if (!router) {
+    router = new PacketRouter();
+    router.setInput(input.getFormatContext());
+    routers.set(input, router);
+  }
+  return router;
 }
 
 /**
- * Interleave multiple streams to a single output.
+ * Resolve the input stream of every named stream.
  *
- * @param streams - Record of packet streams
+ * @param inputs - Named input sources
  *
- * @param output - Media output destination
+ * @param stages - Named processing stages
  *
- * @param metadata - Stream metadata for each stream
+ * @returns Resolved streams in the order of the stages
  *
- * @param shouldStop - Function to check if pipeline should stop
+ * @throws {Error} If an input is missing or no matching stream exists
  *
  * @internal
  */
-async function interleaveToOutput(
-  streams: Record<StreamName, AsyncIterable<Packet>>,
-  output: MediaOutput,
-  metadata: Record<StreamName, StreamMetadata>,
-  shouldStop: () => boolean,
-): Promise<void> {
-  // Add all streams to output first
-  const streamIndices: Record<StreamName, number> = {} as any;
-
-  for (const [name, meta] of Object.entries(metadata) as [StreamName, StreamMetadata][]) {
-    if (meta.encoder) {
-      streamIndices[name] = output.addStream(meta.encoder);
-    } else if (meta.decoder) {
-      // Stream copy - use decoder's original stream
-      const originalStream = meta.decoder.getStream();
-      streamIndices[name] = output.addStream(originalStream);
-    } else if (meta.bitStreamFilter) {
-      // BSF - use BSF's original stream
-      const originalStream = meta.bitStreamFilter.getStream();
-      streamIndices[name] = output.addStream(originalStream);
-    } else if (meta.mediaInput) {
-      // Passthrough from MediaInput - use stream name to determine which stream
-      const stream = name.includes('video') ? meta.mediaInput.video() : meta.mediaInput.audio();
-      if (!stream) {
-        throw new Error(`No matching stream found in MediaInput for ${name}`);
-      }
-      streamIndices[name] = output.addStream(stream);
+function resolveNamedStreams(inputs: NamedInputs<any>, stages: NamedStages<any>): NamedStream[] {
+  const result: NamedStream[] = [];
+
+  for (const [name, streamStages] of Object.entries(stages) as [StreamName, NamedStage[] | 'passthrough'][]) {
+    const source = (inputs as any)[name] as MediaInput | StreamSource | undefined;
+    if (!source) {
+      throw new Error(`No input found for stream: ${name}`);
+    }
+
+    const input = isMediaInput(source) ? source : source.input;
+    let stream: Stream | undefined;
+
+    if (!isMediaInput(source)) {
+      stream = findStream(input, source.stream);
     } else {
-      // This should not happen
-      throw new Error(`Cannot determine stream configuration for ${name}. This is likely a bug in the pipeline.`);
+      // Stream of the decoder or BSF, otherwise derived from the name
+      if (streamStages !== 'passthrough') {
+        const stage = streamStages.find((s) => isDecoder(s) || isBitStreamFilterAPI(s)) as Decoder | BitStreamFilterAPI | undefined;
+        const index = stage?.getStream().index;
+        stream = index !== undefined ? input.streams.find((s) => s.index === index) : undefined;
+      }
+      stream ??= findStream(input, name);
     }
+
+    if (!stream) {
+      throw new Error(`No stream found in input for '${name}'.`);
+    }
+
+    result.push({ name, input, stream, stages: streamStages });
   }
 
-  // Create packet queues for each stream
-  interface PacketWithStream extends Packet {
-    _streamName: string;
+  return result;
+}
+
+/**
+ * Find an input stream by index, name or type specifier.
+ *
+ * @param input - Media input
+ *
+ * @param selector - Stream index, 'video'/'audio' or specifier ('2', 'v', 'a:1', 's:0', 'd', 't')
+ *
+ * @returns Matching stream or undefined
+ *
+ * @internal
+ */
+function findStream(input: MediaInput, selector: number | string): Stream | undefined {
+  if (typeof selector === 'number' || /^\d+$/.test(selector)) {
+    const index = Number(selector);
+    return input.streams.find((s) => s.index === index);
   }
 
-  const queues = new Map<StreamName, PacketWithStream[]>();
-  const iterators = new Map<StreamName, AsyncIterator<Packet>>();
-  const done = new Set<StreamName>();
+  switch (selector) {
+    case 'video':
+      return input.video();
+    case 'audio':
+      return input.audio();
+  }
 
-  // Initialize iterators
-  for (const [name, stream] of Object.entries(streams) as [StreamName, AsyncIterable<Packet>][]) {
-    queues.set(name, []);
-    iterators.set(name, stream[Symbol.asyncIterator]());
+  const match = /^([vasdt])(?::(\d+))?$/.exec(selector);
+  if (!match) {
+    return undefined;
   }
 
-  // Read initial packet from each stream
-  for (const [name, iterator] of iterators) {
-    const result = await iterator.next();
-    if (!result.done && result.value) {
-      const packet = result.value as PacketWithStream;
-      packet._streamName = name;
-      queues.get(name)!.push(packet);
-    } else {
-      done.add(name);
+  const types: Record<string, AVMediaType> = {
+    v: AVMEDIA_TYPE_VIDEO,
+    a: AVMEDIA_TYPE_AUDIO,
+    s: AVMEDIA_TYPE_SUBTITLE,
+    d: AVMEDIA_TYPE_DATA,
+    t: AVMEDIA_TYPE_ATTACHMENT,
+  };
+  const streams = input.streams.filter((s) => s.codecpar.codecType === types[match[1]]);
+  return streams[Number(match[2] ?? 0)];
+}
+
+// ============================================================================
+// Stage Execution and Statistics
+// ============================================================================
+
+const defaultQueueDepth = 4;
+
+/** Window the current fps is measured over in milliseconds */
+const fpsWindow = 1000;
+
+/**
+ * Stream name and packet time base of a stage.
+ *
+ * @internal
+ */
+interface StageOptions {
+  name?: StreamName;
+  timeBase?: () => IRational | null;
+}
+
+/**
+ * Runs the stages of one pipeline and collects their statistics.
+ *
+ * @internal
+ */
+class PipelineMonitor {
+  readonly options: PipelineOptions;
+  readonly capacity: number;
+  private stages: StageMonitor[] = [];
+  private startTime = 0;
+
+  /**
+   * @param options - Pipeline options
+   *
+   * @internal
+   */
+  constructor(options: PipelineOptions) {
+    this.options = options;
+    this.capacity = Math.max(0, Math.floor(options.queueDepth ?? defaultQueueDepth));
+  }
+
+  /**
+   * Run the source as read stage, reading ahead while the next stage works.
+   *
+   * @param source - Source packets or frames
+   *
+   * @param options - Stage options
+   *
+   * @returns Buffered source
+   *
+   * @internal
+   */
+  read<T extends Packet | Frame>(source: AsyncIterable<T>, options: StageOptions = {}): AsyncGenerator<T> {
+    const stage = this.add('read', options);
+    return this.buffer(stage.measure(source), stage);
+  }
+
+  /**
+   * Run a stage as its own loop, buffering its output.
+   *
+   * @param kind - Stage kind
+   *
+   * @param source - Input of the stage
+   *
+   * @param process - Creates the stage from its input
+   *
+   * @param options - Stage options
+   *
+   * @returns Output of the stage
+   *
+   * @internal
+   */
+  run<I extends Packet | Frame, T extends Packet | Frame>(
+    kind: PipelineQueueStats['stage'],
+    source: AsyncIterable<I>,
+    process: (input: AsyncIterable<I>) => AsyncIterable<T>,
+    options: StageOptions = {},
+  ): AsyncGenerator<T> {
+    const stage = this.add(kind, options);
+    return this.buffer(stage.measure(process(stage.pull(source))), stage);
+  }
+
+  /**
+   * Add a write stage, driven by the caller.
+   *
+   * @param options - Stage options
+   *
+   * @returns Monitor of the write stage
+   *
+   * @internal
+   */
+  write(options: StageOptions = {}): StageMonitor {
+    return this.add('write', options);
+  }
+
+  /**
+   * Start the clock on the first activity of any stage.
+   *
+   * @internal
+   */
+  started(): void {
+    if (this.startTime === 0) {
+      this.startTime = performance.now();
     }
   }
 
-  // Interleave packets based on DTS/PTS
-  while (done.size < Object.keys(streams).length && !shouldStop()) {
-    // Find packet with smallest DTS/PTS
-    let minPacket: PacketWithStream | null = null;
-    let minStreamName: StreamName | null = null;
-    let minTime = BigInt(Number.MAX_SAFE_INTEGER);
-
-    for (const [name, queue] of queues) {
-      if (queue.length > 0) {
-        const packet = queue[0];
-        const time = packet.dts ?? packet.pts ?? BigInt(0);
-        if (time < minTime) {
-          minTime = time;
-          minPacket = packet;
-          minStreamName = name;
-        }
+  /**
+   * Get the elapsed time.
+   *
+   * @returns Milliseconds since the first stage started
+   *
+   * @internal
+   */
+  elapsed(): number {
+    return this.startTime === 0 ? 0 : performance.now() - this.startTime;
+  }
+
+  /**
+   * Get a snapshot of every stage.
+   *
+   * @returns Pipeline statistics
+   *
+   * @internal
+   */
+  stats(): PipelineStats {
+    const elapsedTime = this.elapsed();
+    const stages = this.stages.map((stage) => stage.snapshot(elapsedTime));
+
+    // The slowest written stream determines the speed of the job
+    const speeds = stages.filter((stage) => stage.stage === 'write' && stage.speed > 0).map((stage) => stage.speed);
+    const stats: PipelineStats = { elapsedTime, speed: speeds.length > 0 ? Math.min(...speeds) : 0, stages };
+
+    let bottleneck: PipelineStageStats | undefined;
+    for (const stage of stages) {
+      if (stage.busyTime > (bottleneck?.busyTime ?? 0)) {
+        bottleneck = stage;
       }
     }
+    if (bottleneck) {
+      stats.bottleneck = bottleneck.stream !== undefined ? { stage: bottleneck.stage, stream: bottleneck.stream } : { stage: bottleneck.stage };
+    }
 
-    if (!minPacket || !minStreamName) {
-      // All queues empty, read more
-      for (const [name, iterator] of iterators) {
-        if (!done.has(name)) {
-          const result = await iterator.next();
-          if (!result.done && result.value) {
-            const packet = result.value as PacketWithStream;
-            packet._streamName = name;
-            queues.get(name)!.push(packet);
-          } else {
-            done.add(name);
-          }
-        }
-      }
-      continue;
+    return stats;
+  }
+
+  /**
+   * Get a snapshot of every queue.
+   *
+   * @returns Queues in stage order
+   *
+   * @internal
+   */
+  queueStats(): PipelineQueueStats[] {
+    return this.stages.filter((stage) => stage.queue).map((stage) => ({ ...stage.queue! }));
+  }
+
+  /**
+   * Create the monitor of a stage.
+   *
+   * @param kind - Stage kind
+   *
+   * @param options - Stage options
+   *
+   * @returns Stage monitor
+   *
+   * @internal
+   */
+  private add(kind: PipelineStageStats['stage'], options: StageOptions): StageMonitor {
+    const stage = new StageMonitor(this, kind, options);
+    this.stages.push(stage);
+    return stage;
+  }
+
+  /**
+   * Buffer the output of a stage, unless buffering is disabled.
+   *
+   * @param stream - Output of the stage
+   *
+   * @param stage - Stage monitor
+   *
+   * @returns Buffered output
+   *
+   * @internal
+   */
+  private buffer<T extends Packet | Frame>(stream: AsyncGenerator<T>, stage: StageMonitor): AsyncGenerator<T> {
+    if (this.capacity === 0) {
+      return stream;
     }
 
-    // Write the packet with smallest timestamp
-    const streamIndex = streamIndices[minStreamName];
-    await output.writePacket(minPacket, streamIndex);
+    const queue: PipelineQueueStats = { stage: stage.stats.stage as PipelineQueueStats['stage'], depth: 0, maxDepth: 0, capacity: this.capacity };
+    if (stage.stats.stream !== undefined) {
+      queue.stream = stage.stats.stream;
+    }
+    stage.queue = queue;
 
-    // Free the packet after writing
-    minPacket.free();
+    return bufferStream(stream, new StageQueue<T>(queue), stage);
+  }
+}
 
-    // Remove from queue
-    queues.get(minStreamName)!.shift();
+/**
+ * Counters of one stage.
+ *
+ * @internal
+ */
+class StageMonitor {
+  readonly stats: PipelineStageStats;
+  queue?: PipelineQueueStats;
+  private video = false;
+  private firstTime: number | null = null;
+  private lastTime: number | null = null;
+  private windowStart = 0;
+  private windowCount = 0;
+  private fps = 0;
 
-    // Read next packet from that stream
-    const iterator = iterators.get(minStreamName)!;
-    const result = await iterator.next();
-    if (!result.done && result.value) {
-      const packet = result.value as PacketWithStream;
-      packet._streamName = minStreamName;
-      queues.get(minStreamName)!.push(packet);
-    } else {
-      done.add(minStreamName);
+  /**
+   * @param pipeline - Pipeline of the stage
+   *
+   * @param kind - Stage kind
+   *
+   * @param options - Stage options
+   *
+   * @internal
+   */
+  constructor(
+    private readonly pipeline: PipelineMonitor,
+    kind: PipelineStageStats['stage'],
+    private readonly options: StageOptions,
+  ) {
+    this.stats = {
+      stage: kind,
+      packetsIn: 0,
+      framesIn: 0,
+      packetsOut: 0,
+      framesOut: 0,
+      bytesIn: 0,
+      bytesOut: 0,
+      busyTime: 0,
+      upstreamWaitTime: 0,
+      downstreamWaitTime: 0,
+      fps: 0,
+      speed: 0,
+      dropped: 0,
+      duplicated: 0,
+    };
+    if (options.name !== undefined) {
+      this.stats.stream = options.name;
     }
   }
 
-  // If stopped, free all remaining packets in queues
-  if (shouldStop()) {
-    for (const [, queue] of queues) {
-      for (const packet of queue) {
-        packet.free();
+  /**
+   * Count the input of the stage and the time spent waiting for it.
+   *
+   * @param source - Input of the stage
+   *
+   * @yields {T} Input items
+   *
+   * @internal
+   */
+  async *pull<T extends Packet | Frame>(source: AsyncIterable<T>): AsyncGenerator<T> {
+    this.pipeline.started();
+    let start = performance.now();
+
+    for await (const item of source) {
+      this.stats.upstreamWaitTime += performance.now() - start;
+
+      const input: Packet | Frame = item;
+      if (isPacket(input)) {
+        this.stats.packetsIn++;
+        this.stats.bytesIn += input.size;
+      } else {
+        this.stats.framesIn++;
+        this.video ||= input.isVideo();
       }
+
+      yield item;
+      start = performance.now();
     }
-  } else {
-    // Write any remaining packets
-    for (const [name, queue] of queues) {
-      const streamIndex = streamIndices[name];
-      for (const packet of queue) {
-        await output.writePacket(packet, streamIndex);
-        packet.free(); // Free packet after writing
+
+    this.stats.upstreamWaitTime += performance.now() - start;
+  }
+
+  /**
+   * Count the output of the stage, the time spent producing it and the
+   * time the next stage took to take it.
+   *
+   * @param source - Output of the stage
+   *
+   * @yields {T} Output items
+   *
+   * @internal
+   */
+  async *measure<T extends Packet | Frame>(source: AsyncIterable<T>): AsyncGenerator<T> {
+    this.pipeline.started();
+    let start = performance.now();
+    let upstream = this.stats.upstreamWaitTime;
+
+    for await (const item of source) {
+      const ready = performance.now();
+      // Waiting for input happens inside the stage, it is not busy time
+      this.stats.busyTime += ready - start - (this.stats.upstreamWaitTime - upstream);
+
+      const output: Packet | Frame = item;
+      if (isPacket(output)) {
+        this.stats.packetsOut++;
+        this.stats.bytesOut += output.size;
+      } else {
+        this.stats.framesOut++;
       }
+      this.progress(output, ready);
+
+      yield item;
+      start = performance.now();
+      this.stats.downstreamWaitTime += start - ready;
+      upstream = this.stats.upstreamWaitTime;
+    }
+
+    // Flushing
+    this.stats.busyTime += performance.now() - start - (this.stats.upstreamWaitTime - upstream);
+  }
+
+  /**
+   * Run the work of a stage driven by the caller (write stage).
+   *
+   * @param item - Item processed
+   *
+   * @param work - Work to time
+   *
+   * @internal
+   */
+  async process(item: Packet | Frame, work: () => Promise<void>): Promise<void> {
+    const start = performance.now();
+    await work();
+    const end = performance.now();
+    this.stats.busyTime += end - start;
+    this.progress(item, end);
+  }
+
+  /**
+   * Count items discarded because the pipeline stopped.
+   *
+   * @param count - Number of items
+   *
+   * @internal
+   */
+  discard(count: number): void {
+    this.stats.dropped += count;
+  }
+
+  /**
+   * Get a snapshot of the counters.
+   *
+   * @param elapsedTime - Milliseconds since the pipeline started
+   *
+   * @returns Stage statistics
+   *
+   * @internal
+   */
+  snapshot(elapsedTime: number): PipelineStageStats {
+    const stats: PipelineStageStats = { ...this.stats };
+
+    const windowTime = performance.now() - this.windowStart;
+    stats.fps = this.windowCount > 0 && windowTime >= fpsWindow ? (this.windowCount * 1000) / windowTime : this.fps;
+
+    if (this.firstTime !== null && this.lastTime !== null && elapsedTime > 0) {
+      stats.speed = (this.lastTime - this.firstTime) / (elapsedTime / 1000);
     }
+
+    // Frame rate conversion by video filters
+    if (stats.stage === 'filter' && this.video) {
+      stats.duplicated = Math.max(0, stats.framesOut - stats.framesIn);
+      stats.dropped += Math.max(0, stats.framesIn - stats.framesOut);
+    }
+
+    if (this.queue) {
+      stats.queue = { ...this.queue };
+    }
+
+    return stats;
   }
 
-  await output.close();
+  /**
+   * Update fps and media time with a produced or written item.
+   *
+   * @param item - Item
+   *
+   * @param now - Current time
+   *
+   * @internal
+   */
+  private progress(item: Packet | Frame, now: number): void {
+    if (this.windowCount === 0 && this.windowStart === 0) {
+      this.windowStart = now;
+    }
+    this.windowCount++;
+    if (now - this.windowStart >= fpsWindow) {
+      this.fps = (this.windowCount * 1000) / (now - this.windowStart);
+      this.windowStart = now;
+      this.windowCount = 0;
+    }
+
+    const frameTimeBase = isPacket(item) ? null : item.timeBase;
+    const timeBase = frameTimeBase && frameTimeBase.num > 0 ? frameTimeBase : this.options.timeBase?.();
+    if (!timeBase || timeBase.den <= 0 || item.pts === AV_NOPTS_VALUE) {
+      return;
+    }
+
+    const time = (Number(item.pts) * timeBase.num) / timeBase.den;
+    this.firstTime ??= time;
+    this.lastTime = Math.max(this.lastTime ?? time, time);
+  }
+}
+
+/**
+ * Time base of the packets a named or simple pipeline writes.
+ *
+ * @param metadata - Stream metadata
+ *
+ * @returns Encoder time base, or the time base of the copied stream
+ *
+ * @internal
+ */
+function packetTimeBase(metadata: StreamMetadata): IRational | null {
+  if (metadata.encoder) {
+    return metadata.encoder.getCodecContext()?.timeBase ?? null;
+  }
+  return (metadata.bitStreamFilter ?? metadata.decoder)?.getStream().timeBase ?? null;
+}
+
+/**
+ * Bounded queue handing items from one stage loop to the next.
+ *
+ * @internal
+ */
+class StageQueue<T extends Packet | Frame> {
+  private items: T[] = [];
+  private ended = false;
+  private closed = false;
+  private failure?: { error: unknown };
+  private wakeConsumer?: () => void;
+  private wakeProducer?: () => void;
+
+  /**
+   * @param stats - Counters of this queue
+   *
+   * @internal
+   */
+  constructor(private readonly stats: PipelineQueueStats) {}
+
+  /**
+   * Add an item, waiting while the queue is full.
+   *
+   * @param item - Item to queue (owned by the queue on success)
+   *
+   * @returns False if the consumer closed the queue
+   *
+   * @internal
+   */
+  async push(item: T): Promise<boolean> {
+    while (!this.closed && this.items.length >= this.stats.capacity) {
+      await new Promise<void>((resolve) => (this.wakeProducer = resolve));
+    }
+    if (this.closed) {
+      return false;
+    }
+
+    this.items.push(item);
+    this.stats.depth = this.items.length;
+    this.stats.maxDepth = Math.max(this.stats.maxDepth, this.stats.depth);
+    this.wakeConsumer?.();
+    return true;
+  }
+
+  /**
+   * Take the next item, waiting while the queue is empty.
+   *
+   * @returns Next item, or null once the producer ended
+   *
+   * @throws {Error} Error of the producer, after all queued items
+   *
+   * @internal
+   */
+  async pop(): Promise<T | null> {
+    while (this.items.length === 0 && !this.ended) {
+      await new Promise<void>((resolve) => (this.wakeConsumer = resolve));
+    }
+
+    const item = this.items.shift();
+    if (item) {
+      this.stats.depth = this.items.length;
+      this.wakeProducer?.();
+      return item;
+    }
+    if (this.failure) {
+      throw this.failure.error;
+    }
+    return null;
+  }
+
+  /**
+   * End the queue from the producer side.
+   *
+   * @param failure - Error raised by the producer
+   *
+   * @internal
+   */
+  end(failure?: { error: unknown }): void {
+    this.ended = true;
+    this.failure = failure;
+    this.wakeConsumer?.();
+  }
+
+  /**
+   * Close the queue from the consumer side and free queued items.
+   *
+   * @returns Number of items freed
+   *
+   * @internal
+   */
+  close(): number {
+    this.closed = true;
+    const items = this.items.splice(0);
+    for (const item of items) {
+      item.free();
+    }
+    this.stats.depth = 0;
+    this.wakeProducer?.();
+    return items.length;
+  }
+}
+
+/**
+ * Pull a stream in its own loop and deliver it through a bounded queue.
+ *
+ * The loop starts with the first pull and keeps the queue filled, so the
+ * stage works on the next items while the consumer handles the current one.
+ * Returning early stops the loop and returns the source.
+ *
+ * @param source - Stream to pull
+ *
+ * @param queue - Queue between the loop and the consumer
+ *
+ * @param stage - Counts items discarded when returning early
+ *
+ * @yields {T} Items of the source (must be freed by caller)
+ *
+ * @internal
+ */
+async function* bufferStream<T extends Packet | Frame>(source: AsyncIterable<T>, queue: StageQueue<T>, stage: StageMonitor): AsyncGenerator<T> {
+  const pump = (async () => {
+    try {
+      for await (const item of source) {
+        if (!(await queue.push(item))) {
+          // Consumer is gone, breaking returns the source
+          item.free();
+          stage.discard(1);
+          break;
+        }
+      }
+      queue.end();
+    } catch (error) {
+      queue.end({ error });
+    }
+  })();
+
+  try {
+    let item;
+    while ((item = await queue.pop()) !== null) {
+      yield item;
+    }
+  } finally {
+    stage.discard(queue.close());
+    await pump;
+  }
 }
 
 // ============================================================================
@@ -1753,3 +2731,27 @@ function isMediaOutput(obj: any): obj is MediaOutput {
 function isPacket(obj: any): obj is Packet {
   return obj && 'streamIndex' in obj && 'pts' in obj && 'dts' in obj;
 }
+
+const pipelineOptionTypes: Record<keyof PipelineOptions, string> = {
+  queueDepth: 'number',
+  onStats: 'function',
+  statsInterval: 'number',
+};
+
+/**
+ * Check if object is pipeline options.
+ *
+ * @param obj - Object to check
+ *
+ * @returns True if object is PipelineOptions
+ *
+ * @internal
+ */
+function isPipelineOptions(obj: any): obj is PipelineOptions {
+  return (
+    obj &&
+    typeof obj === 'object' &&
+    Object.getPrototypeOf(obj) === Object.prototype &&
+    Object.entries(obj).every(([key, value]) => value === undefined || typeof value === pipelineOptionTypes[key as keyof PipelineOptions])
+  );
+}
@@ -1,5 +1,5 @@
 import type { AVPixelFormat, AVSampleFormat } from '../constants/constants.js';
-import type { IRational } from '../lib/index.js';
+import type { CodecReconfigureStats, FileIOOptions, FrameArena, HttpIOOptions, IOCallbackOptions, IRational, PacketAllocator, PacketRecorder, ReadRateOptions } from '../lib/index.js';
 import type { HardwareContext } from './hardware.js';
 
 /**
@@ -72,6 +72,19 @@ export interface MediaInputOptions {
    */
   bufferSize?: number;
 
+  /**
+   * Adapt the read size for buffer and callback inputs.
+   *
+   * Starts at `bufferSize`, grows while the source delivers full reads and
+   * shrinks for sources that trickle in (live streams). Read callbacks then
+   * receive a varying size argument.
+   *
+   * @default false
+   *
+   * @see {@link IOCallbackOptions.adaptive}
+   */
+  adaptiveBuffer?: boolean;
+
   /**
    * Force specific input format.
    *
@@ -87,6 +100,59 @@ export interface MediaInputOptions {
    *
    */
   options?: Record<string, string | number>;
+
+  /**
+   * Read local files through the native file backend.
+   *
+   * Uses io_uring (Linux) or a pread worker thread with readahead instead of
+   * FFmpeg's `file:` protocol. Ignored for URLs and buffers. Falls back to the
+   * `file:` protocol where the backend is not supported.
+   *
+   * @default false
+   */
+  fileIO?: boolean | FileIOOptions;
+
+  /**
+   * Read http(s) URLs through the native HTTP backend.
+   *
+   * Fetches blocks with parallel range requests ahead of the read position over
+   * keep-alive connections and caches them, which cuts open and seek latency
+   * for remote files (e.g. MP4s with `moov` at the end). Ignored for other
+   * inputs. FFmpeg `options` for the http protocol do not apply.
+   *
+   * @default false
+   */
+  httpIO?: boolean | HttpIOOptions;
+
+  /**
+   * Place small demuxed packets (audio, subtitles, data) in slab memory.
+   *
+   * Useful with many concurrent inputs, where per-packet heap allocations
+   * freed on another thread add up. Packets above the allocator's `maxSize`
+   * are unaffected.
+   *
+   * @see {@link PacketAllocator}
+   */
+  packetAllocator?: PacketAllocator;
+
+  /**
+   * Record every packet read into a trace for offline replay.
+   *
+   * The recorder must be open. Replay the trace with {@link MediaInput.openTrace}.
+   *
+   * @see {@link PacketRecorder}
+   */
+  packetRecorder?: PacketRecorder;
+
+  /**
+   * Read at the native rate instead of as fast as possible (ffmpeg `-re`).
+   *
+   * Packets are released natively by their dts against a monotonic clock.
+   * Use {@link MediaInput.getReadRateStats} to monitor lateness.
+   *
+   * @default false
+   */
+  readRate?: boolean | ReadRateOptions;
 }
 
 /**
@@ -117,6 +183,21 @@ export interface MediaOutputOptions {
    * ```
    */
   bufferSize?: number;
+
+  /**
+   * Write local files through the native file backend.
+   *
+   * Coalesces muxer writes into large blocks written asynchronously through
+   * io_uring (Linux) or a pwrite worker thread instead of FFmpeg's `file:` protocol.
+   * Ignored for URLs and custom I/O. Falls back to the `file:` protocol where
+   * the backend is not supported.
+   *
+   * For long recordings use `{ cache: 'direct', fsync: 'close' }` (or `'dontneed'`)
+   * to keep the written stream out of the page cache.
+   *
+   * @default false
+   */
+  fileIO?: boolean | FileIOOptions;
 }
 
 /**
@@ -138,6 +219,19 @@ export interface DecoderOptions {
 
   /** Hardware acceleration: Pass a HardwareContext instance */
   hardware?: HardwareContext | null;
+
+  /**
+   * Number of parallel decoder instances for intra-only codecs (MJPEG, ProRes, PNG, ...).
+   * Values above 1 spread packets across independent codec contexts.
+   * Ignored for inter-frame codecs and hardware decoding.
+   */
+  parallel?: number;
+
+  /**
+   * Allocate decoded video frames from this arena (e.g. shared memory for workers).
+   * Falls back to regular buffers when no slot is free.
+   */
+  frameArena?: FrameArena;
 }
 
 /**
@@ -177,6 +271,75 @@ export interface EncoderOptions {
 
   /** Additional codec-specific options (passed to AVOptions) */
   options?: Record<string, string | number>;
+
+  /** Allocate small encoded packets from this slab allocator */
+  packetAllocator?: PacketAllocator;
+
+  /**
+   * Continue frames of a new size on a new encoder instance (default: false).
+   *
+   * Without it only a prepared spare switches instances, frames of another size
+   * are rejected with an error. Requires in-band parameter sets (no AV_CODEC_FLAG_GLOBAL_HEADER).
+   */
+  switchOnResize?: boolean;
+}
+
+/**
+ * Runtime changes for a running encoder.
+ */
+export interface EncoderReconfigureOptions {
+  /** Target bitrate (number, bigint, or string like '800k') */
+  bitrate?: number | bigint | string;
+
+  /** Maximum bitrate (number, bigint, or string like '1M') */
+  maxRate?: number | bigint | string;
+
+  /** Buffer size (number, bigint, or string like '500k') */
+  bufSize?: number | bigint | string;
+
+  /** Constant rate factor (encoders with a `crf` option) */
+  crf?: number;
+
+  /** Encode the next frame as keyframe */
+  keyframe?: boolean;
+}
+
+/**
+ * Configuration of a spare encoder opened ahead of a switch.
+ *
+ * Unset values are taken from the running encoder.
+ */
+export interface EncoderSpareOptions {
+  /** Frame width after the switch */
+  width?: number;
+
+  /** Frame height after the switch */
+  height?: number;
+
+  /** Target bitrate (number, bigint, or string like '800k') */
+  bitrate?: number | bigint | string;
+
+  /** Maximum bitrate (number, bigint, or string like '1M') */
+  maxRate?: number | bigint | string;
+
+  /** Buffer size (number, bigint, or string like '500k') */
+  bufSize?: number | bigint | string;
+}
+
+/**
+ * Runtime reconfiguration statistics of an encoder.
+ *
+ * Codec counters refer to the encoder instance currently in use.
+ */
+export interface EncoderReconfigureStats extends CodecReconfigureStats {
+  /** Switches to another encoder instance */
+  switches: number;
+
+  /** Switches to a spare opened in advance */
+  warmSwitches: number;
+
+  /** Milliseconds the last switch took (drain plus open for cold switches) */
+  lastSwitchLatency: number;
 }
 
 /**
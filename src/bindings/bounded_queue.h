@@ -0,0 +1,120 @@
+#ifndef FFMPEG_BOUNDED_QUEUE_H
+#define FFMPEG_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace ffmpeg {
+
+/**
+ * Blocking FIFO with a fixed capacity, shared between native worker threads.
+ *
+ * Push blocks while the queue is full, pop blocks while it is empty. Closing
+ * the queue wakes all waiters: pending items can still be popped, further
+ * pushes fail. Items are not owned - use Drain() to release leftovers.
+ */
+template <typename T>
+class BoundedQueue {
+public:
+  explicit BoundedQueue(size_t capacity) : capacity_(capacity ? capacity : 1) {}
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // Returns false if the queue was closed before the item could be queued
+  bool Push(T item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+    if (closed_) {
+      return false;
+    }
+    items_.push_back(item);
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Returns false if the queue is full or closed
+  bool TryPush(T item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_ || items_.size() >= capacity_) {
+      return false;
+    }
+    items_.push_back(item);
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Returns false once the queue is closed and empty
+  bool Pop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+    if (items_.empty()) {
+      return false;
+    }
+    item = items_.front();
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  // Returns false if no item is available right now
+  bool TryPop(T& item) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (items_.empty()) {
+      return false;
+    }
+    item = items_.front();
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  // Reopen an empty queue for reuse
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = false;
+  }
+
+  template <typename Fn>
+  void Drain(Fn release) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (T& item : items_) {
+      release(item);
+    }
+    items_.clear();
+    not_full_.notify_all();
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return items_.size();
+  }
+
+  size_t Capacity() const { return capacity_; }
+
+  bool IsClosed() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return closed_;
+  }
+
+private:
+  std::deque<T> items_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  size_t capacity_;
+  bool closed_ = false;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_BOUNDED_QUEUE_H
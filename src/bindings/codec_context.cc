@@ -6,8 +6,13 @@
 #include "dictionary.h"
 #include "hardware_device_context.h"
 #include "hardware_frames_context.h"
+#include "frame_arena.h"
+#include "packet_allocator.h"
 #include "common.h"
 
+#include <climits>
+#include <cstring>
+
 extern "C" {
 #include <libavutil/pixfmt.h>
 #include <libavutil/opt.h>
@@ -35,6 +40,10 @@ Napi::Object CodecContext::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&CodecContext::ReceivePacketAsync>("receivePacket"),
     InstanceMethod<&CodecContext::ReceivePacketSync>("receivePacketSync"),
     InstanceMethod<&CodecContext::SetHardwarePixelFormat>("setHardwarePixelFormat"),
+    InstanceMethod<&CodecContext::SetFrameArena>("setFrameArena"),
+    InstanceMethod<&CodecContext::SetPacketAllocator>("setPacketAllocator"),
+    InstanceMethod<&CodecContext::Reconfigure>("reconfigure"),
+    InstanceMethod<&CodecContext::GetReconfigureStats>("getReconfigureStats"),
     InstanceMethod<&CodecContext::Dispose>(Napi::Symbol::WellKnown(env, "dispose")),
 
     InstanceAccessor<&CodecContext::GetCodecType, &CodecContext::SetCodecType>("codecType"),
@@ -930,4 +939,308 @@ enum AVPixelFormat CodecContext::GetFormatCallback(AVCodecContext* ctx, const en
   return pix_fmts[0];
 }
 
-} // namespace ffmpeg
\ No newline at end of file
+Napi::Value CodecContext::SetFrameArena(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!context_) {
+    Napi::Error::New(env, "CodecContext not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    frame_arena_.reset();
+    context_->get_buffer2 = avcodec_default_get_buffer2;
+    return env.Undefined();
+  }
+
+  FrameArena* arena = UnwrapNativeObject<FrameArena>(env, info[0], "FrameArena");
+  if (!arena || !arena->GetState()) {
+    Napi::TypeError::New(env, "Invalid or unallocated frame arena").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Decoded frames are allocated from the arena, falling back to the default allocator
+  frame_arena_ = arena->GetState();
+  context_->opaque = this;
+  context_->get_buffer2 = CodecContext::GetBufferCallback;
+
+  return env.Undefined();
+}
+
+int CodecContext::GetBufferCallback(AVCodecContext* ctx, AVFrame* frame, int flags) {
+  CodecContext* self = static_cast<CodecContext*>(ctx->opaque);
+  std::shared_ptr<FrameArenaState> arena = self ? self->frame_arena_ : nullptr;
+
+  // Custom allocators are only allowed for direct-rendering capable decoders
+  if (arena && (ctx->codec->capabilities & AV_CODEC_CAP_DR1)) {
+    int ret = FrameArenaState::GetVideoBuffer(arena, ctx, frame);
+    if (ret >= 0) {
+      return ret;
+    }
+
+    std::lock_guard<std::mutex> lock(arena->mutex);
+    arena->fallbacks++;
+  }
+
+  return avcodec_default_get_buffer2(ctx, frame, flags);
+}
+
+Napi::Value CodecContext::SetPacketAllocator(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!context_) {
+    Napi::Error::New(env, "CodecContext not allocated").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    packet_allocator_.reset();
+    context_->get_encode_buffer = avcodec_default_get_encode_buffer;
+    return env.Undefined();
+  }
+
+  PacketAllocator* allocator = UnwrapNativeObject<PacketAllocator>(env, info[0], "PacketAllocator");
+  if (!allocator || !allocator->GetState()) {
+    Napi::TypeError::New(env, "Invalid or unallocated packet allocator").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Encoders with direct rendering write into slab memory, other encoder
+  // output is copied into it in receivePacket()
+  packet_allocator_ = allocator->GetState();
+  context_->opaque = this;
+  context_->get_encode_buffer = CodecContext::GetEncodeBufferCallback;
+
+  return env.Undefined();
+}
+
+int CodecContext::GetEncodeBufferCallback(AVCodecContext* ctx, AVPacket* pkt, int flags) {
+  CodecContext* self = static_cast<CodecContext*>(ctx->opaque);
+  std::shared_ptr<PacketAllocatorState> allocator = self ? self->packet_allocator_ : nullptr;
+
+  if (allocator && PacketAllocatorState::GetEncodeBuffer(allocator, pkt) >= 0) {
+    return 0;
+  }
+  if (allocator && static_cast<size_t>(pkt->size) <= allocator->max_size) {
+    allocator->fallbacks++;
+  }
+
+  return avcodec_default_get_encode_buffer(ctx, pkt, flags);
+}
+
+// Encoders whose FFmpeg wrapper compares the rate control fields against its
+// configuration on every frame and reconfigures the running encoder
+bool CodecContext::SupportsLiveRateControl(const AVCodec* codec) {
+  static const char* const kLiveEncoders[] = {
+    "libx264", "libx264rgb", "h264_nvenc", "hevc_nvenc", "av1_nvenc",
+  };
+
+  if (!codec || !codec->name) {
+    return false;
+  }
+  for (const char* name : kLiveEncoders) {
+    if (strcmp(codec->name, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool GetInt64Option(const Napi::Object& options, const char* key, int64_t* value) {
+  if (!options.Has(key)) {
+    return false;
+  }
+  Napi::Value v = options.Get(key);
+  if (v.IsBigInt()) {
+    bool lossless;
+    *value = v.As<Napi::BigInt>().Int64Value(&lossless);
+    return true;
+  }
+  if (v.IsNumber()) {
+    *value = v.As<Napi::Number>().Int64Value();
+    return true;
+  }
+  return false;
+}
+
+Napi::Value CodecContext::Reconfigure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!context_ || info.Length() < 1 || !info[0].IsObject()) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  Napi::Object options = info[0].As<Napi::Object>();
+
+  int64_t bit_rate = -1;
+  int64_t rc_max_rate = -1;
+  int64_t rc_buffer_size = -1;
+  double crf = -1;
+  bool has_bit_rate = GetInt64Option(options, "bitRate", &bit_rate);
+  bool has_max_rate = GetInt64Option(options, "rcMaxRate", &rc_max_rate);
+  bool has_buffer_size = GetInt64Option(options, "rcBufferSize", &rc_buffer_size);
+  bool has_crf = options.Has("crf") && options.Get("crf").IsNumber();
+  bool keyframe = options.Has("keyframe") && options.Get("keyframe").ToBoolean().Value();
+  if (has_crf) {
+    crf = options.Get("crf").As<Napi::Number>().DoubleValue();
+  }
+
+  if ((has_bit_rate && bit_rate <= 0) || (has_max_rate && rc_max_rate < 0) ||
+      (has_buffer_size && (rc_buffer_size < 0 || rc_buffer_size > INT_MAX)) || (has_crf && crf < 0)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  if (has_crf && !av_opt_find(context_, "crf", nullptr, 0, AV_OPT_SEARCH_CHILDREN)) {
+    return Napi::Number::New(env, AVERROR(ENOSYS));
+  }
+
+  bool rate_change = has_bit_rate || has_max_rate || has_buffer_size || has_crf;
+
+  if (rate_change && !is_open_) {
+    // Not running yet: becomes part of the configuration avcodec_open2() sees
+    if (has_bit_rate) context_->bit_rate = bit_rate;
+    if (has_max_rate) context_->rc_max_rate = rc_max_rate;
+    if (has_buffer_size) context_->rc_buffer_size = static_cast<int>(rc_buffer_size);
+    if (has_crf) av_opt_set_double(context_, "crf", crf, AV_OPT_SEARCH_CHILDREN);
+    rate_change = false;
+  } else if (rate_change && !SupportsLiveRateControl(context_->codec)) {
+    // Would be silently ignored by the running encoder
+    return Napi::Number::New(env, AVERROR(ENOSYS));
+  }
+
+  if (!rate_change && !keyframe) {
+    return Napi::Number::New(env, 0);
+  }
+
+  std::lock_guard<std::mutex> lock(reconfigure_mutex_);
+  if (!reconfigure_.pending) {
+    reconfigure_.requested = std::chrono::steady_clock::now();
+  }
+  reconfigure_.pending = true;
+  if (rate_change) {
+    if (has_bit_rate) reconfigure_.bit_rate = bit_rate;
+    if (has_max_rate) reconfigure_.rc_max_rate = rc_max_rate;
+    if (has_buffer_size) reconfigure_.rc_buffer_size = rc_buffer_size;
+    if (has_crf) reconfigure_.crf = crf;
+  }
+  reconfigure_.keyframe = reconfigure_.keyframe || keyframe;
+
+  return Napi::Number::New(env, 0);
+}
+
+// Called right before avcodec_send_frame() on the thread sending the frame,
+// so the change lands exactly on this frame and never races the encoder
+ForcedKeyframe CodecContext::ApplyReconfigure(AVFrame* frame) {
+  ForcedKeyframe forced;
+  std::lock_guard<std::mutex> lock(reconfigure_mutex_);
+  if (!reconfigure_.pending || !frame || !context_) {
+    return forced;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  double latency = std::chrono::duration<double, std::milli>(now - reconfigure_.requested).count();
+
+  bool rate_change = false;
+  if (reconfigure_.bit_rate >= 0) {
+    context_->bit_rate = reconfigure_.bit_rate;
+    rate_change = true;
+  }
+  if (reconfigure_.rc_max_rate >= 0) {
+    context_->rc_max_rate = reconfigure_.rc_max_rate;
+    rate_change = true;
+  }
+  if (reconfigure_.rc_buffer_size >= 0) {
+    context_->rc_buffer_size = static_cast<int>(reconfigure_.rc_buffer_size);
+    rate_change = true;
+  }
+  if (reconfigure_.crf >= 0) {
+    av_opt_set_double(context_, "crf", reconfigure_.crf, AV_OPT_SEARCH_CHILDREN);
+    rate_change = true;
+  }
+  if (rate_change) {
+    reconfigure_stats_.reconfigurations++;
+  }
+
+  if (reconfigure_.keyframe) {
+    // An IDR frame where the encoder lets us choose, so decoders can join
+    forced.active = true;
+    forced.pict_type = frame->pict_type;
+    if (!forced_idr_.active) {
+      // Keep the caller's values across overlapping requests
+      forced_idr_.active = true;
+      forced_idr_.has_forced_idr = av_opt_get_int(context_, "forced-idr", AV_OPT_SEARCH_CHILDREN, &forced_idr_.forced_idr) >= 0;
+      forced_idr_.has_forced_idr_alt = av_opt_get_int(context_, "forced_idr", AV_OPT_SEARCH_CHILDREN, &forced_idr_.forced_idr_alt) >= 0;
+    }
+    if (forced_idr_.has_forced_idr) av_opt_set_int(context_, "forced-idr", 1, AV_OPT_SEARCH_CHILDREN);
+    if (forced_idr_.has_forced_idr_alt) av_opt_set_int(context_, "forced_idr", 1, AV_OPT_SEARCH_CHILDREN);
+    frame->pict_type = AV_PICTURE_TYPE_I;
+    reconfigure_stats_.keyframe_requests++;
+    awaiting_keyframe_ = true;
+    keyframe_pts_ = frame->pts;
+    keyframe_requested_ = reconfigure_.requested;
+  }
+
+  reconfigure_stats_.last_apply_latency = latency;
+  reconfigure_ = PendingReconfigure();
+  return forced;
+}
+
+// Later frames the caller marks as I frames must not all become IDR frames.
+// Called with reconfigure_mutex_ held.
+void CodecContext::RestoreForcedIdr() {
+  if (!forced_idr_.active || !context_) {
+    return;
+  }
+  if (forced_idr_.has_forced_idr) av_opt_set_int(context_, "forced-idr", forced_idr_.forced_idr, AV_OPT_SEARCH_CHILDREN);
+  if (forced_idr_.has_forced_idr_alt) av_opt_set_int(context_, "forced_idr", forced_idr_.forced_idr_alt, AV_OPT_SEARCH_CHILDREN);
+  forced_idr_ = ForcedIdrOptions();
+}
+
+int CodecContext::SendFrameInternal(AVFrame* frame) {
+  ForcedKeyframe forced = ApplyReconfigure(frame);
+  int ret = avcodec_send_frame(context_, frame);
+  if (forced.active) {
+    // The encoder keeps its own reference, the frame belongs to the caller
+    frame->pict_type = forced.pict_type;
+  }
+  if (!frame) {
+    // Draining: no frame can be encoded with the option anymore
+    std::lock_guard<std::mutex> lock(reconfigure_mutex_);
+    RestoreForcedIdr();
+  }
+  return ret;
+}
+
+void CodecContext::TrackForcedKeyframe(const AVPacket* packet) {
+  std::lock_guard<std::mutex> lock(reconfigure_mutex_);
+  if (!awaiting_keyframe_ || !(packet->flags & AV_PKT_FLAG_KEY)) {
+    return;
+  }
+  if (keyframe_pts_ != AV_NOPTS_VALUE && packet->pts != keyframe_pts_) {
+    return;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  reconfigure_stats_.last_keyframe_latency = std::chrono::duration<double, std::milli>(now - keyframe_requested_).count();
+  reconfigure_stats_.forced_keyframes++;
+  awaiting_keyframe_ = false;
+
+  // The encoder has handled the forced frame
+  RestoreForcedIdr();
+}
+
+Napi::Value CodecContext::GetReconfigureStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  std::lock_guard<std::mutex> lock(reconfigure_mutex_);
+  stats.Set("reconfigurations", Napi::Number::New(env, static_cast<double>(reconfigure_stats_.reconfigurations)));
+  stats.Set("keyframeRequests", Napi::Number::New(env, static_cast<double>(reconfigure_stats_.keyframe_requests)));
+  stats.Set("forcedKeyframes", Napi::Number::New(env, static_cast<double>(reconfigure_stats_.forced_keyframes)));
+  stats.Set("lastApplyLatency", Napi::Number::New(env, reconfigure_stats_.last_apply_latency));
+  stats.Set("lastKeyframeLatency", Napi::Number::New(env, reconfigure_stats_.last_keyframe_latency));
+  stats.Set("pending", Napi::Boolean::New(env, reconfigure_.pending));
+  stats.Set("liveRateControl", Napi::Boolean::New(env, context_ && SupportsLiveRateControl(context_->codec)));
+
+  return stats;
+}
+
+} // namespace ffmpeg
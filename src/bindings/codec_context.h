@@ -3,7 +3,9 @@
 
 #include <napi.h>
 #include "common.h"
+#include <chrono>
 #include <memory>
+#include <mutex>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -12,6 +14,44 @@ extern "C" {
 
 namespace ffmpeg {
 
+struct FrameArenaState;
+struct PacketAllocatorState;
+
+// Runtime encoder changes requested from JS, applied with the next frame
+struct PendingReconfigure {
+  bool pending = false;
+  int64_t bit_rate = -1;
+  int64_t rc_max_rate = -1;
+  int64_t rc_buffer_size = -1;
+  double crf = -1;
+  bool keyframe = false;
+  std::chrono::steady_clock::time_point requested;
+};
+
+// Picture type of the caller's frame, restored once the frame is sent
+struct ForcedKeyframe {
+  bool active = false;
+  enum AVPictureType pict_type = AV_PICTURE_TYPE_NONE;
+};
+
+// Encoder forced-idr options before a keyframe request, restored once the
+// encoder has produced the keyframe (it may still hold the frame after sending)
+struct ForcedIdrOptions {
+  bool active = false;
+  bool has_forced_idr = false;
+  int64_t forced_idr = 0;
+  bool has_forced_idr_alt = false;
+  int64_t forced_idr_alt = 0;
+};
+
+struct ReconfigureStats {
+  uint64_t reconfigurations = 0;      // Rate changes applied to a frame
+  uint64_t keyframe_requests = 0;     // Keyframes forced on a frame
+  uint64_t forced_keyframes = 0;      // Forced keyframes received as key packets
+  double last_apply_latency = 0;      // Request to first frame encoded with it (ms)
+  double last_keyframe_latency = 0;   // Keyframe request to key packet (ms)
+};
+
 class CodecContext : public Napi::ObjectWrap<CodecContext> {
 public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
@@ -37,6 +77,24 @@ private:
   enum AVPixelFormat hw_pix_fmt_ = AV_PIX_FMT_NONE;
   enum AVPixelFormat sw_pix_fmt_ = AV_PIX_FMT_NONE;
 
+  std::shared_ptr<FrameArenaState> frame_arena_;
+  std::shared_ptr<PacketAllocatorState> packet_allocator_;
+
+  // Runtime reconfiguration (guarded by reconfigure_mutex_)
+  std::mutex reconfigure_mutex_;
+  PendingReconfigure reconfigure_;
+  ReconfigureStats reconfigure_stats_;
+  ForcedIdrOptions forced_idr_;
+  bool awaiting_keyframe_ = false;
+  int64_t keyframe_pts_ = AV_NOPTS_VALUE;
+  std::chrono::steady_clock::time_point keyframe_requested_;
+
+  static bool SupportsLiveRateControl(const AVCodec* codec);
+  ForcedKeyframe ApplyReconfigure(AVFrame* frame);
+  void RestoreForcedIdr();
+  int SendFrameInternal(AVFrame* frame);
+  void TrackForcedKeyframe(const AVPacket* packet);
+
   Napi::Value AllocContext3(const Napi::CallbackInfo& info);
   Napi::Value FreeContext(const Napi::CallbackInfo& info);
   Napi::Value Open2Async(const Napi::CallbackInfo& info);
@@ -173,6 +231,13 @@ private:
   
   // Static callback for FFmpeg
   static enum AVPixelFormat GetFormatCallback(AVCodecContext* ctx, const enum AVPixelFormat* pix_fmts);
+
+  Napi::Value SetFrameArena(const Napi::CallbackInfo& info);
+  Napi::Value SetPacketAllocator(const Napi::CallbackInfo& info);
+  Napi::Value Reconfigure(const Napi::CallbackInfo& info);
+  Napi::Value GetReconfigureStats(const Napi::CallbackInfo& info);
+  static int GetBufferCallback(AVCodecContext* ctx, AVFrame* frame, int flags);
+  static int GetEncodeBufferCallback(AVCodecContext* ctx, AVPacket* pkt, int flags);
 };
 
 } // namespace ffmpeg
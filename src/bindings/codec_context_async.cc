@@ -1,6 +1,7 @@
 #include "codec_context.h"
 #include "packet.h"
 #include "frame.h"
+#include "packet_allocator.h"
 #include "codec.h"
 #include "dictionary.h"
 #include "common.h"
@@ -162,7 +163,7 @@ public:
     }
     
     // Simply pass to FFmpeg and let it handle validation
-    ret_ = avcodec_send_frame(ctx_->context_, frame_ ? frame_->Get() : nullptr);
+    ret_ = ctx_->SendFrameInternal(frame_ ? frame_->Get() : nullptr);
   }
 
   void OnOK() override {
@@ -190,11 +191,18 @@ public:
     : Napi::AsyncWorker(env), 
       ctx_(ctx), 
       packet_(packet), 
+      allocator_(ctx->packet_allocator_),
       ret_(0),
       deferred_(Napi::Promise::Deferred::New(env)) {}
 
   void Execute() override {
     ret_ = avcodec_receive_packet(ctx_->context_, packet_->Get());
+    if (ret_ >= 0) {
+      ctx_->TrackForcedKeyframe(packet_->Get());
+    }
+    if (ret_ >= 0 && allocator_) {
+      PacketAllocatorState::Adopt(allocator_, packet_->Get());
+    }
   }
 
   void OnOK() override {
@@ -212,6 +220,7 @@ public:
 private:
   CodecContext* ctx_;
   Packet* packet_;
+  std::shared_ptr<PacketAllocatorState> allocator_;
   int ret_;
   Napi::Promise::Deferred deferred_;
 };
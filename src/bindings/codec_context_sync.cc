@@ -1,6 +1,7 @@
 #include "codec_context.h"
 #include "packet.h"
 #include "frame.h"
+#include "packet_allocator.h"
 #include "codec.h"
 #include "dictionary.h"
 #include "common.h"
@@ -115,7 +116,7 @@ Napi::Value CodecContext::SendFrameSync(const Napi::CallbackInfo& info) {
   }
 
   // Direct synchronous call
-  int ret = avcodec_send_frame(context_, frame ? frame->Get() : nullptr);
+  int ret = SendFrameInternal(frame ? frame->Get() : nullptr);
 
   return Napi::Number::New(env, ret);
 }
@@ -141,6 +142,12 @@ Napi::Value CodecContext::ReceivePacketSync(const Napi::CallbackInfo& info) {
 
   // Direct synchronous call
   int ret = avcodec_receive_packet(context_, packet->Get());
+  if (ret >= 0) {
+    TrackForcedKeyframe(packet->Get());
+  }
+  if (ret >= 0 && packet_allocator_) {
+    PacketAllocatorState::Adopt(packet_allocator_, packet->Get());
+  }
 
   return Napi::Number::New(env, ret);
 }
@@ -0,0 +1,769 @@
+#include "color_transform.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+
+extern "C" {
+#include <libavutil/common.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+// LUTs no transform uses anymore are kept up to this cache size
+constexpr size_t kMaxCachedLuts = 16;
+
+std::mutex cache_mutex;
+std::map<ColorLutKey, std::shared_ptr<const ColorLut>> lut_cache;
+
+using Vec3 = std::array<double, 3>;
+using Mat3 = std::array<Vec3, 3>;
+
+Vec3 Mul(const Mat3& m, const Vec3& v) {
+  return { m[0][0] * v[0] + m[0][1] * v[1] + m[0][2] * v[2],
+           m[1][0] * v[0] + m[1][1] * v[1] + m[1][2] * v[2],
+           m[2][0] * v[0] + m[2][1] * v[1] + m[2][2] * v[2] };
+}
+
+Mat3 Mul(const Mat3& a, const Mat3& b) {
+  Mat3 m{};
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      m[r][c] = a[r][0] * b[0][c] + a[r][1] * b[1][c] + a[r][2] * b[2][c];
+    }
+  }
+  return m;
+}
+
+Mat3 Invert(const Mat3& m) {
+  double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+               m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+  Mat3 inv{};
+  inv[0][0] = (m[1][1] * m[2][2] - m[1][2] * m[2][1]) / det;
+  inv[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) / det;
+  inv[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) / det;
+  inv[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) / det;
+  inv[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) / det;
+  inv[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) / det;
+  inv[2][0] = (m[1][0] * m[2][1] - m[1][1] * m[2][0]) / det;
+  inv[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) / det;
+  inv[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) / det;
+  return inv;
+}
+
+// CIE 1931 xy of red, green, blue and white (all D65)
+bool PrimariesXy(int primaries, double xy[4][2]) {
+  static const double kBt709[4][2] = { { 0.640, 0.330 }, { 0.300, 0.600 }, { 0.150, 0.060 }, { 0.3127, 0.3290 } };
+  static const double kBt470bg[4][2] = { { 0.640, 0.330 }, { 0.290, 0.600 }, { 0.150, 0.060 }, { 0.3127, 0.3290 } };
+  static const double kSmpte170m[4][2] = { { 0.630, 0.340 }, { 0.310, 0.595 }, { 0.155, 0.070 }, { 0.3127, 0.3290 } };
+  static const double kBt2020[4][2] = { { 0.708, 0.292 }, { 0.170, 0.797 }, { 0.131, 0.046 }, { 0.3127, 0.3290 } };
+  static const double kDisplayP3[4][2] = { { 0.680, 0.320 }, { 0.265, 0.690 }, { 0.150, 0.060 }, { 0.3127, 0.3290 } };
+
+  const double (*table)[2] = nullptr;
+  switch (primaries) {
+    case AVCOL_PRI_BT709: table = kBt709; break;
+    case AVCOL_PRI_BT470BG: table = kBt470bg; break;
+    case AVCOL_PRI_SMPTE170M:
+    case AVCOL_PRI_SMPTE240M: table = kSmpte170m; break;
+    case AVCOL_PRI_BT2020: table = kBt2020; break;
+    case AVCOL_PRI_SMPTE432: table = kDisplayP3; break;
+    default: return false;
+  }
+  if (xy) {
+    memcpy(xy, table, sizeof(double) * 8);
+  }
+  return true;
+}
+
+Mat3 RgbToXyz(const double xy[4][2]) {
+  // XYZ of each primary at Y = 1, scaled so that RGB 1,1,1 is the white point
+  Mat3 m{};
+  for (int i = 0; i < 3; i++) {
+    m[0][i] = xy[i][0] / xy[i][1];
+    m[1][i] = 1.0;
+    m[2][i] = (1.0 - xy[i][0] - xy[i][1]) / xy[i][1];
+  }
+  Vec3 white = { xy[3][0] / xy[3][1], 1.0, (1.0 - xy[3][0] - xy[3][1]) / xy[3][1] };
+  Vec3 scale = Mul(Invert(m), white);
+  for (int r = 0; r < 3; r++) {
+    for (int c = 0; c < 3; c++) {
+      m[r][c] *= scale[c];
+    }
+  }
+  return m;
+}
+
+bool LumaCoefficients(int space, double* kr, double* kb) {
+  switch (space) {
+    case AVCOL_SPC_BT709: *kr = 0.2126; *kb = 0.0722; return true;
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M: *kr = 0.299; *kb = 0.114; return true;
+    case AVCOL_SPC_BT2020_NCL: *kr = 0.2627; *kb = 0.0593; return true;
+    case AVCOL_SPC_SMPTE240M: *kr = 0.212; *kb = 0.087; return true;
+    case AVCOL_SPC_FCC: *kr = 0.30; *kb = 0.11; return true;
+    default: return false;
+  }
+}
+
+bool IsHdrTrc(int trc) {
+  return trc == AVCOL_TRC_SMPTE2084 || trc == AVCOL_TRC_ARIB_STD_B67;
+}
+
+bool IsSupportedTrc(int trc, bool destination) {
+  switch (trc) {
+    case AVCOL_TRC_BT709:
+    case AVCOL_TRC_SMPTE170M:
+    case AVCOL_TRC_SMPTE240M:
+    case AVCOL_TRC_BT2020_10:
+    case AVCOL_TRC_BT2020_12:
+    case AVCOL_TRC_IEC61966_2_1:
+    case AVCOL_TRC_GAMMA22:
+    case AVCOL_TRC_GAMMA28:
+    case AVCOL_TRC_LINEAR:
+    case AVCOL_TRC_SMPTE2084:
+      return true;
+    case AVCOL_TRC_ARIB_STD_B67:
+      return !destination;
+    default:
+      return false;
+  }
+}
+
+bool IsSupported(const ColorLutKey& key) {
+  double kr, kb;
+  return PrimariesXy(key.src_primaries, nullptr) && PrimariesXy(key.dst_primaries, nullptr) &&
+         IsSupportedTrc(key.src_trc, false) && IsSupportedTrc(key.dst_trc, true) &&
+         LumaCoefficients(key.src_space, &kr, &kb) && LumaCoefficients(key.dst_space, &kr, &kb) &&
+         (key.src_range == AVCOL_RANGE_MPEG || key.src_range == AVCOL_RANGE_JPEG) &&
+         (key.dst_range == AVCOL_RANGE_MPEG || key.dst_range == AVCOL_RANGE_JPEG);
+}
+
+// SMPTE ST 2084
+constexpr double kPqM1 = 2610.0 / 16384.0;
+constexpr double kPqM2 = 2523.0 / 4096.0 * 128.0;
+constexpr double kPqC1 = 3424.0 / 4096.0;
+constexpr double kPqC2 = 2413.0 / 4096.0 * 32.0;
+constexpr double kPqC3 = 2392.0 / 4096.0 * 32.0;
+
+double PqToNits(double e) {
+  double p = std::pow(std::clamp(e, 0.0, 1.0), 1.0 / kPqM2);
+  return 10000.0 * std::pow(std::max(p - kPqC1, 0.0) / (kPqC2 - kPqC3 * p), 1.0 / kPqM1);
+}
+
+double NitsToPq(double nits) {
+  double y = std::pow(std::clamp(nits / 10000.0, 0.0, 1.0), kPqM1);
+  return std::pow((kPqC1 + kPqC2 * y) / (1.0 + kPqC3 * y), kPqM2);
+}
+
+// ARIB STD-B67 inverse OETF, scene light 0..1
+double HlgToScene(double e) {
+  constexpr double a = 0.17883277, b = 0.28466892, c = 0.55991073;
+  e = std::clamp(e, 0.0, 1.0);
+  return e <= 0.5 ? e * e / 3.0 : (std::exp((e - c) / a) + b) / 12.0;
+}
+
+// SDR signal to display light, 1.0 = reference white
+double SdrToLinear(int trc, double e) {
+  e = std::clamp(e, 0.0, 1.0);
+  switch (trc) {
+    case AVCOL_TRC_IEC61966_2_1: return e <= 0.04045 ? e / 12.92 : std::pow((e + 0.055) / 1.055, 2.4);
+    case AVCOL_TRC_GAMMA22: return std::pow(e, 2.2);
+    case AVCOL_TRC_GAMMA28: return std::pow(e, 2.8);
+    case AVCOL_TRC_LINEAR: return e;
+    default: return std::pow(e, 2.4); // BT.1886 display, zero black level
+  }
+}
+
+double LinearToSdr(int trc, double l) {
+  l = std::clamp(l, 0.0, 1.0);
+  switch (trc) {
+    case AVCOL_TRC_IEC61966_2_1: return l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+    case AVCOL_TRC_GAMMA22: return std::pow(l, 1.0 / 2.2);
+    case AVCOL_TRC_GAMMA28: return std::pow(l, 1.0 / 2.8);
+    case AVCOL_TRC_LINEAR: return l;
+    default: return std::pow(l, 1.0 / 2.4);
+  }
+}
+
+// R'G'B' to display light relative to reference white
+Vec3 ToLinear(const ColorLutKey& key, const Vec3& rgb) {
+  Vec3 l{};
+  if (key.src_trc == AVCOL_TRC_SMPTE2084) {
+    for (int i = 0; i < 3; i++) {
+      l[i] = PqToNits(rgb[i]) / key.sdr_white;
+    }
+  } else if (key.src_trc == AVCOL_TRC_ARIB_STD_B67) {
+    // BT.2100 OOTF with the system gamma for the display peak
+    Vec3 scene = { HlgToScene(rgb[0]), HlgToScene(rgb[1]), HlgToScene(rgb[2]) };
+    double ys = 0.2627 * scene[0] + 0.6780 * scene[1] + 0.0593 * scene[2];
+    double gamma = 1.2 + 0.42 * std::log10(key.peak / 1000.0);
+    double scale = key.peak * std::pow(std::max(ys, 1e-9), gamma - 1.0) / key.sdr_white;
+    for (int i = 0; i < 3; i++) {
+      l[i] = scene[i] * scale;
+    }
+  } else {
+    for (int i = 0; i < 3; i++) {
+      l[i] = SdrToLinear(key.src_trc, rgb[i]);
+    }
+  }
+  return l;
+}
+
+Vec3 FromLinear(const ColorLutKey& key, const Vec3& l) {
+  Vec3 e{};
+  for (int i = 0; i < 3; i++) {
+    e[i] = key.dst_trc == AVCOL_TRC_SMPTE2084 ? NitsToPq(l[i] * key.sdr_white) : LinearToSdr(key.dst_trc, l[i]);
+  }
+  return e;
+}
+
+double Hable(double x) {
+  constexpr double a = 0.15, b = 0.50, c = 0.10, d = 0.20, e = 0.02, f = 0.30;
+  return (x * (x * a + c * b) + d * e) / (x * (x * a + b) + d * f) - e / f;
+}
+
+// Tone curves of the tonemap filter, signal and peak relative to reference white
+double ToneCurve(const ColorLutKey& key, double sig, double peak) {
+  switch (key.tonemap) {
+    case ToneMapping::kHable: return Hable(sig) / Hable(peak);
+    case ToneMapping::kReinhard: return sig / (sig + key.param) * (peak + key.param) / peak;
+    default: return std::min(sig, 1.0);
+  }
+}
+
+std::shared_ptr<ColorLut> BuildLut(const ColorLutKey& key) {
+  double src_xy[4][2], dst_xy[4][2];
+  double src_kr, src_kb, dst_kr, dst_kb;
+  PrimariesXy(key.src_primaries, src_xy);
+  PrimariesXy(key.dst_primaries, dst_xy);
+  LumaCoefficients(key.src_space, &src_kr, &src_kb);
+  LumaCoefficients(key.dst_space, &dst_kr, &dst_kb);
+
+  Mat3 gamut = Mul(Invert(RgbToXyz(dst_xy)), RgbToXyz(src_xy));
+  bool tonemap = IsHdrTrc(key.src_trc) && !IsHdrTrc(key.dst_trc) && key.tonemap != ToneMapping::kNone;
+  double peak = std::max(key.peak / key.sdr_white, 1.0);
+  double dst_peak = key.dst_trc == AVCOL_TRC_SMPTE2084 ? 10000.0 / key.sdr_white : 1.0;
+
+  double src_max = (1 << key.src_depth) - 1;
+  double dst_max = (1 << key.dst_depth) - 1;
+  double src_scale = 1 << (key.src_depth - 8);
+  double dst_scale = 1 << (key.dst_depth - 8);
+
+  auto lut = std::make_shared<ColorLut>();
+  int n = key.size;
+  lut->size = n;
+  lut->data.resize(static_cast<size_t>(n) * n * n * 3);
+  uint16_t* out = lut->data.data();
+
+  auto decode = [&](int index, bool chroma) {
+    double code = index * src_max / (n - 1);
+    if (key.src_range == AVCOL_RANGE_JPEG) {
+      return chroma ? (code - (src_max + 1) / 2) / src_max : code / src_max;
+    }
+    return chroma ? (code - 128 * src_scale) / (224 * src_scale) : (code - 16 * src_scale) / (219 * src_scale);
+  };
+  auto encode = [&](double value, bool chroma) {
+    double code;
+    if (key.dst_range == AVCOL_RANGE_JPEG) {
+      code = chroma ? value * dst_max + (dst_max + 1) / 2 : value * dst_max;
+    } else {
+      code = chroma ? (value * 224 + 128) * dst_scale : (value * 219 + 16) * dst_scale;
+    }
+    return static_cast<uint16_t>(std::clamp(std::lrint(code * 16), 0L, static_cast<long>(dst_max) * 16));
+  };
+
+  for (int iy = 0; iy < n; iy++) {
+    double y = decode(iy, false);
+    for (int icb = 0; icb < n; icb++) {
+      double cb = decode(icb, true);
+      for (int icr = 0; icr < n; icr++) {
+        double cr = decode(icr, true);
+
+        Vec3 rgb{};
+        rgb[0] = y + 2 * (1 - src_kr) * cr;
+        rgb[2] = y + 2 * (1 - src_kb) * cb;
+        rgb[1] = (y - src_kr * rgb[0] - src_kb * rgb[2]) / (1 - src_kr - src_kb);
+
+        Vec3 l = ToLinear(key, rgb);
+        if (tonemap) {
+          // On the largest component like the tonemap filter, keeps hue and saturation
+          double sig = std::max({ l[0], l[1], l[2] });
+          if (sig > 1e-6) {
+            double ratio = ToneCurve(key, sig, peak) / sig;
+            l = { l[0] * ratio, l[1] * ratio, l[2] * ratio };
+          }
+        }
+        l = Mul(gamut, l);
+        for (int i = 0; i < 3; i++) {
+          l[i] = std::clamp(l[i], 0.0, dst_peak);
+        }
+
+        Vec3 e = FromLinear(key, l);
+        double yo = dst_kr * e[0] + (1 - dst_kr - dst_kb) * e[1] + dst_kb * e[2];
+        *out++ = encode(yo, false);
+        *out++ = encode((e[2] - yo) / (2 * (1 - dst_kb)), true);
+        *out++ = encode((e[0] - yo) / (2 * (1 - dst_kr)), true);
+      }
+    }
+  }
+
+  return lut;
+}
+
+struct PlaneLayout {
+  int depth = 0;
+  int log2_w = 0;
+  int log2_h = 0;
+};
+
+// Planar 8 to 12-bit YUV in native byte order
+bool DescribeFormat(int format, PlaneLayout* layout) {
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(format));
+  if (!desc || desc->nb_components != 3 || !(desc->flags & AV_PIX_FMT_FLAG_PLANAR) ||
+      (desc->flags & (AV_PIX_FMT_FLAG_RGB | AV_PIX_FMT_FLAG_BE | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_FLOAT))) {
+    return false;
+  }
+
+  int depth = desc->comp[0].depth;
+  if (depth < 8 || depth > 12) {
+    return false;
+  }
+  for (int i = 0; i < 3; i++) {
+    if (desc->comp[i].plane != i || desc->comp[i].shift != 0 || desc->comp[i].depth != depth ||
+        desc->comp[i].step != (depth > 8 ? 2 : 1)) {
+      return false;
+    }
+  }
+
+  layout->depth = depth;
+  layout->log2_w = desc->log2_chroma_w;
+  layout->log2_h = desc->log2_chroma_h;
+  return true;
+}
+
+struct Lattice {
+  const uint16_t* data;
+  uint32_t size;
+  uint32_t scale;                 // Source code to lattice position (16.16)
+  uint32_t max_code;
+  size_t stride_y;
+  size_t stride_cb;
+};
+
+inline void Locate(const Lattice& lat, uint32_t v, uint32_t* index, uint32_t* frac) {
+  uint32_t pos = std::min(v, lat.max_code) * lat.scale;
+  *index = pos >> 16;
+  *frac = pos & 0xFFFF;
+  if (*index >= lat.size - 1) {
+    *index = lat.size - 2;
+    *frac = 0x10000;
+  }
+}
+
+// Tetrahedral interpolation: the lattice cube around the sample is split into
+// six tetrahedra along its diagonal, the fractions' order picks one and its
+// four corners are blended (4 taps instead of trilinear's 8)
+inline void Lookup(const Lattice& lat, uint32_t y, uint32_t cb, uint32_t cr, uint32_t out[3]) {
+  uint32_t iy, icb, icr, fy, fcb, fcr;
+  Locate(lat, y, &iy, &fy);
+  Locate(lat, cb, &icb, &fcb);
+  Locate(lat, cr, &icr, &fcr);
+
+  const size_t sy = lat.stride_y;
+  const size_t scb = lat.stride_cb;
+  const size_t scr = 3;
+  const uint16_t* c000 = lat.data + iy * sy + icb * scb + icr * scr;
+  const uint16_t* c111 = c000 + sy + scb + scr;
+  const uint16_t* v1;
+  const uint16_t* v2;
+  uint32_t a, b, c;
+
+  if (fy >= fcb) {
+    if (fcb >= fcr) {
+      a = fy; b = fcb; c = fcr; v1 = c000 + sy; v2 = c000 + sy + scb;
+    } else if (fy >= fcr) {
+      a = fy; b = fcr; c = fcb; v1 = c000 + sy; v2 = c000 + sy + scr;
+    } else {
+      a = fcr; b = fy; c = fcb; v1 = c000 + scr; v2 = c000 + sy + scr;
+    }
+  } else {
+    if (fy >= fcr) {
+      a = fcb; b = fy; c = fcr; v1 = c000 + scb; v2 = c000 + sy + scb;
+    } else if (fcb >= fcr) {
+      a = fcb; b = fcr; c = fy; v1 = c000 + scb; v2 = c000 + scb + scr;
+    } else {
+      a = fcr; b = fcb; c = fy; v1 = c000 + scr; v2 = c000 + scb + scr;
+    }
+  }
+
+  // Weights sum to 1 << 16, values stay below 1 << 16: fits 32 bits
+  const uint32_t w0 = 0x10000 - a, w1 = a - b, w2 = b - c, w3 = c;
+  for (int i = 0; i < 3; i++) {
+    out[i] = (w0 * c000[i] + w1 * v1[i] + w2 * v2[i] + w3 * c111[i] + 0x8000) >> 16;
+  }
+}
+
+// Each chroma sample is shared by a block of luma samples: every luma sample
+// is looked up with it, the block's output chroma is the average
+template <typename In, typename Out>
+void TransformPlanes(const Lattice& lat, const AVFrame* src, AVFrame* dst, const PlaneLayout& layout, uint32_t dst_max) {
+  const int width = src->width;
+  const int height = src->height;
+  const int chroma_w = AV_CEIL_RSHIFT(width, layout.log2_w);
+  const int chroma_h = AV_CEIL_RSHIFT(height, layout.log2_h);
+  const int block_w = 1 << layout.log2_w;
+  const int block_h = 1 << layout.log2_h;
+  const uint32_t max_fixed = dst_max << 4;
+
+  for (int cy = 0; cy < chroma_h; cy++) {
+    const In* src_cb = reinterpret_cast<const In*>(src->data[1] + static_cast<ptrdiff_t>(cy) * src->linesize[1]);
+    const In* src_cr = reinterpret_cast<const In*>(src->data[2] + static_cast<ptrdiff_t>(cy) * src->linesize[2]);
+    Out* dst_cb = reinterpret_cast<Out*>(dst->data[1] + static_cast<ptrdiff_t>(cy) * dst->linesize[1]);
+    Out* dst_cr = reinterpret_cast<Out*>(dst->data[2] + static_cast<ptrdiff_t>(cy) * dst->linesize[2]);
+    const int rows = std::min(block_h, height - (cy << layout.log2_h));
+
+    for (int cx = 0; cx < chroma_w; cx++) {
+      const uint32_t cb = src_cb[cx];
+      const uint32_t cr = src_cr[cx];
+      const int x0 = cx << layout.log2_w;
+      const int cols = std::min(block_w, width - x0);
+      uint32_t sum_cb = 0, sum_cr = 0;
+
+      for (int dy = 0; dy < rows; dy++) {
+        const int y = (cy << layout.log2_h) + dy;
+        const In* src_y = reinterpret_cast<const In*>(src->data[0] + static_cast<ptrdiff_t>(y) * src->linesize[0]) + x0;
+        Out* dst_y = reinterpret_cast<Out*>(dst->data[0] + static_cast<ptrdiff_t>(y) * dst->linesize[0]) + x0;
+        for (int dx = 0; dx < cols; dx++) {
+          uint32_t out[3];
+          Lookup(lat, src_y[dx], cb, cr, out);
+          dst_y[dx] = static_cast<Out>((std::min(out[0], max_fixed) + 8) >> 4);
+          sum_cb += out[1];
+          sum_cr += out[2];
+        }
+      }
+
+      const uint32_t count = static_cast<uint32_t>(rows * cols);
+      dst_cb[cx] = static_cast<Out>(std::min((sum_cb + count * 8) / (count * 16), dst_max));
+      dst_cr[cx] = static_cast<Out>(std::min((sum_cr + count * 8) / (count * 16), dst_max));
+    }
+  }
+}
+
+ToneMapping ParseToneMapping(const std::string& name, bool* ok) {
+  *ok = true;
+  if (name == "hable") return ToneMapping::kHable;
+  if (name == "reinhard") return ToneMapping::kReinhard;
+  if (name == "none") return ToneMapping::kNone;
+  *ok = false;
+  return ToneMapping::kNone;
+}
+
+} // namespace
+
+Napi::FunctionReference ColorTransform::constructor;
+
+Napi::Object ColorTransform::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "ColorTransform", {
+    InstanceMethod<&ColorTransform::Alloc>("alloc"),
+    InstanceMethod<&ColorTransform::Free>("free"),
+    InstanceMethod<&ColorTransform::ApplyAsync>("apply"),
+    InstanceMethod<&ColorTransform::ApplySync>("applySync"),
+    InstanceMethod<&ColorTransform::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &ColorTransform::Dispose),
+    StaticMethod<&ColorTransform::ClearCache>("clearCache"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ColorTransform", func);
+  return exports;
+}
+
+ColorTransform::ColorTransform(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ColorTransform>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+ColorTransform::~ColorTransform() {
+  // Manual cleanup if not already done
+  FreeInternal();
+}
+
+// === LUT cache ===
+
+std::shared_ptr<const ColorLut> ColorTransform::AcquireLut(const ColorLutKey& key, double* build_time) {
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    auto it = lut_cache.find(key);
+    if (it != lut_cache.end()) {
+      *build_time = -1;
+      return it->second;
+    }
+  }
+
+  // Build outside the lock, other combinations stay available meanwhile
+  auto start = std::chrono::steady_clock::now();
+  std::shared_ptr<const ColorLut> lut = BuildLut(key);
+  *build_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  if (lut_cache.size() >= kMaxCachedLuts) {
+    for (auto it = lut_cache.begin(); it != lut_cache.end();) {
+      it = it->second.use_count() == 1 ? lut_cache.erase(it) : std::next(it);
+    }
+  }
+  // A concurrent build of the same key wins, both results are identical
+  return lut_cache.emplace(key, lut).first->second;
+}
+
+// === Transform ===
+
+int ColorTransform::PrepareDestination(const AVFrame* src, AVFrame* dst, AVPixelFormat format) {
+  PlaneLayout layout;
+  DescribeFormat(format, &layout);
+  const int bytes = layout.depth > 8 ? 2 : 1;
+
+  av_frame_unref(dst);
+  dst->format = format;
+  dst->width = src->width;
+  dst->height = src->height;
+
+  for (int i = 0; i < 3; i++) {
+    int w = i ? AV_CEIL_RSHIFT(src->width, layout.log2_w) : src->width;
+    int h = i ? AV_CEIL_RSHIFT(src->height, layout.log2_h) : src->height;
+    int linesize = FFALIGN(w * bytes, 64);
+    int size = linesize * h + AV_INPUT_BUFFER_PADDING_SIZE;
+
+    if (!pools_[i] || pool_sizes_[i] != size) {
+      // Buffers still referenced by earlier frames stay valid
+      av_buffer_pool_uninit(&pools_[i]);
+      pools_[i] = av_buffer_pool_init(size, nullptr);
+      pool_sizes_[i] = pools_[i] ? size : 0;
+    }
+    dst->buf[i] = pools_[i] ? av_buffer_pool_get(pools_[i]) : nullptr;
+    if (!dst->buf[i]) {
+      av_frame_unref(dst);
+      return AVERROR(ENOMEM);
+    }
+    dst->data[i] = dst->buf[i]->data;
+    dst->linesize[i] = linesize;
+  }
+
+  // Timestamps, side data and metadata
+  int ret = av_frame_copy_props(dst, src);
+  if (ret < 0) {
+    av_frame_unref(dst);
+  }
+  return ret;
+}
+
+int ColorTransform::ApplyLocked(AVFrame* src, AVFrame* dst) {
+  if (!configured_ || !src || !src->data[0] || src->hw_frames_ctx || src->width <= 0 || src->height <= 0) {
+    return AVERROR(EINVAL);
+  }
+
+  PlaneLayout in, out;
+  AVPixelFormat out_format = dst_format_ != AV_PIX_FMT_NONE ? dst_format_ : static_cast<AVPixelFormat>(src->format);
+  if (!DescribeFormat(src->format, &in) || !DescribeFormat(out_format, &out) ||
+      in.log2_w != out.log2_w || in.log2_h != out.log2_h) {
+    return AVERROR(EINVAL);
+  }
+
+  bool in_place = !dst || dst == src;
+  if (in_place && out_format != src->format) {
+    return AVERROR(EINVAL);
+  }
+
+  // Source description from the options, else from the frame (BT.709 limited when unspecified)
+  ColorLutKey key = options_;
+  key.src_primaries = src_primaries_ >= 0 ? src_primaries_
+                      : src->color_primaries != AVCOL_PRI_UNSPECIFIED ? src->color_primaries : AVCOL_PRI_BT709;
+  key.src_trc = src_trc_ >= 0 ? src_trc_ : src->color_trc != AVCOL_TRC_UNSPECIFIED ? src->color_trc : AVCOL_TRC_BT709;
+  key.src_space = src_space_ >= 0 ? src_space_ : src->colorspace != AVCOL_SPC_UNSPECIFIED ? src->colorspace : AVCOL_SPC_BT709;
+  key.src_range = src_range_ >= 0 ? src_range_ : src->color_range == AVCOL_RANGE_JPEG ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG;
+  key.src_depth = in.depth;
+  key.dst_depth = out.depth;
+  if (!IsSupported(key)) {
+    return AVERROR(ENOSYS);
+  }
+
+  if (!lut_ || !(key == lut_key_)) {
+    double build_time = -1;
+    lut_ = AcquireLut(key, &build_time);
+    lut_key_ = key;
+    if (build_time >= 0) {
+      stats_.lut_builds++;
+      stats_.last_build_time = build_time;
+    } else {
+      stats_.cache_hits++;
+    }
+  }
+
+  AVFrame* target = src;
+  int ret;
+  if (in_place) {
+    // Never write into buffers shared with other frames
+    ret = av_frame_make_writable(src);
+  } else {
+    ret = PrepareDestination(src, dst, out_format);
+    target = dst;
+  }
+  if (ret < 0) {
+    return ret;
+  }
+
+  Lattice lat;
+  lat.data = lut_->data.data();
+  lat.size = static_cast<uint32_t>(lut_->size);
+  lat.max_code = (1u << in.depth) - 1;
+  lat.scale = static_cast<uint32_t>(std::lrint((lut_->size - 1) * 65536.0 / lat.max_code));
+  lat.stride_cb = static_cast<size_t>(lut_->size) * 3;
+  lat.stride_y = lat.stride_cb * lut_->size;
+  const uint32_t dst_max = (1u << out.depth) - 1;
+
+  if (in.depth > 8 && out.depth > 8) {
+    TransformPlanes<uint16_t, uint16_t>(lat, src, target, in, dst_max);
+  } else if (in.depth > 8) {
+    TransformPlanes<uint16_t, uint8_t>(lat, src, target, in, dst_max);
+  } else if (out.depth > 8) {
+    TransformPlanes<uint8_t, uint16_t>(lat, src, target, in, dst_max);
+  } else {
+    TransformPlanes<uint8_t, uint8_t>(lat, src, target, in, dst_max);
+  }
+
+  target->color_primaries = static_cast<AVColorPrimaries>(key.dst_primaries);
+  target->color_trc = static_cast<AVColorTransferCharacteristic>(key.dst_trc);
+  target->colorspace = static_cast<AVColorSpace>(key.dst_space);
+  target->color_range = static_cast<AVColorRange>(key.dst_range);
+  if (!IsHdrTrc(key.dst_trc)) {
+    av_frame_remove_side_data(target, AV_FRAME_DATA_MASTERING_DISPLAY_METADATA);
+    av_frame_remove_side_data(target, AV_FRAME_DATA_CONTENT_LIGHT_LEVEL);
+  }
+
+  stats_.frames++;
+  return 0;
+}
+
+void ColorTransform::FreeInternal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lut_.reset();
+  for (int i = 0; i < 3; i++) {
+    av_buffer_pool_uninit(&pools_[i]);
+    pool_sizes_[i] = 0;
+  }
+  configured_ = false;
+}
+
+// === JS methods ===
+
+Napi::Value ColorTransform::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  ColorLutKey options;
+  int src_primaries = -1, src_trc = -1, src_space = -1, src_range = -1;
+  int dst_format = AV_PIX_FMT_NONE;
+  bool tonemap_ok = true;
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object opts = info[0].As<Napi::Object>();
+    auto number = [&](const char* name, int* value) {
+      if (opts.Has(name) && opts.Get(name).IsNumber()) {
+        *value = opts.Get(name).As<Napi::Number>().Int32Value();
+      }
+    };
+    auto real = [&](const char* name, double* value) {
+      if (opts.Has(name) && opts.Get(name).IsNumber()) {
+        *value = opts.Get(name).As<Napi::Number>().DoubleValue();
+      }
+    };
+
+    number("srcPrimaries", &src_primaries);
+    number("srcTrc", &src_trc);
+    number("srcSpace", &src_space);
+    number("srcRange", &src_range);
+    number("dstPrimaries", &options.dst_primaries);
+    number("dstTrc", &options.dst_trc);
+    number("dstSpace", &options.dst_space);
+    number("dstRange", &options.dst_range);
+    number("dstFormat", &dst_format);
+    number("lutSize", &options.size);
+    real("peak", &options.peak);
+    real("param", &options.param);
+    real("sdrWhite", &options.sdr_white);
+    if (opts.Has("tonemap") && opts.Get("tonemap").IsString()) {
+      options.tonemap = ParseToneMapping(opts.Get("tonemap").As<Napi::String>().Utf8Value(), &tonemap_ok);
+    }
+  }
+
+  // Validate with the source side filled in where it is given
+  ColorLutKey check = options;
+  if (src_primaries >= 0) check.src_primaries = src_primaries;
+  if (src_trc >= 0) check.src_trc = src_trc;
+  if (src_space >= 0) check.src_space = src_space;
+  if (src_range >= 0) check.src_range = src_range;
+
+  PlaneLayout layout;
+  if (!tonemap_ok || !IsSupported(check) || options.size < 2 || options.size > 65 || options.peak <= 0 ||
+      options.param <= 0 || options.sdr_white <= 0 || (dst_format != AV_PIX_FMT_NONE && !DescribeFormat(dst_format, &layout))) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  FreeInternal();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  options_ = options;
+  src_primaries_ = src_primaries;
+  src_trc_ = src_trc;
+  src_space_ = src_space;
+  src_range_ = src_range;
+  dst_format_ = static_cast<AVPixelFormat>(dst_format);
+  stats_ = ColorTransformStats();
+  configured_ = true;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value ColorTransform::Free(const Napi::CallbackInfo& info) {
+  FreeInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value ColorTransform::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  size_t cached;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cached = lut_cache.size();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.Set("frames", Napi::Number::New(env, static_cast<double>(stats_.frames)));
+  stats.Set("lutBuilds", Napi::Number::New(env, static_cast<double>(stats_.lut_builds)));
+  stats.Set("cacheHits", Napi::Number::New(env, static_cast<double>(stats_.cache_hits)));
+  stats.Set("lastBuildTime", Napi::Number::New(env, stats_.last_build_time));
+  stats.Set("cachedLuts", Napi::Number::New(env, static_cast<double>(cached)));
+  return stats;
+}
+
+Napi::Value ColorTransform::ClearCache(const Napi::CallbackInfo& info) {
+  // LUTs in use stay alive with their transforms
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  lut_cache.clear();
+  return info.Env().Undefined();
+}
+
+Napi::Value ColorTransform::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,124 @@
+#ifndef FFMPEG_COLOR_TRANSFORM_H
+#define FFMPEG_COLOR_TRANSFORM_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+namespace ffmpeg {
+
+enum class ToneMapping {
+  kNone,                          // Clip to the destination range
+  kHable,                         // Filmic curve (tonemap=hable)
+  kReinhard,                      // tonemap=reinhard with `param` as contrast
+};
+
+// Source and destination color description, identifies a cached LUT
+struct ColorLutKey {
+  int src_primaries = AVCOL_PRI_BT709;
+  int src_trc = AVCOL_TRC_BT709;
+  int src_space = AVCOL_SPC_BT709;
+  int src_range = AVCOL_RANGE_MPEG;
+  int src_depth = 8;
+  int dst_primaries = AVCOL_PRI_BT709;
+  int dst_trc = AVCOL_TRC_BT709;
+  int dst_space = AVCOL_SPC_BT709;
+  int dst_range = AVCOL_RANGE_MPEG;
+  int dst_depth = 8;
+  int size = 33;
+  ToneMapping tonemap = ToneMapping::kHable;
+  double peak = 1000;             // Source peak luminance (nits)
+  double param = 0.5;             // Tone mapping parameter
+  double sdr_white = 100;         // Reference white (nits)
+
+  auto Tie() const {
+    return std::tie(src_primaries, src_trc, src_space, src_range, src_depth, dst_primaries, dst_trc, dst_space,
+                    dst_range, dst_depth, size, tonemap, peak, param, sdr_white);
+  }
+  bool operator<(const ColorLutKey& other) const { return Tie() < other.Tie(); }
+  bool operator==(const ColorLutKey& other) const { return Tie() == other.Tie(); }
+};
+
+// Immutable lattice of size^3 (Y, Cb, Cr) destination code values with 4
+// fractional bits, indexed [y][cb][cr] over the full source code range
+struct ColorLut {
+  int size = 0;
+  std::vector<uint16_t> data;
+};
+
+struct ColorTransformStats {
+  uint64_t frames = 0;            // Transformed frames
+  uint64_t lut_builds = 0;        // LUTs built by this instance
+  uint64_t cache_hits = 0;        // LUTs taken from the process-wide cache
+  double last_build_time = 0;     // Milliseconds to build the last LUT
+};
+
+/**
+ * Colorspace conversion and HDR to SDR tone mapping through a cached 3D LUT.
+ *
+ * The per-pixel math of a colorspace/tonemap filter chain (range and matrix
+ * decode, EOTF, tone curve, gamut matrix, OETF, matrix and range encode) is
+ * identical for every frame, so it is evaluated once per (source, destination)
+ * combination on a lattice and cached process-wide. Frames are then converted
+ * with tetrahedral interpolation directly on planar 8 to 12-bit YUV planes,
+ * in place or into a destination frame backed by buffer pools.
+ */
+class ColorTransform : public Napi::ObjectWrap<ColorTransform> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  ColorTransform(const Napi::CallbackInfo& info);
+  ~ColorTransform();
+
+private:
+  friend class CTApplyWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Options (-1: taken from each source frame)
+  bool configured_ = false;
+  int src_primaries_ = -1;
+  int src_trc_ = -1;
+  int src_space_ = -1;
+  int src_range_ = -1;
+  AVPixelFormat dst_format_ = AV_PIX_FMT_NONE;
+  ColorLutKey options_;
+
+  // State (guarded by mutex_)
+  std::shared_ptr<const ColorLut> lut_;
+  ColorLutKey lut_key_;
+  AVBufferPool* pools_[3] = { nullptr, nullptr, nullptr };
+  int pool_sizes_[3] = { 0, 0, 0 };
+  ColorTransformStats stats_;
+  std::mutex mutex_;
+
+  // Cached LUT for the key, built on a miss (build_time in ms, -1 on a hit)
+  static std::shared_ptr<const ColorLut> AcquireLut(const ColorLutKey& key, double* build_time);
+
+  int ApplyLocked(AVFrame* src, AVFrame* dst);
+  int PrepareDestination(const AVFrame* src, AVFrame* dst, AVPixelFormat format);
+  void FreeInternal();
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value ApplyAsync(const Napi::CallbackInfo& info);
+  Napi::Value ApplySync(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+  static Napi::Value ClearCache(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_COLOR_TRANSFORM_H
@@ -0,0 +1,74 @@
+#include "color_transform.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class CTApplyWorker : public Napi::AsyncWorker {
+public:
+  CTApplyWorker(Napi::Env env, ColorTransform* transform, Frame* src, Frame* dst)
+    : Napi::AsyncWorker(env),
+      transform_(transform),
+      src_(src),
+      dst_(dst),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    std::lock_guard<std::mutex> lock(transform_->mutex_);
+    ret_ = transform_->ApplyLocked(src_->Get(), dst_ ? dst_->Get() : nullptr);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ColorTransform* transform_;
+  Frame* src_;
+  Frame* dst_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value ColorTransform::ApplyAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* src = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  Frame* dst = nullptr;
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    dst = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+    if (!dst || !dst->Get()) {
+      Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+  if (!src || !src->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new CTApplyWorker(env, this, src, dst);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,28 @@
+#include "color_transform.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value ColorTransform::ApplySync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* src = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  Frame* dst = nullptr;
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    dst = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+    if (!dst || !dst->Get()) {
+      Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+  if (!src || !src->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(env, ApplyLocked(src->Get(), dst ? dst->Get() : nullptr));
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,514 @@
+#include "concat_input.h"
+#include "codec_parameters.h"
+
+#include <cstring>
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/log.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference ConcatInput::constructor;
+
+// av_err2str() relies on a C compound literal
+static std::string ErrorString(int errnum) {
+  char buf[AV_ERROR_MAX_STRING_SIZE] = { 0 };
+  av_strerror(errnum, buf, sizeof(buf));
+  return buf;
+}
+
+Napi::Object ConcatInput::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "ConcatInput", {
+    // Lifecycle
+    InstanceMethod<&ConcatInput::OpenAsync>("open"),
+    InstanceMethod<&ConcatInput::OpenSync>("openSync"),
+    InstanceMethod<&ConcatInput::Append>("append"),
+    InstanceMethod<&ConcatInput::End>("end"),
+    InstanceMethod<&ConcatInput::Close>("close"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &ConcatInput::Dispose),
+
+    // Reading
+    InstanceMethod<&ConcatInput::ReadFrameAsync>("readFrame"),
+    InstanceMethod<&ConcatInput::ReadFrameSync>("readFrameSync"),
+
+    // Streams
+    InstanceMethod<&ConcatInput::GetCodecParameters>("getCodecParameters"),
+    InstanceMethod<&ConcatInput::GetStreamTimeBase>("getStreamTimeBase"),
+
+    // Properties
+    InstanceAccessor<&ConcatInput::GetNbStreams>("nbStreams"),
+    InstanceAccessor<&ConcatInput::GetBoundary>("boundary"),
+    InstanceAccessor<&ConcatInput::GetItemIndex>("itemIndex"),
+    InstanceAccessor<&ConcatInput::GetCurrentUrl>("currentUrl"),
+    InstanceAccessor<&ConcatInput::GetItemsSkipped>("itemsSkipped"),
+    InstanceAccessor<&ConcatInput::GetPendingItems>("pendingItems"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ConcatInput", func);
+  return exports;
+}
+
+ConcatInput::ConcatInput(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ConcatInput>(info) {
+  // Constructor does nothing - user must explicitly call open()
+}
+
+ConcatInput::~ConcatInput() {
+  CloseInternal();
+
+  // Prefetchers keep the input alive, they can only still run at environment
+  // teardown, where closing has just interrupted them
+  for (auto& entry : prefetch_threads_) {
+    if (entry.second.joinable()) {
+      entry.second.join();
+    }
+  }
+}
+
+// === Internal ===
+
+void ConcatInput::FreeItem(Item* item) {
+  if (!item) {
+    return;
+  }
+  if (item->fmt) {
+    avformat_close_input(&item->fmt);
+  }
+  delete item;
+}
+
+void ConcatInput::PrefetchLoop(uint64_t run, Napi::ThreadSafeFunction exit_tsfn) {
+  while (true) {
+    Item* item = new Item();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      prefetch_cv_.wait(lock, [&] {
+        return run != prefetch_run_ || (!pending_.empty() && static_cast<int>(ready_.size()) < lookahead_);
+      });
+      if (run != prefetch_run_) {
+        delete item;
+        break;
+      }
+      item->url = pending_.front();
+      item->index = next_index_++;
+      item->owner = this;
+      item->run = run;
+      pending_.pop_front();
+      opening_ = true;
+    }
+
+    // Open and probe while the current item is being read
+    item->fmt = avformat_alloc_context();
+    if (item->fmt) {
+      // Protocols copy the callback when they are opened, so it has to be set before opening
+      item->fmt->interrupt_callback.callback = &ConcatInput::CheckInterrupt;
+      item->fmt->interrupt_callback.opaque = item;
+      item->ret = avformat_open_input(&item->fmt, item->url.c_str(), nullptr, nullptr);
+    } else {
+      item->ret = AVERROR(ENOMEM);
+    }
+    if (item->ret >= 0) {
+      item->ret = avformat_find_stream_info(item->fmt, nullptr);
+    }
+    if (item->ret < 0 && item->fmt) {
+      avformat_close_input(&item->fmt);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      // Closed meanwhile, the playlist state already belongs to the next run
+      if (run != prefetch_run_) {
+        FreeItem(item);
+        break;
+      }
+      opening_ = false;
+      ready_.push_back(item);
+    }
+    ready_cv_.notify_all();
+  }
+
+  // Join and drop the start reference on the JS thread
+  exit_tsfn.NonBlockingCall([this, run](Napi::Env, Napi::Function) { OnPrefetcherExit(run); });
+  exit_tsfn.Release();
+}
+
+int ConcatInput::CheckInterrupt(void* opaque) {
+  const Item* item = static_cast<const Item*>(opaque);
+  return item->run != item->owner->prefetch_run_.load() ? 1 : 0;
+}
+
+void ConcatInput::StartPrefetcher(Napi::Env env) {
+  Napi::ThreadSafeFunction exit_tsfn = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "ConcatInputPrefetchExit",
+    0,
+    1
+  );
+  exit_tsfn.Unref(env);
+
+  // Keep the input alive until the thread has exited
+  Ref();
+  uint64_t run = prefetch_run_.load();
+  prefetch_threads_[run] = std::thread(&ConcatInput::PrefetchLoop, this, run, exit_tsfn);
+}
+
+void ConcatInput::OnPrefetcherExit(uint64_t run) {
+  // The thread has left its loop, joining does not wait on any I/O
+  auto it = prefetch_threads_.find(run);
+  if (it != prefetch_threads_.end()) {
+    if (it->second.joinable()) {
+      it->second.join();
+    }
+    prefetch_threads_.erase(it);
+  }
+  Unref();
+}
+
+ConcatInput::Item* ConcatInput::NextItem() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  ready_cv_.wait(lock, [&] {
+    return stopping_ || !ready_.empty() || (ended_ && pending_.empty() && !opening_);
+  });
+
+  if (stopping_ || ready_.empty()) {
+    return nullptr;
+  }
+
+  Item* item = ready_.front();
+  ready_.pop_front();
+
+  // Let the prefetcher open the next one
+  prefetch_cv_.notify_all();
+  return item;
+}
+
+bool ConcatInput::IsCompatible(const AVFormatContext* fmt) const {
+  if (fmt->nb_streams != ref_params_.size()) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < fmt->nb_streams; i++) {
+    const AVCodecParameters* a = ref_params_[i];
+    const AVCodecParameters* b = fmt->streams[i]->codecpar;
+
+    if (a->codec_type != b->codec_type || a->codec_id != b->codec_id) {
+      return false;
+    }
+
+    if (a->codec_type == AVMEDIA_TYPE_VIDEO &&
+        (a->width != b->width || a->height != b->height || a->format != b->format)) {
+      return false;
+    }
+
+    if (a->codec_type == AVMEDIA_TYPE_AUDIO &&
+        (a->sample_rate != b->sample_rate || a->format != b->format ||
+         a->ch_layout.nb_channels != b->ch_layout.nb_channels)) {
+      return false;
+    }
+
+    // Stream copy requires identical decoder configuration
+    if (a->extradata_size != b->extradata_size ||
+        (a->extradata_size > 0 && memcmp(a->extradata, b->extradata, a->extradata_size) != 0)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int ConcatInput::StartInternal() {
+  std::lock_guard<std::mutex> lock(read_mutex_);
+
+  Item* item = nullptr;
+  while ((item = NextItem()) != nullptr) {
+    if (item->ret >= 0) {
+      break;
+    }
+    av_log(nullptr, AV_LOG_WARNING, "Skipping playlist item '%s': %s\n", item->url.c_str(), ErrorString(item->ret).c_str());
+    last_item_error_ = item->ret;
+    items_skipped_++;
+    FreeItem(item);
+  }
+
+  if (!item) {
+    return last_item_error_ < 0 ? last_item_error_ : AVERROR_EOF;
+  }
+
+  // The first item defines the output streams
+  for (unsigned int i = 0; i < item->fmt->nb_streams; i++) {
+    AVCodecParameters* par = avcodec_parameters_alloc();
+    if (!par) {
+      FreeItem(item);
+      return AVERROR(ENOMEM);
+    }
+    avcodec_parameters_copy(par, item->fmt->streams[i]->codecpar);
+    ref_params_.push_back(par);
+    out_time_base_.push_back(item->fmt->streams[i]->time_base);
+  }
+
+  current_ = item;
+  current_url_ = item->url;
+  item_index_ = item->index;
+  offset_us_ = 0;
+  item_end_us_ = 0;
+  boundary_pending_ = true;
+
+  return 0;
+}
+
+int ConcatInput::ReadInternal(AVPacket* packet) {
+  std::lock_guard<std::mutex> lock(read_mutex_);
+
+  if (ref_params_.empty()) {
+    return AVERROR(EINVAL);
+  }
+
+  while (true) {
+    if (!current_) {
+      Item* item = NextItem();
+      if (!item) {
+        return AVERROR_EOF;
+      }
+
+      if (item->ret < 0 || !IsCompatible(item->fmt)) {
+        av_log(nullptr, AV_LOG_WARNING, "Skipping playlist item '%s': %s\n", item->url.c_str(),
+               item->ret < 0 ? ErrorString(item->ret).c_str() : "incompatible stream layout");
+        last_item_error_ = item->ret < 0 ? item->ret : AVERROR_INVALIDDATA;
+        items_skipped_++;
+        FreeItem(item);
+        continue;
+      }
+
+      // Continue where the previous item ended
+      current_ = item;
+      current_url_ = item->url;
+      item_index_ = item->index;
+      offset_us_ = item_end_us_;
+      boundary_pending_ = true;
+    }
+
+    int ret = av_read_frame(current_->fmt, packet);
+    if (ret < 0) {
+      if (ret != AVERROR_EOF) {
+        av_log(nullptr, AV_LOG_WARNING, "Playlist item '%s' ended with error: %s\n", current_url_.c_str(), ErrorString(ret).c_str());
+        last_item_error_ = ret;
+      }
+      FreeItem(current_);
+      current_ = nullptr;
+      continue;
+    }
+
+    if (packet->stream_index < 0 || packet->stream_index >= static_cast<int>(out_time_base_.size())) {
+      av_packet_unref(packet);
+      continue;
+    }
+
+    // Stitch timestamps onto the continuous output timeline
+    AVStream* st = current_->fmt->streams[packet->stream_index];
+    AVRational tb = out_time_base_[packet->stream_index];
+    int64_t start = current_->fmt->start_time != AV_NOPTS_VALUE ? current_->fmt->start_time : 0;
+    int64_t shift = av_rescale_q(offset_us_ - start, AV_TIME_BASE_Q, tb);
+
+    if (packet->pts != AV_NOPTS_VALUE) {
+      packet->pts = av_rescale_q(packet->pts, st->time_base, tb) + shift;
+    }
+    if (packet->dts != AV_NOPTS_VALUE) {
+      packet->dts = av_rescale_q(packet->dts, st->time_base, tb) + shift;
+    }
+    packet->duration = av_rescale_q(packet->duration, st->time_base, tb);
+    packet->time_base = tb;
+
+    int64_t last = packet->pts;
+    if (last == AV_NOPTS_VALUE || (packet->dts != AV_NOPTS_VALUE && packet->dts > last)) {
+      last = packet->dts;
+    }
+    if (last != AV_NOPTS_VALUE) {
+      int64_t end_us = av_rescale_q(last + packet->duration, tb, AV_TIME_BASE_Q);
+      if (end_us > item_end_us_) {
+        item_end_us_ = end_us;
+      }
+    }
+
+    boundary_ = boundary_pending_;
+    boundary_pending_ = false;
+    return 0;
+  }
+}
+
+void ConcatInput::CloseInternal() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    // Stops the prefetcher and aborts the I/O of its items; it is joined once it has exited
+    prefetch_run_++;
+  }
+  prefetch_cv_.notify_all();
+  ready_cv_.notify_all();
+
+  std::lock_guard<std::mutex> read_lock(read_mutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  FreeItem(current_);
+  current_ = nullptr;
+  for (Item* item : ready_) {
+    FreeItem(item);
+  }
+  ready_.clear();
+  pending_.clear();
+
+  for (AVCodecParameters*& par : ref_params_) {
+    avcodec_parameters_free(&par);
+  }
+  ref_params_.clear();
+  out_time_base_.clear();
+
+  next_index_ = 0;
+  item_index_ = -1;
+  current_url_.clear();
+  boundary_ = false;
+  boundary_pending_ = false;
+  opening_ = false;
+  ended_ = false;
+  stopping_ = false;
+}
+
+// === Lifecycle ===
+
+bool ConcatInput::PrepareOpen(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Expected array of URLs").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  CloseInternal();
+
+  Napi::Array urls = info[0].As<Napi::Array>();
+  int lookahead = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 1;
+  bool endless = info.Length() > 2 && info[2].IsBoolean() && info[2].As<Napi::Boolean>().Value();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint32_t i = 0; i < urls.Length(); i++) {
+      pending_.push_back(urls.Get(i).As<Napi::String>().Utf8Value());
+    }
+    lookahead_ = lookahead > 0 ? lookahead : 1;
+    ended_ = !endless;
+    items_skipped_ = 0;
+    last_item_error_ = 0;
+  }
+
+  StartPrefetcher(env);
+  return true;
+}
+
+Napi::Value ConcatInput::Append(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected URL").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(info[0].As<Napi::String>().Utf8Value());
+  }
+  prefetch_cv_.notify_all();
+
+  return env.Undefined();
+}
+
+Napi::Value ConcatInput::End(const Napi::CallbackInfo& info) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ended_ = true;
+  }
+  ready_cv_.notify_all();
+  return info.Env().Undefined();
+}
+
+Napi::Value ConcatInput::Close(const Napi::CallbackInfo& info) {
+  CloseInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value ConcatInput::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+// === Streams ===
+
+Napi::Value ConcatInput::GetCodecParameters(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected 2 arguments (streamIndex, codecpar)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[1], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid CodecParameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int index = info[0].As<Napi::Number>().Int32Value();
+  if (index < 0 || index >= static_cast<int>(ref_params_.size())) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  return Napi::Number::New(env, avcodec_parameters_copy(par->Get(), ref_params_[index]));
+}
+
+Napi::Value ConcatInput::GetStreamTimeBase(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int index = info.Length() > 0 && info[0].IsNumber() ? info[0].As<Napi::Number>().Int32Value() : -1;
+  if (index < 0 || index >= static_cast<int>(out_time_base_.size())) {
+    return env.Null();
+  }
+
+  return RationalToJS(env, out_time_base_[index]);
+}
+
+// === Properties ===
+
+Napi::Value ConcatInput::GetNbStreams(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), static_cast<double>(ref_params_.size()));
+}
+
+Napi::Value ConcatInput::GetBoundary(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), boundary_);
+}
+
+Napi::Value ConcatInput::GetItemIndex(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), item_index_);
+}
+
+Napi::Value ConcatInput::GetCurrentUrl(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (item_index_ < 0) {
+    return env.Null();
+  }
+  return Napi::String::New(env, current_url_);
+}
+
+Napi::Value ConcatInput::GetItemsSkipped(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), items_skipped_);
+}
+
+Napi::Value ConcatInput::GetPendingItems(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(pending_.size() + ready_.size()));
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,123 @@
+#ifndef FFMPEG_CONCAT_INPUT_H
+#define FFMPEG_CONCAT_INPUT_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Gapless playlist input.
+ *
+ * Reads a list of inputs back to back as one continuous packet stream.
+ * Upcoming items are opened and probed on a background thread while the
+ * current one is read, timestamps are shifted so pts/dts continue across
+ * items, and items whose streams are not stream-copy compatible with the
+ * first item are skipped.
+ *
+ * Closing never waits for the prefetcher, it may be blocked in network I/O:
+ * the I/O of its items is interrupted and the thread is joined on the JS
+ * thread once it has exited. The input keeps itself alive until then.
+ */
+class ConcatInput : public Napi::ObjectWrap<ConcatInput> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  ConcatInput(const Napi::CallbackInfo& info);
+  ~ConcatInput();
+
+private:
+  friend class CIOpenWorker;
+  friend class CIReadFrameWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct Item {
+    std::string url;
+    int index = 0;
+    AVFormatContext* fmt = nullptr;
+    int ret = 0;
+    // Interrupt callback state: the prefetcher run that opened the item
+    ConcatInput* owner = nullptr;
+    uint64_t run = 0;
+  };
+
+  // Playlist (guarded by mutex_)
+  std::deque<std::string> pending_;
+  std::deque<Item*> ready_;
+  std::mutex mutex_;
+  std::condition_variable prefetch_cv_;
+  std::condition_variable ready_cv_;
+  // Current prefetcher run, bumped on close. Stops older runs and interrupts
+  // the I/O of their items (written under mutex_, read by CheckInterrupt)
+  std::atomic<uint64_t> prefetch_run_{0};
+  // JS thread only: started and not yet joined, by run
+  std::map<uint64_t, std::thread> prefetch_threads_;
+  int lookahead_ = 1;
+  int next_index_ = 0;
+  bool opening_ = false;
+  bool ended_ = false;
+  bool stopping_ = false;
+
+  // Reader state (owned by the reading thread)
+  Item* current_ = nullptr;
+  std::vector<AVCodecParameters*> ref_params_;
+  std::vector<AVRational> out_time_base_;
+  int64_t offset_us_ = 0;
+  int64_t item_end_us_ = 0;
+  bool boundary_ = false;
+  bool boundary_pending_ = false;
+  int item_index_ = -1;
+  std::string current_url_;
+  int items_skipped_ = 0;
+  int last_item_error_ = 0;
+  std::mutex read_mutex_;
+
+  void PrefetchLoop(uint64_t run, Napi::ThreadSafeFunction exit_tsfn);
+  void StartPrefetcher(Napi::Env env);
+  void OnPrefetcherExit(uint64_t run);
+  static int CheckInterrupt(void* opaque);
+  Item* NextItem();
+  bool IsCompatible(const AVFormatContext* fmt) const;
+  int StartInternal();
+  int ReadInternal(AVPacket* packet);
+  void CloseInternal();
+  static void FreeItem(Item* item);
+
+  bool PrepareOpen(const Napi::CallbackInfo& info);
+  Napi::Value OpenAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenSync(const Napi::CallbackInfo& info);
+  Napi::Value Append(const Napi::CallbackInfo& info);
+  Napi::Value End(const Napi::CallbackInfo& info);
+  Napi::Value ReadFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReadFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value GetCodecParameters(const Napi::CallbackInfo& info);
+  Napi::Value GetStreamTimeBase(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetNbStreams(const Napi::CallbackInfo& info);
+  Napi::Value GetBoundary(const Napi::CallbackInfo& info);
+  Napi::Value GetItemIndex(const Napi::CallbackInfo& info);
+  Napi::Value GetCurrentUrl(const Napi::CallbackInfo& info);
+  Napi::Value GetItemsSkipped(const Napi::CallbackInfo& info);
+  Napi::Value GetPendingItems(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_CONCAT_INPUT_H
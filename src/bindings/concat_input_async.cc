@@ -0,0 +1,108 @@
+#include "concat_input.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class CIOpenWorker : public Napi::AsyncWorker {
+public:
+  CIOpenWorker(Napi::Env env, ConcatInput* input)
+    : Napi::AsyncWorker(env),
+      input_(input),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    // Waits for the prefetcher to open the first usable item
+    ret_ = input_->StartInternal();
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ConcatInput* input_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class CIReadFrameWorker : public Napi::AsyncWorker {
+public:
+  CIReadFrameWorker(Napi::Env env, ConcatInput* input, Packet* packet)
+    : Napi::AsyncWorker(env),
+      input_(input),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = input_->ReadInternal(packet_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ConcatInput* input_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value ConcatInput::OpenAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareOpen(info)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new CIOpenWorker(env, this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ConcatInput::ReadFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new CIReadFrameWorker(env, this, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,30 @@
+#include "concat_input.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value ConcatInput::OpenSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareOpen(info)) {
+    return env.Undefined();
+  }
+
+  // Waits for the prefetcher to open the first usable item
+  return Napi::Number::New(env, StartInternal());
+}
+
+Napi::Value ConcatInput::ReadFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ReadInternal(packet->Get()));
+}
+
+} // namespace ffmpeg
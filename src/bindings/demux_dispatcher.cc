@@ -0,0 +1,521 @@
+#include "demux_dispatcher.h"
+#include "format_context.h"
+#include "codec_context.h"
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference DemuxDispatcher::constructor;
+
+// Decoded frames buffered per stream before the decoder thread blocks
+static constexpr size_t kFrameQueueSize = 8;
+
+Napi::Object DemuxDispatcher::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "DemuxDispatcher", {
+    // Setup
+    InstanceMethod<&DemuxDispatcher::SetInput>("setInput"),
+    InstanceMethod<&DemuxDispatcher::SetOutput>("setOutput"),
+    InstanceMethod<&DemuxDispatcher::AddStream>("addStream"),
+    InstanceMethod<&DemuxDispatcher::Start>("start"),
+
+    // Consumption
+    InstanceMethod<&DemuxDispatcher::ReceiveFrameAsync>("receiveFrame"),
+    InstanceMethod<&DemuxDispatcher::ReceiveFrameSync>("receiveFrameSync"),
+    InstanceMethod<&DemuxDispatcher::WaitAsync>("wait"),
+    InstanceMethod<&DemuxDispatcher::WaitSync>("waitSync"),
+
+    // Lifecycle
+    InstanceMethod<&DemuxDispatcher::Stop>("stop"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &DemuxDispatcher::Dispose),
+
+    // Properties
+    InstanceAccessor<&DemuxDispatcher::GetIsRunning>("isRunning"),
+    InstanceMethod<&DemuxDispatcher::GetStats>("getStats"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("DemuxDispatcher", func);
+  return exports;
+}
+
+DemuxDispatcher::DemuxDispatcher(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<DemuxDispatcher>(info) {
+  // Constructor does nothing - user must call setInput() and addStream()
+}
+
+DemuxDispatcher::~DemuxDispatcher() {
+  // start() keeps the dispatcher alive until its threads have exited and been joined, so
+  // they can only still run here at environment teardown, where calls into JS fail
+  // instead of blocking and the input interrupt aborts I/O
+  StopInternal();
+  JoinInternal();
+
+  for (auto& ref : refs_) {
+    ref.Reset();
+  }
+  refs_.clear();
+}
+
+// === Threads ===
+
+void DemuxDispatcher::ReaderLoop() {
+  AVPacket* packet = av_packet_alloc();
+  if (!packet) {
+    read_error_ = AVERROR(ENOMEM);
+  }
+
+  while (packet && !stopping_) {
+    // Through the format context: packet traces, read pacing, allocator and recorder
+    int ret = input_context_->ReadPacket(packet);
+    if (ret < 0) {
+      // AVERROR_EXIT from an interrupted read is the expected result of stop()
+      if (ret != AVERROR_EOF && !stopping_) {
+        read_error_ = ret;
+      }
+      break;
+    }
+
+    packets_read_++;
+
+    Route* route = FindRoute(packet->stream_index);
+    if (!route) {
+      // Stream not attached - drop
+      av_packet_unref(packet);
+      continue;
+    }
+
+    AVPacket* queued = av_packet_alloc();
+    if (!queued) {
+      av_packet_unref(packet);
+      read_error_ = AVERROR(ENOMEM);
+      break;
+    }
+    av_packet_move_ref(queued, packet);
+
+    // Blocks while the decoder of this stream is behind
+    if (!route->packets.Push(queued)) {
+      av_packet_free(&queued);
+    }
+  }
+
+  av_packet_free(&packet);
+
+  // End of input - let every decoder drain
+  for (auto& route : routes_) {
+    route->packets.Close();
+  }
+
+  {
+    // Done with the input: undo the interrupt of stop() so it can be read again
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    read_finished_ = true;
+    if (interrupted_) {
+      input_context_->ResumeReads();
+      interrupted_ = false;
+    }
+  }
+
+  ThreadExited();
+}
+
+void DemuxDispatcher::RouteLoop(Route* route) {
+  AVFrame* frame = av_frame_alloc();
+  if (!frame) {
+    route->error = AVERROR(ENOMEM);
+    route->frames.Close();
+    ThreadExited();
+    return;
+  }
+
+  bool running = true;
+  while (running && !stopping_) {
+    AVPacket* packet = nullptr;
+    bool got = route->packets.Pop(packet);
+
+    // A closed and empty queue means end of input: flush the decoder
+    int ret = avcodec_send_packet(route->decoder, got ? packet : nullptr);
+    if (got) {
+      av_packet_free(&packet);
+      route->packets_decoded++;
+    }
+    if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+      // Corrupt packet - keep going like the ffmpeg CLI does
+      continue;
+    }
+
+    while ((ret = avcodec_receive_frame(route->decoder, frame)) >= 0) {
+      route->frames_decoded++;
+      if (!EmitFrame(route, frame)) {
+        running = false;
+        break;
+      }
+    }
+
+    if (!got) {
+      break;
+    }
+  }
+
+  // Flush the chained encoder
+  if (running && route->encoder && !stopping_) {
+    EncodeFrame(route, nullptr);
+  }
+
+  av_frame_free(&frame);
+  route->frames.Close();
+  ThreadExited();
+}
+
+bool DemuxDispatcher::EmitFrame(Route* route, AVFrame* frame) {
+  if (route->encoder) {
+    // No timestamp stays no timestamp
+    frame->pts = frame->best_effort_timestamp == AV_NOPTS_VALUE
+                   ? AV_NOPTS_VALUE
+                   : av_rescale_q(frame->best_effort_timestamp, route->decoder->pkt_timebase, route->encoder->time_base);
+    frame->pict_type = AV_PICTURE_TYPE_NONE;
+    bool ok = EncodeFrame(route, frame);
+    av_frame_unref(frame);
+    return ok;
+  }
+
+  AVFrame* out = av_frame_alloc();
+  if (!out) {
+    route->error = AVERROR(ENOMEM);
+    av_frame_unref(frame);
+    return false;
+  }
+  av_frame_move_ref(out, frame);
+
+  // Blocks until JS consumes frames of this stream
+  if (!route->frames.Push(out)) {
+    av_frame_free(&out);
+    return false;
+  }
+  return true;
+}
+
+bool DemuxDispatcher::EncodeFrame(Route* route, AVFrame* frame) {
+  int ret = avcodec_send_frame(route->encoder, frame);
+  if (ret < 0 && ret != AVERROR_EOF) {
+    route->error = ret;
+    return false;
+  }
+
+  AVPacket* packet = av_packet_alloc();
+  if (!packet) {
+    route->error = AVERROR(ENOMEM);
+    return false;
+  }
+
+  bool ok = true;
+  while ((ret = avcodec_receive_packet(route->encoder, packet)) >= 0) {
+    {
+      // Muxer is shared between all routes, JS writes and packet routers
+      std::lock_guard<std::mutex> lock(output_context_->WriteMutex());
+      AVFormatContext* output = output_context_->Get();
+      if (!output || !output_context_->IsHeaderWritten() ||
+          route->output_index >= static_cast<int>(output->nb_streams)) {
+        // Trailer already written or output closed from JS
+        av_packet_unref(packet);
+        ret = AVERROR(EINVAL);
+      } else {
+        AVStream* stream = output->streams[route->output_index];
+        av_packet_rescale_ts(packet, route->encoder->time_base, stream->time_base);
+        packet->stream_index = route->output_index;
+        ret = av_interleaved_write_frame(output, packet);
+      }
+    }
+    if (ret < 0) {
+      route->error = ret;
+      ok = false;
+      break;
+    }
+    route->packets_written++;
+  }
+
+  av_packet_free(&packet);
+  return ok;
+}
+
+void DemuxDispatcher::ThreadExited() {
+  // Last thread out: join and drop the start() reference on the JS thread
+  if (--running_threads_ == 0) {
+    if (native_writer_) {
+      output_context_->RemoveNativeWriter();
+    }
+    exit_tsfn_.NonBlockingCall([this](Napi::Env, Napi::Function) { OnThreadsExit(); });
+  }
+  exit_tsfn_.Release();
+}
+
+void DemuxDispatcher::OnThreadsExit() {
+  // Every thread has returned from its loop, joining does not wait on any I/O
+  JoinInternal();
+  Unref();
+}
+
+int DemuxDispatcher::JoinInternal() {
+  std::lock_guard<std::mutex> lock(join_mutex_);
+
+  if (reader_.joinable()) {
+    reader_.join();
+  }
+  for (auto& route : routes_) {
+    if (route->thread.joinable()) {
+      route->thread.join();
+    }
+  }
+
+  if (read_error_ < 0) {
+    return read_error_;
+  }
+  for (auto& route : routes_) {
+    if (route->error < 0) {
+      return route->error;
+    }
+  }
+  return 0;
+}
+
+void DemuxDispatcher::StopInternal() {
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stopping_ = true;
+
+    // Aborts network reads; a read through a JS callback returns once the event loop
+    // runs it, which is why this never joins the threads
+    if (started_ && !read_finished_ && !interrupted_) {
+      input_context_->InterruptReads();
+      interrupted_ = true;
+    }
+  }
+
+  // Wake every blocked thread and release what is queued
+  for (auto& route : routes_) {
+    route->packets.Close();
+    route->frames.Close();
+    route->packets.Drain([](AVPacket*& packet) { av_packet_free(&packet); });
+    route->frames.Drain([](AVFrame*& frame) { av_frame_free(&frame); });
+  }
+}
+
+DemuxDispatcher::Route* DemuxDispatcher::FindRoute(int stream_index) {
+  if (stream_index < 0 || stream_index >= static_cast<int>(by_stream_.size())) {
+    return nullptr;
+  }
+  return by_stream_[stream_index];
+}
+
+// === Setup ===
+
+Napi::Value DemuxDispatcher::SetInput(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "DemuxDispatcher already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (formatContext)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FormatContext* fmt = UnwrapNativeObject<FormatContext>(env, info[0], "FormatContext");
+  if (!fmt || !fmt->Get()) {
+    Napi::TypeError::New(env, "Invalid FormatContext object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    int size = info[1].As<Napi::Number>().Int32Value();
+    queue_size_ = size > 0 ? static_cast<size_t>(size) : 1;
+  }
+
+  input_context_ = fmt;
+  input_ = fmt->Get();
+  by_stream_.assign(input_->nb_streams, nullptr);
+  refs_.push_back(Napi::Persistent(info[0].As<Napi::Object>()));
+
+  return env.Undefined();
+}
+
+Napi::Value DemuxDispatcher::SetOutput(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "DemuxDispatcher already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FormatContext* fmt = info.Length() > 0 ? UnwrapNativeObject<FormatContext>(env, info[0], "FormatContext") : nullptr;
+  if (!fmt || !fmt->Get()) {
+    Napi::TypeError::New(env, "Invalid FormatContext object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  output_context_ = fmt;
+  refs_.push_back(Napi::Persistent(info[0].As<Napi::Object>()));
+
+  return env.Undefined();
+}
+
+Napi::Value DemuxDispatcher::AddStream(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!input_ || started_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected at least 2 arguments (streamIndex, decoder)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int stream_index = info[0].As<Napi::Number>().Int32Value();
+  if (stream_index < 0 || stream_index >= static_cast<int>(by_stream_.size()) || by_stream_[stream_index]) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  CodecContext* decoder = UnwrapNativeObject<CodecContext>(env, info[1], "CodecContext");
+  if (!decoder || !decoder->Get() || !av_codec_is_decoder(decoder->Get()->codec)) {
+    Napi::TypeError::New(env, "Invalid decoder CodecContext").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecContext* encoder = nullptr;
+  int output_index = -1;
+  if (info.Length() > 2 && !info[2].IsNull() && !info[2].IsUndefined()) {
+    encoder = UnwrapNativeObject<CodecContext>(env, info[2], "CodecContext");
+    if (!encoder || !encoder->Get() || !av_codec_is_encoder(encoder->Get()->codec)) {
+      Napi::TypeError::New(env, "Invalid encoder CodecContext").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    output_index = info.Length() > 3 ? info[3].As<Napi::Number>().Int32Value() : -1;
+    AVFormatContext* output = output_context_ ? output_context_->Get() : nullptr;
+    if (!output || output_index < 0 || output_index >= static_cast<int>(output->nb_streams)) {
+      return Napi::Number::New(env, AVERROR(EINVAL));
+    }
+  }
+
+  auto route = std::make_unique<Route>(queue_size_, kFrameQueueSize);
+  route->stream_index = stream_index;
+  route->decoder = decoder->Get();
+  route->encoder = encoder ? encoder->Get() : nullptr;
+  route->output_index = output_index;
+
+  // Keep the codec contexts alive while the threads use them
+  refs_.push_back(Napi::Persistent(info[1].As<Napi::Object>()));
+  if (encoder) {
+    refs_.push_back(Napi::Persistent(info[2].As<Napi::Object>()));
+  }
+
+  by_stream_[stream_index] = route.get();
+  routes_.push_back(std::move(route));
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value DemuxDispatcher::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!input_ || started_ || routes_.empty()) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  bool encodes = false;
+  for (auto& route : routes_) {
+    encodes = encodes || route->encoder != nullptr;
+  }
+  if (encodes) {
+    std::lock_guard<std::mutex> lock(output_context_->WriteMutex());
+    if (!output_context_->IsHeaderWritten()) {
+      return Napi::Number::New(env, AVERROR(EINVAL));
+    }
+    // Sync muxer calls from JS would wait for the routes' writes on the JS thread
+    output_context_->AddNativeWriter();
+    native_writer_ = true;
+  }
+
+  started_ = true;
+
+  // Keep the dispatcher, and through refs_ its contexts, alive until every thread has exited
+  running_threads_ = static_cast<int>(routes_.size()) + 1;
+  exit_tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "DemuxDispatcherExit",
+    0,  // Unlimited queue
+    running_threads_.load()
+  );
+  exit_tsfn_.Unref(env);
+  Ref();
+
+  for (auto& route : routes_) {
+    route->thread = std::thread(&DemuxDispatcher::RouteLoop, this, route.get());
+  }
+  reader_ = std::thread(&DemuxDispatcher::ReaderLoop, this);
+
+  return Napi::Number::New(env, 0);
+}
+
+// === Lifecycle ===
+
+Napi::Value DemuxDispatcher::Stop(const Napi::CallbackInfo& info) {
+  StopInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value DemuxDispatcher::Dispose(const Napi::CallbackInfo& info) {
+  return Stop(info);
+}
+
+// === Properties ===
+
+Napi::Value DemuxDispatcher::GetIsRunning(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!started_ || stopping_) {
+    return Napi::Boolean::New(env, false);
+  }
+
+  // Running until every route delivered its last frame
+  for (auto& route : routes_) {
+    if (!route->frames.IsClosed()) {
+      return Napi::Boolean::New(env, true);
+    }
+  }
+  return Napi::Boolean::New(env, false);
+}
+
+Napi::Value DemuxDispatcher::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("packetsRead", Napi::Number::New(env, static_cast<double>(packets_read_.load())));
+
+  Napi::Array streams = Napi::Array::New(env, routes_.size());
+  for (size_t i = 0; i < routes_.size(); i++) {
+    Route* route = routes_[i].get();
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("streamIndex", Napi::Number::New(env, route->stream_index));
+    entry.Set("packetsDecoded", Napi::Number::New(env, static_cast<double>(route->packets_decoded.load())));
+    entry.Set("framesDecoded", Napi::Number::New(env, static_cast<double>(route->frames_decoded.load())));
+    entry.Set("packetsWritten", Napi::Number::New(env, static_cast<double>(route->packets_written.load())));
+    entry.Set("packetQueue", Napi::Number::New(env, static_cast<double>(route->packets.Size())));
+    entry.Set("frameQueue", Napi::Number::New(env, static_cast<double>(route->frames.Size())));
+    streams.Set(static_cast<uint32_t>(i), entry);
+  }
+  stats.Set("streams", streams);
+
+  return stats;
+}
+
+} // namespace ffmpeg
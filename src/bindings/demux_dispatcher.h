@@ -0,0 +1,127 @@
+#ifndef FFMPEG_DEMUX_DISPATCHER_H
+#define FFMPEG_DEMUX_DISPATCHER_H
+
+#include <napi.h>
+#include "common.h"
+#include "bounded_queue.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace ffmpeg {
+
+class FormatContext;
+
+/**
+ * Demuxes an input on a dedicated thread and decodes every attached stream
+ * on its own thread.
+ *
+ * Packets are routed by stream index into bounded per-stream queues. Each
+ * route either buffers decoded frames for JS or, when chained to an encoder,
+ * encodes them and writes the packets to an output format context without
+ * ever returning to the event loop. The output is registered as natively
+ * written while the threads run, its header must be written before start().
+ *
+ * stop() never waits for the threads, the reader may be blocked in a read
+ * through JS or the network: it signals them and interrupts the input, and
+ * wait() joins them off the JS thread. The dispatcher keeps itself alive
+ * until every thread has exited.
+ */
+class DemuxDispatcher : public Napi::ObjectWrap<DemuxDispatcher> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  DemuxDispatcher(const Napi::CallbackInfo& info);
+  ~DemuxDispatcher();
+
+private:
+  friend class DDReceiveFrameWorker;
+  friend class DDWaitWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct Route {
+    Route(size_t packet_capacity, size_t frame_capacity)
+      : packets(packet_capacity), frames(frame_capacity) {}
+
+    int stream_index = -1;
+    AVCodecContext* decoder = nullptr;
+    AVCodecContext* encoder = nullptr;
+    int output_index = -1;
+
+    BoundedQueue<AVPacket*> packets;
+    BoundedQueue<AVFrame*> frames;
+    std::thread thread;
+
+    std::atomic<int> error{0};
+    std::atomic<uint64_t> packets_decoded{0};
+    std::atomic<uint64_t> frames_decoded{0};
+    std::atomic<uint64_t> packets_written{0};
+  };
+
+  FormatContext* input_context_ = nullptr;
+  AVFormatContext* input_ = nullptr;
+  // Muxer shared with JS writes and other native writers, guarded by its WriteMutex()
+  FormatContext* output_context_ = nullptr;
+  bool native_writer_ = false;
+  std::vector<Napi::ObjectReference> refs_;
+
+  std::vector<std::unique_ptr<Route>> routes_;
+  std::vector<Route*> by_stream_;
+
+  std::thread reader_;
+  std::mutex join_mutex_;
+  // Reports the exit of the last thread to the JS thread, which joins them and drops the start() reference
+  Napi::ThreadSafeFunction exit_tsfn_;
+  std::atomic<int> running_threads_{0};
+  // Orders stop()'s input interrupt with the reader's exit
+  std::mutex state_mutex_;
+  bool interrupted_ = false;
+  bool read_finished_ = false;
+  std::atomic<bool> stopping_{false};
+  std::atomic<int> read_error_{0};
+  std::atomic<uint64_t> packets_read_{0};
+  size_t queue_size_ = 64;
+  bool started_ = false;
+
+  void ReaderLoop();
+  void RouteLoop(Route* route);
+  bool EmitFrame(Route* route, AVFrame* frame);
+  bool EncodeFrame(Route* route, AVFrame* frame);
+  void ThreadExited();
+  void OnThreadsExit();
+  int JoinInternal();
+  void StopInternal();
+  Route* FindRoute(int stream_index);
+
+  // Setup
+  Napi::Value SetInput(const Napi::CallbackInfo& info);
+  Napi::Value SetOutput(const Napi::CallbackInfo& info);
+  Napi::Value AddStream(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+
+  // Consumption
+  Napi::Value ReceiveFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value WaitAsync(const Napi::CallbackInfo& info);
+  Napi::Value WaitSync(const Napi::CallbackInfo& info);
+
+  // Lifecycle
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetIsRunning(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_DEMUX_DISPATCHER_H
@@ -0,0 +1,124 @@
+#include "demux_dispatcher.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class DDReceiveFrameWorker : public Napi::AsyncWorker {
+public:
+  DDReceiveFrameWorker(Napi::Env env, DemuxDispatcher::Route* route, Frame* frame)
+    : Napi::AsyncWorker(env),
+      route_(route),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    AVFrame* decoded = nullptr;
+    if (!route_->frames.Pop(decoded)) {
+      ret_ = route_->error < 0 ? route_->error.load() : AVERROR_EOF;
+      return;
+    }
+
+    av_frame_unref(frame_->Get());
+    av_frame_move_ref(frame_->Get(), decoded);
+    av_frame_free(&decoded);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  DemuxDispatcher::Route* route_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class DDWaitWorker : public Napi::AsyncWorker {
+public:
+  DDWaitWorker(Napi::Env env, DemuxDispatcher* dispatcher)
+    : Napi::AsyncWorker(env),
+      dispatcher_(dispatcher),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = dispatcher_->JoinInternal();
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  DemuxDispatcher* dispatcher_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value DemuxDispatcher::ReceiveFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (streamIndex, frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Route* route = FindRoute(info[0].As<Napi::Number>().Int32Value());
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Unknown stream or frames go to an encoder instead of JS
+  if (!route || route->encoder || !started_) {
+    auto deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(Napi::Number::New(env, AVERROR(EINVAL)));
+    return deferred.Promise();
+  }
+
+  auto* worker = new DDReceiveFrameWorker(env, route, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value DemuxDispatcher::WaitAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  auto* worker = new DDWaitWorker(env, this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,44 @@
+#include "demux_dispatcher.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value DemuxDispatcher::ReceiveFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (streamIndex, frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Route* route = FindRoute(info[0].As<Napi::Number>().Int32Value());
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[1], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Unknown stream or frames go to an encoder instead of JS
+  if (!route || route->encoder || !started_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  AVFrame* decoded = nullptr;
+  if (!route->frames.Pop(decoded)) {
+    int ret = route->error < 0 ? route->error.load() : AVERROR_EOF;
+    return Napi::Number::New(env, ret);
+  }
+
+  av_frame_unref(frame->Get());
+  av_frame_move_ref(frame->Get(), decoded);
+  av_frame_free(&decoded);
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value DemuxDispatcher::WaitSync(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), JoinInternal());
+}
+
+} // namespace ffmpeg
@@ -72,6 +72,7 @@ Napi::Value FFmpegError::GetAverror(const Napi::CallbackInfo& info) {
   if (errorName == "EBUSY") return Napi::Number::New(env, AVERROR(EBUSY));
   if (errorName == "EMFILE") return Napi::Number::New(env, AVERROR(EMFILE));
   if (errorName == "ERANGE") return Napi::Number::New(env, AVERROR(ERANGE));
+  if (errorName == "ENOSYS") return Napi::Number::New(env, AVERROR(ENOSYS));
   
   // We don't handle FFmpeg-specific error codes here
   // They are already available as constants
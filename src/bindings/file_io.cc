@@ -0,0 +1,1004 @@
+#include "file_io.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define FILE_IO_HAVE_URING 1
+#endif
+#endif
+
+extern "C" {
+#include <libavformat/avio.h>
+#include <libavutil/error.h>
+}
+
+namespace ffmpeg {
+
+#ifndef _WIN32
+
+namespace {
+
+int64_t NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void RecordLatency(FileIOLatencyHistogram& histogram, int64_t ns) {
+  uint64_t us = ns > 0 ? static_cast<uint64_t>(ns) / 1000 : 0;
+  int bucket = 0;
+  while (us > 0 && bucket < kFileIOLatencyBuckets - 1) {
+    us >>= 1;
+    bucket++;
+  }
+  histogram[bucket]++;
+}
+
+uint8_t* AllocAligned(size_t size, size_t alignment) {
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, std::max<size_t>(alignment, sizeof(void*)), size) != 0) {
+    return nullptr;
+  }
+  return static_cast<uint8_t*>(ptr);
+}
+
+// Transfer a whole request synchronously, retrying on EINTR and short transfers
+int64_t TransferSync(FileIOEngine::Op* op, std::atomic<uint64_t>* syscalls) {
+  size_t done = 0;
+  while (done < op->length) {
+    ssize_t ret = op->write
+      ? pwrite(op->fd, op->data + done, op->length - done, op->offset + done)
+      : pread(op->fd, op->data + done, op->length - done, op->offset + done);
+    syscalls->fetch_add(1, std::memory_order_relaxed);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return done > 0 ? static_cast<int64_t>(done) : AVERROR(errno);
+    }
+    if (ret == 0) {
+      break;  // End of file
+    }
+    done += ret;
+  }
+  return static_cast<int64_t>(done);
+}
+
+/**
+ * Fallback engine: a worker thread executing requests with pread/pwrite.
+ */
+class ThreadEngine : public FileIOEngine {
+public:
+  ThreadEngine() : worker_([this] { Run(); }) {}
+
+  ~ThreadEngine() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    submit_cv_.notify_all();
+    worker_.join();
+  }
+
+  const char* Name() const override { return "threads"; }
+
+  int Submit(Op* op) override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.push_back(op);
+    submit_cv_.notify_one();
+    return 0;
+  }
+
+  int Flush() override { return 0; }
+
+  Op* Reap(bool wait) override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (wait) {
+      done_cv_.wait(lock, [this] { return !done_.empty(); });
+    } else if (done_.empty()) {
+      return nullptr;
+    }
+    Op* op = done_.front();
+    done_.pop_front();
+    return op;
+  }
+
+private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      submit_cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+      if (pending_.empty()) {
+        return;
+      }
+      Op* op = pending_.front();
+      pending_.pop_front();
+      lock.unlock();
+      op->result = TransferSync(op, &syscalls_);
+      lock.lock();
+      done_.push_back(op);
+      done_cv_.notify_one();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable submit_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Op*> pending_;
+  std::deque<Op*> done_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+#ifdef FILE_IO_HAVE_URING
+
+/**
+ * io_uring engine on raw syscalls (no liburing dependency).
+ *
+ * Uses IORING_OP_READV/WRITEV so kernels from 5.1 on are supported.
+ */
+class UringEngine : public FileIOEngine {
+public:
+  ~UringEngine() override {
+    if (sqes_) munmap(sqes_, sqes_size_);
+    if (cq_ptr_ && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+    if (sq_ptr_) munmap(sq_ptr_, sq_size_);
+    if (ring_fd_ >= 0) close(ring_fd_);
+  }
+
+  int Init(unsigned entries, unsigned depth) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+      return AVERROR(errno);
+    }
+
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+
+    void* sq = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq == MAP_FAILED) {
+      return AVERROR(errno);
+    }
+    sq_ptr_ = static_cast<uint8_t*>(sq);
+
+    if (single_mmap) {
+      cq_ptr_ = sq_ptr_;
+    } else {
+      void* cq = mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+      if (cq == MAP_FAILED) {
+        return AVERROR(errno);
+      }
+      cq_ptr_ = static_cast<uint8_t*>(cq);
+    }
+
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+      sqes_size_ = 0;
+      return AVERROR(errno);
+    }
+    sqes_ = static_cast<struct io_uring_sqe*>(sqes);
+
+    sq_entries_ = params.sq_entries;
+    sq_head_ = reinterpret_cast<unsigned*>(sq_ptr_ + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq_ptr_ + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq_ptr_ + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq_ptr_ + params.sq_off.array);
+    cq_head_ = reinterpret_cast<unsigned*>(cq_ptr_ + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq_ptr_ + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq_ptr_ + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<struct io_uring_cqe*>(cq_ptr_ + params.cq_off.cqes);
+
+    iovecs_.resize(std::max(depth, 1u));
+    return 0;
+  }
+
+  const char* Name() const override { return "uring"; }
+
+  int Submit(Op* op) override {
+    unsigned tail = *sq_tail_;
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (tail - head >= sq_entries_) {
+      int ret = Flush();
+      if (ret < 0) {
+        return ret;
+      }
+    }
+
+    unsigned index = tail & *sq_mask_;
+    struct iovec* iov = &iovecs_[op->tag % iovecs_.size()];
+    iov->iov_base = op->data;
+    iov->iov_len = op->length;
+
+    struct io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = op->write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = op->fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = 1;
+    sqe->off = static_cast<uint64_t>(op->offset);
+    sqe->user_data = reinterpret_cast<uint64_t>(op);
+
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    to_submit_++;
+    return 0;
+  }
+
+  int Flush() override {
+    while (to_submit_ > 0) {
+      int ret = Enter(to_submit_, 0, 0);
+      if (ret < 0) {
+        return ret;
+      }
+      to_submit_ -= std::min<unsigned>(to_submit_, ret);
+    }
+    return 0;
+  }
+
+  Op* Reap(bool wait) override {
+    for (;;) {
+      unsigned head = *cq_head_;
+      unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      if (head != tail) {
+        struct io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+        Op* op = reinterpret_cast<Op*>(cqe->user_data);
+        op->result = cqe->res;  // -errno on failure, which is an AVERROR on POSIX
+        __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+        return op;
+      }
+      if (!wait) {
+        return nullptr;
+      }
+      // Submit anything still queued and wait for one completion in the same syscall
+      unsigned submit = to_submit_;
+      int ret = Enter(submit, 1, IORING_ENTER_GETEVENTS);
+      if (ret < 0) {
+        return nullptr;
+      }
+      to_submit_ -= std::min<unsigned>(submit, ret);
+    }
+  }
+
+private:
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags) {
+    for (;;) {
+      long ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, nullptr, 0);
+      syscalls_.fetch_add(1, std::memory_order_relaxed);
+      if (ret >= 0) {
+        return static_cast<int>(ret);
+      }
+      if (errno != EINTR) {
+        return AVERROR(errno);
+      }
+    }
+  }
+
+  int ring_fd_ = -1;
+  uint8_t* sq_ptr_ = nullptr;
+  uint8_t* cq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  size_t cq_size_ = 0;
+  struct io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned sq_entries_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  struct io_uring_cqe* cqes_ = nullptr;
+  unsigned to_submit_ = 0;
+  std::vector<struct iovec> iovecs_;  // One per op tag, valid until the op completes
+};
+
+#endif // FILE_IO_HAVE_URING
+
+} // namespace
+
+std::unique_ptr<FileIOEngine> FileIOEngine::Create(FileIOEngineType type, unsigned depth, int* error) {
+  *error = 0;
+
+#ifdef FILE_IO_HAVE_URING
+  if (type != FILE_IO_ENGINE_THREADS) {
+    auto uring = std::make_unique<UringEngine>();
+    int ret = uring->Init(depth, depth);
+    if (ret >= 0) {
+      return uring;
+    }
+    if (type == FILE_IO_ENGINE_URING) {
+      *error = ret;
+      return nullptr;
+    }
+  }
+#else
+  if (type == FILE_IO_ENGINE_URING) {
+    *error = AVERROR(ENOSYS);
+    return nullptr;
+  }
+#endif
+
+  return std::make_unique<ThreadEngine>();
+}
+
+int FileIO::Open(const std::string& path, bool write, const FileIOOptions& options, std::unique_ptr<FileIO>* out) {
+  if (options.queue_depth < 1 || options.block_size < 4096) {
+    return AVERROR(EINVAL);
+  }
+  if (options.alignment < 512 || (options.alignment & (options.alignment - 1)) != 0) {
+    return AVERROR(EINVAL);
+  }
+
+  std::string file = path;
+  if (file.compare(0, 5, "file:") == 0) {
+    file = file.substr(5);
+  }
+
+  std::unique_ptr<FileIO> io(new FileIO());
+  io->write_ = write;
+  io->block_size_ = static_cast<size_t>(options.block_size);
+  io->queue_depth_ = static_cast<size_t>(options.queue_depth);
+  if (write) {
+    io->cache_ = options.cache;
+    io->sync_ = options.sync;
+    io->sync_interval_ = options.sync_interval;
+  }
+
+  int ret = 0;
+  io->engine_ = FileIOEngine::Create(options.engine, static_cast<unsigned>(options.queue_depth), &ret);
+  if (!io->engine_) {
+    return ret;
+  }
+
+  // Written files are opened read-write so unaligned O_DIRECT writes can read back their sectors
+  int flags = write ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY;
+#ifdef O_CLOEXEC
+  flags |= O_CLOEXEC;
+#endif
+
+#ifdef O_DIRECT
+  if (io->cache_ == FILE_IO_CACHE_DIRECT) {
+    io->fd_ = open(file.c_str(), flags | O_DIRECT, 0666);
+    if (io->fd_ >= 0) {
+      io->aligned_ = true;
+      io->alignment_ = static_cast<size_t>(options.alignment);
+      io->stats_.direct = true;
+    } else if (errno != EINVAL) {
+      return AVERROR(errno);
+    }
+  }
+#endif
+
+  if (io->fd_ < 0) {
+    io->fd_ = open(file.c_str(), flags, 0666);
+    if (io->fd_ < 0) {
+      return AVERROR(errno);
+    }
+  }
+
+#ifdef F_NOCACHE
+  if (io->cache_ == FILE_IO_CACHE_DIRECT && !io->stats_.direct && fcntl(io->fd_, F_NOCACHE, 1) == 0) {
+    io->stats_.direct = true;
+  }
+#endif
+
+  // Filesystems without O_DIRECT (tmpfs, some network filesystems): drop pages after writeback instead
+  if (io->cache_ == FILE_IO_CACHE_DIRECT && !io->stats_.direct) {
+    io->cache_ = FILE_IO_CACHE_DONTNEED;
+  }
+
+  size_t buffer_alignment = 64;
+  if (io->aligned_) {
+    buffer_alignment = io->alignment_;
+    io->block_size_ = (io->block_size_ + io->alignment_ - 1) & ~(io->alignment_ - 1);
+    io->sector_ = AllocAligned(io->alignment_, io->alignment_);
+    if (!io->sector_) {
+      return AVERROR(ENOMEM);
+    }
+  }
+
+  io->blocks_.resize(options.queue_depth);
+  for (size_t i = 0; i < io->blocks_.size(); i++) {
+    Block& block = io->blocks_[i];
+    block.data = AllocAligned(io->block_size_, buffer_alignment);
+    if (!block.data) {
+      return AVERROR(ENOMEM);
+    }
+    block.op.fd = io->fd_;
+    block.op.write = write;
+    block.op.data = block.data;
+    block.op.tag = static_cast<int>(i);
+  }
+
+  *out = std::move(io);
+  return 0;
+}
+
+FileIO::~FileIO() {
+  Close();
+  for (Block& block : blocks_) {
+    free(block.data);
+  }
+  free(sector_);
+}
+
+const char* FileIO::EngineName() const {
+  return engine_ ? engine_->Name() : "none";
+}
+
+FileIOStats FileIO::GetStats() const {
+  FileIOStats stats = stats_;
+  if (engine_) {
+    stats.syscalls += engine_->Syscalls();
+  }
+  return stats;
+}
+
+int FileIO::AcquireBlock() {
+  for (;;) {
+    for (size_t i = 0; i < blocks_.size(); i++) {
+      if (blocks_[i].state == BLOCK_FREE) {
+        return static_cast<int>(i);
+      }
+    }
+    int ret = ReapOne(true);
+    if (ret < 0) {
+      return ret;
+    }
+    if (ret == 0) {
+      return AVERROR(EAGAIN);  // Nothing in flight that could free a block
+    }
+  }
+}
+
+int FileIO::SubmitBlock(int index) {
+  Block& block = blocks_[index];
+  size_t length = block.length;
+
+  if (write_) {
+    if (aligned_) {
+      int ret = PadBlock(block);
+      if (ret < 0) {
+        return ret;
+      }
+      length = (block.length + alignment_ - 1) & ~(alignment_ - 1);
+    }
+
+    // Pending writes complete in any order, so a rewrite of a range that is
+    // still in flight (seek-back header updates) must wait for it
+    if (block.op.offset < submitted_end_ && in_flight_ > 0) {
+      int ret = Drain();
+      if (ret < 0) {
+        return ret;
+      }
+    }
+    submitted_end_ = std::max(submitted_end_, block.op.offset + static_cast<int64_t>(length));
+    stats_.write_ops++;
+    stats_.bytes_submitted += length;
+  } else {
+    stats_.read_ops++;
+  }
+
+  block.op.length = length;
+  block.op.result = 0;
+  block.op.submitted_at = NowNs();
+  block.state = BLOCK_PENDING;
+
+  int ret = engine_->Submit(&block.op);
+  if (ret < 0) {
+    block.state = BLOCK_FREE;
+    return ret;
+  }
+
+  in_flight_++;
+  stats_.max_in_flight = std::max<uint64_t>(stats_.max_in_flight, in_flight_);
+  return 0;
+}
+
+int FileIO::ReapOne(bool wait) {
+  if (in_flight_ == 0) {
+    return 0;
+  }
+
+  int ret = engine_->Flush();
+  if (ret < 0) {
+    return ret;
+  }
+
+  FileIOEngine::Op* op = engine_->Reap(false);
+  if (!op && wait) {
+    stats_.waits++;
+    op = engine_->Reap(true);
+  }
+  if (!op) {
+    return wait ? AVERROR(EIO) : 0;
+  }
+
+  in_flight_--;
+  Block& block = blocks_[op->tag];
+
+  if (write_) {
+    RecordLatency(stats_.write_latency, NowNs() - op->submitted_at);
+    if (op->result < 0) {
+      error_ = static_cast<int>(op->result);
+    } else if (static_cast<size_t>(op->result) < op->length) {
+      // Short write: finish the remainder synchronously
+      FileIOEngine::Op rest = *op;
+      rest.data += op->result;
+      rest.offset += op->result;
+      rest.length -= op->result;
+      std::atomic<uint64_t> syscalls{0};
+      int64_t written = TransferSync(&rest, &syscalls);
+      stats_.syscalls += syscalls.load();
+      if (written < 0 || static_cast<size_t>(written) < rest.length) {
+        error_ = written < 0 ? static_cast<int>(written) : AVERROR(EIO);
+      }
+    }
+    if (error_ >= 0) {
+      AfterWrite(op->offset, op->length);
+    }
+    block.state = BLOCK_FREE;
+  } else {
+    block.state = block.state == BLOCK_DISCARDED ? BLOCK_FREE : BLOCK_READY;
+  }
+
+  return 1;
+}
+
+int FileIO::Drain() {
+  while (in_flight_ > 0) {
+    int ret = ReapOne(true);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+  return 0;
+}
+
+void FileIO::FillReadahead() {
+  bool submitted = false;
+
+  for (Block& block : blocks_) {
+    if (block.state != BLOCK_FREE) {
+      continue;
+    }
+    if (eof_offset_ >= 0 && next_offset_ >= eof_offset_) {
+      break;
+    }
+
+    int index = static_cast<int>(&block - blocks_.data());
+    block.op.offset = next_offset_;
+    block.length = block_size_;
+    block.consumed = 0;
+    if (SubmitBlock(index) < 0) {
+      break;
+    }
+    window_.push_back(index);
+    next_offset_ += block_size_;
+    submitted = true;
+  }
+
+  // One syscall for the whole batch
+  if (submitted) {
+    engine_->Flush();
+  }
+}
+
+void FileIO::DropWindow() {
+  for (int index : window_) {
+    Block& block = blocks_[index];
+    block.state = block.state == BLOCK_PENDING ? BLOCK_DISCARDED : BLOCK_FREE;
+  }
+  window_.clear();
+}
+
+int FileIO::Read(uint8_t* buf, int size) {
+  if (fd_ < 0 || write_) {
+    return AVERROR(EINVAL);
+  }
+  if (error_ < 0) {
+    return error_;
+  }
+
+  for (;;) {
+    FillReadahead();
+    if (window_.empty()) {
+      return AVERROR_EOF;
+    }
+
+    Block& block = blocks_[window_.front()];
+    while (block.state == BLOCK_PENDING) {
+      int ret = ReapOne(true);
+      if (ret < 0) {
+        return ret;
+      }
+    }
+
+    if (block.op.result < 0) {
+      int ret = static_cast<int>(block.op.result);
+      DropWindow();
+      next_offset_ = pos_;
+      return ret;
+    }
+
+    size_t filled = static_cast<size_t>(block.op.result);
+    if (filled < block.length) {
+      // Short read on a regular file: end of file reached
+      eof_offset_ = block.op.offset + static_cast<int64_t>(filled);
+    }
+
+    if (block.consumed >= filled) {
+      if (filled < block.length) {
+        DropWindow();
+        next_offset_ = eof_offset_;
+        return AVERROR_EOF;
+      }
+      block.state = BLOCK_FREE;
+      window_.pop_front();
+      continue;
+    }
+
+    size_t n = std::min(filled - block.consumed, static_cast<size_t>(size));
+    memcpy(buf, block.data + block.consumed, n);
+    block.consumed += n;
+    pos_ += static_cast<int64_t>(n);
+    stats_.bytes_read += n;
+
+    if (block.consumed == block.length) {
+      block.state = BLOCK_FREE;
+      window_.pop_front();
+    }
+    return static_cast<int>(n);
+  }
+}
+
+int FileIO::Write(const uint8_t* buf, int size) {
+  if (fd_ < 0 || !write_) {
+    return AVERROR(EINVAL);
+  }
+  if (error_ < 0) {
+    return error_;
+  }
+
+  size_t done = 0;
+  while (done < static_cast<size_t>(size)) {
+    if (filling_ >= 0) {
+      Block& current = blocks_[filling_];
+      // Not contiguous with the coalesced data: write out what we have
+      if (current.op.offset + static_cast<int64_t>(current.length) != pos_) {
+        int ret = SubmitBlock(filling_);
+        filling_ = -1;
+        if (ret < 0) {
+          return ret;
+        }
+        continue;
+      }
+    } else {
+      int index = AcquireBlock();
+      if (index < 0) {
+        return index;
+      }
+      filling_ = index;
+      blocks_[index].state = BLOCK_FILLING;
+      blocks_[index].op.offset = pos_;
+      blocks_[index].length = 0;
+
+      if (aligned_) {
+        // O_DIRECT blocks start on a sector boundary, keep the bytes before pos_
+        size_t head = static_cast<size_t>(pos_) & (alignment_ - 1);
+        blocks_[index].op.offset = pos_ - static_cast<int64_t>(head);
+        blocks_[index].length = head;
+        if (head > 0) {
+          int ret = LoadSector(blocks_[index].op.offset, blocks_[index].data, 0, head);
+          if (ret < 0) {
+            blocks_[index].state = BLOCK_FREE;
+            filling_ = -1;
+            return ret;
+          }
+        }
+      }
+    }
+
+    Block& block = blocks_[filling_];
+    size_t n = std::min(block_size_ - block.length, static_cast<size_t>(size) - done);
+    memcpy(block.data + block.length, buf + done, n);
+    block.length += n;
+    done += n;
+    pos_ += static_cast<int64_t>(n);
+
+    if (block.length == block_size_) {
+      int ret = SubmitBlock(filling_);
+      filling_ = -1;
+      if (ret < 0) {
+        return ret;
+      }
+      ret = engine_->Flush();
+      if (ret < 0) {
+        return ret;
+      }
+    }
+  }
+
+  // Recycle buffers whose writes completed meanwhile
+  while (ReapOne(false) > 0) {
+  }
+
+  written_end_ = std::max(written_end_, pos_);
+  stats_.bytes_written += done;
+  return error_ < 0 ? error_ : size;
+}
+
+int64_t FileIO::FileSize() {
+  // Written files are truncated on open, padding of O_DIRECT tails is not part of the file
+  if (write_) {
+    return written_end_;
+  }
+
+  struct stat st;
+  if (fstat(fd_, &st) < 0) {
+    return AVERROR(errno);
+  }
+  return st.st_size;
+}
+
+int FileIO::LoadSector(int64_t sector, uint8_t* dst, size_t from, size_t to) {
+  if (sector >= written_end_) {
+    memset(dst + from, 0, to - from);
+    return 0;
+  }
+
+  // The sector may still be part of a pending write
+  int ret = Drain();
+  if (ret < 0) {
+    return ret;
+  }
+
+  ssize_t n;
+  do {
+    n = pread(fd_, sector_, alignment_, sector);
+    stats_.syscalls++;
+  } while (n < 0 && errno == EINTR);
+  if (n < 0) {
+    return AVERROR(errno);
+  }
+  if (static_cast<size_t>(n) < alignment_) {
+    memset(sector_ + n, 0, alignment_ - n);
+  }
+
+  memcpy(dst + from, sector_ + from, to - from);
+  stats_.rmw_reads++;
+  return 0;
+}
+
+int FileIO::PadBlock(Block& block) {
+  size_t tail = block.length & (alignment_ - 1);
+  if (tail == 0) {
+    return 0;
+  }
+
+  // Complete the last sector with the bytes already in the file behind the data
+  size_t sector_start = block.length - tail;
+  if (block.op.offset + static_cast<int64_t>(block.length) >= written_end_) {
+    memset(block.data + block.length, 0, alignment_ - tail);  // Appending: cut by ftruncate on close
+    return 0;
+  }
+  return LoadSector(block.op.offset + static_cast<int64_t>(sector_start), block.data + sector_start, tail, alignment_);
+}
+
+void FileIO::AfterWrite(int64_t offset, size_t length) {
+  unsynced_ += static_cast<int64_t>(length);
+
+  if (cache_ == FILE_IO_CACHE_DONTNEED) {
+#ifdef __linux__
+    // Start writeback now, so dropping the pages later does not have to wait for it
+    sync_file_range(fd_, offset, static_cast<off_t>(length), SYNC_FILE_RANGE_WRITE);
+    stats_.syscalls++;
+#endif
+    writeback_.emplace_back(offset, length);
+    ReleaseWriteback(queue_depth_);
+  }
+
+  if (sync_ == FILE_IO_SYNC_INTERVAL && sync_interval_ > 0 && unsynced_ >= sync_interval_) {
+    int ret = Sync();
+    if (ret < 0) {
+      error_ = ret;
+    }
+  }
+}
+
+void FileIO::ReleaseWriteback(size_t keep) {
+  while (writeback_.size() > keep) {
+    std::pair<int64_t, size_t> range = writeback_.front();
+    writeback_.pop_front();
+#ifdef __linux__
+    sync_file_range(fd_, range.first, static_cast<off_t>(range.second),
+                    SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    stats_.syscalls++;
+#endif
+#ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd_, range.first, static_cast<off_t>(range.second), POSIX_FADV_DONTNEED);
+    stats_.syscalls++;
+#endif
+  }
+}
+
+int FileIO::Sync() {
+  int64_t start = NowNs();
+#ifdef __APPLE__
+  int ret = fsync(fd_);
+#else
+  int ret = fdatasync(fd_);
+#endif
+  int err = errno;
+  stats_.syscalls++;
+  stats_.syncs++;
+  RecordLatency(stats_.sync_latency, NowNs() - start);
+  unsynced_ = 0;
+  return ret < 0 ? AVERROR(err) : 0;
+}
+
+int64_t FileIO::Seek(int64_t offset, int whence) {
+  if (fd_ < 0) {
+    return AVERROR(EINVAL);
+  }
+
+  if (whence & AVSEEK_SIZE) {
+    return FileSize();
+  }
+
+  int64_t target;
+  switch (whence & ~AVSEEK_FORCE) {
+    case SEEK_SET:
+      target = offset;
+      break;
+    case SEEK_CUR:
+      target = pos_ + offset;
+      break;
+    case SEEK_END: {
+      int64_t size = FileSize();
+      if (size < 0) {
+        return size;
+      }
+      target = size + offset;
+      break;
+    }
+    default:
+      return AVERROR(EINVAL);
+  }
+  if (target < 0) {
+    return AVERROR(EINVAL);
+  }
+
+  if (write_) {
+    // The coalesced block is written when the next write is not contiguous
+    pos_ = target;
+    return pos_;
+  }
+
+  // Keep the readahead window if the target lies inside it
+  while (!window_.empty()) {
+    Block& block = blocks_[window_.front()];
+    int64_t start = block.op.offset;
+    int64_t end = start + static_cast<int64_t>(block.length);
+    if (target >= start && target < end) {
+      block.consumed = static_cast<size_t>(target - start);
+      pos_ = target;
+      return pos_;
+    }
+    if (target < start) {
+      break;
+    }
+    block.state = block.state == BLOCK_PENDING ? BLOCK_DISCARDED : BLOCK_FREE;
+    window_.pop_front();
+  }
+
+  DropWindow();
+  next_offset_ = target;
+  eof_offset_ = -1;
+  pos_ = target;
+  return pos_;
+}
+
+int FileIO::Close() {
+  if (fd_ < 0) {
+    return 0;
+  }
+
+  int ret = 0;
+  if (write_ && filling_ >= 0) {
+    ret = SubmitBlock(filling_);
+    filling_ = -1;
+  }
+
+  // Buffers must not be freed while the kernel still owns them
+  int drained = Drain();
+  if (ret >= 0) {
+    ret = drained;
+  }
+  window_.clear();
+
+  if (write_) {
+    // Cut the O_DIRECT padding of the last sector
+    if (aligned_ && ftruncate(fd_, written_end_) < 0 && ret >= 0) {
+      ret = AVERROR(errno);
+    }
+    if (sync_ != FILE_IO_SYNC_NONE) {
+      int synced = Sync();
+      if (ret >= 0) {
+        ret = synced;
+      }
+    }
+    ReleaseWriteback(0);
+  }
+
+  if (close(fd_) < 0 && ret >= 0) {
+    ret = AVERROR(errno);
+  }
+  fd_ = -1;
+
+  if (ret >= 0 && error_ < 0) {
+    ret = error_;
+  }
+  return ret;
+}
+
+#else // _WIN32
+
+std::unique_ptr<FileIOEngine> FileIOEngine::Create(FileIOEngineType type, unsigned depth, int* error) {
+  *error = AVERROR(ENOSYS);
+  return nullptr;
+}
+
+int FileIO::Open(const std::string& path, bool write, const FileIOOptions& options, std::unique_ptr<FileIO>* out) {
+  return AVERROR(ENOSYS);
+}
+
+FileIO::~FileIO() {}
+
+const char* FileIO::EngineName() const { return "none"; }
+FileIOStats FileIO::GetStats() const { return stats_; }
+int FileIO::Read(uint8_t* buf, int size) { return AVERROR(ENOSYS); }
+int FileIO::Write(const uint8_t* buf, int size) { return AVERROR(ENOSYS); }
+int64_t FileIO::Seek(int64_t offset, int whence) { return AVERROR(ENOSYS); }
+int FileIO::Close() { return 0; }
+
+#endif // _WIN32
+
+int FileIO::ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
+  return static_cast<FileIO*>(opaque)->Read(buf, buf_size);
+}
+
+int FileIO::WritePacket(void* opaque, const uint8_t* buf, int buf_size) {
+  return static_cast<FileIO*>(opaque)->Write(buf, buf_size);
+}
+
+int64_t FileIO::SeekPacket(void* opaque, int64_t offset, int whence) {
+  return static_cast<FileIO*>(opaque)->Seek(offset, whence);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,195 @@
+#ifndef FFMPEG_FILE_IO_H
+#define FFMPEG_FILE_IO_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ffmpeg {
+
+enum FileIOEngineType {
+  FILE_IO_ENGINE_AUTO = 0,
+  FILE_IO_ENGINE_URING = 1,
+  FILE_IO_ENGINE_THREADS = 2,
+};
+
+// Page cache handling for written files
+enum FileIOCacheMode {
+  FILE_IO_CACHE_DEFAULT = 0,      // Leave written pages in the page cache
+  FILE_IO_CACHE_DONTNEED = 1,     // Start writeback early and drop written pages (sync_file_range + fadvise)
+  FILE_IO_CACHE_DIRECT = 2,       // Bypass the page cache (O_DIRECT / F_NOCACHE)
+};
+
+enum FileIOSyncPolicy {
+  FILE_IO_SYNC_NONE = 0,
+  FILE_IO_SYNC_CLOSE = 1,         // fdatasync before closing
+  FILE_IO_SYNC_INTERVAL = 2,      // fdatasync every sync_interval bytes and before closing
+};
+
+struct FileIOOptions {
+  FileIOEngineType engine = FILE_IO_ENGINE_AUTO;
+  int queue_depth = 8;            // Buffers in flight (readahead depth / pending writes)
+  int block_size = 256 * 1024;    // Bytes per request
+  FileIOCacheMode cache = FILE_IO_CACHE_DEFAULT;
+  FileIOSyncPolicy sync = FILE_IO_SYNC_NONE;
+  int64_t sync_interval = 0;
+  int alignment = 4096;           // O_DIRECT offset/length/buffer alignment
+};
+
+// Log2 latency histogram: bucket 0 counts < 1us, bucket i counts [2^(i-1), 2^i) us
+constexpr int kFileIOLatencyBuckets = 24;
+using FileIOLatencyHistogram = std::array<uint64_t, kFileIOLatencyBuckets>;
+
+struct FileIOStats {
+  uint64_t bytes_read = 0;        // Bytes handed to FFmpeg
+  uint64_t bytes_written = 0;     // Bytes accepted from FFmpeg
+  uint64_t read_ops = 0;          // Read requests submitted to the engine
+  uint64_t write_ops = 0;         // Write requests submitted to the engine
+  uint64_t syscalls = 0;          // I/O syscalls (io_uring_enter, pread, pwrite)
+  uint64_t waits = 0;             // Times FFmpeg had to wait for a completion
+  uint64_t max_in_flight = 0;     // Peak number of requests in flight
+  uint64_t bytes_submitted = 0;   // Bytes written to the file incl. alignment padding and rewrites
+  uint64_t rmw_reads = 0;         // Sector reads for unaligned O_DIRECT heads and tails
+  uint64_t syncs = 0;             // fdatasync calls
+  bool direct = false;            // Page cache bypassed
+  FileIOLatencyHistogram write_latency{};
+  FileIOLatencyHistogram sync_latency{};
+};
+
+/**
+ * Asynchronous request engine.
+ *
+ * Requests are queued with Submit(), handed to the kernel with Flush() (one
+ * syscall for the whole batch with io_uring) and collected with Reap().
+ * Only used from one thread at a time.
+ */
+class FileIOEngine {
+public:
+  struct Op {
+    int fd = -1;
+    bool write = false;
+    uint8_t* data = nullptr;
+    size_t length = 0;
+    int64_t offset = 0;
+    int64_t result = 0;           // Bytes transferred or negative AVERROR
+    int tag = 0;
+    int64_t submitted_at = 0;     // Steady clock, ns
+  };
+
+  virtual ~FileIOEngine() = default;
+
+  virtual const char* Name() const = 0;
+  virtual int Submit(Op* op) = 0;
+  virtual int Flush() = 0;
+  // Returns a completed op, nullptr if none is ready and wait is false
+  virtual Op* Reap(bool wait) = 0;
+
+  uint64_t Syscalls() const { return syscalls_.load(std::memory_order_relaxed); }
+
+  static std::unique_ptr<FileIOEngine> Create(FileIOEngineType type, unsigned depth, int* error);
+
+protected:
+  std::atomic<uint64_t> syscalls_{0};
+};
+
+/**
+ * Local file backend for custom AVIOContexts.
+ *
+ * Reads keep `queue_depth` blocks of readahead in flight and serve FFmpeg
+ * from completed blocks. Writes are coalesced into blocks that are written
+ * asynchronously; a block is recycled once its completion arrives, so at
+ * most `queue_depth` blocks are pending. Writes that overlap pending ones
+ * (muxers rewriting headers) wait for those to finish first.
+ *
+ * Uses io_uring on Linux and a pread/pwrite worker thread elsewhere or
+ * when io_uring is unavailable (old kernels, seccomp).
+ *
+ * Written files can keep out of the page cache: with O_DIRECT blocks are
+ * aligned, unaligned heads and tails are completed from the file
+ * (read-modify-write) and the file is truncated to its real size on close.
+ */
+class FileIO {
+public:
+  ~FileIO();
+
+  static int Open(const std::string& path, bool write, const FileIOOptions& options, std::unique_ptr<FileIO>* out);
+
+  int Read(uint8_t* buf, int size);
+  int Write(const uint8_t* buf, int size);
+  int64_t Seek(int64_t offset, int whence);
+  int Close();
+
+  const char* EngineName() const;
+  FileIOStats GetStats() const;
+
+  // AVIOContext callbacks, opaque is the FileIO
+  static int ReadPacket(void* opaque, uint8_t* buf, int buf_size);
+  static int WritePacket(void* opaque, const uint8_t* buf, int buf_size);
+  static int64_t SeekPacket(void* opaque, int64_t offset, int whence);
+
+private:
+  enum BlockState { BLOCK_FREE, BLOCK_FILLING, BLOCK_PENDING, BLOCK_READY, BLOCK_DISCARDED };
+
+  struct Block {
+    FileIOEngine::Op op;
+    uint8_t* data = nullptr;
+    size_t length = 0;            // Valid bytes (write) / requested bytes (read)
+    size_t consumed = 0;          // Bytes already handed to FFmpeg (read)
+    BlockState state = BLOCK_FREE;
+  };
+
+  FileIO() = default;
+
+  int AcquireBlock();
+  int SubmitBlock(int index);
+  int ReapOne(bool wait);
+  int Drain();
+  void FillReadahead();
+  void DropWindow();
+  int64_t FileSize();
+  int LoadSector(int64_t sector, uint8_t* dst, size_t from, size_t to);
+  int PadBlock(Block& block);
+  void AfterWrite(int64_t offset, size_t length);
+  void ReleaseWriteback(size_t keep);
+  int Sync();
+
+  int fd_ = -1;
+  bool write_ = false;
+  size_t block_size_ = 0;
+  std::unique_ptr<FileIOEngine> engine_;
+  std::vector<Block> blocks_;
+
+  // Read state
+  std::deque<int> window_;        // Readahead blocks in file order
+  int64_t next_offset_ = 0;       // Offset of the next readahead request
+  int64_t eof_offset_ = -1;       // File end seen by a short read
+
+  // Write state
+  int filling_ = -1;              // Block currently being coalesced into
+  int64_t submitted_end_ = 0;     // Highest end offset of all submitted writes
+  int64_t written_end_ = 0;       // Highest end offset written by FFmpeg
+
+  // Page cache / durability
+  FileIOCacheMode cache_ = FILE_IO_CACHE_DEFAULT;
+  bool aligned_ = false;          // O_DIRECT: offsets, lengths and buffers aligned
+  size_t alignment_ = 1;
+  uint8_t* sector_ = nullptr;     // Scratch sector for read-modify-write
+  std::deque<std::pair<int64_t, size_t>> writeback_;  // Written ranges not yet dropped from the cache
+  FileIOSyncPolicy sync_ = FILE_IO_SYNC_NONE;
+  int64_t sync_interval_ = 0;
+  int64_t unsynced_ = 0;
+  size_t queue_depth_ = 0;
+
+  int64_t pos_ = 0;
+  int in_flight_ = 0;
+  int error_ = 0;
+  FileIOStats stats_;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_FILE_IO_H
@@ -6,6 +6,9 @@
 #include "input_format.h"
 #include "output_format.h"
 #include "io_context.h"
+#include "packet_allocator.h"
+#include "packet_trace.h"
+#include "read_pacer.h"
 #include "common.h"
 #include <napi.h>
 #include <memory>
@@ -27,10 +30,16 @@ Napi::Object FormatContext::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&FormatContext::CloseOutputSync>("closeOutputSync"),
     InstanceMethod<&FormatContext::OpenInputAsync>("openInput"),
     InstanceMethod<&FormatContext::OpenInputSync>("openInputSync"),
+    InstanceMethod<&FormatContext::OpenTraceAsync>("openTrace"),
+    InstanceMethod<&FormatContext::OpenTraceSync>("openTraceSync"),
     InstanceMethod<&FormatContext::FindStreamInfoAsync>("findStreamInfo"),
     InstanceMethod<&FormatContext::FindStreamInfoSync>("findStreamInfoSync"),
     InstanceMethod<&FormatContext::ReadFrameAsync>("readFrame"),
     InstanceMethod<&FormatContext::ReadFrameSync>("readFrameSync"),
+    InstanceMethod<&FormatContext::SetPacketAllocator>("setPacketAllocator"),
+    InstanceMethod<&FormatContext::SetPacketRecorder>("setPacketRecorder"),
+    InstanceMethod<&FormatContext::SetReadRate>("setReadRate"),
+    InstanceMethod<&FormatContext::GetReadRateStats>("getReadRateStats"),
     InstanceMethod<&FormatContext::SeekFrameAsync>("seekFrame"),
     InstanceMethod<&FormatContext::SeekFrameSync>("seekFrameSync"),
     InstanceMethod<&FormatContext::SeekFileAsync>("seekFile"),
@@ -106,6 +115,76 @@ FormatContext::~FormatContext() {
   }
 }
 
+// === Native access ===
+
+int FormatContext::ReadPacket(AVPacket* packet) {
+  if (!ctx_) {
+    return AVERROR(EINVAL);
+  }
+
+  // The JS thread may replace the hooks meanwhile, the copies keep them alive for this read
+  std::shared_ptr<PacketTraceReader> trace;
+  std::shared_ptr<ReadPacer> pacer;
+  std::shared_ptr<PacketAllocatorState> allocator;
+  std::shared_ptr<PacketTraceWriter> recorder;
+  {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    trace = trace_;
+    pacer = read_pacer_;
+    allocator = packet_allocator_;
+    recorder = packet_recorder_;
+  }
+
+  // av_read_frame, or the next packet of an open trace
+  int result = trace ? trace->Read(packet) : av_read_frame(ctx_, packet);
+  if (result >= 0 && pacer) {
+    // Blocks the calling thread until the packet is due
+    result = pacer->Wait(ctx_, packet);
+    if (result < 0) {
+      av_packet_unref(packet);
+    }
+  }
+  if (result >= 0 && allocator) {
+    PacketAllocatorState::Adopt(allocator, packet);
+  }
+  if (result >= 0 && recorder) {
+    recorder->Write(ctx_, packet);
+  }
+  return result;
+}
+
+int FormatContext::CheckInterrupt(void* opaque) {
+  return static_cast<FormatContext*>(opaque)->interrupt_reads_.load() ? 1 : 0;
+}
+
+void FormatContext::InstallInterruptCallback(AVFormatContext* ctx) {
+  // Protocols copy the callback when they are opened, so it has to be set before opening
+  ctx->interrupt_callback.callback = &FormatContext::CheckInterrupt;
+  ctx->interrupt_callback.opaque = this;
+}
+
+void FormatContext::InterruptReads() {
+  interrupt_reads_ = true;
+  std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+  if (trace_) {
+    trace_->Interrupt();
+  }
+  if (read_pacer_) {
+    read_pacer_->Interrupt();
+  }
+}
+
+void FormatContext::ResumeReads() {
+  interrupt_reads_ = false;
+  std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+  if (trace_) {
+    trace_->Resume();
+  }
+  if (read_pacer_) {
+    read_pacer_->Resume();
+  }
+}
+
 // === Methods ===
 
 Napi::Value FormatContext::AllocContext(const Napi::CallbackInfo& info) {
@@ -119,6 +198,7 @@ Napi::Value FormatContext::AllocContext(const Napi::CallbackInfo& info) {
   
   ctx_ = new_ctx;
   is_output_ = false;
+  InstallInterruptCallback(ctx_);
   
   return env.Undefined();
 }
@@ -181,6 +261,12 @@ Napi::Value FormatContext::FreeContext(const Napi::CallbackInfo& info) {
   
   AVFormatContext* ctx = ctx_;
   ctx_ = nullptr;
+  header_written_ = false;
+  {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    trace_.reset();
+    read_pacer_.reset();
+  }
   
   if (!ctx) {
     // Already freed
@@ -270,6 +356,135 @@ Napi::Value FormatContext::DumpFormat(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
+Napi::Value FormatContext::SetPacketAllocator(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    packet_allocator_.reset();
+    return env.Undefined();
+  }
+
+  PacketAllocator* allocator = UnwrapNativeObject<PacketAllocator>(env, info[0], "PacketAllocator");
+  if (!allocator || !allocator->GetState()) {
+    Napi::TypeError::New(env, "Invalid or unallocated packet allocator").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Demuxers have no allocation hook, small packets are moved into slab memory after reading
+  std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+  packet_allocator_ = allocator->GetState();
+  return env.Undefined();
+}
+
+Napi::Value FormatContext::SetPacketRecorder(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    packet_recorder_.reset();
+    return Napi::Number::New(env, 0);
+  }
+
+  PacketRecorder* recorder = UnwrapNativeObject<PacketRecorder>(env, info[0], "PacketRecorder");
+  std::shared_ptr<PacketTraceWriter> writer = recorder ? recorder->GetWriter() : nullptr;
+  if (!writer || !writer->IsOpen()) {
+    Napi::TypeError::New(env, "Invalid or closed packet recorder").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (is_output_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  // Streams known now are written up front, later ones before their first packet
+  int ret = ctx_ ? writer->AddStreams(ctx_) : 0;
+  if (ret < 0) {
+    return Napi::Number::New(env, ret);
+  }
+
+  std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+  packet_recorder_ = writer;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FormatContext::SetReadRate(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || info[0].IsNull() || info[0].IsUndefined()) {
+    // A native read already waiting keeps its copy and finishes on the old schedule
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    read_pacer_.reset();
+    return Napi::Number::New(env, 0);
+  }
+
+  ReadRateOptions options;
+  if (info[0].IsObject()) {
+    Napi::Object obj = info[0].As<Napi::Object>();
+    if (obj.Has("rate") && obj.Get("rate").IsNumber()) {
+      options.rate = obj.Get("rate").As<Napi::Number>().DoubleValue();
+    }
+    if (obj.Has("initialBurst") && obj.Get("initialBurst").IsNumber()) {
+      options.initial_burst = static_cast<int64_t>(obj.Get("initialBurst").As<Napi::Number>().DoubleValue() * 1000000.0);
+    }
+    if (obj.Has("catchup") && obj.Get("catchup").IsString()) {
+      std::string catchup = obj.Get("catchup").As<Napi::String>().Utf8Value();
+      if (catchup == "burst") {
+        options.catchup = ReadRateCatchup::kBurst;
+      } else if (catchup == "rate") {
+        options.catchup = ReadRateCatchup::kRate;
+      } else if (catchup == "reset") {
+        options.catchup = ReadRateCatchup::kReset;
+      } else {
+        return Napi::Number::New(env, AVERROR(EINVAL));
+      }
+    }
+    if (obj.Has("catchupRate") && obj.Get("catchupRate").IsNumber()) {
+      options.catchup_rate = obj.Get("catchupRate").As<Napi::Number>().DoubleValue();
+    }
+    if (obj.Has("maxLag") && obj.Get("maxLag").IsNumber()) {
+      options.max_lag = static_cast<int64_t>(obj.Get("maxLag").As<Napi::Number>().DoubleValue() * 1000000.0);
+    }
+  }
+
+  if (!(options.rate > 0) || options.initial_burst < 0 || options.max_lag < 0) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  if (options.catchup_rate < options.rate) {
+    // Catching up slower than the nominal rate would never catch up
+    options.catchup_rate = options.rate;
+  }
+
+  if (is_output_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  auto pacer = std::make_shared<ReadPacer>(options);
+  std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+  read_pacer_ = std::move(pacer);
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FormatContext::GetReadRateStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!read_pacer_) {
+    return env.Null();
+  }
+
+  ReadRateStats stats = read_pacer_->GetStats();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("packets", Napi::Number::New(env, static_cast<double>(stats.packets)));
+  result.Set("waits", Napi::Number::New(env, static_cast<double>(stats.waits)));
+  result.Set("latePackets", Napi::Number::New(env, static_cast<double>(stats.late_packets)));
+  result.Set("resets", Napi::Number::New(env, static_cast<double>(stats.resets)));
+  result.Set("waitTime", Napi::Number::New(env, static_cast<double>(stats.wait_time) / 1000.0));
+  result.Set("maxLateness", Napi::Number::New(env, static_cast<double>(stats.max_lateness) / 1000.0));
+  result.Set("avgLateness", Napi::Number::New(env, stats.late_packets ? static_cast<double>(stats.total_lateness) / stats.late_packets / 1000.0 : 0.0));
+  result.Set("lag", Napi::Number::New(env, static_cast<double>(stats.lag) / 1000.0));
+  return result;
+}
+
 Napi::Value FormatContext::FindBestStream(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
@@ -3,6 +3,7 @@
 
 #include <napi.h>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <memory>
 #include "common.h"
@@ -13,6 +14,11 @@ extern "C" {
 
 namespace ffmpeg {
 
+struct PacketAllocatorState;
+class PacketTraceReader;
+class PacketTraceWriter;
+class ReadPacer;
+
 class FormatContext : public Napi::ObjectWrap<FormatContext> {
 public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
@@ -23,9 +29,30 @@ public:
   const AVFormatContext* Get() const { return ctx_; }
   bool IsOutput() const { return is_output_; }
 
+  // Reads the next packet like readFrame() (trace, pacing, allocator and recorder included)
+  int ReadPacket(AVPacket* packet);
+
+  // Aborts a read blocked in network I/O, read pacing or a trace (native readers such as PacketRouter)
+  void InterruptReads();
+  // Allows reads again once the interrupted reader has returned
+  void ResumeReads();
+
+  // Muxer calls are serialized with native writers (PacketRouter) through this lock
+  std::mutex& WriteMutex() { return write_mutex_; }
+  // Header written and trailer not yet - only read while holding WriteMutex()
+  bool IsHeaderWritten() const { return header_written_; }
+  // Notified (with WriteMutex()) when the header or the trailer has been written
+  std::condition_variable& HeaderCondition() { return header_cond_; }
+
+  // A native writer may hold WriteMutex() while its write waits for a JS callback,
+  // so Sync writes refuse to take the lock on the JS thread while one is attached
+  void AddNativeWriter() { native_writers_++; }
+  void RemoveNativeWriter() { native_writers_--; }
+
 private:
   friend class AVOptionWrapper;
   friend class FCOpenInputWorker;
+  friend class FCOpenTraceWorker;
   friend class FCFindStreamInfoWorker;
   friend class FCReadFrameWorker;
   friend class FCSeekFrameWorker;
@@ -42,8 +69,25 @@ private:
 
   static Napi::FunctionReference constructor;
 
+  // AVIOInterruptCB installed on input contexts, checked by demuxers and protocols
+  static int CheckInterrupt(void* opaque);
+  void InstallInterruptCallback(AVFormatContext* ctx);
+
   AVFormatContext* ctx_ = nullptr;
   bool is_output_ = false;
+  // Guards the read hooks below against native readers (ReadPacket) on other threads
+  std::mutex read_hooks_mutex_;
+  std::shared_ptr<PacketAllocatorState> packet_allocator_;
+  std::shared_ptr<PacketTraceWriter> packet_recorder_;
+  // Set while reading from a packet trace instead of a demuxer
+  std::shared_ptr<PacketTraceReader> trace_;
+  // Releases read packets at their native rate (-re)
+  std::shared_ptr<ReadPacer> read_pacer_;
+  std::mutex write_mutex_;
+  std::condition_variable header_cond_;
+  std::atomic<int> native_writers_{0};
+  bool header_written_ = false;
+  std::atomic<bool> interrupt_reads_{false};
 
   Napi::Value AllocContext(const Napi::CallbackInfo& info);
   Napi::Value AllocOutputContext2(const Napi::CallbackInfo& info);
@@ -56,6 +100,8 @@ private:
   Napi::Value CloseOutputSync(const Napi::CallbackInfo& info);
   Napi::Value OpenInputAsync(const Napi::CallbackInfo& info);
   Napi::Value OpenInputSync(const Napi::CallbackInfo& info);
+  Napi::Value OpenTraceAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenTraceSync(const Napi::CallbackInfo& info);
   Napi::Value FindStreamInfoAsync(const Napi::CallbackInfo& info);
   Napi::Value FindStreamInfoSync(const Napi::CallbackInfo& info);
   Napi::Value ReadFrameAsync(const Napi::CallbackInfo& info);
@@ -78,6 +124,10 @@ private:
   Napi::Value GetNbStreams(const Napi::CallbackInfo& info);
   Napi::Value DumpFormat(const Napi::CallbackInfo& info);
   Napi::Value FindBestStream(const Napi::CallbackInfo& info);
+  Napi::Value SetPacketAllocator(const Napi::CallbackInfo& info);
+  Napi::Value SetPacketRecorder(const Napi::CallbackInfo& info);
+  Napi::Value SetReadRate(const Napi::CallbackInfo& info);
+  Napi::Value GetReadRateStats(const Napi::CallbackInfo& info);
   Napi::Value DisposeAsync(const Napi::CallbackInfo& info);
 
   Napi::Value GetUrl(const Napi::CallbackInfo& info);
@@ -1,5 +1,8 @@
 #include "format_context.h"
 #include "packet.h"
+#include "packet_allocator.h"
+#include "packet_trace.h"
+#include "read_pacer.h"
 #include "input_format.h"
 #include "output_format.h"
 #include "dictionary.h"
@@ -39,6 +42,16 @@ public:
     if (!url_.empty() && url_ != "dummy") {
       url = url_.c_str();
     }
+
+    // Allocated here so protocols pick up the interrupt callback (freed by avformat_open_input on error)
+    if (!ctx) {
+      ctx = avformat_alloc_context();
+      if (!ctx) {
+        result_ = AVERROR(ENOMEM);
+        return;
+      }
+    }
+    parent_->InstallInterruptCallback(ctx);
     
     result_ = avformat_open_input(&ctx, url, fmt_, options_ ? &options_ : nullptr);
     
@@ -69,6 +82,63 @@ private:
   Napi::Promise::Deferred deferred_;
 };
 
+class FCOpenTraceWorker : public Napi::AsyncWorker {
+public:
+  FCOpenTraceWorker(Napi::Env env, FormatContext* parent, const std::string& path,
+                  const PacketTraceOptions& options)
+    : AsyncWorker(env),
+      parent_(parent),
+      path_(path),
+      options_(options),
+      result_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    AVFormatContext* ctx = parent_->ctx_;
+    bool allocated = false;
+    if (!ctx) {
+      ctx = avformat_alloc_context();
+      if (!ctx) {
+        result_ = AVERROR(ENOMEM);
+        return;
+      }
+      allocated = true;
+    }
+
+    std::unique_ptr<PacketTraceReader> reader;
+    result_ = PacketTraceReader::Open(path_, options_, ctx, &reader);
+    if (result_ < 0) {
+      if (allocated) {
+        avformat_free_context(ctx);
+      }
+      return;
+    }
+
+    parent_->ctx_ = ctx;
+    parent_->is_output_ = false;
+    std::lock_guard<std::mutex> lock(parent_->read_hooks_mutex_);
+    parent_->trace_ = std::move(reader);
+  }
+
+  void OnOK() override {
+    Napi::HandleScope scope(Env());
+    deferred_.Resolve(Napi::Number::New(Env(), result_));
+  }
+
+  void OnError(const Napi::Error& error) override {
+    deferred_.Reject(error.Value());
+  }
+
+  Napi::Promise GetPromise() { return deferred_.Promise(); }
+
+private:
+  FormatContext* parent_;
+  std::string path_;
+  PacketTraceOptions options_;
+  int result_;
+  Napi::Promise::Deferred deferred_;
+};
+
 class FCFindStreamInfoWorker : public Napi::AsyncWorker {
 public:
   FCFindStreamInfoWorker(Napi::Env env, FormatContext* parent, AVDictionary* options)
@@ -85,7 +155,10 @@ public:
   }
 
   void Execute() override {
-    if (parent_->ctx_) {
+    if (parent_->ctx_ && parent_->trace_) {
+      // Stream parameters come from the trace, there is no demuxer to probe
+      result_ = 0;
+    } else if (parent_->ctx_) {
       result_ = avformat_find_stream_info(parent_->ctx_, options_ ? &options_ : nullptr);
     } else {
       result_ = AVERROR(EINVAL);
@@ -116,12 +189,29 @@ public:
     : AsyncWorker(env),
       parent_(parent),
       packet_(packet),
+      allocator_(parent->packet_allocator_),
+      recorder_(parent->packet_recorder_),
+      trace_(parent->trace_),
+      pacer_(parent->read_pacer_),
       result_(0),
       deferred_(Napi::Promise::Deferred::New(env)) {}
 
   void Execute() override {
     if (parent_->ctx_ && packet_) {
-      result_ = av_read_frame(parent_->ctx_, packet_->Get());
+      result_ = trace_ ? trace_->Read(packet_->Get()) : av_read_frame(parent_->ctx_, packet_->Get());
+      if (result_ >= 0 && pacer_) {
+        result_ = pacer_->Wait(parent_->ctx_, packet_->Get());
+        if (result_ < 0) {
+          av_packet_unref(packet_->Get());
+        }
+      }
+      if (result_ >= 0 && allocator_) {
+        PacketAllocatorState::Adopt(allocator_, packet_->Get());
+      }
+      if (result_ >= 0 && recorder_) {
+        // A failing capture must not break the input, the error stays on the recorder
+        recorder_->Write(parent_->ctx_, packet_->Get());
+      }
     } else {
       result_ = AVERROR(EINVAL);
     }
@@ -141,6 +231,10 @@ public:
 private:
   FormatContext* parent_;
   Packet* packet_;
+  std::shared_ptr<PacketAllocatorState> allocator_;
+  std::shared_ptr<PacketTraceWriter> recorder_;
+  std::shared_ptr<PacketTraceReader> trace_;
+  std::shared_ptr<ReadPacer> pacer_;
   int result_;
   Napi::Promise::Deferred deferred_;
 };
@@ -154,15 +248,22 @@ public:
       stream_index_(stream_index),
       timestamp_(timestamp),
       flags_(flags),
+      trace_(parent->trace_),
+      pacer_(parent->read_pacer_),
       result_(0),
       deferred_(Napi::Promise::Deferred::New(env)) {}
 
   void Execute() override {
-    if (parent_->ctx_) {
+    if (parent_->ctx_ && trace_) {
+      result_ = trace_->Seek(parent_->ctx_, stream_index_, timestamp_, flags_);
+    } else if (parent_->ctx_) {
       result_ = av_seek_frame(parent_->ctx_, stream_index_, timestamp_, flags_);
     } else {
       result_ = AVERROR(EINVAL);
     }
+    if (result_ >= 0 && pacer_) {
+      pacer_->Reset();
+    }
   }
 
   void OnOK() override {
@@ -181,6 +282,8 @@ private:
   int stream_index_;
   int64_t timestamp_;
   int flags_;
+  std::shared_ptr<PacketTraceReader> trace_;
+  std::shared_ptr<ReadPacer> pacer_;
   int result_;
   Napi::Promise::Deferred deferred_;
 };
@@ -196,16 +299,26 @@ public:
       ts_(ts),
       max_ts_(max_ts),
       flags_(flags),
+      trace_(parent->trace_),
+      pacer_(parent->read_pacer_),
       result_(0),
       deferred_(Napi::Promise::Deferred::New(env)) {}
 
   void Execute() override {
-    if (parent_->ctx_) {
+    if (parent_->ctx_ && trace_) {
+      // Same direction choice as avformat_seek_file() for demuxers without read_seek2
+      uint64_t ts = static_cast<uint64_t>(ts_);
+      int dir = ts - static_cast<uint64_t>(min_ts_) > static_cast<uint64_t>(max_ts_) - ts ? AVSEEK_FLAG_BACKWARD : 0;
+      result_ = trace_->Seek(parent_->ctx_, stream_index_, ts_, (flags_ & ~AVSEEK_FLAG_BACKWARD) | dir);
+    } else if (parent_->ctx_) {
       result_ = avformat_seek_file(parent_->ctx_, stream_index_, 
                                    min_ts_, ts_, max_ts_, flags_);
     } else {
       result_ = AVERROR(EINVAL);
     }
+    if (result_ >= 0 && pacer_) {
+      pacer_->Reset();
+    }
   }
 
   void OnOK() override {
@@ -226,6 +339,8 @@ private:
   int64_t ts_;
   int64_t max_ts_;
   int flags_;
+  std::shared_ptr<PacketTraceReader> trace_;
+  std::shared_ptr<ReadPacer> pacer_;
   int result_;
   Napi::Promise::Deferred deferred_;
 };
@@ -260,7 +375,10 @@ public:
         }
       }
       
+      std::lock_guard<std::mutex> lock(parent_->write_mutex_);
       result_ = avformat_write_header(ctx, options_ ? &options_ : nullptr);
+      parent_->header_written_ = result_ >= 0;
+      parent_->header_cond_.notify_all();
     } else {
       result_ = AVERROR(EINVAL);
     }
@@ -295,6 +413,7 @@ public:
 
   void Execute() override {
     if (parent_->ctx_) {
+      std::lock_guard<std::mutex> lock(parent_->write_mutex_);
       result_ = av_write_frame(parent_->ctx_, packet_ ? packet_->Get() : nullptr);
     } else {
       result_ = AVERROR(EINVAL);
@@ -330,6 +449,7 @@ public:
 
   void Execute() override {
     if (parent_->ctx_) {
+      std::lock_guard<std::mutex> lock(parent_->write_mutex_);
       result_ = av_interleaved_write_frame(parent_->ctx_, packet_ ? packet_->Get() : nullptr);
     } else {
       result_ = AVERROR(EINVAL);
@@ -364,7 +484,10 @@ public:
 
   void Execute() override {
     if (parent_->ctx_) {
+      std::lock_guard<std::mutex> lock(parent_->write_mutex_);
       result_ = av_write_trailer(parent_->ctx_);
+      parent_->header_written_ = false;
+      parent_->header_cond_.notify_all();
     } else {
       result_ = AVERROR(EINVAL);
     }
@@ -476,6 +599,11 @@ public:
   void Execute() override {
     AVFormatContext* ctx = parent_->ctx_;
     parent_->ctx_ = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(parent_->read_hooks_mutex_);
+      parent_->trace_.reset();
+      parent_->read_pacer_.reset();
+    }
     
     if (ctx) {
       // Check if this is a custom IO context
@@ -580,6 +708,29 @@ Napi::Value FormatContext::OpenInputAsync(const Napi::CallbackInfo& info) {
   return promise;
 }
 
+Napi::Value FormatContext::OpenTraceAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Trace file path required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (is_output_ || trace_ || (ctx_ && ctx_->nb_streams > 0)) {
+    Napi::Error::New(env, "Format context already in use").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  PacketTraceOptions options = ParsePacketTraceOptions(info.Length() > 1 ? info[1] : env.Undefined());
+
+  auto* worker = new FCOpenTraceWorker(env, this, path, options);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
 Napi::Value FormatContext::FindStreamInfoAsync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
@@ -772,6 +923,14 @@ Napi::Value FormatContext::CloseInputAsync(const Napi::CallbackInfo& info) {
   if (!ctx_) {
     return env.Null();
   }
+
+  // Don't wait out a paced read still in flight
+  if (trace_) {
+    trace_->Interrupt();
+  }
+  if (read_pacer_) {
+    read_pacer_->Interrupt();
+  }
   
   auto* worker = new FCCloseInputWorker(env, this);
   worker->Queue();
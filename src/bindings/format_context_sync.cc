@@ -1,5 +1,8 @@
 #include "format_context.h"
 #include "packet.h"
+#include "packet_allocator.h"
+#include "packet_trace.h"
+#include "read_pacer.h"
 #include "input_format.h"
 #include "dictionary.h"
 #include "common.h"
@@ -30,8 +33,7 @@ Napi::Value FormatContext::ReadFrameSync(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
-  // Direct synchronous call to av_read_frame
-  int result = av_read_frame(ctx_, packet->Get());
+  int result = ReadPacket(packet->Get());
 
   return Napi::Number::New(env, result);
 }
@@ -49,7 +51,13 @@ Napi::Value FormatContext::WriteFrameSync(const Napi::CallbackInfo& info) {
     packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
   }
 
+  // A native writer may hold the muxer while waiting for a JS callback write - would deadlock
+  if (native_writers_ > 0) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
   // Direct synchronous call to av_write_frame
+  std::lock_guard<std::mutex> lock(write_mutex_);
   int result = av_write_frame(ctx_, packet ? packet->Get() : nullptr);
 
   return Napi::Number::New(env, result);
@@ -68,7 +76,13 @@ Napi::Value FormatContext::InterleavedWriteFrameSync(const Napi::CallbackInfo& i
     packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
   }
 
+  // A native writer may hold the muxer while waiting for a JS callback write - would deadlock
+  if (native_writers_ > 0) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
   // Direct synchronous call to av_interleaved_write_frame
+  std::lock_guard<std::mutex> lock(write_mutex_);
   int result = av_interleaved_write_frame(ctx_, packet ? packet->Get() : nullptr);
 
   return Napi::Number::New(env, result);
@@ -105,6 +119,18 @@ Napi::Value FormatContext::OpenInputSync(const Napi::CallbackInfo& info) {
   // If we already have a context (e.g., for custom I/O), preserve it
   AVFormatContext* ctx = ctx_;
 
+  // Allocated here so protocols pick up the interrupt callback (freed by avformat_open_input on error)
+  if (!ctx) {
+    ctx = avformat_alloc_context();
+    if (!ctx) {
+      if (options) {
+        av_dict_free(&options);
+      }
+      return Napi::Number::New(env, AVERROR(ENOMEM));
+    }
+  }
+  InstallInterruptCallback(ctx);
+
   // Direct synchronous call
   const char* urlPtr = url.empty() || url == "dummy" ? nullptr : url.c_str();
   int ret = avformat_open_input(&ctx, urlPtr, fmt, options ? &options : nullptr);
@@ -122,6 +148,49 @@ Napi::Value FormatContext::OpenInputSync(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, ret);
 }
 
+Napi::Value FormatContext::OpenTraceSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Trace file path required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (is_output_ || trace_ || (ctx_ && ctx_->nb_streams > 0)) {
+    Napi::Error::New(env, "Format context already in use").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string path = info[0].As<Napi::String>().Utf8Value();
+  PacketTraceOptions options = ParsePacketTraceOptions(info.Length() > 1 ? info[1] : env.Undefined());
+
+  AVFormatContext* ctx = ctx_;
+  if (!ctx) {
+    ctx = avformat_alloc_context();
+    if (!ctx) {
+      return Napi::Number::New(env, AVERROR(ENOMEM));
+    }
+  }
+
+  std::unique_ptr<PacketTraceReader> reader;
+  int ret = PacketTraceReader::Open(path, options, ctx, &reader);
+  if (ret < 0) {
+    if (ctx != ctx_) {
+      avformat_free_context(ctx);
+    }
+    return Napi::Number::New(env, ret);
+  }
+
+  ctx_ = ctx;
+  is_output_ = false;
+  {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    trace_ = std::move(reader);
+  }
+
+  return Napi::Number::New(env, 0);
+}
+
 Napi::Value FormatContext::FindStreamInfoSync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -130,6 +199,11 @@ Napi::Value FormatContext::FindStreamInfoSync(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, AVERROR(EINVAL));
   }
 
+  if (trace_) {
+    // Stream parameters come from the trace, there is no demuxer to probe
+    return Napi::Number::New(env, 0);
+  }
+
   AVDictionary* options = nullptr;
 
   // Parse options argument
@@ -170,7 +244,10 @@ Napi::Value FormatContext::SeekFrameSync(const Napi::CallbackInfo& info) {
   int flags = info[2].As<Napi::Number>().Int32Value();
 
   // Direct synchronous call
-  int ret = av_seek_frame(ctx_, stream_index, timestamp, flags);
+  int ret = trace_ ? trace_->Seek(ctx_, stream_index, timestamp, flags) : av_seek_frame(ctx_, stream_index, timestamp, flags);
+  if (ret >= 0 && read_pacer_) {
+    read_pacer_->Reset();
+  }
 
   return Napi::Number::New(env, ret);
 }
@@ -188,6 +265,11 @@ Napi::Value FormatContext::WriteHeaderSync(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, AVERROR(EINVAL));
   }
 
+  // A native writer may hold the muxer while waiting for a JS callback write - would deadlock
+  if (native_writers_ > 0) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
   AVDictionary* options = nullptr;
 
   // Parse options argument
@@ -199,7 +281,13 @@ Napi::Value FormatContext::WriteHeaderSync(const Napi::CallbackInfo& info) {
   }
 
   // Direct synchronous call
-  int ret = avformat_write_header(ctx_, options ? &options : nullptr);
+  int ret;
+  {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    ret = avformat_write_header(ctx_, options ? &options : nullptr);
+    header_written_ = ret >= 0;
+    header_cond_.notify_all();
+  }
 
   // Clean up options if any remain
   if (options) {
@@ -222,8 +310,16 @@ Napi::Value FormatContext::WriteTrailerSync(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, AVERROR(EINVAL));
   }
 
+  // A native writer may hold the muxer while waiting for a JS callback write - would deadlock
+  if (native_writers_ > 0) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
   // Direct synchronous call
+  std::lock_guard<std::mutex> lock(write_mutex_);
   int ret = av_write_trailer(ctx_);
+  header_written_ = false;
+  header_cond_.notify_all();
 
   return Napi::Number::New(env, ret);
 }
@@ -243,6 +339,11 @@ Napi::Value FormatContext::CloseInputSync(const Napi::CallbackInfo& info) {
   // Direct synchronous call
   avformat_close_input(&ctx_);
   ctx_ = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(read_hooks_mutex_);
+    trace_.reset();
+    read_pacer_.reset();
+  }
 
   return env.Undefined();
 }
@@ -1,10 +1,73 @@
 #include "frame.h"
 #include "hardware_frames_context.h"
 
+#include <cstring>
+
 namespace ffmpeg {
 
 Napi::FunctionReference Frame::constructor;
 
+// Buffers wrapping JS memory may be released by FFmpeg worker threads
+// (encoders, filters), JS references can only be dropped on the JS thread of
+// the environment that created them. Every environment loading the addon
+// (main thread, worker threads) gets its own release context.
+std::mutex Frame::js_release_mutex_;
+std::map<napi_env, std::shared_ptr<Frame::JSReleaseContext>> Frame::js_release_contexts_;
+
+std::shared_ptr<Frame::JSReleaseContext> Frame::FindJSReleaseContext(napi_env env) {
+  std::lock_guard<std::mutex> lock(js_release_mutex_);
+  auto it = js_release_contexts_.find(env);
+  return it != js_release_contexts_.end() ? it->second : nullptr;
+}
+
+// Environment cleanup hook: buffers released later leak their (already dead) reference
+void Frame::CloseJSReleaseContext(void* arg) {
+  napi_env env = static_cast<napi_env>(arg);
+  std::shared_ptr<JSReleaseContext> context;
+  {
+    std::lock_guard<std::mutex> lock(js_release_mutex_);
+    auto it = js_release_contexts_.find(env);
+    if (it == js_release_contexts_.end()) {
+      return;
+    }
+    context = it->second;
+    js_release_contexts_.erase(it);
+  }
+
+  std::lock_guard<std::mutex> lock(context->mutex);
+  context->closed = true;
+  context->tsfn.Release();
+}
+
+void Frame::ReleaseJSBuffer(void* opaque, uint8_t* data) {
+  auto* hold = static_cast<JSBufferHold*>(opaque);
+  std::shared_ptr<JSReleaseContext> owner = hold->owner;
+
+  std::lock_guard<std::mutex> lock(owner->mutex);
+  if (owner->closed) {
+    hold->ref.SuppressDestruct();
+    delete hold;
+    return;
+  }
+
+  if (std::this_thread::get_id() == owner->js_thread_id) {
+    delete hold;
+    return;
+  }
+
+  napi_status status = owner->tsfn.NonBlockingCall(hold, [](Napi::Env env, Napi::Function, JSBufferHold* pending) {
+    // Without an environment the function is being torn down with the environment
+    if (static_cast<napi_env>(env) == nullptr) {
+      pending->ref.SuppressDestruct();
+    }
+    delete pending;
+  });
+  if (status != napi_ok) {
+    hold->ref.SuppressDestruct();
+    delete hold;
+  }
+}
+
 Napi::Object Frame::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "Frame", {
     InstanceMethod<&Frame::Alloc>("alloc"),
@@ -19,6 +82,7 @@ Napi::Object Frame::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&Frame::Copy>("copy"),
     InstanceMethod<&Frame::FromBuffer>("fromBuffer"),
     InstanceMethod<&Frame::ToBuffer>("toBuffer"),
+    InstanceMethod<&Frame::ImportBuffer>("importBuffer"),
     InstanceMethod<&Frame::HwframeTransferDataAsync>("hwframeTransferData"),
     InstanceMethod<&Frame::HwframeTransferDataSync>("hwframeTransferDataSync"),
     InstanceMethod<&Frame::IsHwFrame>("isHwFrame"),
@@ -56,6 +120,23 @@ Napi::Object Frame::Init(Napi::Env env, Napi::Object exports) {
   
   constructor = Napi::Persistent(func);
   constructor.SuppressDestruct();
+
+  // Releases JS references held by imported buffers, must not keep the loop alive
+  auto release_context = std::make_shared<JSReleaseContext>();
+  release_context->js_thread_id = std::this_thread::get_id();
+  release_context->tsfn = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "FrameBufferRelease",
+    0,
+    1
+  );
+  release_context->tsfn.Unref(env);
+  {
+    std::lock_guard<std::mutex> lock(js_release_mutex_);
+    js_release_contexts_[env] = release_context;
+  }
+  napi_add_env_cleanup_hook(env, CloseJSReleaseContext, static_cast<napi_env>(env));
   
   exports.Set("Frame", func);
   return exports;
@@ -234,6 +315,150 @@ Napi::Value Frame::Copy(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, ret);
 }
 
+bool Frame::GetJSMemory(const Napi::Value& value, uint8_t** data, size_t* size) {
+  if (value.IsBuffer()) {
+    Napi::Buffer<uint8_t> buffer = value.As<Napi::Buffer<uint8_t>>();
+    *data = buffer.Data();
+    *size = buffer.Length();
+    return true;
+  }
+  if (value.IsArrayBuffer()) {
+    Napi::ArrayBuffer buffer = value.As<Napi::ArrayBuffer>();
+    *data = static_cast<uint8_t*>(buffer.Data());
+    *size = buffer.ByteLength();
+    return true;
+  }
+  if (value.IsTypedArray()) {
+    // Query the view directly, this also works for views on a SharedArrayBuffer
+    napi_typedarray_type type;
+    size_t length = 0;
+    void* ptr = nullptr;
+    if (napi_get_typedarray_info(value.Env(), value, &type, &length, &ptr, nullptr, nullptr) != napi_ok) {
+      return false;
+    }
+    *data = static_cast<uint8_t*>(ptr);
+    *size = value.As<Napi::TypedArray>().ByteLength();
+    return true;
+  }
+  if (value.IsDataView()) {
+    Napi::DataView view = value.As<Napi::DataView>();
+    *data = static_cast<uint8_t*>(view.ArrayBuffer().Data()) + view.ByteOffset();
+    *size = view.ByteLength();
+    return true;
+  }
+  return false;
+}
+
+AVBufferRef* Frame::CreateJSBuffer(Napi::Env env, const Napi::Value& owner, uint8_t* data, size_t size) {
+  std::shared_ptr<JSReleaseContext> context = FindJSReleaseContext(env);
+  if (!context) {
+    return nullptr;
+  }
+  auto* hold = new JSBufferHold{ Napi::Persistent(owner), context };
+  AVBufferRef* buf = av_buffer_create(data, size, ReleaseJSBuffer, hold, 0);
+  if (!buf) {
+    delete hold;
+  }
+  return buf;
+}
+
+void Frame::ReleaseBuffers() {
+  for (int i = 0; i < AV_NUM_DATA_POINTERS; i++) {
+    av_buffer_unref(&frame_->buf[i]);
+  }
+  for (int i = 0; i < frame_->nb_extended_buf; i++) {
+    av_buffer_unref(&frame_->extended_buf[i]);
+  }
+  av_freep(&frame_->extended_buf);
+  frame_->nb_extended_buf = 0;
+
+  if (frame_->extended_data != frame_->data) {
+    av_freep(&frame_->extended_data);
+  }
+  frame_->extended_data = nullptr;
+  memset(frame_->data, 0, sizeof(frame_->data));
+  memset(frame_->linesize, 0, sizeof(frame_->linesize));
+}
+
+int Frame::RequiredBufferSize(int align) const {
+  if (frame_->hw_frames_ctx) {
+    return AVERROR(EINVAL);
+  }
+
+  if (frame_->width > 0 && frame_->height > 0) {
+    return av_image_get_buffer_size(static_cast<AVPixelFormat>(frame_->format), frame_->width, frame_->height, align);
+  }
+  if (frame_->nb_samples > 0) {
+    AVSampleFormat sample_fmt = static_cast<AVSampleFormat>(frame_->format);
+    int channels = frame_->ch_layout.nb_channels;
+    if (av_sample_fmt_is_planar(sample_fmt) && channels > AV_NUM_DATA_POINTERS) {
+      return AVERROR(EINVAL);
+    }
+    return av_samples_get_buffer_size(nullptr, channels, frame_->nb_samples, sample_fmt, align);
+  }
+  return AVERROR(EINVAL);
+}
+
+int Frame::AttachBuffer(AVBufferRef* buf, int align) {
+  ReleaseBuffers();
+  frame_->buf[0] = buf;
+  frame_->extended_data = frame_->data;
+
+  int ret;
+  if (frame_->width > 0 && frame_->height > 0) {
+    ret = av_image_fill_arrays(frame_->data, frame_->linesize, buf->data,
+                               static_cast<AVPixelFormat>(frame_->format), frame_->width, frame_->height, align);
+  } else {
+    ret = av_samples_fill_arrays(frame_->data, &frame_->linesize[0], buf->data, frame_->ch_layout.nb_channels,
+                                 frame_->nb_samples, static_cast<AVSampleFormat>(frame_->format), align);
+  }
+
+  if (ret < 0) {
+    ReleaseBuffers();
+    return ret;
+  }
+  return 0;
+}
+
+int Frame::AttachJSMemory(Napi::Env env, const Napi::Value& owner, uint8_t* data, size_t size, int align) {
+  int required = RequiredBufferSize(align);
+  if (required < 0) {
+    return required;
+  }
+  if (size < static_cast<size_t>(required)) {
+    return AVERROR(EINVAL);
+  }
+
+  AVBufferRef* buf = CreateJSBuffer(env, owner, data, size);
+  if (!buf) {
+    return AVERROR(ENOMEM);
+  }
+
+  return AttachBuffer(buf, align);
+}
+
+Napi::Value Frame::ImportBuffer(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!frame_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  if (info.Length() < 1 || !GetJSMemory(info[0], &data, &size)) {
+    Napi::TypeError::New(env, "Buffer, ArrayBuffer or TypedArray required").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int align = 1;
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    align = info[1].As<Napi::Number>().Int32Value();
+  }
+
+  return Napi::Number::New(env, AttachJSMemory(env, info[0], data, size, align));
+}
+
 Napi::Value Frame::FromBuffer(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
@@ -253,13 +478,10 @@ Napi::Value Frame::FromBuffer(const Napi::CallbackInfo& info) {
   
   // For video frames, copy the buffer data to frame's data planes
   if (frame_->width > 0 && frame_->height > 0) {
+    AVPixelFormat pix_fmt = static_cast<AVPixelFormat>(frame_->format);
+
     // Calculate expected size for the pixel format
-    int expected_size = av_image_get_buffer_size(
-      static_cast<AVPixelFormat>(frame_->format),
-      frame_->width,
-      frame_->height,
-      1
-    );
+    int expected_size = av_image_get_buffer_size(pix_fmt, frame_->width, frame_->height, 1);
     
     if (expected_size < 0) {
       Napi::Error::New(env, "Failed to calculate buffer size").ThrowAsJavaScriptException();
@@ -271,18 +493,28 @@ Napi::Value Frame::FromBuffer(const Napi::CallbackInfo& info) {
       return Napi::Number::New(env, AVERROR(EINVAL));
     }
     
-    // Fill frame data planes from buffer
-    int ret = av_image_fill_arrays(
-      frame_->data,
-      frame_->linesize,
-      data,
-      static_cast<AVPixelFormat>(frame_->format),
-      frame_->width,
-      frame_->height,
-      1
-    );
-    
-    return Napi::Number::New(env, ret);
+    // Without allocated buffers, reference the JS memory (kept alive until FFmpeg releases it)
+    if (!frame_->buf[0]) {
+      return Napi::Number::New(env, AttachJSMemory(env, info[0], data, size, 1));
+    }
+
+    // Copy packed planes into the frame, honoring its linesize
+    uint8_t* src_data[4];
+    int src_linesize[4];
+    int ret = av_image_fill_arrays(src_data, src_linesize, data, pix_fmt, frame_->width, frame_->height, 1);
+    if (ret < 0) {
+      return Napi::Number::New(env, ret);
+    }
+
+    // Buffers shared with other frames (ref, clone, decoder pools) are copied first
+    ret = av_frame_make_writable(frame_);
+    if (ret < 0) {
+      return Napi::Number::New(env, ret);
+    }
+
+    av_image_copy(frame_->data, frame_->linesize, (const uint8_t**)src_data, src_linesize,
+                  pix_fmt, frame_->width, frame_->height);
+    return Napi::Number::New(env, 0);
   }
   // For audio frames
   else if (frame_->nb_samples > 0) {
@@ -343,10 +575,22 @@ Napi::Value Frame::ToBuffer(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
-  // Handle video frames
-  if (frame_->width > 0 && frame_->height > 0) {
+  bool is_video = frame_->width > 0 && frame_->height > 0;
+  bool is_audio = !is_video && frame_->nb_samples > 0;
+  if (!is_video && !is_audio) {
+    // Neither video nor audio frame
+    Napi::Error::New(env, "Frame is neither video nor audio").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int channels = frame_->ch_layout.nb_channels;
+  AVSampleFormat sample_fmt = static_cast<AVSampleFormat>(frame_->format);
+  int bytes_per_sample = is_audio ? av_get_bytes_per_sample(sample_fmt) : 0;
+
+  int buffer_size;
+  if (is_video) {
     // Calculate required buffer size for video frame
-    int buffer_size = av_image_get_buffer_size(
+    buffer_size = av_image_get_buffer_size(
       static_cast<AVPixelFormat>(frame_->format),
       frame_->width,
       frame_->height,
@@ -357,16 +601,46 @@ Napi::Value Frame::ToBuffer(const Napi::CallbackInfo& info) {
       Napi::Error::New(env, "Failed to calculate buffer size for video frame").ThrowAsJavaScriptException();
       return env.Undefined();
     }
+  } else {
+    if (bytes_per_sample <= 0) {
+      Napi::Error::New(env, "Invalid sample format").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    // Planar: all channels concatenated, interleaved: already in correct format
+    buffer_size = frame_->nb_samples * bytes_per_sample * channels;
+  }
+
+  // Write into a caller-provided buffer or allocate a new one
+  bool has_target = info.Length() > 0 && !info[0].IsUndefined() && !info[0].IsNull();
+  Napi::Buffer<uint8_t> buffer;
+  uint8_t* buffer_data = nullptr;
 
+  if (has_target) {
+    size_t target_size = 0;
+    if (!GetJSMemory(info[0], &buffer_data, &target_size)) {
+      Napi::TypeError::New(env, "Target must be a Buffer, ArrayBuffer or TypedArray").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+
+    int64_t offset = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int64Value() : 0;
+    if (offset < 0 || static_cast<uint64_t>(offset) + buffer_size > target_size) {
+      Napi::RangeError::New(env, "Target buffer too small for frame data").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    buffer_data += offset;
+  } else {
     // Allocate buffer
-    Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, buffer_size);
-    uint8_t* buffer_data = buffer.Data();
+    buffer = Napi::Buffer<uint8_t>::New(env, buffer_size);
+    buffer_data = buffer.Data();
 
     if (!buffer_data) {
       Napi::Error::New(env, "Failed to allocate buffer memory").ThrowAsJavaScriptException();
       return env.Undefined();
     }
+  }
 
+  if (is_video) {
     // Copy frame data to buffer
     int ret = av_image_copy_to_buffer(
       buffer_data,
@@ -383,61 +657,25 @@ Napi::Value Frame::ToBuffer(const Napi::CallbackInfo& info) {
       Napi::Error::New(env, "Failed to copy frame data to buffer").ThrowAsJavaScriptException();
       return env.Undefined();
     }
-
-    return buffer;
-  }
-  // Handle audio frames
-  else if (frame_->nb_samples > 0) {
-    int channels = frame_->ch_layout.nb_channels;
-    AVSampleFormat sample_fmt = static_cast<AVSampleFormat>(frame_->format);
-    int bytes_per_sample = av_get_bytes_per_sample(sample_fmt);
-    bool is_planar = av_sample_fmt_is_planar(sample_fmt);
-
-    if (bytes_per_sample <= 0) {
-      Napi::Error::New(env, "Invalid sample format").ThrowAsJavaScriptException();
-      return env.Undefined();
-    }
-
-    int buffer_size;
-    if (is_planar) {
-      // Planar: all channels concatenated
-      buffer_size = frame_->nb_samples * bytes_per_sample * channels;
-    } else {
-      // Interleaved: already in correct format
-      buffer_size = frame_->nb_samples * channels * bytes_per_sample;
-    }
-
-    // Allocate buffer
-    Napi::Buffer<uint8_t> buffer = Napi::Buffer<uint8_t>::New(env, buffer_size);
-    uint8_t* buffer_data = buffer.Data();
-
-    if (!buffer_data) {
-      Napi::Error::New(env, "Failed to allocate buffer memory").ThrowAsJavaScriptException();
-      return env.Undefined();
-    }
-
-    // Copy audio data
-    if (is_planar) {
-      // Copy each channel sequentially
-      int plane_size = frame_->nb_samples * bytes_per_sample;
-      for (int ch = 0; ch < channels; ch++) {
-        if (!frame_->data[ch]) {
-          Napi::Error::New(env, "Missing audio channel data").ThrowAsJavaScriptException();
-          return env.Undefined();
-        }
-        memcpy(buffer_data + (ch * plane_size), frame_->data[ch], plane_size);
+  } else if (av_sample_fmt_is_planar(sample_fmt)) {
+    // Copy each channel sequentially
+    int plane_size = frame_->nb_samples * bytes_per_sample;
+    for (int ch = 0; ch < channels; ch++) {
+      if (!frame_->extended_data[ch]) {
+        Napi::Error::New(env, "Missing audio channel data").ThrowAsJavaScriptException();
+        return env.Undefined();
       }
-    } else {
-      // Copy interleaved data directly
-      memcpy(buffer_data, frame_->data[0], buffer_size);
+      memcpy(buffer_data + (ch * plane_size), frame_->extended_data[ch], plane_size);
     }
-
-    return buffer;
+  } else {
+    // Copy interleaved data directly
+    memcpy(buffer_data, frame_->data[0], buffer_size);
   }
 
-  // Neither video nor audio frame
-  Napi::Error::New(env, "Frame is neither video nor audio").ThrowAsJavaScriptException();
-  return env.Undefined();
+  if (has_target) {
+    return Napi::Number::New(env, buffer_size);
+  }
+  return buffer;
 }
 
 Napi::Value Frame::GetFormat(const Napi::CallbackInfo& info) {
@@ -4,6 +4,11 @@
 #include <napi.h>
 #include "common.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 extern "C" {
 #include <libavutil/frame.h>
 #include <libavutil/pixdesc.h>
@@ -21,14 +26,44 @@ public:
 
   AVFrame* Get() { return frame_; }
 
+  // Wrap JS-owned memory in an AVBufferRef that keeps the JS value alive until released
+  static AVBufferRef* CreateJSBuffer(Napi::Env env, const Napi::Value& owner, uint8_t* data, size_t size);
+  static bool GetJSMemory(const Napi::Value& value, uint8_t** data, size_t* size);
+
+  // Replace the frame buffers with buf (takes ownership) and point the planes into it
+  int AttachBuffer(AVBufferRef* buf, int align);
+  // Buffer size needed for the configured format and dimensions/samples, or negative AVERROR
+  int RequiredBufferSize(int align) const;
+
 private:
   friend class HwframeTransferDataWorker;
 
+  // Releases JS references of one environment (main thread or worker), outlives it
+  struct JSReleaseContext {
+    std::thread::id js_thread_id;
+    Napi::ThreadSafeFunction tsfn;
+    std::mutex mutex;
+    bool closed = false;
+  };
+
+  struct JSBufferHold {
+    Napi::Reference<Napi::Value> ref;
+    std::shared_ptr<JSReleaseContext> owner;
+  };
+
   static Napi::FunctionReference constructor;
 
   AVFrame* frame_ = nullptr;
   bool is_freed_ = false;
 
+  static void ReleaseJSBuffer(void* opaque, uint8_t* data);
+  static std::mutex js_release_mutex_;
+  static std::map<napi_env, std::shared_ptr<JSReleaseContext>> js_release_contexts_;
+  static void CloseJSReleaseContext(void* arg);
+  static std::shared_ptr<JSReleaseContext> FindJSReleaseContext(napi_env env);
+  void ReleaseBuffers();
+  int AttachJSMemory(Napi::Env env, const Napi::Value& owner, uint8_t* data, size_t size, int align);
+
   Napi::Value Alloc(const Napi::CallbackInfo& info);
   Napi::Value Free(const Napi::CallbackInfo& info);
   Napi::Value Ref(const Napi::CallbackInfo& info);
@@ -41,6 +76,7 @@ private:
   Napi::Value Copy(const Napi::CallbackInfo& info);
   Napi::Value FromBuffer(const Napi::CallbackInfo& info);
   Napi::Value ToBuffer(const Napi::CallbackInfo& info);
+  Napi::Value ImportBuffer(const Napi::CallbackInfo& info);
   Napi::Value HwframeTransferDataAsync(const Napi::CallbackInfo& info);
   Napi::Value HwframeTransferDataSync(const Napi::CallbackInfo& info);
   Napi::Value IsHwFrame(const Napi::CallbackInfo& info);
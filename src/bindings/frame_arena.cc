@@ -0,0 +1,374 @@
+#include "frame_arena.h"
+#include "frame.h"
+
+extern "C" {
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace ffmpeg {
+
+// === Arena state ===
+
+FrameArenaState::~FrameArenaState() {
+  // Drops the reference to the JS memory
+  av_buffer_unref(&backing);
+}
+
+int FrameArenaState::Acquire() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < in_use.size(); i++) {
+    if (!in_use[i] && !pinned[i]) {
+      in_use[i] = 1;
+      allocations++;
+      return static_cast<int>(i);
+    }
+  }
+  return AVERROR(EAGAIN);
+}
+
+int FrameArenaState::SlotOf(const uint8_t* ptr) const {
+  if (!ptr || !base || stride == 0 || ptr < base + first_offset) {
+    return -1;
+  }
+  size_t slot = static_cast<size_t>(ptr - (base + first_offset)) / stride;
+  return slot < in_use.size() ? static_cast<int>(slot) : -1;
+}
+
+AVBufferRef* FrameArenaState::WrapSlot(const std::shared_ptr<FrameArenaState>& state, int slot) {
+  auto* ref = new SlotRef{ state, slot };
+  uint8_t* data = state->base + state->first_offset + static_cast<size_t>(slot) * state->stride;
+
+  AVBufferRef* buf = av_buffer_create(data, state->slot_size, ReleaseSlot, ref, 0);
+  if (!buf) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->in_use[slot] = 0;
+    delete ref;
+  }
+  return buf;
+}
+
+void FrameArenaState::ReleaseSlot(void* opaque, uint8_t* data) {
+  auto* ref = static_cast<SlotRef*>(opaque);
+  {
+    std::lock_guard<std::mutex> lock(ref->state->mutex);
+    ref->state->in_use[ref->slot] = 0;
+  }
+  // May drop the last state reference (and with it the JS memory)
+  delete ref;
+}
+
+int FrameArenaState::GetVideoBuffer(const std::shared_ptr<FrameArenaState>& state, AVCodecContext* avctx, AVFrame* frame) {
+  AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (avctx->codec_type != AVMEDIA_TYPE_VIDEO || !desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+    return AVERROR(ENOSYS);
+  }
+
+  // Same padding rules as avcodec_default_get_buffer2()
+  int width = frame->width;
+  int height = frame->height;
+  int linesize_align[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(avctx, &width, &height, linesize_align);
+
+  int linesizes[4];
+  int ret = av_image_fill_linesizes(linesizes, format, width);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ptrdiff_t aligned_linesizes[4];
+  for (int i = 0; i < 4; i++) {
+    linesizes[i] = FFALIGN(linesizes[i], FFMAX(state->align, linesize_align[i]));
+    aligned_linesizes[i] = linesizes[i];
+  }
+
+  size_t sizes[4];
+  ret = av_image_fill_plane_sizes(sizes, format, height, aligned_linesizes);
+  if (ret < 0) {
+    return ret;
+  }
+
+  size_t total = 16 + state->align;
+  for (int i = 0; i < 4; i++) {
+    total += FFALIGN(sizes[i], static_cast<size_t>(state->align));
+  }
+  if (total > state->slot_size) {
+    return AVERROR(ENOMEM);
+  }
+
+  int slot = state->Acquire();
+  if (slot < 0) {
+    return slot;
+  }
+
+  AVBufferRef* buf = WrapSlot(state, slot);
+  if (!buf) {
+    return AVERROR(ENOMEM);
+  }
+
+  frame->buf[0] = buf;
+  size_t offset = 0;
+  for (int i = 0; i < 4 && sizes[i]; i++) {
+    frame->data[i] = buf->data + offset;
+    frame->linesize[i] = linesizes[i];
+    offset += FFALIGN(sizes[i], static_cast<size_t>(state->align));
+  }
+  frame->extended_data = frame->data;
+
+  return 0;
+}
+
+// === FrameArena ===
+
+Napi::FunctionReference FrameArena::constructor;
+
+Napi::Object FrameArena::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "FrameArena", {
+    InstanceMethod<&FrameArena::Alloc>("alloc"),
+    InstanceMethod<&FrameArena::Free>("free"),
+    InstanceMethod<&FrameArena::AllocFrame>("allocFrame"),
+    InstanceMethod<&FrameArena::Pin>("pin"),
+    InstanceMethod<&FrameArena::Release>("release"),
+    InstanceMethod<&FrameArena::SlotOf>("slotOf"),
+    InstanceMethod<&FrameArena::SlotOffset>("slotOffset"),
+    InstanceMethod<&FrameArena::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &FrameArena::Dispose),
+
+    InstanceAccessor<&FrameArena::GetSlotCount>("slotCount"),
+    InstanceAccessor<&FrameArena::GetSlotSize>("slotSize"),
+    InstanceAccessor<&FrameArena::GetFreeSlots>("freeSlots"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("FrameArena", func);
+  return exports;
+}
+
+FrameArena::FrameArena(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<FrameArena>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+FrameArena::~FrameArena() {
+  // Outstanding buffers keep the state (and memory) alive
+  state_.reset();
+}
+
+Napi::Value FrameArena::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  uint8_t* data = nullptr;
+  size_t size = 0;
+  if (info.Length() < 2 || !Frame::GetJSMemory(info[0], &data, &size) || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected (memory, slotSize[, align])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int64_t slot_size = info[1].As<Napi::Number>().Int64Value();
+  int align = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : 64;
+  if (slot_size <= 0 || align <= 0 || (align & (align - 1)) != 0) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  auto state = std::make_shared<FrameArenaState>();
+  state->align = align;
+  state->slot_size = static_cast<size_t>(slot_size);
+  state->stride = FFALIGN(state->slot_size, static_cast<size_t>(align));
+  state->base = data;
+  state->first_offset = FFALIGN(reinterpret_cast<uintptr_t>(data), static_cast<uintptr_t>(align)) - reinterpret_cast<uintptr_t>(data);
+
+  if (size < state->first_offset + state->slot_size) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  size_t count = (size - state->first_offset - state->slot_size) / state->stride + 1;
+
+  // Keeps the JS memory alive as long as any slot is referenced
+  state->backing = Frame::CreateJSBuffer(env, info[0], data, size);
+  if (!state->backing) {
+    return Napi::Number::New(env, AVERROR(ENOMEM));
+  }
+
+  state->in_use.assign(count, 0);
+  state->pinned.assign(count, 0);
+  state_ = state;
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FrameArena::Free(const Napi::CallbackInfo& info) {
+  state_.reset();
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameArena::AllocFrame(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  // Linesizes aligned to the arena alignment keep every plane aligned
+  int required = frame->RequiredBufferSize(state_->align);
+  if (required < 0) {
+    return Napi::Number::New(env, required);
+  }
+  if (static_cast<size_t>(required) > state_->slot_size) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int slot = state_->Acquire();
+  if (slot < 0) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->fallbacks++;
+    return Napi::Number::New(env, slot);
+  }
+
+  AVBufferRef* buf = FrameArenaState::WrapSlot(state_, slot);
+  if (!buf) {
+    return Napi::Number::New(env, AVERROR(ENOMEM));
+  }
+
+  int ret = frame->AttachBuffer(buf, state_->align);
+  return Napi::Number::New(env, ret < 0 ? ret : slot);
+}
+
+Napi::Value FrameArena::Pin(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int slot = state_->SlotOf(frame->Get()->data[0]);
+  if (slot < 0) {
+    return Napi::Number::New(env, AVERROR(ENOENT));
+  }
+
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->pinned[slot] = 1;
+  return Napi::Number::New(env, slot);
+}
+
+Napi::Value FrameArena::Release(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Slot index required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int slot = info[0].As<Napi::Number>().Int32Value();
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  if (slot < 0 || slot >= static_cast<int>(state_->pinned.size())) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  state_->pinned[slot] = 0;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FrameArena::SlotOf(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, -1);
+  }
+
+  return Napi::Number::New(env, state_->SlotOf(frame->Get()->data[0]));
+}
+
+Napi::Value FrameArena::SlotOffset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Slot index required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int slot = info[0].As<Napi::Number>().Int32Value();
+  if (slot < 0 || slot >= static_cast<int>(state_->in_use.size())) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  return Napi::Number::New(env, static_cast<double>(state_->first_offset + static_cast<size_t>(slot) * state_->stride));
+}
+
+Napi::Value FrameArena::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  int in_use = 0;
+  int pinned = 0;
+  uint64_t allocations = 0;
+  uint64_t fallbacks = 0;
+  size_t slots = 0;
+
+  if (state_) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    slots = state_->in_use.size();
+    for (size_t i = 0; i < slots; i++) {
+      in_use += state_->in_use[i] ? 1 : 0;
+      pinned += state_->pinned[i] ? 1 : 0;
+    }
+    allocations = state_->allocations;
+    fallbacks = state_->fallbacks;
+  }
+
+  stats.Set("slots", Napi::Number::New(env, static_cast<double>(slots)));
+  stats.Set("inUse", Napi::Number::New(env, in_use));
+  stats.Set("pinned", Napi::Number::New(env, pinned));
+  stats.Set("allocations", Napi::Number::New(env, static_cast<double>(allocations)));
+  stats.Set("fallbacks", Napi::Number::New(env, static_cast<double>(fallbacks)));
+  return stats;
+}
+
+Napi::Value FrameArena::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+// === Properties ===
+
+Napi::Value FrameArena::GetSlotCount(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), state_ ? static_cast<double>(state_->in_use.size()) : 0);
+}
+
+Napi::Value FrameArena::GetSlotSize(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), state_ ? static_cast<double>(state_->slot_size) : 0);
+}
+
+Napi::Value FrameArena::GetFreeSlots(const Napi::CallbackInfo& info) {
+  if (!state_) {
+    return Napi::Number::New(info.Env(), 0);
+  }
+
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  int free_slots = 0;
+  for (size_t i = 0; i < state_->in_use.size(); i++) {
+    free_slots += !state_->in_use[i] && !state_->pinned[i] ? 1 : 0;
+  }
+  return Napi::Number::New(info.Env(), free_slots);
+}
+
+} // namespace ffmpeg
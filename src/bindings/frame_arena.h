@@ -0,0 +1,93 @@
+#ifndef FFMPEG_FRAME_ARENA_H
+#define FFMPEG_FRAME_ARENA_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Fixed-slot allocator over caller-provided (shared) memory.
+ *
+ * Shared with every buffer handed out, so slots can be returned after the
+ * FrameArena object is gone. A slot is free once FFmpeg dropped its buffer
+ * and it is not pinned by JavaScript.
+ */
+struct FrameArenaState {
+  AVBufferRef* backing = nullptr;
+  uint8_t* base = nullptr;
+  size_t slot_size = 0;
+  size_t stride = 0;
+  size_t first_offset = 0;
+  int align = 64;
+
+  std::mutex mutex;
+  std::vector<uint8_t> in_use;
+  std::vector<uint8_t> pinned;
+  uint64_t allocations = 0;
+  uint64_t fallbacks = 0;
+
+  ~FrameArenaState();
+
+  int Acquire();
+  int SlotOf(const uint8_t* ptr) const;
+  static AVBufferRef* WrapSlot(const std::shared_ptr<FrameArenaState>& state, int slot);
+  static int GetVideoBuffer(const std::shared_ptr<FrameArenaState>& state, AVCodecContext* avctx, AVFrame* frame);
+
+private:
+  struct SlotRef {
+    std::shared_ptr<FrameArenaState> state;
+    int slot;
+  };
+
+  static void ReleaseSlot(void* opaque, uint8_t* data);
+};
+
+/**
+ * Frame buffer arena backed by a SharedArrayBuffer.
+ *
+ * Carves aligned frame planes out of caller memory, so decoded or scaled
+ * frames already live where worker threads and WASM modules can read them.
+ */
+class FrameArena : public Napi::ObjectWrap<FrameArena> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  FrameArena(const Napi::CallbackInfo& info);
+  ~FrameArena();
+
+  std::shared_ptr<FrameArenaState> GetState() { return state_; }
+
+private:
+  static Napi::FunctionReference constructor;
+
+  std::shared_ptr<FrameArenaState> state_;
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value AllocFrame(const Napi::CallbackInfo& info);
+  Napi::Value Pin(const Napi::CallbackInfo& info);
+  Napi::Value Release(const Napi::CallbackInfo& info);
+  Napi::Value SlotOf(const Napi::CallbackInfo& info);
+  Napi::Value SlotOffset(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetSlotCount(const Napi::CallbackInfo& info);
+  Napi::Value GetSlotSize(const Napi::CallbackInfo& info);
+  Napi::Value GetFreeSlots(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_FRAME_ARENA_H
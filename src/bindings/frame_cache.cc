@@ -0,0 +1,582 @@
+#include "frame_cache.h"
+#include "frame.h"
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference FrameCache::constructor;
+
+Napi::Object FrameCache::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "FrameCache", {
+    InstanceMethod<&FrameCache::Alloc>("alloc"),
+    InstanceMethod<&FrameCache::Free>("free"),
+    InstanceMethod<&FrameCache::Put>("put"),
+    InstanceMethod<&FrameCache::GetFrame>("get"),
+    InstanceMethod<&FrameCache::Has>("has"),
+    InstanceMethod<&FrameCache::Clear>("clear"),
+    InstanceMethod<&FrameCache::Prefetch>("prefetch"),
+    InstanceMethod<&FrameCache::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &FrameCache::Dispose),
+
+    InstanceAccessor<&FrameCache::GetBytes>("bytes"),
+    InstanceAccessor<&FrameCache::GetEntries>("entries"),
+    InstanceAccessor<&FrameCache::GetMaxBytes>("maxBytes"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("FrameCache", func);
+  return exports;
+}
+
+FrameCache::FrameCache(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<FrameCache>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+FrameCache::~FrameCache() {
+  // Manual cleanup if not already done
+  FreeInternal();
+
+  // The prefetcher keeps the cache alive, it can only still run at environment
+  // teardown, where its reads have just been interrupted
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+}
+
+// === Cache ===
+
+size_t FrameCache::FrameBytes(const AVFrame* frame) {
+  size_t bytes = sizeof(AVFrame);
+  for (int i = 0; i < AV_NUM_DATA_POINTERS && frame->buf[i]; i++) {
+    bytes += frame->buf[i]->size;
+  }
+  for (int i = 0; i < frame->nb_extended_buf; i++) {
+    bytes += frame->extended_buf[i]->size;
+  }
+  return bytes;
+}
+
+AVFrame* FrameCache::PrepareEntry(const AVFrame* frame) {
+  AVFrame* entry = av_frame_alloc();
+  if (!entry) {
+    return nullptr;
+  }
+
+  // Software video frames may be stored downscaled, everything else by reference
+  bool downscale = scale_width_ > 0 && frame->width > 0 && frame->height > 0 &&
+                   !frame->hw_frames_ctx && frame->width > scale_width_;
+  if (!downscale) {
+    if (av_frame_ref(entry, frame) < 0) {
+      av_frame_free(&entry);
+    }
+    return entry;
+  }
+
+  int height = scale_height_ > 0
+    ? scale_height_
+    : static_cast<int>(av_rescale(frame->height, scale_width_, frame->width)) & ~1;
+  if (height < 2) height = 2;
+
+  entry->format = frame->format;
+  entry->width = scale_width_;
+  entry->height = height;
+  if (av_frame_get_buffer(entry, 0) < 0 || av_frame_copy_props(entry, frame) < 0) {
+    av_frame_free(&entry);
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(scale_mutex_);
+  AVPixelFormat fmt = static_cast<AVPixelFormat>(frame->format);
+  sws_ = sws_getCachedContext(sws_, frame->width, frame->height, fmt,
+                              entry->width, entry->height, fmt,
+                              SWS_BILINEAR, nullptr, nullptr, nullptr);
+  if (!sws_) {
+    av_frame_free(&entry);
+    return nullptr;
+  }
+  sws_scale(sws_, frame->data, frame->linesize, 0, frame->height, entry->data, entry->linesize);
+
+  return entry;
+}
+
+int FrameCache::Insert(const Key& key, const AVFrame* frame) {
+  AVFrame* stored = PrepareEntry(frame);
+  if (!stored) {
+    return AVERROR(ENOMEM);
+  }
+
+  size_t bytes = FrameBytes(stored);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!allocated_) {
+    av_frame_free(&stored);
+    return AVERROR(EINVAL);
+  }
+
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    // Replace existing entry
+    bytes_ -= it->second->bytes;
+    av_frame_free(&it->second->frame);
+    lru_.erase(it->second);
+    index_.erase(it);
+  }
+
+  lru_.push_front({ key, stored, bytes });
+  index_[key] = lru_.begin();
+  bytes_ += bytes;
+
+  EvictLocked();
+  return 0;
+}
+
+bool FrameCache::Contains(const Key& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.find(key) != index_.end();
+}
+
+void FrameCache::EvictLocked() {
+  // Keep the most recent entry even if it alone exceeds the budget
+  while (bytes_ > max_bytes_ && lru_.size() > 1) {
+    Entry& victim = lru_.back();
+    bytes_ -= victim.bytes;
+    index_.erase(victim.key);
+    av_frame_free(&victim.frame);
+    lru_.pop_back();
+    evictions_++;
+  }
+}
+
+void FrameCache::ClearLocked() {
+  for (Entry& entry : lru_) {
+    av_frame_free(&entry.frame);
+  }
+  lru_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+// === Prefetcher ===
+
+FrameCache::PrefetchSource* FrameCache::OpenSource(const std::string& url, int stream) {
+  auto id = std::make_pair(url, stream);
+  auto it = sources_.find(id);
+  if (it != sources_.end()) {
+    return &it->second;
+  }
+
+  PrefetchSource source;
+  source.fmt = avformat_alloc_context();
+  if (!source.fmt) {
+    return nullptr;
+  }
+  // Protocols copy the callback when they are opened, so it has to be set before opening
+  source.fmt->interrupt_callback.callback = &FrameCache::CheckInterrupt;
+  source.fmt->interrupt_callback.opaque = this;
+  if (avformat_open_input(&source.fmt, url.c_str(), nullptr, nullptr) < 0) {
+    return nullptr;
+  }
+
+  int ret = avformat_find_stream_info(source.fmt, nullptr);
+  if (ret >= 0 && (stream < 0 || stream >= static_cast<int>(source.fmt->nb_streams))) {
+    ret = AVERROR(EINVAL);
+  }
+
+  const AVCodec* codec = nullptr;
+  if (ret >= 0) {
+    AVStream* st = source.fmt->streams[stream];
+    codec = avcodec_find_decoder(st->codecpar->codec_id);
+    source.dec = codec ? avcodec_alloc_context3(codec) : nullptr;
+    ret = source.dec ? avcodec_parameters_to_context(source.dec, st->codecpar) : AVERROR_DECODER_NOT_FOUND;
+    if (ret >= 0) {
+      source.dec->pkt_timebase = st->time_base;
+      source.dec->thread_count = 0;
+      ret = avcodec_open2(source.dec, codec, nullptr);
+    }
+  }
+
+  if (ret < 0) {
+    avcodec_free_context(&source.dec);
+    avformat_close_input(&source.fmt);
+    return nullptr;
+  }
+
+  return &(sources_[id] = source);
+}
+
+int FrameCache::RunPrefetch(const PrefetchJob& job) {
+  PrefetchSource* source = OpenSource(job.url, job.stream);
+  if (!source) {
+    return AVERROR(EINVAL);
+  }
+
+  int64_t start = job.pts - job.before;
+  int64_t end = job.pts + job.after;
+
+  int ret = av_seek_frame(source->fmt, job.stream, start, AVSEEK_FLAG_BACKWARD);
+  if (ret < 0) {
+    return ret;
+  }
+  avcodec_flush_buffers(source->dec);
+
+  AVPacket* packet = av_packet_alloc();
+  AVFrame* frame = av_frame_alloc();
+  if (!packet || !frame) {
+    av_packet_free(&packet);
+    av_frame_free(&frame);
+    return AVERROR(ENOMEM);
+  }
+
+  bool done = false;
+  bool flushing = false;
+  while (!done) {
+    {
+      // A newer playhead position supersedes this one
+      std::lock_guard<std::mutex> lock(prefetch_mutex_);
+      if (has_job_ || prefetch_stop_) {
+        break;
+      }
+    }
+
+    if (!flushing) {
+      ret = av_read_frame(source->fmt, packet);
+      if (ret < 0) {
+        flushing = true;
+        ret = avcodec_send_packet(source->dec, nullptr);
+      } else if (packet->stream_index != job.stream) {
+        av_packet_unref(packet);
+        continue;
+      } else {
+        ret = avcodec_send_packet(source->dec, packet);
+        av_packet_unref(packet);
+      }
+    }
+
+    while ((ret = avcodec_receive_frame(source->dec, frame)) >= 0) {
+      int64_t ts = frame->best_effort_timestamp;
+      if (ts != AV_NOPTS_VALUE && ts > end) {
+        done = true;
+      } else if (ts != AV_NOPTS_VALUE && ts >= start) {
+        Key key = { job.url, job.stream, ts };
+        if (!Contains(key) && Insert(key, frame) >= 0) {
+          prefetched_++;
+        }
+      }
+      av_frame_unref(frame);
+    }
+
+    if (flushing) {
+      break;
+    }
+  }
+
+  av_packet_free(&packet);
+  av_frame_free(&frame);
+  return 0;
+}
+
+void FrameCache::PrefetchLoop() {
+  while (true) {
+    PrefetchJob job;
+    {
+      std::unique_lock<std::mutex> lock(prefetch_mutex_);
+      prefetch_cv_.wait(lock, [&] { return has_job_ || prefetch_stop_; });
+      if (prefetch_stop_) {
+        break;
+      }
+      job = job_;
+      has_job_ = false;
+    }
+
+    RunPrefetch(job);
+  }
+
+  for (auto& entry : sources_) {
+    avcodec_free_context(&entry.second.dec);
+    avformat_close_input(&entry.second.fmt);
+  }
+  sources_.clear();
+
+  // Join and drop the start reference on the JS thread
+  prefetch_exit_tsfn_.NonBlockingCall([this](Napi::Env env, Napi::Function) { OnPrefetcherExit(env); });
+  prefetch_exit_tsfn_.Release();
+}
+
+int FrameCache::CheckInterrupt(void* opaque) {
+  return static_cast<FrameCache*>(opaque)->prefetch_interrupt_.load() ? 1 : 0;
+}
+
+void FrameCache::StartPrefetcher(Napi::Env env) {
+  prefetch_exit_tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "FrameCachePrefetchExit",
+    0,
+    1
+  );
+  prefetch_exit_tsfn_.Unref(env);
+
+  // Keep the cache alive until the thread has exited
+  Ref();
+  prefetch_running_ = true;
+  prefetch_thread_ = std::thread(&FrameCache::PrefetchLoop, this);
+}
+
+void FrameCache::StopPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    if (!prefetch_running_) {
+      has_job_ = false;
+      return;
+    }
+    prefetch_stop_ = true;
+    has_job_ = false;
+  }
+  // Aborts network reads of the sources; the thread is joined once it has exited
+  prefetch_interrupt_ = true;
+  prefetch_cv_.notify_all();
+}
+
+void FrameCache::OnPrefetcherExit(Napi::Env env) {
+  // The thread has left its loop, joining does not wait on any I/O
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  prefetch_running_ = false;
+  prefetch_interrupt_ = false;
+
+  bool restart;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_stop_ = false;
+    restart = has_job_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    restart = restart && allocated_;
+  }
+
+  // A playhead set while the previous prefetcher was stopping
+  if (restart) {
+    StartPrefetcher(env);
+  }
+  Unref();
+}
+
+void FrameCache::FreeInternal() {
+  StopPrefetcher();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearLocked();
+    allocated_ = false;
+  }
+
+  std::lock_guard<std::mutex> lock(scale_mutex_);
+  if (sws_) {
+    sws_freeContext(sws_);
+    sws_ = nullptr;
+  }
+}
+
+// === Methods ===
+
+bool FrameCache::ParseKey(const Napi::CallbackInfo& info, Key& key) {
+  if (info.Length() < 3 || !info[0].IsString() || !info[1].IsNumber()) {
+    return false;
+  }
+
+  key.input = info[0].As<Napi::String>().Utf8Value();
+  key.stream = info[1].As<Napi::Number>().Int32Value();
+
+  if (info[2].IsBigInt()) {
+    bool lossless;
+    key.pts = info[2].As<Napi::BigInt>().Int64Value(&lossless);
+  } else if (info[2].IsNumber()) {
+    key.pts = info[2].As<Napi::Number>().Int64Value();
+  } else {
+    return false;
+  }
+
+  return true;
+}
+
+Napi::Value FrameCache::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected maxBytes").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FreeInternal();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_bytes_ = static_cast<size_t>(info[0].As<Napi::Number>().Int64Value());
+    hits_ = 0;
+    misses_ = 0;
+    evictions_ = 0;
+    allocated_ = true;
+  }
+
+  scale_width_ = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 0;
+  scale_height_ = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : 0;
+  prefetched_ = 0;
+
+  return env.Undefined();
+}
+
+Napi::Value FrameCache::Free(const Napi::CallbackInfo& info) {
+  FreeInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameCache::Put(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Key key;
+  if (!ParseKey(info, key) || info.Length() < 4) {
+    Napi::TypeError::New(env, "Expected 4 arguments (input, streamIndex, pts, frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[3], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, Insert(key, frame->Get()));
+}
+
+Napi::Value FrameCache::GetFrame(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Key key;
+  if (!ParseKey(info, key) || info.Length() < 4) {
+    Napi::TypeError::New(env, "Expected 4 arguments (input, streamIndex, pts, frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[3], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    misses_++;
+    return Napi::Number::New(env, AVERROR(ENOENT));
+  }
+
+  // Mark as most recently used
+  lru_.splice(lru_.begin(), lru_, it->second);
+  hits_++;
+
+  av_frame_unref(frame->Get());
+  int ret = av_frame_ref(frame->Get(), it->second->frame);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value FrameCache::Has(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Key key;
+  if (!ParseKey(info, key)) {
+    Napi::TypeError::New(env, "Expected 3 arguments (input, streamIndex, pts)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Boolean::New(env, Contains(key));
+}
+
+Napi::Value FrameCache::Clear(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ClearLocked();
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameCache::Prefetch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Key key;
+  if (!ParseKey(info, key)) {
+    Napi::TypeError::New(env, "Expected at least 3 arguments (url, streamIndex, pts)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!allocated_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  auto toInt64 = [](const Napi::Value& value) -> int64_t {
+    if (value.IsBigInt()) {
+      bool lossless;
+      return value.As<Napi::BigInt>().Int64Value(&lossless);
+    }
+    return value.IsNumber() ? value.As<Napi::Number>().Int64Value() : 0;
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    job_ = { key.input, key.stream, key.pts,
+             info.Length() > 3 ? toInt64(info[3]) : 0,
+             info.Length() > 4 ? toInt64(info[4]) : 0 };
+    has_job_ = true;
+  }
+
+  // Start the prefetch thread lazily, a stopping one restarts once it has exited
+  if (!prefetch_running_) {
+    StartPrefetcher(env);
+  }
+  prefetch_cv_.notify_all();
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FrameCache::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("hits", Napi::Number::New(env, static_cast<double>(hits_)));
+  stats.Set("misses", Napi::Number::New(env, static_cast<double>(misses_)));
+  stats.Set("evictions", Napi::Number::New(env, static_cast<double>(evictions_)));
+  stats.Set("prefetched", Napi::Number::New(env, static_cast<double>(prefetched_.load())));
+  stats.Set("entries", Napi::Number::New(env, static_cast<double>(lru_.size())));
+  stats.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_)));
+  return stats;
+}
+
+Napi::Value FrameCache::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+// === Properties ===
+
+Napi::Value FrameCache::GetBytes(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(bytes_));
+}
+
+Napi::Value FrameCache::GetEntries(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(lru_.size()));
+}
+
+Napi::Value FrameCache::GetMaxBytes(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(max_bytes_));
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,152 @@
+#ifndef FFMPEG_FRAME_CACHE_H
+#define FFMPEG_FRAME_CACHE_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libswscale/swscale.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * LRU cache of decoded frames keyed by (input, stream, pts).
+ *
+ * Entries hold a reference to the frame buffers (or a downscaled copy) and
+ * are evicted least-recently-used first once the byte budget is exceeded.
+ * Lookups hand out new references, never pixel copies. An optional
+ * background prefetcher opens its own demuxer/decoder per input and fills
+ * the cache around a playhead.
+ *
+ * Stopping the prefetcher (free, alloc) never waits for it, it may be blocked
+ * in network I/O: its reads are interrupted and the thread is joined on the
+ * JS thread once it has exited. The cache keeps itself alive until then.
+ */
+class FrameCache : public Napi::ObjectWrap<FrameCache> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  FrameCache(const Napi::CallbackInfo& info);
+  ~FrameCache();
+
+private:
+  static Napi::FunctionReference constructor;
+
+  struct Key {
+    std::string input;
+    int stream;
+    int64_t pts;
+
+    bool operator==(const Key& other) const {
+      return pts == other.pts && stream == other.stream && input == other.input;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t h = std::hash<std::string>()(key.input);
+      h ^= std::hash<int64_t>()(key.pts) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      h ^= std::hash<int>()(key.stream) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  struct Entry {
+    Key key;
+    AVFrame* frame;
+    size_t bytes;
+  };
+
+  struct PrefetchJob {
+    std::string url;
+    int stream;
+    int64_t pts;
+    int64_t before;
+    int64_t after;
+  };
+
+  struct PrefetchSource {
+    AVFormatContext* fmt = nullptr;
+    AVCodecContext* dec = nullptr;
+  };
+
+  // Cache state (guarded by mutex_)
+  std::list<Entry> lru_;
+  std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+  std::mutex mutex_;
+  size_t max_bytes_ = 0;
+  size_t bytes_ = 0;
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+  bool allocated_ = false;
+
+  // Downscaled storage
+  int scale_width_ = 0;
+  int scale_height_ = 0;
+  SwsContext* sws_ = nullptr;
+  std::mutex scale_mutex_;
+
+  // Prefetcher
+  std::thread prefetch_thread_;
+  // Reports the thread's exit to the JS thread, which joins it and drops the start reference
+  Napi::ThreadSafeFunction prefetch_exit_tsfn_;
+  bool prefetch_running_ = false;  // JS thread only: started and not yet joined
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cv_;
+  PrefetchJob job_;
+  bool has_job_ = false;
+  bool prefetch_stop_ = false;
+  // AVIOInterruptCB of the prefetch sources, aborts their network I/O on stop
+  std::atomic<bool> prefetch_interrupt_{false};
+  std::atomic<uint64_t> prefetched_{0};
+  std::map<std::pair<std::string, int>, PrefetchSource> sources_;
+
+  int Insert(const Key& key, const AVFrame* frame);
+  bool Contains(const Key& key);
+  AVFrame* PrepareEntry(const AVFrame* frame);
+  void EvictLocked();
+  void ClearLocked();
+  void PrefetchLoop();
+  int RunPrefetch(const PrefetchJob& job);
+  PrefetchSource* OpenSource(const std::string& url, int stream);
+  void StartPrefetcher(Napi::Env env);
+  void StopPrefetcher();
+  void OnPrefetcherExit(Napi::Env env);
+  static int CheckInterrupt(void* opaque);
+  void FreeInternal();
+
+  static size_t FrameBytes(const AVFrame* frame);
+  static bool ParseKey(const Napi::CallbackInfo& info, Key& key);
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value Put(const Napi::CallbackInfo& info);
+  Napi::Value GetFrame(const Napi::CallbackInfo& info);
+  Napi::Value Has(const Napi::CallbackInfo& info);
+  Napi::Value Clear(const Napi::CallbackInfo& info);
+  Napi::Value Prefetch(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetBytes(const Napi::CallbackInfo& info);
+  Napi::Value GetEntries(const Napi::CallbackInfo& info);
+  Napi::Value GetMaxBytes(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_FRAME_CACHE_H
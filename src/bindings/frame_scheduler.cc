@@ -0,0 +1,550 @@
+#include "frame_scheduler.h"
+#include "codec_context.h"
+#include "frame.h"
+
+#include <algorithm>
+#include <string>
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/mathematics.h>
+#include <libavutil/pixdesc.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference FrameScheduler::constructor;
+
+// Encoded packets buffered for JS before the scheduler thread blocks
+static constexpr size_t kPacketQueueSize = 64;
+
+// Samples per tick for audio encoders without a fixed frame size
+static constexpr int kDefaultFrameSize = 1024;
+
+Napi::Object FrameScheduler::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "FrameScheduler", {
+    // Setup
+    InstanceMethod<&FrameScheduler::Configure>("configure"),
+    InstanceMethod<&FrameScheduler::Start>("start"),
+
+    // Source
+    InstanceMethod<&FrameScheduler::PushFrame>("pushFrame"),
+
+    // Consumption
+    InstanceMethod<&FrameScheduler::ReceivePacketAsync>("receivePacket"),
+    InstanceMethod<&FrameScheduler::ReceivePacketSync>("receivePacketSync"),
+
+    // Lifecycle
+    InstanceMethod<&FrameScheduler::End>("end"),
+    InstanceMethod<&FrameScheduler::Stop>("stop"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &FrameScheduler::Dispose),
+
+    // Properties
+    InstanceAccessor<&FrameScheduler::GetIsRunning>("isRunning"),
+    InstanceMethod<&FrameScheduler::GetStats>("getStats"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("FrameScheduler", func);
+  return exports;
+}
+
+FrameScheduler::FrameScheduler(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<FrameScheduler>(info), packets_(kPacketQueueSize) {
+  // Constructor does nothing - user must call configure()
+}
+
+FrameScheduler::~FrameScheduler() {
+  StopInternal();
+  Release();
+  encoder_ref_.Reset();
+}
+
+// === Scheduler thread ===
+
+int64_t FrameScheduler::DueTime(int64_t tick) const {
+  return av_rescale_q(tick, tick_tb_, AV_TIME_BASE_Q);
+}
+
+void FrameScheduler::Run() {
+  bool flush = false;
+
+  while (true) {
+    AVFrame* frame = nullptr;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      int64_t due = DueTime(tick_);
+      cond_.wait_until(lock, start_ + std::chrono::microseconds(due), [this] { return stopping_ || ending_; });
+      if (stopping_) {
+        break;
+      }
+
+      if (ending_) {
+        // Encode what the source queued before ending, without waiting for the clock
+        frame = audio_ ? NextAudioFrame(true) : NextVideoFrame(true);
+        if (!frame) {
+          flush = error_ == 0;
+          break;
+        }
+      } else {
+        int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start_).count();
+        stats_.max_lateness = std::max(stats_.max_lateness, now - due);
+        if (now >= DueTime(tick_ + 1)) {
+          stats_.late_ticks++;
+        }
+        frame = audio_ ? NextAudioFrame(false) : NextVideoFrame(false);
+      }
+      stats_.ticks++;
+    }
+
+    if (error_ < 0) {
+      av_frame_free(&frame);
+      break;
+    }
+
+    // Nothing to show yet (hardware frames cannot be synthesized)
+    if (frame) {
+      frame->pts = av_rescale_q(tick_, tick_tb_, encoder_->time_base);
+      frame->duration = av_rescale_q(1, tick_tb_, encoder_->time_base);
+      frame->pict_type = AV_PICTURE_TYPE_NONE;
+      bool ok = Encode(frame);
+      av_frame_free(&frame);
+      if (!ok) {
+        break;
+      }
+    }
+    tick_++;
+  }
+
+  if (flush) {
+    Encode(nullptr);
+  }
+  packets_.Close();
+}
+
+AVFrame* FrameScheduler::NextVideoFrame(bool draining) {
+  if (!frames_.empty()) {
+    AVFrame* frame = frames_.front();
+    frames_.pop_front();
+
+    // Keep a reference to repeat while the source is late
+    av_frame_unref(last_);
+    if (av_frame_ref(last_, frame) < 0) {
+      error_ = AVERROR(ENOMEM);
+    }
+    repeated_ = 0;
+    return frame;
+  }
+
+  if (draining) {
+    return nullptr;
+  }
+
+  stats_.underruns++;
+  if (fill_ == SchedulerFill::kRepeat && last_->buf[0] && (max_repeats_ == 0 || repeated_ < max_repeats_)) {
+    repeated_++;
+    stats_.repeats++;
+    return av_frame_clone(last_);
+  }
+
+  AVFrame* frame = FillFrame();
+  if (frame) {
+    stats_.fills++;
+  }
+  return frame;
+}
+
+AVFrame* FrameScheduler::NextAudioFrame(bool draining) {
+  int available = av_audio_fifo_size(fifo_);
+  if (draining && available == 0) {
+    return nullptr;
+  }
+
+  AVFrame* frame = av_frame_alloc();
+  if (!frame) {
+    error_ = AVERROR(ENOMEM);
+    return nullptr;
+  }
+  frame->nb_samples = frame_size_;
+  frame->format = encoder_->sample_fmt;
+  frame->sample_rate = encoder_->sample_rate;
+  int ret = av_channel_layout_copy(&frame->ch_layout, &encoder_->ch_layout);
+  if (ret >= 0) {
+    ret = av_frame_get_buffer(frame, 0);
+  }
+  if (ret < 0) {
+    av_frame_free(&frame);
+    error_ = ret;
+    return nullptr;
+  }
+
+  int got = av_audio_fifo_read(fifo_, reinterpret_cast<void**>(frame->extended_data), std::min(available, frame_size_));
+  got = std::max(got, 0);
+  if (got < frame_size_) {
+    // Pad with silence, also the last frame when draining
+    av_samples_set_silence(frame->extended_data, got, frame_size_ - got, frame->ch_layout.nb_channels,
+                           static_cast<AVSampleFormat>(frame->format));
+    if (!draining) {
+      stats_.underruns++;
+      if (got == 0) {
+        stats_.fills++;
+      }
+    }
+  }
+  return frame;
+}
+
+AVFrame* FrameScheduler::FillFrame() {
+  // Repeating falls back to the slate when there is one
+  if (slate_ && fill_ != SchedulerFill::kBlack) {
+    return av_frame_clone(slate_);
+  }
+  return black_ ? av_frame_clone(black_) : nullptr;
+}
+
+bool FrameScheduler::Encode(AVFrame* frame) {
+  int ret = avcodec_send_frame(encoder_, frame);
+  if (ret < 0 && ret != AVERROR_EOF) {
+    error_ = ret;
+    return false;
+  }
+
+  while (true) {
+    AVPacket* packet = av_packet_alloc();
+    if (!packet) {
+      error_ = AVERROR(ENOMEM);
+      return false;
+    }
+
+    ret = avcodec_receive_packet(encoder_, packet);
+    if (ret < 0) {
+      av_packet_free(&packet);
+      if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
+        return true;
+      }
+      error_ = ret;
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.packets++;
+    }
+
+    // Blocks while JS is behind, which shows up as late ticks
+    if (!packets_.Push(packet)) {
+      av_packet_free(&packet);
+      return false;
+    }
+  }
+}
+
+void FrameScheduler::StopInternal() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+    cond_.notify_all();
+  }
+
+  packets_.Close();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  packets_.Drain([](AVPacket*& packet) { av_packet_free(&packet); });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (AVFrame*& frame : frames_) {
+    av_frame_free(&frame);
+  }
+  frames_.clear();
+}
+
+void FrameScheduler::Release() {
+  av_frame_free(&last_);
+  av_frame_free(&black_);
+  av_frame_free(&slate_);
+  if (fifo_) {
+    av_audio_fifo_free(fifo_);
+    fifo_ = nullptr;
+  }
+}
+
+// === Setup ===
+
+Napi::Value FrameScheduler::Configure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "FrameScheduler already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecContext* codec_context = info.Length() > 0 ? UnwrapNativeObject<CodecContext>(env, info[0], "CodecContext") : nullptr;
+  if (!codec_context || !codec_context->Get()) {
+    Napi::TypeError::New(env, "Invalid encoder CodecContext").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  AVCodecContext* encoder = codec_context->Get();
+  if (encoder_ || !avcodec_is_open(encoder) || !av_codec_is_encoder(encoder->codec)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  bool audio = encoder->codec_type == AVMEDIA_TYPE_AUDIO;
+  if (!audio && encoder->codec_type != AVMEDIA_TYPE_VIDEO) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  AVRational frame_rate = encoder->framerate.num > 0 ? encoder->framerate : av_inv_q(encoder->time_base);
+  int frame_size = encoder->frame_size > 0 ? encoder->frame_size : kDefaultFrameSize;
+  SchedulerFill fill = SchedulerFill::kRepeat;
+  AVFrame* slate = nullptr;
+  int64_t max_repeats = 0;
+  int64_t queue_size = 2;
+
+  if (info.Length() > 1 && info[1].IsObject()) {
+    Napi::Object options = info[1].As<Napi::Object>();
+
+    if (options.Has("frameRate") && options.Get("frameRate").IsObject()) {
+      frame_rate = JSToRational(options.Get("frameRate").As<Napi::Object>());
+    }
+    // Encoders with a fixed frame size dictate the samples per tick
+    if (options.Has("frameSize") && options.Get("frameSize").IsNumber() && encoder->frame_size <= 0) {
+      frame_size = options.Get("frameSize").As<Napi::Number>().Int32Value();
+    }
+    if (options.Has("fill") && options.Get("fill").IsString()) {
+      std::string value = options.Get("fill").As<Napi::String>().Utf8Value();
+      if (value == "repeat") {
+        fill = SchedulerFill::kRepeat;
+      } else if (value == "black") {
+        fill = SchedulerFill::kBlack;
+      } else if (value == "slate") {
+        fill = SchedulerFill::kSlate;
+      } else {
+        return Napi::Number::New(env, AVERROR(EINVAL));
+      }
+    }
+    if (options.Has("slate") && options.Get("slate").IsObject()) {
+      Frame* frame = UnwrapNativeObject<Frame>(env, options.Get("slate"), "Frame");
+      if (!frame || !frame->Get()) {
+        Napi::TypeError::New(env, "Invalid slate Frame").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      slate = frame->Get();
+    }
+    if (options.Has("maxRepeats") && options.Get("maxRepeats").IsNumber()) {
+      max_repeats = options.Get("maxRepeats").As<Napi::Number>().Int64Value();
+    }
+    if (options.Has("queueSize") && options.Get("queueSize").IsNumber()) {
+      queue_size = options.Get("queueSize").As<Napi::Number>().Int64Value();
+    }
+  }
+
+  if (frame_rate.num <= 0 || frame_rate.den <= 0 || frame_size <= 0 || max_repeats < 0 || queue_size < 1 ||
+      (fill == SchedulerFill::kSlate && !slate)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  // Slates are encoded as-is
+  if (slate && (audio || slate->format != encoder->pix_fmt || slate->width != encoder->width ||
+                slate->height != encoder->height || !slate->buf[0])) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  last_ = av_frame_alloc();
+  if (!last_) {
+    return Napi::Number::New(env, AVERROR(ENOMEM));
+  }
+
+  if (audio) {
+    fifo_ = av_audio_fifo_alloc(encoder->sample_fmt, encoder->ch_layout.nb_channels, frame_size * static_cast<int>(queue_size + 1));
+    if (!fifo_) {
+      Release();
+      return Napi::Number::New(env, AVERROR(ENOMEM));
+    }
+    tick_tb_ = { frame_size, encoder->sample_rate };
+  } else {
+    tick_tb_ = av_inv_q(frame_rate);
+
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(encoder->pix_fmt);
+    if (desc && !(desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+      black_ = av_frame_alloc();
+      if (!black_) {
+        Release();
+        return Napi::Number::New(env, AVERROR(ENOMEM));
+      }
+      black_->format = encoder->pix_fmt;
+      black_->width = encoder->width;
+      black_->height = encoder->height;
+      black_->color_range = encoder->color_range;
+      black_->colorspace = encoder->colorspace;
+      black_->sample_aspect_ratio = encoder->sample_aspect_ratio;
+
+      int ret = av_frame_get_buffer(black_, 0);
+      ptrdiff_t linesize[4] = { black_->linesize[0], black_->linesize[1], black_->linesize[2], black_->linesize[3] };
+      if (ret < 0 || av_image_fill_black(black_->data, linesize, encoder->pix_fmt, encoder->color_range,
+                                         encoder->width, encoder->height) < 0) {
+        // Formats without a black fill fall back to repeating
+        av_frame_free(&black_);
+      }
+    }
+
+    if (slate) {
+      slate_ = av_frame_clone(slate);
+      if (!slate_) {
+        Release();
+        return Napi::Number::New(env, AVERROR(ENOMEM));
+      }
+    }
+  }
+
+  encoder_ = encoder;
+  encoder_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+  audio_ = audio;
+  frame_size_ = audio ? frame_size : 0;
+  fill_ = fill;
+  max_repeats_ = static_cast<uint32_t>(max_repeats);
+  queue_size_ = static_cast<size_t>(queue_size);
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value FrameScheduler::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!encoder_ || started_ || ending_ || stopping_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  started_ = true;
+  start_ = Clock::now();
+  thread_ = std::thread(&FrameScheduler::Run, this);
+
+  return Napi::Number::New(env, 0);
+}
+
+// === Source ===
+
+Napi::Value FrameScheduler::PushFrame(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  AVFrame* src = frame->Get();
+  if (!encoder_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  // Frames are encoded as-is, conversion is up to the caller
+  bool matches = audio_
+    ? src->format == encoder_->sample_fmt && src->sample_rate == encoder_->sample_rate &&
+      src->ch_layout.nb_channels == encoder_->ch_layout.nb_channels
+    : src->format == encoder_->pix_fmt && src->width == encoder_->width && src->height == encoder_->height;
+  if (!matches || !src->buf[0]) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ending_ || stopping_) {
+    return Napi::Number::New(env, AVERROR_EOF);
+  }
+
+  if (audio_) {
+    int ret = av_audio_fifo_write(fifo_, reinterpret_cast<void**>(src->extended_data), src->nb_samples);
+    if (ret < 0) {
+      return Napi::Number::New(env, ret);
+    }
+
+    // Source ahead of the clock: drop the oldest samples
+    int excess = av_audio_fifo_size(fifo_) - static_cast<int>(queue_size_) * frame_size_;
+    if (excess > 0) {
+      av_audio_fifo_drain(fifo_, excess);
+      stats_.overruns++;
+      stats_.dropped_samples += excess;
+    }
+  } else {
+    AVFrame* queued = av_frame_alloc();
+    if (!queued) {
+      return Napi::Number::New(env, AVERROR(ENOMEM));
+    }
+    int ret = av_frame_ref(queued, src);
+    if (ret < 0) {
+      av_frame_free(&queued);
+      return Napi::Number::New(env, ret);
+    }
+
+    // Source ahead of the clock: the newest frames win
+    if (frames_.size() >= queue_size_) {
+      av_frame_free(&frames_.front());
+      frames_.pop_front();
+      stats_.overruns++;
+    }
+    frames_.push_back(queued);
+  }
+
+  stats_.frames_in++;
+  return Napi::Number::New(env, 0);
+}
+
+// === Lifecycle ===
+
+Napi::Value FrameScheduler::End(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ending_ = true;
+  cond_.notify_all();
+
+  // Nothing will ever be encoded
+  if (!started_) {
+    packets_.Close();
+  }
+
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameScheduler::Stop(const Napi::CallbackInfo& info) {
+  StopInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value FrameScheduler::Dispose(const Napi::CallbackInfo& info) {
+  return Stop(info);
+}
+
+// === Properties ===
+
+Napi::Value FrameScheduler::GetIsRunning(const Napi::CallbackInfo& info) {
+  // The packet queue closes when the scheduler thread exits
+  return Napi::Boolean::New(info.Env(), started_ && !packets_.IsClosed());
+}
+
+Napi::Value FrameScheduler::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("ticks", Napi::Number::New(env, static_cast<double>(stats_.ticks)));
+  stats.Set("framesIn", Napi::Number::New(env, static_cast<double>(stats_.frames_in)));
+  stats.Set("repeats", Napi::Number::New(env, static_cast<double>(stats_.repeats)));
+  stats.Set("fills", Napi::Number::New(env, static_cast<double>(stats_.fills)));
+  stats.Set("underruns", Napi::Number::New(env, static_cast<double>(stats_.underruns)));
+  stats.Set("overruns", Napi::Number::New(env, static_cast<double>(stats_.overruns)));
+  stats.Set("droppedSamples", Napi::Number::New(env, static_cast<double>(stats_.dropped_samples)));
+  stats.Set("lateTicks", Napi::Number::New(env, static_cast<double>(stats_.late_ticks)));
+  stats.Set("maxLateness", Napi::Number::New(env, stats_.max_lateness / 1000.0));
+  stats.Set("packets", Napi::Number::New(env, static_cast<double>(stats_.packets)));
+  stats.Set("queued", Napi::Number::New(env, static_cast<double>(audio_ ? av_audio_fifo_size(fifo_) : frames_.size())));
+
+  return stats;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,132 @@
+#ifndef FFMPEG_FRAME_SCHEDULER_H
+#define FFMPEG_FRAME_SCHEDULER_H
+
+#include <napi.h>
+#include "common.h"
+#include "bounded_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/audio_fifo.h>
+}
+
+namespace ffmpeg {
+
+enum class SchedulerFill {
+  kRepeat,                        // Repeat the last frame
+  kBlack,                         // Black frame
+  kSlate,                         // User-provided frame
+};
+
+struct FrameSchedulerStats {
+  uint64_t ticks = 0;             // Output frames due so far
+  uint64_t frames_in = 0;         // Frames pushed by the source
+  uint64_t repeats = 0;           // Ticks served by repeating the last frame
+  uint64_t fills = 0;             // Ticks served by a black, slate or silent frame
+  uint64_t underruns = 0;         // Ticks without a new source frame (audio: not enough samples)
+  uint64_t overruns = 0;          // Source frames dropped (audio: drops of buffered samples)
+  uint64_t dropped_samples = 0;   // Audio samples dropped on overrun
+  uint64_t late_ticks = 0;        // Ticks that started after the following tick was due
+  uint64_t packets = 0;           // Packets produced by the encoder
+  int64_t max_lateness = 0;       // Largest tick lateness (us)
+};
+
+/**
+ * Feeds an encoder at a constant frame rate driven by a monotonic clock.
+ *
+ * The source pushes frames whenever they arrive. A native thread wakes at
+ * every output tick, takes the next queued frame and encodes it with the
+ * tick's pts. A late source is covered by repeating the last frame or by
+ * black/slate frames (silence for audio), a source running ahead overwrites
+ * the oldest queued frames. Tick times are computed from the start time,
+ * never from the previous tick, so the output rate does not drift.
+ *
+ * Encoded packets are queued for JS in the encoder time base.
+ */
+class FrameScheduler : public Napi::ObjectWrap<FrameScheduler> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  FrameScheduler(const Napi::CallbackInfo& info);
+  ~FrameScheduler();
+
+private:
+  friend class FSReceivePacketWorker;
+
+  using Clock = std::chrono::steady_clock;
+
+  static Napi::FunctionReference constructor;
+
+  AVCodecContext* encoder_ = nullptr;
+  Napi::ObjectReference encoder_ref_;
+  bool audio_ = false;
+
+  // Duration of one tick in seconds, and samples per tick for audio
+  AVRational tick_tb_ = { 0, 1 };
+  int frame_size_ = 0;
+
+  SchedulerFill fill_ = SchedulerFill::kRepeat;
+  uint32_t max_repeats_ = 0;
+  size_t queue_size_ = 2;
+
+  // Source side, guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<AVFrame*> frames_;
+  AVAudioFifo* fifo_ = nullptr;
+  FrameSchedulerStats stats_;
+
+  // Scheduler thread only
+  AVFrame* last_ = nullptr;
+  AVFrame* black_ = nullptr;
+  AVFrame* slate_ = nullptr;
+  uint32_t repeated_ = 0;
+  int64_t tick_ = 0;
+
+  BoundedQueue<AVPacket*> packets_;
+  std::thread thread_;
+  Clock::time_point start_;
+  std::atomic<int> error_{0};
+  bool started_ = false;
+  bool ending_ = false;
+  bool stopping_ = false;
+
+  void Run();
+  AVFrame* NextVideoFrame(bool draining);
+  AVFrame* NextAudioFrame(bool draining);
+  AVFrame* FillFrame();
+  bool Encode(AVFrame* frame);
+  int64_t DueTime(int64_t tick) const;
+  void StopInternal();
+  void Release();
+
+  // Setup
+  Napi::Value Configure(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+
+  // Source
+  Napi::Value PushFrame(const Napi::CallbackInfo& info);
+
+  // Consumption
+  Napi::Value ReceivePacketAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceivePacketSync(const Napi::CallbackInfo& info);
+
+  // Lifecycle
+  Napi::Value End(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetIsRunning(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_FRAME_SCHEDULER_H
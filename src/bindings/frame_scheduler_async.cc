@@ -0,0 +1,77 @@
+#include "frame_scheduler.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class FSReceivePacketWorker : public Napi::AsyncWorker {
+public:
+  FSReceivePacketWorker(Napi::Env env, FrameScheduler* scheduler, Packet* packet)
+    : Napi::AsyncWorker(env),
+      scheduler_(scheduler),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    AVPacket* encoded = nullptr;
+    if (!scheduler_->packets_.Pop(encoded)) {
+      ret_ = scheduler_->error_ < 0 ? scheduler_->error_.load() : AVERROR_EOF;
+      return;
+    }
+
+    av_packet_unref(packet_->Get());
+    av_packet_move_ref(packet_->Get(), encoded);
+    av_packet_free(&encoded);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  FrameScheduler* scheduler_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value FrameScheduler::ReceivePacketAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!started_ && !packets_.IsClosed()) {
+    auto deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(Napi::Number::New(env, AVERROR(EINVAL)));
+    return deferred.Promise();
+  }
+
+  auto* worker = new FSReceivePacketWorker(env, this, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,34 @@
+#include "frame_scheduler.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value FrameScheduler::ReceivePacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Would wait forever
+  if (!started_ && !packets_.IsClosed()) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  AVPacket* encoded = nullptr;
+  if (!packets_.Pop(encoded)) {
+    int ret = error_ < 0 ? error_.load() : AVERROR_EOF;
+    return Napi::Number::New(env, ret);
+  }
+
+  av_packet_unref(packet->Get());
+  av_packet_move_ref(packet->Get(), encoded);
+  av_packet_free(&encoded);
+
+  return Napi::Number::New(env, 0);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,849 @@
+#include "http_io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavformat/version.h>
+#include <libavutil/base64.h>
+#include <libavutil/dict.h>
+#include <libavutil/error.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+constexpr int kMaxRedirects = 5;
+constexpr size_t kMaxLineLength = 16 * 1024;
+constexpr size_t kReceiveBufferSize = 64 * 1024;
+
+int64_t NowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool HeaderIs(const std::string& line, size_t colon, const char* name) {
+  size_t length = strlen(name);
+  if (colon != length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; i++) {
+    if (tolower(static_cast<unsigned char>(line[i])) != name[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ContainsToken(const std::string& value, const char* token) {
+  std::string lower = value;
+  std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+  return lower.find(token) != std::string::npos;
+}
+
+struct ParsedUrl {
+  std::string endpoint;   // tcp://host:port or tls://host:port
+  std::string host;       // Host header
+  std::string path;       // Request target incl. query
+  std::string authorization;
+};
+
+int ParseUrl(const std::string& url, ParsedUrl* out) {
+  char proto[16];
+  char auth[1024];
+  char host[1024];
+  char path[4096];
+  int port = -1;
+  av_url_split(proto, sizeof(proto), auth, sizeof(auth), host, sizeof(host), &port, path, sizeof(path), url.c_str());
+
+  bool tls;
+  if (strcmp(proto, "http") == 0) {
+    tls = false;
+  } else if (strcmp(proto, "https") == 0) {
+    tls = true;
+  } else {
+    return AVERROR(EPROTONOSUPPORT);
+  }
+  if (!host[0]) {
+    return AVERROR(EINVAL);
+  }
+
+  int default_port = tls ? 443 : 80;
+  std::string hostname = strchr(host, ':') ? std::string("[") + host + "]" : std::string(host);
+  out->endpoint = std::string(tls ? "tls://" : "tcp://") + hostname + ":" + std::to_string(port > 0 ? port : default_port);
+  out->host = port > 0 && port != default_port ? hostname + ":" + std::to_string(port) : hostname;
+  out->path = path[0] == '/' ? std::string(path) : "/" + std::string(path);
+
+  out->authorization.clear();
+  if (auth[0]) {
+    size_t length = strlen(auth);
+    std::vector<char> encoded(AV_BASE64_SIZE(length));
+    if (av_base64_encode(encoded.data(), static_cast<int>(encoded.size()), reinterpret_cast<const uint8_t*>(auth), static_cast<int>(length))) {
+      out->authorization = std::string("Authorization: Basic ") + encoded.data() + "\r\n";
+    }
+  }
+  return 0;
+}
+
+std::string ResolveUrl(const std::string& base, const std::string& location) {
+  if (location.find("://") != std::string::npos) {
+    return location;
+  }
+  size_t scheme = base.find("://");
+  if (scheme == std::string::npos) {
+    return location;
+  }
+  if (location.compare(0, 2, "//") == 0) {
+    return base.substr(0, scheme + 1) + location;
+  }
+  size_t host_end = base.find_first_of("/?", scheme + 3);
+  std::string origin = host_end == std::string::npos ? base : base.substr(0, host_end);
+  if (!location.empty() && location[0] == '/') {
+    return origin + location;
+  }
+  std::string path = host_end == std::string::npos ? "/" : base.substr(host_end, base.find('?', host_end) - host_end);
+  return origin + path.substr(0, path.rfind('/') + 1) + location;
+}
+
+int StatusError(int status) {
+  switch (status) {
+    case 400: return AVERROR_HTTP_BAD_REQUEST;
+    case 401: return AVERROR_HTTP_UNAUTHORIZED;
+    case 403: return AVERROR_HTTP_FORBIDDEN;
+    case 404: return AVERROR_HTTP_NOT_FOUND;
+    default:
+      if (status >= 400 && status < 500) {
+        return AVERROR_HTTP_OTHER_4XX;
+      }
+      if (status >= 500) {
+        return AVERROR_HTTP_SERVER_ERROR;
+      }
+      return AVERROR(EIO);
+  }
+}
+
+int SeekFile(FILE* file, int64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+} // namespace
+
+// HttpConnection
+
+int HttpConnection::Connect(const std::string& endpoint) {
+  Close();
+
+  AVDictionary* options = nullptr;
+  av_dict_set_int(&options, "rw_timeout", timeout_, 0);
+  av_dict_set(&options, "tcp_nodelay", "1", 0);
+  int ret = avio_open2(&io_, endpoint.c_str(), AVIO_FLAG_READ_WRITE, interrupt_, &options);
+  av_dict_free(&options);
+  if (ret < 0) {
+    io_ = nullptr;
+    return ret;
+  }
+
+  endpoint_ = endpoint;
+  buf_.resize(kReceiveBufferSize);
+  buf_pos_ = buf_end_ = 0;
+  body_done_ = true;
+  keep_alive_ = true;
+  if (opened_) {
+    (*opened_)++;
+  }
+  return 0;
+}
+
+void HttpConnection::Close() {
+  if (io_) {
+    avio_closep(&io_);
+  }
+  endpoint_.clear();
+  buf_pos_ = buf_end_ = 0;
+  body_done_ = true;
+  keep_alive_ = false;
+}
+
+int HttpConnection::Fill() {
+  if (!io_) {
+    return AVERROR(ENOTCONN);
+  }
+  if (buf_pos_ == buf_end_) {
+    buf_pos_ = buf_end_ = 0;
+  } else if (buf_end_ == buf_.size()) {
+    memmove(buf_.data(), buf_.data() + buf_pos_, buf_end_ - buf_pos_);
+    buf_end_ -= buf_pos_;
+    buf_pos_ = 0;
+  }
+  int ret = avio_read_partial(io_, buf_.data() + buf_end_, static_cast<int>(buf_.size() - buf_end_));
+  if (ret == AVERROR_EOF || ret == 0) {
+    return 0;
+  }
+  if (ret < 0) {
+    return ret;
+  }
+  buf_end_ += ret;
+  return ret;
+}
+
+int HttpConnection::ReadLine(std::string* line) {
+  line->clear();
+  for (;;) {
+    uint8_t* start = buf_.data() + buf_pos_;
+    uint8_t* newline = static_cast<uint8_t*>(memchr(start, '\n', buf_end_ - buf_pos_));
+    if (newline) {
+      size_t length = newline - start;
+      line->append(reinterpret_cast<char*>(start), length);
+      buf_pos_ += length + 1;
+      if (!line->empty() && line->back() == '\r') {
+        line->pop_back();
+      }
+      return 0;
+    }
+    line->append(reinterpret_cast<char*>(start), buf_end_ - buf_pos_);
+    buf_pos_ = buf_end_;
+    if (line->size() > kMaxLineLength) {
+      return AVERROR_INVALIDDATA;
+    }
+    int ret = Fill();
+    if (ret <= 0) {
+      return ret < 0 ? ret : AVERROR_EOF;
+    }
+  }
+}
+
+int HttpConnection::ReadResponse(Response* response) {
+  std::string line;
+  int ret;
+
+  // Skip interim 1xx responses
+  do {
+    *response = Response();
+    if ((ret = ReadLine(&line)) < 0) {
+      return ret;
+    }
+    if (line.compare(0, 5, "HTTP/") != 0) {
+      return AVERROR_INVALIDDATA;
+    }
+    size_t space = line.find(' ');
+    if (space == std::string::npos) {
+      return AVERROR_INVALIDDATA;
+    }
+    response->status = atoi(line.c_str() + space + 1);
+    response->keep_alive = line.compare(0, 8, "HTTP/1.0") != 0;
+
+    for (;;) {
+      if ((ret = ReadLine(&line)) < 0) {
+        return ret;
+      }
+      if (line.empty()) {
+        break;
+      }
+      size_t colon = line.find(':');
+      if (colon == std::string::npos) {
+        continue;
+      }
+      size_t value_start = line.find_first_not_of(" \t", colon + 1);
+      std::string value = value_start == std::string::npos ? std::string() : line.substr(value_start);
+
+      if (HeaderIs(line, colon, "content-length")) {
+        response->content_length = strtoll(value.c_str(), nullptr, 10);
+      } else if (HeaderIs(line, colon, "content-range")) {
+        // bytes <start>-<end>/<total> or bytes */<total>
+        const char* range = value.c_str() + (value.compare(0, 6, "bytes ") == 0 ? 6 : 0);
+        if (*range != '*') {
+          response->range_start = strtoll(range, nullptr, 10);
+        }
+        const char* slash = strchr(range, '/');
+        if (slash && slash[1] != '*') {
+          response->total_size = strtoll(slash + 1, nullptr, 10);
+        }
+      } else if (HeaderIs(line, colon, "transfer-encoding")) {
+        response->chunked = ContainsToken(value, "chunked");
+      } else if (HeaderIs(line, colon, "connection")) {
+        if (ContainsToken(value, "close")) {
+          response->keep_alive = false;
+        } else if (ContainsToken(value, "keep-alive")) {
+          response->keep_alive = true;
+        }
+      } else if (HeaderIs(line, colon, "location")) {
+        response->location = value;
+      }
+    }
+  } while (response->status >= 100 && response->status < 200);
+
+  if (response->status == 200 && !response->chunked) {
+    response->total_size = response->content_length;
+  }
+
+  // Set up body framing
+  keep_alive_ = response->keep_alive;
+  body_chunked_ = response->chunked;
+  if (response->status == 204 || response->status == 304) {
+    body_left_ = 0;
+    body_done_ = true;
+  } else if (body_chunked_) {
+    body_left_ = 0;
+    body_done_ = false;
+  } else if (response->content_length >= 0) {
+    body_left_ = response->content_length;
+    body_done_ = body_left_ == 0;
+  } else {
+    // Body ends when the server closes the connection
+    body_left_ = -1;
+    body_done_ = false;
+    keep_alive_ = false;
+  }
+  return 0;
+}
+
+int HttpConnection::Request(const std::string& url, const std::string& extra_headers, int64_t range_start, int64_t range_end, Response* response, bool* reused) {
+  ParsedUrl parsed;
+  int ret = ParseUrl(url, &parsed);
+  if (ret < 0) {
+    return ret;
+  }
+
+  std::string request = "GET " + parsed.path + " HTTP/1.1\r\nHost: " + parsed.host + "\r\n";
+  if (range_start >= 0) {
+    request += "Range: bytes=" + std::to_string(range_start) + "-" + (range_end >= range_start ? std::to_string(range_end) : std::string()) + "\r\n";
+  }
+  request += "Accept: */*\r\nAccept-Encoding: identity\r\nConnection: keep-alive\r\n";
+  request += parsed.authorization;
+  request += extra_headers;
+  request += "\r\n";
+
+  // A kept-alive connection may have been closed by the server meanwhile, retry once on a new one
+  bool reuse = io_ && endpoint_ == parsed.endpoint && body_done_ && keep_alive_;
+  for (int attempt = 0; attempt < 2; attempt++) {
+    if (!reuse && (ret = Connect(parsed.endpoint)) < 0) {
+      return ret;
+    }
+    avio_write(io_, reinterpret_cast<const unsigned char*>(request.data()), static_cast<int>(request.size()));
+    avio_flush(io_);
+    ret = io_->error < 0 ? io_->error : ReadResponse(response);
+    if (ret >= 0) {
+      if (reused) {
+        *reused = reuse;
+      }
+      return 0;
+    }
+    Close();
+    if (!reuse) {
+      break;
+    }
+    reuse = false;
+  }
+  return ret;
+}
+
+int HttpConnection::ReadBody(uint8_t* buf, int size) {
+  if (body_done_ || size <= 0) {
+    return 0;
+  }
+
+  int ret;
+  if (body_chunked_ && body_left_ == 0) {
+    std::string line;
+    if ((ret = ReadLine(&line)) < 0) {
+      return ret;
+    }
+    body_left_ = strtoll(line.c_str(), nullptr, 16);
+    if (body_left_ < 0) {
+      return AVERROR_INVALIDDATA;
+    }
+    if (body_left_ == 0) {
+      // Skip trailers
+      do {
+        if ((ret = ReadLine(&line)) < 0) {
+          return ret;
+        }
+      } while (!line.empty());
+      body_done_ = true;
+      return 0;
+    }
+  }
+
+  if (buf_pos_ == buf_end_) {
+    ret = Fill();
+    if (ret < 0) {
+      return ret;
+    }
+    if (ret == 0) {
+      if (body_left_ < 0) {
+        body_done_ = true;
+        return 0;
+      }
+      return AVERROR(EIO);
+    }
+  }
+
+  size_t length = std::min(static_cast<size_t>(size), buf_end_ - buf_pos_);
+  if (body_left_ >= 0) {
+    length = std::min(length, static_cast<size_t>(body_left_));
+  }
+  memcpy(buf, buf_.data() + buf_pos_, length);
+  buf_pos_ += length;
+
+  if (body_left_ > 0) {
+    body_left_ -= static_cast<int64_t>(length);
+    if (body_left_ == 0) {
+      if (body_chunked_) {
+        std::string line;
+        if ((ret = ReadLine(&line)) < 0) {
+          return ret;
+        }
+      } else {
+        body_done_ = true;
+      }
+    }
+  }
+  return static_cast<int>(length);
+}
+
+int HttpConnection::ReadBodyFully(uint8_t* buf, int size) {
+  int done = 0;
+  while (done < size) {
+    int ret = ReadBody(buf + done, size - done);
+    if (ret < 0) {
+      return ret;
+    }
+    if (ret == 0) {
+      return AVERROR(EIO);
+    }
+    done += ret;
+  }
+  return done;
+}
+
+// HttpIO
+
+HttpIO::~HttpIO() {
+  Close();
+}
+
+int HttpIO::Interrupted(void* opaque) {
+  return static_cast<HttpIO*>(opaque)->stop_.load() ? 1 : 0;
+}
+
+int HttpIO::Open(const std::string& url, const HttpIOOptions& options, std::unique_ptr<HttpIO>* out) {
+  std::unique_ptr<HttpIO> io(new HttpIO());
+  io->options_ = options;
+  io->options_.connections = std::max(1, std::min(options.connections, 32));
+  io->options_.prefetch = std::max(0, options.prefetch);
+  io->block_size_ = static_cast<size_t>(std::max(options.block_size, 16 * 1024));
+  // Keep the prefetch window plus the block being read in memory
+  io->options_.cache_size = std::max<int64_t>(options.cache_size,
+    static_cast<int64_t>(io->block_size_) * (io->options_.prefetch + io->options_.connections + 1));
+  io->window_ = io->options_.prefetch;
+  io->interrupt_.callback = Interrupted;
+  io->interrupt_.opaque = io.get();
+
+  io->extra_headers_ = "User-Agent: " + (options.user_agent.empty() ? std::string(LIBAVFORMAT_IDENT) : options.user_agent) + "\r\n";
+  if (!options.headers.empty()) {
+    io->extra_headers_ += options.headers;
+    if (io->extra_headers_.compare(io->extra_headers_.size() - 2, 2, "\r\n") != 0) {
+      io->extra_headers_ += "\r\n";
+    }
+  }
+
+  // Probe with the first block: learns the size and range support and already
+  // holds the bytes the demuxer reads first
+  auto connection = std::make_unique<HttpConnection>(&io->interrupt_, options.timeout, &io->opened_);
+  HttpConnection::Response response;
+  std::string current = url;
+  int ret;
+  for (int redirects = 0;; redirects++) {
+    ret = connection->Request(current, io->extra_headers_, 0, static_cast<int64_t>(io->block_size_) - 1, &response, nullptr);
+    if (ret < 0) {
+      return ret;
+    }
+    io->requests_++;
+    if (response.status < 300 || response.status >= 400 || response.location.empty()) {
+      break;
+    }
+    if (redirects == kMaxRedirects) {
+      return AVERROR(ELOOP);
+    }
+    connection->Close();
+    current = ResolveUrl(current, response.location);
+    io->stats_.redirects++;
+  }
+  io->url_ = current;
+
+  if (response.status == 206 && response.total_size >= 0) {
+    if (response.range_start != 0) {
+      return AVERROR_INVALIDDATA;
+    }
+    io->ranged_ = true;
+    io->size_ = response.total_size;
+
+    auto first = std::make_shared<std::vector<uint8_t>>(io->BlockLength(0));
+    if ((ret = connection->ReadBodyFully(first->data(), static_cast<int>(first->size()))) < 0) {
+      return ret;
+    }
+    io->bytes_fetched_ += first->size();
+    io->Store(0, first);
+  } else if (response.status == 416) {
+    // Empty resource
+    io->ranged_ = true;
+    io->size_ = 0;
+  } else if (response.status == 200 || response.status == 206) {
+    // Range ignored (or unknown size): stream the response as is
+    io->size_ = response.status == 200 ? response.total_size : -1;
+    io->stream_ = std::move(connection);
+    *out = std::move(io);
+    return 0;
+  } else {
+    return StatusError(response.status);
+  }
+
+  if (options.disk_cache_size > 0) {
+    io->disk_ = tmpfile();
+  }
+
+  io->connections_.push_back(std::move(connection));
+  for (int i = 1; i < io->options_.connections; i++) {
+    io->connections_.push_back(std::make_unique<HttpConnection>(&io->interrupt_, options.timeout, &io->opened_));
+  }
+  HttpIO* self = io.get();
+  for (auto& worker_connection : io->connections_) {
+    HttpConnection* conn = worker_connection.get();
+    io->workers_.emplace_back([self, conn]() { self->WorkerLoop(conn); });
+  }
+
+  *out = std::move(io);
+  return 0;
+}
+
+int64_t HttpIO::BlockLength(int64_t index) const {
+  int64_t start = index * static_cast<int64_t>(block_size_);
+  return std::max<int64_t>(0, std::min<int64_t>(block_size_, size_ - start));
+}
+
+void HttpIO::WorkerLoop(HttpConnection* connection) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stop_) {
+    if (queue_.empty()) {
+      work_cv_.wait(lock);
+      continue;
+    }
+    int64_t index = queue_.front();
+    queue_.pop_front();
+    auto it = blocks_.find(index);
+    if (it == blocks_.end() || it->second.state != BLOCK_QUEUED) {
+      continue;
+    }
+    it->second.state = BLOCK_FETCHING;
+    lock.unlock();
+
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    int ret = Fetch(connection, index, data.get());
+    bool on_disk = ret >= 0 && disk_ && WriteDisk(index, *data) >= 0;
+
+    lock.lock();
+    Block& block = blocks_[index];
+    if (ret < 0) {
+      block.state = BLOCK_FAILED;
+      block.error = ret;
+    } else {
+      block.on_disk = on_disk;
+      Store(index, data);
+    }
+    ready_cv_.notify_all();
+  }
+}
+
+int HttpIO::Fetch(HttpConnection* connection, int64_t index, std::vector<uint8_t>* data) {
+  int64_t start = index * static_cast<int64_t>(block_size_);
+  int64_t length = BlockLength(index);
+  int ret = AVERROR(EIO);
+
+  for (int attempt = 0; attempt < 2 && !stop_; attempt++) {
+    HttpConnection::Response response;
+    bool reused = false;
+    ret = connection->Request(url_, extra_headers_, start, start + length - 1, &response, &reused);
+    if (ret >= 0) {
+      requests_++;
+      if (reused) {
+        reused_++;
+      }
+      if (response.status != 206 || response.range_start != start) {
+        ret = response.status >= 400 ? StatusError(response.status) : AVERROR(EIO);
+      } else {
+        data->resize(length);
+        ret = connection->ReadBodyFully(data->data(), static_cast<int>(length));
+      }
+      if (ret >= 0) {
+        bytes_fetched_ += length;
+        return 0;
+      }
+    }
+    connection->Close();
+  }
+  return ret;
+}
+
+void HttpIO::Store(int64_t index, std::shared_ptr<std::vector<uint8_t>> data) {
+  Block& block = blocks_[index];
+  block.state = BLOCK_READY;
+  if (block.in_lru) {
+    memory_bytes_ -= static_cast<int64_t>(block.data->size());
+    lru_.erase(block.lru);
+  }
+  memory_bytes_ += static_cast<int64_t>(data->size());
+  block.data = std::move(data);
+  lru_.push_front(index);
+  block.lru = lru_.begin();
+  block.in_lru = true;
+  Evict();
+}
+
+void HttpIO::Evict() {
+  while (memory_bytes_ > options_.cache_size && lru_.size() > 1) {
+    int64_t index = lru_.back();
+    lru_.pop_back();
+    Block& block = blocks_[index];
+    memory_bytes_ -= static_cast<int64_t>(block.data->size());
+    block.data.reset();
+    block.in_lru = false;
+    if (!block.on_disk) {
+      blocks_.erase(index);
+    }
+  }
+}
+
+void HttpIO::Schedule(int64_t index, int window) {
+  bool queued = false;
+  for (int64_t i = index; i <= index + window; i++) {
+    if (BlockLength(i) <= 0) {
+      break;
+    }
+    auto it = blocks_.find(i);
+    if (it != blocks_.end()) {
+      if (i == index && it->second.state == BLOCK_QUEUED) {
+        // Needed now: move to the front
+        queue_.erase(std::find(queue_.begin(), queue_.end(), i));
+        queue_.push_front(i);
+      }
+      continue;
+    }
+    blocks_[i].state = BLOCK_QUEUED;
+    if (i == index) {
+      queue_.push_front(i);
+    } else {
+      queue_.push_back(i);
+    }
+    queued = true;
+  }
+  if (queued) {
+    work_cv_.notify_all();
+  }
+}
+
+int HttpIO::WriteDisk(int64_t index, const std::vector<uint8_t>& data) {
+  std::lock_guard<std::mutex> lock(disk_mutex_);
+  if (disk_bytes_ + static_cast<int64_t>(data.size()) > options_.disk_cache_size) {
+    return AVERROR(ENOSPC);
+  }
+  if (SeekFile(disk_, index * static_cast<int64_t>(block_size_)) != 0 ||
+      fwrite(data.data(), 1, data.size(), disk_) != data.size()) {
+    return AVERROR(EIO);
+  }
+  disk_bytes_ += static_cast<int64_t>(data.size());
+  return 0;
+}
+
+int HttpIO::ReadDisk(int64_t index, std::vector<uint8_t>* data) {
+  std::lock_guard<std::mutex> lock(disk_mutex_);
+  data->resize(BlockLength(index));
+  if (SeekFile(disk_, index * static_cast<int64_t>(block_size_)) != 0 ||
+      fread(data->data(), 1, data->size(), disk_) != data->size()) {
+    return AVERROR(EIO);
+  }
+  return 0;
+}
+
+int HttpIO::Read(uint8_t* buf, int size) {
+  if (size <= 0) {
+    return 0;
+  }
+
+  if (!ranged_) {
+    if (!stream_) {
+      return AVERROR_EOF;
+    }
+    int ret = stream_->ReadBody(buf, size);
+    if (ret <= 0) {
+      return ret < 0 ? ret : AVERROR_EOF;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    pos_ += ret;
+    stats_.bytes_read += ret;
+    bytes_fetched_ += ret;
+    return ret;
+  }
+
+  if (pos_ >= size_) {
+    return AVERROR_EOF;
+  }
+
+  int64_t index = pos_ / static_cast<int64_t>(block_size_);
+  size_t offset = static_cast<size_t>(pos_ - index * static_cast<int64_t>(block_size_));
+
+  if (index == last_index_ + 1) {
+    window_ = std::min(std::max(window_ * 2, 1), options_.prefetch);
+  }
+  last_index_ = index;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  Schedule(index, window_);
+
+  int64_t wait_start = 0;
+  auto it = blocks_.find(index);
+  while (!stop_ && (it->second.state == BLOCK_QUEUED || it->second.state == BLOCK_FETCHING)) {
+    if (!wait_start) {
+      wait_start = NowUs();
+    }
+    ready_cv_.wait(lock);
+    it = blocks_.find(index);
+  }
+  if (wait_start) {
+    stats_.misses++;
+    stats_.wait_us += NowUs() - wait_start;
+  }
+  // Closed while waiting, the workers are gone and the range never arrives
+  if (stop_) {
+    return AVERROR_EXIT;
+  }
+
+  if (it->second.state == BLOCK_FAILED) {
+    int error = it->second.error;
+    blocks_.erase(it);
+    return error;
+  }
+
+  std::shared_ptr<std::vector<uint8_t>> data = it->second.data;
+  if (data) {
+    if (!wait_start) {
+      stats_.memory_hits++;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+  } else {
+    // Evicted from memory, still in the disk cache
+    lock.unlock();
+    data = std::make_shared<std::vector<uint8_t>>();
+    int ret = ReadDisk(index, data.get());
+    lock.lock();
+    if (ret < 0) {
+      blocks_.erase(index);
+      return ret;
+    }
+    stats_.disk_hits++;
+    Store(index, data);
+  }
+
+  size_t length = std::min(static_cast<size_t>(size), data->size() - offset);
+  stats_.bytes_read += length;
+  lock.unlock();
+
+  memcpy(buf, data->data() + offset, length);
+  pos_ += static_cast<int64_t>(length);
+  return static_cast<int>(length);
+}
+
+int64_t HttpIO::Seek(int64_t offset, int whence) {
+  if (whence & AVSEEK_SIZE) {
+    return size_ >= 0 ? size_ : AVERROR(ENOSYS);
+  }
+
+  int64_t target;
+  switch (whence & ~AVSEEK_FORCE) {
+    case SEEK_SET: target = offset; break;
+    case SEEK_CUR: target = pos_ + offset; break;
+    case SEEK_END:
+      if (size_ < 0) {
+        return AVERROR(ENOSYS);
+      }
+      target = size_ + offset;
+      break;
+    default: return AVERROR(EINVAL);
+  }
+  if (target < 0) {
+    return AVERROR(EINVAL);
+  }
+  if (!ranged_) {
+    return target == pos_ ? pos_ : AVERROR(ENOSYS);
+  }
+
+  // Random access: restart with a small readahead window and drop queued
+  // prefetches outside of it
+  int64_t first = target / static_cast<int64_t>(block_size_);
+  if (first != last_index_ && first != last_index_ + 1) {
+    window_ = std::min(1, options_.prefetch);
+    last_index_ = first;
+  }
+  int64_t last = first + window_;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto it = queue_.begin(); it != queue_.end();) {
+    if (*it < first || *it > last) {
+      blocks_.erase(*it);
+      stats_.cancelled++;
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  pos_ = target;
+  return pos_;
+}
+
+int HttpIO::Close() {
+  stop_ = true;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    work_cv_.notify_all();
+    ready_cv_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  connections_.clear();
+  stream_.reset();
+  if (disk_) {
+    fclose(disk_);
+    disk_ = nullptr;
+  }
+  return 0;
+}
+
+HttpIOStats HttpIO::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  HttpIOStats stats = stats_;
+  stats.requests = requests_.load();
+  stats.reused = reused_.load();
+  stats.bytes_fetched = bytes_fetched_.load();
+  stats.connections = opened_.load();
+  return stats;
+}
+
+int HttpIO::ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
+  return static_cast<HttpIO*>(opaque)->Read(buf, buf_size);
+}
+
+int64_t HttpIO::SeekPacket(void* opaque, int64_t offset, int whence) {
+  return static_cast<HttpIO*>(opaque)->Seek(offset, whence);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,195 @@
+#ifndef FFMPEG_HTTP_IO_H
+#define FFMPEG_HTTP_IO_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avio.h>
+}
+
+namespace ffmpeg {
+
+struct HttpIOOptions {
+  int connections = 4;                    // Parallel keep-alive connections
+  int block_size = 512 * 1024;            // Bytes per range request
+  int prefetch = 8;                       // Blocks requested ahead of the read position
+  int64_t cache_size = 32 * 1024 * 1024;  // Memory cache limit in bytes
+  int64_t disk_cache_size = 0;            // Temporary file cache limit in bytes, 0 disables
+  int64_t timeout = 10000000;             // Socket read/write timeout in microseconds
+  std::string user_agent;
+  std::string headers;                    // Extra request headers, "Name: value\r\n" separated
+};
+
+struct HttpIOStats {
+  uint64_t bytes_read = 0;        // Bytes handed to FFmpeg
+  uint64_t bytes_fetched = 0;     // Response body bytes received
+  uint64_t requests = 0;          // HTTP requests sent
+  uint64_t connections = 0;       // TCP/TLS connections opened
+  uint64_t reused = 0;            // Requests sent on an already open connection
+  uint64_t memory_hits = 0;       // Reads served from a cached block
+  uint64_t disk_hits = 0;         // Reads served from the disk cache
+  uint64_t misses = 0;            // Reads that had to wait for a fetch
+  uint64_t cancelled = 0;         // Queued prefetches dropped by seeks
+  uint64_t redirects = 0;
+  uint64_t wait_us = 0;           // Time FFmpeg spent waiting for fetches
+};
+
+/**
+ * Persistent HTTP/1.1 connection on top of FFmpeg's tcp:// or tls:// protocol.
+ *
+ * Sends GET requests (optionally with a Range) and reads the response body
+ * with Content-Length or chunked framing. Kept open between requests unless
+ * the server closes it.
+ */
+class HttpConnection {
+public:
+  struct Response {
+    int status = 0;
+    int64_t content_length = -1;  // -1 when unknown (chunked or read until close)
+    int64_t range_start = -1;     // From Content-Range
+    int64_t total_size = -1;      // From Content-Range or Content-Length of a 200
+    bool chunked = false;
+    bool keep_alive = true;
+    std::string location;
+  };
+
+  HttpConnection(const AVIOInterruptCB* interrupt, int64_t timeout, std::atomic<uint64_t>* opened)
+    : interrupt_(interrupt), timeout_(timeout), opened_(opened) {}
+  ~HttpConnection() { Close(); }
+
+  // Send a request, range_end is inclusive, range_start < 0 requests the whole resource
+  int Request(const std::string& url, const std::string& extra_headers, int64_t range_start, int64_t range_end, Response* response, bool* reused);
+  // Read up to size body bytes, 0 at the end of the body
+  int ReadBody(uint8_t* buf, int size);
+  // Read exactly size body bytes
+  int ReadBodyFully(uint8_t* buf, int size);
+  void Close();
+
+private:
+  int Connect(const std::string& endpoint);
+  int Fill();
+  int ReadLine(std::string* line);
+  int ReadResponse(Response* response);
+
+  const AVIOInterruptCB* interrupt_;
+  int64_t timeout_;
+  std::atomic<uint64_t>* opened_;
+  AVIOContext* io_ = nullptr;
+  std::string endpoint_;          // tcp://host:port or tls://host:port
+  std::vector<uint8_t> buf_;
+  size_t buf_pos_ = 0;
+  size_t buf_end_ = 0;
+
+  // Body state of the current response
+  bool body_chunked_ = false;
+  int64_t body_left_ = 0;         // Bytes left in the body or current chunk, -1 until close
+  bool body_done_ = true;
+  bool keep_alive_ = false;
+};
+
+/**
+ * HTTP input backend for custom AVIOContexts.
+ *
+ * Splits the resource into blocks fetched with byte-range requests by a pool
+ * of worker threads, each owning one keep-alive connection. Blocks ahead of
+ * the read position are prefetched in parallel; the block FFmpeg needs next
+ * jumps the queue. The readahead window shrinks after a seek and doubles
+ * with every sequential block up to `prefetch`. Fetched blocks stay in an LRU memory cache and optionally
+ * in a temporary file, so seeks back (moov at the end, index lookups) are
+ * served locally. Seeks cancel queued prefetches that did not start yet.
+ *
+ * Servers that ignore Range requests are streamed sequentially.
+ */
+class HttpIO {
+public:
+  ~HttpIO();
+
+  static int Open(const std::string& url, const HttpIOOptions& options, std::unique_ptr<HttpIO>* out);
+
+  int Read(uint8_t* buf, int size);
+  int64_t Seek(int64_t offset, int whence);
+  int Close();
+
+  bool Seekable() const { return ranged_; }
+  int64_t Size() const { return size_; }
+  HttpIOStats GetStats();
+
+  // AVIOContext callbacks, opaque is the HttpIO
+  static int ReadPacket(void* opaque, uint8_t* buf, int buf_size);
+  static int64_t SeekPacket(void* opaque, int64_t offset, int whence);
+
+private:
+  enum BlockState { BLOCK_QUEUED, BLOCK_FETCHING, BLOCK_READY, BLOCK_FAILED };
+
+  struct Block {
+    BlockState state = BLOCK_QUEUED;
+    std::shared_ptr<std::vector<uint8_t>> data;   // Null when only on disk
+    bool on_disk = false;
+    int error = 0;
+    std::list<int64_t>::iterator lru;
+    bool in_lru = false;
+  };
+
+  HttpIO() = default;
+
+  void WorkerLoop(HttpConnection* connection);
+  int Fetch(HttpConnection* connection, int64_t index, std::vector<uint8_t>* data);
+  void Schedule(int64_t index, int window);
+  void Store(int64_t index, std::shared_ptr<std::vector<uint8_t>> data);
+  void Evict();
+  int WriteDisk(int64_t index, const std::vector<uint8_t>& data);
+  int ReadDisk(int64_t index, std::vector<uint8_t>* data);
+  int64_t BlockLength(int64_t index) const;
+  static int Interrupted(void* opaque);
+
+  std::string url_;               // After redirects
+  std::string extra_headers_;
+  HttpIOOptions options_;
+  AVIOInterruptCB interrupt_{};
+  std::atomic<bool> stop_{false};
+  std::atomic<uint64_t> opened_{0};
+
+  bool ranged_ = false;
+  int64_t size_ = -1;
+  int64_t pos_ = 0;
+  size_t block_size_ = 0;
+  int64_t last_index_ = -1;       // Block of the previous read
+  int window_ = 0;                // Current readahead in blocks, grows on sequential reads
+
+  // Sequential fallback
+  std::unique_ptr<HttpConnection> stream_;
+
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable ready_cv_;
+  std::deque<int64_t> queue_;
+  std::unordered_map<int64_t, Block> blocks_;
+  std::list<int64_t> lru_;        // Blocks with data in memory, most recent first
+  int64_t memory_bytes_ = 0;
+  std::vector<std::unique_ptr<HttpConnection>> connections_;
+  std::vector<std::thread> workers_;
+
+  std::mutex disk_mutex_;
+  FILE* disk_ = nullptr;
+  int64_t disk_bytes_ = 0;
+
+  HttpIOStats stats_;
+  std::atomic<uint64_t> requests_{0};
+  std::atomic<uint64_t> reused_{0};
+  std::atomic<uint64_t> bytes_fetched_{0};
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_HTTP_IO_H
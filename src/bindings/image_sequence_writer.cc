@@ -0,0 +1,491 @@
+#include "image_sequence_writer.h"
+#include "common.h"
+
+#include <algorithm>
+#include <cstring>
+
+extern "C" {
+#include <libavformat/avformat.h>
+#include <libavformat/avio.h>
+#include <libavutil/error.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference ImageSequenceWriter::constructor;
+
+// Upper bound for the number of encoder instances
+static constexpr int kMaxImageWorkers = 64;
+
+Napi::Object ImageSequenceWriter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "ImageSequenceWriter", {
+    // Lifecycle
+    InstanceMethod<&ImageSequenceWriter::OpenAsync>("open"),
+    InstanceMethod<&ImageSequenceWriter::OpenSync>("openSync"),
+    InstanceMethod<&ImageSequenceWriter::CloseAsync>("close"),
+    InstanceMethod<&ImageSequenceWriter::CloseSync>("closeSync"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &ImageSequenceWriter::Dispose),
+
+    // Writing
+    InstanceMethod<&ImageSequenceWriter::WriteAsync>("write"),
+    InstanceMethod<&ImageSequenceWriter::WriteSync>("writeSync"),
+    InstanceMethod<&ImageSequenceWriter::ReadResults>("readResults"),
+    InstanceMethod<&ImageSequenceWriter::GetStats>("getStats"),
+
+    // Properties
+    InstanceAccessor<&ImageSequenceWriter::GetWorkers>("workers"),
+    InstanceAccessor<&ImageSequenceWriter::GetPending>("pending"),
+    InstanceAccessor<&ImageSequenceWriter::GetIsOpen>("isOpen"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ImageSequenceWriter", func);
+  return exports;
+}
+
+ImageSequenceWriter::ImageSequenceWriter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ImageSequenceWriter>(info) {
+  // Constructor does nothing - user must explicitly call open()
+}
+
+ImageSequenceWriter::~ImageSequenceWriter() {
+  // Stop worker threads, discarding queued images
+  CloseInternal(false);
+}
+
+// === Internal ===
+
+int ImageSequenceWriter::OpenInternal(const ImageSequenceWriterConfig& config, const AVDictionary* options) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (is_open_) {
+      return AVERROR(EINVAL);
+    }
+  }
+
+  // A sequence needs a number field, image2's single-file update mode is not supported
+  char filename[4096];
+  if (config.pattern.empty() || config.start_number < 0 ||
+      av_get_frame_filename2(filename, sizeof(filename), config.pattern.c_str(), config.start_number, 0) < 0) {
+    return AVERROR(EINVAL);
+  }
+
+  const AVCodec* codec = nullptr;
+  if (!config.encoder.empty()) {
+    codec = avcodec_find_encoder_by_name(config.encoder.c_str());
+  } else {
+    // Same extension mapping as the image2 muxer
+    const AVOutputFormat* image2 = av_guess_format("image2", nullptr, nullptr);
+    AVCodecID id = image2 ? av_guess_codec(image2, nullptr, config.pattern.c_str(), nullptr, AVMEDIA_TYPE_VIDEO)
+                          : AV_CODEC_ID_NONE;
+    if (id == AV_CODEC_ID_NONE) {
+      return AVERROR(EINVAL);
+    }
+    codec = avcodec_find_encoder(id);
+  }
+  if (!codec || codec->type != AVMEDIA_TYPE_VIDEO) {
+    return AVERROR_ENCODER_NOT_FOUND;
+  }
+
+  int count = std::clamp(config.workers, 1, kMaxImageWorkers);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  config_ = config;
+  config_.workers = count;
+  config_.max_pending = config.max_pending > 0 ? config.max_pending : count * 2;
+  codec_ = codec;
+  av_dict_free(&options_);
+  if (options) {
+    av_dict_copy(&options_, options, 0);
+  }
+
+  results_.clear();
+  stats_ = ImageSequenceStats();
+  next_seq_ = 0;
+  next_report_seq_ = 0;
+  in_flight_ = 0;
+  first_error_ = 0;
+  stopping_ = false;
+  is_open_ = true;
+
+  // Encoders are opened by each worker from the first frame it receives
+  for (int i = 0; i < count; i++) {
+    Worker* worker = new Worker();
+    workers_.push_back(worker);
+    worker->thread = std::thread(&ImageSequenceWriter::WorkerLoop, this, worker);
+  }
+
+  return 0;
+}
+
+int ImageSequenceWriter::WriteInternal(const AVFrame* frame) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (!is_open_ || stopping_) {
+    return AVERROR(EINVAL);
+  }
+
+  if (!frame || !frame->data[0] || frame->hw_frames_ctx || frame->width <= 0 || frame->height <= 0 ||
+      !av_pix_fmt_desc_get(static_cast<AVPixelFormat>(frame->format))) {
+    return AVERROR(EINVAL);
+  }
+
+  // Bounded concurrency: wait until an image is done
+  done_cv_.wait(lock, [&] { return !is_open_ || stopping_ || in_flight_ < config_.max_pending; });
+  if (!is_open_ || stopping_) {
+    return AVERROR_EXIT;
+  }
+
+  // Reference, not a copy: the caller may free or reuse the frame right away
+  AVFrame* ref = av_frame_clone(frame);
+  if (!ref) {
+    return AVERROR(ENOMEM);
+  }
+
+  jobs_.push_back({ next_seq_++, ref, std::chrono::steady_clock::now() });
+  in_flight_++;
+  job_cv_.notify_one();
+
+  return 0;
+}
+
+int ImageSequenceWriter::PrepareEncoder(Worker* worker, const AVFrame* frame) {
+  AVPixelFormat src_format = static_cast<AVPixelFormat>(frame->format);
+  AVPixelFormat target = config_.pix_fmt;
+
+  if (target == AV_PIX_FMT_NONE) {
+    const AVPixelFormat* formats = nullptr;
+    int count = 0;
+    int ret = avcodec_get_supported_config(nullptr, codec_, AV_CODEC_CONFIG_PIX_FORMAT, 0,
+                                           (const void**)&formats, &count);
+    if (ret < 0 || !formats || std::find(formats, formats + count, src_format) != formats + count) {
+      target = src_format;
+    } else {
+      std::vector<AVPixelFormat> list(formats, formats + count);
+      list.push_back(AV_PIX_FMT_NONE);
+      const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(src_format);
+      int has_alpha = desc && (desc->flags & AV_PIX_FMT_FLAG_ALPHA);
+      target = avcodec_find_best_pix_fmt_of_list(list.data(), src_format, has_alpha, nullptr);
+    }
+  }
+
+  AVCodecContext* ctx = worker->context;
+  if (ctx && ctx->width == frame->width && ctx->height == frame->height && ctx->pix_fmt == target &&
+      worker->src_format == src_format) {
+    return 0;
+  }
+
+  // First frame or a frame of another size/format: (re)open this worker's encoder
+  avcodec_free_context(&worker->context);
+  sws_freeContext(worker->sws);
+  worker->sws = nullptr;
+  av_frame_free(&worker->converted);
+  worker->src_format = AV_PIX_FMT_NONE;
+
+  ctx = avcodec_alloc_context3(codec_);
+  if (!ctx) {
+    return AVERROR(ENOMEM);
+  }
+
+  ctx->width = frame->width;
+  ctx->height = frame->height;
+  ctx->pix_fmt = target;
+  ctx->time_base = frame->time_base.num > 0 && frame->time_base.den > 0 ? frame->time_base : AVRational{ 1, 25 };
+  ctx->sample_aspect_ratio = frame->sample_aspect_ratio;
+  ctx->color_range = frame->color_range;
+  ctx->color_primaries = frame->color_primaries;
+  ctx->color_trc = frame->color_trc;
+  ctx->colorspace = frame->colorspace;
+  // Parallelism comes from the pool, each instance stays single-threaded
+  ctx->thread_count = 1;
+
+  if (config_.quality >= 0) {
+    ctx->flags |= AV_CODEC_FLAG_QSCALE;
+    ctx->global_quality = FF_QP2LAMBDA * config_.quality;
+  }
+
+  // Limited range JPEG is what image2 output of decoded video usually is
+  const AVPixFmtDescriptor* target_desc = av_pix_fmt_desc_get(target);
+  if (codec_->id == AV_CODEC_ID_MJPEG && ctx->color_range != AVCOL_RANGE_JPEG && target_desc &&
+      !(target_desc->flags & AV_PIX_FMT_FLAG_RGB) && strncmp(target_desc->name, "yuvj", 4) != 0) {
+    ctx->strict_std_compliance = FF_COMPLIANCE_UNOFFICIAL;
+  }
+
+  AVDictionary* opts = nullptr;
+  if (options_) {
+    av_dict_copy(&opts, options_, 0);
+  }
+  int ret = avcodec_open2(ctx, codec_, opts ? &opts : nullptr);
+  av_dict_free(&opts);
+  if (ret < 0) {
+    avcodec_free_context(&ctx);
+    return ret;
+  }
+
+  if (target != src_format) {
+    worker->sws = sws_getContext(frame->width, frame->height, src_format, frame->width, frame->height, target,
+                                 SWS_BICUBIC, nullptr, nullptr, nullptr);
+    worker->converted = av_frame_alloc();
+    if (!worker->sws || !worker->converted) {
+      avcodec_free_context(&ctx);
+      return AVERROR(ENOMEM);
+    }
+    worker->converted->format = target;
+    worker->converted->width = frame->width;
+    worker->converted->height = frame->height;
+    ret = av_frame_get_buffer(worker->converted, 0);
+    if (ret < 0) {
+      avcodec_free_context(&ctx);
+      return ret;
+    }
+  }
+
+  worker->context = ctx;
+  worker->src_format = src_format;
+  return 0;
+}
+
+int ImageSequenceWriter::EncodeImage(Worker* worker, AVFrame* frame, const std::string& filename, int64_t* size) {
+  int ret = PrepareEncoder(worker, frame);
+  if (ret < 0) {
+    return ret;
+  }
+
+  AVFrame* input = frame;
+  if (worker->sws) {
+    // The encoder may still reference the previous image
+    ret = av_frame_make_writable(worker->converted);
+    if (ret < 0) {
+      return ret;
+    }
+    sws_scale(worker->sws, frame->data, frame->linesize, 0, frame->height, worker->converted->data,
+              worker->converted->linesize);
+    av_frame_copy_props(worker->converted, frame);
+    input = worker->converted;
+  }
+  input->pict_type = AV_PICTURE_TYPE_NONE;
+
+  AVPacket* packet = av_packet_alloc();
+  if (!packet) {
+    return AVERROR(ENOMEM);
+  }
+
+  ret = avcodec_send_frame(worker->context, input);
+  if (ret >= 0) {
+    ret = avcodec_receive_packet(worker->context, packet);
+    if (ret == AVERROR(EAGAIN)) {
+      // Encoder with delay: drain it and open a fresh one for the next image
+      avcodec_send_frame(worker->context, nullptr);
+      ret = avcodec_receive_packet(worker->context, packet);
+      avcodec_free_context(&worker->context);
+    }
+  }
+
+  if (ret >= 0) {
+    AVIOContext* io = nullptr;
+    ret = avio_open(&io, filename.c_str(), AVIO_FLAG_WRITE);
+    if (ret >= 0) {
+      avio_write(io, packet->data, packet->size);
+      avio_flush(io);
+      int write_ret = io->error;
+      ret = avio_closep(&io);
+      if (write_ret < 0) {
+        ret = write_ret;
+      }
+    }
+    *size = packet->size;
+  }
+
+  av_packet_free(&packet);
+  return ret;
+}
+
+void ImageSequenceWriter::WorkerLoop(Worker* worker) {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [&] { return stopping_ || !jobs_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      job = jobs_.front();
+      jobs_.pop_front();
+    }
+
+    // Number fixed at write(), independent of which worker runs first
+    int64_t number = config_.start_number + static_cast<int64_t>(job.seq);
+    char filename[4096];
+    int64_t size = 0;
+    int ret = av_get_frame_filename2(filename, sizeof(filename), config_.pattern.c_str(), static_cast<int>(number), 0);
+    if (ret >= 0) {
+      ret = EncodeImage(worker, job.frame, filename, &size);
+    } else {
+      filename[0] = '\0';
+    }
+    av_frame_free(&job.frame);
+
+    double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.queued).count();
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (ret < 0) {
+        stats_.failed++;
+        if (!first_error_) {
+          first_error_ = ret;
+        }
+      } else {
+        stats_.images++;
+        stats_.bytes += static_cast<uint64_t>(size);
+      }
+      stats_.last_latency = latency;
+      stats_.max_latency = std::max(stats_.max_latency, latency);
+      stats_.total_latency += latency;
+      if (config_.collect_results) {
+        results_[job.seq] = { number, filename, ret < 0 ? 0 : size, latency, ret < 0 ? ret : 0 };
+      }
+      in_flight_--;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+int ImageSequenceWriter::CloseInternal(bool drain) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!is_open_) {
+      return 0;
+    }
+    if (drain) {
+      done_cv_.wait(lock, [&] { return in_flight_ == 0 || stopping_; });
+    }
+    stopping_ = true;
+  }
+  job_cv_.notify_all();
+  done_cv_.notify_all();
+
+  for (Worker* worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+    avcodec_free_context(&worker->context);
+    sws_freeContext(worker->sws);
+    av_frame_free(&worker->converted);
+    delete worker;
+  }
+
+  // Results stay readable until the next open()
+  std::lock_guard<std::mutex> lock(mutex_);
+  workers_.clear();
+  for (Job& job : jobs_) {
+    av_frame_free(&job.frame);
+  }
+  jobs_.clear();
+  in_flight_ = 0;
+  av_dict_free(&options_);
+  is_open_ = false;
+  return first_error_;
+}
+
+bool ImageSequenceWriter::ParseConfig(const Napi::Value& value, ImageSequenceWriterConfig* config) {
+  if (!value.IsObject()) {
+    return false;
+  }
+  Napi::Object opts = value.As<Napi::Object>();
+  if (!opts.Has("pattern") || !opts.Get("pattern").IsString()) {
+    return false;
+  }
+
+  config->pattern = opts.Get("pattern").As<Napi::String>().Utf8Value();
+  if (opts.Has("encoder") && opts.Get("encoder").IsString()) {
+    config->encoder = opts.Get("encoder").As<Napi::String>().Utf8Value();
+  }
+  if (opts.Has("workers") && opts.Get("workers").IsNumber()) {
+    config->workers = opts.Get("workers").As<Napi::Number>().Int32Value();
+  }
+  if (opts.Has("maxPending") && opts.Get("maxPending").IsNumber()) {
+    config->max_pending = opts.Get("maxPending").As<Napi::Number>().Int32Value();
+  }
+  if (opts.Has("startNumber") && opts.Get("startNumber").IsNumber()) {
+    config->start_number = opts.Get("startNumber").As<Napi::Number>().Int32Value();
+  }
+  if (opts.Has("pixFmt") && opts.Get("pixFmt").IsNumber()) {
+    config->pix_fmt = static_cast<AVPixelFormat>(opts.Get("pixFmt").As<Napi::Number>().Int32Value());
+  }
+  if (opts.Has("quality") && opts.Get("quality").IsNumber()) {
+    config->quality = opts.Get("quality").As<Napi::Number>().Int32Value();
+  }
+  if (opts.Has("collectResults") && opts.Get("collectResults").IsBoolean()) {
+    config->collect_results = opts.Get("collectResults").As<Napi::Boolean>().Value();
+  }
+  return true;
+}
+
+// === Lifecycle ===
+
+Napi::Value ImageSequenceWriter::Dispose(const Napi::CallbackInfo& info) {
+  CloseInternal(false);
+  return info.Env().Undefined();
+}
+
+// === Writing ===
+
+Napi::Value ImageSequenceWriter::ReadResults(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Array results = Napi::Array::New(env);
+
+  // Only the completed prefix, so results come out in sequence order
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint32_t index = 0;
+  for (auto it = results_.find(next_report_seq_); it != results_.end(); it = results_.find(next_report_seq_)) {
+    const Result& result = it->second;
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("number", Napi::Number::New(env, static_cast<double>(result.number)));
+    entry.Set("filename", Napi::String::New(env, result.filename));
+    entry.Set("size", Napi::Number::New(env, static_cast<double>(result.size)));
+    entry.Set("latency", Napi::Number::New(env, result.latency));
+    entry.Set("ret", Napi::Number::New(env, result.ret));
+    results.Set(index++, entry);
+    results_.erase(it);
+    next_report_seq_++;
+  }
+  return results;
+}
+
+Napi::Value ImageSequenceWriter::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t done = stats_.images + stats_.failed;
+  stats.Set("images", Napi::Number::New(env, static_cast<double>(stats_.images)));
+  stats.Set("failed", Napi::Number::New(env, static_cast<double>(stats_.failed)));
+  stats.Set("bytes", Napi::Number::New(env, static_cast<double>(stats_.bytes)));
+  stats.Set("pending", Napi::Number::New(env, in_flight_));
+  stats.Set("lastLatency", Napi::Number::New(env, stats_.last_latency));
+  stats.Set("averageLatency", Napi::Number::New(env, done ? stats_.total_latency / done : 0));
+  stats.Set("maxLatency", Napi::Number::New(env, stats_.max_latency));
+  return stats;
+}
+
+// === Properties ===
+
+Napi::Value ImageSequenceWriter::GetWorkers(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(workers_.size()));
+}
+
+Napi::Value ImageSequenceWriter::GetPending(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), in_flight_);
+}
+
+Napi::Value ImageSequenceWriter::GetIsOpen(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Boolean::New(info.Env(), is_open_);
+}
+
+} // namespace ffmpeg
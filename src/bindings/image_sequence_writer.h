@@ -0,0 +1,140 @@
+#ifndef FFMPEG_IMAGE_SEQUENCE_WRITER_H
+#define FFMPEG_IMAGE_SEQUENCE_WRITER_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/dict.h>
+#include <libavutil/frame.h>
+#include <libswscale/swscale.h>
+}
+
+namespace ffmpeg {
+
+struct ImageSequenceWriterConfig {
+  std::string pattern;            // Filename with a %d sequence field
+  std::string encoder;            // Encoder name, empty to guess from the extension
+  int workers = 4;
+  int max_pending = 0;            // Queued and encoding images, 0 for 2 per worker
+  int start_number = 1;
+  AVPixelFormat pix_fmt = AV_PIX_FMT_NONE;
+  int quality = -1;               // qscale (1 best), -1 for the encoder default
+  bool collect_results = false;
+};
+
+struct ImageSequenceStats {
+  uint64_t images = 0;            // Files written
+  uint64_t failed = 0;            // Images that failed to encode or write
+  uint64_t bytes = 0;             // Bytes written
+  double last_latency = 0;        // Milliseconds from write() until the file was closed
+  double max_latency = 0;
+  double total_latency = 0;
+};
+
+/**
+ * Writes an image sequence on a pool of independent encoders.
+ *
+ * Every image of a sequence is independent, so instead of encoding and
+ * muxing them one after another through image2, frames are queued and
+ * picked up by N worker threads, each with its own single-threaded encoder
+ * (opened from the first frame it sees), scaler and file handle. A frame's
+ * number is fixed when it is written, so numbering and order do not depend
+ * on which worker finishes first; results are reported in that order.
+ */
+class ImageSequenceWriter : public Napi::ObjectWrap<ImageSequenceWriter> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  ImageSequenceWriter(const Napi::CallbackInfo& info);
+  ~ImageSequenceWriter();
+
+private:
+  friend class ISWOpenWorker;
+  friend class ISWWriteWorker;
+  friend class ISWCloseWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct Job {
+    uint64_t seq;
+    AVFrame* frame;
+    std::chrono::steady_clock::time_point queued;
+  };
+
+  struct Result {
+    int64_t number;
+    std::string filename;
+    int64_t size;
+    double latency;
+    int ret;
+  };
+
+  struct Worker {
+    AVCodecContext* context = nullptr;
+    SwsContext* sws = nullptr;
+    AVFrame* converted = nullptr;
+    AVPixelFormat src_format = AV_PIX_FMT_NONE;
+    std::thread thread;
+  };
+
+  ImageSequenceWriterConfig config_;
+  const AVCodec* codec_ = nullptr;
+  AVDictionary* options_ = nullptr;
+  std::vector<Worker*> workers_;
+
+  std::deque<Job> jobs_;
+  std::map<uint64_t, Result> results_;
+  ImageSequenceStats stats_;
+
+  std::mutex mutex_;
+  std::condition_variable job_cv_;
+  std::condition_variable done_cv_;
+
+  uint64_t next_seq_ = 0;
+  uint64_t next_report_seq_ = 0;
+  int in_flight_ = 0;
+  int first_error_ = 0;
+  bool stopping_ = false;
+  bool is_open_ = false;
+
+  int OpenInternal(const ImageSequenceWriterConfig& config, const AVDictionary* options);
+  int WriteInternal(const AVFrame* frame);
+  int CloseInternal(bool drain);
+  void WorkerLoop(Worker* worker);
+  int EncodeImage(Worker* worker, AVFrame* frame, const std::string& filename, int64_t* size);
+  int PrepareEncoder(Worker* worker, const AVFrame* frame);
+  static bool ParseConfig(const Napi::Value& value, ImageSequenceWriterConfig* config);
+
+  // Lifecycle
+  Napi::Value OpenAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenSync(const Napi::CallbackInfo& info);
+  Napi::Value CloseAsync(const Napi::CallbackInfo& info);
+  Napi::Value CloseSync(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Writing
+  Napi::Value WriteAsync(const Napi::CallbackInfo& info);
+  Napi::Value WriteSync(const Napi::CallbackInfo& info);
+  Napi::Value ReadResults(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetWorkers(const Napi::CallbackInfo& info);
+  Napi::Value GetPending(const Napi::CallbackInfo& info);
+  Napi::Value GetIsOpen(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_IMAGE_SEQUENCE_WRITER_H
@@ -0,0 +1,174 @@
+#include "image_sequence_writer.h"
+#include "dictionary.h"
+#include "frame.h"
+#include <napi.h>
+
+extern "C" {
+#include <libavutil/dict.h>
+}
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class ISWOpenWorker : public Napi::AsyncWorker {
+public:
+  ISWOpenWorker(Napi::Env env, ImageSequenceWriter* writer, const ImageSequenceWriterConfig& config,
+                const AVDictionary* options)
+    : Napi::AsyncWorker(env),
+      writer_(writer),
+      config_(config),
+      options_(nullptr),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    // Copy options so the JS dictionary may be released while the worker runs
+    if (options) {
+      av_dict_copy(&options_, options, 0);
+    }
+  }
+
+  ~ISWOpenWorker() {
+    av_dict_free(&options_);
+  }
+
+  void Execute() override {
+    ret_ = writer_->OpenInternal(config_, options_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ImageSequenceWriter* writer_;
+  ImageSequenceWriterConfig config_;
+  AVDictionary* options_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class ISWWriteWorker : public Napi::AsyncWorker {
+public:
+  ISWWriteWorker(Napi::Env env, ImageSequenceWriter* writer, Frame* frame)
+    : Napi::AsyncWorker(env),
+      writer_(writer),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = writer_->WriteInternal(frame_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ImageSequenceWriter* writer_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class ISWCloseWorker : public Napi::AsyncWorker {
+public:
+  ISWCloseWorker(Napi::Env env, ImageSequenceWriter* writer)
+    : Napi::AsyncWorker(env),
+      writer_(writer),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = writer_->CloseInternal(true);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ImageSequenceWriter* writer_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value ImageSequenceWriter::OpenAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  ImageSequenceWriterConfig config;
+  if (info.Length() < 1 || !ParseConfig(info[0], &config)) {
+    Napi::TypeError::New(env, "Expected options with a filename pattern").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const AVDictionary* options = nullptr;
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    Dictionary* dict = UnwrapNativeObject<Dictionary>(env, info[1], "Dictionary");
+    if (dict) {
+      options = dict->Get();
+    }
+  }
+
+  auto* worker = new ISWOpenWorker(env, this, config, options);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ImageSequenceWriter::WriteAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new ISWWriteWorker(env, this, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ImageSequenceWriter::CloseAsync(const Napi::CallbackInfo& info) {
+  auto* worker = new ISWCloseWorker(info.Env(), this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
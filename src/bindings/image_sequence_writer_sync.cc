@@ -0,0 +1,47 @@
+#include "image_sequence_writer.h"
+#include "dictionary.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value ImageSequenceWriter::OpenSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  ImageSequenceWriterConfig config;
+  if (info.Length() < 1 || !ParseConfig(info[0], &config)) {
+    Napi::TypeError::New(env, "Expected options with a filename pattern").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  const AVDictionary* options = nullptr;
+  if (info.Length() > 1 && !info[1].IsNull() && !info[1].IsUndefined()) {
+    Dictionary* dict = UnwrapNativeObject<Dictionary>(env, info[1], "Dictionary");
+    if (dict) {
+      options = dict->Get();
+    }
+  }
+
+  int ret = OpenInternal(config, options);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value ImageSequenceWriter::WriteSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int ret = WriteInternal(frame->Get());
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value ImageSequenceWriter::CloseSync(const Napi::CallbackInfo& info) {
+  int ret = CloseInternal(true);
+  return Napi::Number::New(info.Env(), ret);
+}
+
+} // namespace ffmpeg
@@ -11,10 +11,26 @@
 #include "input_format.h"
 #include "output_format.h"
 #include "io_context.h"
+#include "concat_input.h"
 #include "error.h"
 #include "software_scale_context.h"
 #include "software_resample_context.h"
 #include "audio_fifo.h"
+#include "parallel_decoder.h"
+#include "demux_dispatcher.h"
+#include "frame_cache.h"
+#include "frame_arena.h"
+#include "packet_allocator.h"
+#include "packet_trace.h"
+#include "frame_scheduler.h"
+#include "packet_router.h"
+#include "shared_memory_channel.h"
+#include "smart_cutter.h"
+#include "scene_analyzer.h"
+#include "color_transform.h"
+#include "logo_overlay.h"
+#include "image_sequence_writer.h"
+#include "media_hasher.h"
 #include "utilities.h"
 #include "filter.h"
 #include "filter_context.h"
@@ -45,6 +61,7 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   Stream::Init(env, exports);
   InputFormat::Init(env, exports);
   OutputFormat::Init(env, exports);
+  ConcatInput::Init(env, exports);
   
   // I/O System
   IOContext::Init(env, exports);
@@ -58,6 +75,21 @@ Napi::Object Init(Napi::Env env, Napi::Object exports) {
   SoftwareScaleContext::Init(env, exports);
   SoftwareResampleContext::Init(env, exports);
   AudioFifo::Init(env, exports);
+  ParallelDecoder::Init(env, exports);
+  DemuxDispatcher::Init(env, exports);
+  FrameCache::Init(env, exports);
+  MediaHasher::Init(env, exports);
+  FrameArena::Init(env, exports);
+  PacketAllocator::Init(env, exports);
+  PacketRecorder::Init(env, exports);
+  FrameScheduler::Init(env, exports);
+  PacketRouter::Init(env, exports);
+  SharedMemoryChannel::Init(env, exports);
+  SmartCutter::Init(env, exports);
+  SceneAnalyzer::Init(env, exports);
+  ColorTransform::Init(env, exports);
+  LogoOverlay::Init(env, exports);
+  ImageSequenceWriter::Init(env, exports);
   
   // Filter System
   Filter::Init(env, exports);
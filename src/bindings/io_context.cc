@@ -1,6 +1,7 @@
 #include "io_context.h"
 #include <libavutil/error.h>
 #include <libavutil/mem.h>
+#include <algorithm>
 #include <future>
 #include <cstring>
 
@@ -15,6 +16,13 @@ Napi::Object IOContext::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod<&IOContext::FreeContext>("freeContext"),
     InstanceMethod<&IOContext::Open2Async>("open2"),
     InstanceMethod<&IOContext::Open2Sync>("open2Sync"),
+    InstanceMethod<&IOContext::OpenFileAsync>("openFile"),
+    InstanceMethod<&IOContext::OpenFileSync>("openFileSync"),
+    InstanceMethod<&IOContext::GetFileStats>("getFileStats"),
+    InstanceMethod<&IOContext::OpenHttpAsync>("openHttp"),
+    InstanceMethod<&IOContext::OpenHttpSync>("openHttpSync"),
+    InstanceMethod<&IOContext::GetHttpStats>("getHttpStats"),
+    InstanceMethod<&IOContext::GetCallbackStats>("getCallbackStats"),
     InstanceMethod<&IOContext::ClosepAsync>("closep"),
     InstanceMethod<&IOContext::ClosepSync>("closepSync"),
     InstanceMethod<&IOContext::ReadAsync>("read"),
@@ -81,20 +89,55 @@ int IOContext::ReadPacket(void* opaque, uint8_t* buf, int buf_size) {
     return AVERROR_EOF;
   }
   
+  data->read_calls++;
+
+  // Rest of a previous buffer: no JS round trip
+  if (data->pending_size > 0) {
+    int n = static_cast<int>(std::min(static_cast<size_t>(buf_size), data->pending_size));
+    memcpy(buf, data->pending, n);
+    data->pending += n;
+    data->pending_size -= n;
+    data->buffered_reads++;
+    data->bytes_read += n;
+    return n;
+  }
+
+  int request_size = data->adaptive ? data->request_size.load() : buf_size;
   int bytes_read = 0;
   std::promise<int> promise;
   std::future<int> future = promise.get_future();
   
-  auto callback = [&promise, &bytes_read, buf, buf_size](Napi::Env env, Napi::Function jsCallback) {
+  auto callback = [&promise, &bytes_read, data, buf, buf_size, request_size](Napi::Env env, Napi::Function jsCallback) {
     try {
-      Napi::Value result = jsCallback.Call({Napi::Number::New(env, buf_size)});
+      data->pending = nullptr;
+      data->read_callbacks++;
+
+      Napi::Value result = jsCallback.Call({Napi::Number::New(env, request_size)});
       
       if (result.IsNull() || result.IsUndefined()) {
         bytes_read = AVERROR_EOF;
       } else if (result.IsBuffer()) {
         Napi::Buffer<uint8_t> buffer = result.As<Napi::Buffer<uint8_t>>();
-        bytes_read = std::min(static_cast<int>(buffer.Length()), buf_size);
+        size_t length = buffer.Length();
+        bytes_read = static_cast<int>(std::min(length, static_cast<size_t>(buf_size)));
         memcpy(buf, buffer.Data(), bytes_read);
+        data->bytes_read += bytes_read;
+
+        // Keep the rest for the next reads instead of dropping it
+        if (length > static_cast<size_t>(bytes_read)) {
+          data->pending_data.assign(buffer.Data() + bytes_read, buffer.Data() + length);
+          data->pending = data->pending_data.data();
+          data->pending_size = length - bytes_read;
+        }
+
+        // Full answers: ask for more per call; short answers (live sources): ask for less
+        if (data->adaptive) {
+          if (length >= static_cast<size_t>(request_size)) {
+            data->request_size = std::min(request_size * 2, data->max_request_size);
+          } else if (length < static_cast<size_t>(request_size) / 4) {
+            data->request_size = std::max(request_size / 2, data->min_request_size);
+          }
+        }
       } else if (result.IsNumber()) {
         // Error code
         bytes_read = result.As<Napi::Number>().Int32Value();
@@ -160,11 +203,16 @@ int64_t IOContext::Seek(void* opaque, int64_t offset, int whence) {
     whence = AVSEEK_SIZE;
   }
   
+  // The JS source is ahead of FFmpeg by the pending bytes
+  if (whence == SEEK_CUR) {
+    offset -= static_cast<int64_t>(data->pending_size);
+  }
+
   int64_t new_position = -1;
   std::promise<int64_t> promise;
   std::future<int64_t> future = promise.get_future();
   
-  auto callback = [&promise, &new_position, offset, whence](Napi::Env env, Napi::Function jsCallback) {
+  auto callback = [&promise, &new_position, data, offset, whence](Napi::Env env, Napi::Function jsCallback) {
     try {
       Napi::Value result = jsCallback.Call({
         Napi::BigInt::New(env, offset),
@@ -190,7 +238,234 @@ int64_t IOContext::Seek(void* opaque, int64_t offset, int whence) {
     return AVERROR(EIO);
   }
   
-  return future.get();
+  int64_t ret = future.get();
+
+  // A failed seek leaves the JS source where it was, the pending bytes are still next
+  if (ret >= 0 && whence != AVSEEK_SIZE) {
+    data->pending = nullptr;
+    data->pending_size = 0;
+  }
+  return ret;
+}
+
+bool IOContext::ParseFileIOOptions(Napi::Env env, const Napi::Value& value, FileIOOptions* options, int* buffer_size) {
+  if (value.IsUndefined() || value.IsNull()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "options must be an object").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Object obj = value.As<Napi::Object>();
+
+  if (obj.Has("engine") && obj.Get("engine").IsString()) {
+    std::string engine = obj.Get("engine").As<Napi::String>().Utf8Value();
+    if (engine == "auto") {
+      options->engine = FILE_IO_ENGINE_AUTO;
+    } else if (engine == "uring") {
+      options->engine = FILE_IO_ENGINE_URING;
+    } else if (engine == "threads") {
+      options->engine = FILE_IO_ENGINE_THREADS;
+    } else {
+      Napi::TypeError::New(env, "engine must be 'auto', 'uring' or 'threads'").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  if (obj.Has("queueDepth") && obj.Get("queueDepth").IsNumber()) {
+    options->queue_depth = obj.Get("queueDepth").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("blockSize") && obj.Get("blockSize").IsNumber()) {
+    options->block_size = obj.Get("blockSize").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("cache") && obj.Get("cache").IsString()) {
+    std::string cache = obj.Get("cache").As<Napi::String>().Utf8Value();
+    if (cache == "default") {
+      options->cache = FILE_IO_CACHE_DEFAULT;
+    } else if (cache == "dontneed") {
+      options->cache = FILE_IO_CACHE_DONTNEED;
+    } else if (cache == "direct") {
+      options->cache = FILE_IO_CACHE_DIRECT;
+    } else {
+      Napi::TypeError::New(env, "cache must be 'default', 'dontneed' or 'direct'").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  if (obj.Has("fsync")) {
+    Napi::Value fsync = obj.Get("fsync");
+    if (fsync.IsNumber()) {
+      options->sync = FILE_IO_SYNC_INTERVAL;
+      options->sync_interval = fsync.As<Napi::Number>().Int64Value();
+    } else if (fsync.IsString() && fsync.As<Napi::String>().Utf8Value() == "close") {
+      options->sync = FILE_IO_SYNC_CLOSE;
+    } else if (fsync.IsString() && fsync.As<Napi::String>().Utf8Value() == "none") {
+      options->sync = FILE_IO_SYNC_NONE;
+    } else if (!fsync.IsUndefined()) {
+      Napi::TypeError::New(env, "fsync must be 'none', 'close' or a byte interval").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  if (obj.Has("alignment") && obj.Get("alignment").IsNumber()) {
+    options->alignment = obj.Get("alignment").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("bufferSize") && obj.Get("bufferSize").IsNumber()) {
+    *buffer_size = obj.Get("bufferSize").As<Napi::Number>().Int32Value();
+  }
+  return true;
+}
+
+int IOContext::OpenFileInternal(const std::string& url, int flags, const FileIOOptions& options, int buffer_size) {
+  // Read-write files are not supported by the backend
+  if ((flags & AVIO_FLAG_READ_WRITE) == AVIO_FLAG_READ_WRITE || buffer_size <= 0) {
+    return AVERROR(EINVAL);
+  }
+
+  bool write = (flags & AVIO_FLAG_WRITE) != 0;
+  std::unique_ptr<FileIO> file_io;
+  int ret = FileIO::Open(url, write, options, &file_io);
+  if (ret < 0) {
+    return ret;
+  }
+
+  uint8_t* buffer = static_cast<uint8_t*>(av_malloc(buffer_size));
+  if (!buffer) {
+    return AVERROR(ENOMEM);
+  }
+
+  AVIOContext* avio_ctx = avio_alloc_context(
+    buffer,
+    buffer_size,
+    write ? 1 : 0,
+    file_io.get(),
+    write ? nullptr : FileIO::ReadPacket,
+    write ? FileIO::WritePacket : nullptr,
+    FileIO::SeekPacket
+  );
+  if (!avio_ctx) {
+    av_free(buffer);
+    return AVERROR(ENOMEM);
+  }
+
+  ctx_ = avio_ctx;
+  file_io_ = std::move(file_io);
+  return 0;
+}
+
+bool IOContext::ParseHttpIOOptions(Napi::Env env, const Napi::Value& value, HttpIOOptions* options, int* buffer_size) {
+  if (value.IsUndefined() || value.IsNull()) {
+    return true;
+  }
+  if (!value.IsObject()) {
+    Napi::TypeError::New(env, "options must be an object").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Object obj = value.As<Napi::Object>();
+
+  if (obj.Has("connections") && obj.Get("connections").IsNumber()) {
+    options->connections = obj.Get("connections").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("blockSize") && obj.Get("blockSize").IsNumber()) {
+    options->block_size = obj.Get("blockSize").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("prefetch") && obj.Get("prefetch").IsNumber()) {
+    options->prefetch = obj.Get("prefetch").As<Napi::Number>().Int32Value();
+  }
+  if (obj.Has("cacheSize") && obj.Get("cacheSize").IsNumber()) {
+    options->cache_size = obj.Get("cacheSize").As<Napi::Number>().Int64Value();
+  }
+  if (obj.Has("diskCacheSize") && obj.Get("diskCacheSize").IsNumber()) {
+    options->disk_cache_size = obj.Get("diskCacheSize").As<Napi::Number>().Int64Value();
+  }
+  if (obj.Has("timeout") && obj.Get("timeout").IsNumber()) {
+    // Milliseconds in JS, microseconds for FFmpeg
+    options->timeout = obj.Get("timeout").As<Napi::Number>().Int64Value() * 1000;
+  }
+  if (obj.Has("userAgent") && obj.Get("userAgent").IsString()) {
+    options->user_agent = obj.Get("userAgent").As<Napi::String>().Utf8Value();
+  }
+  if (obj.Has("headers") && obj.Get("headers").IsObject()) {
+    Napi::Object headers = obj.Get("headers").As<Napi::Object>();
+    Napi::Array names = headers.GetPropertyNames();
+    for (uint32_t i = 0; i < names.Length(); i++) {
+      std::string name = names.Get(i).As<Napi::String>().Utf8Value();
+      Napi::Value header = headers.Get(name);
+      if (!header.IsString()) {
+        continue;
+      }
+      options->headers += name + ": " + header.As<Napi::String>().Utf8Value() + "\r\n";
+    }
+  }
+  if (obj.Has("bufferSize") && obj.Get("bufferSize").IsNumber()) {
+    *buffer_size = obj.Get("bufferSize").As<Napi::Number>().Int32Value();
+  }
+  return true;
+}
+
+int IOContext::OpenHttpInternal(const std::string& url, const HttpIOOptions& options, int buffer_size) {
+  if (buffer_size <= 0) {
+    return AVERROR(EINVAL);
+  }
+
+  std::unique_ptr<HttpIO> http_io;
+  int ret = HttpIO::Open(url, options, &http_io);
+  if (ret < 0) {
+    return ret;
+  }
+
+  uint8_t* buffer = static_cast<uint8_t*>(av_malloc(buffer_size));
+  if (!buffer) {
+    return AVERROR(ENOMEM);
+  }
+
+  AVIOContext* avio_ctx = avio_alloc_context(
+    buffer,
+    buffer_size,
+    0,
+    http_io.get(),
+    HttpIO::ReadPacket,
+    nullptr,
+    HttpIO::SeekPacket
+  );
+  if (!avio_ctx) {
+    av_free(buffer);
+    return AVERROR(ENOMEM);
+  }
+  if (!http_io->Seekable()) {
+    avio_ctx->seekable = 0;
+  }
+
+  ctx_ = avio_ctx;
+  http_io_ = std::move(http_io);
+  return 0;
+}
+
+int IOContext::CloseFileInternal() {
+  int ret = 0;
+
+  if (ctx_) {
+    if (ctx_->write_flag) {
+      avio_flush(ctx_);
+    }
+    ret = ctx_->error;
+    av_freep(&ctx_->buffer);
+    avio_context_free(&ctx_);
+  }
+
+  if (file_io_) {
+    int close_ret = file_io_->Close();
+    if (ret >= 0) {
+      ret = close_ret;
+    }
+    file_io_.reset();
+  }
+
+  if (http_io_) {
+    http_io_->Close();
+    http_io_.reset();
+  }
+
+  return ret;
 }
 
 void IOContext::CleanupCallbacks() {
@@ -293,6 +568,25 @@ Napi::Value IOContext::AllocContextWithCallbacks(const Napi::CallbackInfo& info)
   callback_data_ = std::make_unique<CallbackData>();
   callback_data_->io_context = this;
   callback_data_->active = true;
+  callback_data_->request_size = buffer_size;
+
+  // Options: { adaptive, minReadSize, maxReadSize }
+  if (info.Length() > 5 && info[5].IsObject()) {
+    Napi::Object options = info[5].As<Napi::Object>();
+    if (options.Has("adaptive") && options.Get("adaptive").IsBoolean()) {
+      callback_data_->adaptive = options.Get("adaptive").As<Napi::Boolean>().Value();
+    }
+    callback_data_->min_request_size = std::min(buffer_size, 4096);
+    callback_data_->max_request_size = std::max(buffer_size, 1024 * 1024);
+    if (options.Has("minReadSize") && options.Get("minReadSize").IsNumber()) {
+      callback_data_->min_request_size = std::max(1, options.Get("minReadSize").As<Napi::Number>().Int32Value());
+    }
+    if (options.Has("maxReadSize") && options.Get("maxReadSize").IsNumber()) {
+      callback_data_->max_request_size = options.Get("maxReadSize").As<Napi::Number>().Int32Value();
+    }
+    callback_data_->max_request_size = std::max(callback_data_->max_request_size, callback_data_->min_request_size);
+    callback_data_->request_size = std::max(std::min(buffer_size, callback_data_->max_request_size), callback_data_->min_request_size);
+  }
   
   // Setup callbacks
   int (*read_cb)(void*, uint8_t*, int) = nullptr;
@@ -371,6 +665,11 @@ Napi::Value IOContext::FreeContext(const Napi::CallbackInfo& info) {
   
   // Clean up callbacks first if they exist
   CleanupCallbacks();
+
+  if (file_io_ || http_io_) {
+    CloseFileInternal();
+    return env.Undefined();
+  }
   
   if (ctx_) {
     // avio_context_free will also free the buffer
@@ -501,6 +800,83 @@ Napi::Value IOContext::GetWriteFlag(const Napi::CallbackInfo& info) {
   return Napi::Boolean::New(env, ctx->write_flag != 0);
 }
 
+Napi::Value IOContext::GetFileStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!file_io_) {
+    return env.Null();
+  }
+
+  FileIOStats stats = file_io_->GetStats();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("engine", Napi::String::New(env, file_io_->EngineName()));
+  result.Set("bytesRead", Napi::Number::New(env, static_cast<double>(stats.bytes_read)));
+  result.Set("bytesWritten", Napi::Number::New(env, static_cast<double>(stats.bytes_written)));
+  result.Set("readOps", Napi::Number::New(env, static_cast<double>(stats.read_ops)));
+  result.Set("writeOps", Napi::Number::New(env, static_cast<double>(stats.write_ops)));
+  result.Set("syscalls", Napi::Number::New(env, static_cast<double>(stats.syscalls)));
+  result.Set("waits", Napi::Number::New(env, static_cast<double>(stats.waits)));
+  result.Set("maxInFlight", Napi::Number::New(env, static_cast<double>(stats.max_in_flight)));
+  result.Set("direct", Napi::Boolean::New(env, stats.direct));
+  result.Set("bytesSubmitted", Napi::Number::New(env, static_cast<double>(stats.bytes_submitted)));
+  result.Set("writeAmplification", Napi::Number::New(env, stats.bytes_written > 0
+    ? static_cast<double>(stats.bytes_submitted) / static_cast<double>(stats.bytes_written) : 0.0));
+  result.Set("rmwReads", Napi::Number::New(env, static_cast<double>(stats.rmw_reads)));
+  result.Set("syncs", Napi::Number::New(env, static_cast<double>(stats.syncs)));
+
+  Napi::Array write_latency = Napi::Array::New(env, kFileIOLatencyBuckets);
+  Napi::Array sync_latency = Napi::Array::New(env, kFileIOLatencyBuckets);
+  for (int i = 0; i < kFileIOLatencyBuckets; i++) {
+    write_latency.Set(i, Napi::Number::New(env, static_cast<double>(stats.write_latency[i])));
+    sync_latency.Set(i, Napi::Number::New(env, static_cast<double>(stats.sync_latency[i])));
+  }
+  result.Set("writeLatency", write_latency);
+  result.Set("syncLatency", sync_latency);
+  return result;
+}
+
+Napi::Value IOContext::GetHttpStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!http_io_) {
+    return env.Null();
+  }
+
+  HttpIOStats stats = http_io_->GetStats();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("size", Napi::Number::New(env, static_cast<double>(http_io_->Size())));
+  result.Set("seekable", Napi::Boolean::New(env, http_io_->Seekable()));
+  result.Set("bytesRead", Napi::Number::New(env, static_cast<double>(stats.bytes_read)));
+  result.Set("bytesFetched", Napi::Number::New(env, static_cast<double>(stats.bytes_fetched)));
+  result.Set("requests", Napi::Number::New(env, static_cast<double>(stats.requests)));
+  result.Set("connections", Napi::Number::New(env, static_cast<double>(stats.connections)));
+  result.Set("reusedConnections", Napi::Number::New(env, static_cast<double>(stats.reused)));
+  result.Set("memoryHits", Napi::Number::New(env, static_cast<double>(stats.memory_hits)));
+  result.Set("diskHits", Napi::Number::New(env, static_cast<double>(stats.disk_hits)));
+  result.Set("misses", Napi::Number::New(env, static_cast<double>(stats.misses)));
+  result.Set("cancelled", Napi::Number::New(env, static_cast<double>(stats.cancelled)));
+  result.Set("redirects", Napi::Number::New(env, static_cast<double>(stats.redirects)));
+  result.Set("waitTime", Napi::Number::New(env, static_cast<double>(stats.wait_us) / 1000.0));
+  return result;
+}
+
+Napi::Value IOContext::GetCallbackStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!callback_data_ || !callback_data_->has_read_callback) {
+    return env.Null();
+  }
+
+  CallbackData* data = callback_data_.get();
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("reads", Napi::Number::New(env, static_cast<double>(data->read_calls.load())));
+  result.Set("readCallbacks", Napi::Number::New(env, static_cast<double>(data->read_callbacks.load())));
+  result.Set("bufferedReads", Napi::Number::New(env, static_cast<double>(data->buffered_reads.load())));
+  result.Set("bytesRead", Napi::Number::New(env, static_cast<double>(data->bytes_read.load())));
+  result.Set("readSize", Napi::Number::New(env, data->adaptive ? data->request_size.load() : (ctx_ ? ctx_->buffer_size : 0)));
+  return result;
+}
+
 Napi::Value IOContext::AsyncDispose(const Napi::CallbackInfo& info) {
   // Check if this context was created with callbacks or opened with avio_open2
   // Contexts with callbacks should use freeContext, others use closep
@@ -4,7 +4,10 @@
 #include <napi.h>
 #include <memory>
 #include <atomic>
+#include <vector>
 #include "common.h"
+#include "file_io.h"
+#include "http_io.h"
 
 extern "C" {
 #include <libavformat/avio.h>
@@ -55,6 +58,10 @@ public:
   Napi::Value GetBufferSize(const Napi::CallbackInfo& info);
 
   Napi::Value GetWriteFlag(const Napi::CallbackInfo& info);
+
+  Napi::Value GetFileStats(const Napi::CallbackInfo& info);
+  Napi::Value GetHttpStats(const Napi::CallbackInfo& info);
+  Napi::Value GetCallbackStats(const Napi::CallbackInfo& info);
   
   // Static members  
   static Napi::FunctionReference constructor;
@@ -71,6 +78,8 @@ private:
   friend class IOSizeWorker;
   friend class IOFlushWorker;
   friend class IOSkipWorker;
+  friend class IOOpenFileWorker;
+  friend class IOOpenHttpWorker;
 
   AVIOContext* ctx_ = nullptr;
   
@@ -85,14 +94,47 @@ private:
     bool has_seek_callback = false;
     void* opaque_data;  // User data passed to callbacks
     std::atomic<bool> active{false};
+
+    // Bytes of the last JS buffer beyond what FFmpeg asked for. Copied, as
+    // sources may reuse their buffers, and served by the following reads
+    // without calling into JS until used up or discarded by a seek.
+    std::vector<uint8_t> pending_data;
+    const uint8_t* pending = nullptr;
+    size_t pending_size = 0;
+
+    // Adaptive read size passed to the JS read callback
+    bool adaptive = false;
+    std::atomic<int> request_size{0};
+    int min_request_size = 0;
+    int max_request_size = 0;
+
+    std::atomic<uint64_t> read_calls{0};       // ReadPacket calls from FFmpeg
+    std::atomic<uint64_t> read_callbacks{0};   // Calls into the JS read callback
+    std::atomic<uint64_t> buffered_reads{0};   // Reads served from pending
+    std::atomic<uint64_t> bytes_read{0};
   };
   
   std::unique_ptr<CallbackData> callback_data_;
   uint8_t* buffer_ = nullptr;  // Buffer for custom I/O
+
+  // Native file backend (openFile)
+  std::unique_ptr<FileIO> file_io_;
+
+  // Native HTTP backend (openHttp)
+  std::unique_ptr<HttpIO> http_io_;
   
   // Helper to clean up callbacks
   void CleanupCallbacks();
   
+  // Open / close the native file backend
+  int OpenFileInternal(const std::string& url, int flags, const FileIOOptions& options, int buffer_size);
+  int CloseFileInternal();
+  static bool ParseFileIOOptions(Napi::Env env, const Napi::Value& value, FileIOOptions* options, int* buffer_size);
+
+  // Open the native HTTP backend, closed by CloseFileInternal
+  int OpenHttpInternal(const std::string& url, const HttpIOOptions& options, int buffer_size);
+  static bool ParseHttpIOOptions(Napi::Env env, const Napi::Value& value, HttpIOOptions* options, int* buffer_size);
+
   // Static callback functions for FFmpeg
   static int ReadPacket(void* opaque, uint8_t* buf, int buf_size);
   static int WritePacket(void* opaque, const uint8_t* buf, int buf_size);
@@ -102,6 +144,10 @@ private:
   Napi::Value AllocContextWithCallbacks(const Napi::CallbackInfo& info);
   Napi::Value Open2Async(const Napi::CallbackInfo& info);
   Napi::Value Open2Sync(const Napi::CallbackInfo& info);
+  Napi::Value OpenFileAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenFileSync(const Napi::CallbackInfo& info);
+  Napi::Value OpenHttpAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenHttpSync(const Napi::CallbackInfo& info);
   Napi::Value AsyncDispose(const Napi::CallbackInfo& info);
 };
 
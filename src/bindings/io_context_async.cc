@@ -47,6 +47,82 @@ private:
   Napi::Promise::Deferred deferred_;
 };
 
+class IOOpenFileWorker : public Napi::AsyncWorker {
+public:
+  IOOpenFileWorker(Napi::Env env, IOContext* ctx, const std::string& url, int flags,
+                   const FileIOOptions& options, int buffer_size)
+    : Napi::AsyncWorker(env),
+      ctx_(ctx),
+      url_(url),
+      flags_(flags),
+      options_(options),
+      buffer_size_(buffer_size),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ctx_->OpenFileInternal(url_, flags_, options_, buffer_size_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  IOContext* ctx_;
+  std::string url_;
+  int flags_;
+  FileIOOptions options_;
+  int buffer_size_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class IOOpenHttpWorker : public Napi::AsyncWorker {
+public:
+  IOOpenHttpWorker(Napi::Env env, IOContext* ctx, const std::string& url,
+                   const HttpIOOptions& options, int buffer_size)
+    : Napi::AsyncWorker(env),
+      ctx_(ctx),
+      url_(url),
+      options_(options),
+      buffer_size_(buffer_size),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ctx_->OpenHttpInternal(url_, options_, buffer_size_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  IOContext* ctx_;
+  std::string url_;
+  HttpIOOptions options_;
+  int buffer_size_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
 class IOClosepWorker : public Napi::AsyncWorker {
 public:
   IOClosepWorker(Napi::Env env, IOContext* ctx)
@@ -63,6 +139,11 @@ public:
       if (ctx_->callback_data_) {
         ctx_->callback_data_->active = false;
       }
+
+      if (ctx_->file_io_ || ctx_->http_io_) {
+        ret_ = ctx_->CloseFileInternal();
+        return;
+      }
       
       ret_ = avio_closep(&ctx);
       // avio_closep freed the context and set the pointer to NULL
@@ -352,6 +433,63 @@ Napi::Value IOContext::Open2Async(const Napi::CallbackInfo& info) {
   return promise;
 }
 
+Napi::Value IOContext::OpenFileAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected (url, flags, options?)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (ctx_) {
+    Napi::Error::New(env, "IOContext already initialized").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FileIOOptions options;
+  int buffer_size = 65536;
+  if (info.Length() > 2 && !ParseFileIOOptions(env, info[2], &options, &buffer_size)) {
+    return env.Undefined();
+  }
+
+  std::string url = info[0].As<Napi::String>().Utf8Value();
+  int flags = info[1].As<Napi::Number>().Int32Value();
+
+  auto* worker = new IOOpenFileWorker(env, this, url, flags, options, buffer_size);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value IOContext::OpenHttpAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected (url, options?)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (ctx_) {
+    Napi::Error::New(env, "IOContext already initialized").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  HttpIOOptions options;
+  int buffer_size = 65536;
+  if (info.Length() > 1 && !ParseHttpIOOptions(env, info[1], &options, &buffer_size)) {
+    return env.Undefined();
+  }
+
+  std::string url = info[0].As<Napi::String>().Utf8Value();
+
+  auto* worker = new IOOpenHttpWorker(env, this, url, options, buffer_size);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
 Napi::Value IOContext::ClosepAsync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   
@@ -32,6 +32,57 @@ Napi::Value IOContext::Open2Sync(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, 0);
 }
 
+Napi::Value IOContext::OpenFileSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected (url, flags, options?)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (ctx_) {
+    Napi::Error::New(env, "IOContext already initialized").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FileIOOptions options;
+  int buffer_size = 65536;
+  if (info.Length() > 2 && !ParseFileIOOptions(env, info[2], &options, &buffer_size)) {
+    return env.Undefined();
+  }
+
+  std::string url = info[0].As<Napi::String>().Utf8Value();
+  int flags = info[1].As<Napi::Number>().Int32Value();
+
+  int ret = OpenFileInternal(url, flags, options, buffer_size);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value IOContext::OpenHttpSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Expected (url, options?)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (ctx_) {
+    Napi::Error::New(env, "IOContext already initialized").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  HttpIOOptions options;
+  int buffer_size = 65536;
+  if (info.Length() > 1 && !ParseHttpIOOptions(env, info[1], &options, &buffer_size)) {
+    return env.Undefined();
+  }
+
+  std::string url = info[0].As<Napi::String>().Utf8Value();
+
+  int ret = OpenHttpInternal(url, options, buffer_size);
+  return Napi::Number::New(env, ret);
+}
+
 Napi::Value IOContext::ReadSync(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
 
@@ -125,6 +176,10 @@ Napi::Value IOContext::ClosepSync(const Napi::CallbackInfo& info) {
     callback_data_->active = false;
   }
 
+  if (file_io_ || http_io_) {
+    return Napi::Number::New(env, CloseFileInternal());
+  }
+
   // Direct FFmpeg call
   int ret = avio_closep(&ctx);
 
@@ -0,0 +1,427 @@
+#include "logo_overlay.h"
+#include "frame.h"
+
+#include <algorithm>
+#include <cmath>
+
+extern "C" {
+#include <libavutil/common.h>
+#include <libavutil/pixdesc.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+struct PlaneLayout {
+  int depth = 0;
+  int log2_w = 0;
+  int log2_h = 0;
+};
+
+// Planar 8 to 12-bit YUV in native byte order
+bool DescribeFormat(int format, PlaneLayout* layout) {
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(format));
+  if (!desc || desc->nb_components < 3 || !(desc->flags & AV_PIX_FMT_FLAG_PLANAR) ||
+      (desc->flags & (AV_PIX_FMT_FLAG_RGB | AV_PIX_FMT_FLAG_BE | AV_PIX_FMT_FLAG_HWACCEL | AV_PIX_FMT_FLAG_FLOAT))) {
+    return false;
+  }
+
+  int depth = desc->comp[0].depth;
+  if (depth < 8 || depth > 12) {
+    return false;
+  }
+  for (int i = 0; i < 3; i++) {
+    if (desc->comp[i].plane != i || desc->comp[i].shift != 0 || desc->comp[i].depth != depth ||
+        desc->comp[i].step != (depth > 8 ? 2 : 1)) {
+      return false;
+    }
+  }
+
+  layout->depth = depth;
+  layout->log2_w = desc->log2_chroma_w;
+  layout->log2_h = desc->log2_chroma_h;
+  return true;
+}
+
+void LumaCoefficients(int space, double* kr, double* kb) {
+  switch (space) {
+    case AVCOL_SPC_BT470BG:
+    case AVCOL_SPC_SMPTE170M: *kr = 0.299; *kb = 0.114; break;
+    case AVCOL_SPC_BT2020_NCL:
+    case AVCOL_SPC_BT2020_CL: *kr = 0.2627; *kb = 0.0593; break;
+    case AVCOL_SPC_SMPTE240M: *kr = 0.212; *kb = 0.087; break;
+    case AVCOL_SPC_FCC: *kr = 0.30; *kb = 0.11; break;
+    default: *kr = 0.2126; *kb = 0.0722; break;
+  }
+}
+
+// Floor to a multiple of 1 << log2 (also for negative values)
+int AlignDown(int value, int log2) {
+  int n = 1 << log2;
+  return value - ((value % n) + n) % n;
+}
+
+void ComputeSpans(OverlayPlane* plane) {
+  plane->row_begin.assign(plane->height, 0);
+  plane->row_end.assign(plane->height, 0);
+  for (int r = 0; r < plane->height; r++) {
+    const uint16_t* alpha = plane->alpha.data() + static_cast<size_t>(r) * plane->width;
+    int begin = 0;
+    int end = plane->width;
+    while (begin < end && !alpha[begin]) begin++;
+    while (end > begin && !alpha[end - 1]) end--;
+    plane->row_begin[r] = begin;
+    plane->row_end[r] = end;
+  }
+}
+
+// dst = dst * (1 - a) + premultiplied logo; branch-free so the compiler vectorizes it
+template <typename T>
+void BlendRow(T* dst, const uint16_t* alpha, const uint32_t* premult, int count) {
+  for (int i = 0; i < count; i++) {
+    dst[i] = static_cast<T>((dst[i] * (256u - alpha[i]) + premult[i] + 128u) >> 8);
+  }
+}
+
+template <typename T>
+void BlendPlane(const OverlayPlane& plane, AVFrame* frame, int index, int origin_x, int origin_y, int plane_w, int plane_h) {
+  const int ox = origin_x + plane.x;
+  const int oy = origin_y + plane.y;
+  const int row_first = std::max(0, -oy);
+  const int row_last = std::min(plane.height, plane_h - oy);
+
+  for (int r = row_first; r < row_last; r++) {
+    const int begin = std::max(plane.row_begin[r], -ox);
+    const int end = std::min(plane.row_end[r], plane_w - ox);
+    if (begin >= end) {
+      continue;
+    }
+    T* dst = reinterpret_cast<T*>(frame->data[index] + static_cast<ptrdiff_t>(oy + r) * frame->linesize[index]) + ox + begin;
+    const size_t offset = static_cast<size_t>(r) * plane.width + begin;
+    BlendRow(dst, plane.alpha.data() + offset, plane.premult.data() + offset, end - begin);
+  }
+}
+
+} // namespace
+
+Napi::FunctionReference LogoOverlay::constructor;
+
+Napi::Object LogoOverlay::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "LogoOverlay", {
+    InstanceMethod<&LogoOverlay::Alloc>("alloc"),
+    InstanceMethod<&LogoOverlay::Free>("free"),
+    InstanceMethod<&LogoOverlay::ApplyAsync>("apply"),
+    InstanceMethod<&LogoOverlay::ApplySync>("applySync"),
+    InstanceMethod<&LogoOverlay::SetPosition>("setPosition"),
+    InstanceMethod<&LogoOverlay::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &LogoOverlay::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("LogoOverlay", func);
+  return exports;
+}
+
+LogoOverlay::LogoOverlay(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<LogoOverlay>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+LogoOverlay::~LogoOverlay() {
+  // Manual cleanup if not already done
+  FreeInternal();
+}
+
+// === Rendering ===
+
+std::shared_ptr<const OverlayPlanes> LogoOverlay::Render(const RenderKey& key) const {
+  PlaneLayout layout;
+  if (!DescribeFormat(std::get<0>(key), &layout)) {
+    return nullptr;
+  }
+
+  double kr, kb;
+  LumaCoefficients(std::get<1>(key), &kr, &kb);
+  const bool full = std::get<2>(key) == AVCOL_RANGE_JPEG;
+  const double max = (1 << layout.depth) - 1;
+  const double scale = 1 << (layout.depth - 8);
+
+  auto render = std::make_shared<OverlayPlanes>();
+  render->log2_w = layout.log2_w;
+  render->log2_h = layout.log2_h;
+  render->depth = layout.depth;
+
+  // Bounding box on the chroma grid, relative to the logo origin
+  const int x0 = AlignDown(box_x_, layout.log2_w);
+  const int y0 = AlignDown(box_y_, layout.log2_h);
+  const int x1 = -AlignDown(-(box_x_ + box_width_), layout.log2_w);
+  const int y1 = -AlignDown(-(box_y_ + box_height_), layout.log2_h);
+
+  // Logo samples in straight alpha: code values and alpha 0..256 (with opacity)
+  const int w = x1 - x0;
+  const int h = y1 - y0;
+  std::vector<double> codes[3];
+  std::vector<uint16_t> alpha(static_cast<size_t>(w) * h, 0);
+  for (auto& c : codes) {
+    c.assign(alpha.size(), 0.0);
+  }
+
+  for (int y = 0; y < h; y++) {
+    for (int x = 0; x < w; x++) {
+      int lx = x0 + x - box_x_;
+      int ly = y0 + y - box_y_;
+      if (lx < 0 || ly < 0 || lx >= box_width_ || ly >= box_height_) {
+        continue;
+      }
+      const uint8_t* px = rgba_.data() + (static_cast<size_t>(ly) * box_width_ + lx) * 4;
+      double r = px[0] / 255.0, g = px[1] / 255.0, b = px[2] / 255.0;
+      double luma = kr * r + (1 - kr - kb) * g + kb * b;
+      double cb = (b - luma) / (2 * (1 - kb));
+      double cr = (r - luma) / (2 * (1 - kr));
+
+      size_t i = static_cast<size_t>(y) * w + x;
+      alpha[i] = static_cast<uint16_t>(std::lrint(px[3] * opacity_ * 256.0 / 255.0));
+      if (full) {
+        codes[0][i] = luma * max;
+        codes[1][i] = cb * max + (max + 1) / 2;
+        codes[2][i] = cr * max + (max + 1) / 2;
+      } else {
+        codes[0][i] = (16 + 219 * luma) * scale;
+        codes[1][i] = (128 + 224 * cb) * scale;
+        codes[2][i] = (128 + 224 * cr) * scale;
+      }
+    }
+  }
+
+  for (int p = 0; p < 3; p++) {
+    const int lw = p ? layout.log2_w : 0;
+    const int lh = p ? layout.log2_h : 0;
+    const int bw = 1 << lw;
+    const int bh = 1 << lh;
+    const int n = bw * bh;
+
+    OverlayPlane& plane = render->planes[p];
+    plane.x = x0 >> lw;
+    plane.y = y0 >> lh;
+    plane.width = w >> lw;
+    plane.height = h >> lh;
+    plane.alpha.assign(static_cast<size_t>(plane.width) * plane.height, 0);
+    plane.premult.assign(plane.alpha.size(), 0);
+
+    // Subsampled planes average premultiplied samples, as a filter on the blended picture would
+    for (int y = 0; y < plane.height; y++) {
+      for (int x = 0; x < plane.width; x++) {
+        double sum_alpha = 0, sum_premult = 0;
+        for (int dy = 0; dy < bh; dy++) {
+          for (int dx = 0; dx < bw; dx++) {
+            size_t i = static_cast<size_t>((y << lh) + dy) * w + (x << lw) + dx;
+            sum_alpha += alpha[i];
+            sum_premult += codes[p][i] * alpha[i];
+          }
+        }
+        size_t o = static_cast<size_t>(y) * plane.width + x;
+        plane.alpha[o] = static_cast<uint16_t>(std::lrint(sum_alpha / n));
+        plane.premult[o] = static_cast<uint32_t>(std::lrint(sum_premult / n));
+      }
+    }
+    ComputeSpans(&plane);
+  }
+
+  return render;
+}
+
+// === Blending ===
+
+int LogoOverlay::ApplyFrame(AVFrame* frame) {
+  std::shared_ptr<const OverlayPlanes> render;
+  int px, py;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!configured_ || !frame || !frame->data[0] || frame->hw_frames_ctx || frame->width <= 0 || frame->height <= 0) {
+      return AVERROR(EINVAL);
+    }
+
+    RenderKey key(frame->format, frame->colorspace, frame->color_range == AVCOL_RANGE_JPEG ? AVCOL_RANGE_JPEG : AVCOL_RANGE_MPEG);
+    auto it = renders_.find(key);
+    if (it == renders_.end()) {
+      render = Render(key);
+      if (!render) {
+        return AVERROR(EINVAL);
+      }
+      renders_.emplace(key, render);
+      stats_.renders++;
+    } else {
+      render = it->second;
+    }
+
+    // Position on the chroma grid, negative values from the right/bottom edge
+    px = AlignDown(x_ >= 0 ? x_ : frame->width + x_ - logo_width_, render->log2_w);
+    py = AlignDown(y_ >= 0 ? y_ : frame->height + y_ - logo_height_, render->log2_h);
+
+    const OverlayPlane& luma = render->planes[0];
+    if (!box_width_ || px + luma.x >= frame->width || py + luma.y >= frame->height ||
+        px + luma.x + luma.width <= 0 || py + luma.y + luma.height <= 0) {
+      stats_.skipped++;
+      return 0;
+    }
+    stats_.frames++;
+  }
+
+  // Never write into buffers shared with other frames (e.g. decoder references)
+  int ret = av_frame_make_writable(frame);
+  if (ret < 0) {
+    return ret;
+  }
+
+  for (int p = 0; p < 3; p++) {
+    const int lw = p ? render->log2_w : 0;
+    const int lh = p ? render->log2_h : 0;
+    const int plane_w = AV_CEIL_RSHIFT(frame->width, lw);
+    const int plane_h = AV_CEIL_RSHIFT(frame->height, lh);
+    // Exact: positions are aligned to the chroma grid
+    const int origin_x = px / (1 << lw);
+    const int origin_y = py / (1 << lh);
+    if (render->depth > 8) {
+      BlendPlane<uint16_t>(render->planes[p], frame, p, origin_x, origin_y, plane_w, plane_h);
+    } else {
+      BlendPlane<uint8_t>(render->planes[p], frame, p, origin_x, origin_y, plane_w, plane_h);
+    }
+  }
+
+  return 0;
+}
+
+void LogoOverlay::FreeInternal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  renders_.clear();
+  rgba_.clear();
+  rgba_.shrink_to_fit();
+  configured_ = false;
+}
+
+// === JS methods ===
+
+Napi::Value LogoOverlay::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* logo = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!logo || !logo->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int x = 0, y = 0;
+  double opacity = 1.0;
+  if (info.Length() > 1 && info[1].IsObject()) {
+    Napi::Object opts = info[1].As<Napi::Object>();
+    if (opts.Has("x") && opts.Get("x").IsNumber()) {
+      x = opts.Get("x").As<Napi::Number>().Int32Value();
+    }
+    if (opts.Has("y") && opts.Get("y").IsNumber()) {
+      y = opts.Get("y").As<Napi::Number>().Int32Value();
+    }
+    if (opts.Has("opacity") && opts.Get("opacity").IsNumber()) {
+      opacity = opts.Get("opacity").As<Napi::Number>().DoubleValue();
+    }
+  }
+
+  // Packed 8-bit RGB with alpha (RGBA, BGRA, ARGB, ABGR)
+  const AVFrame* src = logo->Get();
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(static_cast<AVPixelFormat>(src->format));
+  if (!desc || desc->nb_components != 4 || (desc->flags & AV_PIX_FMT_FLAG_PLANAR) ||
+      !(desc->flags & AV_PIX_FMT_FLAG_RGB) || !(desc->flags & AV_PIX_FMT_FLAG_ALPHA) || !src->data[0] ||
+      src->width <= 0 || src->height <= 0 || !(opacity >= 0 && opacity <= 1)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+  for (int i = 0; i < 4; i++) {
+    if (desc->comp[i].depth != 8 || desc->comp[i].step != 4 || desc->comp[i].shift != 0) {
+      return Napi::Number::New(env, AVERROR(EINVAL));
+    }
+  }
+
+  // Bounding box of the visible pixels
+  auto sample = [&](int px, int py, int c) {
+    return src->data[0][static_cast<ptrdiff_t>(py) * src->linesize[0] + px * 4 + desc->comp[c].offset];
+  };
+  int bx0 = src->width, by0 = src->height, bx1 = 0, by1 = 0;
+  for (int py = 0; py < src->height; py++) {
+    for (int px = 0; px < src->width; px++) {
+      if (sample(px, py, 3)) {
+        bx0 = std::min(bx0, px);
+        by0 = std::min(by0, py);
+        bx1 = std::max(bx1, px + 1);
+        by1 = std::max(by1, py + 1);
+      }
+    }
+  }
+  if (bx1 <= bx0) {
+    bx0 = by0 = bx1 = by1 = 0;
+  }
+
+  std::vector<uint8_t> rgba(static_cast<size_t>(bx1 - bx0) * (by1 - by0) * 4);
+  uint8_t* out = rgba.data();
+  for (int py = by0; py < by1; py++) {
+    for (int px = bx0; px < bx1; px++) {
+      for (int c = 0; c < 4; c++) {
+        *out++ = sample(px, py, c);
+      }
+    }
+  }
+
+  FreeInternal();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  logo_width_ = src->width;
+  logo_height_ = src->height;
+  box_x_ = bx0;
+  box_y_ = by0;
+  box_width_ = bx1 - bx0;
+  box_height_ = by1 - by0;
+  rgba_ = std::move(rgba);
+  x_ = x;
+  y_ = y;
+  opacity_ = opacity;
+  stats_ = LogoOverlayStats();
+  configured_ = true;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value LogoOverlay::Free(const Napi::CallbackInfo& info) {
+  FreeInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value LogoOverlay::SetPosition(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected x and y").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Prepared planes do not depend on the position
+  std::lock_guard<std::mutex> lock(mutex_);
+  x_ = info[0].As<Napi::Number>().Int32Value();
+  y_ = info[1].As<Napi::Number>().Int32Value();
+  return env.Undefined();
+}
+
+Napi::Value LogoOverlay::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.Set("frames", Napi::Number::New(env, static_cast<double>(stats_.frames)));
+  stats.Set("skipped", Napi::Number::New(env, static_cast<double>(stats_.skipped)));
+  stats.Set("renders", Napi::Number::New(env, static_cast<double>(stats_.renders)));
+  return stats;
+}
+
+Napi::Value LogoOverlay::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,104 @@
+#ifndef FFMPEG_LOGO_OVERLAY_H
+#define FFMPEG_LOGO_OVERLAY_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libavutil/pixfmt.h>
+}
+
+namespace ffmpeg {
+
+// Premultiplied logo samples of one plane, cropped to the logo's bounding box
+struct OverlayPlane {
+  int x = 0;                      // Offset from the logo origin (plane samples)
+  int y = 0;
+  int width = 0;
+  int height = 0;
+  std::vector<uint16_t> alpha;    // 0..256
+  std::vector<uint32_t> premult;  // Code value * alpha
+  std::vector<int> row_begin;     // Span of non-zero alpha per row
+  std::vector<int> row_end;
+};
+
+// Logo rendered for one pixel format and color description
+struct OverlayPlanes {
+  int log2_w = 0;
+  int log2_h = 0;
+  int depth = 8;
+  OverlayPlane planes[3];
+};
+
+struct LogoOverlayStats {
+  uint64_t frames = 0;            // Frames the logo was blended into
+  uint64_t skipped = 0;           // Frames the logo did not intersect
+  uint64_t renders = 0;           // Formats the logo was prepared for
+};
+
+/**
+ * Static logo blended into video frames in place.
+ *
+ * The RGBA logo is converted once per target pixel format and color
+ * description into premultiplied, chroma-subsampled planes cropped to its
+ * visible bounding box. Blending then touches only that box with one
+ * multiply-add per sample. The prepared planes are immutable and blending
+ * runs outside the lock, so one overlay can serve many streams at once.
+ */
+class LogoOverlay : public Napi::ObjectWrap<LogoOverlay> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  LogoOverlay(const Napi::CallbackInfo& info);
+  ~LogoOverlay();
+
+private:
+  friend class LOApplyWorker;
+
+  using RenderKey = std::tuple<int, int, int>; // Format, colorspace, range
+
+  static Napi::FunctionReference constructor;
+
+  // Logo (straight alpha RGBA, cropped to non-transparent pixels)
+  bool configured_ = false;
+  int logo_width_ = 0;
+  int logo_height_ = 0;
+  int box_x_ = 0;
+  int box_y_ = 0;
+  int box_width_ = 0;
+  int box_height_ = 0;
+  std::vector<uint8_t> rgba_;     // box_width_ * box_height_ * 4
+
+  // Options
+  int x_ = 0;                     // Negative: from the right edge
+  int y_ = 0;                     // Negative: from the bottom edge
+  double opacity_ = 1.0;
+
+  // State (guarded by mutex_)
+  std::map<RenderKey, std::shared_ptr<const OverlayPlanes>> renders_;
+  LogoOverlayStats stats_;
+  std::mutex mutex_;
+
+  std::shared_ptr<const OverlayPlanes> Render(const RenderKey& key) const;
+  int ApplyFrame(AVFrame* frame);
+  void FreeInternal();
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value ApplyAsync(const Napi::CallbackInfo& info);
+  Napi::Value ApplySync(const Napi::CallbackInfo& info);
+  Napi::Value SetPosition(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_LOGO_OVERLAY_H
@@ -0,0 +1,64 @@
+#include "logo_overlay.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class LOApplyWorker : public Napi::AsyncWorker {
+public:
+  LOApplyWorker(Napi::Env env, LogoOverlay* overlay, Frame* frame)
+    : Napi::AsyncWorker(env),
+      overlay_(overlay),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    // Locks only to look up the prepared planes, blends of several streams run in parallel
+    ret_ = overlay_->ApplyFrame(frame_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  LogoOverlay* overlay_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value LogoOverlay::ApplyAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new LOApplyWorker(env, this, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
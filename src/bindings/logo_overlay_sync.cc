@@ -0,0 +1,19 @@
+#include "logo_overlay.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value LogoOverlay::ApplySync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ApplyFrame(frame->Get()));
+}
+
+} // namespace ffmpeg
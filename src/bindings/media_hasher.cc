@@ -0,0 +1,619 @@
+#include "media_hasher.h"
+#include "codec_parameters.h"
+#include "frame.h"
+#include "packet.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/avstring.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+#include <libavutil/samplefmt.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference MediaHasher::constructor;
+
+Napi::Object MediaHasher::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "MediaHasher", {
+    InstanceMethod<&MediaHasher::Alloc>("alloc"),
+    InstanceMethod<&MediaHasher::Free>("free"),
+    InstanceMethod<&MediaHasher::AddFrame>("addFrame"),
+    InstanceMethod<&MediaHasher::AddPacket>("addPacket"),
+    InstanceMethod<&MediaHasher::SetStream>("setStream"),
+    InstanceMethod<&MediaHasher::ScanAsync>("scan"),
+    InstanceMethod<&MediaHasher::ScanSync>("scanSync"),
+    InstanceMethod<&MediaHasher::GetEntries>("getEntries"),
+    InstanceMethod<&MediaHasher::GetHash>("getHash"),
+    InstanceMethod<&MediaHasher::ToFrameMd5>("toFrameMd5"),
+    InstanceMethod<&MediaHasher::Clear>("clear"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &MediaHasher::Dispose),
+
+    InstanceAccessor<&MediaHasher::GetAlgorithm>("algorithm"),
+    InstanceAccessor<&MediaHasher::GetDigestSize>("digestSize"),
+    InstanceAccessor<&MediaHasher::GetCount>("count"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("MediaHasher", func);
+  return exports;
+}
+
+MediaHasher::MediaHasher(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<MediaHasher>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+MediaHasher::~MediaHasher() {
+  // Manual cleanup if not already done
+  FreeInternal();
+}
+
+// === Hashing ===
+
+void MediaHasher::Record(int stream_index, int64_t pts, int64_t dts, int64_t duration, int size) {
+  streams_.push_back(stream_index);
+  pts_.push_back(pts);
+  dts_.push_back(dts);
+  durations_.push_back(duration);
+  sizes_.push_back(size);
+
+  size_t offset = digests_.size();
+  digests_.resize(offset + digest_size_);
+  av_hash_final_bin(hash_, digests_.data() + offset, digest_size_);
+}
+
+int MediaHasher::HashFrameLocked(const AVFrame* frame, int stream_index) {
+  if (!hash_) {
+    return AVERROR(EINVAL);
+  }
+  if (frame->hw_frames_ctx) {
+    // Hardware frames must be transferred to system memory first
+    return AVERROR(EINVAL);
+  }
+
+  int64_t size = 0;
+  av_hash_init(hash_);
+
+  if (frame->width > 0 && frame->height > 0) {
+    AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+    const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+    if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) {
+      return AVERROR(EINVAL);
+    }
+
+    // Visible rows only, same layout as av_image_copy_to_buffer(align = 1),
+    // so the digest matches a rawvideo packet of the frame
+    int planes = av_pix_fmt_count_planes(format);
+    for (int i = 0; i < planes; i++) {
+      if (!frame->data[i]) {
+        return AVERROR(EINVAL);
+      }
+      int row = av_image_get_linesize(format, frame->width, i);
+      if (row < 0) {
+        return row;
+      }
+      int shift = (i == 1 || i == 2) ? desc->log2_chroma_h : 0;
+      int rows = AV_CEIL_RSHIFT(frame->height, shift);
+
+      const uint8_t* src = frame->data[i];
+      for (int y = 0; y < rows; y++) {
+        av_hash_update(hash_, src, row);
+        src += frame->linesize[i];
+      }
+      size += static_cast<int64_t>(row) * rows;
+    }
+
+    if ((desc->flags & AV_PIX_FMT_FLAG_PAL) && frame->data[1]) {
+      av_hash_update(hash_, frame->data[1], 256 * 4);
+      size += 256 * 4;
+    }
+  } else if (frame->nb_samples > 0) {
+    AVSampleFormat format = static_cast<AVSampleFormat>(frame->format);
+    int bps = av_get_bytes_per_sample(format);
+    int channels = frame->ch_layout.nb_channels;
+    if (bps <= 0 || channels <= 0 || !frame->extended_data) {
+      return AVERROR(EINVAL);
+    }
+
+    if (!av_sample_fmt_is_planar(format) || channels == 1) {
+      size = static_cast<int64_t>(frame->nb_samples) * bps * channels;
+      av_hash_update(hash_, frame->extended_data[0], size);
+    } else {
+      // Hash interleaved samples (same as a packed PCM packet) through a
+      // small scratch buffer instead of converting the whole frame
+      uint8_t scratch[4096];
+      int per_chunk = static_cast<int>(sizeof(scratch)) / (bps * channels);
+      if (per_chunk < 1) {
+        return AVERROR(EINVAL);
+      }
+      for (int start = 0; start < frame->nb_samples; start += per_chunk) {
+        int count = FFMIN(per_chunk, frame->nb_samples - start);
+        uint8_t* dst = scratch;
+        for (int s = start; s < start + count; s++) {
+          for (int ch = 0; ch < channels; ch++) {
+            memcpy(dst, frame->extended_data[ch] + static_cast<size_t>(s) * bps, bps);
+            dst += bps;
+          }
+        }
+        av_hash_update(hash_, scratch, dst - scratch);
+      }
+      size = static_cast<int64_t>(frame->nb_samples) * bps * channels;
+    }
+  } else {
+    return AVERROR(EINVAL);
+  }
+
+  DescribeFrame(stream_index, frame);
+  Record(stream_index, frame->pts, frame->pts, frame->duration, static_cast<int>(size));
+  return 0;
+}
+
+int MediaHasher::HashPacketLocked(const AVPacket* packet) {
+  if (!hash_) {
+    return AVERROR(EINVAL);
+  }
+
+  av_hash_init(hash_);
+  if (packet->data && packet->size > 0) {
+    av_hash_update(hash_, packet->data, packet->size);
+  }
+
+  StreamInfo& stream = stream_info_[packet->stream_index];
+  if (stream.time_base.num <= 0 && packet->time_base.num > 0) {
+    stream.time_base = packet->time_base;
+  }
+
+  Record(packet->stream_index, packet->pts, packet->dts, packet->duration, packet->size);
+  return 0;
+}
+
+void MediaHasher::DescribeStream(int stream_index, const AVCodecParameters* par, AVRational time_base) {
+  StreamInfo& stream = stream_info_[stream_index];
+  stream.time_base = time_base;
+  stream.type = par->codec_type;
+  stream.codec_id = par->codec_id;
+  stream.width = par->width;
+  stream.height = par->height;
+  stream.sar = par->sample_aspect_ratio;
+  stream.sample_rate = par->sample_rate;
+
+  char layout[128] = { 0 };
+  if (par->ch_layout.nb_channels > 0 && av_channel_layout_describe(&par->ch_layout, layout, sizeof(layout)) >= 0) {
+    stream.channel_layout = layout;
+  }
+}
+
+void MediaHasher::DescribeFrame(int stream_index, const AVFrame* frame) {
+  StreamInfo& stream = stream_info_[stream_index];
+  if (stream.time_base.num <= 0 && frame->time_base.num > 0) {
+    stream.time_base = frame->time_base;
+  }
+  if (stream.type != AVMEDIA_TYPE_UNKNOWN && stream.codec_id != AV_CODEC_ID_NONE) {
+    return;
+  }
+
+  // Describe the stream as the raw encoding the digest corresponds to
+  if (frame->width > 0) {
+    stream.type = AVMEDIA_TYPE_VIDEO;
+    stream.codec_id = AV_CODEC_ID_RAWVIDEO;
+    stream.width = frame->width;
+    stream.height = frame->height;
+    stream.sar = frame->sample_aspect_ratio;
+  } else {
+    AVSampleFormat packed = av_get_packed_sample_fmt(static_cast<AVSampleFormat>(frame->format));
+    stream.type = AVMEDIA_TYPE_AUDIO;
+    stream.codec_id = av_get_pcm_codec(packed, 0);
+    stream.sample_rate = frame->sample_rate;
+
+    char layout[128] = { 0 };
+    if (av_channel_layout_describe(&frame->ch_layout, layout, sizeof(layout)) >= 0) {
+      stream.channel_layout = layout;
+    }
+  }
+}
+
+// === Scan ===
+
+int MediaHasher::ScanInternal() {
+  AVFormatContext* fmt = nullptr;
+  std::vector<AVCodecContext*> decoders;
+  AVPacket* packet = nullptr;
+  AVFrame* frame = nullptr;
+  int64_t hashed = 0;
+
+  int ret = avformat_open_input(&fmt, scan_url_.c_str(), nullptr, nullptr);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ret = avformat_find_stream_info(fmt, nullptr);
+  if (ret < 0) {
+    avformat_close_input(&fmt);
+    return ret;
+  }
+
+  if (scan_stream_ >= static_cast<int>(fmt->nb_streams)) {
+    avformat_close_input(&fmt);
+    return AVERROR_STREAM_NOT_FOUND;
+  }
+
+  decoders.assign(fmt->nb_streams, nullptr);
+  packet = av_packet_alloc();
+  frame = av_frame_alloc();
+  if (!packet || !frame) {
+    ret = AVERROR(ENOMEM);
+    goto end;
+  }
+
+  for (unsigned i = 0; i < fmt->nb_streams; i++) {
+    AVStream* st = fmt->streams[i];
+    bool selected = scan_stream_ < 0 || scan_stream_ == static_cast<int>(i);
+    if (!selected) {
+      st->discard = AVDISCARD_ALL;
+      continue;
+    }
+
+    if (!scan_decode_) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      DescribeStream(i, st->codecpar, st->time_base);
+      continue;
+    }
+
+    // Only audio and video have frame planes to hash
+    AVMediaType type = st->codecpar->codec_type;
+    const AVCodec* codec = avcodec_find_decoder(st->codecpar->codec_id);
+    if ((type != AVMEDIA_TYPE_VIDEO && type != AVMEDIA_TYPE_AUDIO) || !codec) {
+      st->discard = AVDISCARD_ALL;
+      continue;
+    }
+
+    AVCodecContext* dec = avcodec_alloc_context3(codec);
+    if (!dec) {
+      ret = AVERROR(ENOMEM);
+      goto end;
+    }
+    decoders[i] = dec;
+
+    ret = avcodec_parameters_to_context(dec, st->codecpar);
+    if (ret < 0) goto end;
+    dec->pkt_timebase = st->time_base;
+    dec->thread_count = 0;
+    ret = avcodec_open2(dec, codec, nullptr);
+    if (ret < 0) goto end;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_info_[i].time_base = st->time_base;
+  }
+
+  while (true) {
+    ret = av_read_frame(fmt, packet);
+    bool eof = ret == AVERROR_EOF;
+    if (ret < 0 && !eof) {
+      goto end;
+    }
+
+    if (!scan_decode_) {
+      if (eof) break;
+      if (scan_stream_ >= 0 && packet->stream_index != scan_stream_) {
+        av_packet_unref(packet);
+        continue;
+      }
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ret = HashPacketLocked(packet);
+      }
+      av_packet_unref(packet);
+      if (ret < 0) goto end;
+      hashed++;
+      continue;
+    }
+
+    // Decode (or drain all decoders on EOF) and hash every frame
+    for (unsigned i = 0; i < decoders.size(); i++) {
+      AVCodecContext* dec = decoders[i];
+      if (!dec || (!eof && packet->stream_index != static_cast<int>(i))) {
+        continue;
+      }
+
+      ret = avcodec_send_packet(dec, eof ? nullptr : packet);
+      if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+        // Corrupt packet, keep scanning like the ffmpeg CLI does
+        ret = 0;
+      }
+
+      while (avcodec_receive_frame(dec, frame) >= 0) {
+        frame->pts = frame->best_effort_timestamp;
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          ret = HashFrameLocked(frame, i);
+        }
+        av_frame_unref(frame);
+        if (ret < 0) goto end;
+        hashed++;
+      }
+    }
+    av_packet_unref(packet);
+
+    if (eof) break;
+  }
+
+  ret = 0;
+
+end:
+  for (AVCodecContext*& dec : decoders) {
+    avcodec_free_context(&dec);
+  }
+  av_frame_free(&frame);
+  av_packet_free(&packet);
+  avformat_close_input(&fmt);
+
+  return ret < 0 ? ret : static_cast<int>(hashed);
+}
+
+bool MediaHasher::PrepareScan(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "URL string required").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  scan_url_ = info[0].As<Napi::String>().Utf8Value();
+  scan_decode_ = info.Length() > 1 && info[1].IsString() && info[1].As<Napi::String>().Utf8Value() == "frames";
+  scan_stream_ = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : -1;
+  return true;
+}
+
+void MediaHasher::FreeInternal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  av_hash_freep(&hash_);
+  algorithm_.clear();
+  digest_size_ = 0;
+  streams_.clear();
+  pts_.clear();
+  dts_.clear();
+  durations_.clear();
+  sizes_.clear();
+  digests_.clear();
+  stream_info_.clear();
+}
+
+// === JS Methods ===
+
+Napi::Value MediaHasher::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  std::string requested = info.Length() > 0 && info[0].IsString() ? info[0].As<Napi::String>().Utf8Value() : "MD5";
+
+  // Accept libavutil hash names case-insensitively (md5, murmur3, crc32, sha256, ...)
+  const char* name = nullptr;
+  for (int i = 0; (name = av_hash_names(i)); i++) {
+    if (!av_strcasecmp(name, requested.c_str())) {
+      break;
+    }
+  }
+  if (!name) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  FreeInternal();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  int ret = av_hash_alloc(&hash_, name);
+  if (ret < 0) {
+    return Napi::Number::New(env, ret);
+  }
+  algorithm_ = name;
+  digest_size_ = av_hash_get_size(hash_);
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value MediaHasher::Free(const Napi::CallbackInfo& info) {
+  FreeInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value MediaHasher::AddFrame(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  int stream_index = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(env, HashFrameLocked(frame->Get(), stream_index));
+}
+
+Napi::Value MediaHasher::AddPacket(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(env, HashPacketLocked(packet->Get()));
+}
+
+Napi::Value MediaHasher::SetStream(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 3 || !info[0].IsNumber() || !info[2].IsObject()) {
+    Napi::TypeError::New(env, "Expected (streamIndex, codecpar, timeBase)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[1], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid codec parameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  DescribeStream(info[0].As<Napi::Number>().Int32Value(), par->Get(), JSToRational(info[2].As<Napi::Object>()));
+  return env.Undefined();
+}
+
+Napi::Value MediaHasher::GetEntries(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  size_t count = streams_.size();
+  auto streams = Napi::Int32Array::New(env, count);
+  auto pts = Napi::BigInt64Array::New(env, count);
+  auto dts = Napi::BigInt64Array::New(env, count);
+  auto durations = Napi::BigInt64Array::New(env, count);
+  auto sizes = Napi::Int32Array::New(env, count);
+
+  if (count > 0) {
+    memcpy(streams.Data(), streams_.data(), count * sizeof(int32_t));
+    memcpy(pts.Data(), pts_.data(), count * sizeof(int64_t));
+    memcpy(dts.Data(), dts_.data(), count * sizeof(int64_t));
+    memcpy(durations.Data(), durations_.data(), count * sizeof(int64_t));
+    memcpy(sizes.Data(), sizes_.data(), count * sizeof(int32_t));
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("streamIndex", streams);
+  result.Set("pts", pts);
+  result.Set("dts", dts);
+  result.Set("duration", durations);
+  result.Set("size", sizes);
+  result.Set("digests", Napi::Buffer<uint8_t>::Copy(env, digests_.data(), digests_.size()));
+  return result;
+}
+
+Napi::Value MediaHasher::GetHash(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Index required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t index = info[0].As<Napi::Number>().Int64Value();
+  if (index < 0 || index >= static_cast<int64_t>(streams_.size())) {
+    return env.Null();
+  }
+
+  static const char hex[] = "0123456789abcdef";
+  const uint8_t* digest = digests_.data() + index * digest_size_;
+  std::string out(digest_size_ * 2, '0');
+  for (int i = 0; i < digest_size_; i++) {
+    out[i * 2] = hex[digest[i] >> 4];
+    out[i * 2 + 1] = hex[digest[i] & 0xf];
+  }
+  return Napi::String::New(env, out);
+}
+
+Napi::Value MediaHasher::ToFrameMd5(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!hash_) {
+    return env.Null();
+  }
+
+  // Same layout as libavformat's framehash muxer (version 2)
+  std::string out;
+  char line[256];
+
+  out += "#format: frame checksums\n#version: 2\n";
+  out += "#hash: " + algorithm_ + "\n";
+
+  for (const auto& [index, stream] : stream_info_) {
+    snprintf(line, sizeof(line), "#tb %d: %d/%d\n", index, stream.time_base.num, stream.time_base.den);
+    out += line;
+    if (stream.type == AVMEDIA_TYPE_UNKNOWN) {
+      continue;
+    }
+
+    const char* type = av_get_media_type_string(stream.type);
+    snprintf(line, sizeof(line), "#media_type %d: %s\n", index, type ? type : "unknown");
+    out += line;
+    snprintf(line, sizeof(line), "#codec_id %d: %s\n", index, avcodec_get_name(stream.codec_id));
+    out += line;
+
+    if (stream.type == AVMEDIA_TYPE_AUDIO) {
+      snprintf(line, sizeof(line), "#sample_rate %d: %d\n", index, stream.sample_rate);
+      out += line;
+      snprintf(line, sizeof(line), "#channel_layout_name %d: %s\n", index, stream.channel_layout.c_str());
+      out += line;
+    } else if (stream.type == AVMEDIA_TYPE_VIDEO) {
+      snprintf(line, sizeof(line), "#dimensions %d: %dx%d\n", index, stream.width, stream.height);
+      out += line;
+      snprintf(line, sizeof(line), "#sar %d: %d/%d\n", index, stream.sar.num, stream.sar.den);
+      out += line;
+    }
+  }
+
+  out += "#stream#, dts,        pts, duration,     size, hash\n";
+
+  static const char hex[] = "0123456789abcdef";
+  for (size_t i = 0; i < streams_.size(); i++) {
+    snprintf(line, sizeof(line), "%d, %10" PRId64 ", %10" PRId64 ", %8" PRId64 ", %8d, ",
+             streams_[i], dts_[i], pts_[i], durations_[i], sizes_[i]);
+    out += line;
+
+    const uint8_t* digest = digests_.data() + i * digest_size_;
+    for (int b = 0; b < digest_size_; b++) {
+      out += hex[digest[b] >> 4];
+      out += hex[digest[b] & 0xf];
+    }
+    out += '\n';
+  }
+
+  return Napi::String::New(env, out);
+}
+
+Napi::Value MediaHasher::Clear(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  streams_.clear();
+  pts_.clear();
+  dts_.clear();
+  durations_.clear();
+  sizes_.clear();
+  digests_.clear();
+  stream_info_.clear();
+  return info.Env().Undefined();
+}
+
+Napi::Value MediaHasher::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+// === Properties ===
+
+Napi::Value MediaHasher::GetAlgorithm(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!hash_) {
+    return info.Env().Null();
+  }
+  return Napi::String::New(info.Env(), algorithm_);
+}
+
+Napi::Value MediaHasher::GetDigestSize(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), digest_size_);
+}
+
+Napi::Value MediaHasher::GetCount(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(streams_.size()));
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,100 @@
+#ifndef FFMPEG_MEDIA_HASHER_H
+#define FFMPEG_MEDIA_HASHER_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/hash.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Per-frame / per-packet hashing for QC and regression tests.
+ *
+ * Hashes frame planes row by row (honoring linesize, without copying) and
+ * packet payloads with any libavutil hash (MD5, murmur3, CRC32, SHA...).
+ * Results are kept in compact arrays and can be rendered as framemd5 text.
+ * A standalone scan demuxes (and optionally decodes) a file on a worker
+ * thread and hashes everything natively.
+ */
+class MediaHasher : public Napi::ObjectWrap<MediaHasher> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  MediaHasher(const Napi::CallbackInfo& info);
+  ~MediaHasher();
+
+private:
+  friend class MHScanWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct StreamInfo {
+    AVRational time_base = { 0, 1 };
+    AVMediaType type = AVMEDIA_TYPE_UNKNOWN;
+    AVCodecID codec_id = AV_CODEC_ID_NONE;
+    int width = 0;
+    int height = 0;
+    AVRational sar = { 0, 1 };
+    int sample_rate = 0;
+    std::string channel_layout;
+  };
+
+  // Hash state and results (guarded by mutex_)
+  AVHashContext* hash_ = nullptr;
+  std::string algorithm_;
+  int digest_size_ = 0;
+  std::vector<int32_t> streams_;
+  std::vector<int64_t> pts_;
+  std::vector<int64_t> dts_;
+  std::vector<int64_t> durations_;
+  std::vector<int32_t> sizes_;
+  std::vector<uint8_t> digests_;
+  std::map<int, StreamInfo> stream_info_;
+  std::mutex mutex_;
+
+  // Scan arguments
+  std::string scan_url_;
+  bool scan_decode_ = false;
+  int scan_stream_ = -1;
+
+  int HashFrameLocked(const AVFrame* frame, int stream_index);
+  int HashPacketLocked(const AVPacket* packet);
+  void Record(int stream_index, int64_t pts, int64_t dts, int64_t duration, int size);
+  void DescribeStream(int stream_index, const AVCodecParameters* par, AVRational time_base);
+  void DescribeFrame(int stream_index, const AVFrame* frame);
+  int ScanInternal();
+  void FreeInternal();
+
+  bool PrepareScan(const Napi::CallbackInfo& info);
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value AddFrame(const Napi::CallbackInfo& info);
+  Napi::Value AddPacket(const Napi::CallbackInfo& info);
+  Napi::Value SetStream(const Napi::CallbackInfo& info);
+  Napi::Value ScanAsync(const Napi::CallbackInfo& info);
+  Napi::Value ScanSync(const Napi::CallbackInfo& info);
+  Napi::Value GetEntries(const Napi::CallbackInfo& info);
+  Napi::Value GetHash(const Napi::CallbackInfo& info);
+  Napi::Value ToFrameMd5(const Napi::CallbackInfo& info);
+  Napi::Value Clear(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetAlgorithm(const Napi::CallbackInfo& info);
+  Napi::Value GetDigestSize(const Napi::CallbackInfo& info);
+  Napi::Value GetCount(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_MEDIA_HASHER_H
@@ -0,0 +1,58 @@
+#include "media_hasher.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class MHScanWorker : public Napi::AsyncWorker {
+public:
+  MHScanWorker(Napi::Env env, MediaHasher* hasher)
+    : Napi::AsyncWorker(env),
+      hasher_(hasher),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = hasher_->ScanInternal();
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  MediaHasher* hasher_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value MediaHasher::ScanAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareScan(info)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new MHScanWorker(env, this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
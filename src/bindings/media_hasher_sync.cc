@@ -0,0 +1,16 @@
+#include "media_hasher.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value MediaHasher::ScanSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareScan(info)) {
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ScanInternal());
+}
+
+} // namespace ffmpeg
@@ -1,4 +1,5 @@
 #include "packet.h"
+#include "packet_allocator.h"
 
 namespace ffmpeg {
 
@@ -121,7 +122,18 @@ Napi::Value Packet::Clone(const Napi::CallbackInfo& info) {
     return env.Null();
   }
   
-  AVPacket* cloned = av_packet_clone(packet_);
+  // Optional allocator for the payload copy
+  PacketAllocator* allocator = nullptr;
+  if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
+    allocator = UnwrapNativeObject<PacketAllocator>(env, info[0], "PacketAllocator");
+    if (!allocator) {
+      Napi::TypeError::New(env, "Invalid packet allocator").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  std::shared_ptr<PacketAllocatorState> state = allocator ? allocator->GetState() : nullptr;
+  AVPacket* cloned = state ? PacketAllocatorState::Clone(state, packet_) : av_packet_clone(packet_);
   if (!cloned) {
     return env.Null();
   }
@@ -0,0 +1,454 @@
+#include "packet_allocator.h"
+#include "packet.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+extern "C" {
+#include <libavutil/mem.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+std::atomic<uint64_t> next_allocator_id{1};
+
+} // namespace
+
+// === Thread cache ===
+
+// Set once the cache is destroyed at thread exit, later frees take the lock
+static thread_local bool thread_cache_gone = false;
+
+/**
+ * Free blocks kept by one thread, per allocator and size class.
+ *
+ * Only touched by its own thread, so no locking. Entries of allocators
+ * that are gone are dropped without touching their (freed) slabs.
+ */
+struct PacketThreadCache {
+  struct Entry {
+    uint64_t id = 0;
+    std::weak_ptr<PacketAllocatorState> state;
+    std::vector<uint8_t*> blocks[PacketAllocatorState::kMaxClasses];
+  };
+
+  std::vector<std::unique_ptr<Entry>> entries;
+
+  Entry* Find(const std::shared_ptr<PacketAllocatorState>& state) {
+    for (auto& entry : entries) {
+      if (entry->id == state->id) {
+        return entry.get();
+      }
+    }
+
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const std::unique_ptr<Entry>& entry) {
+      return entry->state.expired();
+    }), entries.end());
+
+    auto entry = std::make_unique<Entry>();
+    entry->id = state->id;
+    entry->state = state;
+    entries.push_back(std::move(entry));
+    return entries.back().get();
+  }
+
+  ~PacketThreadCache() {
+    thread_cache_gone = true;
+    // Hand cached blocks back so other threads can reuse them
+    for (auto& entry : entries) {
+      std::shared_ptr<PacketAllocatorState> state = entry->state.lock();
+      if (!state) {
+        continue;
+      }
+      for (int cls = 0; cls < state->classes; cls++) {
+        state->Spill(cls, &entry->blocks[cls], entry->blocks[cls].size());
+      }
+    }
+  }
+};
+
+static thread_local PacketThreadCache local_cache;
+
+// === Allocator state ===
+
+PacketAllocatorState::PacketAllocatorState(size_t max_size, size_t slab_size, bool thread_cache)
+  : id(next_allocator_id++), slab_size(slab_size), thread_cache(thread_cache) {
+  classes = ClassOf(max_size) + 1;
+  this->max_size = static_cast<size_t>(1) << (kMinClassShift + classes - 1);
+}
+
+PacketAllocatorState::~PacketAllocatorState() {
+  // Only runs once no block is referenced anymore
+  for (uint8_t* slab : slabs) {
+    av_free(slab);
+  }
+}
+
+int PacketAllocatorState::ClassOf(size_t size) const {
+  int cls = 0;
+  while ((static_cast<size_t>(1) << (kMinClassShift + cls)) < size) {
+    cls++;
+  }
+  int limit = classes > 0 ? classes : kMaxClasses;
+  return cls < limit ? cls : -1;
+}
+
+size_t PacketAllocatorState::BlockSize(int cls) const {
+  // Header, payload and padding, each a multiple of 64 bytes
+  return kHeaderSize + (static_cast<size_t>(1) << (kMinClassShift + cls)) + FFALIGN(AV_INPUT_BUFFER_PADDING_SIZE, 64);
+}
+
+int PacketAllocatorState::Refill(int cls, std::vector<uint8_t*>* out, size_t count) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::vector<uint8_t*>& list = free_lists[cls];
+
+  if (list.empty()) {
+    size_t block_size = BlockSize(cls);
+    size_t blocks = std::max<size_t>(1, slab_size / block_size);
+    uint8_t* slab = static_cast<uint8_t*>(av_malloc(blocks * block_size));
+    if (!slab) {
+      return AVERROR(ENOMEM);
+    }
+    slabs.push_back(slab);
+    slab_bytes += blocks * block_size;
+
+    // Reversed, so blocks are handed out in address order
+    for (size_t i = blocks; i > 0; i--) {
+      list.push_back(slab + (i - 1) * block_size);
+    }
+  }
+
+  count = std::min(count, list.size());
+  out->insert(out->end(), list.end() - count, list.end());
+  list.resize(list.size() - count);
+  return 0;
+}
+
+void PacketAllocatorState::Spill(int cls, std::vector<uint8_t*>* from, size_t count) {
+  std::lock_guard<std::mutex> lock(mutex);
+  count = std::min(count, from->size());
+  free_lists[cls].insert(free_lists[cls].end(), from->end() - count, from->end());
+  from->resize(from->size() - count);
+}
+
+uint8_t* PacketAllocatorState::Take(const std::shared_ptr<PacketAllocatorState>& state, int cls) {
+  if (!state->thread_cache || thread_cache_gone) {
+    std::vector<uint8_t*> out;
+    return state->Refill(cls, &out, 1) < 0 ? nullptr : out.back();
+  }
+
+  std::vector<uint8_t*>& cached = local_cache.Find(state)->blocks[cls];
+  if (!cached.empty()) {
+    state->cache_hits++;
+  } else if (state->Refill(cls, &cached, kBatch) < 0) {
+    return nullptr;
+  }
+
+  uint8_t* block = cached.back();
+  cached.pop_back();
+  return block;
+}
+
+void PacketAllocatorState::Give(const std::shared_ptr<PacketAllocatorState>& state, int cls, uint8_t* block) {
+  if (!state->thread_cache || thread_cache_gone) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->free_lists[cls].push_back(block);
+    return;
+  }
+
+  // Blocks freed on another thread than they were allocated on flow back
+  // through the shared list once this cache is full
+  std::vector<uint8_t*>& cached = local_cache.Find(state)->blocks[cls];
+  cached.push_back(block);
+  if (cached.size() > kCacheLimit) {
+    state->Spill(cls, &cached, kBatch);
+  }
+}
+
+void PacketAllocatorState::ReleaseBlock(void* opaque, uint8_t* data) {
+  auto* header = static_cast<BlockHeader*>(opaque);
+  std::shared_ptr<PacketAllocatorState> owner = std::move(header->owner);
+  int cls = header->cls;
+  int size = header->size;
+  header->~BlockHeader();
+
+  owner->in_use--;
+  owner->bytes_in_use -= size;
+  Give(owner, cls, reinterpret_cast<uint8_t*>(header));
+  // May drop the last state reference (and with it the slabs)
+}
+
+AVBufferRef* PacketAllocatorState::Alloc(const std::shared_ptr<PacketAllocatorState>& state, int size) {
+  if (size < 0) {
+    return nullptr;
+  }
+  int cls = state->ClassOf(static_cast<size_t>(size));
+  if (cls < 0) {
+    return nullptr;
+  }
+
+  uint8_t* block = Take(state, cls);
+  if (!block) {
+    return nullptr;
+  }
+
+  static_assert(sizeof(BlockHeader) <= kHeaderSize, "Block header does not fit");
+  auto* header = new (block) BlockHeader{ state, cls, size };
+  uint8_t* data = block + kHeaderSize;
+  memset(data + size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+  AVBufferRef* buf = av_buffer_create(data, size + AV_INPUT_BUFFER_PADDING_SIZE, ReleaseBlock, header, 0);
+  if (!buf) {
+    header->~BlockHeader();
+    Give(state, cls, block);
+    return nullptr;
+  }
+
+  state->allocations++;
+  state->in_use++;
+  state->bytes_in_use += size;
+  return buf;
+}
+
+bool PacketAllocatorState::IsSlabBuffer(const AVBufferRef* buf) {
+  return buf && av_buffer_get_opaque(buf) == buf->data - kHeaderSize;
+}
+
+int PacketAllocatorState::NewPacket(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt, int size) {
+  AVBufferRef* buf = Alloc(state, size);
+  if (!buf) {
+    state->fallbacks++;
+    return av_new_packet(pkt, size);
+  }
+
+  pkt->buf = buf;
+  pkt->data = buf->data;
+  pkt->size = size;
+  return 0;
+}
+
+int PacketAllocatorState::Adopt(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt) {
+  if (!pkt->data || pkt->size <= 0 || IsSlabBuffer(pkt->buf)) {
+    return 0;
+  }
+  if (static_cast<size_t>(pkt->size) > state->max_size) {
+    return 0;
+  }
+
+  AVBufferRef* buf = Alloc(state, pkt->size);
+  if (!buf) {
+    state->fallbacks++;
+    return 0;
+  }
+
+  // The demuxer's short-lived buffer is freed right away on this thread
+  memcpy(buf->data, pkt->data, pkt->size);
+  av_buffer_unref(&pkt->buf);
+  pkt->buf = buf;
+  pkt->data = buf->data;
+  state->copies++;
+  return 1;
+}
+
+AVPacket* PacketAllocatorState::Clone(const std::shared_ptr<PacketAllocatorState>& state, const AVPacket* src) {
+  if (!src->data || src->size <= 0 || static_cast<size_t>(src->size) > state->max_size || IsSlabBuffer(src->buf)) {
+    return av_packet_clone(src);
+  }
+
+  AVPacket* dst = av_packet_alloc();
+  if (!dst) {
+    return nullptr;
+  }
+
+  AVBufferRef* buf = Alloc(state, src->size);
+  if (!buf) {
+    state->fallbacks++;
+    av_packet_free(&dst);
+    return av_packet_clone(src);
+  }
+
+  if (av_packet_copy_props(dst, src) < 0) {
+    av_buffer_unref(&buf);
+    av_packet_free(&dst);
+    return nullptr;
+  }
+
+  memcpy(buf->data, src->data, src->size);
+  dst->buf = buf;
+  dst->data = buf->data;
+  dst->size = src->size;
+  state->copies++;
+  return dst;
+}
+
+int PacketAllocatorState::GetEncodeBuffer(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt) {
+  AVBufferRef* buf = Alloc(state, pkt->size);
+  if (!buf) {
+    return AVERROR(ENOMEM);
+  }
+
+  pkt->buf = buf;
+  pkt->data = buf->data;
+  return 0;
+}
+
+// === PacketAllocator ===
+
+Napi::FunctionReference PacketAllocator::constructor;
+
+Napi::Object PacketAllocator::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "PacketAllocator", {
+    InstanceMethod<&PacketAllocator::Alloc>("alloc"),
+    InstanceMethod<&PacketAllocator::Free>("free"),
+    InstanceMethod<&PacketAllocator::AllocPacket>("allocPacket"),
+    InstanceMethod<&PacketAllocator::Adopt>("adopt"),
+    InstanceMethod<&PacketAllocator::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &PacketAllocator::Dispose),
+
+    InstanceAccessor<&PacketAllocator::GetMaxSize>("maxSize"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PacketAllocator", func);
+  return exports;
+}
+
+PacketAllocator::PacketAllocator(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PacketAllocator>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+PacketAllocator::~PacketAllocator() {
+  // Outstanding buffers keep the state (and slabs) alive
+  state_.reset();
+}
+
+Napi::Value PacketAllocator::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int64_t max_size = 4096;
+  int64_t slab_size = 64 * 1024;
+  bool thread_cache = true;
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (options.Has("maxSize") && options.Get("maxSize").IsNumber()) {
+      max_size = options.Get("maxSize").As<Napi::Number>().Int64Value();
+    }
+    if (options.Has("slabSize") && options.Get("slabSize").IsNumber()) {
+      slab_size = options.Get("slabSize").As<Napi::Number>().Int64Value();
+    }
+    if (options.Has("threadCache") && options.Get("threadCache").IsBoolean()) {
+      thread_cache = options.Get("threadCache").As<Napi::Boolean>().Value();
+    }
+  }
+
+  int64_t largest = static_cast<int64_t>(1) << (PacketAllocatorState::kMinClassShift + PacketAllocatorState::kMaxClasses - 1);
+  if (max_size <= 0 || max_size > largest || slab_size <= 0 || slab_size > INT32_MAX) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  state_ = std::make_shared<PacketAllocatorState>(static_cast<size_t>(max_size), static_cast<size_t>(slab_size), thread_cache);
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value PacketAllocator::Free(const Napi::CallbackInfo& info) {
+  state_.reset();
+  return info.Env().Undefined();
+}
+
+Napi::Value PacketAllocator::AllocPacket(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get() || info.Length() < 2 || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Expected (packet, size)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int size = info[1].As<Napi::Number>().Int32Value();
+  if (size < 0) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  av_packet_unref(packet->Get());
+  return Napi::Number::New(env, PacketAllocatorState::NewPacket(state_, packet->Get(), size));
+}
+
+Napi::Value PacketAllocator::Adopt(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = info.Length() > 0 ? UnwrapNativeObject<Packet>(env, info[0], "Packet") : nullptr;
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!state_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  return Napi::Number::New(env, PacketAllocatorState::Adopt(state_, packet->Get()));
+}
+
+Napi::Value PacketAllocator::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::Object stats = Napi::Object::New(env);
+
+  double allocations = 0;
+  double cache_hits = 0;
+  double fallbacks = 0;
+  double copies = 0;
+  double in_use = 0;
+  double bytes_in_use = 0;
+  double slabs = 0;
+  double slab_bytes = 0;
+  double free_blocks = 0;
+
+  if (state_) {
+    allocations = static_cast<double>(state_->allocations.load());
+    cache_hits = static_cast<double>(state_->cache_hits.load());
+    fallbacks = static_cast<double>(state_->fallbacks.load());
+    copies = static_cast<double>(state_->copies.load());
+    in_use = static_cast<double>(state_->in_use.load());
+    bytes_in_use = static_cast<double>(state_->bytes_in_use.load());
+    slab_bytes = static_cast<double>(state_->slab_bytes.load());
+
+    // Blocks parked in thread caches are neither in use nor listed here
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    slabs = static_cast<double>(state_->slabs.size());
+    for (int cls = 0; cls < state_->classes; cls++) {
+      free_blocks += static_cast<double>(state_->free_lists[cls].size());
+    }
+  }
+
+  stats.Set("allocations", Napi::Number::New(env, allocations));
+  stats.Set("cacheHits", Napi::Number::New(env, cache_hits));
+  stats.Set("fallbacks", Napi::Number::New(env, fallbacks));
+  stats.Set("copies", Napi::Number::New(env, copies));
+  stats.Set("inUse", Napi::Number::New(env, in_use));
+  stats.Set("bytesInUse", Napi::Number::New(env, bytes_in_use));
+  stats.Set("slabs", Napi::Number::New(env, slabs));
+  stats.Set("slabBytes", Napi::Number::New(env, slab_bytes));
+  stats.Set("freeBlocks", Napi::Number::New(env, free_blocks));
+  return stats;
+}
+
+Napi::Value PacketAllocator::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+// === Properties ===
+
+Napi::Value PacketAllocator::GetMaxSize(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), state_ ? static_cast<double>(state_->max_size) : 0);
+}
+
+} // namespace ffmpeg
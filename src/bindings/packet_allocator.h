@@ -0,0 +1,122 @@
+#ifndef FFMPEG_PACKET_ALLOCATOR_H
+#define FFMPEG_PACKET_ALLOCATOR_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/buffer.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Slab allocator for small packet payloads.
+ *
+ * Payloads are rounded up to a power-of-two size class and carved out of
+ * larger slabs. Freed blocks go to a per-thread cache first and spill to
+ * the shared per-class free list in batches, so the common alloc/free pair
+ * takes no lock. Shared with every buffer handed out, so blocks can be
+ * returned after the PacketAllocator object is gone.
+ */
+struct PacketAllocatorState {
+  static constexpr int kMinClassShift = 6;        // 64 bytes
+  static constexpr int kMaxClasses = 10;          // Up to 32 KiB
+  static constexpr int kHeaderSize = 64;          // Keeps payloads as aligned as the slab
+  static constexpr size_t kCacheLimit = 64;       // Blocks per class in a thread cache
+  static constexpr size_t kBatch = 32;            // Blocks moved between cache and free list
+
+  uint64_t id = 0;
+  int classes = 0;
+  size_t max_size = 0;
+  size_t slab_size = 0;
+  bool thread_cache = true;
+
+  std::mutex mutex;
+  std::vector<uint8_t*> slabs;
+  std::vector<uint8_t*> free_lists[kMaxClasses];
+
+  std::atomic<uint64_t> allocations{0};
+  std::atomic<uint64_t> cache_hits{0};
+  std::atomic<uint64_t> fallbacks{0};
+  std::atomic<uint64_t> copies{0};
+  std::atomic<int64_t> in_use{0};
+  std::atomic<int64_t> bytes_in_use{0};
+  std::atomic<uint64_t> slab_bytes{0};
+
+  PacketAllocatorState(size_t max_size, size_t slab_size, bool thread_cache);
+  ~PacketAllocatorState();
+
+  int ClassOf(size_t size) const;
+  size_t BlockSize(int cls) const;
+
+  // Buffer of size + AV_INPUT_BUFFER_PADDING_SIZE bytes with zeroed padding, null if too large
+  static AVBufferRef* Alloc(const std::shared_ptr<PacketAllocatorState>& state, int size);
+  // Allocate the payload of an empty packet, like av_new_packet()
+  static int NewPacket(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt, int size);
+  // Move a small payload into slab memory, returns 1 if copied, 0 if left alone
+  static int Adopt(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt);
+  // av_packet_clone() with the payload copied into slab memory
+  static AVPacket* Clone(const std::shared_ptr<PacketAllocatorState>& state, const AVPacket* src);
+  // AVCodecContext.get_encode_buffer helper
+  static int GetEncodeBuffer(const std::shared_ptr<PacketAllocatorState>& state, AVPacket* pkt);
+
+  // Whether the buffer was handed out by any packet allocator
+  static bool IsSlabBuffer(const AVBufferRef* buf);
+
+private:
+  struct BlockHeader {
+    std::shared_ptr<PacketAllocatorState> owner;
+    int cls;
+    int size;
+  };
+
+  static uint8_t* Take(const std::shared_ptr<PacketAllocatorState>& state, int cls);
+  static void Give(const std::shared_ptr<PacketAllocatorState>& state, int cls, uint8_t* block);
+  int Refill(int cls, std::vector<uint8_t*>* out, size_t count);
+  void Spill(int cls, std::vector<uint8_t*>* from, size_t count);
+  static void ReleaseBlock(void* opaque, uint8_t* data);
+
+  friend struct PacketThreadCache;
+};
+
+/**
+ * Packet payload allocator.
+ *
+ * Hands out padded AVBufferRefs for packets up to `maxSize` bytes from
+ * slab memory. Used by demuxers (FormatContext), encoders (CodecContext)
+ * and Packet.clone().
+ */
+class PacketAllocator : public Napi::ObjectWrap<PacketAllocator> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  PacketAllocator(const Napi::CallbackInfo& info);
+  ~PacketAllocator();
+
+  std::shared_ptr<PacketAllocatorState> GetState() { return state_; }
+
+private:
+  static Napi::FunctionReference constructor;
+
+  std::shared_ptr<PacketAllocatorState> state_;
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value AllocPacket(const Napi::CallbackInfo& info);
+  Napi::Value Adopt(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetMaxSize(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PACKET_ALLOCATOR_H
@@ -0,0 +1,524 @@
+#include "packet_router.h"
+#include "format_context.h"
+
+extern "C" {
+#include <libavutil/error.h>
+#include <libavutil/mathematics.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference PacketRouter::constructor;
+
+// Upper bound for a missed header notification while the reader waits to hold more packets
+
+Napi::Object PacketRouter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "PacketRouter", {
+    // Setup
+    InstanceMethod<&PacketRouter::SetInput>("setInput"),
+    InstanceMethod<&PacketRouter::AddRoute>("addRoute"),
+    InstanceMethod<&PacketRouter::AddPassthrough>("addPassthrough"),
+    InstanceMethod<&PacketRouter::Start>("start"),
+
+    // Consumption
+    InstanceMethod<&PacketRouter::ReceivePacketAsync>("receivePacket"),
+    InstanceMethod<&PacketRouter::ReceivePacketSync>("receivePacketSync"),
+    InstanceMethod<&PacketRouter::CloseRoute>("closeRoute"),
+    InstanceMethod<&PacketRouter::Flush>("flush"),
+    InstanceMethod<&PacketRouter::WaitAsync>("wait"),
+    InstanceMethod<&PacketRouter::WaitSync>("waitSync"),
+
+    // Lifecycle
+    InstanceMethod<&PacketRouter::Stop>("stop"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &PacketRouter::Dispose),
+
+    // Properties
+    InstanceAccessor<&PacketRouter::GetIsRunning>("isRunning"),
+    InstanceMethod<&PacketRouter::GetStats>("getStats"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PacketRouter", func);
+  return exports;
+}
+
+PacketRouter::PacketRouter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PacketRouter>(info) {
+  // Constructor does nothing - user must call setInput() and addRoute()/addPassthrough()
+}
+
+PacketRouter::~PacketRouter() {
+  // start() keeps the router alive until the reader has exited and been joined, so a
+  // reader can only still run here at environment teardown, where calls into JS fail
+  // instead of blocking and the input interrupt aborts I/O
+  StopInternal();
+  if (reader_.joinable()) {
+    reader_.join();
+  }
+
+  // Outputs may already be finalized - no reader is left, so release without their lock
+  for (auto& route : routes_) {
+    for (AVPacket* packet : route->pending) {
+      av_packet_free(&packet);
+    }
+    route->pending.clear();
+  }
+
+  for (auto& ref : refs_) {
+    ref.Reset();
+  }
+  refs_.clear();
+}
+
+// === Reader thread ===
+
+void PacketRouter::ReaderLoop() {
+  AVPacket* packet = av_packet_alloc();
+  if (!packet) {
+    read_error_ = AVERROR(ENOMEM);
+  }
+
+  // Stops early once every route has been closed
+  while (packet && !stopping_ && open_routes_ > 0 && read_error_ == 0) {
+    int ret = input_->ReadPacket(packet);
+    if (ret < 0) {
+      // AVERROR_EXIT from an interrupted read is the expected result of stop()
+      if (ret != AVERROR_EOF && !stopping_) {
+        read_error_ = ret;
+      }
+      break;
+    }
+
+    packets_read_++;
+
+    int stream_index = packet->stream_index;
+    if (stream_index >= 0 && stream_index < static_cast<int>(by_stream_.size())) {
+      for (Route* route : by_stream_[stream_index]) {
+        if (route->closed) {
+          continue;
+        }
+
+        route->packets_routed++;
+        if (route->output) {
+          WritePassthrough(route, packet);
+          continue;
+        }
+
+        // New reference, the payload is shared between routes of the same stream
+        AVPacket* queued = av_packet_clone(packet);
+        if (!queued) {
+          read_error_ = AVERROR(ENOMEM);
+          break;
+        }
+
+        // Blocks while the consumer of this route is behind
+        if (!route->packets.Push(queued)) {
+          av_packet_free(&queued);
+        }
+      }
+    }
+
+    av_packet_unref(packet);
+  }
+
+  av_packet_free(&packet);
+
+  // End of input - let every consumer drain its queue
+  for (auto& route : routes_) {
+    route->packets.Close();
+  }
+
+  // Stopped: nothing will flush the packets held for outputs without header
+  if (stopping_) {
+    ReleasePending();
+  }
+
+  // Sync writes from JS are safe again
+  for (auto& route : routes_) {
+    if (route->output) {
+      route->output->RemoveNativeWriter();
+    }
+  }
+
+  {
+    // Done with the input: undo the interrupt of stop() so it can be read again
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    finished_ = true;
+    if (interrupted_) {
+      input_->ResumeReads();
+      interrupted_ = false;
+    }
+  }
+
+  // Join and drop the start() reference on the JS thread
+  exit_tsfn_.NonBlockingCall([this](Napi::Env, Napi::Function) { OnReaderExit(); });
+  exit_tsfn_.Release();
+}
+
+void PacketRouter::WritePassthrough(Route* route, const AVPacket* packet) {
+  // Muxer is shared with JS writes and other routers
+  std::lock_guard<std::mutex> lock(route->output->WriteMutex());
+  if (stopping_ || route->closed) {
+    return;
+  }
+
+  int ret = 0;
+  AVPacket* copy = av_packet_clone(packet);
+  if (!copy) {
+    ret = AVERROR(ENOMEM);
+  } else if (!route->output->IsHeaderWritten()) {
+    // Header waits for encoder streams, which are fed by this reader through JS
+    // routes - hold the packet until it is written, never block on it
+    route->pending.push_back(copy);
+    route->pending_count = route->pending.size();
+    return;
+  } else {
+    ret = WritePending(route);
+    if (ret >= 0) {
+      ret = WriteLocked(route, copy);
+    }
+    av_packet_free(&copy);
+  }
+
+  if (ret < 0) {
+    route->error = ret;
+    CloseRouteInternal(route);
+  }
+}
+
+int PacketRouter::WritePending(Route* route) {
+  int ret = 0;
+  while (!route->pending.empty() && ret >= 0) {
+    AVPacket* packet = route->pending.front();
+    route->pending.pop_front();
+    ret = WriteLocked(route, packet);
+    av_packet_free(&packet);
+  }
+  route->pending_count = route->pending.size();
+  return ret;
+}
+
+int PacketRouter::WriteLocked(Route* route, AVPacket* packet) {
+  AVFormatContext* output = route->output->Get();
+  if (!output || route->output_index >= static_cast<int>(output->nb_streams)) {
+    av_packet_unref(packet);
+    return AVERROR(EINVAL);
+  }
+
+  // Output time base is only final once the header has been written
+  AVStream* in = input_->Get()->streams[route->stream_index];
+  AVStream* out = output->streams[route->output_index];
+  av_packet_rescale_ts(packet, in->time_base, out->time_base);
+  packet->stream_index = route->output_index;
+  packet->pos = -1;
+
+  // Takes over the packet reference
+  int ret = av_interleaved_write_frame(output, packet);
+  if (ret >= 0) {
+    route->packets_written++;
+  }
+  return ret;
+}
+
+void PacketRouter::CloseRouteInternal(Route* route) {
+  if (!route->closed.exchange(true)) {
+    open_routes_--;
+  }
+  route->packets.Close();
+}
+
+void PacketRouter::ReleasePending() {
+  for (auto& route : routes_) {
+    if (!route->output) {
+      continue;
+    }
+    std::lock_guard<std::mutex> lock(route->output->WriteMutex());
+    for (AVPacket* packet : route->pending) {
+      av_packet_free(&packet);
+    }
+    route->pending.clear();
+    route->pending_count = 0;
+  }
+}
+
+void PacketRouter::OnReaderExit() {
+  // The reader has returned from its loop, joining does not wait on any I/O
+  JoinInternal();
+  Unref();
+}
+
+int PacketRouter::JoinInternal() {
+  std::lock_guard<std::mutex> lock(join_mutex_);
+
+  if (reader_.joinable()) {
+    reader_.join();
+  }
+
+  if (read_error_ < 0) {
+    return read_error_;
+  }
+  for (auto& route : routes_) {
+    if (route->error < 0) {
+      return route->error;
+    }
+  }
+  return 0;
+}
+
+void PacketRouter::StopInternal() {
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    stopping_ = true;
+
+    // Aborts network reads and read pacing; a read through a JS callback returns once
+    // the event loop runs it, which is why this never joins the reader
+    if (started_ && !finished_ && !interrupted_) {
+      input_->InterruptReads();
+      interrupted_ = true;
+    }
+  }
+
+  // Wake a reader blocked on a full queue and release what is queued
+  for (auto& route : routes_) {
+    route->packets.Close();
+    route->packets.Drain([](AVPacket*& packet) { av_packet_free(&packet); });
+  }
+}
+
+PacketRouter::Route* PacketRouter::FindRoute(const Napi::Value& value) {
+  if (!value.IsNumber()) {
+    return nullptr;
+  }
+  int id = value.As<Napi::Number>().Int32Value();
+  if (id < 0 || id >= static_cast<int>(routes_.size())) {
+    return nullptr;
+  }
+  return routes_[id].get();
+}
+
+// === Setup ===
+
+Napi::Value PacketRouter::SetInput(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (started_) {
+    Napi::Error::New(env, "PacketRouter already started").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (formatContext)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  FormatContext* fmt = UnwrapNativeObject<FormatContext>(env, info[0], "FormatContext");
+  if (!fmt || !fmt->Get() || fmt->IsOutput()) {
+    Napi::TypeError::New(env, "Invalid input FormatContext object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info.Length() > 1 && info[1].IsNumber()) {
+    int size = info[1].As<Napi::Number>().Int32Value();
+    queue_size_ = size > 0 ? static_cast<size_t>(size) : 1;
+  }
+
+  input_ = fmt;
+  by_stream_.assign(fmt->Get()->nb_streams, {});
+  refs_.push_back(Napi::Persistent(info[0].As<Napi::Object>()));
+
+  return env.Undefined();
+}
+
+Napi::Value PacketRouter::AddRoute(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!input_ || started_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected 1 argument (streamIndex)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int stream_index = info[0].As<Napi::Number>().Int32Value();
+  if (stream_index < 0 || stream_index >= static_cast<int>(by_stream_.size())) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  auto route = std::make_unique<Route>(queue_size_);
+  route->stream_index = stream_index;
+
+  by_stream_[stream_index].push_back(route.get());
+  routes_.push_back(std::move(route));
+
+  return Napi::Number::New(env, static_cast<int>(routes_.size()) - 1);
+}
+
+Napi::Value PacketRouter::AddPassthrough(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!input_ || started_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  if (info.Length() < 3) {
+    Napi::TypeError::New(env, "Expected 3 arguments (streamIndex, formatContext, outputStreamIndex)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int stream_index = info[0].As<Napi::Number>().Int32Value();
+  if (stream_index < 0 || stream_index >= static_cast<int>(by_stream_.size())) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  FormatContext* output = UnwrapNativeObject<FormatContext>(env, info[1], "FormatContext");
+  if (!output || !output->Get() || !output->IsOutput()) {
+    Napi::TypeError::New(env, "Invalid output FormatContext object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int output_index = info[2].As<Napi::Number>().Int32Value();
+  if (output_index < 0 || output_index >= static_cast<int>(output->Get()->nb_streams)) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  auto route = std::make_unique<Route>(1);
+  route->stream_index = stream_index;
+  route->output = output;
+  route->output_index = output_index;
+
+  // Keep the output alive while the reader writes to it
+  refs_.push_back(Napi::Persistent(info[1].As<Napi::Object>()));
+
+  by_stream_[stream_index].push_back(route.get());
+  routes_.push_back(std::move(route));
+
+  return Napi::Number::New(env, static_cast<int>(routes_.size()) - 1);
+}
+
+Napi::Value PacketRouter::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!input_ || !input_->Get() || started_ || routes_.empty()) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  started_ = true;
+  open_routes_ = static_cast<int>(routes_.size());
+
+  // Keep the router, and through refs_ its input and outputs, alive until the reader has exited
+  exit_tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "PacketRouterExit",
+    0,  // Unlimited queue
+    1   // Reader thread
+  );
+  exit_tsfn_.Unref(env);
+  Ref();
+
+  for (auto& route : routes_) {
+    if (route->output) {
+      route->output->AddNativeWriter();
+    }
+  }
+
+  reader_ = std::thread(&PacketRouter::ReaderLoop, this);
+
+  return Napi::Number::New(env, 0);
+}
+
+// === Consumption ===
+
+Napi::Value PacketRouter::CloseRoute(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Route* route = info.Length() > 0 ? FindRoute(info[0]) : nullptr;
+  if (!route) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  CloseRouteInternal(route);
+  route->packets.Drain([](AVPacket*& packet) { av_packet_free(&packet); });
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value PacketRouter::Flush(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  // The reader may hold a muxer lock while waiting for a JS callback write
+  if (started_ && !finished_) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
+  int ret = 0;
+  for (auto& route : routes_) {
+    if (!route->output || route->error < 0) {
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(route->output->WriteMutex());
+    if (route->pending.empty()) {
+      continue;
+    }
+    if (!route->output->IsHeaderWritten()) {
+      // Still waiting for the header of this output
+      ret = ret < 0 ? ret : AVERROR(EAGAIN);
+      continue;
+    }
+
+    int err = WritePending(route.get());
+    if (err < 0) {
+      route->error = err;
+      ret = err;
+    }
+  }
+
+  return Napi::Number::New(env, ret);
+}
+
+// === Lifecycle ===
+
+Napi::Value PacketRouter::Stop(const Napi::CallbackInfo& info) {
+  StopInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value PacketRouter::Dispose(const Napi::CallbackInfo& info) {
+  return Stop(info);
+}
+
+// === Properties ===
+
+Napi::Value PacketRouter::GetIsRunning(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), started_ && !stopping_ && !finished_);
+}
+
+Napi::Value PacketRouter::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("packetsRead", Napi::Number::New(env, static_cast<double>(packets_read_.load())));
+
+  Napi::Array routes = Napi::Array::New(env, routes_.size());
+  for (size_t i = 0; i < routes_.size(); i++) {
+    Route* route = routes_[i].get();
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("streamIndex", Napi::Number::New(env, route->stream_index));
+    entry.Set("passthrough", Napi::Boolean::New(env, route->output != nullptr));
+    entry.Set("packetsRouted", Napi::Number::New(env, static_cast<double>(route->packets_routed.load())));
+    entry.Set("packetsWritten", Napi::Number::New(env, static_cast<double>(route->packets_written.load())));
+    entry.Set("queued", Napi::Number::New(env, static_cast<double>(route->packets.Size())));
+    entry.Set("pending", Napi::Number::New(env, static_cast<double>(route->pending_count.load())));
+    routes.Set(static_cast<uint32_t>(i), entry);
+  }
+  stats.Set("routes", routes);
+
+  return stats;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,127 @@
+#ifndef FFMPEG_PACKET_ROUTER_H
+#define FFMPEG_PACKET_ROUTER_H
+
+#include <napi.h>
+#include "common.h"
+#include "bounded_queue.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace ffmpeg {
+
+class FormatContext;
+
+/**
+ * Demuxes an input on a dedicated thread and routes its packets to any
+ * number of routes.
+ *
+ * A route either buffers the packets of one input stream in a bounded queue
+ * for JS, or copies them straight into a stream of an output format context
+ * (passthrough). Passthrough packets are rescaled and interleaved by the
+ * muxer on the reader thread; until the output header has been written they
+ * are held natively so lazily initialized encoder streams can catch up.
+ *
+ * stop() never waits for the reader: it may be blocked in a read or write
+ * that calls back into JS. It signals the reader and interrupts the input,
+ * wait() joins it off the JS thread. The router keeps itself alive until
+ * the reader has exited.
+ */
+class PacketRouter : public Napi::ObjectWrap<PacketRouter> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  PacketRouter(const Napi::CallbackInfo& info);
+  ~PacketRouter();
+
+private:
+  friend class PRReceivePacketWorker;
+  friend class PRWaitWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct Route {
+    explicit Route(size_t capacity) : packets(capacity) {}
+
+    int stream_index = -1;
+    // Passthrough target, null for routes consumed from JS
+    FormatContext* output = nullptr;
+    int output_index = -1;
+
+    BoundedQueue<AVPacket*> packets;
+    // Passthrough packets waiting for the output header - guarded by the output's WriteMutex()
+    std::deque<AVPacket*> pending;
+
+    std::atomic<bool> closed{false};
+    std::atomic<int> error{0};
+    std::atomic<uint64_t> packets_routed{0};
+    std::atomic<uint64_t> packets_written{0};
+    std::atomic<size_t> pending_count{0};
+  };
+
+  FormatContext* input_ = nullptr;
+  std::vector<Napi::ObjectReference> refs_;
+
+  std::vector<std::unique_ptr<Route>> routes_;
+  std::vector<std::vector<Route*>> by_stream_;
+
+  std::thread reader_;
+  std::mutex join_mutex_;
+  // Reports the reader's exit to the JS thread, which joins it and drops the start() reference
+  Napi::ThreadSafeFunction exit_tsfn_;
+  // Orders stop()'s input interrupt with the reader's exit
+  std::mutex state_mutex_;
+  bool interrupted_ = false;
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> finished_{false};
+  std::atomic<int> read_error_{0};
+  std::atomic<int> open_routes_{0};
+  std::atomic<uint64_t> packets_read_{0};
+  size_t queue_size_ = 64;
+  bool started_ = false;
+
+  void ReaderLoop();
+  void WritePassthrough(Route* route, const AVPacket* packet);
+  int WritePending(Route* route);
+  int WriteLocked(Route* route, AVPacket* packet);
+  void CloseRouteInternal(Route* route);
+  void ReleasePending();
+  void OnReaderExit();
+  int JoinInternal();
+  void StopInternal();
+  Route* FindRoute(const Napi::Value& value);
+
+  // Setup
+  Napi::Value SetInput(const Napi::CallbackInfo& info);
+  Napi::Value AddRoute(const Napi::CallbackInfo& info);
+  Napi::Value AddPassthrough(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+
+  // Consumption
+  Napi::Value ReceivePacketAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceivePacketSync(const Napi::CallbackInfo& info);
+  Napi::Value CloseRoute(const Napi::CallbackInfo& info);
+  Napi::Value Flush(const Napi::CallbackInfo& info);
+  Napi::Value WaitAsync(const Napi::CallbackInfo& info);
+  Napi::Value WaitSync(const Napi::CallbackInfo& info);
+
+  // Lifecycle
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetIsRunning(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PACKET_ROUTER_H
@@ -0,0 +1,126 @@
+#include "packet_router.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class PRReceivePacketWorker : public Napi::AsyncWorker {
+public:
+  PRReceivePacketWorker(Napi::Env env, PacketRouter* router, PacketRouter::Route* route, Packet* packet)
+    : Napi::AsyncWorker(env),
+      router_(router),
+      route_(route),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    AVPacket* routed = nullptr;
+    if (!route_->packets.Pop(routed)) {
+      ret_ = router_->read_error_ < 0 ? router_->read_error_.load() : AVERROR_EOF;
+      return;
+    }
+
+    av_packet_unref(packet_->Get());
+    av_packet_move_ref(packet_->Get(), routed);
+    av_packet_free(&routed);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  PacketRouter* router_;
+  PacketRouter::Route* route_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class PRWaitWorker : public Napi::AsyncWorker {
+public:
+  PRWaitWorker(Napi::Env env, PacketRouter* router)
+    : Napi::AsyncWorker(env),
+      router_(router),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = router_->JoinInternal();
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  PacketRouter* router_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value PacketRouter::ReceivePacketAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (route, packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Route* route = FindRoute(info[0]);
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[1], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Unknown route or packets go straight to an output
+  if (!route || route->output || !started_) {
+    auto deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(Napi::Number::New(env, AVERROR(EINVAL)));
+    return deferred.Promise();
+  }
+
+  auto* worker = new PRReceivePacketWorker(env, this, route, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value PacketRouter::WaitAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  auto* worker = new PRWaitWorker(env, this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,44 @@
+#include "packet_router.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value PacketRouter::ReceivePacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (route, packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Route* route = FindRoute(info[0]);
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[1], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Unknown route or packets go straight to an output
+  if (!route || route->output || !started_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  AVPacket* routed = nullptr;
+  if (!route->packets.Pop(routed)) {
+    int ret = read_error_ < 0 ? read_error_.load() : AVERROR_EOF;
+    return Napi::Number::New(env, ret);
+  }
+
+  av_packet_unref(packet->Get());
+  av_packet_move_ref(packet->Get(), routed);
+  av_packet_free(&routed);
+
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value PacketRouter::WaitSync(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), JoinInternal());
+}
+
+} // namespace ffmpeg
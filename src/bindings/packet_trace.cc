@@ -0,0 +1,668 @@
+#include "packet_trace.h"
+#include "wire_format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+extern "C" {
+#include <libavutil/time.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+int SeekFile(FILE* file, int64_t offset) {
+#ifdef _WIN32
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+}
+
+int64_t TellFile(FILE* file) {
+#ifdef _WIN32
+  return _ftelli64(file);
+#else
+  return static_cast<int64_t>(ftello(file));
+#endif
+}
+
+struct TraceStream {
+  int index = -1;
+  AVRational time_base{ 0, 1 };
+  AVRational avg_frame_rate{ 0, 1 };
+  AVRational r_frame_rate{ 0, 1 };
+  int64_t start_time = AV_NOPTS_VALUE;
+  int64_t duration = AV_NOPTS_VALUE;
+  AVCodecParameters* par = nullptr;
+
+  // Timestamp range of the recorded packets
+  int64_t first_ts = AV_NOPTS_VALUE;
+  int64_t end_ts = AV_NOPTS_VALUE;
+};
+
+void EncodeStream(WireEncoder* e, const AVStream* st) {
+  e->I32(st->index);
+  e->Rational(st->time_base);
+  e->Rational(st->avg_frame_rate);
+  e->Rational(st->r_frame_rate);
+  e->I64(st->start_time);
+  e->I64(st->duration);
+
+  EncodeCodecParameters(e, st->codecpar);
+}
+
+int DecodeStream(WireDecoder* d, TraceStream* s) {
+  s->index = d->I32();
+  s->time_base = d->Rational();
+  s->avg_frame_rate = d->Rational();
+  s->r_frame_rate = d->Rational();
+  s->start_time = d->I64();
+  s->duration = d->I64();
+
+  s->par = avcodec_parameters_alloc();
+  if (!s->par) {
+    return AVERROR(ENOMEM);
+  }
+  return DecodeCodecParameters(d, s->par);
+}
+
+} // namespace
+
+// === Writer ===
+
+PacketTraceWriter::~PacketTraceWriter() {
+  Close();
+}
+
+int PacketTraceWriter::Open(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_) {
+    return AVERROR(EBUSY);
+  }
+
+  FILE* file = fopen(path.c_str(), "wb");
+  if (!file) {
+    return AVERROR(errno);
+  }
+  setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+  std::vector<uint8_t> header;
+  WireEncoder e(&header);
+  for (char c : PacketTraceFormat::kMagic) {
+    e.U8(static_cast<uint8_t>(c));
+  }
+  e.U32(PacketTraceFormat::kVersion);
+  e.U32(0);
+  e.I64(av_gettime());
+
+  if (fwrite(header.data(), 1, header.size(), file) != header.size()) {
+    fclose(file);
+    return AVERROR(EIO);
+  }
+
+  file_ = file;
+  error_ = 0;
+  start_ = av_gettime_relative();
+  written_streams_.clear();
+  stats_ = PacketTraceStats();
+  return 0;
+}
+
+int PacketTraceWriter::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_) {
+    return error_;
+  }
+
+  if (fclose(file_) != 0 && error_ == 0) {
+    error_ = AVERROR(EIO);
+  }
+  file_ = nullptr;
+  return error_;
+}
+
+bool PacketTraceWriter::IsOpen() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return file_ != nullptr;
+}
+
+PacketTraceStats PacketTraceWriter::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+int PacketTraceWriter::WriteRecord(uint8_t type, const std::vector<uint8_t>& payload) {
+  uint8_t head[5] = { type };
+  uint32_t length = static_cast<uint32_t>(payload.size());
+  for (int i = 0; i < 4; i++) {
+    head[1 + i] = static_cast<uint8_t>(length >> (8 * i));
+  }
+
+  if (fwrite(head, 1, sizeof(head), file_) != sizeof(head) ||
+      (length > 0 && fwrite(payload.data(), 1, length, file_) != length)) {
+    // Sticky, the capture is incomplete from here on
+    error_ = AVERROR(EIO);
+  }
+  return error_;
+}
+
+int PacketTraceWriter::WriteStream(const AVStream* st) {
+  std::vector<uint8_t> payload;
+  WireEncoder e(&payload);
+  EncodeStream(&e, st);
+
+  int ret = WriteRecord(PacketTraceFormat::kStream, payload);
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (written_streams_.size() <= static_cast<size_t>(st->index)) {
+    written_streams_.resize(st->index + 1, false);
+  }
+  written_streams_[st->index] = true;
+  stats_.streams++;
+  return 0;
+}
+
+int PacketTraceWriter::AddStreams(const AVFormatContext* ctx) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_ || error_ < 0) {
+    return error_ < 0 ? error_ : AVERROR(EINVAL);
+  }
+
+  for (unsigned int i = 0; i < ctx->nb_streams; i++) {
+    if (i < written_streams_.size() && written_streams_[i]) {
+      continue;
+    }
+    int ret = WriteStream(ctx->streams[i]);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+  return 0;
+}
+
+int PacketTraceWriter::Write(const AVFormatContext* ctx, const AVPacket* pkt) {
+  int64_t arrival = av_gettime_relative();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_ || error_ < 0) {
+    return error_;
+  }
+  if (pkt->stream_index < 0 || static_cast<unsigned int>(pkt->stream_index) >= ctx->nb_streams) {
+    return AVERROR(EINVAL);
+  }
+
+  // Streams that appeared after the recorder was attached
+  size_t index = static_cast<size_t>(pkt->stream_index);
+  if (index >= written_streams_.size() || !written_streams_[index]) {
+    int ret = WriteStream(ctx->streams[index]);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  std::vector<uint8_t> payload;
+  payload.reserve(64 + pkt->size);
+  WireEncoder e(&payload);
+  e.I32(pkt->stream_index);
+  e.I32(pkt->flags);
+  e.I64(pkt->pts);
+  e.I64(pkt->dts);
+  e.I64(pkt->duration);
+  e.I64(pkt->pos);
+  e.I64(arrival - start_);
+  e.Bytes(pkt->data, pkt->data ? pkt->size : 0);
+  e.U32(static_cast<uint32_t>(pkt->side_data_elems));
+  for (int i = 0; i < pkt->side_data_elems; i++) {
+    e.I32(pkt->side_data[i].type);
+    e.Bytes(pkt->side_data[i].data, pkt->side_data[i].size);
+  }
+
+  int ret = WriteRecord(PacketTraceFormat::kPacket, payload);
+  if (ret < 0) {
+    return ret;
+  }
+
+  stats_.packets++;
+  stats_.bytes += pkt->size;
+  stats_.duration_us = arrival - start_;
+  return 0;
+}
+
+// === Reader ===
+
+PacketTraceOptions ParsePacketTraceOptions(const Napi::Value& value) {
+  PacketTraceOptions options;
+  if (!value.IsObject()) {
+    return options;
+  }
+
+  Napi::Object obj = value.As<Napi::Object>();
+  if (obj.Has("realtime") && obj.Get("realtime").IsBoolean()) {
+    options.realtime = obj.Get("realtime").As<Napi::Boolean>().Value();
+  }
+  if (obj.Has("speed") && obj.Get("speed").IsNumber()) {
+    options.speed = obj.Get("speed").As<Napi::Number>().DoubleValue();
+  }
+  return options;
+}
+
+PacketTraceReader::~PacketTraceReader() {
+  if (file_) {
+    fclose(file_);
+  }
+}
+
+int PacketTraceReader::Open(const std::string& path, const PacketTraceOptions& options, AVFormatContext* ctx, std::unique_ptr<PacketTraceReader>* out) {
+  std::unique_ptr<PacketTraceReader> reader(new PacketTraceReader());
+  reader->options_ = options;
+  if (reader->options_.speed <= 0) {
+    reader->options_.speed = 1.0;
+  }
+
+  reader->file_ = fopen(path.c_str(), "rb");
+  if (!reader->file_) {
+    return AVERROR(errno);
+  }
+
+  uint8_t header[PacketTraceFormat::kHeaderSize];
+  if (fread(header, 1, sizeof(header), reader->file_) != sizeof(header) ||
+      memcmp(header, PacketTraceFormat::kMagic, sizeof(PacketTraceFormat::kMagic)) != 0) {
+    return AVERROR_INVALIDDATA;
+  }
+  WireDecoder d(header + sizeof(PacketTraceFormat::kMagic), sizeof(header) - sizeof(PacketTraceFormat::kMagic));
+  if (d.U32() != PacketTraceFormat::kVersion) {
+    return AVERROR_PATCHWELCOME;
+  }
+
+  reader->data_start_ = PacketTraceFormat::kHeaderSize;
+  int ret = reader->Scan(ctx);
+  if (ret < 0) {
+    return ret;
+  }
+
+  *out = std::move(reader);
+  return 0;
+}
+
+int PacketTraceReader::ReadRecord(uint8_t* type, std::vector<uint8_t>* payload) {
+  uint8_t head[5];
+  if (fread(head, 1, sizeof(head), file_) != sizeof(head)) {
+    return AVERROR_EOF;
+  }
+
+  *type = head[0];
+  uint32_t length = 0;
+  for (int i = 0; i < 4; i++) {
+    length |= static_cast<uint32_t>(head[1 + i]) << (8 * i);
+  }
+
+  payload->resize(length);
+  if (length > 0 && fread(payload->data(), 1, length, file_) != length) {
+    return AVERROR_EOF;
+  }
+  return 0;
+}
+
+int PacketTraceReader::Scan(AVFormatContext* ctx) {
+  // Fixed part of a packet record: stream, flags, pts, dts, duration, pos, arrival, size
+  constexpr size_t kPacketFixed = 4 + 4 + 8 * 5 + 4;
+
+  std::vector<TraceStream> streams;
+  int ret = 0;
+  int64_t pos = data_start_;
+
+  while (true) {
+    uint8_t head[5];
+    if (SeekFile(file_, pos) != 0 || fread(head, 1, sizeof(head), file_) != sizeof(head)) {
+      break;
+    }
+    uint32_t length = 0;
+    for (int i = 0; i < 4; i++) {
+      length |= static_cast<uint32_t>(head[1 + i]) << (8 * i);
+    }
+
+    if (head[0] == PacketTraceFormat::kStream) {
+      std::vector<uint8_t> payload(length);
+      if (length > 0 && fread(payload.data(), 1, length, file_) != length) {
+        break;
+      }
+      WireDecoder d(payload.data(), payload.size());
+      TraceStream stream;
+      ret = DecodeStream(&d, &stream);
+      if (ret < 0 || stream.index < 0 || stream.index >= 65536) {
+        avcodec_parameters_free(&stream.par);
+        break;
+      }
+      if (streams.size() <= static_cast<size_t>(stream.index)) {
+        streams.resize(stream.index + 1);
+      }
+      avcodec_parameters_free(&streams[stream.index].par);
+      streams[stream.index] = stream;
+    } else if (head[0] == PacketTraceFormat::kPacket) {
+      uint8_t fixed[kPacketFixed];
+      if (length < kPacketFixed || fread(fixed, 1, sizeof(fixed), file_) != sizeof(fixed)) {
+        break;
+      }
+      // Only complete records count
+      if (SeekFile(file_, pos + 5 + length - 1) != 0 || fgetc(file_) == EOF) {
+        break;
+      }
+
+      WireDecoder d(fixed, sizeof(fixed));
+      int index = d.I32();
+      int flags = d.I32();
+      int64_t pts = d.I64();
+      int64_t dts = d.I64();
+      int64_t duration = d.I64();
+      d.I64();
+      int64_t arrival = d.I64();
+      uint32_t size = d.U32();
+
+      int64_t ts = pts != AV_NOPTS_VALUE ? pts : dts;
+      if (index >= 0 && static_cast<size_t>(index) < streams.size() && ts != AV_NOPTS_VALUE) {
+        TraceStream& s = streams[index];
+        if (s.first_ts == AV_NOPTS_VALUE || ts < s.first_ts) {
+          s.first_ts = ts;
+        }
+        int64_t end = ts + std::max<int64_t>(duration, 0);
+        if (s.end_ts == AV_NOPTS_VALUE || end > s.end_ts) {
+          s.end_ts = end;
+        }
+        if (flags & AV_PKT_FLAG_KEY) {
+          keyframes_.push_back({ pos, index, ts });
+        }
+      }
+
+      stats_.packets++;
+      stats_.bytes += size;
+      stats_.duration_us = arrival;
+    }
+    // Unknown record types are skipped
+
+    pos += 5 + static_cast<int64_t>(length);
+    data_end_ = pos;
+  }
+
+  if (ret < 0) {
+    for (TraceStream& s : streams) {
+      avcodec_parameters_free(&s.par);
+    }
+    return ret;
+  }
+
+  // Recreate the streams with their recorded indices
+  int64_t start_time = AV_NOPTS_VALUE;
+  int64_t end_time = AV_NOPTS_VALUE;
+  for (size_t i = 0; i < streams.size(); i++) {
+    TraceStream& s = streams[i];
+    AVStream* st = avformat_new_stream(ctx, nullptr);
+    if (!st) {
+      ret = AVERROR(ENOMEM);
+      break;
+    }
+    if (!s.par) {
+      // Gap in the recorded indices
+      st->codecpar->codec_type = AVMEDIA_TYPE_DATA;
+      continue;
+    }
+
+    avcodec_parameters_copy(st->codecpar, s.par);
+    if (s.time_base.num > 0 && s.time_base.den > 0) {
+      st->time_base = s.time_base;
+    }
+    st->avg_frame_rate = s.avg_frame_rate;
+    st->r_frame_rate = s.r_frame_rate;
+    st->start_time = s.start_time != AV_NOPTS_VALUE ? s.start_time : s.first_ts;
+    st->duration = s.duration;
+    if (st->duration == AV_NOPTS_VALUE && s.first_ts != AV_NOPTS_VALUE) {
+      st->duration = s.end_ts - s.first_ts;
+    }
+
+    if (s.first_ts != AV_NOPTS_VALUE) {
+      int64_t first = av_rescale_q(s.first_ts, st->time_base, AV_TIME_BASE_Q);
+      int64_t end = av_rescale_q(s.end_ts, st->time_base, AV_TIME_BASE_Q);
+      start_time = start_time == AV_NOPTS_VALUE ? first : std::min(start_time, first);
+      end_time = end_time == AV_NOPTS_VALUE ? end : std::max(end_time, end);
+    }
+  }
+
+  for (TraceStream& s : streams) {
+    avcodec_parameters_free(&s.par);
+  }
+  if (ret < 0) {
+    return ret;
+  }
+
+  if (start_time != AV_NOPTS_VALUE) {
+    ctx->start_time = start_time;
+    ctx->duration = end_time - start_time;
+  }
+
+  return SeekFile(file_, data_start_) != 0 ? AVERROR(EIO) : 0;
+}
+
+void PacketTraceReader::Pace(int64_t arrival) {
+  if (!options_.realtime) {
+    return;
+  }
+
+  int64_t now = av_gettime_relative();
+  if (base_wall_ < 0) {
+    base_wall_ = now;
+    base_arrival_ = arrival;
+    return;
+  }
+
+  int64_t target = base_wall_ + static_cast<int64_t>((arrival - base_arrival_) / options_.speed);
+  while (!interrupted_ && (now = av_gettime_relative()) < target) {
+    // Short sleeps so Interrupt() takes effect quickly
+    av_usleep(static_cast<unsigned>(std::min<int64_t>(target - now, 10000)));
+  }
+}
+
+void PacketTraceReader::Interrupt() {
+  interrupted_ = true;
+}
+
+void PacketTraceReader::Resume() {
+  interrupted_ = false;
+}
+
+int PacketTraceReader::Read(AVPacket* pkt) {
+  av_packet_unref(pkt);
+
+  while (true) {
+    if (TellFile(file_) >= data_end_) {
+      return AVERROR_EOF;
+    }
+
+    uint8_t type = 0;
+    int ret = ReadRecord(&type, &record_);
+    if (ret < 0) {
+      return ret;
+    }
+    if (type != PacketTraceFormat::kPacket) {
+      continue;
+    }
+
+    WireDecoder d(record_.data(), record_.size());
+    pkt->stream_index = d.I32();
+    pkt->flags = d.I32();
+    pkt->pts = d.I64();
+    pkt->dts = d.I64();
+    pkt->duration = d.I64();
+    pkt->pos = d.I64();
+    int64_t arrival = d.I64();
+
+    uint32_t size = 0;
+    const uint8_t* data = d.Bytes(&size);
+    if (!data) {
+      av_packet_unref(pkt);
+      return AVERROR_INVALIDDATA;
+    }
+    ret = av_new_packet(pkt, static_cast<int>(size));
+    if (ret < 0) {
+      av_packet_unref(pkt);
+      return ret;
+    }
+    memcpy(pkt->data, data, size);
+
+    uint32_t count = d.U32();
+    for (uint32_t i = 0; i < count && d.ok(); i++) {
+      AVPacketSideDataType side_type = static_cast<AVPacketSideDataType>(d.I32());
+      const uint8_t* side = d.Bytes(&size);
+      if (!side) {
+        break;
+      }
+      uint8_t* dst = av_packet_new_side_data(pkt, side_type, size);
+      if (!dst) {
+        av_packet_unref(pkt);
+        return AVERROR(ENOMEM);
+      }
+      memcpy(dst, side, size);
+    }
+    if (!d.ok()) {
+      av_packet_unref(pkt);
+      return AVERROR_INVALIDDATA;
+    }
+
+    Pace(arrival);
+    // Interrupted while pacing, the caller gets no packet with the error
+    if (interrupted_) {
+      av_packet_unref(pkt);
+      return AVERROR_EXIT;
+    }
+    return 0;
+  }
+}
+
+int PacketTraceReader::Seek(AVFormatContext* ctx, int stream_index, int64_t timestamp, int flags) {
+  if (flags & AVSEEK_FLAG_BYTE) {
+    return AVERROR(ENOSYS);
+  }
+
+  if (stream_index < 0) {
+    stream_index = av_find_default_stream_index(ctx);
+    if (stream_index < 0) {
+      return AVERROR(EINVAL);
+    }
+    timestamp = av_rescale_q(timestamp, AV_TIME_BASE_Q, ctx->streams[stream_index]->time_base);
+  }
+
+  // Last keyframe at or before the target, or the first one after it
+  const Keyframe* before = nullptr;
+  const Keyframe* after = nullptr;
+  for (const Keyframe& kf : keyframes_) {
+    if (kf.stream != stream_index) {
+      continue;
+    }
+    if (kf.ts <= timestamp) {
+      before = &kf;
+    } else if (!after) {
+      after = &kf;
+    }
+  }
+
+  const Keyframe* target = (flags & AVSEEK_FLAG_BACKWARD) ? (before ? before : after) : (after ? after : before);
+  if (!target && !keyframes_.empty()) {
+    return AVERROR(EPERM);
+  }
+
+  int64_t offset = target ? target->offset : data_start_;
+  if (SeekFile(file_, offset) != 0) {
+    return AVERROR(EIO);
+  }
+
+  // Pacing restarts at the new position
+  base_wall_ = -1;
+  return 0;
+}
+
+// === PacketRecorder ===
+
+Napi::FunctionReference PacketRecorder::constructor;
+
+Napi::Object PacketRecorder::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "PacketRecorder", {
+    InstanceMethod<&PacketRecorder::Open>("open"),
+    InstanceMethod<&PacketRecorder::Close>("close"),
+    InstanceMethod<&PacketRecorder::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &PacketRecorder::Dispose),
+
+    InstanceAccessor<&PacketRecorder::GetIsOpen>("isOpen"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PacketRecorder", func);
+  return exports;
+}
+
+PacketRecorder::PacketRecorder(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PacketRecorder>(info) {
+  // Constructor does nothing - user must explicitly call open()
+}
+
+PacketRecorder::~PacketRecorder() {
+  // Format contexts still holding the writer close it when they let go
+}
+
+Napi::Value PacketRecorder::Open(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsString()) {
+    Napi::TypeError::New(env, "Trace file path required").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto writer = std::make_shared<PacketTraceWriter>();
+  int ret = writer->Open(info[0].As<Napi::String>().Utf8Value());
+  if (ret < 0) {
+    return Napi::Number::New(env, ret);
+  }
+
+  if (writer_) {
+    writer_->Close();
+  }
+  writer_ = writer;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value PacketRecorder::Close(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (!writer_) {
+    return Napi::Number::New(env, 0);
+  }
+  return Napi::Number::New(env, writer_->Close());
+}
+
+Napi::Value PacketRecorder::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  PacketTraceStats stats = writer_ ? writer_->GetStats() : PacketTraceStats();
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("packets", Napi::Number::New(env, static_cast<double>(stats.packets)));
+  result.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+  result.Set("streams", Napi::Number::New(env, static_cast<double>(stats.streams)));
+  result.Set("duration", Napi::Number::New(env, static_cast<double>(stats.duration_us) / 1000000.0));
+  return result;
+}
+
+Napi::Value PacketRecorder::Dispose(const Napi::CallbackInfo& info) {
+  Close(info);
+  return info.Env().Undefined();
+}
+
+// === Properties ===
+
+Napi::Value PacketRecorder::GetIsOpen(const Napi::CallbackInfo& info) {
+  return Napi::Boolean::New(info.Env(), writer_ && writer_->IsOpen());
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,166 @@
+#ifndef FFMPEG_PACKET_TRACE_H
+#define FFMPEG_PACKET_TRACE_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Packet trace file format (little-endian):
+ *
+ *   header:  "NAVTRACE" u32 version u32 reserved i64 wall-clock start (us)
+ *   record:  u8 type u32 length payload[length]
+ *
+ * Record types are 'S' (stream: index, timing, codec parameters, coded side
+ * data) and 'P' (packet: stream, flags, pts/dts/duration/pos, arrival time
+ * relative to the start, payload, side data). A stream record precedes the
+ * first packet of its stream. A truncated last record is ignored, so traces
+ * of crashed captures stay readable.
+ */
+struct PacketTraceFormat {
+  static constexpr char kMagic[8] = { 'N', 'A', 'V', 'T', 'R', 'A', 'C', 'E' };
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kHeaderSize = 24;
+  static constexpr uint8_t kStream = 'S';
+  static constexpr uint8_t kPacket = 'P';
+};
+
+struct PacketTraceStats {
+  uint64_t packets = 0;
+  uint64_t bytes = 0;             // Payload bytes
+  uint64_t streams = 0;
+  int64_t duration_us = 0;        // Arrival time of the last packet
+};
+
+/**
+ * Writes the packets read from one input to a trace file.
+ *
+ * Thread-safe, writes happen on the thread that read the packet.
+ */
+class PacketTraceWriter {
+public:
+  ~PacketTraceWriter();
+
+  int Open(const std::string& path);
+  int Close();
+
+  // Record the stream layout known so far
+  int AddStreams(const AVFormatContext* ctx);
+  // Record a packet that just arrived from ctx
+  int Write(const AVFormatContext* ctx, const AVPacket* pkt);
+
+  PacketTraceStats GetStats();
+  bool IsOpen();
+
+private:
+  int WriteStream(const AVStream* st);
+  int WriteRecord(uint8_t type, const std::vector<uint8_t>& payload);
+
+  std::mutex mutex_;
+  FILE* file_ = nullptr;
+  int error_ = 0;
+  int64_t start_ = 0;
+  std::vector<bool> written_streams_;
+  PacketTraceStats stats_;
+};
+
+struct PacketTraceOptions {
+  bool realtime = false;          // Deliver packets at their recorded arrival times
+  double speed = 1.0;             // Pacing factor for realtime replay
+};
+
+// Reads { realtime, speed } from a JavaScript options object
+PacketTraceOptions ParsePacketTraceOptions(const Napi::Value& value);
+
+/**
+ * Reads a trace file back as an input.
+ *
+ * Open() creates the recorded streams on the format context; Read() then
+ * returns the packets in recorded order, optionally paced by their arrival
+ * times. Keyframes are indexed on open for seeking.
+ */
+class PacketTraceReader {
+public:
+  ~PacketTraceReader();
+
+  static int Open(const std::string& path, const PacketTraceOptions& options, AVFormatContext* ctx, std::unique_ptr<PacketTraceReader>* out);
+
+  int Read(AVPacket* pkt);
+  int Seek(AVFormatContext* ctx, int stream_index, int64_t timestamp, int flags);
+  // Wakes a paced Read() waiting for the next arrival time
+  void Interrupt();
+  void Resume();
+
+  PacketTraceStats GetStats() const { return stats_; }
+
+private:
+  struct Keyframe {
+    int64_t offset;               // Record start in the file
+    int stream;
+    int64_t ts;                   // pts, or dts when pts is unset
+  };
+
+  PacketTraceReader() = default;
+
+  int Scan(AVFormatContext* ctx);
+  int ReadRecord(uint8_t* type, std::vector<uint8_t>* payload);
+  void Pace(int64_t arrival);
+
+  FILE* file_ = nullptr;
+  PacketTraceOptions options_;
+  int64_t data_start_ = 0;        // First record
+  int64_t data_end_ = 0;          // End of the last complete record
+  std::vector<Keyframe> keyframes_;
+  std::vector<uint8_t> record_;
+  PacketTraceStats stats_;
+
+  // Pacing reference, reset by seeks
+  int64_t base_wall_ = -1;
+  int64_t base_arrival_ = 0;
+  std::atomic<bool> interrupted_{false};
+};
+
+/**
+ * Packet trace recorder.
+ *
+ * Attached to an input FormatContext, captures every packet read together
+ * with the stream parameters and arrival times.
+ */
+class PacketRecorder : public Napi::ObjectWrap<PacketRecorder> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  PacketRecorder(const Napi::CallbackInfo& info);
+  ~PacketRecorder();
+
+  std::shared_ptr<PacketTraceWriter> GetWriter() { return writer_; }
+
+private:
+  static Napi::FunctionReference constructor;
+
+  std::shared_ptr<PacketTraceWriter> writer_;
+
+  Napi::Value Open(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  Napi::Value GetIsOpen(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PACKET_TRACE_H
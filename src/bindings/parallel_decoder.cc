@@ -0,0 +1,324 @@
+#include "parallel_decoder.h"
+#include "common.h"
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/error.h>
+}
+
+namespace ffmpeg {
+
+Napi::FunctionReference ParallelDecoder::constructor;
+
+// Upper bound for the number of decoder instances
+static constexpr int kMaxParallelWorkers = 64;
+
+Napi::Object ParallelDecoder::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "ParallelDecoder", {
+    // Static
+    StaticMethod<&ParallelDecoder::IsSupported>("isSupported"),
+
+    // Lifecycle
+    InstanceMethod<&ParallelDecoder::OpenAsync>("open"),
+    InstanceMethod<&ParallelDecoder::OpenSync>("openSync"),
+    InstanceMethod<&ParallelDecoder::Close>("close"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &ParallelDecoder::Dispose),
+
+    // Decoding
+    InstanceMethod<&ParallelDecoder::SendPacketAsync>("sendPacket"),
+    InstanceMethod<&ParallelDecoder::SendPacketSync>("sendPacketSync"),
+    InstanceMethod<&ParallelDecoder::ReceiveFrameAsync>("receiveFrame"),
+    InstanceMethod<&ParallelDecoder::ReceiveFrameSync>("receiveFrameSync"),
+
+    // Properties
+    InstanceAccessor<&ParallelDecoder::GetWorkers>("workers"),
+    InstanceAccessor<&ParallelDecoder::GetPending>("pending"),
+    InstanceAccessor<&ParallelDecoder::GetIsOpen>("isOpen"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ParallelDecoder", func);
+  return exports;
+}
+
+ParallelDecoder::ParallelDecoder(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ParallelDecoder>(info) {
+  // Constructor does nothing - user must explicitly call open()
+}
+
+ParallelDecoder::~ParallelDecoder() {
+  // Stop worker threads and release all decoder instances
+  CloseInternal();
+}
+
+// === Internal ===
+
+int ParallelDecoder::OpenInternal(const AVCodecParameters* par, AVRational pkt_timebase,
+                                  int count, const AVDictionary* options) {
+  if (is_open_) {
+    return AVERROR(EINVAL);
+  }
+
+  if (!par) {
+    return AVERROR(EINVAL);
+  }
+
+  const AVCodecDescriptor* desc = avcodec_descriptor_get(par->codec_id);
+  if (!desc || !(desc->props & AV_CODEC_PROP_INTRA_ONLY)) {
+    // Only intra-only codecs can be split across independent contexts
+    return AVERROR(ENOSYS);
+  }
+
+  const AVCodec* codec = avcodec_find_decoder(par->codec_id);
+  if (!codec) {
+    return AVERROR_DECODER_NOT_FOUND;
+  }
+
+  if (count < 1) count = 1;
+  if (count > kMaxParallelWorkers) count = kMaxParallelWorkers;
+
+  std::vector<Worker*> workers;
+  int ret = 0;
+
+  for (int i = 0; i < count; i++) {
+    Worker* worker = new Worker();
+    workers.push_back(worker);
+
+    worker->context = avcodec_alloc_context3(codec);
+    if (!worker->context) {
+      ret = AVERROR(ENOMEM);
+      break;
+    }
+
+    ret = avcodec_parameters_to_context(worker->context, par);
+    if (ret < 0) {
+      break;
+    }
+
+    // Parallelism comes from the pool, each instance stays single-threaded
+    worker->context->thread_count = 1;
+    worker->context->pkt_timebase = pkt_timebase;
+
+    AVDictionary* opts = nullptr;
+    if (options) {
+      av_dict_copy(&opts, options, 0);
+    }
+    ret = avcodec_open2(worker->context, codec, opts ? &opts : nullptr);
+    av_dict_free(&opts);
+    if (ret < 0) {
+      break;
+    }
+  }
+
+  if (ret < 0) {
+    for (Worker* worker : workers) {
+      avcodec_free_context(&worker->context);
+      delete worker;
+    }
+    return ret;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    workers_ = workers;
+    next_send_seq_ = 0;
+    next_recv_seq_ = 0;
+    max_in_flight_ = count * 2;
+    eof_ = false;
+    stopping_ = false;
+    is_open_ = true;
+  }
+
+  for (Worker* worker : workers_) {
+    worker->thread = std::thread(&ParallelDecoder::WorkerLoop, this, worker);
+  }
+
+  return 0;
+}
+
+int ParallelDecoder::SendPacketInternal(const AVPacket* packet) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!is_open_ || stopping_) {
+    return AVERROR(EINVAL);
+  }
+
+  if (eof_) {
+    return AVERROR_EOF;
+  }
+
+  // Flush request - intra-only decoders hold no delayed frames
+  if (!packet) {
+    eof_ = true;
+    result_cv_.notify_all();
+    return 0;
+  }
+
+  if (next_send_seq_ - next_recv_seq_ >= static_cast<uint64_t>(max_in_flight_)) {
+    return AVERROR(EAGAIN);
+  }
+
+  AVPacket* copy = av_packet_clone(packet);
+  if (!copy) {
+    return AVERROR(ENOMEM);
+  }
+
+  uint64_t seq = next_send_seq_++;
+  workers_[seq % workers_.size()]->jobs.push_back({ seq, copy });
+  job_cv_.notify_all();
+
+  return 0;
+}
+
+int ParallelDecoder::ReceiveFrameInternal(AVFrame* frame, bool wait) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (true) {
+    if (!is_open_ || stopping_) {
+      return AVERROR_EXIT;
+    }
+
+    auto it = results_.find(next_recv_seq_);
+    if (it != results_.end()) {
+      Slot slot = it->second;
+      results_.erase(it);
+      next_recv_seq_++;
+
+      if (slot.ret == AVERROR(EAGAIN)) {
+        // Packet produced no picture, move on to the next one
+        continue;
+      }
+
+      if (slot.ret < 0) {
+        return slot.ret;
+      }
+
+      av_frame_unref(frame);
+      av_frame_move_ref(frame, slot.frame);
+      av_frame_free(&slot.frame);
+      return 0;
+    }
+
+    if (next_recv_seq_ == next_send_seq_) {
+      return eof_ ? AVERROR_EOF : AVERROR(EAGAIN);
+    }
+
+    if (!wait && !eof_) {
+      return AVERROR(EAGAIN);
+    }
+
+    result_cv_.wait(lock);
+  }
+}
+
+void ParallelDecoder::WorkerLoop(Worker* worker) {
+  while (true) {
+    Job job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [&] { return stopping_ || !worker->jobs.empty(); });
+      if (stopping_) {
+        return;
+      }
+      job = worker->jobs.front();
+      worker->jobs.pop_front();
+    }
+
+    AVFrame* frame = av_frame_alloc();
+    int ret = frame ? avcodec_send_packet(worker->context, job.packet) : AVERROR(ENOMEM);
+    if (ret >= 0) {
+      ret = avcodec_receive_frame(worker->context, frame);
+    }
+    av_packet_free(&job.packet);
+
+    if (ret < 0) {
+      av_frame_free(&frame);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      results_[job.seq] = { frame, ret };
+    }
+    result_cv_.notify_all();
+  }
+}
+
+void ParallelDecoder::CloseInternal() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  job_cv_.notify_all();
+  result_cv_.notify_all();
+
+  for (Worker* worker : workers_) {
+    if (worker->thread.joinable()) {
+      worker->thread.join();
+    }
+    for (Job& job : worker->jobs) {
+      av_packet_free(&job.packet);
+    }
+    avcodec_free_context(&worker->context);
+    delete worker;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  workers_.clear();
+  for (auto& entry : results_) {
+    av_frame_free(&entry.second.frame);
+  }
+  results_.clear();
+  next_send_seq_ = 0;
+  next_recv_seq_ = 0;
+  eof_ = false;
+  is_open_ = false;
+}
+
+// === Static ===
+
+Napi::Value ParallelDecoder::IsSupported(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected codec ID").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  AVCodecID id = static_cast<AVCodecID>(info[0].As<Napi::Number>().Int32Value());
+  const AVCodecDescriptor* desc = avcodec_descriptor_get(id);
+  bool supported = desc && (desc->props & AV_CODEC_PROP_INTRA_ONLY) && avcodec_find_decoder(id);
+
+  return Napi::Boolean::New(env, supported);
+}
+
+// === Lifecycle ===
+
+Napi::Value ParallelDecoder::Close(const Napi::CallbackInfo& info) {
+  CloseInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value ParallelDecoder::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+// === Properties ===
+
+Napi::Value ParallelDecoder::GetWorkers(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(workers_.size()));
+}
+
+Napi::Value ParallelDecoder::GetPending(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(info.Env(), static_cast<double>(next_send_seq_ - next_recv_seq_));
+}
+
+Napi::Value ParallelDecoder::GetIsOpen(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Boolean::New(info.Env(), is_open_);
+}
+
+} // namespace ffmpeg
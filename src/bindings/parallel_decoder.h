@@ -0,0 +1,104 @@
+#ifndef FFMPEG_PARALLEL_DECODER_H
+#define FFMPEG_PARALLEL_DECODER_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/dict.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Decodes intra-only streams on a pool of independent codec contexts.
+ *
+ * Every packet of an intra-only codec (MJPEG, ProRes, DNxHD, PNG, ...) is a
+ * self-contained picture, so packets can be spread over N single-threaded
+ * decoder instances. Each instance runs on its own worker thread; decoded
+ * frames are collected in a reorder map and handed out strictly in the order
+ * the packets were submitted.
+ */
+class ParallelDecoder : public Napi::ObjectWrap<ParallelDecoder> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  ParallelDecoder(const Napi::CallbackInfo& info);
+  ~ParallelDecoder();
+
+private:
+  friend class PDOpenWorker;
+  friend class PDSendPacketWorker;
+  friend class PDReceiveFrameWorker;
+
+  static Napi::FunctionReference constructor;
+
+  struct Job {
+    uint64_t seq;
+    AVPacket* packet;
+  };
+
+  struct Slot {
+    AVFrame* frame;
+    int ret;
+  };
+
+  struct Worker {
+    AVCodecContext* context = nullptr;
+    std::deque<Job> jobs;
+    std::thread thread;
+  };
+
+  std::vector<Worker*> workers_;
+  std::map<uint64_t, Slot> results_;
+
+  std::mutex mutex_;
+  std::condition_variable job_cv_;
+  std::condition_variable result_cv_;
+
+  uint64_t next_send_seq_ = 0;
+  uint64_t next_recv_seq_ = 0;
+  int max_in_flight_ = 0;
+  bool eof_ = false;
+  bool stopping_ = false;
+  bool is_open_ = false;
+
+  int OpenInternal(const AVCodecParameters* par, AVRational pkt_timebase,
+                   int count, const AVDictionary* options);
+  int SendPacketInternal(const AVPacket* packet);
+  int ReceiveFrameInternal(AVFrame* frame, bool wait);
+  void WorkerLoop(Worker* worker);
+  void CloseInternal();
+
+  // Static
+  static Napi::Value IsSupported(const Napi::CallbackInfo& info);
+
+  // Lifecycle
+  Napi::Value OpenAsync(const Napi::CallbackInfo& info);
+  Napi::Value OpenSync(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Decoding
+  Napi::Value SendPacketAsync(const Napi::CallbackInfo& info);
+  Napi::Value SendPacketSync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveFrameSync(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetWorkers(const Napi::CallbackInfo& info);
+  Napi::Value GetPending(const Napi::CallbackInfo& info);
+  Napi::Value GetIsOpen(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_PARALLEL_DECODER_H
@@ -0,0 +1,225 @@
+#include "parallel_decoder.h"
+#include "codec_parameters.h"
+#include "dictionary.h"
+#include "packet.h"
+#include "frame.h"
+#include <napi.h>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/dict.h>
+}
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class PDOpenWorker : public Napi::AsyncWorker {
+public:
+  PDOpenWorker(Napi::Env env, ParallelDecoder* decoder, const AVCodecParameters* par,
+               AVRational pkt_timebase, int count, const AVDictionary* options)
+    : Napi::AsyncWorker(env),
+      decoder_(decoder),
+      par_(avcodec_parameters_alloc()),
+      pkt_timebase_(pkt_timebase),
+      count_(count),
+      options_(nullptr),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {
+    // Copy inputs so the JS objects may be released while the worker runs
+    if (par_) {
+      avcodec_parameters_copy(par_, par);
+    }
+    if (options) {
+      av_dict_copy(&options_, options, 0);
+    }
+  }
+
+  ~PDOpenWorker() {
+    avcodec_parameters_free(&par_);
+    av_dict_free(&options_);
+  }
+
+  void Execute() override {
+    if (!par_) {
+      ret_ = AVERROR(ENOMEM);
+      return;
+    }
+    ret_ = decoder_->OpenInternal(par_, pkt_timebase_, count_, options_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ParallelDecoder* decoder_;
+  AVCodecParameters* par_;
+  AVRational pkt_timebase_;
+  int count_;
+  AVDictionary* options_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class PDSendPacketWorker : public Napi::AsyncWorker {
+public:
+  PDSendPacketWorker(Napi::Env env, ParallelDecoder* decoder, Packet* packet)
+    : Napi::AsyncWorker(env),
+      decoder_(decoder),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = decoder_->SendPacketInternal(packet_ ? packet_->Get() : nullptr);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ParallelDecoder* decoder_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class PDReceiveFrameWorker : public Napi::AsyncWorker {
+public:
+  PDReceiveFrameWorker(Napi::Env env, ParallelDecoder* decoder, Frame* frame, bool wait)
+    : Napi::AsyncWorker(env),
+      decoder_(decoder),
+      frame_(frame),
+      wait_(wait),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = decoder_->ReceiveFrameInternal(frame_->Get(), wait_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  ParallelDecoder* decoder_;
+  Frame* frame_;
+  bool wait_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value ParallelDecoder::OpenAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (codecpar, count)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[0], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid CodecParameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int count = info[1].As<Napi::Number>().Int32Value();
+
+  const AVDictionary* options = nullptr;
+  if (info.Length() > 2 && !info[2].IsNull() && !info[2].IsUndefined()) {
+    Dictionary* dict = UnwrapNativeObject<Dictionary>(env, info[2], "Dictionary");
+    if (dict) {
+      options = dict->Get();
+    }
+  }
+
+  AVRational pkt_timebase = { 0, 1 };
+  if (info.Length() > 3 && info[3].IsObject()) {
+    pkt_timebase = JSToRational(info[3].As<Napi::Object>());
+  }
+
+  auto* worker = new PDOpenWorker(env, this, par->Get(), pkt_timebase, count, options);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ParallelDecoder::SendPacketAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = nullptr;
+
+  // Parse packet argument - can be null for flush
+  if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
+    packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+    if (!packet) {
+      Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  auto* worker = new PDSendPacketWorker(env, this, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ParallelDecoder::ReceiveFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  bool wait = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+
+  auto* worker = new PDReceiveFrameWorker(env, this, frame, wait);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,81 @@
+#include "parallel_decoder.h"
+#include "codec_parameters.h"
+#include "dictionary.h"
+#include "packet.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value ParallelDecoder::OpenSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2) {
+    Napi::TypeError::New(env, "Expected 2 arguments (codecpar, count)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[0], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid CodecParameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  int count = info[1].As<Napi::Number>().Int32Value();
+
+  const AVDictionary* options = nullptr;
+  if (info.Length() > 2 && !info[2].IsNull() && !info[2].IsUndefined()) {
+    Dictionary* dict = UnwrapNativeObject<Dictionary>(env, info[2], "Dictionary");
+    if (dict) {
+      options = dict->Get();
+    }
+  }
+
+  AVRational pkt_timebase = { 0, 1 };
+  if (info.Length() > 3 && info[3].IsObject()) {
+    pkt_timebase = JSToRational(info[3].As<Napi::Object>());
+  }
+
+  int ret = OpenInternal(par->Get(), pkt_timebase, count, options);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value ParallelDecoder::SendPacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Packet* packet = nullptr;
+
+  // Parse packet argument - can be null for flush
+  if (info.Length() > 0 && !info[0].IsNull() && !info[0].IsUndefined()) {
+    packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+    if (!packet) {
+      Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  int ret = SendPacketInternal(packet ? packet->Get() : nullptr);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value ParallelDecoder::ReceiveFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  bool wait = info.Length() > 1 && info[1].IsBoolean() && info[1].As<Napi::Boolean>().Value();
+
+  int ret = ReceiveFrameInternal(frame->Get(), wait);
+  return Napi::Number::New(env, ret);
+}
+
+} // namespace ffmpeg
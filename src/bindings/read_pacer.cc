@@ -0,0 +1,106 @@
+#include "read_pacer.h"
+
+#include <algorithm>
+
+namespace ffmpeg {
+
+ReadPacer::ReadPacer(const ReadRateOptions& options)
+  : options_(options), epoch_(Clock::now()) {
+  burst_ = options_.initial_burst;
+}
+
+int64_t ReadPacer::Now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - epoch_).count();
+}
+
+int ReadPacer::Wait(const AVFormatContext* ctx, const AVPacket* pkt) {
+  int64_t ts = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : pkt->pts;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (interrupted_) {
+    return AVERROR_EXIT;
+  }
+
+  stats_.packets++;
+  if (ts == AV_NOPTS_VALUE || pkt->stream_index < 0 || static_cast<unsigned int>(pkt->stream_index) >= ctx->nb_streams) {
+    // Nothing to schedule by, release with the previous packet
+    return 0;
+  }
+
+  int64_t media = av_rescale_q(ts, ctx->streams[pkt->stream_index]->time_base, AV_TIME_BASE_Q);
+  int64_t now = Now();
+
+  if (!anchored_) {
+    anchored_ = true;
+    origin_ts_ = media;
+    origin_wall_ = now;
+    last_ts_ = media;
+    last_wall_ = now;
+  }
+
+  // Packets before the origin (other streams starting earlier) are due right away
+  int64_t offset = std::max<int64_t>(media - origin_ts_ - burst_, 0);
+  int64_t due = origin_wall_ + static_cast<int64_t>(offset / options_.rate);
+  // Packets inside the initial burst are never late
+  int64_t lateness = offset > 0 ? std::max<int64_t>(now - due, 0) : 0;
+
+  if (options_.catchup == ReadRateCatchup::kReset && lateness > options_.max_lag) {
+    // Live semantics: a stall shifts the schedule instead of being made up
+    origin_ts_ = media;
+    origin_wall_ = now;
+    burst_ = 0;
+    due = now;
+    stats_.resets++;
+  } else if (options_.catchup == ReadRateCatchup::kRate && offset > 0 && media > last_ts_) {
+    // Behind schedule: space packets by their media distance at the catch-up rate
+    due = std::max(due, last_wall_ + static_cast<int64_t>((media - last_ts_) / options_.catchup_rate));
+  }
+
+  if (lateness > 0) {
+    stats_.late_packets++;
+    stats_.total_lateness += lateness;
+    stats_.max_lateness = std::max(stats_.max_lateness, lateness);
+  }
+  stats_.lag = lateness;
+
+  if (due > now) {
+    stats_.waits++;
+    bool interrupted = cond_.wait_until(lock, epoch_ + std::chrono::microseconds(due), [this] { return interrupted_; });
+    int64_t after = Now();
+    stats_.wait_time += after - now;
+    now = after;
+    if (interrupted) {
+      return AVERROR_EXIT;
+    }
+  }
+
+  if (media > last_ts_) {
+    last_ts_ = media;
+  }
+  last_wall_ = now;
+  return 0;
+}
+
+void ReadPacer::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  anchored_ = false;
+  burst_ = options_.initial_burst;
+}
+
+void ReadPacer::Interrupt() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  interrupted_ = true;
+  cond_.notify_all();
+}
+
+void ReadPacer::Resume() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  interrupted_ = false;
+}
+
+ReadRateStats ReadPacer::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,93 @@
+#ifndef FFMPEG_READ_PACER_H
+#define FFMPEG_READ_PACER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+namespace ffmpeg {
+
+enum class ReadRateCatchup {
+  kBurst,                         // Release late packets immediately until back on schedule
+  kRate,                          // Catch up no faster than catchup_rate
+  kReset,                         // Drop the lag: re-anchor the schedule at the late packet
+};
+
+struct ReadRateOptions {
+  double rate = 1.0;              // Media seconds released per wall-clock second
+  int64_t initial_burst = 0;      // Media time released immediately (us)
+  ReadRateCatchup catchup = ReadRateCatchup::kBurst;
+  double catchup_rate = 1.05;     // Release rate while behind (kRate)
+  int64_t max_lag = 500000;       // Lag that triggers a re-anchor (kReset, us)
+};
+
+struct ReadRateStats {
+  uint64_t packets = 0;           // Packets released
+  uint64_t waits = 0;             // Packets held back until their release time
+  uint64_t late_packets = 0;      // Packets read after their release time
+  uint64_t resets = 0;            // Schedule re-anchors
+  int64_t wait_time = 0;          // Total time spent waiting (us)
+  int64_t max_lateness = 0;       // Largest lateness seen (us)
+  int64_t total_lateness = 0;     // Sum of lateness over late packets (us)
+  int64_t lag = 0;                // Lateness of the last packet (us)
+};
+
+/**
+ * Releases demuxed packets at their native rate (ffmpeg -re).
+ *
+ * Each packet's dts (pts when unset) is mapped to a release time on a
+ * monotonic clock anchored at the first packet. Release times are always
+ * computed from the anchor, never from the previous packet, so sleep
+ * overshoot does not accumulate into drift.
+ *
+ * Wait() runs on whichever thread reads the packet; Interrupt() and
+ * GetStats() may be called from any thread.
+ */
+class ReadPacer {
+public:
+  explicit ReadPacer(const ReadRateOptions& options);
+
+  // Blocks until pkt is due, returns AVERROR_EXIT if interrupted
+  int Wait(const AVFormatContext* ctx, const AVPacket* pkt);
+  // Forget the anchor, e.g. after a seek
+  void Reset();
+  void Interrupt();
+  // Clear an Interrupt() once the interrupted reader has returned
+  void Resume();
+
+  ReadRateStats GetStats();
+  const ReadRateOptions& options() const { return options_; }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  int64_t Now() const;
+
+  ReadRateOptions options_;
+  Clock::time_point epoch_;
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool interrupted_ = false;
+
+  // Schedule anchor: media time origin_ts_ is due at wall time origin_wall_
+  bool anchored_ = false;
+  int64_t origin_ts_ = 0;
+  int64_t origin_wall_ = 0;
+  int64_t burst_ = 0;             // Initial burst, dropped on re-anchor
+
+  // Last released packet, for kRate
+  int64_t last_ts_ = 0;
+  int64_t last_wall_ = 0;
+
+  ReadRateStats stats_;
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_READ_PACER_H
@@ -0,0 +1,379 @@
+#include "scene_analyzer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+
+extern "C" {
+#include <libavutil/mem.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+// Consecutive frames with the same luma trend before reporting a fade
+constexpr int kFadeFrames = 3;
+
+const char* ReasonName(KeyframeReason reason) {
+  switch (reason) {
+    case KeyframeReason::kStart: return "start";
+    case KeyframeReason::kSegment: return "segment";
+    case KeyframeReason::kScene: return "scene";
+    case KeyframeReason::kInterval: return "interval";
+    default: return nullptr;
+  }
+}
+
+void SetMetadata(AVFrame* frame, const char* key, double value) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.6f", value);
+  av_dict_set(&frame->metadata, key, buf, 0);
+}
+
+} // namespace
+
+Napi::FunctionReference SceneAnalyzer::constructor;
+
+Napi::Object SceneAnalyzer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "SceneAnalyzer", {
+    InstanceMethod<&SceneAnalyzer::Alloc>("alloc"),
+    InstanceMethod<&SceneAnalyzer::Free>("free"),
+    InstanceMethod<&SceneAnalyzer::AnalyzeAsync>("analyze"),
+    InstanceMethod<&SceneAnalyzer::AnalyzeSync>("analyzeSync"),
+    InstanceMethod<&SceneAnalyzer::Reset>("reset"),
+    InstanceMethod<&SceneAnalyzer::GetLastResult>("getLastResult"),
+    InstanceMethod<&SceneAnalyzer::GetStats>("getStats"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &SceneAnalyzer::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SceneAnalyzer", func);
+  return exports;
+}
+
+SceneAnalyzer::SceneAnalyzer(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<SceneAnalyzer>(info) {
+  // Constructor does nothing - user must explicitly call alloc()
+}
+
+SceneAnalyzer::~SceneAnalyzer() {
+  // Manual cleanup if not already done
+  FreeInternal();
+}
+
+// === Analysis ===
+
+int SceneAnalyzer::Downscale(const AVFrame* frame) {
+  if (frame->width != source_width_ || frame->height != source_height_) {
+    // Keep the aspect ratio, even sizes for the scaler
+    int width = std::max(2, std::min(analysis_width_, frame->width) & ~1);
+    int height = std::max(2, static_cast<int>(lrint(static_cast<double>(frame->height) * width / frame->width)) & ~1);
+    int stride = FFALIGN(width, 32);
+
+    av_freep(&luma_[0]);
+    av_freep(&luma_[1]);
+    luma_[0] = static_cast<uint8_t*>(av_malloc(static_cast<size_t>(stride) * height));
+    luma_[1] = static_cast<uint8_t*>(av_malloc(static_cast<size_t>(stride) * height));
+    if (!luma_[0] || !luma_[1]) {
+      av_freep(&luma_[0]);
+      av_freep(&luma_[1]);
+      source_width_ = source_height_ = 0;
+      return AVERROR(ENOMEM);
+    }
+
+    width_ = width;
+    height_ = height;
+    stride_ = stride;
+    source_width_ = frame->width;
+    source_height_ = frame->height;
+    has_previous_ = false;
+  }
+
+  sws_ = sws_getCachedContext(sws_, frame->width, frame->height, static_cast<AVPixelFormat>(frame->format),
+                              width_, height_, AV_PIX_FMT_GRAY8, SWS_AREA, nullptr, nullptr, nullptr);
+  if (!sws_) {
+    return AVERROR(EINVAL);
+  }
+
+  uint8_t* dst[4] = { luma_[0], nullptr, nullptr, nullptr };
+  int dst_linesize[4] = { stride_, 0, 0, 0 };
+  int ret = sws_scale(sws_, frame->data, frame->linesize, 0, frame->height, dst, dst_linesize);
+  return ret < 0 ? ret : 0;
+}
+
+KeyframeReason SceneAnalyzer::DecideLocked(const AVFrame* frame, double score) {
+  AVRational tb = frame->time_base.num > 0 && frame->time_base.den > 0 ? frame->time_base : time_base_;
+  bool timed = frame->pts != AV_NOPTS_VALUE && tb.num > 0 && tb.den > 0;
+  double t = timed ? frame->pts * av_q2d(tb) : 0;
+
+  // Tolerate timestamps rounded just below a boundary
+  bool boundary = segment_duration_ > 0 && timed && t + 1e-6 >= next_boundary_;
+  if (boundary) {
+    next_boundary_ = (std::floor((t + 1e-6) / segment_duration_) + 1) * segment_duration_;
+  }
+
+  KeyframeReason reason = KeyframeReason::kNone;
+  if (since_key_ < 0) {
+    reason = KeyframeReason::kStart;
+  } else {
+    since_key_++;
+    if (boundary) {
+      reason = KeyframeReason::kSegment;
+    } else if (score >= scene_threshold_ && since_key_ >= min_interval_) {
+      reason = KeyframeReason::kScene;
+    } else if (max_interval_ > 0 && since_key_ >= max_interval_) {
+      reason = KeyframeReason::kInterval;
+    }
+  }
+
+  if (reason != KeyframeReason::kNone) {
+    since_key_ = 0;
+  }
+  return reason;
+}
+
+int SceneAnalyzer::AnalyzeLocked(AVFrame* frame) {
+  if (!configured_) {
+    return AVERROR(EINVAL);
+  }
+  if (frame->hw_frames_ctx || frame->width <= 0 || frame->height <= 0) {
+    // Hardware frames must be transferred to system memory first
+    return AVERROR(EINVAL);
+  }
+
+  int ret = Downscale(frame);
+  if (ret < 0) {
+    return ret;
+  }
+
+  const uint8_t* cur = luma_[0];
+  const uint8_t* prev = luma_[1];
+  const double pixels = static_cast<double>(width_) * height_;
+
+  // Spatial complexity: mean horizontal and vertical luma gradient
+  int64_t sum = 0;
+  int64_t gradient = 0;
+  for (int y = 0; y < height_; y++) {
+    const uint8_t* row = cur + static_cast<size_t>(y) * stride_;
+    const uint8_t* above = y > 0 ? row - stride_ : nullptr;
+    for (int x = 0; x < width_; x++) {
+      sum += row[x];
+      if (x > 0) gradient += std::abs(row[x] - row[x - 1]);
+      if (above) gradient += std::abs(row[x] - above[x]);
+    }
+  }
+
+  SceneAnalysis result;
+  double mean = sum / pixels;
+  result.complexity = gradient / (2.0 * pixels * 255.0);
+
+  if (has_previous_) {
+    // Remove the mean luma change so fades do not score as cuts
+    double delta = mean - previous_mean_;
+    double raw = 0;
+    double compensated = 0;
+    for (int y = 0; y < height_; y++) {
+      const uint8_t* a = cur + static_cast<size_t>(y) * stride_;
+      const uint8_t* b = prev + static_cast<size_t>(y) * stride_;
+      for (int x = 0; x < width_; x++) {
+        double d = static_cast<double>(a[x]) - b[x];
+        raw += std::fabs(d);
+        compensated += std::fabs(d - delta);
+      }
+    }
+
+    // Same scale as the select filter: min(mafd, |mafd - previous mafd|) / 100
+    double mafd = compensated / pixels;
+    result.score = std::clamp(std::min(mafd, std::fabs(mafd - previous_mafd_)) / 100.0, 0.0, 1.0);
+    result.motion = raw / (pixels * 255.0);
+    previous_mafd_ = mafd;
+
+    if (std::fabs(delta) >= fade_threshold_ && result.score < scene_threshold_) {
+      int direction = delta > 0 ? 1 : -1;
+      fade_run_ = fade_run_ * direction > 0 ? fade_run_ + direction : direction;
+    } else {
+      fade_run_ = 0;
+    }
+    if (std::abs(fade_run_) >= kFadeFrames) {
+      result.fade = fade_run_ > 0 ? 1 : -1;
+    }
+  }
+
+  previous_mean_ = mean;
+  has_previous_ = true;
+  std::swap(luma_[0], luma_[1]);
+
+  result.reason = DecideLocked(frame, result.score);
+  result.pts = frame->pts;
+
+  // Only the analyzer decides: decoded source picture types must not force keyframes
+  if (result.reason != KeyframeReason::kNone) {
+    frame->pict_type = AV_PICTURE_TYPE_I;
+    frame->flags |= AV_FRAME_FLAG_KEY;
+  } else {
+    frame->pict_type = AV_PICTURE_TYPE_NONE;
+    frame->flags &= ~AV_FRAME_FLAG_KEY;
+  }
+
+  SetMetadata(frame, "lavfi.scene_score", result.score);
+  SetMetadata(frame, "scene.complexity", result.complexity);
+  SetMetadata(frame, "scene.motion", result.motion);
+  av_dict_set(&frame->metadata, "scene.fade", result.fade > 0 ? "in" : result.fade < 0 ? "out" : nullptr, 0);
+  av_dict_set(&frame->metadata, "scene.keyframe", ReasonName(result.reason), 0);
+
+  last_ = result;
+  stats_.frames++;
+  if (result.fade != 0) stats_.fade_frames++;
+  switch (result.reason) {
+    case KeyframeReason::kScene: stats_.scene_cuts++; break;
+    case KeyframeReason::kSegment: stats_.segment_keyframes++; break;
+    case KeyframeReason::kInterval: stats_.interval_keyframes++; break;
+    default: break;
+  }
+  if (result.reason != KeyframeReason::kNone) {
+    stats_.keyframes++;
+    return 1;
+  }
+  return 0;
+}
+
+void SceneAnalyzer::ResetLocked() {
+  has_previous_ = false;
+  previous_mean_ = 0;
+  previous_mafd_ = 0;
+  fade_run_ = 0;
+  since_key_ = -1;
+  next_boundary_ = 0;
+  last_ = SceneAnalysis();
+}
+
+void SceneAnalyzer::FreeInternal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sws_freeContext(sws_);
+  sws_ = nullptr;
+  av_freep(&luma_[0]);
+  av_freep(&luma_[1]);
+  width_ = height_ = stride_ = 0;
+  source_width_ = source_height_ = 0;
+  configured_ = false;
+  stats_ = SceneAnalyzerStats();
+  ResetLocked();
+}
+
+// === JS Methods ===
+
+Napi::Value SceneAnalyzer::Alloc(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int width = 160;
+  double scene_threshold = 0.4;
+  int64_t min_interval = 8;
+  int64_t max_interval = 250;
+  double segment_duration = 0;
+  double fade_threshold = 1.0;
+  AVRational time_base = { 0, 1 };
+
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+
+    if (options.Has("width") && options.Get("width").IsNumber()) {
+      width = options.Get("width").As<Napi::Number>().Int32Value();
+    }
+    if (options.Has("sceneThreshold") && options.Get("sceneThreshold").IsNumber()) {
+      scene_threshold = options.Get("sceneThreshold").As<Napi::Number>().DoubleValue();
+    }
+    if (options.Has("minKeyInterval") && options.Get("minKeyInterval").IsNumber()) {
+      min_interval = options.Get("minKeyInterval").As<Napi::Number>().Int64Value();
+    }
+    if (options.Has("maxKeyInterval") && options.Get("maxKeyInterval").IsNumber()) {
+      max_interval = options.Get("maxKeyInterval").As<Napi::Number>().Int64Value();
+    }
+    if (options.Has("segmentDuration") && options.Get("segmentDuration").IsNumber()) {
+      segment_duration = options.Get("segmentDuration").As<Napi::Number>().DoubleValue();
+    }
+    if (options.Has("fadeThreshold") && options.Get("fadeThreshold").IsNumber()) {
+      fade_threshold = options.Get("fadeThreshold").As<Napi::Number>().DoubleValue();
+    }
+    if (options.Has("timeBase") && options.Get("timeBase").IsObject()) {
+      time_base = JSToRational(options.Get("timeBase").As<Napi::Object>());
+    }
+  }
+
+  if (width < 8 || scene_threshold <= 0 || scene_threshold > 1 || min_interval < 0 || max_interval < 0 ||
+      segment_duration < 0 || fade_threshold <= 0) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  FreeInternal();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  analysis_width_ = width;
+  scene_threshold_ = scene_threshold;
+  min_interval_ = min_interval;
+  max_interval_ = max_interval;
+  segment_duration_ = segment_duration;
+  fade_threshold_ = fade_threshold;
+  time_base_ = time_base;
+  configured_ = true;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value SceneAnalyzer::Free(const Napi::CallbackInfo& info) {
+  FreeInternal();
+  return info.Env().Undefined();
+}
+
+Napi::Value SceneAnalyzer::Reset(const Napi::CallbackInfo& info) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ResetLocked();
+  return info.Env().Undefined();
+}
+
+Napi::Value SceneAnalyzer::GetLastResult(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (stats_.frames == 0) {
+    return env.Null();
+  }
+
+  const char* reason = ReasonName(last_.reason);
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("pts", Napi::BigInt::New(env, last_.pts));
+  result.Set("score", Napi::Number::New(env, last_.score));
+  result.Set("complexity", Napi::Number::New(env, last_.complexity));
+  result.Set("motion", Napi::Number::New(env, last_.motion));
+  Napi::Value fade = env.Null();
+  if (last_.fade != 0) {
+    fade = Napi::String::New(env, last_.fade > 0 ? "in" : "out");
+  }
+  result.Set("fade", fade);
+  result.Set("keyframe", Napi::Boolean::New(env, reason != nullptr));
+  result.Set("reason", reason ? Napi::Value(Napi::String::New(env, reason)) : env.Null());
+  return result;
+}
+
+Napi::Value SceneAnalyzer::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Napi::Object stats = Napi::Object::New(env);
+  stats.Set("frames", Napi::Number::New(env, static_cast<double>(stats_.frames)));
+  stats.Set("keyframes", Napi::Number::New(env, static_cast<double>(stats_.keyframes)));
+  stats.Set("sceneCuts", Napi::Number::New(env, static_cast<double>(stats_.scene_cuts)));
+  stats.Set("segmentKeyframes", Napi::Number::New(env, static_cast<double>(stats_.segment_keyframes)));
+  stats.Set("intervalKeyframes", Napi::Number::New(env, static_cast<double>(stats_.interval_keyframes)));
+  stats.Set("fadeFrames", Napi::Number::New(env, static_cast<double>(stats_.fade_frames)));
+  return stats;
+}
+
+Napi::Value SceneAnalyzer::Dispose(const Napi::CallbackInfo& info) {
+  return Free(info);
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,114 @@
+#ifndef FFMPEG_SCENE_ANALYZER_H
+#define FFMPEG_SCENE_ANALYZER_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <cstdint>
+#include <mutex>
+
+extern "C" {
+#include <libavutil/frame.h>
+#include <libswscale/swscale.h>
+}
+
+namespace ffmpeg {
+
+enum class KeyframeReason {
+  kNone,
+  kStart,                         // First frame
+  kSegment,                       // Segment boundary
+  kScene,                         // Scene change
+  kInterval,                      // Maximum keyframe interval reached
+};
+
+struct SceneAnalyzerStats {
+  uint64_t frames = 0;            // Analyzed frames
+  uint64_t keyframes = 0;         // Frames marked as keyframes (all reasons)
+  uint64_t scene_cuts = 0;        // Keyframes placed on scene changes
+  uint64_t segment_keyframes = 0; // Keyframes placed on segment boundaries
+  uint64_t interval_keyframes = 0;// Keyframes forced by the maximum interval
+  uint64_t fade_frames = 0;       // Frames inside a fade
+};
+
+struct SceneAnalysis {
+  double score = 0;               // Scene change score 0..1 (same scale as select's scene)
+  double complexity = 0;          // Spatial complexity 0..1 (mean luma gradient)
+  double motion = 0;              // Temporal complexity 0..1 (mean luma difference)
+  int fade = 0;                   // 1 fade in, -1 fade out, 0 none
+  KeyframeReason reason = KeyframeReason::kNone;
+  int64_t pts = AV_NOPTS_VALUE;
+};
+
+/**
+ * Shared keyframe decisions for all renditions of an ABR ladder.
+ *
+ * Analyzes each source frame once on a small grayscale copy: scene-change
+ * score (mean-compensated, so fades do not look like cuts), spatial and
+ * temporal complexity and fades. Frames starting a scene, a segment or a
+ * maximum-length GOP get pict_type I and the key flag, all others get
+ * AV_PICTURE_TYPE_NONE so decoded source types never force keyframes.
+ * Results are added to the frame metadata (lavfi.scene_score, scene.*).
+ *
+ * Frames then fan out to every rendition; scaling keeps pict_type and
+ * metadata, so encoders with their own scene detection disabled produce
+ * keyframes (and segments) aligned by construction.
+ */
+class SceneAnalyzer : public Napi::ObjectWrap<SceneAnalyzer> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  SceneAnalyzer(const Napi::CallbackInfo& info);
+  ~SceneAnalyzer();
+
+private:
+  friend class SAAnalyzeWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Options
+  bool configured_ = false;
+  int analysis_width_ = 160;
+  double scene_threshold_ = 0.4;
+  int64_t min_interval_ = 8;
+  int64_t max_interval_ = 250;
+  double segment_duration_ = 0;
+  double fade_threshold_ = 1.0;
+  AVRational time_base_ = { 0, 1 };
+
+  // Analysis state (guarded by mutex_)
+  SwsContext* sws_ = nullptr;
+  int width_ = 0;                 // Analysis size
+  int height_ = 0;
+  int stride_ = 0;
+  int source_width_ = 0;
+  int source_height_ = 0;
+  uint8_t* luma_[2] = { nullptr, nullptr };
+  bool has_previous_ = false;
+  double previous_mean_ = 0;
+  double previous_mafd_ = 0;
+  int fade_run_ = 0;              // Consecutive frames with a luma trend (signed)
+  int64_t since_key_ = -1;        // Frames since the last keyframe, -1 before the first
+  double next_boundary_ = 0;      // Next segment boundary in seconds
+  SceneAnalysis last_;
+  SceneAnalyzerStats stats_;
+  std::mutex mutex_;
+
+  int AnalyzeLocked(AVFrame* frame);
+  int Downscale(const AVFrame* frame);
+  KeyframeReason DecideLocked(const AVFrame* frame, double score);
+  void ResetLocked();
+  void FreeInternal();
+
+  Napi::Value Alloc(const Napi::CallbackInfo& info);
+  Napi::Value Free(const Napi::CallbackInfo& info);
+  Napi::Value AnalyzeAsync(const Napi::CallbackInfo& info);
+  Napi::Value AnalyzeSync(const Napi::CallbackInfo& info);
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  Napi::Value GetLastResult(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_SCENE_ANALYZER_H
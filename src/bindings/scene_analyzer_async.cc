@@ -0,0 +1,64 @@
+#include "scene_analyzer.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class SAAnalyzeWorker : public Napi::AsyncWorker {
+public:
+  SAAnalyzeWorker(Napi::Env env, SceneAnalyzer* analyzer, Frame* frame)
+    : Napi::AsyncWorker(env),
+      analyzer_(analyzer),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    std::lock_guard<std::mutex> lock(analyzer_->mutex_);
+    ret_ = analyzer_->AnalyzeLocked(frame_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  SceneAnalyzer* analyzer_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value SceneAnalyzer::AnalyzeAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto* worker = new SAAnalyzeWorker(env, this, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
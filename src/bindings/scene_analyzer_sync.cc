@@ -0,0 +1,20 @@
+#include "scene_analyzer.h"
+#include "frame.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value SceneAnalyzer::AnalyzeSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  Frame* frame = info.Length() > 0 ? UnwrapNativeObject<Frame>(env, info[0], "Frame") : nullptr;
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  return Napi::Number::New(env, AnalyzeLocked(frame->Get()));
+}
+
+} // namespace ffmpeg
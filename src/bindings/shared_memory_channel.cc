@@ -0,0 +1,1386 @@
+#include "shared_memory_channel.h"
+#include "codec_parameters.h"
+#include "wire_format.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+extern "C" {
+#include <libavutil/dict.h>
+#include <libavutil/error.h>
+#include <libavutil/imgutils.h>
+#include <libavutil/pixdesc.h>
+#include <libavutil/samplefmt.h>
+#include <libavutil/time.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+constexpr char kMagic[8] = { 'N', 'A', 'V', 'S', 'H', 'M', 'Q', '1' };
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kAlign = 64;
+// Ring data starts on its own page, after the control block
+constexpr uint64_t kDataOffset = 4096;
+// Metadata space of records reserved by AllocFrame()
+constexpr uint64_t kAllocMeta = 16384;
+// Longest single wait before checking for interruption and a dead peer
+constexpr int64_t kWaitSliceUs = 20000;
+
+// Record types
+constexpr uint32_t kPad = 0;
+constexpr uint32_t kStream = 1;
+constexpr uint32_t kPacket = 2;
+constexpr uint32_t kFrame = 3;
+
+// Header::attached
+constexpr uint32_t kWriterAttached = 1;
+constexpr uint32_t kReaderAttached = 2;
+
+// Header::state
+constexpr uint32_t kEnded = 1;
+constexpr uint32_t kWriterClosed = 2;
+constexpr uint32_t kReaderClosed = 4;
+
+constexpr uint64_t Align(uint64_t size) {
+  return (size + kAlign - 1) & ~(kAlign - 1);
+}
+
+void EncodeChannelLayout(WireEncoder* e, const AVChannelLayout& layout) {
+  // Custom channel orders are sent as unspecified with the channel count
+  bool native = layout.order == AV_CHANNEL_ORDER_NATIVE;
+  e->I32(native ? layout.order : AV_CHANNEL_ORDER_UNSPEC);
+  e->I32(layout.nb_channels);
+  e->U64(native ? layout.u.mask : 0);
+}
+
+void DecodeChannelLayout(WireDecoder* d, AVChannelLayout* layout) {
+  int order = d->I32();
+  int channels = d->I32();
+  uint64_t mask = d->U64();
+  av_channel_layout_uninit(layout);
+  if (order == AV_CHANNEL_ORDER_NATIVE && mask) {
+    av_channel_layout_from_mask(layout, mask);
+  } else if (channels > 0) {
+    layout->order = AV_CHANNEL_ORDER_UNSPEC;
+    layout->nb_channels = channels;
+  }
+}
+
+} // namespace
+
+/**
+ * Control block at the start of the segment.
+ *
+ * Positions grow monotonically, the ring offset is position % capacity.
+ * Each position sits on its own cache line next to the futex word the
+ * other end waits on.
+ */
+struct SharedMemoryRing::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t data_offset;
+  uint64_t capacity;
+
+  std::atomic<uint32_t> attached;
+  std::atomic<uint32_t> state;
+  std::atomic<int64_t> writer_pid;
+  std::atomic<int64_t> reader_pid;
+
+  alignas(64) std::atomic<uint64_t> write_pos;
+  std::atomic<uint32_t> data_seq;
+  std::atomic<uint32_t> reader_waiting;
+
+  alignas(64) std::atomic<uint64_t> read_pos;
+  std::atomic<uint32_t> space_seq;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+static_assert(sizeof(SharedMemoryRing::Header) <= kDataOffset, "Control block must fit before the ring");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared positions need lock-free 64-bit atomics");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Futex words need lock-free 32-bit atomics");
+
+// Record header, followed by the metadata and the 64-byte aligned payload
+struct SharedMemoryRing::Record {
+  uint32_t type;
+  uint32_t meta_size;
+  uint64_t size;                  // Whole record, multiple of kAlign
+  uint64_t data_offset;           // Payload start relative to the record
+  uint64_t data_size;
+};
+
+// Payload geometry of a packet or frame
+struct SharedMemoryRing::Layout {
+  uint64_t size = 0;
+  std::vector<uint64_t> offsets;
+  std::vector<int> linesizes;
+};
+
+namespace {
+
+int FrameLayout(const AVFrame* frame, SharedMemoryRing::Layout* layout) {
+  *layout = SharedMemoryRing::Layout();
+
+  // Hardware frames must be downloaded first
+  if (frame->hw_frames_ctx || frame->format < 0) {
+    return AVERROR(EINVAL);
+  }
+
+  if (frame->nb_samples > 0) {
+    AVSampleFormat format = static_cast<AVSampleFormat>(frame->format);
+    int channels = frame->ch_layout.nb_channels;
+    if (channels <= 0) {
+      return AVERROR(EINVAL);
+    }
+
+    int linesize = 0;
+    int ret = av_samples_get_buffer_size(&linesize, channels, frame->nb_samples, format, static_cast<int>(kAlign));
+    if (ret < 0) {
+      return ret;
+    }
+
+    int planes = av_sample_fmt_is_planar(format) ? channels : 1;
+    for (int i = 0; i < planes; i++) {
+      layout->offsets.push_back(layout->size);
+      layout->linesizes.push_back(linesize);
+      layout->size += Align(static_cast<uint64_t>(linesize));
+    }
+    return 0;
+  }
+
+  AVPixelFormat format = static_cast<AVPixelFormat>(frame->format);
+  const AVPixFmtDescriptor* desc = av_pix_fmt_desc_get(format);
+  if (!desc || (desc->flags & AV_PIX_FMT_FLAG_HWACCEL) || frame->width <= 0 || frame->height <= 0) {
+    return AVERROR(EINVAL);
+  }
+
+  int linesizes[4];
+  int ret = av_image_fill_linesizes(linesizes, format, frame->width);
+  if (ret < 0) {
+    return ret;
+  }
+
+  ptrdiff_t aligned[4];
+  for (int i = 0; i < 4; i++) {
+    aligned[i] = static_cast<ptrdiff_t>(Align(static_cast<uint64_t>(linesizes[i])));
+  }
+
+  size_t sizes[4];
+  ret = av_image_fill_plane_sizes(sizes, format, frame->height, aligned);
+  if (ret < 0) {
+    return ret;
+  }
+
+  for (int i = 0; i < 4 && sizes[i]; i++) {
+    layout->offsets.push_back(layout->size);
+    layout->linesizes.push_back(static_cast<int>(aligned[i]));
+    layout->size += Align(sizes[i]);
+  }
+  return 0;
+}
+
+void CopyFrameData(const AVFrame* frame, const SharedMemoryRing::Layout& layout, uint8_t* payload) {
+  std::vector<uint8_t*> planes(layout.offsets.size());
+  for (size_t i = 0; i < planes.size(); i++) {
+    planes[i] = payload + layout.offsets[i];
+  }
+
+  if (frame->nb_samples > 0) {
+    av_samples_copy(planes.data(), frame->extended_data, 0, 0, frame->nb_samples, frame->ch_layout.nb_channels,
+                    static_cast<AVSampleFormat>(frame->format));
+    return;
+  }
+
+  uint8_t* dst[4] = {};
+  int dst_linesizes[4] = {};
+  for (size_t i = 0; i < planes.size() && i < 4; i++) {
+    dst[i] = planes[i];
+    dst_linesizes[i] = layout.linesizes[i];
+  }
+  av_image_copy(dst, dst_linesizes, const_cast<const uint8_t**>(frame->data), frame->linesize,
+                static_cast<AVPixelFormat>(frame->format), frame->width, frame->height);
+}
+
+// Points the planes of frame at payload
+int AttachFrameData(AVFrame* frame, const SharedMemoryRing::Layout& layout, AVBufferRef* buf) {
+  size_t planes = layout.offsets.size();
+  if (planes > AV_NUM_DATA_POINTERS) {
+    frame->extended_data = static_cast<uint8_t**>(av_calloc(planes, sizeof(uint8_t*)));
+    if (!frame->extended_data) {
+      frame->extended_data = frame->data;
+      av_buffer_unref(&buf);
+      return AVERROR(ENOMEM);
+    }
+  } else {
+    frame->extended_data = frame->data;
+  }
+
+  frame->buf[0] = buf;
+  for (size_t i = 0; i < planes; i++) {
+    frame->extended_data[i] = buf->data + layout.offsets[i];
+    if (i < AV_NUM_DATA_POINTERS) {
+      frame->data[i] = frame->extended_data[i];
+      frame->linesize[i] = layout.linesizes[i];
+    }
+  }
+  return 0;
+}
+
+void EncodeFrame(WireEncoder* e, const AVFrame* frame, int stream_index, const SharedMemoryRing::Layout& layout) {
+  e->I32(stream_index);
+  e->I32(frame->format);
+  e->I32(frame->width);
+  e->I32(frame->height);
+  e->I32(frame->nb_samples);
+  e->I32(frame->sample_rate);
+  EncodeChannelLayout(e, frame->ch_layout);
+  e->I64(frame->pts);
+  e->I64(frame->pkt_dts);
+  e->I64(frame->duration);
+  e->I64(frame->best_effort_timestamp);
+  e->Rational(frame->time_base);
+  e->Rational(frame->sample_aspect_ratio);
+  e->I32(frame->flags);
+  e->I32(frame->pict_type);
+  e->I32(frame->repeat_pict);
+  e->I32(frame->color_range);
+  e->I32(frame->color_primaries);
+  e->I32(frame->color_trc);
+  e->I32(frame->colorspace);
+  e->I32(frame->chroma_location);
+  e->U64(frame->crop_top);
+  e->U64(frame->crop_bottom);
+  e->U64(frame->crop_left);
+  e->U64(frame->crop_right);
+
+  e->U32(static_cast<uint32_t>(av_dict_count(frame->metadata)));
+  const AVDictionaryEntry* entry = nullptr;
+  while ((entry = av_dict_get(frame->metadata, "", entry, AV_DICT_IGNORE_SUFFIX))) {
+    e->Bytes(reinterpret_cast<const uint8_t*>(entry->key), strlen(entry->key));
+    e->Bytes(reinterpret_cast<const uint8_t*>(entry->value), strlen(entry->value));
+  }
+
+  e->U32(static_cast<uint32_t>(frame->nb_side_data));
+  for (int i = 0; i < frame->nb_side_data; i++) {
+    e->I32(frame->side_data[i]->type);
+    e->Bytes(frame->side_data[i]->data, frame->side_data[i]->size);
+  }
+
+  e->U32(static_cast<uint32_t>(layout.offsets.size()));
+  for (size_t i = 0; i < layout.offsets.size(); i++) {
+    e->U64(layout.offsets[i]);
+    e->I32(layout.linesizes[i]);
+  }
+}
+
+int DecodeFrame(WireDecoder* d, AVFrame* frame, int* stream_index, SharedMemoryRing::Layout* layout) {
+  *stream_index = d->I32();
+  frame->format = d->I32();
+  frame->width = d->I32();
+  frame->height = d->I32();
+  frame->nb_samples = d->I32();
+  frame->sample_rate = d->I32();
+  DecodeChannelLayout(d, &frame->ch_layout);
+  frame->pts = d->I64();
+  frame->pkt_dts = d->I64();
+  frame->duration = d->I64();
+  frame->best_effort_timestamp = d->I64();
+  frame->time_base = d->Rational();
+  frame->sample_aspect_ratio = d->Rational();
+  frame->flags = d->I32();
+  frame->pict_type = static_cast<AVPictureType>(d->I32());
+  frame->repeat_pict = d->I32();
+  frame->color_range = static_cast<AVColorRange>(d->I32());
+  frame->color_primaries = static_cast<AVColorPrimaries>(d->I32());
+  frame->color_trc = static_cast<AVColorTransferCharacteristic>(d->I32());
+  frame->colorspace = static_cast<AVColorSpace>(d->I32());
+  frame->chroma_location = static_cast<AVChromaLocation>(d->I32());
+  frame->crop_top = static_cast<size_t>(d->U64());
+  frame->crop_bottom = static_cast<size_t>(d->U64());
+  frame->crop_left = static_cast<size_t>(d->U64());
+  frame->crop_right = static_cast<size_t>(d->U64());
+
+  uint32_t count = d->U32();
+  for (uint32_t i = 0; i < count && d->ok(); i++) {
+    uint32_t key_size = 0;
+    uint32_t value_size = 0;
+    const uint8_t* key = d->Bytes(&key_size);
+    const uint8_t* value = d->Bytes(&value_size);
+    if (!key || !value) {
+      break;
+    }
+    std::string k(reinterpret_cast<const char*>(key), key_size);
+    std::string v(reinterpret_cast<const char*>(value), value_size);
+    av_dict_set(&frame->metadata, k.c_str(), v.c_str(), 0);
+  }
+
+  count = d->U32();
+  for (uint32_t i = 0; i < count && d->ok(); i++) {
+    AVFrameSideDataType type = static_cast<AVFrameSideDataType>(d->I32());
+    uint32_t size = 0;
+    const uint8_t* data = d->Bytes(&size);
+    if (!data) {
+      break;
+    }
+    AVFrameSideData* sd = av_frame_new_side_data(frame, type, size);
+    if (!sd) {
+      return AVERROR(ENOMEM);
+    }
+    memcpy(sd->data, data, size);
+  }
+
+  count = d->U32();
+  for (uint32_t i = 0; i < count && d->ok(); i++) {
+    layout->offsets.push_back(d->U64());
+    layout->linesizes.push_back(d->I32());
+  }
+
+  return d->ok() && count > 0 ? 0 : AVERROR_INVALIDDATA;
+}
+
+void EncodePacket(WireEncoder* e, const AVPacket* pkt) {
+  e->I32(pkt->stream_index);
+  e->I32(pkt->flags);
+  e->I64(pkt->pts);
+  e->I64(pkt->dts);
+  e->I64(pkt->duration);
+  e->I64(pkt->pos);
+  e->Rational(pkt->time_base);
+  e->I32(pkt->size);
+  e->U32(static_cast<uint32_t>(pkt->side_data_elems));
+  for (int i = 0; i < pkt->side_data_elems; i++) {
+    e->I32(pkt->side_data[i].type);
+    e->Bytes(pkt->side_data[i].data, pkt->side_data[i].size);
+  }
+}
+
+int DecodePacket(WireDecoder* d, AVPacket* pkt) {
+  pkt->stream_index = d->I32();
+  pkt->flags = d->I32();
+  pkt->pts = d->I64();
+  pkt->dts = d->I64();
+  pkt->duration = d->I64();
+  pkt->pos = d->I64();
+  pkt->time_base = d->Rational();
+  pkt->size = d->I32();
+
+  uint32_t count = d->U32();
+  for (uint32_t i = 0; i < count && d->ok(); i++) {
+    AVPacketSideDataType type = static_cast<AVPacketSideDataType>(d->I32());
+    uint32_t size = 0;
+    const uint8_t* data = d->Bytes(&size);
+    if (!data) {
+      break;
+    }
+    uint8_t* dst = av_packet_new_side_data(pkt, type, size);
+    if (!dst) {
+      return AVERROR(ENOMEM);
+    }
+    memcpy(dst, data, size);
+  }
+
+  return d->ok() && pkt->size >= 0 ? 0 : AVERROR_INVALIDDATA;
+}
+
+} // namespace
+
+// === Setup ===
+
+SharedMemoryRing::~SharedMemoryRing() {
+  Close();
+#ifndef _WIN32
+  if (map_) {
+    munmap(map_, map_size_);
+  }
+#endif
+}
+
+int SharedMemoryRing::Map(int fd, uint64_t size) {
+#ifndef _WIN32
+  void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    return AVERROR(errno);
+  }
+
+  map_ = static_cast<uint8_t*>(map);
+  map_size_ = size;
+  header_ = reinterpret_cast<Header*>(map_);
+  data_ = map_ + kDataOffset;
+  return 0;
+#else
+  return AVERROR(ENOSYS);
+#endif
+}
+
+int SharedMemoryRing::Create(const std::string& name, uint64_t size, Role role, bool zero_copy, std::shared_ptr<SharedMemoryRing>* out) {
+#ifndef _WIN32
+  // Whole pages, so the ring offset of every record stays 64-byte aligned
+  uint64_t capacity = (size + 4095) & ~static_cast<uint64_t>(4095);
+  if (name.empty() || name[0] != '/' || capacity < 2 * kDataOffset) {
+    return AVERROR(EINVAL);
+  }
+
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    return AVERROR(errno);
+  }
+  if (ftruncate(fd, static_cast<off_t>(kDataOffset + capacity)) != 0) {
+    int ret = AVERROR(errno);
+    close(fd);
+    shm_unlink(name.c_str());
+    return ret;
+  }
+
+  std::shared_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+  int ret = ring->Map(fd, kDataOffset + capacity);
+  close(fd);
+  if (ret < 0) {
+    shm_unlink(name.c_str());
+    return ret;
+  }
+
+  ring->name_ = name;
+  ring->owner_ = true;
+  ring->zero_copy_ = zero_copy;
+  ring->capacity_ = capacity;
+
+  // Fresh segments are zero-filled, the magic is published last
+  Header* header = new (ring->map_) Header();
+  header->version = kVersion;
+  header->data_offset = static_cast<uint32_t>(kDataOffset);
+  header->capacity = capacity;
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(header->magic, kMagic, sizeof(kMagic));
+
+  ret = ring->Attach(role);
+  if (ret < 0) {
+    return ret;
+  }
+
+  *out = std::move(ring);
+  return 0;
+#else
+  return AVERROR(ENOSYS);
+#endif
+}
+
+int SharedMemoryRing::Open(const std::string& name, Role role, bool zero_copy, std::shared_ptr<SharedMemoryRing>* out) {
+#ifndef _WIN32
+  int fd = shm_open(name.c_str(), O_RDWR, 0600);
+  if (fd < 0) {
+    return AVERROR(errno);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int ret = AVERROR(errno);
+    close(fd);
+    return ret;
+  }
+  // Creator has not sized the segment yet
+  if (static_cast<uint64_t>(st.st_size) < 2 * kDataOffset) {
+    close(fd);
+    return AVERROR(EAGAIN);
+  }
+
+  std::shared_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+  int ret = ring->Map(fd, static_cast<uint64_t>(st.st_size));
+  close(fd);
+  if (ret < 0) {
+    return ret;
+  }
+
+  Header* header = ring->header_;
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0) {
+    return AVERROR(EAGAIN);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (header->version != kVersion || header->data_offset != kDataOffset ||
+      header->capacity + kDataOffset > static_cast<uint64_t>(st.st_size)) {
+    return AVERROR_INVALIDDATA;
+  }
+
+  ring->name_ = name;
+  ring->zero_copy_ = zero_copy;
+  ring->capacity_ = header->capacity;
+
+  ret = ring->Attach(role);
+  if (ret < 0) {
+    return ret;
+  }
+
+  *out = std::move(ring);
+  return 0;
+#else
+  return AVERROR(ENOSYS);
+#endif
+}
+
+int SharedMemoryRing::Attach(Role role) {
+#ifndef _WIN32
+  uint32_t bit = role == Role::kWriter ? kWriterAttached : kReaderAttached;
+  if (header_->attached.fetch_or(bit) & bit) {
+    return AVERROR(EBUSY);
+  }
+
+  role_ = role;
+  attached_ = true;
+  int64_t pid = static_cast<int64_t>(getpid());
+  if (role == Role::kWriter) {
+    header_->writer_pid = pid;
+    write_pos_ = header_->write_pos.load();
+  } else {
+    header_->reader_pid = pid;
+    read_pos_ = header_->read_pos.load();
+  }
+  return 0;
+#else
+  return AVERROR(ENOSYS);
+#endif
+}
+
+void SharedMemoryRing::Close() {
+  if (!attached_ || closed_.exchange(true)) {
+    return;
+  }
+
+  header_->state.fetch_or(role_ == Role::kWriter ? kWriterClosed : kReaderClosed);
+  // Wake both ends, including calls of this end blocked on another thread
+  Wake(&header_->data_seq, nullptr);
+  Wake(&header_->space_seq, nullptr);
+
+#ifndef _WIN32
+  // The peer keeps its mapping, only the name goes away
+  if (owner_) {
+    shm_unlink(name_.c_str());
+  }
+#endif
+}
+
+uint64_t SharedMemoryRing::GetUsed() const {
+  if (!header_) {
+    return 0;
+  }
+  return header_->write_pos.load(std::memory_order_acquire) - header_->read_pos.load(std::memory_order_acquire);
+}
+
+SharedMemoryChannelStats SharedMemoryRing::GetStats() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+// === Signalling ===
+
+bool SharedMemoryRing::PeerAlive() {
+#ifndef _WIN32
+  int64_t pid = role_ == Role::kWriter ? header_->reader_pid.load() : header_->writer_pid.load();
+  // Not attached yet
+  if (pid <= 0) {
+    return true;
+  }
+  return kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH;
+#else
+  return false;
+#endif
+}
+
+int SharedMemoryRing::Wait(std::atomic<uint32_t>* seq, uint32_t seen, std::atomic<uint32_t>* waiting) {
+  waiting->store(1);
+  // Re-check after announcing the wait, the other end checks waiting after bumping seq
+  if (seq->load() == seen && !closed_) {
+#ifdef __linux__
+    struct timespec timeout = { 0, kWaitSliceUs * 1000 };
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(seq), FUTEX_WAIT, seen, &timeout, nullptr, 0);
+#else
+    // No cross-process futex - poll with short sleeps
+    for (int64_t slept = 0; slept < kWaitSliceUs && seq->load() == seen && !closed_; slept += 200) {
+      av_usleep(200);
+    }
+#endif
+  }
+  waiting->store(0);
+
+  if (closed_) {
+    return AVERROR_EXIT;
+  }
+  return PeerAlive() ? 0 : AVERROR(EPIPE);
+}
+
+void SharedMemoryRing::Wake(std::atomic<uint32_t>* seq, std::atomic<uint32_t>* waiting) {
+  seq->fetch_add(1);
+  // Skip the syscall unless the other end is (about to be) asleep
+  if (waiting && waiting->load() == 0) {
+    return;
+  }
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(seq), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+// === Writer ===
+
+int SharedMemoryRing::Reserve(uint64_t size, uint8_t** record, bool block) {
+  // Half the ring, so padding up to the wrap point always fits
+  if (size > capacity_ / 2) {
+    return AVERROR(ENOSPC);
+  }
+
+  uint64_t offset = write_pos_ % capacity_;
+  uint64_t pad = capacity_ - offset < size ? capacity_ - offset : 0;
+  bool waited = false;
+
+  while (true) {
+    if (closed_) {
+      return AVERROR_EXIT;
+    }
+    if (header_->state.load(std::memory_order_acquire) & kReaderClosed) {
+      return AVERROR(EPIPE);
+    }
+
+    uint32_t seen = header_->space_seq.load(std::memory_order_acquire);
+    uint64_t used = write_pos_ - header_->read_pos.load(std::memory_order_acquire);
+    if (capacity_ - used >= pad + size) {
+      break;
+    }
+    if (!block) {
+      return AVERROR(EAGAIN);
+    }
+
+    if (!waited) {
+      waited = true;
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.waits++;
+    }
+    int ret = Wait(&header_->space_seq, seen, &header_->writer_waiting);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  // Records never wrap - skip the tail of the ring
+  if (pad > 0) {
+    Record* skip = reinterpret_cast<Record*>(data_ + offset);
+    memset(skip, 0, sizeof(Record));
+    skip->type = kPad;
+    skip->size = pad;
+    write_pos_ += pad;
+  }
+
+  *record = data_ + write_pos_ % capacity_;
+  return 0;
+}
+
+void SharedMemoryRing::Publish(uint64_t size) {
+  write_pos_ += size;
+  header_->write_pos.store(write_pos_, std::memory_order_release);
+  Wake(&header_->data_seq, &header_->reader_waiting);
+}
+
+int SharedMemoryRing::WriteRecord(uint32_t type, const std::vector<uint8_t>& meta, const Layout* layout, const AVFrame* frame, const AVPacket* pkt, bool block) {
+  uint64_t data_offset = Align(sizeof(Record) + meta.size());
+  uint64_t data_size = layout ? layout->size : 0;
+  uint64_t size = data_offset + Align(data_size);
+
+  uint8_t* base = nullptr;
+  int ret = Reserve(size, &base, block);
+  if (ret < 0) {
+    return ret;
+  }
+
+  memcpy(base + sizeof(Record), meta.data(), meta.size());
+  if (frame) {
+    CopyFrameData(frame, *layout, base + data_offset);
+  } else if (pkt) {
+    // Payload is followed by the zeroed input padding
+    if (pkt->size > 0) {
+      memcpy(base + data_offset, pkt->data, pkt->size);
+    }
+    memset(base + data_offset + pkt->size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+  }
+
+  Record* record = reinterpret_cast<Record*>(base);
+  record->type = type;
+  record->meta_size = static_cast<uint32_t>(meta.size());
+  record->size = size;
+  record->data_offset = data_offset;
+  record->data_size = data_size;
+
+  Publish(size);
+  return 0;
+}
+
+int SharedMemoryRing::AddStream(const AVCodecParameters* par, AVRational time_base) {
+  if (role_ != Role::kWriter || !par) {
+    return AVERROR(EINVAL);
+  }
+
+  std::vector<uint8_t> meta;
+  WireEncoder e(&meta);
+  e.I32(next_stream_);
+  e.Rational(time_base);
+  EncodeCodecParameters(&e, par);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (allocated_) {
+      return AVERROR(EBUSY);
+    }
+  }
+
+  // Called from the JS thread - never blocks
+  int ret = WriteRecord(kStream, meta, nullptr, nullptr, nullptr, false);
+  if (ret < 0) {
+    return ret;
+  }
+  return next_stream_++;
+}
+
+int SharedMemoryRing::SendPacket(const AVPacket* pkt) {
+  if (role_ != Role::kWriter || !pkt || pkt->size < 0 || (pkt->size > 0 && !pkt->data)) {
+    return AVERROR(EINVAL);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (allocated_) {
+      return AVERROR(EBUSY);
+    }
+  }
+
+  std::vector<uint8_t> meta;
+  WireEncoder e(&meta);
+  EncodePacket(&e, pkt);
+
+  Layout layout;
+  layout.size = static_cast<uint64_t>(pkt->size) + AV_INPUT_BUFFER_PADDING_SIZE;
+
+  int ret = WriteRecord(kPacket, meta, &layout, nullptr, pkt, true);
+  if (ret < 0) {
+    return ret;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.packets++;
+  stats_.bytes += pkt->size;
+  return 0;
+}
+
+int SharedMemoryRing::SendFrame(const AVFrame* frame, int stream_index) {
+  if (role_ != Role::kWriter || !frame || stream_index < 0) {
+    return AVERROR(EINVAL);
+  }
+
+  Layout layout;
+  int ret = FrameLayout(frame, &layout);
+  if (ret < 0) {
+    return ret;
+  }
+
+  std::vector<uint8_t> meta;
+  WireEncoder e(&meta);
+  EncodeFrame(&e, frame, stream_index, layout);
+
+  bool own = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    own = allocated_ && frame->buf[0] && frame->buf[0]->data == allocation_data_;
+    if (allocated_ && !own) {
+      return AVERROR(EBUSY);
+    }
+    if (own) {
+      if (meta.size() > kAllocMeta || frame->buf[0]->size != layout.size) {
+        return AVERROR(EINVAL);
+      }
+      allocated_ = false;
+      stats_.zero_copy++;
+    }
+  }
+
+  if (!own) {
+    ret = WriteRecord(kFrame, meta, &layout, frame, nullptr, true);
+    if (ret < 0) {
+      return ret;
+    }
+  } else {
+    // Planes are already in place, only the metadata is written
+    uint8_t* base = data_ + allocation_pos_ % capacity_;
+    uint64_t data_offset = Align(sizeof(Record) + kAllocMeta);
+    uint64_t size = data_offset + Align(layout.size);
+    memcpy(base + sizeof(Record), meta.data(), meta.size());
+
+    Record* record = reinterpret_cast<Record*>(base);
+    record->type = kFrame;
+    record->meta_size = static_cast<uint32_t>(meta.size());
+    record->size = size;
+    record->data_offset = data_offset;
+    record->data_size = layout.size;
+    Publish(size);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.frames++;
+  stats_.bytes += layout.size;
+  return 0;
+}
+
+int SharedMemoryRing::AllocFrame(AVFrame* frame) {
+  if (role_ != Role::kWriter || !frame || frame->buf[0]) {
+    return AVERROR(EINVAL);
+  }
+
+  Layout layout;
+  int ret = FrameLayout(frame, &layout);
+  if (ret < 0) {
+    return ret;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (allocated_) {
+      return AVERROR(EBUSY);
+    }
+  }
+
+  uint64_t data_offset = Align(sizeof(Record) + kAllocMeta);
+  uint8_t* base = nullptr;
+  ret = Reserve(data_offset + Align(layout.size), &base, true);
+  if (ret < 0) {
+    return ret;
+  }
+
+  uint64_t id = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    id = ++allocation_id_;
+  }
+
+  auto* ref = new BufferRef{ shared_from_this(), id };
+  AVBufferRef* buf = av_buffer_create(base + data_offset, layout.size, ReleaseAllocation, ref, 0);
+  if (!buf) {
+    delete ref;
+    return AVERROR(ENOMEM);
+  }
+  ret = AttachFrameData(frame, layout, buf);
+  if (ret < 0) {
+    return ret;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  allocated_ = true;
+  allocation_pos_ = write_pos_;
+  allocation_data_ = buf->data;
+  return 0;
+}
+
+void SharedMemoryRing::CancelAllocation(uint64_t id) {
+  // The space is reused by the next record
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (allocated_ && allocation_id_ == id) {
+    allocated_ = false;
+  }
+}
+
+void SharedMemoryRing::ReleaseAllocation(void* opaque, uint8_t* data) {
+  auto* ref = static_cast<BufferRef*>(opaque);
+  ref->ring->CancelAllocation(ref->id);
+  // May drop the last reference to the mapping
+  delete ref;
+}
+
+int SharedMemoryRing::End() {
+  if (role_ != Role::kWriter || !header_) {
+    return AVERROR(EINVAL);
+  }
+
+  header_->state.fetch_or(kEnded);
+  Wake(&header_->data_seq, &header_->reader_waiting);
+  return 0;
+}
+
+// === Reader ===
+
+int SharedMemoryRing::Next(const Record** record) {
+  if (role_ != Role::kReader) {
+    return AVERROR(EINVAL);
+  }
+
+  bool waited = false;
+  while (true) {
+    if (closed_) {
+      return AVERROR_EXIT;
+    }
+
+    uint32_t seen = header_->data_seq.load(std::memory_order_acquire);
+    uint64_t available = header_->write_pos.load(std::memory_order_acquire);
+    if (read_pos_ < available) {
+      const Record* next = reinterpret_cast<const Record*>(data_ + read_pos_ % capacity_);
+      if (next->type == kPad) {
+        Release(Consume(next->size));
+        continue;
+      }
+      if (next->size < sizeof(Record) || next->size > capacity_ / 2 || next->data_offset + next->data_size > next->size) {
+        return AVERROR_INVALIDDATA;
+      }
+      *record = next;
+      return 0;
+    }
+
+    uint32_t state = header_->state.load(std::memory_order_acquire);
+    if (state & (kEnded | kWriterClosed)) {
+      // Records published right before the writer finished
+      if (header_->write_pos.load(std::memory_order_acquire) != available) {
+        continue;
+      }
+      return state & kEnded ? AVERROR_EOF : AVERROR(EPIPE);
+    }
+
+    if (!waited) {
+      waited = true;
+      std::lock_guard<std::mutex> lock(mutex_);
+      stats_.waits++;
+    }
+    int ret = Wait(&header_->data_seq, seen, &header_->reader_waiting);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+}
+
+uint64_t SharedMemoryRing::Consume(uint64_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  read_pos_ += size;
+  held_.push_back({ read_pos_, false });
+  return first_id_ + held_.size() - 1;
+}
+
+void SharedMemoryRing::Release(uint64_t id) {
+  bool advanced = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    held_[id - first_id_].released = true;
+
+    // Space is reclaimed in ring order
+    while (!held_.empty() && held_.front().released) {
+      header_->read_pos.store(held_.front().end, std::memory_order_release);
+      held_.pop_front();
+      first_id_++;
+      advanced = true;
+    }
+  }
+
+  if (advanced) {
+    Wake(&header_->space_seq, &header_->writer_waiting);
+  }
+}
+
+AVBufferRef* SharedMemoryRing::WrapPayload(uint8_t* data, size_t size, uint64_t id) {
+  if (!zero_copy_) {
+    AVBufferRef* buf = av_buffer_alloc(size);
+    if (buf) {
+      memcpy(buf->data, data, size);
+    }
+    Release(id);
+    return buf;
+  }
+
+  auto* ref = new BufferRef{ shared_from_this(), id };
+  AVBufferRef* buf = av_buffer_create(data, size, ReleaseBuffer, ref, 0);
+  if (!buf) {
+    delete ref;
+    Release(id);
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.zero_copy++;
+  return buf;
+}
+
+void SharedMemoryRing::ReleaseBuffer(void* opaque, uint8_t* data) {
+  auto* ref = static_cast<BufferRef*>(opaque);
+  ref->ring->Release(ref->id);
+  // May drop the last reference to the mapping
+  delete ref;
+}
+
+int SharedMemoryRing::ReadStream(const Record* record, AVCodecParameters* par) {
+  WireDecoder d(reinterpret_cast<const uint8_t*>(record) + sizeof(Record), record->meta_size);
+  int index = d.I32();
+  AVRational time_base = d.Rational();
+
+  int ret = d.ok() && index >= 0 && index < 65536 ? 0 : AVERROR_INVALIDDATA;
+  if (ret >= 0 && par) {
+    AVCodecParameters* decoded = avcodec_parameters_alloc();
+    if (!decoded) {
+      ret = AVERROR(ENOMEM);
+    } else {
+      ret = DecodeCodecParameters(&d, decoded);
+      if (ret >= 0) {
+        ret = avcodec_parameters_copy(par, decoded);
+      }
+      avcodec_parameters_free(&decoded);
+    }
+  }
+  if (ret < 0) {
+    return ret;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (time_bases_.size() <= static_cast<size_t>(index)) {
+      time_bases_.resize(index + 1, AVRational{ 0, 1 });
+    }
+    time_bases_[index] = time_base;
+  }
+
+  Release(Consume(record->size));
+  return index;
+}
+
+int SharedMemoryRing::ReceiveStream(AVCodecParameters* par) {
+  const Record* record = nullptr;
+  int ret = Next(&record);
+  if (ret < 0) {
+    return ret;
+  }
+  // Every stream has been announced
+  if (record->type != kStream) {
+    return AVERROR(EAGAIN);
+  }
+  return ReadStream(record, par);
+}
+
+AVRational SharedMemoryRing::StreamTimeBase(int index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (index < 0 || static_cast<size_t>(index) >= time_bases_.size()) {
+    return AVRational{ 0, 1 };
+  }
+  return time_bases_[index];
+}
+
+int SharedMemoryRing::ReceivePacket(AVPacket* pkt) {
+  const Record* record = nullptr;
+  int ret = 0;
+  // Streams announced late are picked up on the way
+  while ((ret = Next(&record)) >= 0 && record->type == kStream) {
+    ret = ReadStream(record, nullptr);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+  if (ret < 0) {
+    return ret;
+  }
+  if (record->type != kPacket) {
+    return AVERROR(EINVAL);
+  }
+
+  av_packet_unref(pkt);
+  WireDecoder d(reinterpret_cast<const uint8_t*>(record) + sizeof(Record), record->meta_size);
+  ret = DecodePacket(&d, pkt);
+  if (ret >= 0 && static_cast<uint64_t>(pkt->size) + AV_INPUT_BUFFER_PADDING_SIZE > record->data_size) {
+    ret = AVERROR_INVALIDDATA;
+  }
+
+  uint64_t id = Consume(record->size);
+  if (ret < 0) {
+    Release(id);
+    av_packet_unref(pkt);
+    return ret;
+  }
+
+  uint8_t* payload = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(record)) + record->data_offset;
+  pkt->buf = WrapPayload(payload, record->data_size, id);
+  if (!pkt->buf) {
+    av_packet_unref(pkt);
+    return AVERROR(ENOMEM);
+  }
+  pkt->data = pkt->buf->data;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.packets++;
+  stats_.bytes += pkt->size;
+  return 0;
+}
+
+int SharedMemoryRing::ReceiveFrame(AVFrame* frame) {
+  const Record* record = nullptr;
+  int ret = 0;
+  while ((ret = Next(&record)) >= 0 && record->type == kStream) {
+    ret = ReadStream(record, nullptr);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+  if (ret < 0) {
+    return ret;
+  }
+  if (record->type != kFrame) {
+    return AVERROR(EINVAL);
+  }
+
+  av_frame_unref(frame);
+  int stream_index = 0;
+  Layout layout;
+  WireDecoder d(reinterpret_cast<const uint8_t*>(record) + sizeof(Record), record->meta_size);
+  ret = DecodeFrame(&d, frame, &stream_index, &layout);
+  if (ret >= 0) {
+    for (size_t i = 0; i < layout.offsets.size(); i++) {
+      if (layout.offsets[i] >= record->data_size) {
+        ret = AVERROR_INVALIDDATA;
+      }
+    }
+  }
+
+  uint64_t id = Consume(record->size);
+  if (ret < 0) {
+    Release(id);
+    av_frame_unref(frame);
+    return ret;
+  }
+
+  uint8_t* payload = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(record)) + record->data_offset;
+  AVBufferRef* buf = WrapPayload(payload, record->data_size, id);
+  if (!buf) {
+    av_frame_unref(frame);
+    return AVERROR(ENOMEM);
+  }
+  ret = AttachFrameData(frame, layout, buf);
+  if (ret < 0) {
+    av_frame_unref(frame);
+    return ret;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.frames++;
+  stats_.bytes += record->data_size;
+  return stream_index;
+}
+
+// === SharedMemoryChannel ===
+
+Napi::FunctionReference SharedMemoryChannel::constructor;
+
+Napi::Object SharedMemoryChannel::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "SharedMemoryChannel", {
+    // Setup
+    InstanceMethod<&SharedMemoryChannel::Create>("create"),
+    InstanceMethod<&SharedMemoryChannel::Open>("open"),
+
+    // Writer
+    InstanceMethod<&SharedMemoryChannel::AddStream>("addStream"),
+    InstanceMethod<&SharedMemoryChannel::SendPacketAsync>("sendPacket"),
+    InstanceMethod<&SharedMemoryChannel::SendPacketSync>("sendPacketSync"),
+    InstanceMethod<&SharedMemoryChannel::SendFrameAsync>("sendFrame"),
+    InstanceMethod<&SharedMemoryChannel::SendFrameSync>("sendFrameSync"),
+    InstanceMethod<&SharedMemoryChannel::AllocFrameAsync>("allocFrame"),
+    InstanceMethod<&SharedMemoryChannel::AllocFrameSync>("allocFrameSync"),
+    InstanceMethod<&SharedMemoryChannel::End>("end"),
+
+    // Reader
+    InstanceMethod<&SharedMemoryChannel::ReceiveStreamAsync>("receiveStream"),
+    InstanceMethod<&SharedMemoryChannel::ReceiveStreamSync>("receiveStreamSync"),
+    InstanceMethod<&SharedMemoryChannel::ReceivePacketAsync>("receivePacket"),
+    InstanceMethod<&SharedMemoryChannel::ReceivePacketSync>("receivePacketSync"),
+    InstanceMethod<&SharedMemoryChannel::ReceiveFrameAsync>("receiveFrame"),
+    InstanceMethod<&SharedMemoryChannel::ReceiveFrameSync>("receiveFrameSync"),
+    InstanceMethod<&SharedMemoryChannel::GetStreamTimeBase>("getStreamTimeBase"),
+
+    // Lifecycle
+    InstanceMethod<&SharedMemoryChannel::Close>("close"),
+    InstanceMethod(Napi::Symbol::WellKnown(env, "dispose"), &SharedMemoryChannel::Dispose),
+
+    // Properties
+    InstanceAccessor<&SharedMemoryChannel::GetName>("name"),
+    InstanceAccessor<&SharedMemoryChannel::GetRole>("role"),
+    InstanceAccessor<&SharedMemoryChannel::GetSize>("size"),
+    InstanceAccessor<&SharedMemoryChannel::GetUsed>("used"),
+    InstanceMethod<&SharedMemoryChannel::GetStats>("getStats"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SharedMemoryChannel", func);
+  return exports;
+}
+
+SharedMemoryChannel::SharedMemoryChannel(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<SharedMemoryChannel>(info) {
+  // Constructor does nothing - user must call create() or open()
+}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+  // Buffers still referencing the ring keep the mapping alive
+  if (ring_) {
+    ring_->Close();
+  }
+}
+
+bool SharedMemoryChannel::ParseRole(const Napi::Value& value, SharedMemoryRing::Role* role) {
+  if (!value.IsString()) {
+    return false;
+  }
+  std::string name = value.As<Napi::String>().Utf8Value();
+  if (name == "writer") {
+    *role = SharedMemoryRing::Role::kWriter;
+  } else if (name == "reader") {
+    *role = SharedMemoryRing::Role::kReader;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+Napi::Value SharedMemoryChannel::Create(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SharedMemoryRing::Role role;
+  if (info.Length() < 3 || !info[0].IsString() || !ParseRole(info[1], &role) || !info[2].IsNumber()) {
+    Napi::TypeError::New(env, "Expected (name, role, size[, zeroCopy])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (ring_) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
+  int64_t size = info[2].As<Napi::Number>().Int64Value();
+  bool zero_copy = info.Length() < 4 || !info[3].IsBoolean() || info[3].As<Napi::Boolean>().Value();
+  if (size <= 0) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  int ret = SharedMemoryRing::Create(info[0].As<Napi::String>().Utf8Value(), static_cast<uint64_t>(size), role, zero_copy, &ring_);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value SharedMemoryChannel::Open(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SharedMemoryRing::Role role;
+  if (info.Length() < 2 || !info[0].IsString() || !ParseRole(info[1], &role)) {
+    Napi::TypeError::New(env, "Expected (name, role[, zeroCopy])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (ring_) {
+    return Napi::Number::New(env, AVERROR(EBUSY));
+  }
+
+  bool zero_copy = info.Length() < 3 || !info[2].IsBoolean() || info[2].As<Napi::Boolean>().Value();
+  int ret = SharedMemoryRing::Open(info[0].As<Napi::String>().Utf8Value(), role, zero_copy, &ring_);
+  return Napi::Number::New(env, ret);
+}
+
+Napi::Value SharedMemoryChannel::AddStream(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Expected 2 arguments (codecpar, timeBase)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[0], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid codec parameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return Napi::Number::New(env, AVERROR(EINVAL));
+  }
+
+  return Napi::Number::New(env, ring_->AddStream(par->Get(), JSToRational(info[1].As<Napi::Object>())));
+}
+
+Napi::Value SharedMemoryChannel::End(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), ring_ ? ring_->End() : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::GetStreamTimeBase(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Expected stream index").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return env.Null();
+  }
+
+  AVRational time_base = ring_->StreamTimeBase(info[0].As<Napi::Number>().Int32Value());
+  if (time_base.num == 0) {
+    return env.Null();
+  }
+  return RationalToJS(env, time_base);
+}
+
+// === Lifecycle ===
+
+Napi::Value SharedMemoryChannel::Close(const Napi::CallbackInfo& info) {
+  if (ring_) {
+    ring_->Close();
+  }
+  return info.Env().Undefined();
+}
+
+Napi::Value SharedMemoryChannel::Dispose(const Napi::CallbackInfo& info) {
+  return Close(info);
+}
+
+// === Properties ===
+
+Napi::Value SharedMemoryChannel::GetName(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (!ring_) {
+    return env.Null();
+  }
+  return Napi::String::New(env, ring_->GetName());
+}
+
+Napi::Value SharedMemoryChannel::GetRole(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  if (!ring_) {
+    return env.Null();
+  }
+  return Napi::String::New(env, ring_->GetRole() == SharedMemoryRing::Role::kWriter ? "writer" : "reader");
+}
+
+Napi::Value SharedMemoryChannel::GetSize(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), ring_ ? static_cast<double>(ring_->GetCapacity()) : 0);
+}
+
+Napi::Value SharedMemoryChannel::GetUsed(const Napi::CallbackInfo& info) {
+  return Napi::Number::New(info.Env(), ring_ ? static_cast<double>(ring_->GetUsed()) : 0);
+}
+
+Napi::Value SharedMemoryChannel::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SharedMemoryChannelStats stats = ring_ ? ring_->GetStats() : SharedMemoryChannelStats();
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("packets", Napi::Number::New(env, static_cast<double>(stats.packets)));
+  obj.Set("frames", Napi::Number::New(env, static_cast<double>(stats.frames)));
+  obj.Set("bytes", Napi::Number::New(env, static_cast<double>(stats.bytes)));
+  obj.Set("zeroCopy", Napi::Number::New(env, static_cast<double>(stats.zero_copy)));
+  obj.Set("waits", Napi::Number::New(env, static_cast<double>(stats.waits)));
+  obj.Set("used", Napi::Number::New(env, ring_ ? static_cast<double>(ring_->GetUsed()) : 0));
+  return obj;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,204 @@
+#ifndef FFMPEG_SHARED_MEMORY_CHANNEL_H
+#define FFMPEG_SHARED_MEMORY_CHANNEL_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavutil/frame.h>
+}
+
+namespace ffmpeg {
+
+struct SharedMemoryChannelStats {
+  uint64_t packets = 0;           // Packets sent or received
+  uint64_t frames = 0;            // Frames sent or received
+  uint64_t bytes = 0;             // Payload bytes sent or received
+  uint64_t zero_copy = 0;         // Records moved without copying the payload
+  uint64_t waits = 0;             // Times this end blocked on the other one
+};
+
+/**
+ * Single-producer single-consumer ring buffer in a named shared-memory
+ * segment, carrying codec parameters, packets and frames between processes.
+ *
+ * Records are contiguous and 64-byte aligned: a fixed header, the serialized
+ * metadata and the payload (packet data or frame planes). The writer copies
+ * payloads into the ring once; frames allocated with AllocFrame() already
+ * live there. The reader hands out buffers referencing the ring, so a record
+ * is only reclaimed once every buffer of it has been freed - in ring order.
+ *
+ * Each end blocks while the other one is behind: futex waits on Linux,
+ * short sleeps elsewhere. A peer that exits without closing is detected.
+ * Not available on Windows (AVERROR(ENOSYS)).
+ */
+class SharedMemoryRing : public std::enable_shared_from_this<SharedMemoryRing> {
+public:
+  enum class Role { kWriter, kReader };
+
+  // Wire structures, defined in the implementation
+  struct Header;
+  struct Record;
+  struct Layout;
+
+  ~SharedMemoryRing();
+
+  static int Create(const std::string& name, uint64_t size, Role role, bool zero_copy, std::shared_ptr<SharedMemoryRing>* out);
+  static int Open(const std::string& name, Role role, bool zero_copy, std::shared_ptr<SharedMemoryRing>* out);
+
+  // Writer
+  int AddStream(const AVCodecParameters* par, AVRational time_base);
+  int SendPacket(const AVPacket* pkt);
+  int SendFrame(const AVFrame* frame, int stream_index);
+  int AllocFrame(AVFrame* frame);
+  int End();
+
+  // Reader
+  int ReceiveStream(AVCodecParameters* par);
+  int ReceivePacket(AVPacket* pkt);
+  int ReceiveFrame(AVFrame* frame);
+  AVRational StreamTimeBase(int index);
+
+  // Detach and wake blocked calls of this end
+  void Close();
+
+  Role GetRole() const { return role_; }
+  const std::string& GetName() const { return name_; }
+  uint64_t GetCapacity() const { return capacity_; }
+  uint64_t GetUsed() const;
+  SharedMemoryChannelStats GetStats();
+
+private:
+  // A received record, reclaimed once released
+  struct Held {
+    uint64_t end;
+    bool released;
+  };
+
+  struct BufferRef {
+    std::shared_ptr<SharedMemoryRing> ring;
+    uint64_t id;
+  };
+
+  SharedMemoryRing() = default;
+
+  int Map(int fd, uint64_t size);
+  int Attach(Role role);
+  bool PeerAlive();
+  int Wait(std::atomic<uint32_t>* seq, uint32_t seen, std::atomic<uint32_t>* waiting);
+  void Wake(std::atomic<uint32_t>* seq, std::atomic<uint32_t>* waiting);
+
+  int Reserve(uint64_t size, uint8_t** record, bool block);
+  void Publish(uint64_t size);
+  int WriteRecord(uint32_t type, const std::vector<uint8_t>& meta, const Layout* layout, const AVFrame* frame, const AVPacket* pkt, bool block);
+  void CancelAllocation(uint64_t id);
+
+  int Next(const Record** record);
+  int ReadStream(const Record* record, AVCodecParameters* par);
+  uint64_t Consume(uint64_t size);
+  void Release(uint64_t id);
+  AVBufferRef* WrapPayload(uint8_t* data, size_t size, uint64_t id);
+
+  static void ReleaseBuffer(void* opaque, uint8_t* data);
+  static void ReleaseAllocation(void* opaque, uint8_t* data);
+
+  std::string name_;
+  Role role_ = Role::kWriter;
+  bool owner_ = false;
+  bool attached_ = false;
+  bool zero_copy_ = true;
+  uint8_t* map_ = nullptr;
+  uint64_t map_size_ = 0;
+  Header* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  uint64_t capacity_ = 0;
+  std::atomic<bool> closed_{false};
+
+  std::mutex mutex_;
+  SharedMemoryChannelStats stats_;
+
+  // Writer state
+  int next_stream_ = 0;
+  uint64_t write_pos_ = 0;
+  bool allocated_ = false;        // AllocFrame() reservation waiting for SendFrame()
+  uint64_t allocation_id_ = 0;
+  uint64_t allocation_pos_ = 0;
+  uint8_t* allocation_data_ = nullptr;
+
+  // Reader state
+  uint64_t read_pos_ = 0;         // Next record
+  uint64_t first_id_ = 0;         // Id of held_.front()
+  std::deque<Held> held_;
+  std::vector<AVRational> time_bases_;
+};
+
+/**
+ * Shared-memory channel between Node processes.
+ */
+class SharedMemoryChannel : public Napi::ObjectWrap<SharedMemoryChannel> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  SharedMemoryChannel(const Napi::CallbackInfo& info);
+  ~SharedMemoryChannel();
+
+private:
+  friend class SMCSendPacketWorker;
+  friend class SMCSendFrameWorker;
+  friend class SMCAllocFrameWorker;
+  friend class SMCReceiveStreamWorker;
+  friend class SMCReceivePacketWorker;
+  friend class SMCReceiveFrameWorker;
+
+  static Napi::FunctionReference constructor;
+
+  std::shared_ptr<SharedMemoryRing> ring_;
+
+  bool ParseRole(const Napi::Value& value, SharedMemoryRing::Role* role);
+
+  // Setup
+  Napi::Value Create(const Napi::CallbackInfo& info);
+  Napi::Value Open(const Napi::CallbackInfo& info);
+
+  // Writer
+  Napi::Value AddStream(const Napi::CallbackInfo& info);
+  Napi::Value SendPacketAsync(const Napi::CallbackInfo& info);
+  Napi::Value SendPacketSync(const Napi::CallbackInfo& info);
+  Napi::Value SendFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value SendFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value AllocFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value AllocFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value End(const Napi::CallbackInfo& info);
+
+  // Reader
+  Napi::Value ReceiveStreamAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveStreamSync(const Napi::CallbackInfo& info);
+  Napi::Value ReceivePacketAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceivePacketSync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveFrameAsync(const Napi::CallbackInfo& info);
+  Napi::Value ReceiveFrameSync(const Napi::CallbackInfo& info);
+  Napi::Value GetStreamTimeBase(const Napi::CallbackInfo& info);
+
+  // Lifecycle
+  Napi::Value Close(const Napi::CallbackInfo& info);
+  Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+  // Properties
+  Napi::Value GetName(const Napi::CallbackInfo& info);
+  Napi::Value GetRole(const Napi::CallbackInfo& info);
+  Napi::Value GetSize(const Napi::CallbackInfo& info);
+  Napi::Value GetUsed(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_SHARED_MEMORY_CHANNEL_H
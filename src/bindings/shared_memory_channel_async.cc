@@ -0,0 +1,366 @@
+#include "shared_memory_channel.h"
+#include "codec_parameters.h"
+#include "frame.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class SMCSendPacketWorker : public Napi::AsyncWorker {
+public:
+  SMCSendPacketWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, Packet* packet)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->SendPacket(packet_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class SMCSendFrameWorker : public Napi::AsyncWorker {
+public:
+  SMCSendFrameWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, Frame* frame, int stream_index)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      frame_(frame),
+      stream_index_(stream_index),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->SendFrame(frame_->Get(), stream_index_);
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  Frame* frame_;
+  int stream_index_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class SMCAllocFrameWorker : public Napi::AsyncWorker {
+public:
+  SMCAllocFrameWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, Frame* frame)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->AllocFrame(frame_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class SMCReceiveStreamWorker : public Napi::AsyncWorker {
+public:
+  SMCReceiveStreamWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, CodecParameters* par)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      par_(par),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->ReceiveStream(par_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  CodecParameters* par_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class SMCReceivePacketWorker : public Napi::AsyncWorker {
+public:
+  SMCReceivePacketWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, Packet* packet)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      packet_(packet),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->ReceivePacket(packet_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  Packet* packet_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+class SMCReceiveFrameWorker : public Napi::AsyncWorker {
+public:
+  SMCReceiveFrameWorker(Napi::Env env, std::shared_ptr<SharedMemoryRing> ring, Frame* frame)
+    : Napi::AsyncWorker(env),
+      ring_(std::move(ring)),
+      frame_(frame),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = ring_->ReceiveFrame(frame_->Get());
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  std::shared_ptr<SharedMemoryRing> ring_;
+  Frame* frame_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+namespace {
+
+Napi::Value ResolvedCode(Napi::Env env, int code) {
+  auto deferred = Napi::Promise::Deferred::New(env);
+  deferred.Resolve(Napi::Number::New(env, code));
+  return deferred.Promise();
+}
+
+} // namespace
+
+Napi::Value SharedMemoryChannel::SendPacketAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCSendPacketWorker(env, ring_, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SharedMemoryChannel::SendFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame[, streamIndex])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  int stream_index = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 0;
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCSendFrameWorker(env, ring_, frame, stream_index);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SharedMemoryChannel::AllocFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCAllocFrameWorker(env, ring_, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SharedMemoryChannel::ReceiveStreamAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (codecpar)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[0], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid codec parameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCReceiveStreamWorker(env, ring_, par);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SharedMemoryChannel::ReceivePacketAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCReceivePacketWorker(env, ring_, packet);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SharedMemoryChannel::ReceiveFrameAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ring_) {
+    return ResolvedCode(env, AVERROR(EINVAL));
+  }
+
+  auto* worker = new SMCReceiveFrameWorker(env, ring_, frame);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
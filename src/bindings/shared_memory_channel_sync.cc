@@ -0,0 +1,112 @@
+#include "shared_memory_channel.h"
+#include "codec_parameters.h"
+#include "frame.h"
+#include "packet.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value SharedMemoryChannel::SendPacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ring_ ? ring_->SendPacket(packet->Get()) : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::SendFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame[, streamIndex])").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  int stream_index = info.Length() > 1 && info[1].IsNumber() ? info[1].As<Napi::Number>().Int32Value() : 0;
+
+  return Napi::Number::New(env, ring_ ? ring_->SendFrame(frame->Get(), stream_index) : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::AllocFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ring_ ? ring_->AllocFrame(frame->Get()) : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::ReceiveStreamSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (codecpar)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  CodecParameters* par = UnwrapNativeObject<CodecParameters>(env, info[0], "CodecParameters");
+  if (!par || !par->Get()) {
+    Napi::TypeError::New(env, "Invalid codec parameters object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ring_ ? ring_->ReceiveStream(par->Get()) : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::ReceivePacketSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (packet)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Packet* packet = UnwrapNativeObject<Packet>(env, info[0], "Packet");
+  if (!packet || !packet->Get()) {
+    Napi::TypeError::New(env, "Invalid packet object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ring_ ? ring_->ReceivePacket(packet->Get()) : AVERROR(EINVAL));
+}
+
+Napi::Value SharedMemoryChannel::ReceiveFrameSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected 1 argument (frame)").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Frame* frame = UnwrapNativeObject<Frame>(env, info[0], "Frame");
+  if (!frame || !frame->Get()) {
+    Napi::TypeError::New(env, "Invalid frame object").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, ring_ ? ring_->ReceiveFrame(frame->Get()) : AVERROR(EINVAL));
+}
+
+} // namespace ffmpeg
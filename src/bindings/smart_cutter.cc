@@ -0,0 +1,790 @@
+#include "smart_cutter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+#include <libavutil/opt.h>
+}
+
+namespace ffmpeg {
+
+namespace {
+
+using NalUnit = std::pair<const uint8_t*, size_t>;
+
+// Split an Annex B byte stream into NAL units (start codes and trailing zeros removed)
+void SplitAnnexB(const uint8_t* data, size_t size, std::vector<NalUnit>* nals) {
+  size_t i = 0;
+  size_t begin = SIZE_MAX;
+  while (i + 3 <= size) {
+    if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1) {
+      if (begin != SIZE_MAX) {
+        size_t end = i;
+        while (end > begin && data[end - 1] == 0) end--;
+        if (end > begin) nals->emplace_back(data + begin, end - begin);
+      }
+      i += 3;
+      begin = i;
+      continue;
+    }
+    i++;
+  }
+  if (begin != SIZE_MAX && begin < size) {
+    nals->emplace_back(data + begin, size - begin);
+  }
+}
+
+bool IsAnnexB(const uint8_t* data, size_t size) {
+  return size >= 3 && data[0] == 0 && data[1] == 0 && (data[2] == 1 || (size >= 4 && data[2] == 0 && data[3] == 1));
+}
+
+// Swap the payload of a packet, keeping its properties
+int ReplacePayload(AVPacket* pkt, const std::vector<uint8_t>& payload) {
+  AVBufferRef* buf = av_buffer_alloc(payload.size() + AV_INPUT_BUFFER_PADDING_SIZE);
+  if (!buf) {
+    return AVERROR(ENOMEM);
+  }
+  memcpy(buf->data, payload.data(), payload.size());
+  memset(buf->data + payload.size(), 0, AV_INPUT_BUFFER_PADDING_SIZE);
+
+  av_buffer_unref(&pkt->buf);
+  pkt->buf = buf;
+  pkt->data = buf->data;
+  pkt->size = static_cast<int>(payload.size());
+  return 0;
+}
+
+void AppendLength(std::vector<uint8_t>* out, size_t length, int length_size) {
+  for (int i = length_size - 1; i >= 0; i--) {
+    out->push_back(static_cast<uint8_t>(length >> (8 * i)));
+  }
+}
+
+} // namespace
+
+Napi::FunctionReference SmartCutter::constructor;
+
+Napi::Object SmartCutter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function func = DefineClass(env, "SmartCutter", {
+    InstanceMethod<&SmartCutter::CutAsync>("cut"),
+    InstanceMethod<&SmartCutter::CutSync>("cutSync"),
+    InstanceMethod<&SmartCutter::GetStats>("getStats"),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SmartCutter", func);
+  return exports;
+}
+
+SmartCutter::SmartCutter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<SmartCutter>(info) {}
+
+SmartCutter::~SmartCutter() {
+  Cleanup();
+}
+
+void SmartCutter::Count(uint64_t SmartCutStats::*field, uint64_t n) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats_.*field += n;
+}
+
+// === Cut ===
+
+int SmartCutter::CutInternal() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = SmartCutStats();
+  }
+
+  std::vector<bool> done;
+  int pending = 0;
+
+  int ret = avformat_open_input(&in_, input_url_.c_str(), nullptr, nullptr);
+  if (ret < 0) goto end;
+  ret = avformat_find_stream_info(in_, nullptr);
+  if (ret < 0) goto end;
+
+  {
+    // Times are relative to the start of the input
+    int64_t base = in_->start_time != AV_NOPTS_VALUE ? in_->start_time : 0;
+    start_us_ = base + llrint(start_ * AV_TIME_BASE);
+    end_us_ = end_ < 0 ? INT64_MAX : base + llrint(end_ * AV_TIME_BASE);
+  }
+
+  video_ = av_find_best_stream(in_, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+  if (video_ >= 0 && (in_->streams[video_]->disposition & AV_DISPOSITION_ATTACHED_PIC)) {
+    video_ = -1;
+  }
+  if (video_ >= 0) {
+    ret = ParseParameterSets(in_->streams[video_]->codecpar);
+    if (ret < 0) goto end;
+  }
+
+  ret = OpenOutput();
+  if (ret < 0) goto end;
+
+  if (video_ >= 0) {
+    start_ts_ = stream_start_[video_];
+    end_ts_ = stream_end_[video_];
+  }
+
+  packet_ = av_packet_alloc();
+  scratch_ = av_packet_alloc();
+  frame_ = av_frame_alloc();
+  if (!packet_ || !scratch_ || !frame_) {
+    ret = AVERROR(ENOMEM);
+    goto end;
+  }
+
+  // Land on the keyframe before the in point, the head GOP is re-encoded from there
+  if (start_ > 0) {
+    if (video_ >= 0) {
+      av_seek_frame(in_, video_, start_ts_, AVSEEK_FLAG_BACKWARD);
+    } else {
+      av_seek_frame(in_, -1, start_us_, AVSEEK_FLAG_BACKWARD);
+    }
+  }
+
+  // Reading stops once every audio/video stream is past the out point
+  done.assign(in_->nb_streams, false);
+  for (unsigned i = 0; i < in_->nb_streams; i++) {
+    AVMediaType type = in_->streams[i]->codecpar->codec_type;
+    if (stream_map_[i] >= 0 && (type == AVMEDIA_TYPE_AUDIO || type == AVMEDIA_TYPE_VIDEO)) {
+      pending++;
+    }
+  }
+
+  while (pending > 0) {
+    ret = av_read_frame(in_, packet_);
+    if (ret == AVERROR_EOF) break;
+    if (ret < 0) goto end;
+
+    int index = packet_->stream_index;
+    if (stream_map_[index] < 0 || done[index]) {
+      av_packet_unref(packet_);
+      continue;
+    }
+
+    if (packet_->pts == AV_NOPTS_VALUE) packet_->pts = packet_->dts;
+    if (packet_->dts == AV_NOPTS_VALUE) packet_->dts = packet_->pts;
+
+    if (index != video_) {
+      // Audio and subtitle packets are all keyframes, copy the ones inside the range
+      int64_t ts = packet_->pts;
+      if (ts != AV_NOPTS_VALUE && packet_->dts >= stream_end_[index]) {
+        done[index] = true;
+        if (in_->streams[index]->codecpar->codec_type == AVMEDIA_TYPE_AUDIO) pending--;
+        av_packet_unref(packet_);
+        continue;
+      }
+      if (ts == AV_NOPTS_VALUE || ts < stream_start_[index] || ts >= stream_end_[index]) {
+        av_packet_unref(packet_);
+        continue;
+      }
+      Count(&SmartCutStats::copied_packets);
+      Count(&SmartCutStats::copied_bytes, packet_->size);
+      ret = WritePacket(packet_);
+      if (ret < 0) goto end;
+      continue;
+    }
+
+    bool key = packet_->flags & AV_PKT_FLAG_KEY;
+    if (key && !gop_.packets.empty()) {
+      ret = FinishGop();
+      if (ret < 0) goto end;
+    }
+
+    // Packets after one decoded at the out point are all displayed after it
+    bool last = packet_->dts != AV_NOPTS_VALUE && packet_->dts >= end_ts_;
+    if (last) {
+      done[index] = true;
+      pending--;
+    }
+    if (packet_->pts == AV_NOPTS_VALUE && !gop_.packets.empty()) {
+      packet_->pts = gop_.max_pts;
+    }
+
+    // Nothing before the first keyframe decodes, a keyframe at the out point starts nothing
+    if ((gop_.packets.empty() && !key) || (last && key) || packet_->pts == AV_NOPTS_VALUE) {
+      av_packet_unref(packet_);
+      continue;
+    }
+
+    AVPacket* held = av_packet_alloc();
+    if (!held) {
+      ret = AVERROR(ENOMEM);
+      goto end;
+    }
+    av_packet_move_ref(held, packet_);
+    gop_.packets.push_back(held);
+
+    if (key) {
+      gop_.key_pts = held->pts;
+      if (held->dts != AV_NOPTS_VALUE && delay_ == 0) {
+        delay_ = std::max<int64_t>(0, held->pts - held->dts);
+      }
+    } else if (held->pts < gop_.key_pts) {
+      gop_.leading_max_pts = std::max(gop_.leading_max_pts, held->pts);
+    }
+    gop_.min_pts = std::min(gop_.min_pts, held->pts);
+    gop_.max_pts = std::max(gop_.max_pts, held->pts);
+
+    if (last) {
+      ret = FinishGop();
+      if (ret < 0) goto end;
+    }
+  }
+
+  if (!gop_.packets.empty()) {
+    ret = FinishGop();
+    if (ret < 0) goto end;
+  }
+  ret = CloseEncoder();
+  if (ret < 0) goto end;
+
+  ret = av_write_trailer(out_);
+
+end:
+  Cleanup();
+  busy_ = false;
+  return ret < 0 ? ret : 0;
+}
+
+int SmartCutter::OpenOutput() {
+  int ret = avformat_alloc_output_context2(&out_, nullptr, format_.empty() ? nullptr : format_.c_str(), output_url_.c_str());
+  if (ret < 0) {
+    return ret;
+  }
+
+  stream_map_.assign(in_->nb_streams, -1);
+  stream_start_.assign(in_->nb_streams, 0);
+  stream_end_.assign(in_->nb_streams, INT64_MAX);
+
+  for (unsigned i = 0; i < in_->nb_streams; i++) {
+    AVStream* st = in_->streams[i];
+    AVMediaType type = st->codecpar->codec_type;
+
+    // Only one video stream can be cut frame-accurately
+    bool keep = type == AVMEDIA_TYPE_AUDIO || type == AVMEDIA_TYPE_SUBTITLE || static_cast<int>(i) == video_;
+    if (!keep || avformat_query_codec(out_->oformat, st->codecpar->codec_id, FF_COMPLIANCE_NORMAL) == 0) {
+      continue;
+    }
+
+    AVStream* os = avformat_new_stream(out_, nullptr);
+    if (!os) {
+      return AVERROR(ENOMEM);
+    }
+    ret = avcodec_parameters_copy(os->codecpar, st->codecpar);
+    if (ret < 0) {
+      return ret;
+    }
+    // Let the muxer pick the tag, in-band parameter sets need hev1/avc1 rather than hvc1
+    os->codecpar->codec_tag = 0;
+    os->time_base = st->time_base;
+    os->sample_aspect_ratio = st->sample_aspect_ratio;
+    os->disposition = st->disposition;
+    av_dict_copy(&os->metadata, st->metadata, 0);
+
+    stream_map_[i] = os->index;
+    stream_start_[i] = av_rescale_q(start_us_, AV_TIME_BASE_Q, st->time_base);
+    if (end_us_ != INT64_MAX) {
+      stream_end_[i] = av_rescale_q(end_us_, AV_TIME_BASE_Q, st->time_base);
+    }
+  }
+
+  if (out_->nb_streams == 0) {
+    return AVERROR_STREAM_NOT_FOUND;
+  }
+  av_dict_copy(&out_->metadata, in_->metadata, 0);
+
+  if (!(out_->oformat->flags & AVFMT_NOFILE)) {
+    ret = avio_open(&out_->pb, output_url_.c_str(), AVIO_FLAG_WRITE);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return avformat_write_header(out_, nullptr);
+}
+
+int SmartCutter::ParseParameterSets(const AVCodecParameters* par) {
+  parameter_sets_.clear();
+  nal_length_size_ = 0;
+
+  // Only NAL-based codecs keep parameter sets outside of the keyframes
+  if (par->codec_id != AV_CODEC_ID_H264 && par->codec_id != AV_CODEC_ID_HEVC) {
+    return 0;
+  }
+
+  const uint8_t* data = par->extradata;
+  size_t size = par->extradata_size;
+  if (!data || size == 0) {
+    return 0;
+  }
+
+  if (IsAnnexB(data, size)) {
+    std::vector<NalUnit> nals;
+    SplitAnnexB(data, size, &nals);
+    for (const NalUnit& nal : nals) {
+      parameter_sets_.emplace_back(nal.first, nal.first + nal.second);
+    }
+    return 0;
+  }
+
+  size_t pos = 0;
+  auto take = [&](size_t n) -> const uint8_t* {
+    if (size - pos < n) return nullptr;
+    const uint8_t* p = data + pos;
+    pos += n;
+    return p;
+  };
+  auto nal = [&]() -> bool {
+    const uint8_t* p = take(2);
+    if (!p) return false;
+    size_t length = (p[0] << 8) | p[1];
+    const uint8_t* unit = take(length);
+    if (!unit) return false;
+    parameter_sets_.emplace_back(unit, unit + length);
+    return true;
+  };
+
+  if (par->codec_id == AV_CODEC_ID_H264) {
+    // avcC: version, profile, compatibility, level, length size, SPS list, PPS list
+    const uint8_t* p = take(6);
+    if (!p) return AVERROR_INVALIDDATA;
+    nal_length_size_ = (p[4] & 3) + 1;
+    for (int i = 0, count = p[5] & 0x1f; i < count; i++) {
+      if (!nal()) return AVERROR_INVALIDDATA;
+    }
+    p = take(1);
+    if (!p) return AVERROR_INVALIDDATA;
+    for (int i = 0, count = p[0]; i < count; i++) {
+      if (!nal()) return AVERROR_INVALIDDATA;
+    }
+  } else {
+    // hvcC: 22 byte header, then arrays of VPS/SPS/PPS/SEI units
+    const uint8_t* p = take(23);
+    if (!p) return AVERROR_INVALIDDATA;
+    nal_length_size_ = (p[21] & 3) + 1;
+    for (int i = 0, arrays = p[22]; i < arrays; i++) {
+      const uint8_t* header = take(3);
+      if (!header) return AVERROR_INVALIDDATA;
+      for (int j = 0, count = (header[1] << 8) | header[2]; j < count; j++) {
+        if (!nal()) return AVERROR_INVALIDDATA;
+      }
+    }
+  }
+
+  return 0;
+}
+
+// === GOPs ===
+
+int SmartCutter::FinishGop() {
+  Gop& gop = gop_;
+  bool copied = false;
+  int ret = 0;
+
+  if (gop.max_pts < start_ts_ || gop.min_pts >= end_ts_) {
+    // Entirely outside of the range
+  } else if (gop.key_pts >= start_ts_ && gop.max_pts < end_ts_ &&
+             (gop.leading_max_pts == INT64_MIN || previous_copied_ || gop.leading_max_pts < start_ts_)) {
+    // Leading pictures either reference copied frames or are dropped with the in point
+    ret = CopyGop();
+    copied = true;
+  } else {
+    ret = EncodeGop();
+  }
+
+  ClearGop(&previous_);
+  std::swap(previous_, gop_);
+  previous_copied_ = copied;
+  return ret;
+}
+
+int SmartCutter::CopyGop() {
+  // The re-encoded run before this GOP must be complete first
+  int ret = CloseEncoder();
+  if (ret < 0) {
+    return ret;
+  }
+
+  bool first = true;
+  for (AVPacket* pkt : gop_.packets) {
+    if (pkt->pts < start_ts_) {
+      continue;
+    }
+
+    // Keep the GOP intact, it may prime the decoder for the next one
+    ret = av_packet_ref(scratch_, pkt);
+    if (ret < 0) {
+      return ret;
+    }
+    if (first && resume_) {
+      // Back to the source parameter sets after in-band ones of the encoder
+      ret = PrependParameterSets(scratch_);
+      if (ret < 0) {
+        av_packet_unref(scratch_);
+        return ret;
+      }
+      resume_ = false;
+    }
+    first = false;
+
+    Count(&SmartCutStats::copied_packets);
+    Count(&SmartCutStats::copied_bytes, scratch_->size);
+    ret = WriteVideo(scratch_, false);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  Count(&SmartCutStats::copied_gops);
+  return 0;
+}
+
+int SmartCutter::EncodeGop() {
+  int ret;
+  AVStream* st = in_->streams[video_];
+
+  if (!decoder_) {
+    const AVCodec* codec = avcodec_find_decoder(st->codecpar->codec_id);
+    if (!codec) {
+      return AVERROR_DECODER_NOT_FOUND;
+    }
+    decoder_ = avcodec_alloc_context3(codec);
+    if (!decoder_) {
+      return AVERROR(ENOMEM);
+    }
+    ret = avcodec_parameters_to_context(decoder_, st->codecpar);
+    if (ret < 0) {
+      return ret;
+    }
+    decoder_->pkt_timebase = st->time_base;
+    decoder_->thread_count = 0;
+    ret = avcodec_open2(decoder_, codec, nullptr);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  // Frames of this GOP inside the range, in presentation order
+  std::vector<int64_t> wanted;
+  for (AVPacket* pkt : gop_.packets) {
+    if (pkt->pts >= start_ts_ && pkt->pts < end_ts_) {
+      wanted.push_back(pkt->pts);
+    }
+  }
+  std::sort(wanted.begin(), wanted.end());
+
+  // Leading pictures reference the previous GOP
+  std::vector<AVPacket*> input;
+  if (gop_.leading_max_pts != INT64_MIN) {
+    input = previous_.packets;
+  }
+  input.insert(input.end(), gop_.packets.begin(), gop_.packets.end());
+  input.push_back(nullptr);
+
+  for (AVPacket* pkt : input) {
+    ret = avcodec_send_packet(decoder_, pkt);
+    if (ret < 0 && ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+      // Corrupt packet, the frames that decode are still cut
+      ret = 0;
+    }
+
+    while (avcodec_receive_frame(decoder_, frame_) >= 0) {
+      Count(&SmartCutStats::decoded_frames);
+      frame_->pts = frame_->best_effort_timestamp;
+      if (!std::binary_search(wanted.begin(), wanted.end(), frame_->pts)) {
+        av_frame_unref(frame_);
+        continue;
+      }
+
+      if (!encoder_ctx_) {
+        ret = OpenEncoder(frame_);
+        if (ret < 0) {
+          av_frame_unref(frame_);
+          return ret;
+        }
+      }
+
+      frame_->pict_type = AV_PICTURE_TYPE_NONE;
+      ret = avcodec_send_frame(encoder_ctx_, frame_);
+      av_frame_unref(frame_);
+      if (ret < 0) {
+        return ret;
+      }
+      ret = DrainEncoder(false);
+      if (ret < 0) {
+        return ret;
+      }
+    }
+  }
+  avcodec_flush_buffers(decoder_);
+
+  resume_ = !parameter_sets_.empty();
+  Count(&SmartCutStats::encoded_gops);
+  return 0;
+}
+
+// === Encoder ===
+
+int SmartCutter::OpenEncoder(const AVFrame* frame) {
+  AVStream* st = in_->streams[video_];
+  const AVCodecParameters* par = st->codecpar;
+
+  const AVCodec* codec = encoder_.empty() ? avcodec_find_encoder(par->codec_id) : avcodec_find_encoder_by_name(encoder_.c_str());
+  if (!codec) {
+    return AVERROR_ENCODER_NOT_FOUND;
+  }
+  if (codec->id != par->codec_id) {
+    return AVERROR(EINVAL);
+  }
+
+  encoder_ctx_ = avcodec_alloc_context3(codec);
+  if (!encoder_ctx_) {
+    return AVERROR(ENOMEM);
+  }
+
+  // Match the source so the re-encoded edges decode like the copied middle
+  AVCodecContext* enc = encoder_ctx_;
+  enc->width = frame->width;
+  enc->height = frame->height;
+  enc->pix_fmt = static_cast<AVPixelFormat>(frame->format);
+  enc->sample_aspect_ratio = frame->sample_aspect_ratio.num > 0 ? frame->sample_aspect_ratio : par->sample_aspect_ratio;
+  enc->color_range = frame->color_range;
+  enc->color_primaries = frame->color_primaries;
+  enc->color_trc = frame->color_trc;
+  enc->colorspace = frame->colorspace;
+  enc->chroma_sample_location = frame->chroma_location;
+  enc->field_order = par->field_order;
+  enc->time_base = st->time_base;
+  enc->framerate = av_guess_frame_rate(in_, st, nullptr);
+  enc->profile = par->profile;
+  enc->level = par->level;
+  if (par->bit_rate > 0) {
+    enc->bit_rate = par->bit_rate;
+  }
+  // No reordering: dts follows pts, offset by the source delay (see WriteVideo)
+  enc->max_b_frames = 0;
+  enc->thread_count = 0;
+  // No global header: parameter sets go in-band, the output keeps the source extradata
+
+  AVDictionary* options = nullptr;
+  for (const auto& [key, value] : encoder_options_) {
+    av_dict_set(&options, key.c_str(), value.c_str(), 0);
+  }
+  int ret = avcodec_open2(enc, codec, &options);
+  av_dict_free(&options);
+  if (ret < 0) {
+    avcodec_free_context(&encoder_ctx_);
+  }
+  return ret;
+}
+
+int SmartCutter::DrainEncoder(bool flush) {
+  int ret;
+  if (flush) {
+    ret = avcodec_send_frame(encoder_ctx_, nullptr);
+    if (ret < 0 && ret != AVERROR_EOF) {
+      return ret;
+    }
+  }
+
+  while ((ret = avcodec_receive_packet(encoder_ctx_, scratch_)) >= 0) {
+    Count(&SmartCutStats::encoded_frames);
+    scratch_->stream_index = video_;
+    if (nal_length_size_ > 0) {
+      ret = ToLengthPrefixed(scratch_);
+      if (ret < 0) {
+        av_packet_unref(scratch_);
+        return ret;
+      }
+    }
+    ret = WriteVideo(scratch_, true);
+    if (ret < 0) {
+      return ret;
+    }
+  }
+
+  return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF ? 0 : ret;
+}
+
+int SmartCutter::CloseEncoder() {
+  if (!encoder_ctx_) {
+    return 0;
+  }
+  int ret = DrainEncoder(true);
+  avcodec_free_context(&encoder_ctx_);
+  return ret;
+}
+
+// === Output ===
+
+int SmartCutter::WriteVideo(AVPacket* pkt, bool encoded) {
+  if (encoded) {
+    pkt->dts = pkt->pts - delay_;
+  }
+  // Stitch: decode order stays strictly increasing across copied and encoded runs
+  if (last_dts_ != AV_NOPTS_VALUE && pkt->dts <= last_dts_) {
+    pkt->dts = last_dts_ + 1;
+  }
+  last_dts_ = pkt->dts;
+  return WritePacket(pkt);
+}
+
+int SmartCutter::WritePacket(AVPacket* pkt) {
+  int index = pkt->stream_index;
+  AVStream* st = in_->streams[index];
+  AVStream* os = out_->streams[stream_map_[index]];
+
+  // Output starts at the in point
+  if (pkt->pts != AV_NOPTS_VALUE) pkt->pts -= stream_start_[index];
+  if (pkt->dts != AV_NOPTS_VALUE) pkt->dts -= stream_start_[index];
+  pkt->stream_index = os->index;
+  pkt->pos = -1;
+  av_packet_rescale_ts(pkt, st->time_base, os->time_base);
+
+  return av_interleaved_write_frame(out_, pkt);
+}
+
+int SmartCutter::ToLengthPrefixed(AVPacket* pkt) {
+  if (!IsAnnexB(pkt->data, pkt->size)) {
+    return 0;
+  }
+
+  std::vector<NalUnit> nals;
+  SplitAnnexB(pkt->data, pkt->size, &nals);
+
+  std::vector<uint8_t> payload;
+  payload.reserve(pkt->size + nals.size() * nal_length_size_);
+  for (const NalUnit& nal : nals) {
+    AppendLength(&payload, nal.second, nal_length_size_);
+    payload.insert(payload.end(), nal.first, nal.first + nal.second);
+  }
+  return ReplacePayload(pkt, payload);
+}
+
+int SmartCutter::PrependParameterSets(AVPacket* pkt) {
+  std::vector<uint8_t> payload;
+  for (const std::vector<uint8_t>& nal : parameter_sets_) {
+    if (nal_length_size_ > 0) {
+      AppendLength(&payload, nal.size(), nal_length_size_);
+    } else {
+      static const uint8_t start_code[] = { 0, 0, 0, 1 };
+      payload.insert(payload.end(), start_code, start_code + sizeof(start_code));
+    }
+    payload.insert(payload.end(), nal.begin(), nal.end());
+  }
+  payload.insert(payload.end(), pkt->data, pkt->data + pkt->size);
+  return ReplacePayload(pkt, payload);
+}
+
+void SmartCutter::ClearGop(Gop* gop) {
+  for (AVPacket*& pkt : gop->packets) {
+    av_packet_free(&pkt);
+  }
+  *gop = Gop();
+}
+
+void SmartCutter::Cleanup() {
+  ClearGop(&gop_);
+  ClearGop(&previous_);
+  avcodec_free_context(&decoder_);
+  avcodec_free_context(&encoder_ctx_);
+  av_frame_free(&frame_);
+  av_packet_free(&packet_);
+  av_packet_free(&scratch_);
+  avformat_close_input(&in_);
+  if (out_) {
+    if (out_->pb && !(out_->oformat->flags & AVFMT_NOFILE)) {
+      avio_closep(&out_->pb);
+    }
+    avformat_free_context(out_);
+    out_ = nullptr;
+  }
+
+  stream_map_.clear();
+  stream_start_.clear();
+  stream_end_.clear();
+  parameter_sets_.clear();
+  nal_length_size_ = 0;
+  video_ = -1;
+  start_ts_ = 0;
+  end_ts_ = INT64_MAX;
+  delay_ = 0;
+  last_dts_ = AV_NOPTS_VALUE;
+  previous_copied_ = false;
+  resume_ = false;
+}
+
+bool SmartCutter::PrepareCut(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 2 || !info[0].IsString() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "Expected (input, output[, options])").ThrowAsJavaScriptException();
+    return false;
+  }
+  if (busy_.exchange(true)) {
+    Napi::Error::New(env, "A cut is already running").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  input_url_ = info[0].As<Napi::String>().Utf8Value();
+  output_url_ = info[1].As<Napi::String>().Utf8Value();
+  format_.clear();
+  encoder_.clear();
+  encoder_options_.clear();
+  start_ = 0;
+  end_ = -1;
+
+  if (info.Length() > 2 && info[2].IsObject()) {
+    Napi::Object options = info[2].As<Napi::Object>();
+    if (options.Get("start").IsNumber()) {
+      start_ = std::max(0.0, options.Get("start").As<Napi::Number>().DoubleValue());
+    }
+    if (options.Get("end").IsNumber()) {
+      end_ = options.Get("end").As<Napi::Number>().DoubleValue();
+    }
+    if (options.Get("format").IsString()) {
+      format_ = options.Get("format").As<Napi::String>().Utf8Value();
+    }
+    if (options.Get("encoder").IsString()) {
+      encoder_ = options.Get("encoder").As<Napi::String>().Utf8Value();
+    }
+    if (options.Get("encoderOptions").IsObject()) {
+      Napi::Object dict = options.Get("encoderOptions").As<Napi::Object>();
+      Napi::Array keys = dict.GetPropertyNames();
+      for (uint32_t i = 0; i < keys.Length(); i++) {
+        std::string key = keys.Get(i).ToString().Utf8Value();
+        encoder_options_[key] = dict.Get(key).ToString().Utf8Value();
+      }
+    }
+  }
+
+  return true;
+}
+
+// === Properties ===
+
+Napi::Value SmartCutter::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("copiedPackets", Napi::Number::New(env, static_cast<double>(stats_.copied_packets)));
+  result.Set("copiedBytes", Napi::Number::New(env, static_cast<double>(stats_.copied_bytes)));
+  result.Set("copiedGops", Napi::Number::New(env, static_cast<double>(stats_.copied_gops)));
+  result.Set("encodedGops", Napi::Number::New(env, static_cast<double>(stats_.encoded_gops)));
+  result.Set("decodedFrames", Napi::Number::New(env, static_cast<double>(stats_.decoded_frames)));
+  result.Set("encodedFrames", Napi::Number::New(env, static_cast<double>(stats_.encoded_frames)));
+  return result;
+}
+
+} // namespace ffmpeg
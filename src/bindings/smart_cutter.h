@@ -0,0 +1,126 @@
+#ifndef FFMPEG_SMART_CUTTER_H
+#define FFMPEG_SMART_CUTTER_H
+
+#include <napi.h>
+#include "common.h"
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+}
+
+namespace ffmpeg {
+
+struct SmartCutStats {
+  uint64_t copied_packets = 0;    // Packets stream-copied (all streams)
+  uint64_t copied_bytes = 0;      // Payload bytes stream-copied
+  uint64_t copied_gops = 0;       // Video GOPs stream-copied
+  uint64_t encoded_gops = 0;      // Video GOPs decoded and re-encoded
+  uint64_t decoded_frames = 0;    // Video frames decoded for re-encoding
+  uint64_t encoded_frames = 0;    // Video frames re-encoded
+};
+
+/**
+ * Frame-accurate trimming that only re-encodes the GOPs at the cut points.
+ *
+ * Seeks to the keyframe before the in point and groups video packets into
+ * GOPs (keyframe to keyframe, decode order). GOPs entirely inside the range
+ * are stream-copied; GOPs crossing the in or out point are decoded and the
+ * frames inside the range re-encoded with the source codec, size, profile,
+ * level, colors and bit rate. Re-encoded runs carry their parameter sets
+ * in-band and the source parameter sets are repeated on the next copied
+ * keyframe, so the output keeps the source extradata. Other audio and video
+ * streams are stream-copied at packet granularity.
+ */
+class SmartCutter : public Napi::ObjectWrap<SmartCutter> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  SmartCutter(const Napi::CallbackInfo& info);
+  ~SmartCutter();
+
+private:
+  friend class SCCutWorker;
+
+  static Napi::FunctionReference constructor;
+
+  // Video packets from one keyframe to the next
+  struct Gop {
+    std::vector<AVPacket*> packets;
+    int64_t key_pts = AV_NOPTS_VALUE;
+    int64_t min_pts = INT64_MAX;
+    int64_t max_pts = INT64_MIN;
+    int64_t leading_max_pts = INT64_MIN;  // Packets displayed before the keyframe (open GOP)
+  };
+
+  // Cut arguments
+  std::string input_url_;
+  std::string output_url_;
+  std::string format_;
+  std::string encoder_;
+  std::map<std::string, std::string> encoder_options_;
+  double start_ = 0;
+  double end_ = -1;
+
+  // Cut state (worker thread)
+  std::atomic<bool> busy_{false};
+  AVFormatContext* in_ = nullptr;
+  AVFormatContext* out_ = nullptr;
+  std::vector<int> stream_map_;
+  std::vector<int64_t> stream_start_;  // In point per input stream time base
+  std::vector<int64_t> stream_end_;    // Out point per input stream time base
+  int64_t start_us_ = 0;
+  int64_t end_us_ = INT64_MAX;
+  int video_ = -1;
+  int64_t start_ts_ = 0;          // In point in the video time base
+  int64_t end_ts_ = INT64_MAX;    // Out point in the video time base
+  int64_t delay_ = 0;             // Source pts - dts of keyframes
+  int64_t last_dts_ = AV_NOPTS_VALUE;
+  AVCodecContext* decoder_ = nullptr;
+  AVCodecContext* encoder_ctx_ = nullptr;
+  AVFrame* frame_ = nullptr;
+  AVPacket* packet_ = nullptr;
+  AVPacket* scratch_ = nullptr;
+  Gop gop_;
+  Gop previous_;
+  bool previous_copied_ = false;
+  bool resume_ = false;           // Next copied keyframe needs the source parameter sets
+  int nal_length_size_ = 0;       // Length prefix size of avcC/hvcC sources, 0 for Annex B
+  std::vector<std::vector<uint8_t>> parameter_sets_;
+
+  SmartCutStats stats_;
+  std::mutex mutex_;
+
+  void Count(uint64_t SmartCutStats::*field, uint64_t n = 1);
+  int CutInternal();
+  int OpenOutput();
+  int ParseParameterSets(const AVCodecParameters* par);
+  int FinishGop();
+  int CopyGop();
+  int EncodeGop();
+  int OpenEncoder(const AVFrame* frame);
+  int DrainEncoder(bool flush);
+  int CloseEncoder();
+  int WriteVideo(AVPacket* pkt, bool encoded);
+  int WritePacket(AVPacket* pkt);
+  int ToLengthPrefixed(AVPacket* pkt);
+  int PrependParameterSets(AVPacket* pkt);
+  void ClearGop(Gop* gop);
+  void Cleanup();
+
+  bool PrepareCut(const Napi::CallbackInfo& info);
+
+  Napi::Value CutAsync(const Napi::CallbackInfo& info);
+  Napi::Value CutSync(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+};
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_SMART_CUTTER_H
@@ -0,0 +1,58 @@
+#include "smart_cutter.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+// ============================================================================
+// Async Worker Classes
+// ============================================================================
+
+class SCCutWorker : public Napi::AsyncWorker {
+public:
+  SCCutWorker(Napi::Env env, SmartCutter* cutter)
+    : Napi::AsyncWorker(env),
+      cutter_(cutter),
+      ret_(0),
+      deferred_(Napi::Promise::Deferred::New(env)) {}
+
+  void Execute() override {
+    ret_ = cutter_->CutInternal();
+  }
+
+  void OnOK() override {
+    deferred_.Resolve(Napi::Number::New(Env(), ret_));
+  }
+
+  void OnError(const Napi::Error& e) override {
+    deferred_.Reject(e.Value());
+  }
+
+  Napi::Promise GetPromise() {
+    return deferred_.Promise();
+  }
+
+private:
+  SmartCutter* cutter_;
+  int ret_;
+  Napi::Promise::Deferred deferred_;
+};
+
+// ============================================================================
+// Async Method Implementations
+// ============================================================================
+
+Napi::Value SmartCutter::CutAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareCut(info)) {
+    return env.Undefined();
+  }
+
+  auto* worker = new SCCutWorker(env, this);
+  auto promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+} // namespace ffmpeg
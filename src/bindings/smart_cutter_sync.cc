@@ -0,0 +1,16 @@
+#include "smart_cutter.h"
+#include <napi.h>
+
+namespace ffmpeg {
+
+Napi::Value SmartCutter::CutSync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!PrepareCut(info)) {
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, CutInternal());
+}
+
+} // namespace ffmpeg
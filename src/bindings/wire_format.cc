@@ -0,0 +1,113 @@
+#include "wire_format.h"
+
+#include <cstring>
+
+namespace ffmpeg {
+
+void EncodeCodecParameters(WireEncoder* e, const AVCodecParameters* par) {
+  e->I32(par->codec_type);
+  e->I32(par->codec_id);
+  e->U32(par->codec_tag);
+  e->I32(par->format);
+  e->I64(par->bit_rate);
+  e->I32(par->bits_per_coded_sample);
+  e->I32(par->bits_per_raw_sample);
+  e->I32(par->profile);
+  e->I32(par->level);
+  e->I32(par->width);
+  e->I32(par->height);
+  e->Rational(par->sample_aspect_ratio);
+  e->Rational(par->framerate);
+  e->I32(par->field_order);
+  e->I32(par->color_range);
+  e->I32(par->color_primaries);
+  e->I32(par->color_trc);
+  e->I32(par->color_space);
+  e->I32(par->chroma_location);
+  e->I32(par->video_delay);
+  // Custom channel orders are stored as unspecified with the channel count
+  bool native = par->ch_layout.order == AV_CHANNEL_ORDER_NATIVE;
+  e->I32(native ? par->ch_layout.order : AV_CHANNEL_ORDER_UNSPEC);
+  e->I32(par->ch_layout.nb_channels);
+  e->U64(native ? par->ch_layout.u.mask : 0);
+  e->I32(par->sample_rate);
+  e->I32(par->block_align);
+  e->I32(par->frame_size);
+  e->I32(par->initial_padding);
+  e->I32(par->trailing_padding);
+  e->I32(par->seek_preroll);
+  e->Bytes(par->extradata, par->extradata ? par->extradata_size : 0);
+
+  e->U32(static_cast<uint32_t>(par->nb_coded_side_data));
+  for (int i = 0; i < par->nb_coded_side_data; i++) {
+    e->I32(par->coded_side_data[i].type);
+    e->Bytes(par->coded_side_data[i].data, par->coded_side_data[i].size);
+  }
+}
+
+int DecodeCodecParameters(WireDecoder* d, AVCodecParameters* par) {
+  par->codec_type = static_cast<AVMediaType>(d->I32());
+  par->codec_id = static_cast<AVCodecID>(d->I32());
+  par->codec_tag = d->U32();
+  par->format = d->I32();
+  par->bit_rate = d->I64();
+  par->bits_per_coded_sample = d->I32();
+  par->bits_per_raw_sample = d->I32();
+  par->profile = d->I32();
+  par->level = d->I32();
+  par->width = d->I32();
+  par->height = d->I32();
+  par->sample_aspect_ratio = d->Rational();
+  par->framerate = d->Rational();
+  par->field_order = static_cast<AVFieldOrder>(d->I32());
+  par->color_range = static_cast<AVColorRange>(d->I32());
+  par->color_primaries = static_cast<AVColorPrimaries>(d->I32());
+  par->color_trc = static_cast<AVColorTransferCharacteristic>(d->I32());
+  par->color_space = static_cast<AVColorSpace>(d->I32());
+  par->chroma_location = static_cast<AVChromaLocation>(d->I32());
+  par->video_delay = d->I32();
+  int order = d->I32();
+  int channels = d->I32();
+  uint64_t mask = d->U64();
+  if (order == AV_CHANNEL_ORDER_NATIVE && mask) {
+    av_channel_layout_from_mask(&par->ch_layout, mask);
+  } else if (channels > 0) {
+    par->ch_layout.order = AV_CHANNEL_ORDER_UNSPEC;
+    par->ch_layout.nb_channels = channels;
+  }
+  par->sample_rate = d->I32();
+  par->block_align = d->I32();
+  par->frame_size = d->I32();
+  par->initial_padding = d->I32();
+  par->trailing_padding = d->I32();
+  par->seek_preroll = d->I32();
+
+  uint32_t size = 0;
+  const uint8_t* extradata = d->Bytes(&size);
+  if (extradata && size > 0) {
+    par->extradata = static_cast<uint8_t*>(av_mallocz(size + AV_INPUT_BUFFER_PADDING_SIZE));
+    if (!par->extradata) {
+      return AVERROR(ENOMEM);
+    }
+    memcpy(par->extradata, extradata, size);
+    par->extradata_size = static_cast<int>(size);
+  }
+
+  uint32_t count = d->U32();
+  for (uint32_t i = 0; i < count && d->ok(); i++) {
+    AVPacketSideDataType type = static_cast<AVPacketSideDataType>(d->I32());
+    const uint8_t* data = d->Bytes(&size);
+    if (!data) {
+      break;
+    }
+    AVPacketSideData* sd = av_packet_side_data_new(&par->coded_side_data, &par->nb_coded_side_data, type, size, 0);
+    if (!sd) {
+      return AVERROR(ENOMEM);
+    }
+    memcpy(sd->data, data, size);
+  }
+
+  return d->ok() ? 0 : AVERROR_INVALIDDATA;
+}
+
+} // namespace ffmpeg
@@ -0,0 +1,91 @@
+#ifndef FFMPEG_WIRE_FORMAT_H
+#define FFMPEG_WIRE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+}
+
+namespace ffmpeg {
+
+/**
+ * Little-endian encoder for records leaving the process (trace files,
+ * shared-memory channels).
+ */
+class WireEncoder {
+public:
+  explicit WireEncoder(std::vector<uint8_t>* out) : out_(out) { out_->clear(); }
+
+  void U8(uint8_t v) { out_->push_back(v); }
+  void U32(uint32_t v) { for (int i = 0; i < 4; i++) out_->push_back(static_cast<uint8_t>(v >> (8 * i))); }
+  void U64(uint64_t v) { for (int i = 0; i < 8; i++) out_->push_back(static_cast<uint8_t>(v >> (8 * i))); }
+  void I32(int32_t v) { U32(static_cast<uint32_t>(v)); }
+  void I64(int64_t v) { U64(static_cast<uint64_t>(v)); }
+  void Rational(AVRational q) { I32(q.num); I32(q.den); }
+  void Bytes(const uint8_t* data, size_t size) {
+    U32(static_cast<uint32_t>(size));
+    if (size > 0) {
+      out_->insert(out_->end(), data, data + size);
+    }
+  }
+
+private:
+  std::vector<uint8_t>* out_;
+};
+
+// Bounds-checked decoder, ok() turns false on overrun
+class WireDecoder {
+public:
+  WireDecoder(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  bool ok() const { return ok_; }
+
+  uint8_t U8() { const uint8_t* p = Take(1); return p ? p[0] : 0; }
+  uint32_t U32() {
+    const uint8_t* p = Take(4);
+    uint32_t v = 0;
+    for (int i = 0; p && i < 4; i++) v |= static_cast<uint32_t>(p[i]) << (8 * i);
+    return v;
+  }
+  uint64_t U64() {
+    const uint8_t* p = Take(8);
+    uint64_t v = 0;
+    for (int i = 0; p && i < 8; i++) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+    return v;
+  }
+  int32_t I32() { return static_cast<int32_t>(U32()); }
+  int64_t I64() { return static_cast<int64_t>(U64()); }
+  AVRational Rational() { AVRational q; q.num = I32(); q.den = I32(); return q; }
+  const uint8_t* Bytes(uint32_t* size) {
+    *size = U32();
+    return Take(*size);
+  }
+
+private:
+  const uint8_t* Take(size_t n) {
+    if (!ok_ || size_ - pos_ < n) {
+      ok_ = false;
+      return nullptr;
+    }
+    const uint8_t* p = data_ + pos_;
+    pos_ += n;
+    return p;
+  }
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  bool ok_ = true;
+};
+
+// Codec parameters including extradata and coded side data
+void EncodeCodecParameters(WireEncoder* e, const AVCodecParameters* par);
+// Fills freshly allocated parameters, AVERROR_INVALIDDATA on truncated input
+int DecodeCodecParameters(WireDecoder* d, AVCodecParameters* par);
+
+} // namespace ffmpeg
+
+#endif // FFMPEG_WIRE_FORMAT_H
@@ -2131,6 +2131,7 @@ export {
   AVERROR_ENOENT,
   AVERROR_ENOMEM,
   AVERROR_ENOSPC,
+  AVERROR_ENOSYS,
   AVERROR_ENOTDIR,
   AVERROR_EPERM,
   AVERROR_EPIPE,
@@ -23,6 +23,9 @@ import type {
   NativeCodecContext,
   NativeCodecParameters,
   NativeCodecParser,
+  NativeColorTransform,
+  NativeConcatInput,
+  NativeDemuxDispatcher,
   NativeDictionary,
   NativeFFmpegError,
   NativeFilter,
@@ -31,14 +34,27 @@ import type {
   NativeFilterInOut,
   NativeFormatContext,
   NativeFrame,
+  NativeFrameArena,
+  NativeFrameCache,
+  NativeFrameScheduler,
   NativeHardwareDeviceContext,
   NativeHardwareFramesContext,
+  NativeImageSequenceWriter,
   NativeInputFormat,
   NativeIOContext,
   NativeLog,
+  NativeLogoOverlay,
+  NativeMediaHasher,
   NativeOption,
   NativeOutputFormat,
   NativePacket,
+  NativePacketAllocator,
+  NativePacketRecorder,
+  NativePacketRouter,
+  NativeSceneAnalyzer,
+  NativeSharedMemoryChannel,
+  NativeSmartCutter,
+  NativeParallelDecoder,
   NativeSoftwareResampleContext,
   NativeSoftwareScaleContext,
   NativeStream,
@@ -88,6 +104,8 @@ interface NativeOutputFormatConstructor {
 
 type NativeIOContextConstructor = new () => NativeIOContext;
 
+type NativeConcatInputConstructor = new () => NativeConcatInput;
+
 type NativeDictionaryConstructor = new () => NativeDictionary;
 
 // Error handling
@@ -122,6 +140,27 @@ type NativeBitStreamFilterContextConstructor = new () => NativeBitStreamFilterCo
 type NativeAudioFifoConstructor = new () => NativeAudioFifo;
 type NativeSoftwareScaleContextConstructor = new () => NativeSoftwareScaleContext;
 type NativeSoftwareResampleContextConstructor = new () => NativeSoftwareResampleContext;
+type NativeDemuxDispatcherConstructor = new () => NativeDemuxDispatcher;
+type NativeFrameCacheConstructor = new () => NativeFrameCache;
+type NativeMediaHasherConstructor = new () => NativeMediaHasher;
+type NativeFrameArenaConstructor = new () => NativeFrameArena;
+type NativePacketAllocatorConstructor = new () => NativePacketAllocator;
+type NativePacketRecorderConstructor = new () => NativePacketRecorder;
+type NativeFrameSchedulerConstructor = new () => NativeFrameScheduler;
+type NativePacketRouterConstructor = new () => NativePacketRouter;
+type NativeSharedMemoryChannelConstructor = new () => NativeSharedMemoryChannel;
+type NativeSmartCutterConstructor = new () => NativeSmartCutter;
+type NativeSceneAnalyzerConstructor = new () => NativeSceneAnalyzer;
+interface NativeColorTransformConstructor {
+  new (): NativeColorTransform;
+  clearCache(): void;
+}
+type NativeLogoOverlayConstructor = new () => NativeLogoOverlay;
+type NativeImageSequenceWriterConstructor = new () => NativeImageSequenceWriter;
+interface NativeParallelDecoderConstructor {
+  new (): NativeParallelDecoder;
+  isSupported(codecId: AVCodecID): boolean;
+}
 
 // Hardware
 interface NativeHardwareDeviceContextConstructor {
@@ -202,6 +241,7 @@ export interface NativeBinding {
   InputFormat: NativeInputFormatConstructor;
   OutputFormat: NativeOutputFormatConstructor;
   IOContext: NativeIOContextConstructor;
+  ConcatInput: NativeConcatInputConstructor;
 
   // Filter System
   Filter: NativeFilterConstructor;
@@ -217,6 +257,21 @@ export interface NativeBinding {
   AudioFifo: NativeAudioFifoConstructor;
   SoftwareScaleContext: NativeSoftwareScaleContextConstructor;
   SoftwareResampleContext: NativeSoftwareResampleContextConstructor;
+  ParallelDecoder: NativeParallelDecoderConstructor;
+  DemuxDispatcher: NativeDemuxDispatcherConstructor;
+  FrameCache: NativeFrameCacheConstructor;
+  MediaHasher: NativeMediaHasherConstructor;
+  FrameArena: NativeFrameArenaConstructor;
+  PacketAllocator: NativePacketAllocatorConstructor;
+  PacketRecorder: NativePacketRecorderConstructor;
+  FrameScheduler: NativeFrameSchedulerConstructor;
+  PacketRouter: NativePacketRouterConstructor;
+  SharedMemoryChannel: NativeSharedMemoryChannelConstructor;
+  SmartCutter: NativeSmartCutterConstructor;
+  SceneAnalyzer: NativeSceneAnalyzerConstructor;
+  ColorTransform: NativeColorTransformConstructor;
+  LogoOverlay: NativeLogoOverlayConstructor;
+  ImageSequenceWriter: NativeImageSequenceWriterConstructor;
 
   // Hardware
   HardwareDeviceContext: NativeHardwareDeviceContextConstructor;
@@ -21,10 +21,12 @@ import type {
 import type { CodecParameters } from './codec-parameters.js';
 import type { Codec } from './codec.js';
 import type { Dictionary } from './dictionary.js';
+import type { FrameArena } from './frame-arena.js';
 import type { Frame } from './frame.js';
 import type { NativeCodecContext, NativeWrapper } from './native-types.js';
+import type { PacketAllocator } from './packet-allocator.js';
 import type { Packet } from './packet.js';
-import type { ChannelLayout } from './types.js';
+import type { ChannelLayout, CodecReconfigureOptions, CodecReconfigureStats } from './types.js';
 
 /**
  * Codec context for encoding and decoding.
@@ -1175,6 +1177,94 @@ export class CodecContext extends OptionMember<NativeCodecContext> implements Di
     this.native.setHardwarePixelFormat(hwFormat, swFormat);
   }
 
+  /**
+   * Allocate decoded frames from a frame arena.
+   *
+   * Installs a get_buffer2 callback that places video frame planes in arena
+   * slots (with the decoder's padding and alignment requirements). When no slot
+   * is free or large enough, or the decoder does not support direct rendering,
+   * the default allocator is used. Set before opening the decoder.
+   *
+   * @param arena - Frame arena, or null to restore the default allocator
+   *
+   * @example
+   * ```typescript
+   * const arena = new FrameArena();
+   * arena.alloc(new Uint8Array(new SharedArrayBuffer(size)), slotSize);
+   * ctx.setFrameArena(arena);
+   * await ctx.open2(codec);
+   * ```
+   *
+   * @see {@link FrameArena} For slot management
+   */
+  setFrameArena(arena: FrameArena | null): void {
+    this.native.setFrameArena(arena ? arena.getNative() : null);
+  }
+
+  /**
+   * Allocate encoded packets from a packet allocator.
+   *
+   * Installs a get_encode_buffer callback, so encoders with direct rendering
+   * support write small packets straight into slab memory. Output of other
+   * encoders is copied into it by {@link receivePacket}. Packets larger than the
+   * allocator's `maxSize` use the default allocator.
+   *
+   * @param allocator - Packet allocator, or null to restore the default allocator
+   *
+   * @example
+   * ```typescript
+   * const allocator = new PacketAllocator();
+   * allocator.alloc({ maxSize: 2048 });
+   * ctx.setPacketAllocator(allocator);
+   * await ctx.open2(codec);
+   * ```
+   *
+   * @see {@link PacketAllocator} For size classes and statistics
+   */
+  setPacketAllocator(allocator: PacketAllocator | null): void {
+    this.native.setPacketAllocator(allocator ? allocator.getNative() : null);
+  }
+
+  /**
+   * Reconfigure a running encoder.
+   *
+   * Changes are queued and applied to the next frame sent, right before
+   * avcodec_send_frame() on the thread encoding it. Rate changes go through the
+   * encoder's own reconfiguration path (x264_encoder_reconfig, NVENC
+   * nvEncReconfigureEncoder); encoders without one return AVERROR_ENOSYS instead
+   * of ignoring the change. A forced keyframe works on every encoder.
+   * Before opening, rate changes update the configuration directly.
+   *
+   * @param options - Rate control changes and keyframe request
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid values or context not allocated
+   *   - AVERROR_ENOSYS: Encoder cannot change rate control while running
+   *
+   * @example
+   * ```typescript
+   * // Congestion feedback
+   * ctx.reconfigure({ bitRate: 800_000n, rcMaxRate: 800_000n, rcBufferSize: 400_000 });
+   *
+   * // Packet loss: next frame becomes an IDR frame
+   * ctx.reconfigure({ keyframe: true });
+   * ```
+   *
+   * @see {@link getReconfigureStats} For apply latencies
+   */
+  reconfigure(options: CodecReconfigureOptions): number {
+    return this.native.reconfigure(options);
+  }
+
+  /**
+   * Get runtime reconfiguration statistics.
+   *
+   * @returns Counters and the latency of the last change and keyframe request
+   */
+  getReconfigureStats(): CodecReconfigureStats {
+    return this.native.getReconfigureStats();
+  }
+
   /**
    * Get the underlying native CodecContext object.
    *
@@ -0,0 +1,153 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeColorTransform, NativeWrapper } from './native-types.js';
+import type { ColorTransformOptions, ColorTransformStats } from './types.js';
+
+/**
+ * Colorspace conversion and HDR to SDR tone mapping through a cached 3D LUT.
+ *
+ * A `zscale`/`colorspace` + `tonemap` filter chain evaluates transfer curves, tone curve
+ * and gamut matrices for every pixel of every frame, although the mapping from source to
+ * destination code values never changes. The transform evaluates it once on a lattice
+ * (33x33x33 by default) per source/destination combination and converts frames with
+ * tetrahedral interpolation directly on the planar YUV data.
+ *
+ * LUTs are cached process-wide: every transform with the same combination (e.g. one per
+ * rendition or per channel) shares one LUT, and a source that changes its color
+ * description mid-stream only builds a LUT the first time it appears.
+ *
+ * Supports planar 8 to 12-bit YUV (4:2:0, 4:2:2, 4:4:4). Frames are converted in place,
+ * or into a destination frame (e.g. with a different bit depth) backed by buffer pools.
+ * Frame color properties are updated and HDR side data is removed for SDR output.
+ *
+ * @example
+ * ```typescript
+ * import { ColorTransform, FFmpegError, Frame, AV_PIX_FMT_YUV420P } from 'node-av';
+ *
+ * // PQ BT.2020 10-bit to SDR BT.709 8-bit
+ * const transform = new ColorTransform();
+ * FFmpegError.throwIfError(transform.alloc({ dstFormat: AV_PIX_FMT_YUV420P, tonemap: 'hable', peak: 1000 }), 'alloc');
+ *
+ * const sdr = new Frame();
+ * sdr.alloc();
+ * for await (const frame of decoder.frames(input.packets(video.index))) {
+ *   FFmpegError.throwIfError(await transform.apply(frame, sdr), 'apply');
+ *   await encoder.encode(sdr);
+ *   frame.free();
+ * }
+ * ```
+ *
+ * @see {@link Frame.colorTrc} For the frame's transfer characteristic
+ */
+export class ColorTransform implements Disposable, NativeWrapper<NativeColorTransform> {
+  private native: NativeColorTransform;
+
+  constructor() {
+    this.native = new bindings.ColorTransform();
+  }
+
+  /**
+   * Drop all cached LUTs.
+   *
+   * LUTs still used by a transform stay alive until it moves on or is freed.
+   */
+  static clearCache(): void {
+    bindings.ColorTransform.clearCache();
+  }
+
+  /**
+   * Allocate and configure the transform.
+   *
+   * Resets statistics. The LUT is built (or taken from the cache) on the first frame.
+   *
+   * @param options - Source and destination color description, tone mapping and LUT size
+   *
+   * @returns 0 on success, AVERROR_EINVAL on invalid or unsupported options
+   *
+   * @example
+   * ```typescript
+   * const transform = new ColorTransform();
+   * // BT.601 to BT.709 matrix, source primaries kept
+   * transform.alloc({ srcSpace: AVCOL_SPC_SMPTE170M, srcPrimaries: AVCOL_PRI_BT709 });
+   * ```
+   */
+  alloc(options: ColorTransformOptions = {}): number {
+    return this.native.alloc(options);
+  }
+
+  /**
+   * Free the transform and its buffer pools.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Convert a frame.
+   *
+   * Without `dst` the source frame is converted in place (made writable first if its
+   * buffers are shared). With `dst` the destination is re-allocated from the transform's
+   * buffer pools and gets the source's properties.
+   *
+   * @param src - Software video frame
+   *
+   * @param dst - Destination frame, or omitted for in-place conversion
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not allocated, unsupported format or in-place format change
+   *   - AVERROR_ENOSYS: Unsupported frame color description
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @see {@link applySync} For synchronous version
+   */
+  async apply(src: Frame, dst?: Frame): Promise<number> {
+    return await this.native.apply(src.getNative(), dst?.getNative() ?? null);
+  }
+
+  /**
+   * Convert a frame synchronously.
+   * Synchronous version of apply.
+   *
+   * @param src - Software video frame
+   *
+   * @param dst - Destination frame, or omitted for in-place conversion
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link apply} For async version
+   */
+  applySync(src: Frame, dst?: Frame): number {
+    return this.native.applySync(src.getNative(), dst?.getNative() ?? null);
+  }
+
+  /**
+   * Get transform statistics.
+   *
+   * @returns Frame, LUT build and cache counters
+   */
+  getStats(): ColorTransformStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native ColorTransform object.
+   *
+   * @returns The native ColorTransform binding object
+   *
+   * @internal
+   */
+  getNative(): NativeColorTransform {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the transform.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
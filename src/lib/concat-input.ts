@@ -0,0 +1,234 @@
+import { bindings } from './binding.js';
+
+import type { CodecParameters } from './codec-parameters.js';
+import type { NativeConcatInput, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { IRational } from './types.js';
+
+/**
+ * Gapless playlist input.
+ *
+ * Reads a list of media files back to back as a single continuous packet stream,
+ * e.g. for 24/7 channels. Upcoming items are opened and probed
+ * (avformat_open_input + avformat_find_stream_info) on a native background thread
+ * while the current item is read, so switching items does not stall packet flow.
+ *
+ * The first item defines the output streams and their time bases. Timestamps of
+ * following items are shifted so pts/dts continue where the previous item ended.
+ * Items whose streams are not stream-copy compatible with the first item (codec,
+ * dimensions, sample format/rate, channel count, extradata) or fail to open are
+ * skipped and counted in {@link itemsSkipped}.
+ *
+ * @example
+ * ```typescript
+ * import { ConcatInput, Packet, FFmpegError } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * const input = new ConcatInput();
+ * FFmpegError.throwIfError(await input.open(['a.mp4', 'b.mp4', 'c.mp4']), 'open');
+ *
+ * const packet = new Packet();
+ * packet.alloc();
+ * while ((await input.readFrame(packet)) !== AVERROR_EOF) {
+ *   if (input.boundary) {
+ *     console.log(`Now playing ${input.currentUrl}`);
+ *   }
+ *   // Write packet (time base: input.getStreamTimeBase(packet.streamIndex))
+ *   packet.unref();
+ * }
+ * ```
+ *
+ * @see {@link FormatContext} For single inputs
+ */
+export class ConcatInput implements Disposable, NativeWrapper<NativeConcatInput> {
+  private native: NativeConcatInput;
+
+  constructor() {
+    this.native = new bindings.ConcatInput();
+  }
+
+  /**
+   * Number of output streams (defined by the first item).
+   */
+  get nbStreams(): number {
+    return this.native.nbStreams;
+  }
+
+  /**
+   * Whether the last packet read is the first packet of a new item.
+   */
+  get boundary(): boolean {
+    return this.native.boundary;
+  }
+
+  /**
+   * Playlist index of the item currently being read.
+   */
+  get itemIndex(): number {
+    return this.native.itemIndex;
+  }
+
+  /**
+   * URL of the item currently being read.
+   */
+  get currentUrl(): string | null {
+    return this.native.currentUrl;
+  }
+
+  /**
+   * Number of items skipped because they failed to open or were incompatible.
+   */
+  get itemsSkipped(): number {
+    return this.native.itemsSkipped;
+  }
+
+  /**
+   * Number of items not yet started (queued or already prefetched).
+   */
+  get pendingItems(): number {
+    return this.native.pendingItems;
+  }
+
+  /**
+   * Open the playlist.
+   *
+   * Starts the prefetch thread and waits until the first usable item is open.
+   *
+   * @param urls - Playlist items
+   *
+   * @param lookahead - Number of items to keep opened ahead (default: 1)
+   *
+   * @param endless - Keep waiting for {@link append} instead of ending after the last item
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: Playlist empty
+   *   - Other: Open error of the last failing item
+   *
+   * @see {@link openSync} For synchronous version
+   */
+  async open(urls: string[], lookahead = 1, endless = false): Promise<number> {
+    return await this.native.open(urls, lookahead, endless);
+  }
+
+  /**
+   * Open the playlist synchronously.
+   * Synchronous version of open.
+   *
+   * @param urls - Playlist items
+   *
+   * @param lookahead - Number of items to keep opened ahead (default: 1)
+   *
+   * @param endless - Keep waiting for {@link append} instead of ending after the last item
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link open} For async version
+   */
+  openSync(urls: string[], lookahead = 1, endless = false): number {
+    return this.native.openSync(urls, lookahead, endless);
+  }
+
+  /**
+   * Append an item to the playlist.
+   *
+   * @param url - Item URL
+   */
+  append(url: string): void {
+    this.native.append(url);
+  }
+
+  /**
+   * Mark the end of an endless playlist.
+   *
+   * Reading returns AVERROR_EOF after the remaining items.
+   */
+  end(): void {
+    this.native.end();
+  }
+
+  /**
+   * Read the next packet.
+   *
+   * Timestamps are in the output stream time base and continue across items.
+   *
+   * @param packet - Packet to read into
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: All items read
+   *   - AVERROR_EINVAL: Not opened
+   *
+   * @see {@link readFrameSync} For synchronous version
+   */
+  async readFrame(packet: Packet): Promise<number> {
+    return await this.native.readFrame(packet.getNative());
+  }
+
+  /**
+   * Read the next packet synchronously.
+   * Synchronous version of readFrame.
+   *
+   * @param packet - Packet to read into
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link readFrame} For async version
+   */
+  readFrameSync(packet: Packet): number {
+    return this.native.readFrameSync(packet.getNative());
+  }
+
+  /**
+   * Copy the codec parameters of an output stream.
+   *
+   * @param streamIndex - Output stream index
+   *
+   * @param codecpar - Destination parameters
+   *
+   * @returns 0 on success, AVERROR_EINVAL for an invalid index
+   */
+  getCodecParameters(streamIndex: number, codecpar: CodecParameters): number {
+    return this.native.getCodecParameters(streamIndex, codecpar.getNative());
+  }
+
+  /**
+   * Get the time base of an output stream.
+   *
+   * @param streamIndex - Output stream index
+   *
+   * @returns Time base or null for an invalid index
+   */
+  getStreamTimeBase(streamIndex: number): IRational | null {
+    return this.native.getStreamTimeBase(streamIndex);
+  }
+
+  /**
+   * Close all items and stop the prefetch thread.
+   *
+   * Does not wait for the prefetch thread: the network I/O of the item it is
+   * opening is interrupted and it exits in the background.
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get the underlying native ConcatInput object.
+   *
+   * @returns The native ConcatInput binding object
+   *
+   * @internal
+   */
+  getNative(): NativeConcatInput {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the playlist input.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
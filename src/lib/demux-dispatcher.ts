@@ -0,0 +1,226 @@
+import { bindings } from './binding.js';
+
+import type { CodecContext } from './codec-context.js';
+import type { FormatContext } from './format-context.js';
+import type { Frame } from './frame.js';
+import type { NativeDemuxDispatcher, NativeWrapper } from './native-types.js';
+import type { DemuxDispatcherStats } from './types.js';
+
+/**
+ * Native demux dispatcher.
+ *
+ * Owns reading of an opened input format context on a dedicated native thread and
+ * routes packets by stream index into bounded per-stream queues. Every attached
+ * decoder runs on its own thread, so audio and video decoding proceed concurrently
+ * instead of serializing on the event loop. Only decoded frames are surfaced to JS -
+ * or nothing at all when a stream is chained to an encoder, in which case encoded
+ * packets are written to the output with av_interleaved_write_frame().
+ *
+ * The input must not be read from JS while the dispatcher runs. Chained encoders
+ * must already be open and accept the decoder output as-is (same pixel/sample format,
+ * matching frame size for fixed frame size audio encoders), and the output header
+ * must already be written.
+ *
+ * @example
+ * ```typescript
+ * import { DemuxDispatcher, Frame } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * const dispatcher = new DemuxDispatcher();
+ * dispatcher.setInput(input.getFormatContext());
+ * dispatcher.addStream(video.index, videoDecoder.getCodecContext()!);
+ * dispatcher.addStream(audio.index, audioDecoder.getCodecContext()!);
+ * dispatcher.start();
+ *
+ * const frame = new Frame();
+ * frame.alloc();
+ * while ((await dispatcher.receiveFrame(video.index, frame)) !== AVERROR_EOF) {
+ *   // Process video frame...
+ * }
+ * ```
+ *
+ * @see {@link FormatContext} For input handling
+ * @see {@link CodecContext} For decoder setup
+ */
+export class DemuxDispatcher implements Disposable, NativeWrapper<NativeDemuxDispatcher> {
+  private native: NativeDemuxDispatcher;
+
+  constructor() {
+    this.native = new bindings.DemuxDispatcher();
+  }
+
+  /**
+   * Whether reader or decoder threads are still producing.
+   */
+  get isRunning(): boolean {
+    return this.native.isRunning;
+  }
+
+  /**
+   * Set the input to demux.
+   *
+   * The format context must be opened and its streams probed.
+   *
+   * @param formatContext - Opened input format context
+   *
+   * @param queueSize - Maximum packets buffered per stream (default: 64)
+   *
+   * @throws {Error} If already started or the context is invalid
+   */
+  setInput(formatContext: FormatContext, queueSize?: number): void {
+    this.native.setInput(formatContext.getNative(), queueSize);
+  }
+
+  /**
+   * Set the output for encoder chained streams.
+   *
+   * The output header must be written before {@link start}.
+   * Writing the trailer after {@link wait} is left to the caller. Muxer calls from JS
+   * are serialized with the dispatcher's writes; the Sync write methods of the output
+   * return AVERROR_EBUSY while it runs.
+   *
+   * @param formatContext - Output format context
+   *
+   * @throws {Error} If already started or the context is invalid
+   */
+  setOutput(formatContext: FormatContext): void {
+    this.native.setOutput(formatContext.getNative());
+  }
+
+  /**
+   * Attach a decoder to an input stream.
+   *
+   * Packets of streams without a decoder are discarded.
+   * When an encoder is given, decoded frames are encoded on the same thread
+   * and written to `outputStreamIndex` of the output.
+   *
+   * @param streamIndex - Input stream index
+   *
+   * @param decoder - Opened decoder context
+   *
+   * @param encoder - Opened encoder context to chain to
+   *
+   * @param outputStreamIndex - Output stream index for the encoder
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid/duplicate stream, missing output or already started
+   */
+  addStream(streamIndex: number, decoder: CodecContext, encoder?: CodecContext | null, outputStreamIndex?: number): number {
+    return this.native.addStream(streamIndex, decoder.getNative(), encoder?.getNative() ?? null, outputStreamIndex);
+  }
+
+  /**
+   * Start the reader and decoder threads.
+   *
+   * @returns 0 on success, AVERROR_EINVAL if no input/stream, already started or
+   *   the output header of chained encoders has not been written
+   */
+  start(): number {
+    return this.native.start();
+  }
+
+  /**
+   * Receive the next decoded frame of a stream.
+   *
+   * Waits until the stream's decoder delivered a frame.
+   *
+   * @param streamIndex - Input stream index
+   *
+   * @param frame - Frame to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: Stream fully decoded
+   *   - AVERROR_EINVAL: Stream not attached, chained to an encoder, or not started
+   *   - Other: Read or decode error
+   *
+   * @see {@link receiveFrameSync} For synchronous version
+   */
+  async receiveFrame(streamIndex: number, frame: Frame): Promise<number> {
+    return await this.native.receiveFrame(streamIndex, frame.getNative());
+  }
+
+  /**
+   * Receive the next decoded frame of a stream synchronously.
+   * Synchronous version of receiveFrame.
+   *
+   * @param streamIndex - Input stream index
+   *
+   * @param frame - Frame to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link receiveFrame} For async version
+   */
+  receiveFrameSync(streamIndex: number, frame: Frame): number {
+    return this.native.receiveFrameSync(streamIndex, frame.getNative());
+  }
+
+  /**
+   * Wait until all threads finished.
+   *
+   * Streams delivering frames to JS must be consumed concurrently,
+   * otherwise their decoder blocks once its frame queue is full.
+   *
+   * @returns 0 on success or the first read/decode/encode error
+   *
+   * @see {@link waitSync} For synchronous version
+   */
+  async wait(): Promise<number> {
+    return await this.native.wait();
+  }
+
+  /**
+   * Wait until all threads finished synchronously.
+   * Synchronous version of wait.
+   *
+   * Blocks the event loop: must not be used while the input or the output
+   * does I/O through JS callbacks, those reads and writes need the event loop.
+   *
+   * @returns 0 on success or the first read/decode/encode error
+   *
+   * @see {@link wait} For async version
+   */
+  waitSync(): number {
+    return this.native.waitSync();
+  }
+
+  /**
+   * Stop all threads and discard queued packets and frames.
+   *
+   * Does not wait for the threads: they are signaled and a blocking network read
+   * is interrupted. Await {@link wait} before closing the input, output or codecs.
+   */
+  stop(): void {
+    this.native.stop();
+  }
+
+  /**
+   * Get reader and per-stream counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): DemuxDispatcherStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native DemuxDispatcher object.
+   *
+   * @returns The native DemuxDispatcher binding object
+   *
+   * @internal
+   */
+  getNative(): NativeDemuxDispatcher {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the dispatcher.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
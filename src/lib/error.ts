@@ -33,6 +33,7 @@ export enum PosixError {
   EBUSY = 'EBUSY',
   EMFILE = 'EMFILE',
   ERANGE = 'ERANGE',
+  ENOSYS = 'ENOSYS',
 }
 
 // Cache for error codes to avoid repeated native calls
@@ -106,6 +107,9 @@ export const AVERROR_EMFILE = getCachedError(PosixError.EMFILE);
 /** FFmpeg error code for ERANGE (result too large) */
 export const AVERROR_ERANGE = getCachedError(PosixError.ERANGE);
 
+/** FFmpeg error code for ENOSYS (function not implemented) */
+export const AVERROR_ENOSYS = getCachedError(PosixError.ENOSYS);
+
 /**
  * FFmpeg error handling class.
  *
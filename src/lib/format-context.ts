@@ -10,7 +10,10 @@ import { Stream } from './stream.js';
 import type { AVFormatFlag, AVMediaType, AVSeekFlag } from '../constants/constants.js';
 import type { IOContext } from './io-context.js';
 import type { NativeFormatContext, NativeWrapper } from './native-types.js';
+import type { PacketAllocator } from './packet-allocator.js';
+import type { PacketRecorder } from './packet-recorder.js';
 import type { Packet } from './packet.js';
+import type { PacketTraceOptions, ReadRateOptions, ReadRateStats } from './types.js';
 
 /**
  * Container format context for reading/writing multimedia files.
@@ -563,6 +566,69 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
     return this.native.openInputSync(url, fmt?.getNative() ?? null, options?.getNative() ?? null);
   }
 
+  /**
+   * Open a packet trace for reading.
+   *
+   * Replays a trace captured with {@link PacketRecorder} instead of running a
+   * demuxer. The recorded streams are created with their original indices, time
+   * bases and codec parameters, and {@link readFrame} returns the recorded
+   * packets in order, bit-exact including side data. {@link findStreamInfo} is
+   * not needed. Seeking jumps to recorded keyframes.
+   *
+   * @param path - Trace file path
+   *
+   * @param options - Replay pacing
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENOENT: File not found
+   *   - AVERROR_INVALIDDATA: Not a packet trace
+   *   - AVERROR_PATCHWELCOME: Unsupported trace version
+   *
+   * @throws {Error} If the context already has an open input or output
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError } from 'node-av';
+   *
+   * const ret = await ctx.openTrace('capture.trace', { realtime: true });
+   * FFmpegError.throwIfError(ret, 'openTrace');
+   * ```
+   *
+   * @see {@link PacketRecorder} For capturing traces
+   */
+  async openTrace(path: string, options: PacketTraceOptions = {}): Promise<number> {
+    return await this.native.openTrace(path, options);
+  }
+
+  /**
+   * Open a packet trace for reading synchronously.
+   * Synchronous version of openTrace.
+   *
+   * @param path - Trace file path
+   *
+   * @param options - Replay pacing
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENOENT: File not found
+   *   - AVERROR_INVALIDDATA: Not a packet trace
+   *   - AVERROR_PATCHWELCOME: Unsupported trace version
+   *
+   * @throws {Error} If the context already has an open input or output
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError } from 'node-av';
+   *
+   * const ret = ctx.openTraceSync('capture.trace');
+   * FFmpegError.throwIfError(ret, 'openTraceSync');
+   * ```
+   *
+   * @see {@link openTrace} For async version
+   */
+  openTraceSync(path: string, options: PacketTraceOptions = {}): number {
+    return this.native.openTraceSync(path, options);
+  }
+
   /**
    * Close an input format context.
    *
@@ -744,6 +810,101 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
     return this.native.readFrameSync(pkt.getNative());
   }
 
+  /**
+   * Place small demuxed packets in slab memory.
+   *
+   * Demuxers have no allocation hook, so packets up to the allocator's `maxSize`
+   * are copied into slab memory by {@link readFrame} right after reading. The
+   * demuxer's own buffer is freed immediately on the reading thread, which keeps
+   * long-lived payloads (queued audio, subtitles, data) out of the heap.
+   *
+   * @param allocator - Packet allocator, or null to keep demuxer buffers
+   *
+   * @example
+   * ```typescript
+   * const allocator = new PacketAllocator();
+   * allocator.alloc();
+   * ctx.setPacketAllocator(allocator);
+   * ```
+   *
+   * @see {@link PacketAllocator} For size classes and statistics
+   */
+  setPacketAllocator(allocator: PacketAllocator | null): void {
+    this.native.setPacketAllocator(allocator ? allocator.getNative() : null);
+  }
+
+  /**
+   * Record every packet read from this input.
+   *
+   * Packets returned by {@link readFrame} are written to the recorder's trace
+   * together with their stream's parameters and arrival time. Streams known at
+   * this point are recorded immediately, streams added later before their first
+   * packet. Write errors stop the capture but not the input; check
+   * {@link PacketRecorder.close}.
+   *
+   * @param recorder - Open packet recorder, or null to stop recording
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Output context
+   *   - AVERROR_EIO: Writing the stream records failed
+   *
+   * @throws {TypeError} If the recorder is not open
+   *
+   * @example
+   * ```typescript
+   * const recorder = new PacketRecorder();
+   * recorder.open('capture.trace');
+   * ctx.setPacketRecorder(recorder);
+   * ```
+   *
+   * @see {@link PacketRecorder} For the trace format
+   * @see {@link openTrace} For replaying a trace
+   */
+  setPacketRecorder(recorder: PacketRecorder | null): number {
+    return this.native.setPacketRecorder(recorder ? recorder.getNative() : null);
+  }
+
+  /**
+   * Release read packets at their native rate.
+   *
+   * Native equivalent of ffmpeg's `-re`: {@link readFrame} holds each packet
+   * until its dts is due on a monotonic clock anchored at the first packet, so
+   * pacing neither depends on the event loop nor drifts over long runs. Seeking
+   * re-anchors the schedule. {@link readFrameSync} blocks the calling thread
+   * while waiting.
+   *
+   * @param options - Rate, initial burst and catch-up policy, or null to read at full speed
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid options or output context
+   *
+   * @example
+   * ```typescript
+   * // Simulcast a file as a live stream with 2 seconds of preroll
+   * ctx.setReadRate({ initialBurst: 2, catchup: 'reset' });
+   * while (await ctx.readFrame(packet) >= 0) {
+   *   // Packets arrive in real time
+   * }
+   * console.log(ctx.getReadRateStats());
+   * ```
+   *
+   * @see {@link getReadRateStats} For lateness statistics
+   */
+  setReadRate(options: ReadRateOptions | null = {}): number {
+    return this.native.setReadRate(options);
+  }
+
+  /**
+   * Get read pacing statistics.
+   *
+   * @returns Statistics, or null if pacing is off
+   *
+   * @see {@link setReadRate} To enable pacing
+   */
+  getReadRateStats(): ReadRateStats | null {
+    return this.native.getReadRateStats();
+  }
+
   /**
    * Seek to timestamp in stream.
    *
@@ -896,6 +1057,7 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
    *
    * @returns 0 on success, negative AVERROR on error:
    *   - AVERROR_EINVAL: Invalid parameters
+   *   - AVERROR_EBUSY: A PacketRouter or DemuxDispatcher writes to this output, use the async version
    *
    * @example
    * ```typescript
@@ -950,7 +1112,8 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
    *
    * @param pkt - Packet to write (null to flush)
    *
-   * @returns 0 on success, negative AVERROR on error
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EBUSY: A PacketRouter or DemuxDispatcher writes to this output, use the async version
    *
    * @example
    * ```typescript
@@ -1012,6 +1175,7 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
    * @returns 0 on success, negative AVERROR on error:
    *   - AVERROR_EINVAL: Invalid parameters
    *   - AVERROR(EIO): I/O error
+   *   - AVERROR_EBUSY: A PacketRouter or DemuxDispatcher writes to this output, use the async version
    *
    * @example
    * ```typescript
@@ -1066,7 +1230,8 @@ export class FormatContext extends OptionMember<NativeFormatContext> implements
    *
    * Direct mapping to av_write_trailer().
    *
-   * @returns 0 on success, negative AVERROR on error
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EBUSY: A PacketRouter or DemuxDispatcher writes to this output, use the async version
    *
    * @example
    * ```typescript
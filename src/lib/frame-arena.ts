@@ -0,0 +1,199 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeFrameArena, NativeWrapper } from './native-types.js';
+import type { FrameArenaStats } from './types.js';
+
+/**
+ * Frame buffer arena in shared memory.
+ *
+ * Splits caller-provided memory - typically a view on a SharedArrayBuffer - into
+ * fixed-size, aligned slots and allocates frame planes inside them. Frames then
+ * already live in memory that worker threads, WASM modules and ML runtimes can read,
+ * so handing a frame to a worker only means passing a slot index.
+ *
+ * Slots can be used by:
+ * - {@link Frame.allocBuffer} / {@link allocFrame} for frames you fill yourself
+ * - Scaler destinations: allocate the destination frame from the arena before
+ *   {@link SoftwareScaleContext.scaleFrame}
+ * - Decoders via {@link CodecContext.setFrameArena} (custom get_buffer2)
+ *
+ * A slot returns to the arena automatically when FFmpeg drops the last reference
+ * to its buffer. Consumers outside FFmpeg {@link pin} a slot and {@link release}
+ * it when done, so it is not recycled while a worker still reads it.
+ * The memory is kept alive as long as any slot is referenced.
+ *
+ * @example
+ * ```typescript
+ * import { FrameArena, Frame, FFmpegError } from 'node-av';
+ *
+ * const sab = new SharedArrayBuffer(8 * 1920 * 1088 * 4);
+ * const arena = new FrameArena();
+ * FFmpegError.throwIfError(arena.alloc(new Uint8Array(sab), 1920 * 1088 * 4), 'alloc');
+ *
+ * // Decoded frames land in the SharedArrayBuffer
+ * decoderContext.setFrameArena(arena);
+ *
+ * // Hand a frame to a worker
+ * const slot = arena.pin(frame);
+ * if (slot >= 0) {
+ *   worker.postMessage({ slot, offset: arena.slotOffset(slot), linesize: frame.linesize });
+ * }
+ *
+ * // Worker finished
+ * worker.on('message', ({ slot }) => arena.release(slot));
+ * ```
+ *
+ * @see {@link Frame.importBuffer} For wrapping single JS buffers
+ */
+export class FrameArena implements Disposable, NativeWrapper<NativeFrameArena> {
+  private native: NativeFrameArena;
+
+  constructor() {
+    this.native = new bindings.FrameArena();
+  }
+
+  /**
+   * Number of slots.
+   */
+  get slotCount(): number {
+    return this.native.slotCount;
+  }
+
+  /**
+   * Usable bytes per slot.
+   */
+  get slotSize(): number {
+    return this.native.slotSize;
+  }
+
+  /**
+   * Slots neither referenced by FFmpeg nor pinned.
+   */
+  get freeSlots(): number {
+    return this.native.freeSlots;
+  }
+
+  /**
+   * Set up the arena.
+   *
+   * Slots start at an `align`-byte boundary and are `align`-aligned apart.
+   * Plane linesizes of allocated frames are aligned to `align` as well.
+   *
+   * @param memory - Backing memory, e.g. `new Uint8Array(sharedArrayBuffer)`
+   *
+   * @param slotSize - Bytes per slot (large enough for one frame including padding)
+   *
+   * @param align - Slot and linesize alignment, power of two (default: 64)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid size/alignment or memory smaller than one slot
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   */
+  alloc(memory: ArrayBufferView | ArrayBuffer, slotSize: number, align = 64): number {
+    return this.native.alloc(memory, slotSize, align);
+  }
+
+  /**
+   * Detach from the memory.
+   *
+   * Slots still referenced by frames stay valid until those frames are released.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Allocate frame buffers from a free slot.
+   *
+   * Format, width/height (video) or nbSamples/channelLayout (audio) must be set.
+   * Previous frame buffers are released.
+   *
+   * @param frame - Frame to allocate
+   *
+   * @returns Slot index, or negative AVERROR on error:
+   *   - AVERROR_EAGAIN: No free slot
+   *   - AVERROR_EINVAL: Arena not allocated, frame not configured or larger than a slot
+   */
+  allocFrame(frame: Frame): number {
+    return this.native.allocFrame(frame.getNative());
+  }
+
+  /**
+   * Pin the slot holding a frame.
+   *
+   * A pinned slot is not recycled even after FFmpeg released it.
+   *
+   * @param frame - Frame allocated from this arena
+   *
+   * @returns Slot index, or AVERROR_ENOENT if the frame is not in the arena
+   *
+   * @see {@link release} To unpin
+   */
+  pin(frame: Frame): number {
+    return this.native.pin(frame.getNative());
+  }
+
+  /**
+   * Unpin a slot once its consumer is done.
+   *
+   * @param slot - Slot index returned by {@link pin}
+   *
+   * @returns 0 on success, AVERROR_EINVAL for an invalid slot
+   */
+  release(slot: number): number {
+    return this.native.release(slot);
+  }
+
+  /**
+   * Find the slot holding a frame.
+   *
+   * @param frame - Frame to look up
+   *
+   * @returns Slot index, or -1 if the frame is not in the arena
+   */
+  slotOf(frame: Frame): number {
+    return this.native.slotOf(frame.getNative());
+  }
+
+  /**
+   * Byte offset of a slot within the backing memory.
+   *
+   * @param slot - Slot index
+   *
+   * @returns Offset in bytes, or AVERROR_EINVAL for an invalid slot
+   */
+  slotOffset(slot: number): number {
+    return this.native.slotOffset(slot);
+  }
+
+  /**
+   * Get slot usage counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): FrameArenaStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native FrameArena object.
+   *
+   * @returns The native FrameArena binding object
+   *
+   * @internal
+   */
+  getNative(): NativeFrameArena {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the arena.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,217 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeFrameCache, NativeWrapper } from './native-types.js';
+import type { FrameCacheStats } from './types.js';
+
+/**
+ * Decoded frame cache for random-access scrubbing.
+ *
+ * Stores decoded frames keyed by (input, stream, pts) within a byte budget and evicts
+ * the least recently used entries first. Entries keep a reference to the decoded
+ * buffers - or a downscaled copy when a scale width is configured - and lookups
+ * return a new reference (av_frame_ref) instead of copying pixel data.
+ *
+ * A background prefetcher can decode ahead and behind a playhead. It opens its own
+ * demuxer and decoder per input on a native thread (seek to the previous keyframe,
+ * decode forward), so it never competes with the caller's {@link FormatContext}.
+ * A new prefetch request supersedes any prefetch still running.
+ *
+ * @example
+ * ```typescript
+ * import { FrameCache, Frame } from 'node-av';
+ *
+ * const cache = new FrameCache();
+ * cache.alloc(512 * 1024 * 1024, 640); // 512 MiB, store 640px wide previews
+ *
+ * const frame = new Frame();
+ * frame.alloc();
+ *
+ * if (cache.get('input.mp4', 0, pts, frame) === 0) {
+ *   // Cache hit - frame references the cached buffers
+ * } else {
+ *   // Decode via MediaInput/Decoder, then
+ *   cache.put('input.mp4', 0, pts, decoded);
+ * }
+ *
+ * // Decode 2s behind and 5s ahead of the playhead in the background (timeBase 1/90000)
+ * cache.prefetch('input.mp4', 0, pts, 180000n, 450000n);
+ * ```
+ *
+ * @see {@link Frame} For frame handling
+ */
+export class FrameCache implements Disposable, NativeWrapper<NativeFrameCache> {
+  private native: NativeFrameCache;
+
+  constructor() {
+    this.native = new bindings.FrameCache();
+  }
+
+  /**
+   * Current memory held by cached frames in bytes.
+   */
+  get bytes(): number {
+    return this.native.bytes;
+  }
+
+  /**
+   * Number of cached frames.
+   */
+  get entries(): number {
+    return this.native.entries;
+  }
+
+  /**
+   * Configured byte budget.
+   */
+  get maxBytes(): number {
+    return this.native.maxBytes;
+  }
+
+  /**
+   * Allocate the cache.
+   *
+   * Clears any previous content and stops a running prefetcher.
+   *
+   * @param maxBytes - Byte budget for all cached frames
+   *
+   * @param scaleWidth - Store video frames wider than this downscaled to this width (0 = full size)
+   *
+   * @param scaleHeight - Target height for downscaled frames (0 = keep aspect ratio)
+   *
+   * @example
+   * ```typescript
+   * const cache = new FrameCache();
+   * cache.alloc(256 * 1024 * 1024);
+   * ```
+   */
+  alloc(maxBytes: number, scaleWidth = 0, scaleHeight = 0): void {
+    this.native.alloc(maxBytes, scaleWidth, scaleHeight);
+  }
+
+  /**
+   * Free all cached frames and stop the prefetcher.
+   *
+   * Does not wait for the prefetcher: its network reads are interrupted and it
+   * exits in the background.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Insert a frame.
+   *
+   * References the frame buffers (or stores a downscaled copy).
+   * Replaces an existing entry with the same key.
+   *
+   * @param input - Input identifier (e.g. URL)
+   *
+   * @param streamIndex - Stream index
+   *
+   * @param pts - Presentation timestamp in stream time base
+   *
+   * @param frame - Decoded frame
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Cache not allocated
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   */
+  put(input: string, streamIndex: number, pts: bigint, frame: Frame): number {
+    return this.native.put(input, streamIndex, pts, frame.getNative());
+  }
+
+  /**
+   * Look up a frame.
+   *
+   * On a hit the target frame references the cached buffers and the entry
+   * becomes the most recently used.
+   *
+   * @param input - Input identifier (e.g. URL)
+   *
+   * @param streamIndex - Stream index
+   *
+   * @param pts - Presentation timestamp in stream time base
+   *
+   * @param frame - Frame to receive the reference
+   *
+   * @returns 0 on hit, AVERROR_ENOENT on miss
+   */
+  get(input: string, streamIndex: number, pts: bigint, frame: Frame): number {
+    return this.native.get(input, streamIndex, pts, frame.getNative());
+  }
+
+  /**
+   * Check whether a frame is cached without touching LRU order.
+   *
+   * @param input - Input identifier (e.g. URL)
+   *
+   * @param streamIndex - Stream index
+   *
+   * @param pts - Presentation timestamp in stream time base
+   *
+   * @returns True if cached
+   */
+  has(input: string, streamIndex: number, pts: bigint): boolean {
+    return this.native.has(input, streamIndex, pts);
+  }
+
+  /**
+   * Remove all cached frames.
+   */
+  clear(): void {
+    this.native.clear();
+  }
+
+  /**
+   * Decode around a playhead in the background.
+   *
+   * Seeks the prefetch demuxer of `url` to the keyframe before `pts - before` and
+   * caches every decoded frame up to `pts + after`. Returns immediately.
+   *
+   * @param url - Input URL, also used as cache key input
+   *
+   * @param streamIndex - Stream index to decode
+   *
+   * @param pts - Playhead in stream time base
+   *
+   * @param before - Range behind the playhead in stream time base
+   *
+   * @param after - Range ahead of the playhead in stream time base
+   *
+   * @returns 0 if queued, AVERROR_EINVAL if the cache is not allocated
+   */
+  prefetch(url: string, streamIndex: number, pts: bigint, before: bigint, after: bigint): number {
+    return this.native.prefetch(url, streamIndex, pts, before, after);
+  }
+
+  /**
+   * Get hit/miss/eviction counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): FrameCacheStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native FrameCache object.
+   *
+   * @returns The native FrameCache binding object
+   *
+   * @internal
+   */
+  getNative(): NativeFrameCache {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the cache.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
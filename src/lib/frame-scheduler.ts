@@ -0,0 +1,189 @@
+import { bindings } from './binding.js';
+
+import type { CodecContext } from './codec-context.js';
+import type { Frame } from './frame.js';
+import type { NativeFrameScheduler, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { FrameSchedulerOptions, FrameSchedulerStats } from './types.js';
+
+/**
+ * Wall-clock driven constant frame rate scheduler in front of an encoder.
+ *
+ * Live sources deliver frames with jitter, gaps and bursts, while live outputs
+ * (RTMP, SRT, HLS) expect a steady frame rate. The source pushes frames whenever
+ * they arrive; a native thread wakes at every output tick on a monotonic clock,
+ * takes the next queued frame and encodes it with the tick's pts. When the source
+ * is late the tick is served by repeating the last frame or by a black/slate frame
+ * (silence for audio), when it runs ahead the oldest queued frames are dropped.
+ * Both are counted as underruns and overruns. Tick times are derived from the start
+ * time rather than the previous tick, so the output rate does not drift.
+ *
+ * The encoder must already be open and is driven exclusively by the scheduler
+ * thread while it runs. Pushed frames must match its size and pixel format (sample
+ * format, rate and channel count for audio); their timestamps are ignored.
+ * Encoded packets are received in the encoder time base.
+ *
+ * @example
+ * ```typescript
+ * import { FrameScheduler, Packet } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * using scheduler = new FrameScheduler();
+ * scheduler.configure(encoderContext, { frameRate: { num: 30, den: 1 }, maxRepeats: 15 });
+ * scheduler.start();
+ *
+ * // Source side, whenever a frame arrives
+ * scheduler.pushFrame(frame);
+ *
+ * // Output side
+ * const packet = new Packet();
+ * packet.alloc();
+ * while ((await scheduler.receivePacket(packet)) !== AVERROR_EOF) {
+ *   await output.writePacket(packet, streamIndex);
+ * }
+ * ```
+ *
+ * @see {@link CodecContext} For encoder setup
+ */
+export class FrameScheduler implements Disposable, NativeWrapper<NativeFrameScheduler> {
+  private native: NativeFrameScheduler;
+
+  constructor() {
+    this.native = new bindings.FrameScheduler();
+  }
+
+  /**
+   * Whether the scheduler thread is running.
+   *
+   * Becomes false once the encoder has been flushed after {@link end} or on {@link stop}.
+   */
+  get isRunning(): boolean {
+    return this.native.isRunning;
+  }
+
+  /**
+   * Attach an opened encoder.
+   *
+   * @param encoder - Opened video or audio encoder context
+   *
+   * @param options - Scheduling options
+   *
+   * @param slate - Frame shown instead of black (matching the encoder size and format)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Encoder not open or already configured, invalid options, slate mismatch
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @throws {Error} If already started or the encoder context is invalid
+   */
+  configure(encoder: CodecContext, options: FrameSchedulerOptions = {}, slate?: Frame | null): number {
+    return this.native.configure(encoder.getNative(), { ...options, slate: slate?.getNative() });
+  }
+
+  /**
+   * Start the clock. The first tick is due immediately.
+   *
+   * Frames pushed before starting are encoded first.
+   *
+   * @returns 0 on success, AVERROR_EINVAL if not configured, already started or ended
+   */
+  start(): number {
+    return this.native.start();
+  }
+
+  /**
+   * Queue a source frame for the next tick.
+   *
+   * Takes a new reference, the frame can be reused right away.
+   *
+   * @param frame - Frame matching the encoder parameters
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not configured or frame does not match the encoder
+   *   - AVERROR_EOF: Scheduler ended or stopped
+   */
+  pushFrame(frame: Frame): number {
+    return this.native.pushFrame(frame.getNative());
+  }
+
+  /**
+   * Receive the next encoded packet.
+   *
+   * Waits until the encoder produced a packet.
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: Scheduler ended and encoder flushed, or stopped
+   *   - AVERROR_EINVAL: Not started
+   *   - Other: Encode error
+   *
+   * @see {@link receivePacketSync} For synchronous version
+   */
+  async receivePacket(packet: Packet): Promise<number> {
+    return await this.native.receivePacket(packet.getNative());
+  }
+
+  /**
+   * Receive the next encoded packet synchronously.
+   * Synchronous version of receivePacket.
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link receivePacket} For async version
+   */
+  receivePacketSync(packet: Packet): number {
+    return this.native.receivePacketSync(packet.getNative());
+  }
+
+  /**
+   * End the stream.
+   *
+   * Frames still queued are encoded without waiting for their ticks, then the
+   * encoder is flushed. Receive packets until AVERROR_EOF.
+   */
+  end(): void {
+    this.native.end();
+  }
+
+  /**
+   * Stop the clock immediately and discard queued frames and packets.
+   *
+   * The encoder is not flushed.
+   */
+  stop(): void {
+    this.native.stop();
+  }
+
+  /**
+   * Get tick, underrun and overrun counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): FrameSchedulerStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native FrameScheduler object.
+   *
+   * @returns The native FrameScheduler binding object
+   *
+   * @internal
+   */
+  getNative(): NativeFrameScheduler {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the scheduler.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -15,6 +15,7 @@ import type {
   AVPixelFormat,
   AVSampleFormat,
 } from '../constants/constants.js';
+import type { FrameArena } from './frame-arena.js';
 import type { NativeFrame, NativeWrapper } from './native-types.js';
 import type { ChannelLayout } from './types.js';
 
@@ -637,12 +638,16 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    *
    * Allocates buffers based on frame format and dimensions.
    * Frame parameters must be set before calling.
+   * With an arena, the planes are placed in a free arena slot instead.
    *
    * Direct mapping to av_frame_get_buffer().
    *
+   * @param arena - Allocate from this frame arena (optional)
+   *
    * @returns 0 on success, negative AVERROR on error:
    *   - AVERROR_EINVAL: Invalid frame parameters
    *   - AVERROR_ENOMEM: Memory allocation failure
+   *   - AVERROR_EAGAIN: No free arena slot
    *
    * @example
    * ```typescript
@@ -657,8 +662,13 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    * ```
    *
    * @see {@link getBuffer} To get required size
+   * @see {@link FrameArena} For shared memory allocation
    */
-  allocBuffer(): number {
+  allocBuffer(arena?: FrameArena): number {
+    if (arena) {
+      const slot = arena.allocFrame(this);
+      return slot < 0 ? slot : 0;
+    }
     return this.native.allocBuffer();
   }
 
@@ -754,7 +764,8 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    * Fill frame data from buffer.
    *
    * Copies data from buffer into frame data planes.
-   * Frame must have allocated buffers.
+   * Video frames without allocated buffers reference the buffer instead
+   * (same as {@link importBuffer} with alignment 1).
    *
    * @param buffer - Source buffer with frame data
    *
@@ -774,6 +785,49 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
     return this.native.fromBuffer(buffer);
   }
 
+  /**
+   * Use JavaScript memory as frame data without copying.
+   *
+   * Wraps the memory in a reference-counted buffer (av_buffer_create) and points
+   * the frame planes into it. The JavaScript object is kept alive until the last
+   * FFmpeg reference is released - including references taken by encoders or
+   * filters - so the memory may be reused once the frame and its references are gone.
+   * Any previous frame buffers are released.
+   *
+   * Format, width/height (video) or nbSamples/channelLayout (audio) must be set.
+   * The memory must hold the planes back to back with the given alignment
+   * and must not be detached or transferred while referenced.
+   *
+   * Direct mapping to av_buffer_create() + av_image_fill_arrays() / av_samples_fill_arrays().
+   *
+   * @param buffer - Memory holding the frame data
+   *
+   * @param align - Linesize alignment of the data (default: 1 = packed)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Frame not configured, hardware frame or buffer too small
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError } from 'node-av';
+   * import { AV_PIX_FMT_RGBA } from 'node-av/constants';
+   *
+   * // 60fps RGBA ingest from a renderer without copying
+   * frame.format = AV_PIX_FMT_RGBA;
+   * frame.width = 1920;
+   * frame.height = 1080;
+   * FFmpegError.throwIfError(frame.importBuffer(pixels), 'importBuffer');
+   * await encoder.encode(frame);
+   * ```
+   *
+   * @see {@link fromBuffer} To copy into allocated buffers
+   * @see {@link toBuffer} To export frame data
+   */
+  importBuffer(buffer: Buffer | ArrayBuffer | ArrayBufferView, align = 1): number {
+    return this.native.importBuffer(buffer, align);
+  }
+
   /**
    * Convert frame data to buffer.
    *
@@ -782,10 +836,19 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    * For audio frames, handles both planar and interleaved formats.
    * Cannot be used with hardware frames - use hwframeTransferData first.
    *
-   * @returns Buffer containing frame data
+   * When a target is given, data is written into it at `offset` instead of
+   * allocating a new buffer, and the number of bytes written is returned.
+   *
+   * @param target - Optional preallocated destination
+   *
+   * @param offset - Byte offset into the target (default: 0)
+   *
+   * @returns Buffer containing frame data, or bytes written into target
    *
    * @throws {Error} If frame is not allocated, has no data, or is a hardware frame
    *
+   * @throws {RangeError} If the target is too small
+   *
    * @example Video frame to buffer
    * ```typescript
    * // Get YUV420P video frame as buffer
@@ -819,13 +882,26 @@ export class Frame implements Disposable, NativeWrapper<NativeFrame> {
    * }
    * ```
    *
+   * @example Reusing a destination
+   * ```typescript
+   * const out = Buffer.allocUnsafe(frameSize);
+   * for await (const frame of decoder.frames(packets)) {
+   *   frame.toBuffer(out); // No allocation per frame
+   * }
+   * ```
+   *
    * @see {@link fromBuffer} To create frame from buffer
    * @see {@link hwframeTransferData} To transfer hardware frames to software
    * @see {@link isHwFrame} To check if frame is hardware
    * @see {@link data} To access individual planes
    */
-  toBuffer(): Buffer {
-    return this.native.toBuffer();
+  toBuffer(): Buffer;
+  toBuffer(target: Buffer | ArrayBuffer | ArrayBufferView, offset?: number): number;
+  toBuffer(target?: Buffer | ArrayBuffer | ArrayBufferView, offset = 0): Buffer | number {
+    if (target === undefined) {
+      return this.native.toBuffer();
+    }
+    return this.native.toBuffer(target, offset);
   }
 
   /**
@@ -0,0 +1,211 @@
+import { bindings } from './binding.js';
+
+import type { Dictionary } from './dictionary.js';
+import type { Frame } from './frame.js';
+import type { NativeImageSequenceWriter, NativeWrapper } from './native-types.js';
+import type { ImageSequenceResult, ImageSequenceWriterOptions, ImageSequenceWriterStats } from './types.js';
+
+/**
+ * Parallel image sequence writer.
+ *
+ * Writing `%05d.jpg` through the image2 muxer encodes every image one after another on a
+ * single codec context, although the images are independent. This class queues frames to
+ * a pool of native worker threads, each with its own single-threaded encoder, scaler and
+ * file handle, so N images are encoded and written at once.
+ *
+ * A frame's number is fixed when it is written, so files are numbered in write order no
+ * matter which worker finishes first, and per-image results are reported in that order.
+ * `write()` waits while `maxPending` images are queued or encoding, which bounds memory
+ * and open files.
+ *
+ * Each worker opens its encoder from the first frame it receives and reopens it when the
+ * frame size or format changes. Frames in a format the encoder does not support are
+ * converted to the closest supported format.
+ *
+ * @example
+ * ```typescript
+ * import { ImageSequenceWriter, FFmpegError } from 'node-av';
+ *
+ * const writer = new ImageSequenceWriter();
+ * FFmpegError.throwIfError(await writer.open({ pattern: 'stills/%06d.jpg', workers: 8, quality: 2 }), 'open');
+ *
+ * for await (const frame of decoder.frames(input.packets(video.index))) {
+ *   FFmpegError.throwIfError(await writer.write(frame), 'write');
+ *   frame.free();
+ * }
+ *
+ * FFmpegError.throwIfError(await writer.close(), 'close');
+ * console.log(writer.getStats());
+ * ```
+ *
+ * @see {@link ParallelDecoder} For the decoding counterpart
+ */
+export class ImageSequenceWriter implements Disposable, NativeWrapper<NativeImageSequenceWriter> {
+  private native: NativeImageSequenceWriter;
+
+  constructor() {
+    this.native = new bindings.ImageSequenceWriter();
+  }
+
+  /**
+   * Number of encoder workers.
+   */
+  get workers(): number {
+    return this.native.workers;
+  }
+
+  /**
+   * Number of images queued or encoding.
+   */
+  get pending(): number {
+    return this.native.pending;
+  }
+
+  /**
+   * Whether the writer is open.
+   */
+  get isOpen(): boolean {
+    return this.native.isOpen;
+  }
+
+  /**
+   * Open the writer and start the worker threads.
+   *
+   * Resets statistics and results.
+   *
+   * @param options - Filename pattern, encoder and pool size
+   *
+   * @param encoderOptions - Encoder options applied to every instance
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Already open, pattern without a sequence field or unknown extension
+   *   - AVERROR_ENCODER_NOT_FOUND: No encoder available
+   *
+   * @example
+   * ```typescript
+   * import { Dictionary } from 'node-av';
+   *
+   * const ret = await writer.open({ pattern: 'out/%05d.png', workers: 4 }, Dictionary.fromObject({ compression_level: 3 }));
+   * ```
+   *
+   * @see {@link openSync} For synchronous version
+   */
+  async open(options: ImageSequenceWriterOptions, encoderOptions: Dictionary | null = null): Promise<number> {
+    return await this.native.open(options, encoderOptions?.getNative() ?? null);
+  }
+
+  /**
+   * Open the writer synchronously.
+   * Synchronous version of open.
+   *
+   * @param options - Filename pattern, encoder and pool size
+   *
+   * @param encoderOptions - Encoder options applied to every instance
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link open} For async version
+   */
+  openSync(options: ImageSequenceWriterOptions, encoderOptions: Dictionary | null = null): number {
+    return this.native.openSync(options, encoderOptions?.getNative() ?? null);
+  }
+
+  /**
+   * Queue a frame as the next image.
+   *
+   * The frame is referenced, not copied, and can be freed right after.
+   * Waits while `maxPending` images are in flight. Encoding and write errors are
+   * reported by {@link readResults}, {@link getStats} and {@link close}.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not open, hardware or invalid frame
+   *   - AVERROR_EXIT: Writer closed while waiting
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @see {@link writeSync} For synchronous version
+   */
+  async write(frame: Frame): Promise<number> {
+    return await this.native.write(frame.getNative());
+  }
+
+  /**
+   * Queue a frame as the next image synchronously.
+   * Synchronous version of write, blocks while `maxPending` images are in flight.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link write} For async version
+   */
+  writeSync(frame: Frame): number {
+    return this.native.writeSync(frame.getNative());
+  }
+
+  /**
+   * Wait for all queued images and stop the workers.
+   *
+   * @returns 0 if every image was written, else the first error
+   *
+   * @see {@link closeSync} For synchronous version
+   */
+  async close(): Promise<number> {
+    return await this.native.close();
+  }
+
+  /**
+   * Wait for all queued images and stop the workers synchronously.
+   * Synchronous version of close.
+   *
+   * @returns 0 if every image was written, else the first error
+   *
+   * @see {@link close} For async version
+   */
+  closeSync(): number {
+    return this.native.closeSync();
+  }
+
+  /**
+   * Take the results of finished images.
+   *
+   * Requires `collectResults`. Returns results in sequence order, up to the first
+   * image that is still in flight; later results follow with the next call.
+   *
+   * @returns Results since the last call
+   */
+  readResults(): ImageSequenceResult[] {
+    return this.native.readResults();
+  }
+
+  /**
+   * Get writer statistics.
+   *
+   * @returns Image, byte and latency counters
+   */
+  getStats(): ImageSequenceWriterStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native ImageSequenceWriter object.
+   *
+   * @returns The native ImageSequenceWriter binding object
+   *
+   * @internal
+   */
+  getNative(): NativeImageSequenceWriter {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the writer.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Stops the workers and discards queued images; use {@link close} to finish them.
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
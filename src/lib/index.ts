@@ -41,9 +41,57 @@ export { SoftwareResampleContext } from './software-resample-context.js';
 // Audio FIFO
 export { AudioFifo } from './audio-fifo.js';
 
+// Parallel Decoder
+export { ParallelDecoder } from './parallel-decoder.js';
+
+// Demux Dispatcher
+export { DemuxDispatcher } from './demux-dispatcher.js';
+
+// Frame Cache
+export { FrameCache } from './frame-cache.js';
+
+// Media Hasher
+export { MediaHasher } from './media-hasher.js';
+
+// Frame Arena
+export { FrameArena } from './frame-arena.js';
+
+// Packet Allocator
+export { PacketAllocator } from './packet-allocator.js';
+
+// Packet Recorder
+export { PacketRecorder } from './packet-recorder.js';
+
+// Frame Scheduler
+export { FrameScheduler } from './frame-scheduler.js';
+
+// Packet Router
+export { PacketRouter } from './packet-router.js';
+
+// Shared Memory Channel
+export { SharedMemoryChannel } from './shared-memory-channel.js';
+
+// Smart Cutter
+export { SmartCutter } from './smart-cutter.js';
+
+// Scene Analyzer
+export { SceneAnalyzer } from './scene-analyzer.js';
+
+// Color Transform
+export { ColorTransform } from './color-transform.js';
+
+// Logo Overlay
+export { LogoOverlay } from './logo-overlay.js';
+
+// Image Sequence Writer
+export { ImageSequenceWriter } from './image-sequence-writer.js';
+
 // I/O Context
 export { IOContext } from './io-context.js';
 
+// Concat Input
+export { ConcatInput } from './concat-input.js';
+
 // Dictionary
 export { Dictionary } from './dictionary.js';
 
@@ -4,6 +4,7 @@ import { OptionMember } from './option.js';
 
 import type { AVIOFlag, AVSeekWhence } from '../constants/constants.js';
 import type { NativeIOContext, NativeWrapper } from './native-types.js';
+import type { FileIOOptions, FileIOStats, HttpIOOptions, HttpIOStats, IOCallbackOptions, IOCallbackStats } from './types.js';
 
 /**
  * I/O context for custom input/output operations.
@@ -228,18 +229,27 @@ export class IOContext extends OptionMember<NativeIOContext> implements AsyncDis
    * which is blocked during synchronous operations. Always use async methods
    * (read, seek) when working with custom callbacks.
    *
+   * The read callback may return more bytes than requested: the rest is copied
+   * and handed to FFmpeg by the following reads before the
+   * callback is called again. With `options.adaptive` the size passed to the
+   * read callback follows the source: it doubles while the callback fills it
+   * and halves when the callback returns much less (live sources).
+   *
    * Direct mapping to avio_alloc_context() with callbacks.
    *
    * @param bufferSize - Size of internal buffer
    *
    * @param writeFlag - 1 for write mode, 0 for read mode
    *
-   * @param readCallback - Function to read data (null for write-only)
+   * @param readCallback - Function to read data (null for write-only).
+   *   Returned buffers may be reused once the callback returned.
    *
    * @param writeCallback - Function to write data (null for read-only)
    *
    * @param seekCallback - Function to seek in stream (optional)
    *
+   * @param options - Adaptive read size
+   *
    * @example
    * ```typescript
    * import { AVSEEK_SET, AVSEEK_CUR, AVSEEK_END, AVSEEK_SIZE } from 'node-av/constants';
@@ -277,8 +287,9 @@ export class IOContext extends OptionMember<NativeIOContext> implements AsyncDis
     readCallback?: ((size: number) => Buffer | null | number) | null,
     writeCallback?: ((buffer: Buffer) => number | void) | null,
     seekCallback?: ((offset: bigint, whence: number) => bigint | number) | null,
+    options?: IOCallbackOptions,
   ): void {
-    this.native.allocContextWithCallbacks(bufferSize, writeFlag, readCallback ?? undefined, writeCallback ?? undefined, seekCallback ?? undefined);
+    this.native.allocContextWithCallbacks(bufferSize, writeFlag, readCallback ?? undefined, writeCallback ?? undefined, seekCallback ?? undefined, options);
   }
 
   /**
@@ -374,6 +385,163 @@ export class IOContext extends OptionMember<NativeIOContext> implements AsyncDis
     return this.native.open2Sync(url, flags);
   }
 
+  /**
+   * Open a local file with the native file backend.
+   *
+   * Bypasses FFmpeg's `file:` protocol. Reads keep several blocks of readahead
+   * in flight, writes are coalesced into large blocks and submitted
+   * asynchronously with a bounded number of pending buffers. Requests go
+   * through io_uring on Linux (batched, few syscalls) and through a
+   * pread/pwrite worker thread elsewhere or when io_uring is unavailable.
+   *
+   * Files are opened either for reading or for writing (truncated).
+   * Close with {@link closep} or {@link freeContext}.
+   *
+   * @param url - File path, optionally with `file:` prefix
+   *
+   * @param flags - AVIO_FLAG_READ or AVIO_FLAG_WRITE
+   *
+   * @param options - Engine, queue depth and block size
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENOENT: File not found
+   *   - AVERROR_EINVAL: Invalid flags or options
+   *   - AVERROR_ENOSYS: Backend not supported on this platform, or 'uring' requested but unavailable
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError, FormatContext, IOContext } from 'node-av';
+   * import { AVIO_FLAG_READ } from 'node-av/constants';
+   *
+   * const io = new IOContext();
+   * FFmpegError.throwIfError(await io.openFile('input.mp4', AVIO_FLAG_READ, { queueDepth: 16 }), 'openFile');
+   *
+   * const fmt = new FormatContext();
+   * fmt.allocContext();
+   * fmt.pb = io;
+   * await fmt.openInput('input.mp4', null, null);
+   * // ...
+   * console.log(io.getFileStats());
+   * ```
+   *
+   * @see {@link openFileSync} For synchronous version
+   * @see {@link getFileStats} For throughput and syscall counters
+   */
+  async openFile(url: string, flags: AVIOFlag = AVIO_FLAG_READ, options?: FileIOOptions): Promise<number> {
+    return await this.native.openFile(url, flags, options);
+  }
+
+  /**
+   * Open a local file with the native file backend synchronously.
+   * Synchronous version of openFile.
+   *
+   * @param url - File path, optionally with `file:` prefix
+   *
+   * @param flags - AVIO_FLAG_READ or AVIO_FLAG_WRITE
+   *
+   * @param options - Engine, queue depth and block size
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link openFile} For async version
+   */
+  openFileSync(url: string, flags: AVIOFlag = AVIO_FLAG_READ, options?: FileIOOptions): number {
+    return this.native.openFileSync(url, flags, options);
+  }
+
+  /**
+   * Get native file backend statistics.
+   *
+   * @returns Counters, or null if not opened with {@link openFile}
+   */
+  getFileStats(): FileIOStats | null {
+    return this.native.getFileStats();
+  }
+
+  /**
+   * Open an HTTP(S) resource with the native HTTP backend.
+   *
+   * Bypasses FFmpeg's `http:` protocol. The resource is split into blocks that
+   * worker threads fetch with parallel byte-range requests over keep-alive
+   * connections (TCP/TLS through FFmpeg), ahead of the read position. Fetched
+   * blocks are cached in memory and optionally in a temporary file, so
+   * seek-heavy access - MP4s with `moov` at the end, index lookups, scrubbing -
+   * does not pay a round trip per seek.
+   *
+   * Opening fetches the first block and follows redirects. Servers that ignore
+   * Range requests are read sequentially (not seekable).
+   * Close with {@link closep} or {@link freeContext}.
+   *
+   * @param url - http:// or https:// URL
+   *
+   * @param options - Connections, block size, prefetch depth and cache limits
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_HTTP_NOT_FOUND, AVERROR_HTTP_FORBIDDEN, ...: HTTP error status
+   *   - AVERROR(EPROTONOSUPPORT): Not an http(s) URL
+   *   - AVERROR_EINVAL: Invalid URL or options
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError, FormatContext, IOContext } from 'node-av';
+   *
+   * const url = 'https://example.com/video.mp4';
+   * const io = new IOContext();
+   * FFmpegError.throwIfError(await io.openHttp(url, { connections: 4, diskCacheSize: 256 * 1024 * 1024 }), 'openHttp');
+   *
+   * const fmt = new FormatContext();
+   * fmt.allocContext();
+   * fmt.pb = io;
+   * await fmt.openInput(url, null, null);
+   * // ...
+   * console.log(io.getHttpStats());
+   * ```
+   *
+   * @see {@link openHttpSync} For synchronous version
+   * @see {@link getHttpStats} For request and cache counters
+   */
+  async openHttp(url: string, options?: HttpIOOptions): Promise<number> {
+    return await this.native.openHttp(url, options);
+  }
+
+  /**
+   * Open an HTTP(S) resource with the native HTTP backend synchronously.
+   * Synchronous version of openHttp.
+   *
+   * Blocks the calling thread for the first request.
+   *
+   * @param url - http:// or https:// URL
+   *
+   * @param options - Connections, block size, prefetch depth and cache limits
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link openHttp} For async version
+   */
+  openHttpSync(url: string, options?: HttpIOOptions): number {
+    return this.native.openHttpSync(url, options);
+  }
+
+  /**
+   * Get native HTTP backend statistics.
+   *
+   * @returns Counters, or null if not opened with {@link openHttp}
+   */
+  getHttpStats(): HttpIOStats | null {
+    return this.native.getHttpStats();
+  }
+
+  /**
+   * Get read callback statistics.
+   *
+   * @returns Counters, or null if not created with a read callback
+   *
+   * @see {@link allocContextWithCallbacks}
+   */
+  getCallbackStats(): IOCallbackStats | null {
+    return this.native.getCallbackStats();
+  }
+
   /**
    * Close I/O context.
    *
@@ -0,0 +1,145 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeLogoOverlay, NativeWrapper } from './native-types.js';
+import type { LogoOverlayOptions, LogoOverlayStats } from './types.js';
+
+/**
+ * Static logo (watermark) blended into video frames in place.
+ *
+ * The `overlay` filter needs a two-input filter graph per stream and converts the logo
+ * for every graph. The overlay takes an RGBA image once and prepares it per target pixel
+ * format and color description: converted to the frame's matrix and range, premultiplied
+ * with its alpha, chroma-subsampled and cropped to its visible pixels. Blending then only
+ * touches the logo's bounding box with one multiply-add per sample.
+ *
+ * The prepared planes are immutable, so a single overlay can be applied to the frames of
+ * many streams concurrently. Supports planar 8 to 12-bit YUV frames.
+ *
+ * @example
+ * ```typescript
+ * import { LogoOverlay, FFmpegError, Frame, AV_PIX_FMT_RGBA } from 'node-av';
+ *
+ * const logo = new Frame();
+ * logo.alloc();
+ * logo.format = AV_PIX_FMT_RGBA;
+ * logo.width = 200;
+ * logo.height = 80;
+ * FFmpegError.throwIfError(logo.fromBuffer(rgbaPixels), 'fromBuffer');
+ *
+ * // 20 pixels from the right and bottom edges
+ * const overlay = new LogoOverlay();
+ * FFmpegError.throwIfError(overlay.alloc(logo, { x: -20, y: -20, opacity: 0.8 }), 'alloc');
+ * logo.free();
+ *
+ * for await (const frame of decoder.frames(input.packets(video.index))) {
+ *   FFmpegError.throwIfError(await overlay.apply(frame), 'apply');
+ *   await encoder.encode(frame);
+ *   frame.free();
+ * }
+ * ```
+ */
+export class LogoOverlay implements Disposable, NativeWrapper<NativeLogoOverlay> {
+  private native: NativeLogoOverlay;
+
+  constructor() {
+    this.native = new bindings.LogoOverlay();
+  }
+
+  /**
+   * Allocate the overlay with a logo.
+   *
+   * The logo is copied; the frame can be freed afterwards. Resets statistics.
+   *
+   * @param logo - Packed 8-bit RGB frame with straight alpha (RGBA, BGRA, ARGB or ABGR)
+   *
+   * @param options - Position and opacity
+   *
+   * @returns 0 on success, AVERROR_EINVAL on an unsupported logo format or invalid options
+   */
+  alloc(logo: Frame, options: LogoOverlayOptions = {}): number {
+    return this.native.alloc(logo.getNative(), options);
+  }
+
+  /**
+   * Free the overlay.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Blend the logo into a frame.
+   *
+   * The frame is made writable first if its buffers are shared (e.g. with decoder references).
+   * Frames the logo does not intersect are left untouched.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not allocated, hardware or unsupported frame
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @see {@link applySync} For synchronous version
+   */
+  async apply(frame: Frame): Promise<number> {
+    return await this.native.apply(frame.getNative());
+  }
+
+  /**
+   * Blend the logo into a frame synchronously.
+   * Synchronous version of apply.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link apply} For async version
+   */
+  applySync(frame: Frame): number {
+    return this.native.applySync(frame.getNative());
+  }
+
+  /**
+   * Move the logo.
+   *
+   * Takes effect with the next frame; prepared planes are kept.
+   *
+   * @param x - Left edge, negative for the distance of the right edge from the frame's right edge
+   *
+   * @param y - Top edge, negative for the distance of the bottom edge from the frame's bottom edge
+   */
+  setPosition(x: number, y: number): void {
+    this.native.setPosition(x, y);
+  }
+
+  /**
+   * Get overlay statistics.
+   *
+   * @returns Blended and skipped frames and prepared formats
+   */
+  getStats(): LogoOverlayStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native LogoOverlay object.
+   *
+   * @returns The native LogoOverlay binding object
+   *
+   * @internal
+   */
+  getNative(): NativeLogoOverlay {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the overlay.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,289 @@
+import { bindings } from './binding.js';
+
+import type { CodecParameters } from './codec-parameters.js';
+import type { Frame } from './frame.js';
+import type { NativeMediaHasher, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { IRational, MediaHashEntries } from './types.js';
+
+/**
+ * Per-frame and per-packet hashing for QC and regression testing.
+ *
+ * Hashes decoded frames and packet payloads natively with any libavutil hash
+ * (MD5, murmur3, CRC32, SHA-1/2, ...). Video planes are hashed row by row honoring
+ * linesize, so no `toBuffer()` copy is made and padding never affects the digest.
+ * Frame digests match a rawvideo / packed PCM encoding of the frame, which makes
+ * MD5 output comparable with `ffmpeg -f framemd5`.
+ *
+ * Results are kept in compact typed arrays ({@link getEntries}) and can be rendered
+ * as framemd5 text ({@link toFrameMd5}). Use murmur3 when only speed matters.
+ *
+ * Frames and packets can be hashed one by one, as a pass-through stage of a
+ * pipeline ({@link hashFrames}, {@link hashPackets}), or with a standalone
+ * {@link scan} that demuxes and decodes a file on a worker thread.
+ *
+ * @example
+ * ```typescript
+ * import { MediaHasher, FFmpegError } from 'node-av';
+ *
+ * const hasher = new MediaHasher();
+ * FFmpegError.throwIfError(hasher.alloc('md5'), 'alloc');
+ *
+ * // Hash every decoded frame of a file
+ * FFmpegError.throwIfError(await hasher.scan('input.mp4', 'frames'), 'scan');
+ * console.log(hasher.toFrameMd5());
+ * ```
+ *
+ * @example
+ * ```typescript
+ * import { MediaHasher } from 'node-av';
+ * import { Decoder, Encoder, MediaInput, MediaOutput, pipeline } from 'node-av/api';
+ *
+ * // Hash frames on their way to the encoder
+ * const hasher = new MediaHasher();
+ * hasher.alloc('murmur3');
+ *
+ * const frames = hasher.hashFrames(decoder.frames(input.packets(video.index)));
+ * await pipeline(frames, encoder, output).completion;
+ * ```
+ *
+ * @see {@link Frame} For frame data
+ * @see {@link Packet} For packet data
+ */
+export class MediaHasher implements Disposable, NativeWrapper<NativeMediaHasher> {
+  private native: NativeMediaHasher;
+
+  constructor() {
+    this.native = new bindings.MediaHasher();
+  }
+
+  /**
+   * Name of the hash algorithm (e.g. 'MD5', 'murmur3').
+   *
+   * Null if not allocated.
+   */
+  get algorithm(): string | null {
+    return this.native.algorithm;
+  }
+
+  /**
+   * Digest size in bytes.
+   */
+  get digestSize(): number {
+    return this.native.digestSize;
+  }
+
+  /**
+   * Number of hashed entries.
+   */
+  get count(): number {
+    return this.native.count;
+  }
+
+  /**
+   * Allocate the hasher.
+   *
+   * Discards previous results.
+   *
+   * @param algorithm - libavutil hash name, case-insensitive (default: 'md5')
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Unknown algorithm
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @example
+   * ```typescript
+   * const hasher = new MediaHasher();
+   * hasher.alloc('murmur3');
+   * ```
+   */
+  alloc(algorithm = 'md5'): number {
+    return this.native.alloc(algorithm);
+  }
+
+  /**
+   * Free the hasher and all results.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Hash a decoded frame.
+   *
+   * @param frame - Software audio or video frame
+   *
+   * @param streamIndex - Stream index to record (default: 0)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not allocated, hardware or empty frame
+   */
+  addFrame(frame: Frame, streamIndex = 0): number {
+    return this.native.addFrame(frame.getNative(), streamIndex);
+  }
+
+  /**
+   * Hash a packet payload.
+   *
+   * The packet's stream index is recorded.
+   *
+   * @param packet - Packet to hash
+   *
+   * @returns 0 on success, AVERROR_EINVAL if not allocated
+   */
+  addPacket(packet: Packet): number {
+    return this.native.addPacket(packet.getNative());
+  }
+
+  /**
+   * Describe a stream for the framemd5 header.
+   *
+   * Frames describe their stream automatically; packets only carry a time base.
+   *
+   * @param streamIndex - Stream index
+   *
+   * @param codecpar - Stream codec parameters
+   *
+   * @param timeBase - Stream time base
+   */
+  setStream(streamIndex: number, codecpar: CodecParameters, timeBase: IRational): void {
+    this.native.setStream(streamIndex, codecpar.getNative(), timeBase);
+  }
+
+  /**
+   * Hash a whole file.
+   *
+   * Opens the file on a worker thread and hashes every packet, or decodes
+   * all audio/video streams and hashes every frame. Results are appended.
+   *
+   * @param url - Input URL
+   *
+   * @param mode - Hash 'packets' (default) or decoded 'frames'
+   *
+   * @param streamIndex - Only hash this stream (default: all)
+   *
+   * @returns Number of hashed entries, or negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not allocated
+   *   - AVERROR_STREAM_NOT_FOUND: Invalid stream index
+   *   - Other: Demuxer or decoder errors
+   *
+   * @see {@link scanSync} For synchronous version
+   */
+  async scan(url: string, mode: 'packets' | 'frames' = 'packets', streamIndex = -1): Promise<number> {
+    return await this.native.scan(url, mode, streamIndex);
+  }
+
+  /**
+   * Hash a whole file synchronously.
+   * Synchronous version of scan.
+   *
+   * @param url - Input URL
+   *
+   * @param mode - Hash 'packets' (default) or decoded 'frames'
+   *
+   * @param streamIndex - Only hash this stream (default: all)
+   *
+   * @returns Number of hashed entries, or negative AVERROR on error
+   *
+   * @see {@link scan} For async version
+   */
+  scanSync(url: string, mode: 'packets' | 'frames' = 'packets', streamIndex = -1): number {
+    return this.native.scanSync(url, mode, streamIndex);
+  }
+
+  /**
+   * Hash frames passing through a pipeline.
+   *
+   * Yields every frame unchanged after hashing it.
+   *
+   * @param frames - Frame source
+   *
+   * @param streamIndex - Stream index to record (default: 0)
+   *
+   * @yields {Frame} The input frames
+   */
+  async *hashFrames(frames: AsyncIterable<Frame>, streamIndex = 0): AsyncGenerator<Frame> {
+    for await (const frame of frames) {
+      this.addFrame(frame, streamIndex);
+      yield frame;
+    }
+  }
+
+  /**
+   * Hash packets passing through a pipeline.
+   *
+   * Yields every packet unchanged after hashing it.
+   *
+   * @param packets - Packet source
+   *
+   * @yields {Packet} The input packets
+   */
+  async *hashPackets(packets: AsyncIterable<Packet>): AsyncGenerator<Packet> {
+    for await (const packet of packets) {
+      this.addPacket(packet);
+      yield packet;
+    }
+  }
+
+  /**
+   * Get all results as compact arrays.
+   *
+   * @returns Entry arrays and concatenated digests
+   */
+  getEntries(): MediaHashEntries {
+    return this.native.getEntries();
+  }
+
+  /**
+   * Get the digest of one entry as hex string.
+   *
+   * @param index - Entry index
+   *
+   * @returns Hex digest or null for an invalid index
+   */
+  getHash(index: number): string | null {
+    return this.native.getHash(index);
+  }
+
+  /**
+   * Render all results in framemd5 / framehash format.
+   *
+   * @returns framemd5 text or null if not allocated
+   *
+   * @example
+   * ```typescript
+   * await fs.writeFile('out.framemd5', hasher.toFrameMd5() ?? '');
+   * ```
+   */
+  toFrameMd5(): string | null {
+    return this.native.toFrameMd5();
+  }
+
+  /**
+   * Discard all results but keep the algorithm.
+   */
+  clear(): void {
+    this.native.clear();
+  }
+
+  /**
+   * Get the underlying native MediaHasher object.
+   *
+   * @returns The native MediaHasher binding object
+   *
+   * @internal
+   */
+  getNative(): NativeMediaHasher {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the hasher.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
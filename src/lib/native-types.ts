@@ -45,7 +45,7 @@ import type {
   AVSampleFormat,
   AVStreamEventFlag,
 } from '../constants/index.js';
-import type { ChannelLayout, CodecProfile, FilterPad, IRational } from './types.js';
+import type { ChannelLayout, CodecProfile, CodecReconfigureOptions, CodecReconfigureStats, ColorTransformOptions, ColorTransformStats, DemuxDispatcherStats, FileIOOptions, FileIOStats, FilterPad, FrameArenaStats, FrameCacheStats, FrameSchedulerOptions, FrameSchedulerStats, HttpIOOptions, HttpIOStats, IOCallbackOptions, IOCallbackStats, IRational, ImageSequenceResult, ImageSequenceWriterOptions, ImageSequenceWriterStats, LogoOverlayOptions, LogoOverlayStats, MediaHashEntries, PacketAllocatorOptions, PacketAllocatorStats, PacketRouterStats, PacketTraceOptions, PacketTraceStats, ReadRateOptions, ReadRateStats, SceneAnalysis, SceneAnalyzerOptions, SceneAnalyzerStats, SharedMemoryChannelStats, SharedMemoryRole, SmartCutOptions, SmartCutStats } from './types.js';
 
 /**
  * Native AVPacket binding interface
@@ -72,7 +72,7 @@ export interface NativePacket extends Disposable {
   free(): void;
   ref(src: NativePacket): number;
   unref(): void;
-  clone(): NativePacket | null;
+  clone(allocator?: NativePacketAllocator | null): NativePacket | null;
   rescaleTs(srcTb: IRational, dstTb: IRational): void;
   makeRefcounted(): number;
   makeWritable(): number;
@@ -131,7 +131,9 @@ export interface NativeFrame extends Disposable {
   copyProps(src: NativeFrame): number;
   copy(src: NativeFrame): number;
   fromBuffer(buffer: Buffer): number;
+  importBuffer(buffer: Buffer | ArrayBuffer | ArrayBufferView, align?: number): number;
   toBuffer(): Buffer;
+  toBuffer(target: Buffer | ArrayBuffer | ArrayBufferView, offset?: number): number;
   hwframeTransferData(dst: NativeFrame, flags?: number): Promise<number>;
   hwframeTransferDataSync(dst: NativeFrame, flags?: number): number;
   isHwFrame(): boolean;
@@ -243,6 +245,10 @@ export interface NativeCodecContext extends Disposable {
   receivePacket(packet: NativePacket): Promise<number>;
   receivePacketSync(packet: NativePacket): number;
   setHardwarePixelFormat(hwFormat: AVPixelFormat, swFormat?: AVPixelFormat): void;
+  setFrameArena(arena: NativeFrameArena | null): void;
+  setPacketAllocator(allocator: NativePacketAllocator | null): void;
+  reconfigure(options: CodecReconfigureOptions): number;
+  getReconfigureStats(): CodecReconfigureStats;
 
   [Symbol.dispose](): void;
 }
@@ -350,10 +356,18 @@ export interface NativeIOContext extends AsyncDisposable {
     readCallback?: (size: number) => Buffer | null | number,
     writeCallback?: (buffer: Buffer) => number | void,
     seekCallback?: (offset: bigint, whence: AVSeekWhence) => bigint | number,
+    options?: IOCallbackOptions,
   ): void;
   freeContext(): void;
   open2(url: string, flags: AVIOFlag): Promise<number>;
   open2Sync(url: string, flags: AVIOFlag): number;
+  openFile(url: string, flags: AVIOFlag, options?: FileIOOptions): Promise<number>;
+  openFileSync(url: string, flags: AVIOFlag, options?: FileIOOptions): number;
+  getFileStats(): FileIOStats | null;
+  openHttp(url: string, options?: HttpIOOptions): Promise<number>;
+  openHttpSync(url: string, options?: HttpIOOptions): number;
+  getHttpStats(): HttpIOStats | null;
+  getCallbackStats(): IOCallbackStats | null;
   closep(): Promise<number>;
   closepSync(): number;
   read(size: number): Promise<Buffer | number>;
@@ -492,6 +506,12 @@ export interface NativeFormatContext extends AsyncDisposable {
   findStreamInfoSync(options: NativeDictionary | null): number;
   readFrame(pkt: NativePacket): Promise<number>;
   readFrameSync(pkt: NativePacket): number;
+  setPacketAllocator(allocator: NativePacketAllocator | null): void;
+  setPacketRecorder(recorder: NativePacketRecorder | null): number;
+  setReadRate(options: ReadRateOptions | null): number;
+  getReadRateStats(): ReadRateStats | null;
+  openTrace(path: string, options?: PacketTraceOptions): Promise<number>;
+  openTraceSync(path: string, options?: PacketTraceOptions): number;
   seekFrame(streamIndex: number, timestamp: bigint, flags: AVSeekFlag): Promise<number>;
   seekFrameSync(streamIndex: number, timestamp: bigint, flags: AVSeekFlag): number;
   seekFile(streamIndex: number, minTs: bigint, ts: bigint, maxTs: bigint, flags: AVSeekFlag): Promise<number>;
@@ -564,6 +584,401 @@ export interface NativeAudioFifo extends Disposable {
   realloc(nbSamples: number): number;
 }
 
+/**
+ * Native ParallelDecoder binding interface
+ *
+ * Pool of single-threaded decoder instances for intra-only codecs.
+ * Packets are distributed round-robin and frames are returned in submission order.
+ *
+ * @internal
+ */
+export interface NativeParallelDecoder extends Disposable {
+  readonly __brand: 'NativeParallelDecoder';
+
+  readonly workers: number;
+  readonly pending: number;
+  readonly isOpen: boolean;
+
+  open(codecpar: NativeCodecParameters, count: number, options?: NativeDictionary | null, pktTimebase?: IRational): Promise<number>;
+  openSync(codecpar: NativeCodecParameters, count: number, options?: NativeDictionary | null, pktTimebase?: IRational): number;
+  close(): void;
+  sendPacket(packet: NativePacket | null): Promise<number>;
+  sendPacketSync(packet: NativePacket | null): number;
+  receiveFrame(frame: NativeFrame, wait?: boolean): Promise<number>;
+  receiveFrameSync(frame: NativeFrame, wait?: boolean): number;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native DemuxDispatcher binding interface
+ *
+ * Reads an input on a native thread and decodes every attached stream on its own thread.
+ * Decoded frames are queued per stream or encoded and muxed directly into an output.
+ *
+ * @internal
+ */
+export interface NativeDemuxDispatcher extends Disposable {
+  readonly __brand: 'NativeDemuxDispatcher';
+
+  readonly isRunning: boolean;
+
+  setInput(formatContext: NativeFormatContext, queueSize?: number): void;
+  setOutput(formatContext: NativeFormatContext): void;
+  addStream(streamIndex: number, decoder: NativeCodecContext, encoder?: NativeCodecContext | null, outputStreamIndex?: number): number;
+  start(): number;
+  receiveFrame(streamIndex: number, frame: NativeFrame): Promise<number>;
+  receiveFrameSync(streamIndex: number, frame: NativeFrame): number;
+  wait(): Promise<number>;
+  waitSync(): number;
+  stop(): void;
+  getStats(): DemuxDispatcherStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native FrameCache binding interface
+ *
+ * LRU cache of decoded frames with a byte budget and background prefetching.
+ *
+ * @internal
+ */
+export interface NativeFrameCache extends Disposable {
+  readonly __brand: 'NativeFrameCache';
+
+  readonly bytes: number;
+  readonly entries: number;
+  readonly maxBytes: number;
+
+  alloc(maxBytes: number, scaleWidth?: number, scaleHeight?: number): void;
+  free(): void;
+  put(input: string, streamIndex: number, pts: bigint, frame: NativeFrame): number;
+  get(input: string, streamIndex: number, pts: bigint, frame: NativeFrame): number;
+  has(input: string, streamIndex: number, pts: bigint): boolean;
+  clear(): void;
+  prefetch(url: string, streamIndex: number, pts: bigint, before: bigint, after: bigint): number;
+  getStats(): FrameCacheStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native FrameArena binding interface
+ *
+ * Slot allocator for frame buffers inside caller-provided (shared) memory.
+ *
+ * @internal
+ */
+export interface NativeFrameArena extends Disposable {
+  readonly __brand: 'NativeFrameArena';
+
+  readonly slotCount: number;
+  readonly slotSize: number;
+  readonly freeSlots: number;
+
+  alloc(memory: ArrayBufferView | ArrayBuffer, slotSize: number, align?: number): number;
+  free(): void;
+  allocFrame(frame: NativeFrame): number;
+  pin(frame: NativeFrame): number;
+  release(slot: number): number;
+  slotOf(frame: NativeFrame): number;
+  slotOffset(slot: number): number;
+  getStats(): FrameArenaStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native PacketAllocator binding interface
+ *
+ * Slab allocator for small packet payloads.
+ *
+ * @internal
+ */
+export interface NativePacketAllocator extends Disposable {
+  readonly __brand: 'NativePacketAllocator';
+
+  readonly maxSize: number;
+
+  alloc(options?: PacketAllocatorOptions): number;
+  free(): void;
+  allocPacket(packet: NativePacket, size: number): number;
+  adopt(packet: NativePacket): number;
+  getStats(): PacketAllocatorStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native PacketRecorder binding interface
+ *
+ * Captures demuxed packets into a replayable trace file.
+ *
+ * @internal
+ */
+export interface NativePacketRecorder extends Disposable {
+  readonly __brand: 'NativePacketRecorder';
+
+  readonly isOpen: boolean;
+
+  open(path: string): number;
+  close(): number;
+  getStats(): PacketTraceStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native FrameScheduler binding interface
+ *
+ * Feeds an encoder at a constant frame rate from a native clock thread.
+ *
+ * @internal
+ */
+export interface NativeFrameScheduler extends Disposable {
+  readonly __brand: 'NativeFrameScheduler';
+
+  readonly isRunning: boolean;
+
+  configure(encoder: NativeCodecContext, options?: FrameSchedulerOptions & { slate?: NativeFrame }): number;
+  start(): number;
+  pushFrame(frame: NativeFrame): number;
+  receivePacket(packet: NativePacket): Promise<number>;
+  receivePacketSync(packet: NativePacket): number;
+  end(): void;
+  stop(): void;
+  getStats(): FrameSchedulerStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native PacketRouter binding interface
+ *
+ * Reads an input on a native thread and routes packets to JS queues or copies them into outputs.
+ *
+ * @internal
+ */
+export interface NativePacketRouter extends Disposable {
+  readonly __brand: 'NativePacketRouter';
+
+  readonly isRunning: boolean;
+
+  setInput(formatContext: NativeFormatContext, queueSize?: number): void;
+  addRoute(streamIndex: number): number;
+  addPassthrough(streamIndex: number, output: NativeFormatContext, outputStreamIndex: number): number;
+  start(): number;
+  receivePacket(route: number, packet: NativePacket): Promise<number>;
+  receivePacketSync(route: number, packet: NativePacket): number;
+  closeRoute(route: number): number;
+  flush(): number;
+  wait(): Promise<number>;
+  waitSync(): number;
+  stop(): void;
+  getStats(): PacketRouterStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native SharedMemoryChannel binding interface
+ *
+ * Ring buffer in a named shared-memory segment carrying packets and frames between processes.
+ *
+ * @internal
+ */
+export interface NativeSharedMemoryChannel extends Disposable {
+  readonly __brand: 'NativeSharedMemoryChannel';
+
+  readonly name: string | null;
+  readonly role: SharedMemoryRole | null;
+  readonly size: number;
+  readonly used: number;
+
+  create(name: string, role: SharedMemoryRole, size: number, zeroCopy?: boolean): number;
+  open(name: string, role: SharedMemoryRole, zeroCopy?: boolean): number;
+  addStream(codecpar: NativeCodecParameters, timeBase: IRational): number;
+  sendPacket(packet: NativePacket): Promise<number>;
+  sendPacketSync(packet: NativePacket): number;
+  sendFrame(frame: NativeFrame, streamIndex?: number): Promise<number>;
+  sendFrameSync(frame: NativeFrame, streamIndex?: number): number;
+  allocFrame(frame: NativeFrame): Promise<number>;
+  allocFrameSync(frame: NativeFrame): number;
+  end(): number;
+  receiveStream(codecpar: NativeCodecParameters): Promise<number>;
+  receiveStreamSync(codecpar: NativeCodecParameters): number;
+  receivePacket(packet: NativePacket): Promise<number>;
+  receivePacketSync(packet: NativePacket): number;
+  receiveFrame(frame: NativeFrame): Promise<number>;
+  receiveFrameSync(frame: NativeFrame): number;
+  getStreamTimeBase(streamIndex: number): IRational | null;
+  close(): void;
+  getStats(): SharedMemoryChannelStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native SmartCutter binding interface
+ *
+ * Frame-accurate trimming that re-encodes only the GOPs at the cut points.
+ *
+ * @internal
+ */
+export interface NativeSmartCutter {
+  readonly __brand: 'NativeSmartCutter';
+
+  cut(input: string, output: string, options?: SmartCutOptions): Promise<number>;
+  cutSync(input: string, output: string, options?: SmartCutOptions): number;
+  getStats(): SmartCutStats;
+}
+
+/**
+ * Native SceneAnalyzer binding interface
+ *
+ * Shared scene analysis and keyframe placement for ABR renditions.
+ *
+ * @internal
+ */
+export interface NativeSceneAnalyzer extends Disposable {
+  readonly __brand: 'NativeSceneAnalyzer';
+
+  alloc(options?: SceneAnalyzerOptions): number;
+  free(): void;
+  analyze(frame: NativeFrame): Promise<number>;
+  analyzeSync(frame: NativeFrame): number;
+  reset(): void;
+  getLastResult(): SceneAnalysis | null;
+  getStats(): SceneAnalyzerStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native ColorTransform binding interface
+ *
+ * Colorspace conversion and HDR to SDR tone mapping through cached 3D LUTs.
+ *
+ * @internal
+ */
+export interface NativeColorTransform extends Disposable {
+  readonly __brand: 'NativeColorTransform';
+
+  alloc(options?: ColorTransformOptions): number;
+  free(): void;
+  apply(src: NativeFrame, dst?: NativeFrame | null): Promise<number>;
+  applySync(src: NativeFrame, dst?: NativeFrame | null): number;
+  getStats(): ColorTransformStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native LogoOverlay binding interface
+ *
+ * Static logo blended into video frames in place.
+ *
+ * @internal
+ */
+export interface NativeLogoOverlay extends Disposable {
+  readonly __brand: 'NativeLogoOverlay';
+
+  alloc(logo: NativeFrame, options?: LogoOverlayOptions): number;
+  free(): void;
+  apply(frame: NativeFrame): Promise<number>;
+  applySync(frame: NativeFrame): number;
+  setPosition(x: number, y: number): void;
+  getStats(): LogoOverlayStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native ImageSequenceWriter binding interface
+ *
+ * Pool of single-threaded image encoders writing a numbered image sequence.
+ *
+ * @internal
+ */
+export interface NativeImageSequenceWriter extends Disposable {
+  readonly __brand: 'NativeImageSequenceWriter';
+
+  readonly workers: number;
+  readonly pending: number;
+  readonly isOpen: boolean;
+
+  open(options: ImageSequenceWriterOptions, encoderOptions?: NativeDictionary | null): Promise<number>;
+  openSync(options: ImageSequenceWriterOptions, encoderOptions?: NativeDictionary | null): number;
+  write(frame: NativeFrame): Promise<number>;
+  writeSync(frame: NativeFrame): number;
+  close(): Promise<number>;
+  closeSync(): number;
+  readResults(): ImageSequenceResult[];
+  getStats(): ImageSequenceWriterStats;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native MediaHasher binding interface
+ *
+ * Per-frame and per-packet hashing with framemd5 output.
+ *
+ * @internal
+ */
+export interface NativeMediaHasher extends Disposable {
+  readonly __brand: 'NativeMediaHasher';
+
+  readonly algorithm: string | null;
+  readonly digestSize: number;
+  readonly count: number;
+
+  alloc(algorithm?: string): number;
+  free(): void;
+  addFrame(frame: NativeFrame, streamIndex?: number): number;
+  addPacket(packet: NativePacket): number;
+  setStream(streamIndex: number, codecpar: NativeCodecParameters, timeBase: IRational): void;
+  scan(url: string, mode?: 'packets' | 'frames', streamIndex?: number): Promise<number>;
+  scanSync(url: string, mode?: 'packets' | 'frames', streamIndex?: number): number;
+  getEntries(): MediaHashEntries;
+  getHash(index: number): string | null;
+  toFrameMd5(): string | null;
+  clear(): void;
+
+  [Symbol.dispose](): void;
+}
+
+/**
+ * Native ConcatInput binding interface
+ *
+ * Gapless playlist input with background prefetch-open and timestamp stitching.
+ *
+ * @internal
+ */
+export interface NativeConcatInput extends Disposable {
+  readonly __brand: 'NativeConcatInput';
+
+  readonly nbStreams: number;
+  readonly boundary: boolean;
+  readonly itemIndex: number;
+  readonly currentUrl: string | null;
+  readonly itemsSkipped: number;
+  readonly pendingItems: number;
+
+  open(urls: string[], lookahead?: number, endless?: boolean): Promise<number>;
+  openSync(urls: string[], lookahead?: number, endless?: boolean): number;
+  append(url: string): void;
+  end(): void;
+  close(): void;
+  readFrame(packet: NativePacket): Promise<number>;
+  readFrameSync(packet: NativePacket): number;
+  getCodecParameters(streamIndex: number, codecpar: NativeCodecParameters): number;
+  getStreamTimeBase(streamIndex: number): IRational | null;
+
+  [Symbol.dispose](): void;
+}
+
 /**
  * Native SwsContext binding interface
  *
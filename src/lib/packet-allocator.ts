@@ -0,0 +1,144 @@
+import { bindings } from './binding.js';
+
+import type { NativePacketAllocator, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { PacketAllocatorOptions, PacketAllocatorStats } from './types.js';
+
+/**
+ * Slab allocator for small packet payloads.
+ *
+ * Audio, subtitle and data packets are typically a few hundred bytes, and each
+ * one normally gets its own heap allocation that is freed on another thread
+ * (demuxed in the thread pool, released from JavaScript). The allocator rounds
+ * payloads up to power-of-two size classes and carves them out of larger slabs.
+ * Freed blocks go to a per-thread cache first and move to a shared free list in
+ * batches, so most allocations take no lock.
+ *
+ * Payloads can come from the allocator in:
+ * - Demuxers via {@link FormatContext.setPacketAllocator} (small packets are moved
+ *   into slab memory after reading)
+ * - Encoders via {@link CodecContext.setPacketAllocator} (written in place by
+ *   encoders with direct rendering support, copied otherwise)
+ * - {@link Packet.clone} with an allocator
+ * - {@link allocPacket} for packets you fill yourself
+ *
+ * Packets larger than {@link maxSize} use the default allocator. Slabs stay alive
+ * as long as any packet references them.
+ *
+ * @example
+ * ```typescript
+ * import { PacketAllocator, FFmpegError } from 'node-av';
+ *
+ * using allocator = new PacketAllocator();
+ * FFmpegError.throwIfError(allocator.alloc({ maxSize: 2048 }), 'alloc');
+ *
+ * // Small demuxed packets land in slab memory
+ * formatContext.setPacketAllocator(allocator);
+ *
+ * console.log(allocator.getStats());
+ * ```
+ *
+ * @see {@link MediaInputOptions.packetAllocator} For the high-level API
+ */
+export class PacketAllocator implements Disposable, NativeWrapper<NativePacketAllocator> {
+  private native: NativePacketAllocator;
+
+  constructor() {
+    this.native = new bindings.PacketAllocator();
+  }
+
+  /**
+   * Largest payload served from slabs.
+   *
+   * The configured maximum rounded up to a power of two, 0 before {@link alloc}.
+   */
+  get maxSize(): number {
+    return this.native.maxSize;
+  }
+
+  /**
+   * Set up the allocator.
+   *
+   * Slabs are allocated on demand. Calling again starts a new allocator;
+   * packets from the previous one stay valid.
+   *
+   * @param options - Size classes, slab size and thread cache
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Invalid maxSize or slabSize
+   */
+  alloc(options: PacketAllocatorOptions = {}): number {
+    return this.native.alloc(options);
+  }
+
+  /**
+   * Detach from the slabs.
+   *
+   * Packets still referencing slab memory stay valid until they are released.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Allocate a packet payload.
+   *
+   * Like av_new_packet(): the packet is unreferenced, then gets a zero-padded
+   * buffer of `size` bytes. Sizes above {@link maxSize} use the default allocator.
+   *
+   * @param packet - Packet to allocate
+   *
+   * @param size - Payload size in bytes
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Allocator not allocated or negative size
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   */
+  allocPacket(packet: Packet, size: number): number {
+    return this.native.allocPacket(packet.getNative(), size);
+  }
+
+  /**
+   * Move a packet payload into slab memory.
+   *
+   * Copies the payload if it fits and is not already slab memory, and drops the
+   * packet's reference to the previous buffer.
+   *
+   * @param packet - Packet to move
+   *
+   * @returns 1 if copied, 0 if left alone, AVERROR_EINVAL if not allocated
+   */
+  adopt(packet: Packet): number {
+    return this.native.adopt(packet.getNative());
+  }
+
+  /**
+   * Get allocation counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): PacketAllocatorStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native PacketAllocator object.
+   *
+   * @returns The native PacketAllocator binding object
+   *
+   * @internal
+   */
+  getNative(): NativePacketAllocator {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the allocator.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,109 @@
+import { bindings } from './binding.js';
+
+import type { NativePacketRecorder, NativeWrapper } from './native-types.js';
+import type { PacketTraceStats } from './types.js';
+
+/**
+ * Packet trace recorder.
+ *
+ * Captures the packets read from an input into a compact binary trace: payload,
+ * timestamps, flags, side data, the codec parameters of each stream and the time
+ * each packet arrived. A trace replays without the original source, which makes
+ * decoder and pipeline benchmarks repeatable for inputs that are hard to
+ * reproduce (live streams, cameras, flaky networks).
+ *
+ * Replay with {@link FormatContext.openTrace} or {@link MediaInput.openTrace},
+ * either as fast as possible or at the recorded arrival times.
+ *
+ * Records are appended as packets arrive, and a trace cut off mid-record (for
+ * example by a crash) stays readable up to the last complete packet.
+ *
+ * @example
+ * ```typescript
+ * import { PacketRecorder, FFmpegError } from 'node-av';
+ *
+ * using recorder = new PacketRecorder();
+ * FFmpegError.throwIfError(recorder.open('capture.trace'), 'open');
+ *
+ * await using input = await MediaInput.open('rtsp://camera.local/stream', { packetRecorder: recorder });
+ * for await (const packet of input.packets()) {
+ *   // ...
+ *   packet.free();
+ * }
+ *
+ * console.log(recorder.getStats());
+ * ```
+ *
+ * @see {@link MediaInputOptions.packetRecorder} For the high-level API
+ */
+export class PacketRecorder implements Disposable, NativeWrapper<NativePacketRecorder> {
+  private native: NativePacketRecorder;
+
+  constructor() {
+    this.native = new bindings.PacketRecorder();
+  }
+
+  /**
+   * Whether a trace file is open for writing.
+   */
+  get isOpen(): boolean {
+    return this.native.isOpen;
+  }
+
+  /**
+   * Start a new trace file.
+   *
+   * An existing file is overwritten. Calling again closes the previous trace.
+   *
+   * @param path - Trace file path
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENOENT: Directory does not exist
+   *   - AVERROR_EACCES: Permission denied
+   *   - AVERROR_EIO: Writing the header failed
+   */
+  open(path: string): number {
+    return this.native.open(path);
+  }
+
+  /**
+   * Finish the trace file.
+   *
+   * Inputs still attached stop recording.
+   *
+   * @returns 0 on success, or the first write error of the capture
+   */
+  close(): number {
+    return this.native.close();
+  }
+
+  /**
+   * Get capture counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): PacketTraceStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native PacketRecorder object.
+   *
+   * @returns The native PacketRecorder binding object
+   *
+   * @internal
+   */
+  getNative(): NativePacketRecorder {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the recorder.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
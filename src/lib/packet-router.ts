@@ -0,0 +1,248 @@
+import { bindings } from './binding.js';
+
+import type { FormatContext } from './format-context.js';
+import type { NativePacketRouter, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { PacketRouterStats } from './types.js';
+
+/**
+ * Native packet router.
+ *
+ * Owns reading of an opened input format context on a dedicated native thread and
+ * routes packets to any number of routes. A route either queues the packets of one
+ * input stream in a bounded queue for JS, or copies them straight into a stream of
+ * an output format context (passthrough): timestamps are rescaled and the packets are
+ * interleaved by the muxer on the reader thread, so copied streams never reach the
+ * event loop. Several routes may read the same input stream.
+ *
+ * Passthrough packets arriving before the output header has been written are held
+ * natively and written once it is (on the next packet of the route or on {@link flush}).
+ * Muxer calls from JS and from the router are serialized per output; the Sync write
+ * methods of an output return AVERROR_EBUSY while a router writes to it.
+ *
+ * The input must not be read from JS while the router runs. Every JS route must be
+ * consumed concurrently or closed, otherwise the reader blocks once its queue is full.
+ *
+ * @example
+ * ```typescript
+ * import { Packet, PacketRouter } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * const router = new PacketRouter();
+ * router.setInput(input.getFormatContext());
+ * const video = router.addRoute(input.video()!.index);
+ * for (const stream of input.streams.filter((s) => s.codecpar.codecType === AVMEDIA_TYPE_AUDIO)) {
+ *   router.addPassthrough(stream.index, output.getFormatContext(), output.addStream(stream));
+ * }
+ * router.start();
+ *
+ * const packet = new Packet();
+ * packet.alloc();
+ * while ((await router.receivePacket(video, packet)) !== AVERROR_EOF) {
+ *   // Decode, filter, encode, write...
+ * }
+ * await router.wait();
+ * router.flush();
+ * ```
+ *
+ * @see {@link FormatContext} For input and output handling
+ */
+export class PacketRouter implements Disposable, NativeWrapper<NativePacketRouter> {
+  private native: NativePacketRouter;
+
+  constructor() {
+    this.native = new bindings.PacketRouter();
+  }
+
+  /**
+   * Whether the reader thread is still reading.
+   */
+  get isRunning(): boolean {
+    return this.native.isRunning;
+  }
+
+  /**
+   * Set the input to demux.
+   *
+   * The format context must be opened and its streams probed.
+   *
+   * @param formatContext - Opened input format context
+   *
+   * @param queueSize - Maximum packets buffered per JS route (default: 64)
+   *
+   * @throws {Error} If already started or the context is invalid
+   */
+  setInput(formatContext: FormatContext, queueSize?: number): void {
+    this.native.setInput(formatContext.getNative(), queueSize);
+  }
+
+  /**
+   * Add a route delivering the packets of an input stream to JS.
+   *
+   * @param streamIndex - Input stream index
+   *
+   * @returns Route id (>= 0) on success, AVERROR_EINVAL for an invalid stream or if already started
+   */
+  addRoute(streamIndex: number): number {
+    return this.native.addRoute(streamIndex);
+  }
+
+  /**
+   * Add a route copying the packets of an input stream into an output stream.
+   *
+   * The output stream must have the codec parameters of the input stream.
+   * Writing the header and trailer is left to the caller.
+   *
+   * @param streamIndex - Input stream index
+   *
+   * @param output - Output format context
+   *
+   * @param outputStreamIndex - Output stream index
+   *
+   * @returns Route id (>= 0) on success, AVERROR_EINVAL for an invalid stream or if already started
+   *
+   * @throws {Error} If the output context is invalid
+   */
+  addPassthrough(streamIndex: number, output: FormatContext, outputStreamIndex: number): number {
+    return this.native.addPassthrough(streamIndex, output.getNative(), outputStreamIndex);
+  }
+
+  /**
+   * Start the reader thread.
+   *
+   * @returns 0 on success, AVERROR_EINVAL if no input/route or already started
+   */
+  start(): number {
+    return this.native.start();
+  }
+
+  /**
+   * Receive the next packet of a JS route.
+   *
+   * Waits until the reader delivered a packet.
+   *
+   * @param route - Route id returned by {@link addRoute}
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: End of input or route closed
+   *   - AVERROR_EINVAL: Unknown or passthrough route, or not started
+   *   - Other: Read error
+   *
+   * @see {@link receivePacketSync} For synchronous version
+   */
+  async receivePacket(route: number, packet: Packet): Promise<number> {
+    return await this.native.receivePacket(route, packet.getNative());
+  }
+
+  /**
+   * Receive the next packet of a JS route synchronously.
+   * Synchronous version of receivePacket.
+   *
+   * @param route - Route id returned by {@link addRoute}
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link receivePacket} For async version
+   */
+  receivePacketSync(route: number, packet: Packet): number {
+    return this.native.receivePacketSync(route, packet.getNative());
+  }
+
+  /**
+   * Stop delivering packets to a route and discard its queue.
+   *
+   * The reader stops early once every route is closed.
+   *
+   * @param route - Route id
+   *
+   * @returns 0 on success, AVERROR_EINVAL for an unknown route
+   */
+  closeRoute(route: number): number {
+    return this.native.closeRoute(route);
+  }
+
+  /**
+   * Write passthrough packets held back for outputs whose header has been written.
+   *
+   * Only once the reader has finished, see {@link wait}.
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EAGAIN: Packets still held for an output without header
+   *   - AVERROR_EBUSY: Reader still running
+   *   - Other: Write error
+   */
+  flush(): number {
+    return this.native.flush();
+  }
+
+  /**
+   * Wait until the reader thread finished.
+   *
+   * @returns 0 on success or the first read/write error
+   *
+   * @see {@link waitSync} For synchronous version
+   */
+  async wait(): Promise<number> {
+    return await this.native.wait();
+  }
+
+  /**
+   * Wait until the reader thread finished synchronously.
+   * Synchronous version of wait.
+   *
+   * Blocks the event loop: must not be used while the input or a passthrough output
+   * does I/O through JS callbacks, those reads and writes need the event loop.
+   *
+   * @returns 0 on success or the first read/write error
+   *
+   * @see {@link wait} For async version
+   */
+  waitSync(): number {
+    return this.native.waitSync();
+  }
+
+  /**
+   * Stop the reader and discard queued and held packets.
+   *
+   * Does not wait for the reader: it is signaled and a blocking network read or read
+   * pacing wait is interrupted. Await {@link wait} before closing the input or the
+   * outputs of passthrough routes.
+   */
+  stop(): void {
+    this.native.stop();
+  }
+
+  /**
+   * Get reader and per-route counters.
+   *
+   * @returns Current statistics
+   */
+  getStats(): PacketRouterStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native PacketRouter object.
+   *
+   * @returns The native PacketRouter binding object
+   *
+   * @internal
+   */
+  getNative(): NativePacketRouter {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the router.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling stop().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -2,6 +2,7 @@ import { bindings } from './binding.js';
 
 import type { AVPacketFlag, AVPacketSideDataType } from '../constants/constants.js';
 import type { NativePacket, NativeWrapper } from './native-types.js';
+import type { PacketAllocator } from './packet-allocator.js';
 import type { IRational } from './types.js';
 
 /**
@@ -290,6 +291,8 @@ export class Packet implements Disposable, NativeWrapper<NativePacket> {
    *
    * Direct mapping to av_packet_clone().
    *
+   * @param allocator - Copy small payloads into slab memory of this allocator
+   *
    * @returns New packet instance, or null on allocation failure
    *
    * @example
@@ -302,9 +305,10 @@ export class Packet implements Disposable, NativeWrapper<NativePacket> {
    * ```
    *
    * @see {@link ref} To create reference instead of copy
+   * @see {@link PacketAllocator} For slab allocation
    */
-  clone(): Packet | null {
-    const cloned = this.native.clone();
+  clone(allocator?: PacketAllocator): Packet | null {
+    const cloned = this.native.clone(allocator?.getNative());
     if (!cloned) {
       return null;
     }
@@ -0,0 +1,252 @@
+import { bindings } from './binding.js';
+
+import type { AVCodecID } from '../constants/constants.js';
+import type { CodecParameters } from './codec-parameters.js';
+import type { Dictionary } from './dictionary.js';
+import type { Frame } from './frame.js';
+import type { NativeParallelDecoder, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { IRational } from './types.js';
+
+/**
+ * Parallel decoder for intra-only codecs.
+ *
+ * Every packet of an intra-only codec (MJPEG, ProRes, DNxHD, PNG, ...) is a
+ * self-contained picture. This class opens a pool of independent single-threaded
+ * codec contexts, each driven by its own native worker thread, and spreads packets
+ * across them round-robin. Decoded frames are reordered natively and returned
+ * strictly in the order packets were sent, which for intra-only streams equals
+ * presentation order.
+ *
+ * Useful where FFmpeg's built-in frame/slice threading is unavailable or scales
+ * poorly for the codec (e.g. high resolution MJPEG or PNG sequences).
+ *
+ * @example
+ * ```typescript
+ * import { ParallelDecoder, Frame, FFmpegError } from 'node-av';
+ * import { AVERROR_EAGAIN } from 'node-av/constants';
+ *
+ * const decoder = new ParallelDecoder();
+ * const ret = await decoder.open(stream.codecpar, 4, null, stream.timeBase);
+ * FFmpegError.throwIfError(ret, 'open');
+ *
+ * const frame = new Frame();
+ * frame.alloc();
+ *
+ * for await (const packet of packets) {
+ *   // Wait for a frame if the pool is saturated
+ *   while ((await decoder.sendPacket(packet)) === AVERROR_EAGAIN) {
+ *     await decoder.receiveFrame(frame, true);
+ *     // Process frame...
+ *   }
+ * }
+ *
+ * decoder.close();
+ * ```
+ *
+ * @see {@link CodecContext} For regular decoding
+ */
+export class ParallelDecoder implements Disposable, NativeWrapper<NativeParallelDecoder> {
+  private native: NativeParallelDecoder;
+
+  constructor() {
+    this.native = new bindings.ParallelDecoder();
+  }
+
+  /**
+   * Check whether a codec can be decoded in parallel.
+   *
+   * Returns true if a decoder exists for the codec and its
+   * descriptor carries AV_CODEC_PROP_INTRA_ONLY.
+   *
+   * @param codecId - Codec ID to check
+   *
+   * @returns True if the codec is intra-only and decodable
+   *
+   * @example
+   * ```typescript
+   * import { AV_CODEC_ID_MJPEG } from 'node-av/constants';
+   *
+   * ParallelDecoder.isSupported(AV_CODEC_ID_MJPEG); // true
+   * ```
+   */
+  static isSupported(codecId: AVCodecID): boolean {
+    return bindings.ParallelDecoder.isSupported(codecId);
+  }
+
+  /**
+   * Number of decoder instances in the pool.
+   */
+  get workers(): number {
+    return this.native.workers;
+  }
+
+  /**
+   * Number of packets sent but not yet received as frames.
+   */
+  get pending(): number {
+    return this.native.pending;
+  }
+
+  /**
+   * Whether the decoder pool is open.
+   */
+  get isOpen(): boolean {
+    return this.native.isOpen;
+  }
+
+  /**
+   * Open the decoder pool.
+   *
+   * Creates `count` codec contexts from the parameters, opens each with
+   * a single thread and starts one worker thread per context.
+   *
+   * @param codecpar - Stream codec parameters
+   *
+   * @param count - Number of decoder instances (clamped to 1..64)
+   *
+   * @param options - Decoder options applied to every instance
+   *
+   * @param pktTimebase - Packet timebase for timestamp handling
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Already open or invalid parameters
+   *   - AVERROR_ENOSYS: Codec is not intra-only
+   *   - AVERROR_DECODER_NOT_FOUND: No decoder available
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @example
+   * ```typescript
+   * import { FFmpegError } from 'node-av';
+   *
+   * const ret = await decoder.open(stream.codecpar, 8, null, stream.timeBase);
+   * FFmpegError.throwIfError(ret, 'open');
+   * ```
+   *
+   * @see {@link openSync} For synchronous version
+   */
+  async open(codecpar: CodecParameters, count: number, options: Dictionary | null = null, pktTimebase?: IRational): Promise<number> {
+    return await this.native.open(codecpar.getNative(), count, options?.getNative() ?? null, pktTimebase);
+  }
+
+  /**
+   * Open the decoder pool synchronously.
+   * Synchronous version of open.
+   *
+   * @param codecpar - Stream codec parameters
+   *
+   * @param count - Number of decoder instances (clamped to 1..64)
+   *
+   * @param options - Decoder options applied to every instance
+   *
+   * @param pktTimebase - Packet timebase for timestamp handling
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link open} For async version
+   */
+  openSync(codecpar: CodecParameters, count: number, options: Dictionary | null = null, pktTimebase?: IRational): number {
+    return this.native.openSync(codecpar.getNative(), count, options?.getNative() ?? null, pktTimebase);
+  }
+
+  /**
+   * Queue a packet for decoding.
+   *
+   * Never blocks. The packet is referenced and handed to the next decoder
+   * instance. Send null to signal end of stream.
+   *
+   * @param packet - Packet to decode, or null to flush
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EAGAIN: Too many frames pending, receive first
+   *   - AVERROR_EOF: Decoder already flushed
+   *   - AVERROR_EINVAL: Decoder not open
+   *
+   * @see {@link receiveFrame} To retrieve decoded frames
+   */
+  async sendPacket(packet: Packet | null): Promise<number> {
+    return await this.native.sendPacket(packet ? packet.getNative() : null);
+  }
+
+  /**
+   * Queue a packet for decoding synchronously.
+   * Synchronous version of sendPacket.
+   *
+   * @param packet - Packet to decode, or null to flush
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link sendPacket} For async version
+   */
+  sendPacketSync(packet: Packet | null): number {
+    return this.native.sendPacketSync(packet ? packet.getNative() : null);
+  }
+
+  /**
+   * Receive the next decoded frame in submission order.
+   *
+   * The frame is moved into the provided frame without copying pixel data.
+   * After a flush, waits for outstanding packets automatically.
+   *
+   * @param frame - Frame to receive into
+   *
+   * @param wait - Block until the next frame is decoded instead of returning EAGAIN
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EAGAIN: Next frame not ready yet
+   *   - AVERROR_EOF: All frames returned after flush
+   *   - AVERROR_EXIT: Decoder closed while waiting
+   *   - Other: Decoding error of the corresponding packet
+   *
+   * @see {@link sendPacket} To queue packets
+   */
+  async receiveFrame(frame: Frame, wait = false): Promise<number> {
+    return await this.native.receiveFrame(frame.getNative(), wait);
+  }
+
+  /**
+   * Receive the next decoded frame synchronously.
+   * Synchronous version of receiveFrame.
+   *
+   * @param frame - Frame to receive into
+   *
+   * @param wait - Block until the next frame is decoded instead of returning EAGAIN
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link receiveFrame} For async version
+   */
+  receiveFrameSync(frame: Frame, wait = false): number {
+    return this.native.receiveFrameSync(frame.getNative(), wait);
+  }
+
+  /**
+   * Close the decoder pool.
+   *
+   * Stops all worker threads and frees every decoder instance and pending frame.
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get the underlying native ParallelDecoder object.
+   *
+   * @returns The native ParallelDecoder binding object
+   *
+   * @internal
+   */
+  getNative(): NativeParallelDecoder {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the decoder pool.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,216 @@
+import { bindings } from './binding.js';
+
+import type { Frame } from './frame.js';
+import type { NativeSceneAnalyzer, NativeWrapper } from './native-types.js';
+import type { SceneAnalysis, SceneAnalyzerOptions, SceneAnalyzerStats } from './types.js';
+
+/**
+ * Encoder options that leave keyframe placement to the analyzer.
+ *
+ * Disables the encoder's own scene-cut detection and turns forced I frames into IDR frames.
+ */
+const KEYFRAME_ENCODER_OPTIONS: Record<string, Record<string, string | number>> = {
+  libx264: { sc_threshold: 0, 'forced-idr': 1 },
+  libx265: { 'forced-idr': 1, 'x265-params': 'scenecut=0' },
+  h264_nvenc: { 'forced-idr': 1, 'no-scenecut': 1 },
+  hevc_nvenc: { 'forced-idr': 1, 'no-scenecut': 1 },
+  av1_nvenc: { 'forced-idr': 1, 'no-scenecut': 1 },
+  h264_qsv: { forced_idr: 1 },
+  hevc_qsv: { forced_idr: 1 },
+  libsvtav1: { 'svtav1-params': 'scd=0' },
+};
+
+/**
+ * Shared scene analysis driving aligned keyframes across ABR renditions.
+ *
+ * In a ladder every encoder runs its own scene-cut detection on its own resolution,
+ * so renditions place keyframes differently and segments only align where keyframes
+ * are forced. The analyzer runs once on a small grayscale copy of each source frame
+ * and computes a scene-change score (mean-compensated, so fades do not look like
+ * cuts), spatial and temporal complexity and fades.
+ *
+ * Frames starting a scene, a segment or a maximum-length GOP are marked with
+ * `pictType = AV_PICTURE_TYPE_I` and the key flag; all other frames are reset to
+ * `AV_PICTURE_TYPE_NONE` so decoded source picture types never force keyframes.
+ * Scores are also added to the frame metadata (`lavfi.scene_score`, `scene.complexity`,
+ * `scene.motion`, `scene.fade`, `scene.keyframe`).
+ *
+ * Analyze each frame before it fans out to the renditions: scaling keeps the picture
+ * type, and encoders configured with {@link SceneAnalyzer.encoderOptions} (plus a GOP size
+ * above `maxKeyInterval`) place their keyframes exactly there.
+ *
+ * @example
+ * ```typescript
+ * import { SceneAnalyzer, FFmpegError } from 'node-av';
+ * import { Encoder } from 'node-av/api';
+ *
+ * const analyzer = new SceneAnalyzer();
+ * FFmpegError.throwIfError(analyzer.alloc({ segmentDuration: 4, maxKeyInterval: 240 }), 'alloc');
+ *
+ * const options = { gopSize: 1000, options: SceneAnalyzer.encoderOptions('libx264') };
+ * const renditions = await Promise.all(ladder.map(() => Encoder.create(FF_ENCODER_LIBX264, { ...options, timeBase })));
+ *
+ * for await (const frame of analyzer.analyzeFrames(decoder.frames(input.packets(video.index)))) {
+ *   // Every rendition gets the same keyframes
+ *   for (const [i, scaler] of scalers.entries()) {
+ *     const scaled = await scaler.process(frame);
+ *     if (scaled) await renditions[i].encode(scaled);
+ *   }
+ *   frame.free();
+ * }
+ * ```
+ *
+ * @see {@link Frame.pictType} For the forced picture type
+ */
+export class SceneAnalyzer implements Disposable, NativeWrapper<NativeSceneAnalyzer> {
+  private native: NativeSceneAnalyzer;
+
+  constructor() {
+    this.native = new bindings.SceneAnalyzer();
+  }
+
+  /**
+   * Encoder options that leave keyframe placement to the analyzer.
+   *
+   * Disables the encoder's scene-cut detection and makes forced I frames IDR frames.
+   * Encoders not listed already follow forced picture types as they are.
+   *
+   * @param encoder - Encoder name (e.g. 'libx264', 'hevc_nvenc')
+   *
+   * @returns Codec options to merge into the encoder options
+   *
+   * @example
+   * ```typescript
+   * const encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+   *   timeBase,
+   *   gopSize: 1000,
+   *   options: { preset: 'fast', ...SceneAnalyzer.encoderOptions('libx264') },
+   * });
+   * ```
+   */
+  static encoderOptions(encoder: string): Record<string, string | number> {
+    return { ...KEYFRAME_ENCODER_OPTIONS[encoder] };
+  }
+
+  /**
+   * Allocate and configure the analyzer.
+   *
+   * Discards previous state and statistics.
+   *
+   * @param options - Analysis size, thresholds and keyframe intervals
+   *
+   * @returns 0 on success, AVERROR_EINVAL on invalid options
+   *
+   * @example
+   * ```typescript
+   * const analyzer = new SceneAnalyzer();
+   * analyzer.alloc({ sceneThreshold: 0.35, segmentDuration: 2 });
+   * ```
+   */
+  alloc(options: SceneAnalyzerOptions = {}): number {
+    return this.native.alloc(options);
+  }
+
+  /**
+   * Free the analyzer.
+   */
+  free(): void {
+    this.native.free();
+  }
+
+  /**
+   * Analyze a frame and mark it.
+   *
+   * Sets the picture type and key flag and adds the scores to the frame metadata.
+   * Frames must be analyzed in presentation order.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 1 if the frame starts a GOP, 0 if not, negative AVERROR on error:
+   *   - AVERROR_EINVAL: Not allocated, hardware, audio or unsupported frame
+   *   - AVERROR_ENOMEM: Memory allocation failure
+   *
+   * @see {@link analyzeSync} For synchronous version
+   */
+  async analyze(frame: Frame): Promise<number> {
+    return await this.native.analyze(frame.getNative());
+  }
+
+  /**
+   * Analyze a frame and mark it synchronously.
+   * Synchronous version of analyze.
+   *
+   * @param frame - Software video frame
+   *
+   * @returns 1 if the frame starts a GOP, 0 if not, negative AVERROR on error
+   *
+   * @see {@link analyze} For async version
+   */
+  analyzeSync(frame: Frame): number {
+    return this.native.analyzeSync(frame.getNative());
+  }
+
+  /**
+   * Analyze frames passing through a pipeline.
+   *
+   * Yields every frame after marking it.
+   *
+   * @param frames - Frame source
+   *
+   * @yields {Frame} The marked input frames
+   */
+  async *analyzeFrames(frames: AsyncIterable<Frame>): AsyncGenerator<Frame> {
+    for await (const frame of frames) {
+      await this.analyze(frame);
+      yield frame;
+    }
+  }
+
+  /**
+   * Restart analysis, e.g. for a new input.
+   *
+   * The next frame starts a GOP. Statistics are kept.
+   */
+  reset(): void {
+    this.native.reset();
+  }
+
+  /**
+   * Get the analysis of the last frame.
+   *
+   * @returns Scores and keyframe decision, or null before the first frame
+   */
+  getLastResult(): SceneAnalysis | null {
+    return this.native.getLastResult();
+  }
+
+  /**
+   * Get analyzer statistics.
+   *
+   * @returns Frame, keyframe and fade counters
+   */
+  getStats(): SceneAnalyzerStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native SceneAnalyzer object.
+   *
+   * @returns The native SceneAnalyzer binding object
+   *
+   * @internal
+   */
+  getNative(): NativeSceneAnalyzer {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the analyzer.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling free().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,419 @@
+import { bindings } from './binding.js';
+
+import type { CodecParameters } from './codec-parameters.js';
+import type { Frame } from './frame.js';
+import type { NativeSharedMemoryChannel, NativeWrapper } from './native-types.js';
+import type { Packet } from './packet.js';
+import type { IRational, SharedMemoryChannelOptions, SharedMemoryChannelStats, SharedMemoryRole } from './types.js';
+
+/**
+ * Shared-memory channel for packets and frames between processes.
+ *
+ * A single-producer single-consumer ring buffer in a named shared-memory segment
+ * (`shm_open`). One process creates it, the other one opens it by name; each end is
+ * either the writer or the reader. Codec parameters, packets and frames travel with
+ * their timing, side data and frame metadata.
+ *
+ * The writer copies every payload into the ring once. Frames allocated with
+ * {@link allocFrame} already live in the ring and are sent without copying. The reader
+ * receives packets and frames whose buffers point into the ring, so nothing is copied
+ * on its side: a record is reclaimed once every reference to it has been freed, in
+ * ring order. Consumers that hold on to many frames (e.g. encoder lookahead) need a
+ * ring large enough for them, or `zeroCopy: false` to copy on receive.
+ *
+ * Both ends block while the other one is behind (futex waits on Linux, short sleeps
+ * on other platforms). A peer that exits without closing fails pending calls with
+ * AVERROR_EPIPE. Not available on Windows (AVERROR_ENOSYS).
+ *
+ * @example
+ * ```typescript
+ * import { CodecParameters, Frame, SharedMemoryChannel } from 'node-av';
+ * import { AVERROR_EOF } from 'node-av/constants';
+ *
+ * // Decoder process
+ * const channel = new SharedMemoryChannel();
+ * channel.create('/job-42', 'writer', { size: 256 * 1024 * 1024 });
+ * channel.addStream(videoStream.codecpar, videoStream.timeBase);
+ * for await (const frame of decoder.frames(input.packets())) {
+ *   await channel.sendFrame(frame);
+ *   frame.free();
+ * }
+ * channel.end();
+ *
+ * // Encoder process
+ * const channel = new SharedMemoryChannel();
+ * channel.open('/job-42', 'reader');
+ * const params = new CodecParameters();
+ * params.alloc();
+ * await channel.receiveStream(params);
+ * const frame = new Frame();
+ * frame.alloc();
+ * while ((await channel.receiveFrame(frame)) >= 0) {
+ *   await encoder.encode(frame);
+ * }
+ * ```
+ *
+ * @see {@link Frame} For frame operations
+ * @see {@link Packet} For packet operations
+ */
+export class SharedMemoryChannel implements Disposable, NativeWrapper<NativeSharedMemoryChannel> {
+  private native: NativeSharedMemoryChannel;
+
+  constructor() {
+    this.native = new bindings.SharedMemoryChannel();
+  }
+
+  /**
+   * Segment name, null before create/open.
+   */
+  get name(): string | null {
+    return this.native.name;
+  }
+
+  /**
+   * Role of this end, null before create/open.
+   */
+  get role(): SharedMemoryRole | null {
+    return this.native.role;
+  }
+
+  /**
+   * Ring size in bytes.
+   */
+  get size(): number {
+    return this.native.size;
+  }
+
+  /**
+   * Bytes currently used by records not yet reclaimed.
+   */
+  get used(): number {
+    return this.native.used;
+  }
+
+  /**
+   * Create a new shared-memory segment and attach to it.
+   *
+   * The name must start with '/' (and stay within 31 characters on macOS).
+   * The name is removed again when this end is closed; the peer keeps its mapping.
+   * A single packet or frame may use at most half of the ring.
+   *
+   * @param name - Segment name, e.g. `/job-42`
+   *
+   * @param role - Role of this end
+   *
+   * @param options - Channel options
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EEXIST: Name already in use
+   *   - AVERROR_EINVAL: Invalid name or size
+   *   - AVERROR_ENOSYS: Not supported on this platform
+   */
+  create(name: string, role: SharedMemoryRole, options: SharedMemoryChannelOptions = {}): number {
+    return this.native.create(name, role, options.size ?? 64 * 1024 * 1024, options.zeroCopy ?? true);
+  }
+
+  /**
+   * Attach to a segment created by another process.
+   *
+   * @param name - Segment name passed to {@link create}
+   *
+   * @param role - Role of this end, the other one than the creator
+   *
+   * @param options - Channel options (size is ignored)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENOENT: No such segment
+   *   - AVERROR_EAGAIN: Segment still being created
+   *   - AVERROR_EBUSY: Role already taken
+   *   - AVERROR_ENOSYS: Not supported on this platform
+   */
+  open(name: string, role: SharedMemoryRole, options: SharedMemoryChannelOptions = {}): number {
+    return this.native.open(name, role, options.zeroCopy ?? true);
+  }
+
+  /**
+   * Announce a stream to the reader (writer only).
+   *
+   * Never blocks: streams are expected before the first packet or frame.
+   *
+   * @param codecpar - Codec parameters of the stream
+   *
+   * @param timeBase - Time base of the stream
+   *
+   * @returns Stream index (>= 0) on success, negative AVERROR on error:
+   *   - AVERROR_EAGAIN: Ring full
+   *   - AVERROR_EINVAL: Not the writer
+   */
+  addStream(codecpar: CodecParameters, timeBase: IRational): number {
+    return this.native.addStream(codecpar.getNative(), timeBase);
+  }
+
+  /**
+   * Send a packet (writer only).
+   *
+   * Waits while the ring is full.
+   *
+   * @param packet - Packet to send, its stream index is kept
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EPIPE: Reader closed or gone
+   *   - AVERROR_ENOSPC: Packet larger than half the ring
+   *   - AVERROR_EBUSY: A frame from {@link allocFrame} has not been sent yet
+   *   - AVERROR_EXIT: Channel closed
+   *
+   * @see {@link sendPacketSync} For synchronous version
+   */
+  async sendPacket(packet: Packet): Promise<number> {
+    return await this.native.sendPacket(packet.getNative());
+  }
+
+  /**
+   * Send a packet synchronously.
+   * Synchronous version of sendPacket.
+   *
+   * @param packet - Packet to send
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link sendPacket} For async version
+   */
+  sendPacketSync(packet: Packet): number {
+    return this.native.sendPacketSync(packet.getNative());
+  }
+
+  /**
+   * Send a frame (writer only).
+   *
+   * Software frames only - download hardware frames first. Frames from
+   * {@link allocFrame} are sent without copying their planes.
+   * Waits while the ring is full.
+   *
+   * @param frame - Frame to send
+   *
+   * @param streamIndex - Stream the frame belongs to (default: 0)
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EPIPE: Reader closed or gone
+   *   - AVERROR_ENOSPC: Frame larger than half the ring
+   *   - AVERROR_EINVAL: Hardware frame or not the writer
+   *   - AVERROR_EBUSY: Another frame from {@link allocFrame} has not been sent yet
+   *   - AVERROR_EXIT: Channel closed
+   *
+   * @see {@link sendFrameSync} For synchronous version
+   */
+  async sendFrame(frame: Frame, streamIndex?: number): Promise<number> {
+    return await this.native.sendFrame(frame.getNative(), streamIndex);
+  }
+
+  /**
+   * Send a frame synchronously.
+   * Synchronous version of sendFrame.
+   *
+   * @param frame - Frame to send
+   *
+   * @param streamIndex - Stream the frame belongs to (default: 0)
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link sendFrame} For async version
+   */
+  sendFrameSync(frame: Frame, streamIndex?: number): number {
+    return this.native.sendFrameSync(frame.getNative(), streamIndex);
+  }
+
+  /**
+   * Allocate the planes of a frame directly in the ring (writer only).
+   *
+   * Set format and size (video) or format, channel layout and sample count (audio)
+   * first. Fill the frame (e.g. scale, convert or copy into it) and pass it to
+   * {@link sendFrame}, which then only writes its metadata. Nothing else can be
+   * sent until it has been sent or freed. Do not modify it after sending.
+   * Waits while the ring is full.
+   *
+   * @param frame - Allocated frame without buffers
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EBUSY: Previous frame from allocFrame not sent yet
+   *   - AVERROR_EINVAL: Frame has buffers, invalid properties or not the writer
+   *
+   * @see {@link allocFrameSync} For synchronous version
+   */
+  async allocFrame(frame: Frame): Promise<number> {
+    return await this.native.allocFrame(frame.getNative());
+  }
+
+  /**
+   * Allocate the planes of a frame in the ring synchronously.
+   * Synchronous version of allocFrame.
+   *
+   * @param frame - Allocated frame without buffers
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link allocFrame} For async version
+   */
+  allocFrameSync(frame: Frame): number {
+    return this.native.allocFrameSync(frame.getNative());
+  }
+
+  /**
+   * Signal the end of the stream (writer only).
+   *
+   * The reader receives AVERROR_EOF once it consumed every record.
+   * Closing the writer without ending makes the reader fail with AVERROR_EPIPE instead.
+   *
+   * @returns 0 on success, AVERROR_EINVAL if not the writer
+   */
+  end(): number {
+    return this.native.end();
+  }
+
+  /**
+   * Receive the next announced stream (reader only).
+   *
+   * @param codecpar - Codec parameters to fill
+   *
+   * @returns Stream index (>= 0) on success, negative AVERROR on error:
+   *   - AVERROR_EAGAIN: Next record is a packet or frame (all streams received)
+   *   - AVERROR_EOF: Writer ended
+   *   - AVERROR_EPIPE: Writer closed without ending or gone
+   *
+   * @see {@link receiveStreamSync} For synchronous version
+   */
+  async receiveStream(codecpar: CodecParameters): Promise<number> {
+    return await this.native.receiveStream(codecpar.getNative());
+  }
+
+  /**
+   * Receive the next announced stream synchronously.
+   * Synchronous version of receiveStream.
+   *
+   * @param codecpar - Codec parameters to fill
+   *
+   * @returns Stream index (>= 0) on success, negative AVERROR on error
+   *
+   * @see {@link receiveStream} For async version
+   */
+  receiveStreamSync(codecpar: CodecParameters): number {
+    return this.native.receiveStreamSync(codecpar.getNative());
+  }
+
+  /**
+   * Receive the next packet (reader only).
+   *
+   * Waits while the ring is empty. Streams announced in between are skipped
+   * (their time bases stay available via {@link getStreamTimeBase}).
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_EOF: Writer ended
+   *   - AVERROR_EPIPE: Writer closed without ending or gone
+   *   - AVERROR_EINVAL: Next record is a frame
+   *   - AVERROR_EXIT: Channel closed
+   *
+   * @see {@link receivePacketSync} For synchronous version
+   */
+  async receivePacket(packet: Packet): Promise<number> {
+    return await this.native.receivePacket(packet.getNative());
+  }
+
+  /**
+   * Receive the next packet synchronously.
+   * Synchronous version of receivePacket.
+   *
+   * @param packet - Packet to receive into
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @see {@link receivePacket} For async version
+   */
+  receivePacketSync(packet: Packet): number {
+    return this.native.receivePacketSync(packet.getNative());
+  }
+
+  /**
+   * Receive the next frame (reader only).
+   *
+   * Waits while the ring is empty. Streams announced in between are skipped.
+   *
+   * @param frame - Frame to receive into
+   *
+   * @returns Stream index of the frame (>= 0) on success, negative AVERROR on error:
+   *   - AVERROR_EOF: Writer ended
+   *   - AVERROR_EPIPE: Writer closed without ending or gone
+   *   - AVERROR_EINVAL: Next record is a packet
+   *   - AVERROR_EXIT: Channel closed
+   *
+   * @see {@link receiveFrameSync} For synchronous version
+   */
+  async receiveFrame(frame: Frame): Promise<number> {
+    return await this.native.receiveFrame(frame.getNative());
+  }
+
+  /**
+   * Receive the next frame synchronously.
+   * Synchronous version of receiveFrame.
+   *
+   * @param frame - Frame to receive into
+   *
+   * @returns Stream index of the frame (>= 0) on success, negative AVERROR on error
+   *
+   * @see {@link receiveFrame} For async version
+   */
+  receiveFrameSync(frame: Frame): number {
+    return this.native.receiveFrameSync(frame.getNative());
+  }
+
+  /**
+   * Get the time base of a received stream.
+   *
+   * @param streamIndex - Stream index
+   *
+   * @returns Time base, or null if the stream has not been received
+   */
+  getStreamTimeBase(streamIndex: number): IRational | null {
+    return this.native.getStreamTimeBase(streamIndex);
+  }
+
+  /**
+   * Detach from the segment.
+   *
+   * Wakes pending calls of this end (AVERROR_EXIT) and the peer.
+   * Received packets and frames stay valid until freed.
+   */
+  close(): void {
+    this.native.close();
+  }
+
+  /**
+   * Get transfer counters of this end.
+   *
+   * @returns Current statistics
+   */
+  getStats(): SharedMemoryChannelStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native SharedMemoryChannel object.
+   *
+   * @returns The native SharedMemoryChannel binding object
+   *
+   * @internal
+   */
+  getNative(): NativeSharedMemoryChannel {
+    return this.native;
+  }
+
+  /**
+   * Dispose of the channel.
+   *
+   * Implements the Disposable interface for automatic cleanup.
+   * Equivalent to calling close().
+   */
+  [Symbol.dispose](): void {
+    this.native[Symbol.dispose]();
+  }
+}
@@ -0,0 +1,116 @@
+import { bindings } from './binding.js';
+
+import type { NativeSmartCutter, NativeWrapper } from './native-types.js';
+import type { SmartCutOptions, SmartCutStats } from './types.js';
+
+/**
+ * Frame-accurate trimming that re-encodes only the GOP edges.
+ *
+ * Cutting a short clip out of a long file usually means decoding and encoding the
+ * whole range. The smart cutter instead seeks to the keyframe before the in point
+ * and groups video packets into GOPs: GOPs entirely inside the range are
+ * stream-copied, only the GOPs crossing the in and out points are decoded and their
+ * frames inside the range re-encoded. Output speed is close to remux speed.
+ *
+ * Re-encoded frames use the source codec, size, pixel format, profile, level, colors
+ * and bit rate. They carry their parameter sets in-band and the source parameter sets
+ * are repeated on the next copied keyframe, so the output keeps the source extradata.
+ * Timestamps are stitched to start at zero with strictly increasing decode order.
+ *
+ * The best video stream is cut frame-accurately. Audio and subtitle streams are
+ * stream-copied at packet granularity; other video streams are dropped.
+ *
+ * @example
+ * ```typescript
+ * import { SmartCutter, FFmpegError } from 'node-av';
+ *
+ * // Two minutes from a two-hour file, at remux speed
+ * const cutter = new SmartCutter();
+ * const ret = await cutter.cut('movie.mp4', 'clip.mp4', { start: 3605.2, end: 3725.2 });
+ * FFmpegError.throwIfError(ret, 'cut');
+ *
+ * const stats = cutter.getStats();
+ * console.log(`${stats.copiedGops} GOPs copied, ${stats.encodedFrames} frames re-encoded`);
+ * ```
+ */
+export class SmartCutter implements NativeWrapper<NativeSmartCutter> {
+  private native: NativeSmartCutter;
+
+  constructor() {
+    this.native = new bindings.SmartCutter();
+  }
+
+  /**
+   * Cut a range of the input into a new file.
+   *
+   * Runs on a worker thread. Only one cut per cutter runs at a time.
+   *
+   * @param input - Input URL
+   *
+   * @param output - Output URL
+   *
+   * @param options - Cut range, output format and encoder settings
+   *
+   * @returns 0 on success, negative AVERROR on error:
+   *   - AVERROR_ENCODER_NOT_FOUND: No encoder for the source codec
+   *   - AVERROR_EINVAL: Encoder does not produce the source codec
+   *   - AVERROR_STREAM_NOT_FOUND: No stream the output format accepts
+   *   - Other: Demuxer, codec or muxer errors
+   *
+   * @throws {Error} If a cut is already running
+   *
+   * @example
+   * ```typescript
+   * const ret = await cutter.cut('input.mp4', 'output.mp4', {
+   *   start: 10.5,
+   *   end: 20,
+   *   encoderOptions: { preset: 'fast' },
+   * });
+   * ```
+   *
+   * @see {@link cutSync} For synchronous version
+   */
+  async cut(input: string, output: string, options: SmartCutOptions = {}): Promise<number> {
+    return await this.native.cut(input, output, options);
+  }
+
+  /**
+   * Cut a range of the input into a new file synchronously.
+   * Synchronous version of cut.
+   *
+   * @param input - Input URL
+   *
+   * @param output - Output URL
+   *
+   * @param options - Cut range, output format and encoder settings
+   *
+   * @returns 0 on success, negative AVERROR on error
+   *
+   * @throws {Error} If a cut is already running
+   *
+   * @see {@link cut} For async version
+   */
+  cutSync(input: string, output: string, options: SmartCutOptions = {}): number {
+    return this.native.cutSync(input, output, options);
+  }
+
+  /**
+   * Get counters of the last (or running) cut.
+   *
+   * @returns Copied and re-encoded packets, GOPs and frames
+   */
+  getStats(): SmartCutStats {
+    return this.native.getStats();
+  }
+
+  /**
+   * Get the underlying native SmartCutter object.
+   *
+   * @returns The native SmartCutter binding object
+   *
+   * @internal
+   */
+  getNative(): NativeSmartCutter {
+    return this.native;
+  }
+}
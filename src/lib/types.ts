@@ -5,7 +5,7 @@
  * directly from FFmpeg constants.
  */
 
-import type { AVLogLevel, AVMediaType } from '../constants/constants.ts';
+import type { AVColorPrimaries, AVColorRange, AVColorSpace, AVColorTransferCharacteristic, AVLogLevel, AVMediaType, AVPixelFormat } from '../constants/constants.ts';
 
 /**
  * Rational number (fraction) interface
@@ -68,3 +68,1205 @@ export interface LogOptions {
    */
   maxLevel?: AVLogLevel;
 }
+
+/**
+ * Per-stream counters of a demux dispatcher route.
+ */
+export interface DemuxDispatcherStreamStats {
+  /** Input stream index */
+  streamIndex: number;
+
+  /** Packets handed to the decoder */
+  packetsDecoded: number;
+
+  /** Frames produced by the decoder */
+  framesDecoded: number;
+
+  /** Packets written to the output (encoder chain only) */
+  packetsWritten: number;
+
+  /** Packets waiting in the stream queue */
+  packetQueue: number;
+
+  /** Decoded frames waiting to be received */
+  frameQueue: number;
+}
+
+/**
+ * Demux dispatcher statistics.
+ */
+export interface DemuxDispatcherStats {
+  /** Packets read from the input (all streams) */
+  packetsRead: number;
+
+  /** Counters per attached stream */
+  streams: DemuxDispatcherStreamStats[];
+}
+
+/**
+ * Frame cache statistics.
+ */
+export interface FrameCacheStats {
+  /** Lookups served from the cache */
+  hits: number;
+
+  /** Lookups not found in the cache */
+  misses: number;
+
+  /** Entries evicted to stay within the byte budget */
+  evictions: number;
+
+  /** Frames inserted by the background prefetcher */
+  prefetched: number;
+
+  /** Current number of entries */
+  entries: number;
+
+  /** Current memory use in bytes */
+  bytes: number;
+}
+
+/**
+ * Frame arena slot statistics.
+ */
+export interface FrameArenaStats {
+  /** Total number of slots */
+  slots: number;
+
+  /** Slots referenced by FFmpeg buffers */
+  inUse: number;
+
+  /** Slots pinned by JavaScript consumers */
+  pinned: number;
+
+  /** Slots handed out since allocation */
+  allocations: number;
+
+  /** Requests served by the default allocator because no slot was free or large enough */
+  fallbacks: number;
+}
+
+/**
+ * Options for a packet payload allocator.
+ */
+export interface PacketAllocatorOptions {
+  /**
+   * Largest payload served from slabs, rounded up to a power of two (max 32768).
+   * Larger packets use the default allocator.
+   *
+   * @default 4096
+   */
+  maxSize?: number;
+
+  /**
+   * Bytes per slab. Each size class carves its blocks out of its own slabs.
+   *
+   * @default 65536
+   */
+  slabSize?: number;
+
+  /**
+   * Keep freed blocks in per-thread caches, so allocation and release take no lock
+   * in the common case.
+   *
+   * @default true
+   */
+  threadCache?: boolean;
+}
+
+/**
+ * Packet payload allocator statistics.
+ */
+export interface PacketAllocatorStats {
+  /** Payloads served from slabs */
+  allocations: number;
+
+  /** Allocations served from a thread cache without locking */
+  cacheHits: number;
+
+  /** Payloads up to `maxSize` that went to the default allocator */
+  fallbacks: number;
+
+  /** Demuxed, encoded or cloned payloads copied into slab memory */
+  copies: number;
+
+  /** Blocks currently referenced by packets */
+  inUse: number;
+
+  /** Payload bytes currently referenced by packets */
+  bytesInUse: number;
+
+  /** Slabs allocated */
+  slabs: number;
+
+  /** Total slab memory in bytes */
+  slabBytes: number;
+
+  /** Blocks on the shared free lists (excludes thread caches) */
+  freeBlocks: number;
+}
+
+/**
+ * Packet trace statistics.
+ */
+export interface PacketTraceStats {
+  /** Packets recorded */
+  packets: number;
+
+  /** Payload bytes recorded */
+  bytes: number;
+
+  /** Stream records written */
+  streams: number;
+
+  /** Arrival time of the last packet in seconds, relative to the start of the capture */
+  duration: number;
+}
+
+/**
+ * Options for replaying a packet trace.
+ */
+export interface PacketTraceOptions {
+  /**
+   * Deliver packets at their recorded arrival times instead of as fast as possible.
+   *
+   * @default false
+   */
+  realtime?: boolean;
+
+  /**
+   * Pacing factor for realtime replay, 2 replays twice as fast.
+   *
+   * @default 1
+   */
+  speed?: number;
+}
+
+/**
+ * Options for releasing read packets at their native rate.
+ */
+export interface ReadRateOptions {
+  /**
+   * Media seconds released per wall-clock second.
+   *
+   * @default 1
+   */
+  rate?: number;
+
+  /**
+   * Seconds of media released immediately after opening or seeking,
+   * e.g. to fill a player's buffer.
+   *
+   * @default 0
+   */
+  initialBurst?: number;
+
+  /**
+   * What to do after falling behind schedule (slow source, blocked reader):
+   * - `'burst'`: release late packets immediately until back on schedule
+   * - `'rate'`: catch up no faster than {@link catchupRate}
+   * - `'reset'`: drop lag above {@link maxLag} and continue at the normal rate from there
+   *
+   * @default 'burst'
+   */
+  catchup?: 'burst' | 'rate' | 'reset';
+
+  /**
+   * Release rate while behind schedule with `catchup: 'rate'`. Never below {@link rate}.
+   *
+   * @default 1.05
+   */
+  catchupRate?: number;
+
+  /**
+   * Lag in seconds that makes `catchup: 'reset'` re-anchor the schedule.
+   *
+   * @default 0.5
+   */
+  maxLag?: number;
+}
+
+/**
+ * Read pacing statistics.
+ *
+ * Lateness is how long after its release time a packet was read; it shows how
+ * far the source or the reader is behind real time.
+ */
+export interface ReadRateStats {
+  /** Packets released */
+  packets: number;
+
+  /** Packets held back until their release time */
+  waits: number;
+
+  /** Packets read after their release time */
+  latePackets: number;
+
+  /** Schedule re-anchors with `catchup: 'reset'` */
+  resets: number;
+
+  /** Total time spent waiting for release times in milliseconds */
+  waitTime: number;
+
+  /** Largest lateness in milliseconds */
+  maxLateness: number;
+
+  /** Average lateness of late packets in milliseconds */
+  avgLateness: number;
+
+  /** Lateness of the last packet in milliseconds */
+  lag: number;
+}
+
+/**
+ * Options for a frame scheduler.
+ */
+export interface FrameSchedulerOptions {
+  /**
+   * Output frame rate of a video encoder.
+   *
+   * @default encoder framerate, else the inverse of its time base
+   */
+  frameRate?: IRational;
+
+  /**
+   * Samples per tick for audio encoders without a fixed frame size.
+   *
+   * @default 1024
+   */
+  frameSize?: number;
+
+  /**
+   * How a video tick without a new source frame is served:
+   * - `'repeat'`: repeat the last frame (black or slate before the first frame)
+   * - `'black'`: black frame
+   * - `'slate'`: the slate frame
+   *
+   * Audio ticks are always padded with silence.
+   *
+   * @default 'repeat'
+   */
+  fill?: 'repeat' | 'black' | 'slate';
+
+  /**
+   * Consecutive repeats before switching to the slate (or black), 0 for no limit.
+   *
+   * @default 0
+   */
+  maxRepeats?: number;
+
+  /**
+   * Source frames buffered ahead of the clock (audio: in units of the tick size).
+   * When full, the oldest frames/samples are dropped. 1 always encodes the latest frame.
+   *
+   * @default 2
+   */
+  queueSize?: number;
+}
+
+/**
+ * Frame scheduler statistics.
+ */
+export interface FrameSchedulerStats {
+  /** Output ticks so far */
+  ticks: number;
+
+  /** Frames pushed by the source */
+  framesIn: number;
+
+  /** Ticks served by repeating the last frame */
+  repeats: number;
+
+  /** Ticks served by a black, slate or silent frame */
+  fills: number;
+
+  /** Ticks without a new source frame (audio: not enough samples) */
+  underruns: number;
+
+  /** Source frames dropped because the source ran ahead (audio: sample drops) */
+  overruns: number;
+
+  /** Audio samples dropped on overrun */
+  droppedSamples: number;
+
+  /** Ticks that started after the following tick was already due */
+  lateTicks: number;
+
+  /** Largest tick lateness in milliseconds */
+  maxLateness: number;
+
+  /** Packets produced by the encoder */
+  packets: number;
+
+  /** Frames (audio: samples) currently buffered */
+  queued: number;
+}
+
+/**
+ * Counters of a packet router route.
+ */
+export interface PacketRouterRouteStats {
+  /** Input stream index */
+  streamIndex: number;
+
+  /** Whether packets are copied straight into an output */
+  passthrough: boolean;
+
+  /** Packets handed to the route */
+  packetsRouted: number;
+
+  /** Packets written to the output (passthrough only) */
+  packetsWritten: number;
+
+  /** Packets waiting to be received */
+  queued: number;
+
+  /** Passthrough packets held until the output header is written */
+  pending: number;
+}
+
+/**
+ * Packet router statistics.
+ */
+export interface PacketRouterStats {
+  /** Packets read from the input (all streams) */
+  packetsRead: number;
+
+  /** Counters per route, indexed by route id */
+  routes: PacketRouterRouteStats[];
+}
+
+/**
+ * End of a shared-memory channel.
+ */
+export type SharedMemoryRole = 'writer' | 'reader';
+
+/**
+ * Options for shared-memory channels.
+ */
+export interface SharedMemoryChannelOptions {
+  /**
+   * Ring size in bytes, rounded up to whole pages (creator only).
+   *
+   * A single packet or frame may use at most half of it.
+   *
+   * @default 67108864
+   */
+  size?: number;
+
+  /**
+   * Receive packets and frames referencing the ring instead of copying them (reader only).
+   *
+   * Referenced records are reclaimed once freed, so consumers holding many frames
+   * need a larger ring.
+   *
+   * @default true
+   */
+  zeroCopy?: boolean;
+}
+
+/**
+ * Shared-memory channel counters of one end.
+ */
+export interface SharedMemoryChannelStats {
+  /** Packets sent or received */
+  packets: number;
+
+  /** Frames sent or received */
+  frames: number;
+
+  /** Payload bytes sent or received */
+  bytes: number;
+
+  /** Records moved without copying their payload (allocated frames, referenced receives) */
+  zeroCopy: number;
+
+  /** Times this end waited for the other one */
+  waits: number;
+
+  /** Bytes currently used in the ring */
+  used: number;
+}
+
+/**
+ * Options for smart-render trimming.
+ */
+export interface SmartCutOptions {
+  /**
+   * In point in seconds from the start of the input.
+   *
+   * @default 0
+   */
+  start?: number;
+
+  /**
+   * Out point in seconds from the start of the input (exclusive).
+   *
+   * Cuts to the end of the input if omitted.
+   */
+  end?: number;
+
+  /**
+   * Output format name (guessed from the output URL if omitted).
+   */
+  format?: string;
+
+  /**
+   * Encoder for the re-encoded edges (default: the default encoder of the source codec).
+   *
+   * Must produce the source codec.
+   */
+  encoder?: string;
+
+  /**
+   * Encoder options for the re-encoded edges (e.g. `{ crf: 18, preset: 'fast' }`).
+   *
+   * B-frames are disabled, options enabling them break the timestamp stitching.
+   * The source bit rate is used unless overridden.
+   */
+  encoderOptions?: Record<string, string | number>;
+}
+
+/**
+ * Smart-cut counters of the last cut.
+ */
+export interface SmartCutStats {
+  /** Packets stream-copied (all streams) */
+  copiedPackets: number;
+
+  /** Payload bytes stream-copied */
+  copiedBytes: number;
+
+  /** Video GOPs stream-copied */
+  copiedGops: number;
+
+  /** Video GOPs decoded and re-encoded at the cut points */
+  encodedGops: number;
+
+  /** Video frames decoded for re-encoding */
+  decodedFrames: number;
+
+  /** Video frames re-encoded */
+  encodedFrames: number;
+}
+
+/**
+ * Options for shared scene analysis.
+ */
+export interface SceneAnalyzerOptions {
+  /**
+   * Width of the grayscale copy that is analyzed (height keeps the aspect ratio).
+   *
+   * @default 160
+   */
+  width?: number;
+
+  /**
+   * Scene change score (0-1, same scale as the select filter's `scene`) starting a new GOP.
+   *
+   * @default 0.4
+   */
+  sceneThreshold?: number;
+
+  /**
+   * Minimum frames between a keyframe and a scene-change keyframe.
+   *
+   * @default 8
+   */
+  minKeyInterval?: number;
+
+  /**
+   * Maximum frames between keyframes, 0 for no limit.
+   *
+   * @default 250
+   */
+  maxKeyInterval?: number;
+
+  /**
+   * Segment duration in seconds: the first frame at or after every multiple starts a GOP.
+   * 0 disables segment keyframes.
+   *
+   * @default 0
+   */
+  segmentDuration?: number;
+
+  /**
+   * Mean luma change per frame (0-255) that counts towards a fade.
+   *
+   * @default 1
+   */
+  fadeThreshold?: number;
+
+  /**
+   * Time base of frames without one, for segment boundaries.
+   */
+  timeBase?: IRational;
+}
+
+/**
+ * Analysis of one frame.
+ */
+export interface SceneAnalysis {
+  /** Frame pts */
+  pts: bigint;
+
+  /** Scene change score 0-1 (mean-compensated, fades score low) */
+  score: number;
+
+  /** Spatial complexity 0-1 (mean luma gradient) */
+  complexity: number;
+
+  /** Temporal complexity 0-1 (mean luma difference to the previous frame) */
+  motion: number;
+
+  /** Fade direction, null outside fades */
+  fade: 'in' | 'out' | null;
+
+  /** Whether the frame was marked as keyframe */
+  keyframe: boolean;
+
+  /** Why the frame starts a GOP, null if it does not */
+  reason: 'start' | 'segment' | 'scene' | 'interval' | null;
+}
+
+/**
+ * Scene analyzer counters.
+ */
+export interface SceneAnalyzerStats {
+  /** Analyzed frames */
+  frames: number;
+
+  /** Frames marked as keyframes (all reasons) */
+  keyframes: number;
+
+  /** Keyframes placed on scene changes */
+  sceneCuts: number;
+
+  /** Keyframes placed on segment boundaries */
+  segmentKeyframes: number;
+
+  /** Keyframes forced by the maximum interval */
+  intervalKeyframes: number;
+
+  /** Frames inside a fade */
+  fadeFrames: number;
+}
+
+/**
+ * Runtime changes for an open encoder.
+ *
+ * Rate changes require an encoder that reconfigures while running
+ * (libx264, NVENC); keyframes can be forced on any encoder.
+ */
+export interface CodecReconfigureOptions {
+  /** Target bit rate in bits/s */
+  bitRate?: bigint | number;
+
+  /** VBV maximum rate in bits/s */
+  rcMaxRate?: bigint | number;
+
+  /** VBV buffer size in bits */
+  rcBufferSize?: number;
+
+  /** Constant rate factor (encoders with a `crf` option) */
+  crf?: number;
+
+  /** Encode the next frame as keyframe (IDR where the encoder lets us choose) */
+  keyframe?: boolean;
+}
+
+/**
+ * Runtime reconfiguration counters and latencies of a codec context.
+ */
+export interface CodecReconfigureStats {
+  /** Rate changes applied to a frame */
+  reconfigurations: number;
+
+  /** Keyframes forced on a frame */
+  keyframeRequests: number;
+
+  /** Forced keyframes received as key packets */
+  forcedKeyframes: number;
+
+  /** Milliseconds from the last request until a frame was sent with it */
+  lastApplyLatency: number;
+
+  /** Milliseconds from the last keyframe request until its key packet was received */
+  lastKeyframeLatency: number;
+
+  /** Whether a request waits for the next frame */
+  pending: boolean;
+
+  /** Whether the encoder applies rate changes while running */
+  liveRateControl: boolean;
+}
+
+/**
+ * Options for a cached 3D-LUT color transform.
+ *
+ * Source fields left out are taken from each frame (BT.709 limited range when the frame
+ * leaves them unspecified). Supported primaries: BT.709, BT.470BG, SMPTE 170M/240M, BT.2020,
+ * Display P3. Supported transfers: BT.709/601/2020, sRGB, gamma 2.2/2.8, linear, PQ and
+ * (source only) HLG.
+ */
+export interface ColorTransformOptions {
+  /** Source primaries */
+  srcPrimaries?: AVColorPrimaries;
+
+  /** Source transfer characteristic */
+  srcTrc?: AVColorTransferCharacteristic;
+
+  /** Source matrix coefficients */
+  srcSpace?: AVColorSpace;
+
+  /** Source range */
+  srcRange?: AVColorRange;
+
+  /**
+   * Destination primaries.
+   *
+   * @default AVCOL_PRI_BT709
+   */
+  dstPrimaries?: AVColorPrimaries;
+
+  /**
+   * Destination transfer characteristic (not HLG).
+   *
+   * @default AVCOL_TRC_BT709
+   */
+  dstTrc?: AVColorTransferCharacteristic;
+
+  /**
+   * Destination matrix coefficients.
+   *
+   * @default AVCOL_SPC_BT709
+   */
+  dstSpace?: AVColorSpace;
+
+  /**
+   * Destination range.
+   *
+   * @default AVCOL_RANGE_MPEG
+   */
+  dstRange?: AVColorRange;
+
+  /**
+   * Destination pixel format, planar 8 to 12-bit YUV with the source's chroma subsampling.
+   * Defaults to the source format.
+   */
+  dstFormat?: AVPixelFormat;
+
+  /**
+   * Lattice points per axis (2-65). Larger is more accurate and slower to build.
+   *
+   * @default 33
+   */
+  lutSize?: number;
+
+  /**
+   * Tone curve for PQ/HLG sources with an SDR destination, 'none' clips.
+   *
+   * @default 'hable'
+   */
+  tonemap?: 'none' | 'hable' | 'reinhard';
+
+  /**
+   * Source peak luminance in nits (tone curve input range, HLG display peak).
+   *
+   * @default 1000
+   */
+  peak?: number;
+
+  /**
+   * Tone curve parameter (reinhard contrast).
+   *
+   * @default 0.5
+   */
+  param?: number;
+
+  /**
+   * Reference white in nits, mapped to SDR peak white.
+   *
+   * @default 100
+   */
+  sdrWhite?: number;
+}
+
+/**
+ * Color transform counters.
+ */
+export interface ColorTransformStats {
+  /** Transformed frames */
+  frames: number;
+
+  /** LUTs built by this transform */
+  lutBuilds: number;
+
+  /** LUTs taken from the process-wide cache */
+  cacheHits: number;
+
+  /** Milliseconds spent building the last LUT */
+  lastBuildTime: number;
+
+  /** LUTs in the process-wide cache */
+  cachedLuts: number;
+}
+
+/**
+ * Options for a logo overlay.
+ */
+export interface LogoOverlayOptions {
+  /**
+   * Horizontal position of the logo's left edge in pixels.
+   * Negative values place the right edge that far from the frame's right edge.
+   * Rounded down to the chroma grid of the frames (even positions for 4:2:0).
+   *
+   * @default 0
+   */
+  x?: number;
+
+  /**
+   * Vertical position of the logo's top edge in pixels.
+   * Negative values place the bottom edge that far from the frame's bottom edge.
+   *
+   * @default 0
+   */
+  y?: number;
+
+  /**
+   * Opacity multiplied with the logo's alpha (0-1).
+   *
+   * @default 1
+   */
+  opacity?: number;
+}
+
+/**
+ * Logo overlay counters.
+ */
+export interface LogoOverlayStats {
+  /** Frames the logo was blended into */
+  frames: number;
+
+  /** Frames the logo did not intersect */
+  skipped: number;
+
+  /** Pixel format / color description combinations the logo was prepared for */
+  renders: number;
+}
+
+/**
+ * Options for a parallel image sequence writer.
+ */
+export interface ImageSequenceWriterOptions {
+  /**
+   * Output filename with a sequence field, as for the image2 muxer (e.g. 'frames/%05d.jpg').
+   */
+  pattern: string;
+
+  /**
+   * Encoder name (e.g. 'mjpeg', 'png', 'libwebp'). Guessed from the pattern's extension by default.
+   */
+  encoder?: string;
+
+  /**
+   * Encoder instances, each on its own thread (1-64).
+   *
+   * @default 4
+   */
+  workers?: number;
+
+  /**
+   * Images queued or encoding at once; `write()` waits while the limit is reached.
+   *
+   * @default 2 per worker
+   */
+  maxPending?: number;
+
+  /**
+   * Number of the first image.
+   *
+   * @default 1
+   */
+  startNumber?: number;
+
+  /**
+   * Encoder pixel format. By default the frame's format if the encoder supports it,
+   * else the closest supported format (converted per worker).
+   */
+  pixFmt?: AVPixelFormat;
+
+  /**
+   * Fixed quantizer (qscale, e.g. 2-31 for mjpeg, lower is better). Encoder default if not set.
+   */
+  quality?: number;
+
+  /**
+   * Keep a result per image for {@link ImageSequenceWriter.readResults}.
+   *
+   * @default false
+   */
+  collectResults?: boolean;
+}
+
+/**
+ * Result of one written image.
+ */
+export interface ImageSequenceResult {
+  /** Image number in the sequence */
+  number: number;
+
+  /** Written file */
+  filename: string;
+
+  /** File size in bytes (0 on error) */
+  size: number;
+
+  /** Milliseconds from write() until the file was closed */
+  latency: number;
+
+  /** 0 on success, negative AVERROR on error */
+  ret: number;
+}
+
+/**
+ * Image sequence writer counters.
+ */
+export interface ImageSequenceWriterStats {
+  /** Images written */
+  images: number;
+
+  /** Images that failed to encode or write */
+  failed: number;
+
+  /** Bytes written */
+  bytes: number;
+
+  /** Images queued or encoding */
+  pending: number;
+
+  /** Latency of the last finished image in milliseconds */
+  lastLatency: number;
+
+  /** Average latency in milliseconds */
+  averageLatency: number;
+
+  /** Highest latency in milliseconds */
+  maxLatency: number;
+}
+
+/**
+ * Options for custom I/O callbacks.
+ */
+export interface IOCallbackOptions {
+  /**
+   * Adapt the size passed to the read callback.
+   *
+   * Doubles while the callback returns full buffers (fewer JS calls for
+   * high-bitrate sources) and halves when it returns less than a quarter
+   * (low latency for live sources).
+   *
+   * @default false
+   */
+  adaptive?: boolean;
+
+  /**
+   * Smallest adaptive read size.
+   *
+   * @default min(bufferSize, 4096)
+   */
+  minReadSize?: number;
+
+  /**
+   * Largest adaptive read size.
+   *
+   * @default max(bufferSize, 1048576)
+   */
+  maxReadSize?: number;
+}
+
+/**
+ * Custom I/O read callback statistics.
+ */
+export interface IOCallbackStats {
+  /** Reads requested by FFmpeg */
+  reads: number;
+
+  /** Calls into the JS read callback */
+  readCallbacks: number;
+
+  /** Reads served from the rest of a previously returned buffer */
+  bufferedReads: number;
+
+  /** Bytes handed to FFmpeg */
+  bytesRead: number;
+
+  /** Current size passed to the read callback */
+  readSize: number;
+}
+
+/**
+ * Options for the native file I/O backend.
+ */
+export interface FileIOOptions {
+  /**
+   * Request engine.
+   *
+   * - 'auto': io_uring when available, otherwise a pread/pwrite worker thread
+   * - 'uring': io_uring only (fails with AVERROR_ENOSYS where unavailable)
+   * - 'threads': pread/pwrite worker thread
+   *
+   * @default 'auto'
+   */
+  engine?: 'auto' | 'uring' | 'threads';
+
+  /**
+   * Requests kept in flight (readahead depth / pending writes).
+   *
+   * @default 8
+   */
+  queueDepth?: number;
+
+  /**
+   * Bytes per request, at least 4096.
+   *
+   * @default 262144
+   */
+  blockSize?: number;
+
+  /**
+   * Page cache handling for written files.
+   *
+   * - 'default': Leave written pages in the page cache
+   * - 'dontneed': Start writeback right after each write and drop the pages a few blocks later
+   *   (`sync_file_range` + `POSIX_FADV_DONTNEED`), so long recordings do not evict hot data
+   * - 'direct': Bypass the page cache (`O_DIRECT`, `F_NOCACHE` on macOS). Blocks are aligned,
+   *   unaligned heads/tails (header rewrites, file end) are completed from the file.
+   *   Falls back to 'dontneed' on filesystems without O_DIRECT (e.g. tmpfs)
+   *
+   * Ignored for reading.
+   *
+   * @default 'default'
+   */
+  cache?: 'default' | 'dontneed' | 'direct';
+
+  /**
+   * Durability policy for written files.
+   *
+   * - 'none': Leave flushing to the kernel
+   * - 'close': `fdatasync` before closing
+   * - number: `fdatasync` whenever this many bytes were written since the last sync, and before closing
+   *
+   * @default 'none'
+   */
+  fsync?: 'none' | 'close' | number;
+
+  /**
+   * O_DIRECT alignment in bytes (power of two, at least 512).
+   *
+   * @default 4096
+   */
+  alignment?: number;
+
+  /**
+   * AVIOContext buffer size.
+   *
+   * @default 65536
+   */
+  bufferSize?: number;
+}
+
+/**
+ * Native file I/O backend statistics.
+ */
+export interface FileIOStats {
+  /** Engine in use */
+  engine: 'uring' | 'threads';
+
+  /** Bytes handed to FFmpeg */
+  bytesRead: number;
+
+  /** Bytes accepted from FFmpeg */
+  bytesWritten: number;
+
+  /** Read requests submitted */
+  readOps: number;
+
+  /** Write requests submitted */
+  writeOps: number;
+
+  /** I/O syscalls made (io_uring_enter, pread, pwrite) */
+  syscalls: number;
+
+  /** Times FFmpeg had to wait for a request to complete */
+  waits: number;
+
+  /** Peak number of requests in flight */
+  maxInFlight: number;
+
+  /** Whether the page cache is bypassed */
+  direct: boolean;
+
+  /** Bytes written to the file, including O_DIRECT padding and rewritten sectors */
+  bytesSubmitted: number;
+
+  /** bytesSubmitted / bytesWritten (0 before the first write) */
+  writeAmplification: number;
+
+  /** Sector reads needed to complete unaligned O_DIRECT writes */
+  rmwReads: number;
+
+  /** fdatasync calls */
+  syncs: number;
+
+  /**
+   * Write completion latency histogram.
+   *
+   * Index 0 counts writes below 1µs, index `i` counts writes taking [2^(i-1), 2^i) µs.
+   */
+  writeLatency: number[];
+
+  /** fdatasync latency histogram, same buckets as writeLatency */
+  syncLatency: number[];
+}
+
+/**
+ * Options for the native HTTP input backend.
+ */
+export interface HttpIOOptions {
+  /**
+   * Parallel keep-alive connections, each fetching one range at a time.
+   *
+   * @default 4
+   */
+  connections?: number;
+
+  /**
+   * Bytes per range request, at least 16384.
+   *
+   * @default 524288
+   */
+  blockSize?: number;
+
+  /**
+   * Maximum blocks requested ahead of the read position.
+   *
+   * The window starts small after a seek and doubles with every sequential block.
+   *
+   * @default 8
+   */
+  prefetch?: number;
+
+  /**
+   * Memory cache limit in bytes. Raised to hold at least the prefetch window.
+   *
+   * @default 33554432
+   */
+  cacheSize?: number;
+
+  /**
+   * Temporary file cache limit in bytes (0 disables).
+   *
+   * Fetched blocks are also written to an anonymous temporary file, so blocks
+   * evicted from memory are read back locally instead of being fetched again.
+   *
+   * @default 0
+   */
+  diskCacheSize?: number;
+
+  /**
+   * Socket read/write timeout in milliseconds.
+   *
+   * @default 10000
+   */
+  timeout?: number;
+
+  /**
+   * User-Agent header.
+   *
+   * @default FFmpeg's libavformat identifier
+   */
+  userAgent?: string;
+
+  /**
+   * Extra request headers (e.g. authorization, cookies).
+   */
+  headers?: Record<string, string>;
+
+  /**
+   * AVIOContext buffer size.
+   *
+   * @default 65536
+   */
+  bufferSize?: number;
+}
+
+/**
+ * Native HTTP input backend statistics.
+ */
+export interface HttpIOStats {
+  /** Resource size in bytes (-1 if unknown) */
+  size: number;
+
+  /** Whether the server supports range requests (seekable) */
+  seekable: boolean;
+
+  /** Bytes handed to FFmpeg */
+  bytesRead: number;
+
+  /** Response body bytes received */
+  bytesFetched: number;
+
+  /** HTTP requests sent */
+  requests: number;
+
+  /** TCP/TLS connections opened */
+  connections: number;
+
+  /** Requests sent on an already open keep-alive connection */
+  reusedConnections: number;
+
+  /** Reads served from a cached or prefetched block */
+  memoryHits: number;
+
+  /** Reads served from the disk cache */
+  diskHits: number;
+
+  /** Reads that had to wait for a fetch */
+  misses: number;
+
+  /** Queued prefetches dropped by seeks */
+  cancelled: number;
+
+  /** Redirects followed while opening */
+  redirects: number;
+
+  /** Total time FFmpeg waited for fetches in milliseconds */
+  waitTime: number;
+}
+
+/**
+ * Per-entry hashes collected by a media hasher.
+ *
+ * Entry `i` is described by index `i` of every array. Digests are stored back to back,
+ * `digestSize` bytes each.
+ */
+export interface MediaHashEntries {
+  /** Stream index of each entry */
+  streamIndex: Int32Array;
+
+  /** Presentation timestamps */
+  pts: BigInt64Array;
+
+  /** Decoding timestamps (equal to pts for frames) */
+  dts: BigInt64Array;
+
+  /** Durations */
+  duration: BigInt64Array;
+
+  /** Number of hashed bytes */
+  size: Int32Array;
+
+  /** Concatenated binary digests */
+  digests: Buffer;
+}
@@ -0,0 +1,187 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import {
+  AV_PIX_FMT_RGB24,
+  AV_PIX_FMT_YUV420P,
+  AV_PIX_FMT_YUV420P10LE,
+  AVCOL_PRI_BT2020,
+  AVCOL_PRI_BT709,
+  AVCOL_RANGE_MPEG,
+  AVCOL_SPC_BT2020_NCL,
+  AVCOL_SPC_BT709,
+  AVCOL_SPC_SMPTE170M,
+  AVCOL_TRC_BT709,
+  AVCOL_TRC_SMPTE2084,
+  AVERROR_EINVAL,
+  ColorTransform,
+  Frame,
+} from '../src/index.js';
+import { prepareTestEnvironment } from './index.js';
+
+import type { AVPixelFormat } from '../src/index.js';
+
+prepareTestEnvironment();
+
+const WIDTH = 64;
+const HEIGHT = 32;
+
+// Frame with luma from `luma(x)` per column and constant chroma
+function createFrame(format: AVPixelFormat, luma: (x: number) => number, cb: number, cr: number): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = format;
+  frame.width = WIDTH;
+  frame.height = HEIGHT;
+  frame.pts = 0n;
+
+  const bytes = format === AV_PIX_FMT_YUV420P10LE ? 2 : 1;
+  const lumaSize = WIDTH * HEIGHT;
+  const chromaSize = (WIDTH / 2) * (HEIGHT / 2);
+  const pixels = Buffer.alloc((lumaSize + chromaSize * 2) * bytes);
+  const write = (index: number, value: number) => (bytes === 2 ? pixels.writeUInt16LE(value, index * 2) : pixels.writeUInt8(value, index));
+
+  for (let y = 0; y < HEIGHT; y++) {
+    for (let x = 0; x < WIDTH; x++) {
+      write(y * WIDTH + x, luma(x));
+    }
+  }
+  for (let i = 0; i < chromaSize; i++) {
+    write(lumaSize + i, cb);
+    write(lumaSize + chromaSize + i, cr);
+  }
+  assert.equal(frame.fromBuffer(pixels), 0);
+  return frame;
+}
+
+// Luma of the first row and the first chroma samples of an 8-bit 4:2:0 frame
+function readFrame(frame: Frame): { luma: number[]; cb: number; cr: number } {
+  const data = frame.toBuffer();
+  const lumaSize = WIDTH * HEIGHT;
+  const chromaSize = (WIDTH / 2) * (HEIGHT / 2);
+  return { luma: [...data.subarray(0, WIDTH)], cb: data[lumaSize], cr: data[lumaSize + chromaSize] };
+}
+
+// 8-bit limited range Y'CbCr of R'G'B' with the given luma coefficients
+function encode(rgb: number[], kr: number, kb: number): number[] {
+  const y = kr * rgb[0] + (1 - kr - kb) * rgb[1] + kb * rgb[2];
+  return [16 + 219 * y, 128 + (224 * (rgb[2] - y)) / (2 * (1 - kb)), 128 + (224 * (rgb[0] - y)) / (2 * (1 - kr))];
+}
+
+describe('ColorTransform', () => {
+  it('should reject invalid options and formats', () => {
+    using transform = new ColorTransform();
+    const frame = createFrame(AV_PIX_FMT_YUV420P, () => 128, 128, 128);
+    assert.equal(transform.applySync(frame), AVERROR_EINVAL);
+    assert.equal(transform.alloc({ lutSize: 1 }), AVERROR_EINVAL);
+    assert.equal(transform.alloc({ peak: 0 }), AVERROR_EINVAL);
+    assert.equal(transform.alloc({ dstFormat: AV_PIX_FMT_RGB24 }), AVERROR_EINVAL);
+    assert.equal(transform.alloc({ tonemap: 'unknown' as 'none' }), AVERROR_EINVAL);
+
+    // In-place conversion cannot change the format
+    assert.equal(transform.alloc({ dstFormat: AV_PIX_FMT_YUV420P10LE }), 0);
+    assert.equal(transform.applySync(frame), AVERROR_EINVAL);
+    frame.free();
+  });
+
+  it('should keep frames unchanged without a color change', () => {
+    using transform = new ColorTransform();
+    assert.equal(transform.alloc(), 0);
+
+    const frame = createFrame(AV_PIX_FMT_YUV420P, (x) => 16 + Math.round((x * 219) / (WIDTH - 1)), 128, 128);
+    const before = readFrame(frame);
+    assert.equal(transform.applySync(frame), 0);
+    const after = readFrame(frame);
+
+    // Gradient on gray: identity
+    for (let x = 0; x < WIDTH; x++) {
+      assert.ok(Math.abs(after.luma[x] - before.luma[x]) <= 2, `luma ${x}: ${before.luma[x]} -> ${after.luma[x]}`);
+    }
+    assert.equal(frame.colorSpace, AVCOL_SPC_BT709);
+    assert.equal(frame.colorRange, AVCOL_RANGE_MPEG);
+    frame.free();
+  });
+
+  it('should convert the matrix from BT.601 to BT.709', async () => {
+    using transform = new ColorTransform();
+    assert.equal(transform.alloc({ srcSpace: AVCOL_SPC_SMPTE170M, srcPrimaries: AVCOL_PRI_BT709, srcTrc: AVCOL_TRC_BT709 }), 0);
+
+    for (const rgb of [
+      [0.8, 0.3, 0.2],
+      [0.2, 0.6, 0.4],
+      [0.5, 0.5, 0.5],
+    ]) {
+      const [y, cb, cr] = encode(rgb, 0.299, 0.114).map(Math.round);
+      const frame = createFrame(AV_PIX_FMT_YUV420P, () => y, cb, cr);
+      assert.equal(await transform.apply(frame), 0);
+
+      const expected = encode(rgb, 0.2126, 0.0722);
+      const result = readFrame(frame);
+      assert.ok(Math.abs(result.luma[0] - expected[0]) <= 2, `Y ${result.luma[0]} vs ${expected[0]}`);
+      assert.ok(Math.abs(result.cb - expected[1]) <= 2, `Cb ${result.cb} vs ${expected[1]}`);
+      assert.ok(Math.abs(result.cr - expected[2]) <= 2, `Cr ${result.cr} vs ${expected[2]}`);
+      frame.free();
+    }
+  });
+
+  it('should tone map PQ BT.2020 10-bit to SDR BT.709 8-bit', async () => {
+    using transform = new ColorTransform();
+    assert.equal(transform.alloc({ dstFormat: AV_PIX_FMT_YUV420P, tonemap: 'hable', peak: 1000 }), 0);
+
+    const src = createFrame(AV_PIX_FMT_YUV420P10LE, (x) => 64 + Math.round((x * 876) / (WIDTH - 1)), 512, 512);
+    src.colorPrimaries = AVCOL_PRI_BT2020;
+    src.colorTrc = AVCOL_TRC_SMPTE2084;
+    src.colorSpace = AVCOL_SPC_BT2020_NCL;
+    src.colorRange = AVCOL_RANGE_MPEG;
+
+    const dst = new Frame();
+    dst.alloc();
+    for (let i = 0; i < 2; i++) {
+      assert.equal(await transform.apply(src, dst), 0);
+    }
+
+    assert.equal(dst.format, AV_PIX_FMT_YUV420P);
+    assert.equal(dst.width, WIDTH);
+    assert.equal(dst.colorPrimaries, AVCOL_PRI_BT709);
+    assert.equal(dst.colorTrc, AVCOL_TRC_BT709);
+    assert.equal(src.colorTrc, AVCOL_TRC_SMPTE2084, 'Source is left untouched');
+
+    const { luma, cb, cr } = readFrame(dst);
+    assert.ok(Math.abs(cb - 128) <= 2 && Math.abs(cr - 128) <= 2, 'Gray stays neutral');
+    for (let x = 1; x < WIDTH; x++) {
+      assert.ok(luma[x] >= luma[x - 1], `Monotonic at ${x}`);
+    }
+    assert.ok(luma[0] <= 20);
+    assert.ok(luma[WIDTH - 1] > 200 && luma[WIDTH - 1] <= 235);
+
+    const stats = transform.getStats();
+    assert.equal(stats.frames, 2);
+    assert.equal(stats.lutBuilds + stats.cacheHits, 1);
+
+    src.free();
+    dst.free();
+  });
+
+  it('should share LUTs between transforms', () => {
+    ColorTransform.clearCache();
+    const options = { srcSpace: AVCOL_SPC_SMPTE170M, lutSize: 17 };
+
+    using first = new ColorTransform();
+    using second = new ColorTransform();
+    assert.equal(first.alloc(options), 0);
+    assert.equal(second.alloc(options), 0);
+
+    const frame = createFrame(AV_PIX_FMT_YUV420P, () => 100, 128, 128);
+    assert.equal(first.applySync(frame), 0);
+    assert.equal(second.applySync(frame), 0);
+
+    assert.equal(first.getStats().lutBuilds, 1);
+    assert.equal(second.getStats().cacheHits, 1);
+    assert.equal(second.getStats().lutBuilds, 0);
+    assert.equal(second.getStats().cachedLuts, 1);
+
+    ColorTransform.clearCache();
+    assert.equal(first.getStats().cachedLuts, 0);
+    frame.free();
+  });
+});
@@ -0,0 +1,95 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AVERROR_EOF, CodecParameters, ConcatInput, Packet } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+async function readAll(input: ConcatInput) {
+  const packet = new Packet();
+  packet.alloc();
+
+  const lastDts = new Map<number, bigint>();
+  let boundaries = 0;
+  let packets = 0;
+  let monotonic = true;
+
+  while ((await input.readFrame(packet)) !== AVERROR_EOF) {
+    packets++;
+    if (input.boundary) {
+      boundaries++;
+    }
+
+    const prev = lastDts.get(packet.streamIndex);
+    if (prev !== undefined && packet.dts <= prev) {
+      monotonic = false;
+    }
+    lastDts.set(packet.streamIndex, packet.dts);
+    packet.unref();
+  }
+
+  packet.free();
+  return { packets, boundaries, monotonic, lastDts };
+}
+
+describe('ConcatInput', () => {
+  it('should fail to read before open', () => {
+    using input = new ConcatInput();
+    const packet = new Packet();
+    packet.alloc();
+    assert.ok(input.readFrameSync(packet) < 0);
+    packet.free();
+  });
+
+  it('should play items back to back with continuous timestamps', async () => {
+    using single = new ConcatInput();
+    assert.equal(await single.open([inputFile]), 0);
+    const one = await readAll(single);
+
+    using input = new ConcatInput();
+    assert.equal(await input.open([inputFile, inputFile]), 0);
+    assert.ok(input.nbStreams > 0);
+
+    const codecpar = new CodecParameters();
+    codecpar.alloc();
+    assert.equal(input.getCodecParameters(0, codecpar), 0);
+    assert.ok(input.getStreamTimeBase(0));
+    assert.equal(input.getStreamTimeBase(99), null);
+
+    const two = await readAll(input);
+    assert.equal(two.packets, one.packets * 2);
+    assert.equal(two.boundaries, 2);
+    assert.equal(two.monotonic, true, 'DTS should increase across items');
+    assert.equal(input.itemIndex, 1);
+    assert.equal(input.itemsSkipped, 0);
+
+    // Second item continues after the first
+    for (const [index, dts] of one.lastDts) {
+      assert.ok(two.lastDts.get(index)! > dts);
+    }
+  });
+
+  it('should skip missing and incompatible items', async () => {
+    using input = new ConcatInput();
+    assert.equal(await input.open([inputFile, getInputFile('does-not-exist.mp4'), getInputFile('audio.wav'), inputFile]), 0);
+
+    const result = await readAll(input);
+    assert.equal(result.boundaries, 2);
+    assert.equal(input.itemsSkipped, 2);
+  });
+
+  it('should accept appended items in endless mode', async () => {
+    using input = new ConcatInput();
+    assert.equal(input.openSync([inputFile], 1, true), 0);
+
+    input.append(inputFile);
+    input.end();
+
+    const result = await readAll(input);
+    assert.equal(result.boundaries, 2);
+    assert.equal(input.pendingItems, 0);
+  });
+});
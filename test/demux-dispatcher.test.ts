@@ -0,0 +1,94 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder } from '../src/api/decoder.js';
+import { MediaInput } from '../src/api/media-input.js';
+import { AVERROR_EOF, DemuxDispatcher, Frame } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+describe('DemuxDispatcher', () => {
+  it('should reject streams before input is set', () => {
+    using dispatcher = new DemuxDispatcher();
+    assert.ok(dispatcher.start() < 0);
+  });
+
+  it('should decode audio and video concurrently', async () => {
+    const media = await MediaInput.open(inputFile);
+    const video = media.video();
+    const audio = media.audio();
+    assert.ok(video && audio);
+
+    const videoDecoder = await Decoder.create(video);
+    const audioDecoder = await Decoder.create(audio);
+
+    const dispatcher = new DemuxDispatcher();
+    dispatcher.setInput(media.getFormatContext(), 16);
+    assert.equal(dispatcher.addStream(video.index, videoDecoder.getCodecContext()!), 0);
+    assert.equal(dispatcher.addStream(audio.index, audioDecoder.getCodecContext()!), 0);
+    assert.ok(dispatcher.addStream(video.index, videoDecoder.getCodecContext()!) < 0, 'Duplicate stream should fail');
+    assert.equal(dispatcher.start(), 0);
+    assert.equal(dispatcher.isRunning, true);
+
+    const drain = async (streamIndex: number) => {
+      const frame = new Frame();
+      frame.alloc();
+      let count = 0;
+      let ret;
+      while ((ret = await dispatcher.receiveFrame(streamIndex, frame)) === 0) {
+        count++;
+      }
+      assert.equal(ret, AVERROR_EOF);
+      frame.free();
+      return count;
+    };
+
+    const [videoFrames, audioFrames] = await Promise.all([drain(video.index), drain(audio.index)]);
+    assert.equal(await dispatcher.wait(), 0);
+
+    assert.ok(videoFrames > 0, 'Should decode video frames');
+    assert.ok(audioFrames > 0, 'Should decode audio frames');
+
+    const stats = dispatcher.getStats();
+    assert.ok(stats.packetsRead > 0);
+    assert.equal(stats.streams.length, 2);
+    assert.equal(stats.streams[0].framesDecoded, videoFrames);
+    assert.equal(stats.streams[1].framesDecoded, audioFrames);
+    assert.equal(dispatcher.isRunning, false);
+
+    dispatcher.stop();
+    videoDecoder.close();
+    audioDecoder.close();
+    await media.close();
+  });
+
+  it('should stop while frames are pending', async () => {
+    const media = await MediaInput.open(inputFile);
+    const video = media.video();
+    assert.ok(video);
+
+    const decoder = await Decoder.create(video);
+
+    const dispatcher = new DemuxDispatcher();
+    dispatcher.setInput(media.getFormatContext());
+    dispatcher.addStream(video.index, decoder.getCodecContext()!);
+    dispatcher.start();
+
+    const frame = new Frame();
+    frame.alloc();
+    assert.equal(await dispatcher.receiveFrame(video.index, frame), 0);
+    assert.ok(frame.width > 0);
+
+    // Signals the threads without waiting, they exit before the input and decoder are closed
+    dispatcher.stop();
+    assert.equal(dispatcher.isRunning, false);
+    assert.equal(await dispatcher.wait(), 0);
+
+    frame.free();
+    decoder.close();
+    await media.close();
+  });
+});
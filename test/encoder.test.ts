@@ -1,10 +1,24 @@
 import assert from 'node:assert';
 import { describe, it } from 'node:test';
 
-import { AV_PIX_FMT_YUV420P, AV_SAMPLE_FMT_FLTP, Encoder, FF_ENCODER_AAC, FF_ENCODER_LIBX264, HardwareContext } from '../src/index.js';
+import {
+  AV_CODEC_FLAG_GLOBAL_HEADER,
+  AV_PIX_FMT_YUV420P,
+  AV_SAMPLE_FMT_FLTP,
+  AVERROR_EINVAL,
+  AVERROR_ENOSYS,
+  Encoder,
+  FF_ENCODER_AAC,
+  FF_ENCODER_LIBX264,
+  FF_ENCODER_MPEG4,
+  HardwareContext,
+} from '../src/index.js';
 import { Frame } from '../src/lib/index.js';
 import { skipInCI } from './index.js';
 
+import type { AVCodecFlag } from '../src/index.js';
+import type { Packet } from '../src/lib/index.js';
+
 describe('Encoder', () => {
   describe('create', () => {
     it('should create video encoder (async)', async () => {
@@ -656,6 +670,165 @@ describe('Encoder', () => {
     });
   });
 
+  describe('runtime reconfiguration', () => {
+    const createVideoFrame = (pts: number, width = 320, height = 240): Frame => {
+      const frame = new Frame();
+      frame.alloc();
+      frame.width = width;
+      frame.height = height;
+      frame.format = AV_PIX_FMT_YUV420P;
+      frame.pts = BigInt(pts);
+      frame.getBuffer();
+      return frame;
+    };
+
+    const realtimeOptions = { preset: 'ultrafast', tune: 'zerolatency', sc_threshold: 0 };
+
+    it('should force a keyframe on request (async)', async () => {
+      using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+        timeBase: { num: 1, den: 25 },
+        frameRate: { num: 25, den: 1 },
+        gopSize: 250,
+        options: realtimeOptions,
+      });
+
+      const keyframes: bigint[] = [];
+      const collect = (packet: Packet) => {
+        if (packet.isKeyframe) {
+          keyframes.push(packet.pts);
+        }
+        packet.free();
+      };
+
+      for (let i = 0; i < 20; i++) {
+        if (i === 12) {
+          encoder.requestKeyframe();
+        }
+        const frame = createVideoFrame(i);
+        const packet = await encoder.encode(frame);
+        frame.free();
+        if (packet) {
+          collect(packet);
+        }
+      }
+      for await (const packet of encoder.flushPackets()) {
+        collect(packet);
+      }
+
+      assert.deepEqual(keyframes, [0n, 12n]);
+      const stats = encoder.getReconfigureStats();
+      assert.equal(stats.keyframeRequests, 1);
+      assert.equal(stats.forcedKeyframes, 1);
+      assert.equal(stats.pending, false);
+      assert.ok(stats.lastKeyframeLatency >= stats.lastApplyLatency);
+    });
+
+    it('should change the bitrate of a running encoder (sync)', () => {
+      using encoder = Encoder.createSync(FF_ENCODER_LIBX264, {
+        timeBase: { num: 1, den: 25 },
+        frameRate: { num: 25, den: 1 },
+        bitrate: '200k',
+        options: realtimeOptions,
+      });
+
+      for (let i = 0; i < 10; i++) {
+        if (i === 5) {
+          assert.equal(encoder.reconfigure({ bitrate: '1M', maxRate: '1M', bufSize: '500k' }), 0);
+          assert.equal(encoder.getReconfigureStats().pending, true);
+        }
+        const frame = createVideoFrame(i);
+        encoder.encodeSync(frame)?.free();
+        frame.free();
+      }
+
+      const stats = encoder.getReconfigureStats();
+      assert.equal(stats.liveRateControl, true);
+      assert.equal(stats.reconfigurations, 1);
+      assert.equal(stats.pending, false);
+      assert.equal(stats.switches, 0);
+      assert.equal(encoder.getCodecContext()?.bitRate, 1_000_000n);
+      assert.equal(encoder.reconfigure({ bitrate: -1 }), AVERROR_EINVAL);
+    });
+
+    it('should refuse rate changes the running encoder would ignore (sync)', () => {
+      using encoder = Encoder.createSync(FF_ENCODER_MPEG4, {
+        timeBase: { num: 1, den: 25 },
+        frameRate: { num: 25, den: 1 },
+        bitrate: '200k',
+      });
+
+      const frame = createVideoFrame(0);
+      encoder.encodeSync(frame)?.free();
+      frame.free();
+
+      assert.equal(encoder.getReconfigureStats().liveRateControl, false);
+      assert.equal(encoder.reconfigure({ bitrate: '1M' }), AVERROR_ENOSYS);
+      assert.equal(encoder.reconfigure({ keyframe: true }), 0);
+    });
+
+    it('should switch resolution through a warm spare (async)', async () => {
+      using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+        timeBase: { num: 1, den: 25 },
+        frameRate: { num: 25, den: 1 },
+        gopSize: 250,
+        options: realtimeOptions,
+        switchOnResize: true,
+      });
+
+      await assert.rejects(() => encoder.prepareSpare({ width: 160, height: 120 }), /not open/);
+
+      let packets = 0;
+      const sizes = (i: number): [number, number] => (i < 10 ? [320, 240] : i < 20 ? [160, 120] : [240, 180]);
+      for (let i = 0; i < 25; i++) {
+        const frame = createVideoFrame(i, ...sizes(i));
+        const packet = await encoder.encode(frame);
+        frame.free();
+        if (packet) {
+          packets++;
+          packet.free();
+        }
+        if (i === 4) {
+          // Opened ahead of the switch at frame 10
+          await encoder.prepareSpare({ width: 160, height: 120, bitrate: '300k' });
+        }
+      }
+      for await (const packet of encoder.flushPackets()) {
+        packets++;
+        packet.free();
+      }
+
+      assert.equal(packets, 25, 'Packets of every instance are returned');
+      const stats = encoder.getReconfigureStats();
+      assert.equal(stats.switches, 2);
+      assert.equal(stats.warmSwitches, 1, 'The 240x180 instance had no spare');
+      assert.ok(stats.lastSwitchLatency > 0);
+      assert.equal(encoder.getCodecContext()?.width, 240);
+    });
+
+    it('should only switch on request and never with global headers (sync)', () => {
+      using encoder = Encoder.createSync(FF_ENCODER_LIBX264, {
+        timeBase: { num: 1, den: 25 },
+        frameRate: { num: 25, den: 1 },
+        options: realtimeOptions,
+      });
+
+      const first = createVideoFrame(0);
+      encoder.encodeSync(first)?.free();
+      first.free();
+
+      // No spare and no switchOnResize: frames of a new size are rejected
+      const resized = createVideoFrame(1, 160, 120);
+      assert.throws(() => encoder.encodeSync(resized), /switchOnResize/);
+      resized.free();
+      assert.equal(encoder.getReconfigureStats().switches, 0);
+
+      // Extradata of a new instance would not reach the output
+      const context = encoder.getCodecContext()!;
+      context.flags = (context.flags | AV_CODEC_FLAG_GLOBAL_HEADER) as AVCodecFlag;
+      assert.throws(() => encoder.prepareSpareSync({ width: 160, height: 120 }), /global/i);
+    });
+  });
+
   describe('hardware encoding', () => {
     it('should create hardware encoder with hardware context', skipInCI, async () => {
       // Try to get hardware context
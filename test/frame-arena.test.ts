@@ -0,0 +1,113 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder, MediaInput } from '../src/api/index.js';
+import { AV_PIX_FMT_RGB24, AVERROR_EAGAIN, Frame, FrameArena } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+function createFrame(): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = AV_PIX_FMT_RGB24;
+  frame.width = 64;
+  frame.height = 16;
+  return frame;
+}
+
+describe('FrameArena', () => {
+  it('should split shared memory into aligned slots', () => {
+    const memory = new Uint8Array(new SharedArrayBuffer(4 * 8192 + 100));
+    using arena = new FrameArena();
+    assert.equal(arena.alloc(memory, 8100, 64), 0);
+
+    assert.equal(arena.slotCount, 4);
+    assert.equal(arena.slotSize, 8100);
+    assert.equal(arena.freeSlots, 4);
+    assert.equal(arena.slotOffset(1) - arena.slotOffset(0), 8128);
+    assert.ok(arena.slotOffset(4) < 0);
+  });
+
+  it('should place frame planes in the shared memory', () => {
+    const memory = new Uint8Array(new SharedArrayBuffer(2 * 4096));
+    using arena = new FrameArena();
+    arena.alloc(memory, 4096);
+
+    const frame = createFrame();
+    assert.equal(frame.allocBuffer(arena), 0);
+    const slot = arena.slotOf(frame);
+    assert.ok(slot >= 0);
+    assert.equal(frame.linesize[0] % 64, 0);
+
+    // Write through FFmpeg, read through the shared view
+    const pixels = Buffer.alloc(64 * 16 * 3);
+    pixels.fill(5);
+    assert.equal(frame.fromBuffer(pixels), 0);
+    assert.equal(memory[arena.slotOffset(slot)], 5);
+
+    frame.free();
+  });
+
+  it('should recycle slots unless pinned', () => {
+    const memory = new Uint8Array(new SharedArrayBuffer(2 * 4096));
+    using arena = new FrameArena();
+    arena.alloc(memory, 4096);
+
+    const a = createFrame();
+    const b = createFrame();
+    const c = createFrame();
+    assert.ok(arena.allocFrame(a) >= 0);
+    assert.ok(arena.allocFrame(b) >= 0);
+    assert.equal(arena.allocFrame(c), AVERROR_EAGAIN);
+    assert.equal(arena.freeSlots, 0);
+
+    // Released by FFmpeg -> free again
+    a.unref();
+    assert.equal(arena.freeSlots, 1);
+
+    // Pinned slot survives the frame
+    const slot = arena.pin(b);
+    assert.ok(slot >= 0);
+    b.unref();
+    assert.equal(arena.freeSlots, 1);
+    assert.equal(arena.getStats().pinned, 1);
+
+    assert.equal(arena.release(slot), 0);
+    assert.equal(arena.freeSlots, 2);
+    assert.equal(arena.getStats().fallbacks, 1);
+
+    a.free();
+    b.free();
+    c.free();
+  });
+
+  it('should allocate decoded frames from the arena', async () => {
+    const memory = new Uint8Array(new SharedArrayBuffer(24 * 2 * 1024 * 1024));
+    using arena = new FrameArena();
+    arena.alloc(memory, 2 * 1024 * 1024);
+
+    await using input = await MediaInput.open(inputFile);
+    const stream = input.video();
+    assert.ok(stream);
+    using decoder = await Decoder.create(stream, { frameArena: arena });
+
+    let inArena = 0;
+    let count = 0;
+    for await (const frame of decoder.frames(input.packets(stream.index))) {
+      if (arena.slotOf(frame) >= 0) {
+        inArena++;
+      }
+      frame.free();
+      if (++count >= 10) {
+        break;
+      }
+    }
+
+    assert.ok(count > 0);
+    assert.ok(inArena > 0, 'Decoded frames should live in the arena');
+    assert.ok(arena.getStats().allocations > 0);
+  });
+});
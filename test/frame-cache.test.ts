@@ -0,0 +1,109 @@
+import assert from 'node:assert';
+import { setTimeout as sleep } from 'node:timers/promises';
+import { describe, it } from 'node:test';
+
+import { AV_PIX_FMT_YUV420P, AVERROR_ENOENT, Frame, FrameCache } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+function createFrame(width: number, height: number, pts: bigint): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.width = width;
+  frame.height = height;
+  frame.format = AV_PIX_FMT_YUV420P;
+  frame.pts = pts;
+  assert.equal(frame.getBuffer(), 0);
+  return frame;
+}
+
+describe('FrameCache', () => {
+  it('should store and return frames by reference', () => {
+    using cache = new FrameCache();
+    cache.alloc(16 * 1024 * 1024);
+
+    const frame = createFrame(320, 240, 10n);
+    assert.equal(cache.put('a.mp4', 0, 10n, frame), 0);
+    assert.equal(cache.entries, 1);
+    assert.ok(cache.bytes > 320 * 240);
+    assert.equal(cache.has('a.mp4', 0, 10n), true);
+    assert.equal(cache.has('a.mp4', 1, 10n), false);
+
+    const out = new Frame();
+    out.alloc();
+    assert.equal(cache.get('a.mp4', 0, 10n, out), 0);
+    assert.equal(out.width, 320);
+    assert.equal(out.pts, 10n);
+    assert.equal(cache.get('b.mp4', 0, 10n, out), AVERROR_ENOENT);
+
+    const stats = cache.getStats();
+    assert.equal(stats.hits, 1);
+    assert.equal(stats.misses, 1);
+
+    frame.free();
+    out.free();
+  });
+
+  it('should evict least recently used frames', () => {
+    using cache = new FrameCache();
+    const frames = [0n, 1n, 2n].map((pts) => createFrame(320, 240, pts));
+
+    // Measure one entry, then leave room for two and a half
+    cache.alloc(64 * 1024 * 1024);
+    cache.put('a.mp4', 0, 0n, frames[0]);
+    const entryBytes = cache.bytes;
+    cache.alloc(Math.floor(entryBytes * 2.5));
+
+    cache.put('a.mp4', 0, 0n, frames[0]);
+    cache.put('a.mp4', 0, 1n, frames[1]);
+
+    // Touch pts 0 so pts 1 becomes least recently used
+    const out = new Frame();
+    out.alloc();
+    assert.equal(cache.get('a.mp4', 0, 0n, out), 0);
+
+    cache.put('a.mp4', 0, 2n, frames[2]);
+    assert.ok(cache.bytes <= cache.maxBytes);
+    assert.equal(cache.has('a.mp4', 0, 0n), true);
+    assert.equal(cache.has('a.mp4', 0, 1n), false);
+    assert.equal(cache.has('a.mp4', 0, 2n), true);
+    assert.ok(cache.getStats().evictions >= 1);
+
+    frames.forEach((f) => f.free());
+    out.free();
+  });
+
+  it('should store downscaled copies', () => {
+    using cache = new FrameCache();
+    cache.alloc(16 * 1024 * 1024, 160);
+
+    const frame = createFrame(640, 480, 5n);
+    cache.put('a.mp4', 0, 5n, frame);
+
+    const out = new Frame();
+    out.alloc();
+    assert.equal(cache.get('a.mp4', 0, 5n, out), 0);
+    assert.equal(out.width, 160);
+    assert.equal(out.height, 120);
+    assert.equal(out.pts, 5n);
+
+    frame.free();
+    out.free();
+  });
+
+  it('should prefetch frames in the background', async () => {
+    using cache = new FrameCache();
+    cache.alloc(256 * 1024 * 1024);
+
+    const url = getInputFile('demux.mp4');
+    assert.equal(cache.prefetch(url, 0, 0n, 0n, 1_000_000n), 0);
+
+    for (let i = 0; i < 100 && cache.entries === 0; i++) {
+      await sleep(20);
+    }
+
+    assert.ok(cache.entries > 0, 'Prefetcher should have cached frames');
+    assert.ok(cache.getStats().prefetched > 0);
+  });
+});
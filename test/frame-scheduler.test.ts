@@ -0,0 +1,209 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import {
+  AV_PIX_FMT_YUVJ420P,
+  AV_SAMPLE_FMT_S16,
+  AVERROR_EINVAL,
+  AVERROR_EOF,
+  Codec,
+  CodecContext,
+  FF_ENCODER_MJPEG,
+  FF_ENCODER_PCM_S16LE,
+  Frame,
+  FrameScheduler,
+  Packet,
+  Rational,
+} from '../src/index.js';
+
+const WIDTH = 32;
+const HEIGHT = 32;
+const SAMPLE_RATE = 48000;
+const STEREO = { nbChannels: 2, order: 1, mask: 3n };
+
+async function openVideoEncoder(fps: number): Promise<CodecContext> {
+  const codec = Codec.findEncoderByName(FF_ENCODER_MJPEG);
+  assert.ok(codec);
+  const ctx = new CodecContext();
+  ctx.allocContext3(codec);
+  ctx.width = WIDTH;
+  ctx.height = HEIGHT;
+  ctx.pixelFormat = AV_PIX_FMT_YUVJ420P;
+  ctx.timeBase = new Rational(1, fps);
+  ctx.framerate = new Rational(fps, 1);
+  assert.equal(await ctx.open2(codec, null), 0);
+  return ctx;
+}
+
+async function openAudioEncoder(): Promise<CodecContext> {
+  const codec = Codec.findEncoderByName(FF_ENCODER_PCM_S16LE);
+  assert.ok(codec);
+  const ctx = new CodecContext();
+  ctx.allocContext3(codec);
+  ctx.sampleRate = SAMPLE_RATE;
+  ctx.sampleFormat = AV_SAMPLE_FMT_S16;
+  ctx.channelLayout = STEREO;
+  ctx.timeBase = new Rational(1, SAMPLE_RATE);
+  assert.equal(await ctx.open2(codec, null), 0);
+  return ctx;
+}
+
+function videoFrame(): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = AV_PIX_FMT_YUVJ420P;
+  frame.width = WIDTH;
+  frame.height = HEIGHT;
+  assert.equal(frame.allocBuffer(), 0);
+  return frame;
+}
+
+function audioFrame(samples: number): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = AV_SAMPLE_FMT_S16;
+  frame.sampleRate = SAMPLE_RATE;
+  frame.channelLayout = STEREO;
+  frame.nbSamples = samples;
+  assert.equal(frame.allocBuffer(), 0);
+  return frame;
+}
+
+async function drain(scheduler: FrameScheduler): Promise<bigint[]> {
+  const packet = new Packet();
+  packet.alloc();
+  const pts: bigint[] = [];
+  let ret;
+  while ((ret = await scheduler.receivePacket(packet)) === 0) {
+    pts.push(packet.pts);
+    packet.unref();
+  }
+  assert.equal(ret, AVERROR_EOF);
+  packet.free();
+  return pts;
+}
+
+const sleep = (ms: number) => new Promise((resolve) => setTimeout(resolve, ms));
+
+describe('FrameScheduler', () => {
+  it('should encode at a constant rate and repeat late frames', async () => {
+    const encoder = await openVideoEncoder(50);
+    using scheduler = new FrameScheduler();
+    assert.equal(scheduler.configure(encoder), 0);
+
+    const frame = videoFrame();
+    assert.equal(scheduler.pushFrame(frame), 0);
+    assert.equal(scheduler.start(), 0);
+    assert.ok(scheduler.isRunning);
+
+    const collected = drain(scheduler);
+    await sleep(200);
+    scheduler.end();
+    const pts = await collected;
+
+    // ~10 ticks in 200 ms at 50 fps, pts continuous in the encoder time base
+    assert.ok(pts.length >= 5 && pts.length <= 15, `Encoded ${pts.length} frames in 200 ms at 50 fps`);
+    pts.forEach((value, index) => assert.equal(value, BigInt(index)));
+
+    const stats = scheduler.getStats();
+    assert.equal(stats.framesIn, 1);
+    assert.equal(stats.ticks, pts.length);
+    assert.equal(stats.packets, pts.length);
+    assert.equal(stats.repeats, pts.length - 1);
+    assert.equal(stats.underruns, stats.repeats);
+    assert.equal(scheduler.isRunning, false);
+    assert.equal(scheduler.pushFrame(frame), AVERROR_EOF);
+
+    frame.free();
+    encoder.freeContext();
+  });
+
+  it('should drop the oldest frames when the source runs ahead', async () => {
+    const encoder = await openVideoEncoder(25);
+    using scheduler = new FrameScheduler();
+    assert.equal(scheduler.configure(encoder, { queueSize: 1 }), 0);
+
+    const frame = videoFrame();
+    for (let i = 0; i < 4; i++) {
+      assert.equal(scheduler.pushFrame(frame), 0);
+    }
+    assert.equal(scheduler.getStats().overruns, 3);
+    assert.equal(scheduler.getStats().queued, 1);
+
+    scheduler.start();
+    scheduler.end();
+    assert.equal((await drain(scheduler)).length, 1);
+
+    frame.free();
+    encoder.freeContext();
+  });
+
+  it('should switch to black after the repeat limit', async () => {
+    const encoder = await openVideoEncoder(100);
+    using scheduler = new FrameScheduler();
+    assert.equal(scheduler.configure(encoder, { maxRepeats: 2 }), 0);
+
+    const frame = videoFrame();
+    scheduler.pushFrame(frame);
+    scheduler.start();
+    const collected = drain(scheduler);
+    await sleep(100);
+    scheduler.end();
+    await collected;
+
+    const stats = scheduler.getStats();
+    assert.equal(stats.repeats, 2);
+    assert.ok(stats.fills > 0);
+    assert.equal(stats.underruns, stats.repeats + stats.fills);
+
+    frame.free();
+    encoder.freeContext();
+  });
+
+  it('should pad late audio with silence', async () => {
+    const encoder = await openAudioEncoder();
+    using scheduler = new FrameScheduler();
+    // 10 ms ticks
+    assert.equal(scheduler.configure(encoder, { frameSize: 480 }), 0);
+
+    const frame = audioFrame(720);
+    scheduler.pushFrame(frame);
+    scheduler.start();
+    const collected = drain(scheduler);
+    await sleep(100);
+    scheduler.end();
+    const pts = await collected;
+
+    assert.ok(pts.length >= 4, `Encoded ${pts.length} audio frames in 100 ms`);
+    pts.forEach((value, index) => assert.equal(value, BigInt(index * 480)));
+
+    const stats = scheduler.getStats();
+    assert.ok(stats.underruns >= 1);
+    assert.equal(stats.fills, stats.underruns - 1, 'Second tick is partially filled');
+
+    frame.free();
+    encoder.freeContext();
+  });
+
+  it('should validate configuration and frames', async () => {
+    const encoder = await openVideoEncoder(25);
+    using scheduler = new FrameScheduler();
+    assert.equal(scheduler.start(), AVERROR_EINVAL);
+    assert.equal(scheduler.pushFrame(videoFrame()), AVERROR_EINVAL);
+
+    assert.equal(scheduler.configure(encoder, { fill: 'slate' }), AVERROR_EINVAL);
+    assert.equal(scheduler.configure(encoder, { queueSize: 0 }), AVERROR_EINVAL);
+    assert.equal(scheduler.configure(encoder, { frameRate: { num: 0, den: 1 } }), AVERROR_EINVAL);
+
+    const unopened = new CodecContext();
+    unopened.allocContext3(Codec.findEncoderByName(FF_ENCODER_MJPEG));
+    assert.equal(scheduler.configure(unopened), AVERROR_EINVAL);
+
+    assert.equal(scheduler.configure(encoder, { fill: 'slate' }, videoFrame()), 0);
+    assert.equal(scheduler.configure(encoder), AVERROR_EINVAL, 'Already configured');
+    assert.equal(scheduler.pushFrame(audioFrame(480)), AVERROR_EINVAL);
+
+    unopened.freeContext();
+    encoder.freeContext();
+  });
+});
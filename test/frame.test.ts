@@ -701,6 +701,25 @@ describe('Frame', () => {
       assert.equal(yPlane[1], 1, 'Second Y value should match');
     });
 
+    it('should not write into buffers shared with other frames', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_YUV420P;
+      frame.width = 64;
+      frame.height = 48;
+      frame.allocBuffer();
+      frame.data![0].fill(0);
+
+      const shared = frame.clone();
+      assert.ok(shared);
+
+      const buffer = Buffer.alloc((64 * 48 * 3) / 2, 0x80);
+      assert.equal(frame.fromBuffer(buffer), 0);
+
+      assert.equal(frame.data![0][0], 0x80);
+      assert.equal(shared.data![0][0], 0, 'Clone keeps its data');
+      shared.free();
+    });
+
     it('should fill audio frame from buffer', () => {
       frame.alloc();
       frame.format = AV_SAMPLE_FMT_FLT;
@@ -768,4 +787,92 @@ describe('Frame', () => {
       }, /Buffer required/);
     });
   });
+
+  describe('importBuffer', () => {
+    it('should reference JS memory without copying', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_RGB24;
+      frame.width = 64;
+      frame.height = 32;
+
+      const pixels = Buffer.alloc(64 * 32 * 3, 7);
+      assert.equal(frame.importBuffer(pixels), 0);
+      assert.equal(frame.linesize[0], 64 * 3);
+
+      // Frame planes alias the JS memory
+      pixels[0] = 42;
+      const data = frame.data;
+      assert.ok(data);
+      assert.equal(data[0][0], 42);
+    });
+
+    it('should keep memory alive through references', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_YUV420P;
+      frame.width = 32;
+      frame.height = 32;
+      assert.equal(frame.importBuffer(new Uint8Array(32 * 32 * 2)), 0);
+
+      const ref = new Frame();
+      ref.alloc();
+      assert.equal(ref.ref(frame), 0);
+      frame.unref();
+
+      // Reference still valid after the source dropped its buffers
+      assert.equal(ref.toBuffer().length, 32 * 32 + 16 * 16 * 2);
+      ref.free();
+    });
+
+    it('should import planar audio from an ArrayBuffer', () => {
+      frame.alloc();
+      frame.format = AV_SAMPLE_FMT_FLTP;
+      frame.nbSamples = 256;
+      frame.channelLayout = { order: 0, nbChannels: 2, mask: 3n };
+
+      const samples = new ArrayBuffer(256 * 4 * 2);
+      assert.equal(frame.importBuffer(samples), 0);
+      assert.equal(frame.toBuffer().length, samples.byteLength);
+    });
+
+    it('should reject buffers that are too small', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_RGB24;
+      frame.width = 64;
+      frame.height = 32;
+
+      assert.ok(frame.importBuffer(Buffer.alloc(16)) < 0);
+      assert.throws(() => {
+        // @ts-expect-error Testing invalid input
+        frame.importBuffer('not a buffer');
+      }, /Buffer, ArrayBuffer or TypedArray required/);
+    });
+  });
+
+  describe('toBuffer with target', () => {
+    it('should write into a preallocated buffer', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_RGB24;
+      frame.width = 16;
+      frame.height = 8;
+      frame.allocBuffer();
+      frame.fromBuffer(Buffer.alloc(16 * 8 * 3, 9));
+
+      const target = Buffer.alloc(16 * 8 * 3 + 10);
+      assert.equal(frame.toBuffer(target, 10), 16 * 8 * 3);
+      assert.equal(target[9], 0);
+      assert.equal(target[10], 9);
+      assert.deepEqual(target.subarray(10), frame.toBuffer());
+    });
+
+    it('should throw if the target is too small', () => {
+      frame.alloc();
+      frame.format = AV_PIX_FMT_RGB24;
+      frame.width = 16;
+      frame.height = 8;
+      frame.allocBuffer();
+
+      assert.throws(() => frame.toBuffer(Buffer.alloc(100)), RangeError);
+      assert.throws(() => frame.toBuffer(Buffer.alloc(16 * 8 * 3), 1), RangeError);
+    });
+  });
 });
@@ -0,0 +1,104 @@
+import assert from 'node:assert';
+import { existsSync, mkdirSync, readFileSync, rmSync } from 'node:fs';
+import { join } from 'node:path';
+import { after, describe, it } from 'node:test';
+
+import { AV_PIX_FMT_YUV420P, AVERROR_EINVAL, Frame, ImageSequenceWriter } from '../src/index.js';
+import { getOutputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const outputDir = getOutputFile('image-sequence');
+mkdirSync(outputDir, { recursive: true });
+
+function createFrame(index: number, width = 64, height = 48): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = AV_PIX_FMT_YUV420P;
+  frame.width = width;
+  frame.height = height;
+  frame.pts = BigInt(index);
+  frame.timeBase = { num: 1, den: 25 };
+
+  const pixels = Buffer.alloc((width * height * 3) / 2, 128);
+  pixels.fill(16 + ((index * 37) % 200), 0, width * height);
+  assert.equal(frame.fromBuffer(pixels), 0);
+  return frame;
+}
+
+describe('ImageSequenceWriter', () => {
+  after(() => {
+    rmSync(outputDir, { recursive: true, force: true });
+  });
+
+  it('should reject invalid patterns and unopened use', () => {
+    using writer = new ImageSequenceWriter();
+    const frame = createFrame(0);
+    assert.equal(writer.writeSync(frame), AVERROR_EINVAL);
+    assert.equal(writer.openSync({ pattern: join(outputDir, 'still.jpg') }), AVERROR_EINVAL, 'Pattern needs a sequence field');
+    assert.equal(writer.openSync({ pattern: join(outputDir, '%05d.unknown') }), AVERROR_EINVAL);
+    assert.equal(writer.isOpen, false);
+    frame.free();
+  });
+
+  it('should write numbered JPEG images on a worker pool', async () => {
+    using writer = new ImageSequenceWriter();
+    const pattern = join(outputDir, 'jpeg-%05d.jpg');
+    assert.equal(await writer.open({ pattern, workers: 4, maxPending: 3, startNumber: 0, quality: 3, collectResults: true }), 0);
+    assert.equal(writer.workers, 4);
+
+    for (let i = 0; i < 20; i++) {
+      const frame = createFrame(i);
+      assert.equal(await writer.write(frame), 0);
+      // Referenced by the writer, free to release
+      frame.free();
+      assert.ok(writer.pending <= 3);
+    }
+
+    assert.equal(await writer.close(), 0);
+    assert.equal(writer.isOpen, false);
+
+    const results = writer.readResults();
+    assert.deepEqual(
+      results.map((result) => result.number),
+      Array.from({ length: 20 }, (_, i) => i),
+    );
+    for (const result of results) {
+      assert.equal(result.ret, 0);
+      assert.equal(result.filename, join(outputDir, `jpeg-${String(result.number).padStart(5, '0')}.jpg`));
+      const data = readFileSync(result.filename);
+      assert.equal(data.length, result.size);
+      assert.equal(data.readUInt16BE(0), 0xffd8, 'JPEG start of image');
+      assert.ok(result.latency >= 0);
+    }
+
+    const stats = writer.getStats();
+    assert.equal(stats.images, 20);
+    assert.equal(stats.failed, 0);
+    assert.equal(stats.pending, 0);
+    assert.ok(stats.bytes > 0);
+    assert.ok(stats.maxLatency >= stats.averageLatency);
+  });
+
+  it('should keep numbering across sizes and converted formats', () => {
+    using writer = new ImageSequenceWriter();
+    // PNG has no YUV: frames are converted per worker; sizes change per frame
+    assert.equal(writer.openSync({ pattern: join(outputDir, 'png-%03d.png'), workers: 3 }), 0);
+
+    for (let i = 0; i < 9; i++) {
+      const frame = createFrame(i, 32 + i * 2, 16);
+      assert.equal(writer.writeSync(frame), 0);
+      frame.free();
+    }
+    assert.equal(writer.closeSync(), 0);
+
+    for (let i = 0; i < 9; i++) {
+      const file = join(outputDir, `png-${String(i + 1).padStart(3, '0')}.png`);
+      assert.ok(existsSync(file));
+      // IHDR width identifies the frame that was written under this number
+      assert.equal(readFileSync(file).readUInt32BE(16), 32 + i * 2);
+    }
+    assert.equal(existsSync(join(outputDir, 'png-010.png')), false);
+    assert.deepEqual(writer.readResults(), [], 'Results are only kept on request');
+  });
+});
@@ -1,12 +1,16 @@
 import assert from 'node:assert';
 import { readFileSync, statSync, writeFileSync } from 'node:fs';
+import { createServer } from 'node:http';
 import { readFile, stat, unlink, writeFile } from 'node:fs/promises';
-import { afterEach, describe, it } from 'node:test';
+import { after, afterEach, before, describe, it } from 'node:test';
 import { pathToFileURL } from 'node:url';
 
-import { AVIO_FLAG_READ, AVIO_FLAG_WRITE, AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE, IOContext } from '../src/index.js';
+import { AVERROR_HTTP_NOT_FOUND, AVIO_FLAG_READ, AVIO_FLAG_WRITE, AVSEEK_CUR, AVSEEK_END, AVSEEK_SET, AVSEEK_SIZE, IOContext, MediaInput, MediaOutput } from '../src/index.js';
 import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
 
+import type { Server } from 'node:http';
+import type { AddressInfo } from 'node:net';
+
 prepareTestEnvironment();
 
 const testVideoFile = getInputFile('video.mp4');
@@ -1182,5 +1186,466 @@ describe('IOContext', () => {
         io.freeContext();
       }
     });
+
+    it('should keep bytes beyond the requested size for following reads', async () => {
+      const data = Buffer.alloc(50000);
+      for (let i = 0; i < data.length; i++) {
+        data[i] = (i * 7) & 0xff;
+      }
+      const scratch = Buffer.from(data);
+      let served = false;
+
+      const io = new IOContext();
+      io.allocContextWithCallbacks(4096, 0, () => {
+        if (served) {
+          return null;
+        }
+        served = true;
+        return scratch; // Whole source at once, much larger than requested
+      });
+
+      const chunks: Buffer[] = [];
+      for (;;) {
+        const chunk = await io.read(1000);
+        if (!Buffer.isBuffer(chunk) || chunk.length === 0) {
+          break;
+        }
+        chunks.push(chunk);
+        // Sources may reuse their buffers once the callback returned
+        scratch.fill(0);
+      }
+      assert.ok(Buffer.concat(chunks).equals(data));
+
+      const stats = io.getCallbackStats();
+      assert.ok(stats);
+      assert.equal(stats.readCallbacks, 2);
+      assert.ok(stats.bufferedReads > 0);
+      assert.equal(stats.bytesRead, data.length);
+      io.freeContext();
+    });
+
+    it('should discard kept bytes on seek', async () => {
+      const data = Buffer.from('0123456789'.repeat(2000));
+      let position = 0;
+
+      const io = new IOContext();
+      io.allocContextWithCallbacks(
+        1024,
+        0,
+        () => {
+          if (position >= data.length) {
+            return null;
+          }
+          const chunk = data.subarray(position, position + 8192);
+          position += chunk.length;
+          return chunk;
+        },
+        undefined,
+        (offset: bigint, whence: number) => {
+          if (whence === AVSEEK_SIZE) {
+            return BigInt(data.length);
+          }
+          position = Number(offset);
+          return offset;
+        },
+      );
+
+      const first = await io.read(3000);
+      assert.ok(Buffer.isBuffer(first) && first.equals(data.subarray(0, 3000)));
+
+      // Behind the AVIO buffer: real seek while the JS source is ahead
+      assert.equal(await io.seek(10n, AVSEEK_SET), 10n);
+      const second = await io.read(10);
+      assert.ok(Buffer.isBuffer(second) && second.equals(data.subarray(10, 20)));
+
+      assert.equal(await io.seek(15003n, AVSEEK_SET), 15003n);
+      const third = await io.read(10);
+      assert.ok(Buffer.isBuffer(third) && third.equals(data.subarray(15003, 15013)));
+      io.freeContext();
+    });
+
+    it('should adapt the read size to the source', async () => {
+      const data = Buffer.alloc(4 * 1024 * 1024, 1);
+      let position = 0;
+      const requested: number[] = [];
+
+      const io = new IOContext();
+      io.allocContextWithCallbacks(
+        4096,
+        0,
+        (size: number) => {
+          requested.push(size);
+          if (position >= data.length) {
+            return null;
+          }
+          const chunk = data.subarray(position, position + size);
+          position += chunk.length;
+          return chunk;
+        },
+        undefined,
+        undefined,
+        { adaptive: true, maxReadSize: 262144 },
+      );
+
+      let total = 0;
+      for (;;) {
+        const chunk = await io.read(65536);
+        if (!Buffer.isBuffer(chunk) || chunk.length === 0) {
+          break;
+        }
+        total += chunk.length;
+      }
+      assert.equal(total, data.length);
+
+      // Full reads grow the request up to the limit
+      assert.equal(requested[0], 4096);
+      assert.equal(Math.max(...requested), 262144);
+      assert.ok(requested.length < data.length / 4096 / 4);
+      assert.equal(io.getCallbackStats()!.readCallbacks, requested.length);
+      io.freeContext();
+    });
+
+    it('should shrink the read size for trickling sources', async () => {
+      let calls = 0;
+      const requested: number[] = [];
+
+      const io = new IOContext();
+      io.allocContextWithCallbacks(
+        65536,
+        0,
+        (size: number) => {
+          requested.push(size);
+          return ++calls > 8 ? null : Buffer.alloc(188, 0x47); // One TS packet at a time
+        },
+        undefined,
+        undefined,
+        { adaptive: true },
+      );
+
+      for (let i = 0; i < 8; i++) {
+        await io.read(188);
+      }
+      assert.ok(requested.at(-1)! < 65536);
+      assert.ok(requested.at(-1)! >= 4096);
+      io.freeContext();
+    });
+  });
+
+  describe('File Backend', () => {
+    it('should read a file through the native backend', async () => {
+      const expected = readFileSync(testVideoFile);
+      const io = new IOContext();
+      const ret = await io.openFile(testVideoFile, AVIO_FLAG_READ, { blockSize: 4096, queueDepth: 4, bufferSize: 1000 });
+      assert.equal(ret, 0);
+
+      const chunks: Buffer[] = [];
+      for (;;) {
+        const data = io.readSync(3000);
+        if (!Buffer.isBuffer(data)) {
+          break;
+        }
+        chunks.push(data);
+      }
+      assert.ok(Buffer.concat(chunks).equals(expected), 'Should read identical bytes');
+
+      const stats = io.getFileStats();
+      assert.ok(stats);
+      assert.ok(stats.engine === 'uring' || stats.engine === 'threads');
+      assert.equal(stats.bytesRead, expected.length);
+      assert.ok(stats.readOps >= Math.ceil(expected.length / 4096));
+      assert.ok(stats.maxInFlight <= 4);
+
+      assert.equal(await io.closep(), 0);
+      assert.equal(io.getFileStats(), null);
+    });
+
+    it('should seek inside and outside the readahead window', () => {
+      const expected = readFileSync(testVideoFile);
+      const io = new IOContext();
+      assert.equal(io.openFileSync(testVideoFile, AVIO_FLAG_READ, { blockSize: 4096, queueDepth: 2, bufferSize: 512 }), 0);
+
+      assert.equal(io.sizeSync(), BigInt(expected.length));
+
+      for (const offset of [5000, 5100, 100, expected.length - 300, 0]) {
+        io.seekSync(BigInt(offset), AVSEEK_SET);
+        const data = io.readSync(200);
+        assert.ok(Buffer.isBuffer(data));
+        assert.ok(data.equals(expected.subarray(offset, offset + 200)), `Data at ${offset} should match`);
+      }
+
+      io.closepSync();
+    });
+
+    it('should coalesce writes and apply seek-back rewrites', () => {
+      const io = new IOContext();
+      assert.equal(io.openFileSync(tempOutputFile, AVIO_FLAG_WRITE, { engine: 'threads', blockSize: 4096, queueDepth: 2, bufferSize: 1024 }), 0);
+
+      const payload = Buffer.alloc(20000);
+      for (let i = 0; i < payload.length; i++) {
+        payload[i] = i & 0xff;
+      }
+      io.writeSync(payload.subarray(0, 7000));
+      io.writeSync(payload.subarray(7000));
+
+      // Rewrite a header like muxers do when writing the trailer
+      io.seekSync(0n, AVSEEK_SET);
+      io.writeSync(Buffer.from('HEAD'));
+      io.seekSync(0n, AVSEEK_END);
+      io.writeSync(Buffer.from('TAIL'));
+
+      const stats = io.getFileStats();
+      assert.equal(stats?.engine, 'threads');
+      assert.equal(io.closepSync(), 0);
+
+      const written = readFileSync(tempOutputFile);
+      assert.equal(written.length, payload.length + 4);
+      assert.equal(written.subarray(0, 4).toString(), 'HEAD');
+      assert.ok(written.subarray(4, payload.length).equals(payload.subarray(4)));
+      assert.equal(written.subarray(payload.length).toString(), 'TAIL');
+    });
+
+    it('should write recordings around the page cache', () => {
+      for (const cache of ['direct', 'dontneed'] as const) {
+        const io = new IOContext();
+        assert.equal(io.openFileSync(tempOutputFile, AVIO_FLAG_WRITE, { cache, fsync: cache === 'direct' ? 'close' : 8192, blockSize: 8192, queueDepth: 2 }), 0);
+
+        const payload = Buffer.alloc(30001);
+        for (let i = 0; i < payload.length; i++) {
+          payload[i] = (i * 13) & 0xff;
+        }
+        io.writeSync(payload);
+
+        // Unaligned header rewrite and append, like an mp4 trailer
+        io.seekSync(10n, AVSEEK_SET);
+        io.writeSync(Buffer.from('MOOV'));
+        io.seekSync(0n, AVSEEK_END);
+        io.writeSync(Buffer.from('END'));
+        io.flushSync();
+
+        const stats = io.getFileStats();
+        assert.ok(stats);
+        assert.ok(stats.writeAmplification >= 1);
+        assert.equal(stats.writeLatency.length, stats.syncLatency.length);
+        assert.equal(io.closepSync(), 0);
+
+        const written = readFileSync(tempOutputFile);
+        assert.equal(written.length, payload.length + 3, `${cache}: size`);
+        assert.equal(written.subarray(10, 14).toString(), 'MOOV');
+        assert.ok(written.subarray(14, payload.length).equals(payload.subarray(14)), `${cache}: payload`);
+        assert.equal(written.subarray(payload.length).toString(), 'END');
+      }
+    });
+
+    it('should report sync and latency statistics', () => {
+      const io = new IOContext();
+      assert.equal(io.openFileSync(tempOutputFile, AVIO_FLAG_WRITE, { fsync: 4096, blockSize: 4096, queueDepth: 1, bufferSize: 4096 }), 0);
+      io.writeSync(Buffer.alloc(16384, 1));
+      io.flushSync();
+      io.writeSync(Buffer.alloc(1, 2));
+
+      const stats = io.getFileStats();
+      assert.ok(stats);
+      // Queue depth 1: every block completes before the next one is submitted
+      const completed = stats.writeLatency.reduce((a, b) => a + b, 0);
+      assert.ok(completed >= 3 && completed <= stats.writeOps);
+      assert.ok(stats.syncs >= 3);
+      assert.equal(stats.syncLatency.reduce((a, b) => a + b, 0), stats.syncs);
+      assert.equal(io.closepSync(), 0);
+      assert.equal(statSync(tempOutputFile).size, 16385);
+    });
+
+    it('should fail for missing files', async () => {
+      const io = new IOContext();
+      const ret = await io.openFile(getInputFile('does-not-exist.mp4'), AVIO_FLAG_READ);
+      assert.ok(ret < 0);
+      assert.equal(io.getFileStats(), null);
+    });
+
+    it('should demux and mux with fileIO option', async () => {
+      let packets = 0;
+      let expectedPackets = 0;
+
+      {
+        await using plain = await MediaInput.open(testVideoFile);
+        for await (const packet of plain.packets()) {
+          expectedPackets++;
+          packet.free();
+        }
+      }
+
+      {
+        await using input = await MediaInput.open(testVideoFile, { fileIO: { queueDepth: 4 } });
+        await using output = await MediaOutput.open(tempOutputFile, { fileIO: true });
+        const streamIndex = output.addStream(input.video()!);
+
+        for await (const packet of input.packets()) {
+          packets++;
+          if (packet.streamIndex === input.video()!.index) {
+            await output.writePacket(packet, streamIndex);
+          }
+          packet.free();
+        }
+      }
+
+      assert.equal(packets, expectedPackets);
+
+      await using check = await MediaInput.open(tempOutputFile);
+      assert.ok(check.video());
+    });
+  });
+
+  describe('HTTP Backend', () => {
+    const content = readFileSync(testVideoFile);
+    let server: Server;
+    let baseUrl: string;
+    let connections = 0;
+    let requests = 0;
+
+    before(async () => {
+      // Local stand-in for a remote server: ranges, keep-alive, redirects and some latency
+      server = createServer((req, res) => {
+        requests++;
+        if (req.url === '/redirect') {
+          res.writeHead(302, { Location: '/video.mp4' }).end();
+          return;
+        }
+        if (req.url !== '/video.mp4' && req.url !== '/norange.mp4') {
+          res.writeHead(404).end();
+          return;
+        }
+        setTimeout(() => {
+          const match = /^bytes=(\d+)-(\d*)$/.exec(req.headers.range ?? '');
+          if (!match || req.url === '/norange.mp4') {
+            res.writeHead(200, { 'Content-Length': content.length }).end(content);
+            return;
+          }
+          const start = Number(match[1]);
+          const end = Math.min(match[2] ? Number(match[2]) : content.length - 1, content.length - 1);
+          res
+            .writeHead(206, { 'Content-Length': end - start + 1, 'Content-Range': `bytes ${start}-${end}/${content.length}` })
+            .end(content.subarray(start, end + 1));
+        }, 5);
+      });
+      server.on('connection', () => connections++);
+      await new Promise<void>((resolve) => server.listen(0, '127.0.0.1', resolve));
+      baseUrl = `http://127.0.0.1:${(server.address() as AddressInfo).port}`;
+    });
+
+    after(async () => {
+      server.closeAllConnections();
+      await new Promise((resolve) => server.close(resolve));
+    });
+
+    const readAll = async (io: IOContext): Promise<Buffer> => {
+      const chunks: Buffer[] = [];
+      for (;;) {
+        const data = await io.read(65536);
+        if (!Buffer.isBuffer(data) || data.length === 0) {
+          break;
+        }
+        chunks.push(data);
+      }
+      return Buffer.concat(chunks);
+    };
+
+    it('should read with parallel range requests over keep-alive connections', async () => {
+      connections = 0;
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/video.mp4`, { connections: 3, blockSize: 16384 }), 0);
+      assert.equal(io.seekable & 1, 1);
+      assert.equal(await io.size(), BigInt(content.length));
+
+      const data = await readAll(io);
+      assert.ok(data.equals(content));
+
+      const stats = io.getHttpStats();
+      assert.ok(stats);
+      assert.equal(stats.size, content.length);
+      assert.equal(stats.bytesRead, content.length);
+      assert.ok(stats.requests >= Math.ceil(content.length / 16384));
+      assert.ok(stats.connections <= 3);
+      assert.equal(connections, stats.connections);
+      assert.ok(stats.reusedConnections > 0);
+      assert.equal(await io.closep(), 0);
+    });
+
+    it('should serve seeks from the block cache', async () => {
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/video.mp4`, { blockSize: 16384 }), 0);
+
+      // moov-at-end style access: tail first, then back to the start
+      const tail = BigInt(content.length - 1000);
+      assert.equal(await io.seek(tail, AVSEEK_SET), tail);
+      const end = await io.read(1000);
+      assert.ok(Buffer.isBuffer(end) && end.equals(content.subarray(content.length - 1000)));
+
+      assert.equal(await io.seek(0n, AVSEEK_SET), 0n);
+      const head = await io.read(4096);
+      assert.ok(Buffer.isBuffer(head) && head.equals(content.subarray(0, 4096)));
+
+      const requestsBefore = io.getHttpStats()!.requests;
+      assert.equal(await io.seek(tail, AVSEEK_SET), tail);
+      const again = await io.read(1000);
+      assert.ok(Buffer.isBuffer(again) && again.equals(end));
+      assert.equal(io.getHttpStats()!.requests, requestsBefore);
+      assert.ok(io.getHttpStats()!.memoryHits > 0);
+      assert.equal(await io.closep(), 0);
+    });
+
+    it('should reread evicted blocks from the disk cache', async () => {
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/video.mp4`, { blockSize: 16384, prefetch: 1, cacheSize: 0, diskCacheSize: content.length }), 0);
+      assert.ok((await readAll(io)).equals(content));
+
+      assert.equal(await io.seek(0n, AVSEEK_SET), 0n);
+      assert.ok((await readAll(io)).equals(content));
+
+      const stats = io.getHttpStats();
+      assert.ok(stats);
+      assert.ok(stats.diskHits > 0);
+      assert.equal(await io.closep(), 0);
+    });
+
+    it('should follow redirects', async () => {
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/redirect`), 0);
+      assert.ok((await readAll(io)).equals(content));
+      assert.equal(io.getHttpStats()!.redirects, 1);
+      assert.equal(await io.closep(), 0);
+    });
+
+    it('should stream servers without range support', async () => {
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/norange.mp4`), 0);
+      assert.equal(io.getHttpStats()!.seekable, false);
+      assert.ok((await readAll(io)).equals(content));
+      assert.equal(await io.closep(), 0);
+    });
+
+    it('should fail for missing resources', async () => {
+      const io = new IOContext();
+      assert.equal(await io.openHttp(`${baseUrl}/missing.mp4`), AVERROR_HTTP_NOT_FOUND);
+      assert.equal(io.getHttpStats(), null);
+    });
+
+    it('should demux with httpIO option', async () => {
+      let expectedPackets = 0;
+      {
+        await using plain = await MediaInput.open(testVideoFile);
+        for await (const packet of plain.packets()) {
+          expectedPackets++;
+          packet.free();
+        }
+      }
+
+      let packets = 0;
+      await using input = await MediaInput.open(`${baseUrl}/video.mp4`, { httpIO: { blockSize: 65536 } });
+      assert.ok(input.video());
+      for await (const packet of input.packets()) {
+        packets++;
+        packet.free();
+      }
+      assert.equal(packets, expectedPackets);
+    });
   });
 });
@@ -0,0 +1,140 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { AV_PIX_FMT_RGBA, AV_PIX_FMT_YUV420P, AV_PIX_FMT_YUV420P10LE, AVERROR_EINVAL, Frame, LogoOverlay } from '../src/index.js';
+import { prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const WIDTH = 32;
+const HEIGHT = 32;
+
+// Black limited range frame
+function createFrame(tenBit = false): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = tenBit ? AV_PIX_FMT_YUV420P10LE : AV_PIX_FMT_YUV420P;
+  frame.width = WIDTH;
+  frame.height = HEIGHT;
+  frame.pts = 0n;
+
+  const lumaSize = WIDTH * HEIGHT;
+  const chromaSize = lumaSize / 4;
+  if (tenBit) {
+    const pixels = Buffer.alloc((lumaSize + chromaSize * 2) * 2);
+    for (let i = 0; i < lumaSize + chromaSize * 2; i++) {
+      pixels.writeUInt16LE(i < lumaSize ? 64 : 512, i * 2);
+    }
+    assert.equal(frame.fromBuffer(pixels), 0);
+  } else {
+    const pixels = Buffer.alloc(lumaSize + chromaSize * 2, 128);
+    pixels.fill(16, 0, lumaSize);
+    assert.equal(frame.fromBuffer(pixels), 0);
+  }
+  return frame;
+}
+
+// RGBA logo, `pixel(x, y)` returns [r, g, b, a]
+function createLogo(width: number, height: number, pixel: (x: number, y: number) => number[]): Frame {
+  const logo = new Frame();
+  logo.alloc();
+  logo.format = AV_PIX_FMT_RGBA;
+  logo.width = width;
+  logo.height = height;
+
+  const pixels = Buffer.alloc(width * height * 4);
+  for (let y = 0; y < height; y++) {
+    for (let x = 0; x < width; x++) {
+      pixels.set(pixel(x, y), (y * width + x) * 4);
+    }
+  }
+  assert.equal(logo.fromBuffer(pixels), 0);
+  return logo;
+}
+
+function luma(frame: Frame, x: number, y: number): number {
+  return frame.toBuffer()[y * WIDTH + x];
+}
+
+describe('LogoOverlay', () => {
+  it('should reject invalid logos and options', () => {
+    using overlay = new LogoOverlay();
+    const frame = createFrame();
+    assert.equal(overlay.applySync(frame), AVERROR_EINVAL);
+
+    assert.equal(overlay.alloc(frame), AVERROR_EINVAL, 'YUV is not a logo format');
+    const logo = createLogo(8, 8, () => [255, 255, 255, 255]);
+    assert.equal(overlay.alloc(logo, { opacity: 2 }), AVERROR_EINVAL);
+    logo.free();
+    frame.free();
+  });
+
+  it('should blend an opaque logo at its position only', () => {
+    using overlay = new LogoOverlay();
+    const logo = createLogo(8, 8, () => [255, 255, 255, 255]);
+    assert.equal(overlay.alloc(logo, { x: 4, y: 6 }), 0);
+    logo.free();
+
+    const frame = createFrame();
+    assert.equal(overlay.applySync(frame), 0);
+
+    assert.equal(luma(frame, 4, 6), 235);
+    assert.equal(luma(frame, 11, 13), 235);
+    assert.equal(luma(frame, 3, 6), 16);
+    assert.equal(luma(frame, 12, 6), 16);
+    assert.equal(luma(frame, 4, 14), 16);
+
+    const chroma = frame.toBuffer()[WIDTH * HEIGHT + 4 * (WIDTH / 2) + 3];
+    assert.equal(chroma, 128, 'White keeps neutral chroma');
+    frame.free();
+  });
+
+  it('should apply alpha, opacity and edge-relative positions', async () => {
+    using overlay = new LogoOverlay();
+    // Transparent border around an opaque 4x4 center
+    const logo = createLogo(16, 16, (x, y) => [255, 255, 255, x >= 6 && x < 10 && y >= 6 && y < 10 ? 255 : 0]);
+    assert.equal(overlay.alloc(logo, { x: -2, y: -2, opacity: 0.5 }), 0);
+    logo.free();
+
+    const frame = createFrame();
+    assert.equal(await overlay.apply(frame), 0);
+
+    // Logo spans 14..30, center 20..24
+    const blended = luma(frame, 20, 20);
+    assert.ok(Math.abs(blended - 125.5) <= 1, `Half opacity gives ${blended}`);
+    assert.equal(luma(frame, 19, 20), 16);
+    assert.equal(luma(frame, 24, 23), 16);
+    frame.free();
+
+    // Moved out of the frame
+    overlay.setPosition(100, 0);
+    const outside = createFrame();
+    assert.equal(await overlay.apply(outside), 0);
+    assert.equal(Math.max(...outside.toBuffer().subarray(0, WIDTH * HEIGHT)), 16);
+    outside.free();
+
+    const stats = overlay.getStats();
+    assert.equal(stats.frames, 1);
+    assert.equal(stats.skipped, 1);
+    assert.equal(stats.renders, 1);
+  });
+
+  it('should prepare the logo per pixel format', () => {
+    using overlay = new LogoOverlay();
+    const logo = createLogo(4, 4, () => [255, 255, 255, 255]);
+    assert.equal(overlay.alloc(logo), 0);
+    logo.free();
+
+    const frame = createFrame();
+    assert.equal(overlay.applySync(frame), 0);
+    frame.free();
+
+    const tenBit = createFrame(true);
+    assert.equal(overlay.applySync(tenBit), 0);
+    assert.equal(tenBit.toBuffer().readUInt16LE(0), 940);
+    assert.equal(tenBit.toBuffer().readUInt16LE(4 * 2), 64);
+    tenBit.free();
+
+    assert.equal(overlay.getStats().renders, 2);
+  });
+});
@@ -0,0 +1,104 @@
+import assert from 'node:assert';
+import { createHash } from 'node:crypto';
+import { describe, it } from 'node:test';
+
+import { AV_PIX_FMT_YUV420P, AVERROR_EINVAL, Frame, MediaHasher, Packet } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+function createFrame(width: number, height: number, pts: bigint): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.width = width;
+  frame.height = height;
+  frame.format = AV_PIX_FMT_YUV420P;
+  frame.pts = pts;
+  frame.timeBase = { num: 1, den: 25 };
+  assert.equal(frame.getBuffer(), 0);
+  return frame;
+}
+
+describe('MediaHasher', () => {
+  it('should reject unknown algorithms', () => {
+    using hasher = new MediaHasher();
+    assert.equal(hasher.alloc('does-not-exist'), AVERROR_EINVAL);
+    assert.equal(hasher.algorithm, null);
+  });
+
+  it('should hash frames without padding like a packed copy', () => {
+    using hasher = new MediaHasher();
+    assert.equal(hasher.alloc('md5'), 0);
+    assert.equal(hasher.algorithm, 'MD5');
+    assert.equal(hasher.digestSize, 16);
+
+    // Odd width forces linesize padding
+    const frame = createFrame(33, 17, 3n);
+    const packed = frame.toBuffer();
+
+    assert.equal(hasher.addFrame(frame, 0), 0);
+    assert.equal(hasher.count, 1);
+    assert.equal(hasher.getHash(0), createHash('md5').update(packed).digest('hex'));
+    assert.equal(hasher.getHash(1), null);
+
+    const entries = hasher.getEntries();
+    assert.equal(entries.size[0], packed.length);
+    assert.equal(entries.pts[0], 3n);
+    assert.equal(entries.digests.length, 16);
+
+    const text = hasher.toFrameMd5() ?? '';
+    assert.ok(text.startsWith('#format: frame checksums\n#version: 2\n#hash: MD5\n'));
+    assert.ok(text.includes('#tb 0: 1/25'));
+    assert.ok(text.includes('#codec_id 0: rawvideo'));
+    assert.ok(text.includes('#dimensions 0: 33x17'));
+    assert.ok(text.trimEnd().endsWith(`${packed.length}, ${hasher.getHash(0)}`));
+
+    frame.free();
+  });
+
+  it('should hash packet payloads', () => {
+    using hasher = new MediaHasher();
+    hasher.alloc('murmur3');
+
+    const packet = new Packet();
+    packet.alloc();
+    packet.data = Buffer.from('hello world');
+    packet.streamIndex = 2;
+
+    assert.equal(hasher.addPacket(packet), 0);
+    assert.equal(hasher.digestSize, 16);
+    assert.equal(hasher.getEntries().streamIndex[0], 2);
+
+    // Same payload, same digest
+    hasher.addPacket(packet);
+    assert.equal(hasher.getHash(0), hasher.getHash(1));
+
+    hasher.clear();
+    assert.equal(hasher.count, 0);
+    packet.free();
+  });
+
+  it('should scan packets and frames of a file', async () => {
+    using hasher = new MediaHasher();
+    hasher.alloc();
+
+    const packets = await hasher.scan(inputFile);
+    assert.ok(packets > 0);
+    assert.equal(hasher.count, packets);
+    const text = hasher.toFrameMd5() ?? '';
+    assert.ok(text.includes('#codec_id 0: h264'));
+
+    hasher.clear();
+    const frames = hasher.scanSync(inputFile, 'frames', 0);
+    assert.ok(frames > 0);
+    assert.ok(Array.from(hasher.getEntries().streamIndex).every((index) => index === 0));
+
+    // Deterministic
+    const first = hasher.toFrameMd5();
+    hasher.clear();
+    await hasher.scan(inputFile, 'frames', 0);
+    assert.equal(hasher.toFrameMd5(), first);
+  });
+});
@@ -0,0 +1,164 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Encoder, MediaInput } from '../src/api/index.js';
+import { AV_SAMPLE_FMT_FLTP, AVERROR_EINVAL, FF_ENCODER_AAC, Frame, Packet, PacketAllocator } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+describe('PacketAllocator', () => {
+  it('should round maxSize up to a size class', () => {
+    using allocator = new PacketAllocator();
+    assert.equal(allocator.maxSize, 0);
+    assert.equal(allocator.alloc({ maxSize: 3000 }), 0);
+    assert.equal(allocator.maxSize, 4096);
+
+    assert.equal(allocator.alloc({ maxSize: 0 }), AVERROR_EINVAL);
+    assert.equal(allocator.alloc({ maxSize: 1 << 20 }), AVERROR_EINVAL);
+    assert.equal(allocator.alloc({ slabSize: -1 }), AVERROR_EINVAL);
+  });
+
+  it('should serve small payloads from slabs', () => {
+    using allocator = new PacketAllocator();
+    allocator.alloc({ maxSize: 1024 });
+
+    const small = new Packet();
+    small.alloc();
+    assert.equal(allocator.allocPacket(small, 300), 0);
+    assert.equal(small.size, 300);
+
+    let stats = allocator.getStats();
+    assert.equal(stats.allocations, 1);
+    assert.equal(stats.inUse, 1);
+    assert.equal(stats.bytesInUse, 300);
+    assert.equal(stats.slabs, 1);
+
+    // Too large for any size class
+    const large = new Packet();
+    large.alloc();
+    assert.equal(allocator.allocPacket(large, 5000), 0);
+    assert.equal(large.size, 5000);
+    assert.equal(allocator.getStats().fallbacks, 1);
+
+    small.free();
+    large.free();
+    stats = allocator.getStats();
+    assert.equal(stats.inUse, 0);
+    assert.equal(stats.bytesInUse, 0);
+
+    // Freed blocks are reused without a new slab
+    const again = new Packet();
+    again.alloc();
+    allocator.allocPacket(again, 200);
+    stats = allocator.getStats();
+    assert.equal(stats.slabs, 1);
+    assert.ok(stats.cacheHits >= 1);
+    again.free();
+  });
+
+  it('should clone and adopt payloads into slab memory', () => {
+    using allocator = new PacketAllocator();
+    allocator.alloc();
+
+    const packet = new Packet();
+    packet.alloc();
+    packet.data = Buffer.from('payload data');
+    packet.pts = 42n;
+
+    const copy = packet.clone(allocator);
+    assert.ok(copy);
+    assert.equal(copy.pts, 42n);
+    assert.deepEqual(copy.data, Buffer.from('payload data'));
+    assert.equal(allocator.getStats().copies, 1);
+
+    // Already slab memory
+    assert.equal(allocator.adopt(copy), 0);
+    assert.equal(allocator.adopt(packet), 1);
+    assert.deepEqual(packet.data, Buffer.from('payload data'));
+    assert.equal(allocator.getStats().inUse, 2);
+
+    copy.free();
+    packet.free();
+    assert.equal(allocator.getStats().inUse, 0);
+  });
+
+  it('should keep slabs alive after the allocator is freed', () => {
+    const allocator = new PacketAllocator();
+    allocator.alloc();
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(allocator.allocPacket(packet, 16), 0);
+    allocator.free();
+    assert.equal(allocator.maxSize, 0);
+
+    const copy = packet.clone();
+    assert.ok(copy);
+    assert.equal(copy.data?.length, 16);
+    packet.free();
+    copy.free();
+  });
+
+  it('should place demuxed audio packets in slab memory', async () => {
+    using allocator = new PacketAllocator();
+    allocator.alloc();
+
+    await using input = await MediaInput.open(inputFile, { packetAllocator: allocator });
+    const audio = input.audio();
+    assert.ok(audio);
+
+    let count = 0;
+    for await (const packet of input.packets(audio.index)) {
+      assert.ok(packet.size > 0);
+      packet.free();
+      if (++count >= 20) {
+        break;
+      }
+    }
+
+    const stats = allocator.getStats();
+    assert.ok(stats.copies >= count, 'Audio packets should be copied into slabs');
+    assert.ok(stats.slabBytes > 0);
+  });
+
+  it('should allocate encoded packets from slab memory', async () => {
+    using allocator = new PacketAllocator();
+    allocator.alloc();
+
+    using encoder = await Encoder.create(FF_ENCODER_AAC, {
+      timeBase: { num: 1, den: 44100 },
+      bitrate: '128k',
+      packetAllocator: allocator,
+    });
+
+    const packets: Packet[] = [];
+    for (let i = 0; i < 8; i++) {
+      const frame = new Frame();
+      frame.alloc();
+      frame.nbSamples = 1024;
+      frame.sampleRate = 44100;
+      frame.format = AV_SAMPLE_FMT_FLTP;
+      frame.channelLayout = { nbChannels: 2, order: 1, mask: 3n };
+      frame.pts = BigInt(i * 1024);
+      assert.equal(frame.getBuffer(), 0);
+
+      const packet = await encoder.encode(frame);
+      if (packet) {
+        packets.push(packet);
+      }
+      frame.free();
+    }
+
+    assert.ok(packets.length > 0);
+    assert.equal(allocator.getStats().inUse, packets.length);
+
+    for (const packet of packets) {
+      packet.free();
+    }
+    // The encoder keeps a reference to its last packet
+    assert.ok(allocator.getStats().inUse <= 1);
+  });
+});
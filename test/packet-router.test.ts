@@ -0,0 +1,154 @@
+import assert from 'node:assert';
+import { readFileSync } from 'node:fs';
+import { describe, it } from 'node:test';
+
+import { MediaInput } from '../src/api/media-input.js';
+import { MediaOutput } from '../src/api/media-output.js';
+import { AVERROR_EAGAIN, AVERROR_EINVAL, AVERROR_EOF, Packet, PacketRouter } from '../src/index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+async function countPackets(file: string): Promise<Map<number, number>> {
+  await using media = await MediaInput.open(file);
+  const counts = new Map<number, number>();
+  for await (const packet of media.packets()) {
+    counts.set(packet.streamIndex, (counts.get(packet.streamIndex) ?? 0) + 1);
+    packet.free();
+  }
+  return counts;
+}
+
+async function drain(router: PacketRouter, route: number): Promise<bigint[]> {
+  const packet = new Packet();
+  packet.alloc();
+  const dts: bigint[] = [];
+  let ret;
+  while ((ret = await router.receivePacket(route, packet)) === 0) {
+    dts.push(packet.dts);
+    packet.unref();
+  }
+  assert.equal(ret, AVERROR_EOF);
+  packet.free();
+  return dts;
+}
+
+describe('PacketRouter', () => {
+  it('should reject routes before input is set', () => {
+    using router = new PacketRouter();
+    assert.equal(router.addRoute(0), AVERROR_EINVAL);
+    assert.equal(router.start(), AVERROR_EINVAL);
+  });
+
+  it('should route every stream once with a single reader', async () => {
+    const expected = await countPackets(inputFile);
+
+    await using media = await MediaInput.open(inputFile);
+    const video = media.video();
+    const audio = media.audio();
+    assert.ok(video && audio);
+
+    using router = new PacketRouter();
+    router.setInput(media.getFormatContext(), 8);
+    const videoRoute = router.addRoute(video.index);
+    const audioRoute = router.addRoute(audio.index);
+    // Second route on the same stream gets its own reference of every packet
+    const audioCopy = router.addRoute(audio.index);
+    assert.deepEqual([videoRoute, audioRoute, audioCopy], [0, 1, 2]);
+    assert.equal(router.addRoute(99), AVERROR_EINVAL);
+
+    assert.equal(router.start(), 0);
+    assert.equal(router.addRoute(video.index), AVERROR_EINVAL, 'Routes are fixed once started');
+
+    const [videoDts, audioDts, copyDts] = await Promise.all([drain(router, videoRoute), drain(router, audioRoute), drain(router, audioCopy)]);
+    assert.equal(await router.wait(), 0);
+
+    assert.equal(videoDts.length, expected.get(video.index));
+    assert.equal(audioDts.length, expected.get(audio.index));
+    assert.deepEqual(copyDts, audioDts);
+
+    const stats = router.getStats();
+    assert.equal(stats.routes.length, 3);
+    assert.equal(stats.routes[0].packetsRouted, videoDts.length);
+    assert.equal(stats.routes[2].passthrough, false);
+    assert.equal(router.isRunning, false);
+  });
+
+  it('should stop reading once every route is closed', async () => {
+    await using media = await MediaInput.open(inputFile);
+    const video = media.video();
+    assert.ok(video);
+
+    using router = new PacketRouter();
+    router.setInput(media.getFormatContext(), 2);
+    const route = router.addRoute(video.index);
+    router.start();
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(await router.receivePacket(route, packet), 0);
+    packet.free();
+
+    assert.equal(router.closeRoute(route), 0);
+    assert.equal(await router.wait(), 0);
+    assert.equal(router.isRunning, false);
+  });
+
+  it('should stop without waiting for a read through a JS callback', async () => {
+    // Buffer input: every read of the reader thread is a call into the event loop
+    await using media = await MediaInput.open(readFileSync(inputFile));
+    const video = media.video();
+    assert.ok(video);
+
+    using router = new PacketRouter();
+    router.setInput(media.getFormatContext(), 1);
+    const route = router.addRoute(video.index);
+    assert.equal(router.start(), 0);
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(await router.receivePacket(route, packet), 0);
+    packet.free();
+
+    // Returns right away, the reader finishes its read once the event loop runs it
+    router.stop();
+    assert.equal(await router.wait(), 0);
+    assert.equal(router.isRunning, false);
+  });
+
+  it('should hold copied packets until the output header is written', async () => {
+    const outputFile = getOutputFile('packet-router-passthrough.mkv');
+    const expected = await countPackets(inputFile);
+
+    await using media = await MediaInput.open(inputFile);
+    await using output = await MediaOutput.open(outputFile);
+    const streams = media.streams;
+
+    using router = new PacketRouter();
+    router.setInput(media.getFormatContext());
+    for (const stream of streams) {
+      const outputIndex = output.addStream(stream);
+      assert.ok(router.addPassthrough(stream.index, output.getFormatContext(), outputIndex) >= 0);
+    }
+    assert.equal(router.start(), 0);
+
+    // Nothing written without a header, every packet is held without blocking the reader
+    assert.equal(await router.wait(), 0);
+    const held = router.getStats().routes.reduce((sum, route) => sum + route.pending, 0);
+    assert.equal(held, [...expected.values()].reduce((sum, count) => sum + count, 0));
+    assert.ok(router.getStats().routes.every((route) => route.packetsWritten === 0));
+    assert.equal(router.flush(), AVERROR_EAGAIN);
+
+    assert.equal(await output.ensureHeader(), true);
+    assert.equal(router.flush(), 0);
+    assert.ok(router.getStats().routes.every((route) => route.pending === 0 && route.packetsWritten === route.packetsRouted));
+    await output.close();
+
+    const written = await countPackets(outputFile);
+    for (const stream of streams) {
+      assert.equal(written.get(stream.index), expected.get(stream.index));
+    }
+  });
+});
@@ -0,0 +1,175 @@
+import assert from 'node:assert';
+import { writeFileSync } from 'node:fs';
+import { describe, it } from 'node:test';
+
+import { Decoder, MediaInput } from '../src/api/index.js';
+import { AVERROR_INVALIDDATA, AVSEEK_FLAG_BACKWARD, FormatContext, Packet, PacketRecorder } from '../src/index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+const traceFile = getOutputFile('packet-trace.trace');
+
+interface PacketInfo {
+  streamIndex: number;
+  pts: bigint;
+  dts: bigint;
+  flags: number;
+  data: Buffer | null;
+}
+
+async function record(limit: number): Promise<PacketInfo[]> {
+  using recorder = new PacketRecorder();
+  assert.equal(recorder.open(traceFile), 0);
+  assert.ok(recorder.isOpen);
+
+  const packets: PacketInfo[] = [];
+  await using input = await MediaInput.open(inputFile, { packetRecorder: recorder });
+  for await (const packet of input.packets()) {
+    packets.push({ streamIndex: packet.streamIndex, pts: packet.pts, dts: packet.dts, flags: packet.flags, data: packet.data });
+    packet.free();
+    if (packets.length >= limit) {
+      break;
+    }
+  }
+
+  const stats = recorder.getStats();
+  assert.equal(stats.packets, packets.length);
+  assert.equal(stats.streams, input.streams.length);
+  assert.equal(recorder.close(), 0);
+  assert.ok(!recorder.isOpen);
+  return packets;
+}
+
+describe('PacketRecorder', () => {
+  it('should replay recorded packets bit-exact', async () => {
+    const recorded = await record(100);
+
+    await using original = await MediaInput.open(inputFile);
+    await using replay = await MediaInput.openTrace(traceFile);
+    assert.equal(replay.streams.length, original.streams.length);
+    for (let i = 0; i < replay.streams.length; i++) {
+      const a = original.streams[i].codecpar;
+      const b = replay.streams[i].codecpar;
+      assert.equal(b.codecType, a.codecType);
+      assert.equal(b.codecId, a.codecId);
+      assert.equal(b.width, a.width);
+      assert.equal(b.height, a.height);
+      assert.equal(b.sampleRate, a.sampleRate);
+      assert.deepEqual(b.extradata, a.extradata);
+      assert.deepEqual(replay.streams[i].timeBase, original.streams[i].timeBase);
+    }
+
+    let index = 0;
+    for await (const packet of replay.packets()) {
+      const expected = recorded[index++];
+      assert.equal(packet.streamIndex, expected.streamIndex);
+      assert.equal(packet.pts, expected.pts);
+      assert.equal(packet.dts, expected.dts);
+      assert.equal(packet.flags, expected.flags);
+      assert.deepEqual(packet.data, expected.data);
+      packet.free();
+    }
+    assert.equal(index, recorded.length);
+  });
+
+  it('should decode a replayed trace', async () => {
+    await record(60);
+
+    await using input = await MediaInput.openTrace(traceFile);
+    const video = input.video();
+    assert.ok(video);
+
+    using decoder = await Decoder.create(video);
+    let frames = 0;
+    for await (const frame of decoder.frames(input.packets(video.index))) {
+      if (frame) {
+        assert.ok(frame.width > 0);
+        frames++;
+        frame.free();
+      }
+    }
+    assert.ok(frames > 0, 'Should decode frames from the trace');
+  });
+
+  it('should seek to recorded keyframes', async () => {
+    await record(200);
+
+    const ctx = new FormatContext();
+    assert.equal(ctx.openTraceSync(traceFile), 0);
+    assert.equal(ctx.findStreamInfoSync(null), 0);
+
+    const packet = new Packet();
+    packet.alloc();
+
+    // Last packet of the video stream
+    let lastVideo = -1n;
+    let videoIndex = -1;
+    for (const stream of ctx.streams ?? []) {
+      if (stream.codecpar.width > 0) {
+        videoIndex = stream.index;
+      }
+    }
+    while (ctx.readFrameSync(packet) >= 0) {
+      if (packet.streamIndex === videoIndex) {
+        lastVideo = packet.pts;
+      }
+      packet.unref();
+    }
+    assert.ok(lastVideo > 0n);
+
+    assert.equal(ctx.seekFrameSync(videoIndex, lastVideo, AVSEEK_FLAG_BACKWARD), 0);
+    assert.equal(ctx.readFrameSync(packet), 0);
+    assert.equal(packet.streamIndex, videoIndex);
+    assert.ok(packet.isKeyframe);
+    assert.ok(packet.pts <= lastVideo);
+    packet.unref();
+
+    assert.equal(ctx.seekFrameSync(videoIndex, 0n, AVSEEK_FLAG_BACKWARD), 0);
+    assert.equal(ctx.readFrameSync(packet), 0);
+    packet.free();
+
+    ctx.closeInputSync();
+  });
+
+  it('should pace replay by arrival times', async () => {
+    // Arrival times are only meaningful for a paced capture, so pace the capture too
+    using recorder = new PacketRecorder();
+    recorder.open(traceFile);
+    {
+      await using input = await MediaInput.open(inputFile, { packetRecorder: recorder });
+      let count = 0;
+      for await (const packet of input.packets()) {
+        packet.free();
+        await new Promise((resolve) => setTimeout(resolve, 5));
+        if (++count >= 10) {
+          break;
+        }
+      }
+    }
+    const captured = recorder.getStats().duration;
+    recorder.close();
+    assert.ok(captured >= 0.04);
+
+    const start = performance.now();
+    using input = MediaInput.openTraceSync(traceFile, { realtime: true, speed: 2 });
+    let count = 0;
+    for (const packet of input.packetsSync()) {
+      count++;
+      packet.free();
+    }
+    assert.equal(count, 10);
+    const elapsed = (performance.now() - start) / 1000;
+    assert.ok(elapsed >= captured / 2 - 0.01, `Replay took ${elapsed}s for a ${captured}s capture at 2x`);
+  });
+
+  it('should reject files that are not traces', async () => {
+    const bogus = getOutputFile('packet-trace-bogus.trace');
+    writeFileSync(bogus, Buffer.alloc(64, 1));
+
+    const ctx = new FormatContext();
+    assert.equal(await ctx.openTrace(bogus), AVERROR_INVALIDDATA);
+    await assert.rejects(MediaInput.openTrace(bogus));
+  });
+});
@@ -0,0 +1,253 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder } from '../src/api/decoder.js';
+import { MediaInput } from '../src/api/media-input.js';
+import {
+  AV_CODEC_ID_H264,
+  AV_CODEC_ID_MJPEG,
+  AV_PIX_FMT_YUVJ420P,
+  AVERROR_EAGAIN,
+  AVERROR_EOF,
+  Codec,
+  CodecContext,
+  CodecParameters,
+  Frame,
+  Packet,
+  ParallelDecoder,
+} from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+import type { Stream } from '../src/index.js';
+
+prepareTestEnvironment();
+
+const WIDTH = 64;
+const HEIGHT = 48;
+
+/**
+ * Encode a short MJPEG sequence with increasing pts.
+ */
+async function encodeMjpeg(count: number): Promise<{ codecpar: CodecParameters; packets: Packet[] }> {
+  const codec = Codec.findEncoder(AV_CODEC_ID_MJPEG);
+  assert.ok(codec, 'MJPEG encoder should be available');
+
+  const ctx = new CodecContext();
+  ctx.allocContext3(codec);
+  ctx.width = WIDTH;
+  ctx.height = HEIGHT;
+  ctx.pixelFormat = AV_PIX_FMT_YUVJ420P;
+  ctx.timeBase = { num: 1, den: 25 };
+  assert.equal(await ctx.open2(codec, null), 0);
+
+  const codecpar = new CodecParameters();
+  codecpar.alloc();
+  assert.equal(codecpar.fromContext(ctx), 0);
+
+  const frame = new Frame();
+  frame.alloc();
+  frame.width = WIDTH;
+  frame.height = HEIGHT;
+  frame.format = AV_PIX_FMT_YUVJ420P;
+  assert.equal(frame.getBuffer(), 0);
+
+  const packets: Packet[] = [];
+  const packet = new Packet();
+  packet.alloc();
+
+  for (let i = 0; i <= count; i++) {
+    if (i < count) {
+      frame.makeWritable();
+      frame.pts = BigInt(i);
+    }
+    await ctx.sendFrame(i < count ? frame : null);
+    while ((await ctx.receivePacket(packet)) === 0) {
+      const clone = packet.clone();
+      assert.ok(clone);
+      packets.push(clone);
+      packet.unref();
+    }
+  }
+
+  frame.free();
+  packet.free();
+  ctx.freeContext();
+
+  return { codecpar, packets };
+}
+
+describe('ParallelDecoder', () => {
+  it('should report intra-only codecs as supported', () => {
+    assert.equal(ParallelDecoder.isSupported(AV_CODEC_ID_MJPEG), true);
+    assert.equal(ParallelDecoder.isSupported(AV_CODEC_ID_H264), false);
+  });
+
+  it('should reject inter-frame codecs', async () => {
+    const codecpar = new CodecParameters();
+    codecpar.alloc();
+    codecpar.codecId = AV_CODEC_ID_H264;
+
+    const decoder = new ParallelDecoder();
+    const ret = await decoder.open(codecpar, 4);
+    assert.ok(ret < 0, 'Should fail for H.264');
+    assert.equal(decoder.isOpen, false);
+    decoder.close();
+  });
+
+  it('should decode frames in submission order (async)', async () => {
+    const { codecpar, packets } = await encodeMjpeg(24);
+
+    const decoder = new ParallelDecoder();
+    assert.equal(await decoder.open(codecpar, 4, null, { num: 1, den: 25 }), 0);
+    assert.equal(decoder.workers, 4);
+
+    const frame = new Frame();
+    frame.alloc();
+    const pts: bigint[] = [];
+
+    for (const packet of packets) {
+      let ret = await decoder.sendPacket(packet);
+      while (ret === AVERROR_EAGAIN) {
+        assert.equal(await decoder.receiveFrame(frame, true), 0);
+        pts.push(frame.pts);
+        ret = await decoder.sendPacket(packet);
+      }
+      assert.equal(ret, 0);
+    }
+
+    assert.equal(await decoder.sendPacket(null), 0);
+
+    let ret;
+    while ((ret = await decoder.receiveFrame(frame)) === 0) {
+      assert.equal(frame.width, WIDTH);
+      assert.equal(frame.height, HEIGHT);
+      pts.push(frame.pts);
+    }
+    assert.equal(ret, AVERROR_EOF);
+
+    assert.equal(pts.length, packets.length);
+    pts.forEach((value, i) => assert.equal(value, BigInt(i)));
+    assert.equal(decoder.pending, 0);
+
+    frame.free();
+    packets.forEach((p) => p.free());
+    decoder.close();
+    assert.equal(decoder.isOpen, false);
+  });
+
+  it('should decode frames in submission order (sync)', async () => {
+    const { codecpar, packets } = await encodeMjpeg(12);
+
+    using decoder = new ParallelDecoder();
+    assert.equal(decoder.openSync(codecpar, 3), 0);
+
+    const frame = new Frame();
+    frame.alloc();
+    const pts: bigint[] = [];
+
+    for (const packet of packets) {
+      while (decoder.sendPacketSync(packet) === AVERROR_EAGAIN) {
+        assert.equal(decoder.receiveFrameSync(frame, true), 0);
+        pts.push(frame.pts);
+      }
+    }
+
+    decoder.sendPacketSync(null);
+    while (decoder.receiveFrameSync(frame) === 0) {
+      pts.push(frame.pts);
+    }
+
+    assert.deepEqual(
+      pts,
+      packets.map((_, i) => BigInt(i)),
+    );
+
+    frame.free();
+    packets.forEach((p) => p.free());
+  });
+
+  it('should decode through Decoder with parallel option', async () => {
+    const media = await MediaInput.open(getInputFile('image-rgba.png'));
+    const stream = media.video();
+    assert.ok(stream);
+
+    const decoder = await Decoder.create(stream, { parallel: 4 });
+    let count = 0;
+    for await (const frame of decoder.frames(media.packets())) {
+      assert.ok(frame.width > 0);
+      count++;
+      frame.free();
+    }
+    assert.equal(count, 1);
+
+    decoder.close();
+    await media.close();
+  });
+
+  it('should keep every packet when the Decoder pool is saturated (sync)', async () => {
+    const { codecpar, packets } = await encodeMjpeg(24);
+    const stream = { index: 0, codecpar, timeBase: { num: 1, den: 25 } } as unknown as Stream;
+
+    const decoder = Decoder.createSync(stream, { parallel: 2 });
+    const pts: bigint[] = [];
+    for (const packet of packets) {
+      // Sent without draining the pool first
+      const frame = decoder.decodeSync(packet);
+      if (frame) {
+        pts.push(frame.pts);
+        frame.free();
+      }
+    }
+    decoder.flushSync();
+    let frame;
+    while ((frame = decoder.receiveSync()) !== null) {
+      pts.push(frame.pts);
+      frame.free();
+    }
+
+    assert.deepEqual(
+      pts,
+      packets.map((_, i) => BigInt(i)),
+    );
+
+    decoder.close();
+    packets.forEach((p) => p.free());
+  });
+
+  it('should keep packets when a decode error is suppressed in a saturated pool (async)', async () => {
+    const { codecpar, packets } = await encodeMjpeg(24);
+    const stream = { index: 0, codecpar, timeBase: { num: 1, den: 25 } } as unknown as Stream;
+
+    // Every fourth packet is not a JPEG image
+    const corrupt = (i: number) => i % 4 === 1;
+    packets.forEach((packet, i) => {
+      if (corrupt(i)) {
+        packet.data = Buffer.alloc(256, 0x11);
+      }
+    });
+
+    const decoder = await Decoder.create(stream, { parallel: 2, exitOnError: false });
+    const pts: bigint[] = [];
+    for (const packet of packets) {
+      const frame = await decoder.decode(packet);
+      if (frame) {
+        pts.push(frame.pts);
+        frame.free();
+      }
+    }
+    await decoder.flush();
+    let frame;
+    while ((frame = await decoder.receive()) !== null) {
+      pts.push(frame.pts);
+      frame.free();
+    }
+
+    assert.deepEqual(
+      pts,
+      packets.flatMap((_, i) => (corrupt(i) ? [] : [BigInt(i)])),
+    );
+
+    decoder.close();
+    packets.forEach((p) => p.free());
+  });
+});
@@ -21,6 +21,8 @@ import {
 } from '../src/index.js';
 import { getInputFile, getOutputFile, getTmpDir, prepareTestEnvironment, skipInCI } from './index.js';
 
+import type { PipelineOptions, PipelineQueueStats, PipelineStats } from '../src/index.js';
+
 prepareTestEnvironment();
 
 const inputFile = getInputFile('demux.mp4');
@@ -397,6 +399,346 @@ describe('Pipeline - Comprehensive Tests', () => {
     });
   });
 
+  describe('Named Pipeline - Stream Routing', () => {
+    it('should reject names that resolve to no stream', async () => {
+      const outputFile = getTestOutputPath('named-routing-unknown.mkv');
+
+      try {
+        await using input = await MediaInput.open(inputFile);
+        await using output = await MediaOutput.open(outputFile);
+
+        // Not a type, index or specifier, and no decoder to take the stream from
+        const control = pipeline({ dub: input }, { dub: 'passthrough' }, output);
+        await assert.rejects(control.completion, /No stream found in input for 'dub'/);
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should transcode one stream and copy the others natively', async () => {
+      const outputFile = getTestOutputPath('named-routing-mixed.mkv');
+
+      try {
+        await using input = await MediaInput.open(inputFile);
+        const output = await MediaOutput.open(outputFile);
+
+        const videoStream = input.video();
+        const audioStream = input.audio();
+        if (!videoStream || !audioStream) {
+          assert.fail('Missing video or audio stream');
+        }
+
+        using videoDecoder = await Decoder.create(videoStream);
+        using videoEncoder = await Encoder.create(FF_ENCODER_LIBX264, {
+          timeBase: { num: 1, den: 30 },
+          frameRate: { num: 30, den: 1 },
+          bitrate: '500k',
+        });
+
+        const control = pipeline(
+          { video: input, a0: { input, stream: 'a' }, a1: { input, stream: audioStream.index }, a2: { input, stream: String(audioStream.index) } },
+          { video: [videoDecoder, videoEncoder], a0: 'passthrough', a1: 'passthrough', a2: 'passthrough' },
+          output,
+        );
+        await control.completion;
+
+        let inputAudioPackets = 0;
+        await using countInput = await MediaInput.open(inputFile);
+        for await (const packet of countInput.packets(audioStream.index)) {
+          inputAudioPackets++;
+          packet.free();
+        }
+
+        await using verifyInput = await MediaInput.open(outputFile);
+        assert.equal(verifyInput.streams.length, 4, 'Output should have one video and three audio streams');
+        assert.equal(verifyInput.video()?.codecpar.codecId, AV_CODEC_ID_H264);
+
+        const counts = new Map<number, number>();
+        for await (const packet of verifyInput.packets()) {
+          counts.set(packet.streamIndex, (counts.get(packet.streamIndex) ?? 0) + 1);
+          packet.free();
+        }
+        assert.ok((counts.get(0) ?? 0) > 0, 'Video should be encoded');
+        for (const index of [1, 2, 3]) {
+          assert.equal(verifyInput.streams[index].codecpar.codecId, audioStream.codecpar.codecId, 'Audio should be copied');
+          assert.equal(counts.get(index), inputAudioPackets, 'Every audio packet should be copied once per track');
+        }
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+  });
+
+  describe('Concurrent Stages', () => {
+    async function transcode(outputFile: string, queueDepth: number): Promise<{ packets: number; queues: PipelineQueueStats[] }> {
+      await using input = await MediaInput.open(inputFile);
+      await using output = await MediaOutput.open(outputFile);
+
+      const videoStream = input.video();
+      if (!videoStream) {
+        assert.fail('No video stream found');
+      }
+
+      using decoder = await Decoder.create(videoStream);
+      using filter = FilterAPI.create('scale=160:120', {
+        frameRate: videoStream.avgFrameRate,
+        timeBase: videoStream.timeBase,
+      });
+      using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+        frameRate: videoStream.avgFrameRate,
+        timeBase: videoStream.timeBase,
+        bitrate: '500k',
+      });
+
+      const control = pipeline(input, decoder, filter, encoder, output, { queueDepth });
+      await control.completion;
+
+      await using verifyInput = await MediaInput.open(outputFile);
+      let packets = 0;
+      for await (const packet of verifyInput.packets()) {
+        packets++;
+        packet.free();
+      }
+
+      return { packets, queues: control.getQueueStats() };
+    }
+
+    it('should buffer every stage and produce the same output as sequential stages', async () => {
+      const sequentialFile = getTestOutputPath('concurrent-sequential.mp4');
+      const concurrentFile = getTestOutputPath('concurrent-buffered.mp4');
+
+      try {
+        const sequential = await transcode(sequentialFile, 0);
+        const concurrent = await transcode(concurrentFile, 2);
+
+        assert.deepEqual(sequential.queues, [], 'queueDepth 0 should not create queues');
+        assert.ok(concurrent.packets > 0, 'Should encode packets');
+        assert.equal(concurrent.packets, sequential.packets, 'Buffering should not drop or duplicate packets');
+
+        assert.deepEqual(
+          concurrent.queues.map((queue) => queue.stage),
+          ['read', 'decode', 'filter', 'encode'],
+        );
+        for (const queue of concurrent.queues) {
+          assert.equal(queue.capacity, 2);
+          assert.equal(queue.depth, 0, 'Queues should be drained at completion');
+          assert.ok(queue.maxDepth >= 1 && queue.maxDepth <= 2, `${queue.stage} queue should stay within capacity`);
+        }
+      } finally {
+        cleanupTestFile(sequentialFile);
+        cleanupTestFile(concurrentFile);
+      }
+    });
+
+    it('should report queues per named stream', async () => {
+      const outputFile = getTestOutputPath('concurrent-named.mkv');
+
+      try {
+        await using input = await MediaInput.open(inputFile);
+        await using output = await MediaOutput.open(outputFile);
+
+        const videoStream = input.video();
+        if (!videoStream) {
+          assert.fail('No video stream found');
+        }
+
+        using decoder = await Decoder.create(videoStream);
+        using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+          timeBase: { num: 1, den: 30 },
+          frameRate: { num: 30, den: 1 },
+          bitrate: '500k',
+        });
+
+        const control = pipeline({ video: input, audio: input }, { video: [decoder, encoder], audio: 'passthrough' }, output, { queueDepth: 3 });
+        await control.completion;
+
+        const queues = control.getQueueStats();
+        assert.deepEqual(
+          queues.map((queue) => [queue.stream, queue.stage, queue.capacity]),
+          [
+            ['video', 'decode', 3],
+            ['video', 'encode', 3],
+          ],
+          'Copied streams are routed natively and have no queues',
+        );
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should deliver source errors after the queued items', async () => {
+      const outputFile = getTestOutputPath('concurrent-error.mp4');
+
+      try {
+        await using output = await MediaOutput.open(outputFile);
+
+        let produced = 0;
+        async function* generateFrames() {
+          for (let i = 0; i < 5; i++) {
+            const frame = new Frame();
+            frame.alloc();
+            frame.width = 320;
+            frame.height = 240;
+            frame.format = AV_PIX_FMT_YUV420P;
+            frame.pts = BigInt(i);
+            frame.getBuffer(0);
+            produced++;
+            yield frame;
+          }
+          throw new Error('Source failed');
+        }
+
+        using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+          timeBase: { num: 1, den: 30 },
+          frameRate: { num: 30, den: 1 },
+          bitrate: '500k',
+          maxBFrames: 0,
+        });
+
+        const control = pipeline(generateFrames(), encoder, output, { queueDepth: 2 });
+        await assert.rejects(control.completion, /Source failed/);
+        assert.equal(produced, 5, 'Every frame should be pulled before the error');
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should stop upstream stages when a partial pipeline is returned early', async () => {
+      await using input = await MediaInput.open(inputFile);
+      const videoStream = input.video();
+      if (!videoStream) {
+        assert.fail('No video stream found');
+      }
+
+      using decoder = await Decoder.create(videoStream);
+      const frames = pipeline(input, decoder, { queueDepth: 2 });
+
+      let received = 0;
+      for await (const frame of frames) {
+        received++;
+        frame.free();
+        break;
+      }
+
+      assert.equal(received, 1);
+      assert.deepEqual(await frames.next(), { done: true, value: undefined }, 'Generator should be finished');
+    });
+  });
+
+  describe('Pipeline Statistics', () => {
+    async function transcode(outputFile: string, filterDescription: string, options: PipelineOptions = {}): Promise<PipelineStats> {
+      await using input = await MediaInput.open(inputFile);
+      await using output = await MediaOutput.open(outputFile);
+
+      const videoStream = input.video();
+      if (!videoStream) {
+        assert.fail('No video stream found');
+      }
+
+      using decoder = await Decoder.create(videoStream);
+      using filter = FilterAPI.create(filterDescription, {
+        frameRate: videoStream.avgFrameRate,
+        timeBase: videoStream.timeBase,
+      });
+      using encoder = await Encoder.create(FF_ENCODER_LIBX264, {
+        frameRate: videoStream.avgFrameRate,
+        timeBase: videoStream.timeBase,
+        bitrate: '500k',
+      });
+
+      const control = pipeline(input, decoder, filter, encoder, output, options);
+      await control.completion;
+      return control.stats();
+    }
+
+    it('should count items, bytes and time for every stage', async () => {
+      const outputFile = getTestOutputPath('stats-transcode.mp4');
+
+      try {
+        const stats = await transcode(outputFile, 'scale=160:120');
+        const [read, decode, filter, encode, write] = stats.stages;
+
+        assert.deepEqual(
+          stats.stages.map((stage) => stage.stage),
+          ['read', 'decode', 'filter', 'encode', 'write'],
+        );
+        assert.equal(read.packetsOut, decode.packetsIn, 'Decoder should receive every read packet');
+        assert.equal(decode.framesOut, filter.framesIn);
+        assert.equal(filter.framesOut, encode.framesIn);
+        assert.equal(encode.packetsOut, write.packetsIn, 'Muxer should receive every encoded packet');
+        assert.equal(read.bytesOut, decode.bytesIn);
+        assert.equal(encode.bytesOut, write.bytesIn);
+        assert.ok(write.bytesIn > 0, 'Should write payload bytes');
+
+        for (const stage of stats.stages) {
+          assert.ok(stage.busyTime > 0, `${stage.stage} should report busy time`);
+        }
+        assert.deepEqual(
+          stats.stages.map((stage) => stage.queue !== undefined),
+          [true, true, true, true, false],
+          'Every stage but the muxer should report its queue',
+        );
+        assert.equal(filter.dropped, 0, 'Scaling should not drop frames');
+        assert.equal(filter.duplicated, 0, 'Scaling should not duplicate frames');
+
+        assert.ok(stats.elapsedTime > 0);
+        assert.ok(stats.speed > 0, 'Should report media speed');
+        assert.ok(stats.bottleneck, 'Should name a bottleneck');
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should attribute frames dropped by a rate filter', async () => {
+      const outputFile = getTestOutputPath('stats-fps.mp4');
+
+      try {
+        const stats = await transcode(outputFile, 'fps=5');
+        const filter = stats.stages.find((stage) => stage.stage === 'filter');
+        assert.ok(filter);
+
+        assert.ok(filter.framesOut < filter.framesIn, 'fps=5 should drop frames');
+        assert.equal(filter.dropped, filter.framesIn - filter.framesOut);
+        assert.equal(filter.duplicated, 0);
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should push periodic reports and a final report', async () => {
+      const outputFile = getTestOutputPath('stats-push.mp4');
+      const reports: PipelineStats[] = [];
+
+      try {
+        const stats = await transcode(outputFile, 'scale=160:120', {
+          statsInterval: 10,
+          onStats: (report) => reports.push(report),
+        });
+
+        assert.ok(reports.length >= 1, 'onStats should be called');
+        const last = reports[reports.length - 1];
+        const write = last.stages.find((stage) => stage.stage === 'write');
+        assert.ok(write && write.packetsIn > 0, 'Final report should include written packets');
+        assert.equal(write.packetsIn, stats.stages[stats.stages.length - 1].packetsIn);
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+
+    it('should report stats without stage queues', async () => {
+      const outputFile = getTestOutputPath('stats-sequential.mp4');
+
+      try {
+        const stats = await transcode(outputFile, 'scale=160:120', { queueDepth: 0 });
+        assert.equal(stats.stages.length, 5);
+        assert.ok(stats.stages.every((stage) => stage.queue === undefined));
+        assert.ok(stats.stages[4].packetsIn > 0);
+      } finally {
+        cleanupTestFile(outputFile);
+      }
+    });
+  });
+
   describe('Partial Pipelines', () => {
     it('should return generator for decoder only', async () => {
       await using input = await MediaInput.open(inputFile);
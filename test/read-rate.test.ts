@@ -0,0 +1,102 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { MediaInput } from '../src/api/index.js';
+import { AVERROR_EINVAL, FormatContext } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+import type { Stream } from '../src/index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+function seconds(stream: Stream, ts: bigint): number {
+  return (Number(ts) * stream.timeBase.num) / stream.timeBase.den;
+}
+
+// Reads until `media` seconds past the first packet, returns elapsed wall-clock seconds
+async function readMedia(input: MediaInput, media: number): Promise<number> {
+  const start = performance.now();
+  let first: number | undefined;
+  for await (const packet of input.packets()) {
+    const stream = input.streams[packet.streamIndex];
+    const ts = seconds(stream, packet.dts);
+    packet.free();
+    first ??= ts;
+    if (ts - first >= media) {
+      break;
+    }
+  }
+  return (performance.now() - start) / 1000;
+}
+
+describe('Read rate', () => {
+  it('should release packets at the configured rate', async () => {
+    await using input = await MediaInput.open(inputFile, { readRate: { rate: 10 } });
+
+    // 1.5 seconds of media at 10x
+    const elapsed = await readMedia(input, 1.5);
+    assert.ok(elapsed >= 0.14, `Read 1.5s of media in ${elapsed}s at 10x`);
+    assert.ok(elapsed < 1, `Read 1.5s of media in ${elapsed}s at 10x`);
+
+    const stats = input.getReadRateStats();
+    assert.ok(stats);
+    assert.ok(stats.packets > 0);
+    assert.ok(stats.waits > 0);
+    assert.ok(stats.waitTime > 50);
+  });
+
+  it('should release the initial burst immediately', async () => {
+    await using input = await MediaInput.open(inputFile, { readRate: { rate: 1, initialBurst: 1 } });
+
+    const elapsed = await readMedia(input, 0.9);
+    assert.ok(elapsed < 0.5, `Initial burst took ${elapsed}s`);
+    assert.equal(input.getReadRateStats()?.latePackets, 0);
+  });
+
+  it('should re-anchor the schedule after seeking', async () => {
+    await using input = await MediaInput.open(inputFile, { readRate: { rate: 10 } });
+    await readMedia(input, 0.2);
+
+    // Seeking forward must not release everything up to the new position at once, nor stall
+    assert.ok((await input.seek(1)) >= 0);
+    const elapsed = await readMedia(input, 0.5);
+    assert.ok(elapsed >= 0.04 && elapsed < 0.5, `Read 0.5s after seeking in ${elapsed}s`);
+  });
+
+  it('should report lateness of a slow reader', async () => {
+    await using input = await MediaInput.open(inputFile, { readRate: { rate: 10, catchup: 'reset', maxLag: 0.05 } });
+
+    let count = 0;
+    for await (const packet of input.packets()) {
+      packet.free();
+      if (++count === 5) {
+        // Fall 200 ms behind schedule
+        await new Promise((resolve) => setTimeout(resolve, 200));
+      }
+      if (count >= 20) {
+        break;
+      }
+    }
+
+    const stats = input.getReadRateStats();
+    assert.ok(stats);
+    assert.ok(stats.latePackets >= 1);
+    assert.ok(stats.maxLateness >= 100);
+    assert.ok(stats.resets >= 1);
+  });
+
+  it('should validate options', () => {
+    const ctx = new FormatContext();
+    assert.equal(ctx.setReadRate({ rate: 0 }), AVERROR_EINVAL);
+    assert.equal(ctx.setReadRate({ initialBurst: -1 }), AVERROR_EINVAL);
+    assert.equal(ctx.setReadRate({ catchup: 'skip' as 'burst' }), AVERROR_EINVAL);
+    assert.equal(ctx.getReadRateStats(), null);
+
+    assert.equal(ctx.setReadRate(), 0);
+    assert.equal(ctx.getReadRateStats()?.packets, 0);
+    assert.equal(ctx.setReadRate(null), 0);
+    assert.equal(ctx.getReadRateStats(), null);
+  });
+});
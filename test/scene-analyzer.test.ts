@@ -0,0 +1,149 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder, MediaInput } from '../src/api/index.js';
+import { AV_PICTURE_TYPE_I, AV_PICTURE_TYPE_NONE, AV_PICTURE_TYPE_P, AV_PIX_FMT_YUV420P, AVERROR_EINVAL, Frame, SceneAnalyzer } from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+const WIDTH = 64;
+const HEIGHT = 48;
+
+// Frame with a horizontal luma gradient shifted by `offset`, scaled by `gain`
+function createFrame(pts: number, offset: number, gain = 1): Frame {
+  const frame = new Frame();
+  frame.alloc();
+  frame.format = AV_PIX_FMT_YUV420P;
+  frame.width = WIDTH;
+  frame.height = HEIGHT;
+  frame.pts = BigInt(pts);
+  frame.timeBase = { num: 1, den: 25 };
+
+  const pixels = Buffer.alloc((WIDTH * HEIGHT * 3) / 2, 128);
+  for (let y = 0; y < HEIGHT; y++) {
+    for (let x = 0; x < WIDTH; x++) {
+      pixels[y * WIDTH + x] = Math.round((16 + ((x * 3 + offset) % 200)) * gain);
+    }
+  }
+  assert.equal(frame.fromBuffer(pixels), 0);
+  return frame;
+}
+
+describe('SceneAnalyzer', () => {
+  it('should reject invalid options and unallocated use', () => {
+    using analyzer = new SceneAnalyzer();
+    const frame = createFrame(0, 0);
+    assert.equal(analyzer.analyzeSync(frame), AVERROR_EINVAL);
+    assert.equal(analyzer.alloc({ sceneThreshold: 2 }), AVERROR_EINVAL);
+    assert.equal(analyzer.alloc({ width: 4 }), AVERROR_EINVAL);
+    assert.equal(analyzer.getLastResult(), null);
+    frame.free();
+  });
+
+  it('should place keyframes on scene changes only', () => {
+    using analyzer = new SceneAnalyzer();
+    assert.equal(analyzer.alloc({ width: 32, minKeyInterval: 2, maxKeyInterval: 0 }), 0);
+
+    const keyframes: number[] = [];
+    for (let i = 0; i < 30; i++) {
+      // Cut to different content at frame 10 and 20
+      const frame = createFrame(i, i < 10 ? 0 : i < 20 ? 100 : 37);
+      frame.pictType = AV_PICTURE_TYPE_P;
+      const ret = analyzer.analyzeSync(frame);
+      assert.ok(ret >= 0);
+      if (ret === 1) {
+        keyframes.push(i);
+        assert.equal(frame.pictType, AV_PICTURE_TYPE_I);
+        assert.equal(frame.keyFrame, 1);
+      } else {
+        assert.equal(frame.pictType, AV_PICTURE_TYPE_NONE, 'Source picture types must not force keyframes');
+      }
+      frame.free();
+    }
+
+    assert.deepEqual(keyframes, [0, 10, 20]);
+    const stats = analyzer.getStats();
+    assert.equal(stats.frames, 30);
+    assert.equal(stats.keyframes, 3);
+    assert.equal(stats.sceneCuts, 2);
+  });
+
+  it('should report fades without scene changes', () => {
+    using analyzer = new SceneAnalyzer();
+    assert.equal(analyzer.alloc({ width: 32, maxKeyInterval: 0 }), 0);
+
+    let fading = 0;
+    for (let i = 0; i < 20; i++) {
+      const frame = createFrame(i, 0, 1 - i * 0.04);
+      analyzer.analyzeSync(frame);
+      const result = analyzer.getLastResult();
+      assert.ok(result);
+      assert.equal(result.pts, BigInt(i));
+      if (result.fade === 'out') {
+        fading++;
+      }
+      frame.free();
+    }
+
+    const stats = analyzer.getStats();
+    assert.equal(stats.keyframes, 1, 'A fade is not a scene change');
+    assert.ok(fading >= 15);
+    assert.equal(stats.fadeFrames, fading);
+  });
+
+  it('should align keyframes to segment boundaries and the maximum interval', () => {
+    using analyzer = new SceneAnalyzer();
+    // 25 fps: boundaries every 2 s (50 frames), at most 30 frames per GOP
+    assert.equal(analyzer.alloc({ width: 32, segmentDuration: 2, maxKeyInterval: 30 }), 0);
+
+    const reasons = new Map<number, string | null>();
+    for (let i = 0; i < 101; i++) {
+      const frame = createFrame(i, 0);
+      if (analyzer.analyzeSync(frame) === 1) {
+        reasons.set(i, analyzer.getLastResult()?.reason ?? null);
+      }
+      frame.free();
+    }
+
+    assert.deepEqual(
+      [...reasons.entries()],
+      [
+        [0, 'start'],
+        [30, 'interval'],
+        [50, 'segment'],
+        [80, 'interval'],
+        [100, 'segment'],
+      ],
+    );
+  });
+
+  it('should mark decoded frames in a pipeline', async () => {
+    await using input = await MediaInput.open(inputFile);
+    const video = input.video();
+    assert.ok(video);
+    using decoder = await Decoder.create(video);
+
+    using analyzer = new SceneAnalyzer();
+    assert.equal(analyzer.alloc({ segmentDuration: 1, timeBase: video.timeBase }), 0);
+
+    let frames = 0;
+    let keyframes = 0;
+    for await (const frame of analyzer.analyzeFrames(decoder.frames(input.packets(video.index)))) {
+      frames++;
+      if (frame.pictType === AV_PICTURE_TYPE_I) {
+        keyframes++;
+      }
+      frame.free();
+    }
+
+    const stats = analyzer.getStats();
+    assert.equal(stats.frames, frames);
+    assert.equal(stats.keyframes, keyframes);
+    assert.ok(stats.segmentKeyframes > 0);
+    assert.equal(SceneAnalyzer.encoderOptions('libx264')['forced-idr'], 1);
+    assert.deepEqual(SceneAnalyzer.encoderOptions('unknown'), {});
+  });
+});
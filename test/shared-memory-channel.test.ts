@@ -0,0 +1,246 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder, MediaInput } from '../src/api/index.js';
+import {
+  AV_PIX_FMT_YUV420P,
+  AVERROR_EBUSY,
+  AVERROR_EEXIST,
+  AVERROR_EINVAL,
+  AVERROR_ENOENT,
+  AVERROR_ENOSPC,
+  AVERROR_EOF,
+  AVERROR_EPIPE,
+  CodecParameters,
+  Frame,
+  Packet,
+  SharedMemoryChannel,
+} from '../src/index.js';
+import { getInputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+const skipOnWindows = { skip: process.platform === 'win32' ? 'Shared memory channels are not available on Windows' : false };
+
+let channels = 0;
+function channelName(): string {
+  return `/nav-test-${process.pid}-${channels++}`;
+}
+
+function connect(size = 1024 * 1024): { writer: SharedMemoryChannel; reader: SharedMemoryChannel } {
+  const name = channelName();
+  const writer = new SharedMemoryChannel();
+  assert.equal(writer.create(name, 'writer', { size }), 0);
+  const reader = new SharedMemoryChannel();
+  assert.equal(reader.open(name, 'reader'), 0);
+  return { writer, reader };
+}
+
+describe('SharedMemoryChannel', skipOnWindows, () => {
+  it('should attach one writer and one reader by name', () => {
+    const name = channelName();
+    using writer = new SharedMemoryChannel();
+    assert.equal(writer.create(name, 'writer', { size: 100_000 }), 0);
+    assert.equal(writer.name, name);
+    assert.equal(writer.role, 'writer');
+    assert.equal(writer.size, 102_400, 'Size should be rounded up to whole pages');
+
+    using duplicate = new SharedMemoryChannel();
+    assert.equal(duplicate.create(name, 'reader'), AVERROR_EEXIST);
+    assert.equal(duplicate.open(name, 'writer'), AVERROR_EBUSY, 'Writer role is taken');
+
+    using reader = new SharedMemoryChannel();
+    assert.equal(reader.open(name, 'reader'), 0);
+    assert.equal(reader.size, writer.size);
+
+    using missing = new SharedMemoryChannel();
+    assert.equal(missing.open(`${name}-missing`, 'reader'), AVERROR_ENOENT);
+  });
+
+  it('should carry codec parameters and packets with backpressure', async () => {
+    await using input = await MediaInput.open(inputFile);
+    const { writer, reader } = connect(256 * 1024);
+
+    const expected: { streamIndex: number; pts: bigint; size: number; first: number }[] = [];
+    const send = async () => {
+      for (const stream of input.streams) {
+        assert.equal(writer.addStream(stream.codecpar, stream.timeBase), stream.index);
+      }
+      for await (const packet of input.packets()) {
+        expected.push({ streamIndex: packet.streamIndex, pts: packet.pts, size: packet.size, first: packet.data?.[0] ?? -1 });
+        assert.equal(await writer.sendPacket(packet), 0);
+        packet.free();
+      }
+      assert.equal(writer.end(), 0);
+    };
+
+    const received: typeof expected = [];
+    const receive = async () => {
+      const params = new CodecParameters();
+      params.alloc();
+      for (const stream of input.streams) {
+        assert.equal(await reader.receiveStream(params), stream.index);
+        assert.equal(params.codecId, stream.codecpar.codecId);
+        assert.equal(params.width, stream.codecpar.width);
+        assert.equal(params.extradataSize, stream.codecpar.extradataSize);
+      }
+      params.free();
+
+      const packet = new Packet();
+      packet.alloc();
+      let ret;
+      while ((ret = await reader.receivePacket(packet)) === 0) {
+        received.push({ streamIndex: packet.streamIndex, pts: packet.pts, size: packet.size, first: packet.data?.[0] ?? -1 });
+        packet.unref();
+      }
+      assert.equal(ret, AVERROR_EOF);
+      packet.free();
+    };
+
+    await Promise.all([send(), receive()]);
+
+    assert.ok(expected.length > 0);
+    assert.deepEqual(received, expected);
+    assert.deepEqual(reader.getStreamTimeBase(0), input.streams[0].timeBase);
+    assert.equal(reader.getStats().packets, expected.length);
+    assert.equal(reader.getStats().zeroCopy, expected.length, 'Received packets should reference the ring');
+    assert.equal(writer.used, 0, 'Every record should be reclaimed');
+
+    writer.close();
+    reader.close();
+  });
+
+  it('should move decoded frames without copying on the reader', async () => {
+    await using input = await MediaInput.open(inputFile);
+    const videoStream = input.video();
+    assert.ok(videoStream);
+    using decoder = await Decoder.create(videoStream);
+    const { writer, reader } = connect(2 * 1024 * 1024);
+
+    const expected: { pts: bigint; bytes: Buffer }[] = [];
+    const send = async () => {
+      for await (const frame of decoder.frames(input.packets(videoStream.index))) {
+        expected.push({ pts: frame.pts, bytes: frame.toBuffer() as Buffer });
+        assert.equal(await writer.sendFrame(frame, videoStream.index), 0);
+        frame.free();
+      }
+      writer.end();
+    };
+
+    const received: typeof expected = [];
+    const receive = async () => {
+      const frame = new Frame();
+      frame.alloc();
+      let ret;
+      while ((ret = await reader.receiveFrame(frame)) >= 0) {
+        assert.equal(ret, videoStream.index);
+        assert.equal(frame.width, videoStream.codecpar.width);
+        assert.equal(frame.linesize[0] % 64, 0, 'Planes should be aligned');
+        received.push({ pts: frame.pts, bytes: frame.toBuffer() as Buffer });
+        frame.unref();
+      }
+      assert.equal(ret, AVERROR_EOF);
+      frame.free();
+    };
+
+    await Promise.all([send(), receive()]);
+
+    assert.ok(expected.length > 0);
+    assert.equal(received.length, expected.length);
+    for (let i = 0; i < expected.length; i++) {
+      assert.equal(received[i].pts, expected[i].pts);
+      assert.ok(received[i].bytes.equals(expected[i].bytes), `Frame ${i} should be identical`);
+    }
+    assert.equal(reader.getStats().zeroCopy, expected.length);
+
+    writer.close();
+    reader.close();
+  });
+
+  it('should send frames allocated in the ring without copying', async () => {
+    const { writer, reader } = connect();
+
+    const frame = new Frame();
+    frame.alloc();
+    frame.format = AV_PIX_FMT_YUV420P;
+    frame.width = 64;
+    frame.height = 32;
+    frame.pts = 42n;
+    assert.equal(await writer.allocFrame(frame), 0);
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(await writer.sendPacket(packet), AVERROR_EBUSY, 'Allocated frame must be sent first');
+    packet.free();
+
+    const pixels = Buffer.alloc(64 * 32 * 3 / 2);
+    for (let i = 0; i < pixels.length; i++) {
+      pixels[i] = i & 0xff;
+    }
+    assert.equal(frame.fromBuffer(pixels), 0);
+    assert.equal(await writer.sendFrame(frame), 0);
+    frame.free();
+    writer.end();
+
+    const received = new Frame();
+    received.alloc();
+    assert.equal(await reader.receiveFrame(received), 0);
+    assert.equal(received.pts, 42n);
+    assert.ok((received.toBuffer() as Buffer).equals(pixels));
+    received.free();
+    assert.equal(await reader.receiveFrame(received), AVERROR_EOF);
+
+    assert.equal(writer.getStats().zeroCopy, 1);
+    writer.close();
+    reader.close();
+  });
+
+  it('should reject records larger than half the ring', async () => {
+    const { writer, reader } = connect(64 * 1024);
+
+    const frame = new Frame();
+    frame.alloc();
+    frame.format = AV_PIX_FMT_YUV420P;
+    frame.width = 320;
+    frame.height = 240;
+    assert.equal(frame.getBuffer(), 0);
+    assert.equal(await writer.sendFrame(frame), AVERROR_ENOSPC);
+    frame.free();
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(await writer.sendPacket(packet), 0);
+    const received = new Frame();
+    received.alloc();
+    assert.equal(await reader.receiveFrame(received), AVERROR_EINVAL, 'Next record is a packet');
+    received.free();
+    packet.free();
+    writer.close();
+    reader.close();
+  });
+
+  it('should report a writer closed without ending', async () => {
+    const { writer, reader } = connect();
+
+    const packet = new Packet();
+    packet.alloc();
+    const pending = reader.receivePacket(packet);
+    writer.close();
+    assert.equal(await pending, AVERROR_EPIPE);
+
+    packet.free();
+    reader.close();
+  });
+
+  it('should stop the writer once the reader is closed', async () => {
+    const { writer, reader } = connect();
+    reader.close();
+
+    const packet = new Packet();
+    packet.alloc();
+    assert.equal(await writer.sendPacket(packet), AVERROR_EPIPE);
+    packet.free();
+    writer.close();
+  });
+});
@@ -0,0 +1,97 @@
+import assert from 'node:assert';
+import { describe, it } from 'node:test';
+
+import { Decoder, MediaInput } from '../src/api/index.js';
+import { SmartCutter } from '../src/index.js';
+import { getInputFile, getOutputFile, prepareTestEnvironment } from './index.js';
+
+prepareTestEnvironment();
+
+const inputFile = getInputFile('demux.mp4');
+
+// Presentation times (seconds) of every decoded video frame
+async function framePresentationTimes(url: string): Promise<number[]> {
+  await using input = await MediaInput.open(url);
+  const video = input.video();
+  assert.ok(video);
+  using decoder = await Decoder.create(video);
+
+  const times: number[] = [];
+  for await (const frame of decoder.frames(input.packets(video.index))) {
+    times.push((Number(frame.pts) * video.timeBase.num) / video.timeBase.den);
+    frame.free();
+  }
+  return times;
+}
+
+describe('SmartCutter', () => {
+  it('should cut frame-accurately between keyframes', async () => {
+    const output = getOutputFile('smart-cut-range.mp4');
+    const start = 1.02;
+    const end = 2.98;
+
+    const cutter = new SmartCutter();
+    assert.equal(await cutter.cut(inputFile, output, { start, end }), 0);
+
+    const source = await framePresentationTimes(inputFile);
+    const expected = source.filter((t) => t >= start && t < end);
+    const cut = await framePresentationTimes(output);
+
+    assert.ok(expected.length > 0);
+    assert.equal(cut.length, expected.length, 'Every frame inside the range and nothing else');
+    assert.ok(Math.abs(cut[0] - (expected[0] - start)) < 0.04, 'Output starts at the in point');
+
+    const stats = cutter.getStats();
+    assert.ok(stats.encodedGops >= 1, 'The in point is not on a keyframe');
+    assert.ok(stats.encodedFrames > 0 && stats.encodedFrames <= expected.length);
+    assert.ok(stats.decodedFrames >= stats.encodedFrames);
+  });
+
+  it('should stream-copy everything without a cut inside a GOP', async () => {
+    const output = getOutputFile('smart-cut-full.mp4');
+
+    const cutter = new SmartCutter();
+    assert.equal(await cutter.cut(inputFile, output), 0);
+
+    const stats = cutter.getStats();
+    assert.ok(stats.copiedGops > 0);
+    assert.equal(stats.encodedGops, 0);
+    assert.equal(stats.encodedFrames, 0);
+    assert.ok(stats.copiedPackets > 0);
+
+    const source = await framePresentationTimes(inputFile);
+    const cut = await framePresentationTimes(output);
+    assert.equal(cut.length, source.length);
+  });
+
+  it('should keep audio inside the range', async () => {
+    const output = getOutputFile('smart-cut-audio.mp4');
+
+    const cutter = new SmartCutter();
+    assert.equal(cutter.cutSync(inputFile, output, { start: 0.5, end: 1.5 }), 0);
+
+    await using input = await MediaInput.open(output);
+    const audio = input.audio();
+    assert.ok(audio, 'Audio stream should be copied');
+    assert.ok(input.video());
+
+    let first: bigint | null = null;
+    let last = 0n;
+    for await (const packet of input.packets(audio.index)) {
+      first ??= packet.pts;
+      last = packet.pts;
+      packet.free();
+    }
+    assert.ok(first !== null && first >= 0n);
+    assert.ok((Number(last) * audio.timeBase.num) / audio.timeBase.den < 1.0);
+  });
+
+  it('should report input errors and reject concurrent cuts', async () => {
+    const cutter = new SmartCutter();
+    assert.ok((await cutter.cut(getInputFile('does-not-exist.mp4'), getOutputFile('smart-cut-missing.mp4'))) < 0);
+
+    const running = cutter.cut(inputFile, getOutputFile('smart-cut-busy.mp4'), { start: 1 });
+    assert.throws(() => cutter.cutSync(inputFile, getOutputFile('smart-cut-busy-2.mp4')), /already running/);
+    assert.equal(await running, 0);
+  });
+});